@@ -201,6 +201,15 @@ ControlCharacterFill            [^"\\]|\\["\\/bfnrtu]
     }
 }
 
+\"http-threads\" {
+    switch(driver.ctx_) {
+    case ParserContext::AGENT:
+        return AgentParser::make_HTTP_THREADS(driver.loc_);
+    default:
+        return AgentParser::make_STRING("http-threads", driver.loc_);
+    }
+}
+
 \"user-context\" {
     switch(driver.ctx_) {
     case ParserContext::AGENT:
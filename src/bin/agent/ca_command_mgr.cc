@@ -1,4 +1,4 @@
-// Copyright (C) 2017-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2017-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -41,7 +41,24 @@ CtrlAgentCommandMgr::instance() {
 }
 
 CtrlAgentCommandMgr::CtrlAgentCommandMgr()
-    : HookedCommandMgr() {
+    : HookedCommandMgr(), command_mutex_() {
+}
+
+bool
+CtrlAgentCommandMgr::isThreadSafe(const ConstElementPtr& command) const {
+    if (!command || (command->getType() != Element::map)) {
+        return (false);
+    }
+    ConstElementPtr services = command->get("service");
+    if (services && (services->getType() == Element::list) &&
+        !services->empty()) {
+        return (true);
+    }
+    ConstElementPtr name = command->get(CONTROL_COMMAND);
+    if (!name || (name->getType() != Element::string)) {
+        return (false);
+    }
+    return (isThreadSafe(name->stringValue()));
 }
 
 isc::data::ConstElementPtr
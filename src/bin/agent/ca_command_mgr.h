@@ -1,4 +1,4 @@
-// Copyright (C) 2017-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2017-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -9,6 +9,7 @@
 
 #include <config/hooked_command_mgr.h>
 #include <exceptions/exceptions.h>
+#include <util/readwrite_mutex.h>
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -41,6 +42,26 @@ public:
     /// @brief Returns sole instance of the Command Manager.
     static CtrlAgentCommandMgr& instance();
 
+    using BaseCommandMgr::isThreadSafe;
+
+    /// @brief Checks if a command can be processed concurrently with the
+    /// other thread safe commands.
+    ///
+    /// The commands forwarded to the Kea servers and the commands marked
+    /// with @c setThreadSafe are thread safe.
+    ///
+    /// @param command Pointer to the command, which may be null.
+    /// @return true if the command is thread safe.
+    bool isThreadSafe(const isc::data::ConstElementPtr& command) const;
+
+    /// @brief Returns the mutex serializing the commands.
+    ///
+    /// The thread safe commands are processed holding the read lock and
+    /// the other commands are processed holding the write lock.
+    util::ReadWriteMutex& getCommandMutex() {
+        return (command_mutex_);
+    }
+
     /// @brief Triggers command processing.
     ///
     /// This method overrides the @c BaseCommandMgr::processCommand to ensure
@@ -107,6 +128,8 @@ private:
     /// thus the constructor is private.
     CtrlAgentCommandMgr();
 
+    /// @brief Mutex serializing the commands.
+    util::ReadWriteMutex command_mutex_;
 };
 
 } // end of namespace isc::agent
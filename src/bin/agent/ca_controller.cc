@@ -1,4 +1,4 @@
-// Copyright (C) 2016-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2016-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -79,6 +79,13 @@ CtrlAgentController::registerCommands() {
 
     CtrlAgentCommandMgr::instance().registerCommand(VERSION_GET_COMMAND,
         std::bind(&DControllerBase::versionGetHandler, this, ph::_1, ph::_2));
+
+    // Mark the commands which can be processed concurrently by the HTTP
+    // threads.
+    CtrlAgentCommandMgr::instance().setThreadSafe(BUILD_REPORT_COMMAND);
+    CtrlAgentCommandMgr::instance().setThreadSafe(CONFIG_GET_COMMAND);
+    CtrlAgentCommandMgr::instance().setThreadSafe(VERSION_GET_COMMAND);
+    CtrlAgentCommandMgr::instance().setThreadSafe("list-commands");
 }
 
 void
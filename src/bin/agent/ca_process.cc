@@ -29,7 +29,8 @@ namespace agent {
 CtrlAgentProcess::CtrlAgentProcess(const char* name,
                                    const asiolink::IOServicePtr& io_service)
     : DProcessBase(name, io_service, DCfgMgrBasePtr(new CtrlAgentCfgMgr())),
-      http_listeners_() {
+      http_listeners_(), http_listeners_mutex_(), thread_io_service_(),
+      thread_pool_() {
 }
 
 CtrlAgentProcess::~CtrlAgentProcess() {
@@ -50,6 +51,11 @@ CtrlAgentProcess::run() {
                 CtrlAgentController::instance());
         controller->registerCommands();
 
+        // Start the HTTP threads.
+        if (thread_pool_) {
+            thread_pool_->run();
+        }
+
         // Let's process incoming data or expiring timers in a loop until
         // shutdown condition is detected.
         while (!shouldShutdown()) {
@@ -61,10 +67,16 @@ CtrlAgentProcess::run() {
         }
         // Done so removing all listeners.
         garbageCollectListeners(0);
+        if (thread_pool_) {
+            thread_pool_->stop();
+        }
         stopIOService();
     } catch (const std::exception& ex) {
         LOG_FATAL(agent_logger, CTRL_AGENT_FAILED).arg(ex.what());
         try {
+            if (thread_pool_) {
+                thread_pool_->stop();
+            }
             stopIOService();
         } catch (...) {
             // Ignore double errors
@@ -98,6 +110,10 @@ CtrlAgentProcess::runIO() {
 isc::data::ConstElementPtr
 CtrlAgentProcess::shutdown(isc::data::ConstElementPtr /*args*/) {
     setShutdownFlag(true);
+    // Wake up the main loop when the command is processed by an HTTP thread.
+    if (thread_pool_) {
+        getIoService()->post([]() {});
+    }
     return (isc::config::createAnswer(0, "Control Agent is shutting down"));
 }
 
@@ -138,6 +154,22 @@ CtrlAgentProcess::configure(isc::data::ConstElementPtr config_set,
         uint16_t server_port = ctx->getHttpPort();
         bool use_https = false;
 
+        std::lock_guard<std::mutex> lock(http_listeners_mutex_);
+
+        // The pool of HTTP threads is created with the first listener.
+        // The threads may be processing this configuration, so the pool
+        // can't be resized later.
+        uint16_t http_threads = ctx->getHttpThreads();
+        IOServicePtr thread_io_service = thread_io_service_;
+        if (http_listeners_.empty()) {
+            if (http_threads > 0) {
+                thread_io_service.reset(new IOService());
+            }
+        } else if (http_threads != getHttpThreads()) {
+            LOG_WARN(agent_logger, CTRL_AGENT_HTTP_THREADS_UNCHANGED)
+                .arg(getHttpThreads()).arg(http_threads);
+        }
+
         // Only open a new listener if the configuration has changed.
         if (http_listeners_.empty() ||
             (http_listeners_.back()->getLocalAddress() != server_address) ||
@@ -163,7 +195,8 @@ CtrlAgentProcess::configure(isc::data::ConstElementPtr config_set,
             // Create http listener. It will open up a TCP socket and be
             // prepared to accept incoming connection.
             HttpListenerPtr http_listener
-                (new HttpListener(*getIoService(), server_address,
+                (new HttpListener(thread_io_service ? *thread_io_service :
+                                  *getIoService(), server_address,
                                   server_port, tls_context, rcf,
                                   HttpListener::RequestTimeout(TIMEOUT_AGENT_RECEIVE_COMMAND),
                                   HttpListener::IdleTimeout(TIMEOUT_AGENT_IDLE_CONNECTION_TIMEOUT)));
@@ -172,10 +205,23 @@ CtrlAgentProcess::configure(isc::data::ConstElementPtr config_set,
             // callback and start listening.
             http_listener->start();
 
+            // The threads are started by the run method.
+            if (thread_io_service && !thread_pool_) {
+                thread_io_service_ = thread_io_service;
+                thread_pool_.reset(new HttpThreadPool(thread_io_service_,
+                                                      http_threads, true));
+            }
+
             // The new listener is running so add it to the collection of
             // active listeners. The next step will be to remove all other
             // active listeners, but we do it inside the main process loop.
             http_listeners_.push_back(http_listener);
+
+            // Wake up the main loop when the configuration is processed by
+            // an HTTP thread.
+            if (thread_pool_) {
+                getIoService()->post([]() {});
+            }
         }
 
         // Ok, seems we're good to go.
@@ -198,23 +244,42 @@ CtrlAgentProcess::garbageCollectListeners(size_t leaving) {
     // We expect only one active listener. If there are more (most likely 2),
     // it means we have just reconfigured the server and need to shut down all
     // listeners execept the most recently added.
-    if (http_listeners_.size() > leaving) {
-        // Stop no longer used listeners.
-        for (auto l = http_listeners_.begin();
-             l != http_listeners_.end() - leaving;
-             ++l) {
-            (*l)->stop();
+    std::vector<HttpListenerPtr> unused;
+    {
+        std::lock_guard<std::mutex> lock(http_listeners_mutex_);
+        if (http_listeners_.size() > leaving) {
+            unused.assign(http_listeners_.begin(),
+                          http_listeners_.end() - leaving);
+            http_listeners_.erase(http_listeners_.begin(),
+                                  http_listeners_.end() - leaving);
         }
-        // We have stopped listeners but there may be some pending handlers
-        // related to these listeners. Need to invoke these handlers.
+    }
+    if (unused.empty()) {
+        return;
+    }
+
+    // The HTTP threads must not run the handlers of the listeners being
+    // stopped.
+    if (thread_pool_) {
+        thread_pool_->pause();
+    }
+
+    // Stop no longer used listeners.
+    for (auto const& l : unused) {
+        l->stop();
+    }
+
+    // We have stopped listeners but there may be some pending handlers
+    // related to these listeners. Need to invoke these handlers.
+    if (thread_pool_) {
+        thread_io_service_->restart();
+        thread_io_service_->poll();
+        thread_pool_->run();
+    } else {
         getIoService()->get_io_service().poll();
-        // Finally, we're ready to remove no longer used listeners.
-        http_listeners_.erase(http_listeners_.begin(),
-                              http_listeners_.end() - leaving);
     }
 }
 
-
 CtrlAgentCfgMgrPtr
 CtrlAgentProcess::getCtrlAgentCfgMgr() {
     return (boost::dynamic_pointer_cast<CtrlAgentCfgMgr>(getCfgMgr()));
@@ -222,6 +287,7 @@ CtrlAgentProcess::getCtrlAgentCfgMgr() {
 
 ConstHttpListenerPtr
 CtrlAgentProcess::getHttpListener() const {
+    std::lock_guard<std::mutex> lock(http_listeners_mutex_);
     // Return the most recent listener or null.
     return (http_listeners_.empty() ? ConstHttpListenerPtr() :
             http_listeners_.back());
@@ -233,5 +299,10 @@ CtrlAgentProcess::isListening() const {
     return (static_cast<bool>(getHttpListener()));
 }
 
+uint16_t
+CtrlAgentProcess::getHttpThreads() const {
+    return (thread_pool_ ? thread_pool_->getPoolSize() : 0);
+}
+
 } // namespace isc::agent
 } // namespace isc
@@ -8,8 +8,10 @@
 #define CTRL_AGENT_PROCESS_H
 
 #include <agent/ca_cfg_mgr.h>
+#include <http/http_thread_pool.h>
 #include <http/listener.h>
 #include <process/d_process.h>
+#include <mutex>
 #include <vector>
 
 namespace isc {
@@ -29,6 +31,13 @@ namespace agent {
 /// Some commands are handled by the Control Agent process itself, rather than
 /// forwarded to the Kea servers. An example of such command is the one that
 /// instructs the agent to start a specific service.
+///
+/// The HTTP requests are processed by the main thread unless the number of
+/// HTTP threads is given by the http-threads configuration parameter.
+/// In that case the listeners are driven by a pool of threads, so a slow
+/// command doesn't delay the processing of the other requests. The pool
+/// is created by the first configuration and keeps its size until the
+/// Control Agent is restarted.
 class CtrlAgentProcess : public process::DProcessBase {
 public:
     /// @brief Constructor
@@ -121,6 +130,12 @@ public:
     /// @return true if the process is listening.
     bool isListening() const;
 
+    /// @brief Returns the number of threads processing the HTTP requests.
+    ///
+    /// @return Number of HTTP threads, 0 when the requests are processed
+    /// by the main thread.
+    uint16_t getHttpThreads() const;
+
 private:
 
     /// @brief Removes listeners which are no longer in use.
@@ -144,6 +159,19 @@ private:
     /// @brief Holds a list of pointers to the active listeners.
     std::vector<http::HttpListenerPtr> http_listeners_;
 
+    /// @brief Mutex protecting the list of active listeners.
+    ///
+    /// The listeners are created by the configuration which can be
+    /// processed by an HTTP thread.
+    mutable std::mutex http_listeners_mutex_;
+
+    /// @brief IO service driving the listeners when the HTTP threads are
+    /// used, null otherwise.
+    asiolink::IOServicePtr thread_io_service_;
+
+    /// @brief Pool of threads processing the HTTP requests, null when the
+    /// requests are processed by the main thread.
+    http::HttpThreadPoolPtr thread_pool_;
 };
 
 /// @brief Defines a shared pointer to CtrlAgentProcess.
@@ -1,4 +1,4 @@
-// Copyright (C) 2017-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2017-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -23,6 +23,7 @@
 using namespace isc::data;
 using namespace isc::hooks;
 using namespace isc::http;
+using namespace isc::util;
 
 namespace {
 
@@ -87,6 +88,27 @@ createStockHttpResponseInternal(const HttpRequestPtr& request,
 HttpResponsePtr
 CtrlAgentResponseCreator::
 createDynamicHttpResponse(HttpRequestPtr request) {
+    // The request is finalized so the call to getBodyAsJson must not
+    // trigger an exception.
+    ConstElementPtr command;
+    PostHttpRequestJsonPtr request_json =
+        boost::dynamic_pointer_cast<PostHttpRequestJson>(request);
+    if (request_json) {
+        command = request_json->getBodyAsJson();
+    }
+
+    CtrlAgentCommandMgr& command_mgr = CtrlAgentCommandMgr::instance();
+    if (command_mgr.isThreadSafe(command)) {
+        ReadLockGuard lock(command_mgr.getCommandMutex());
+        return (createDynamicHttpResponseInternal(request));
+    }
+    WriteLockGuard lock(command_mgr.getCommandMutex());
+    return (createDynamicHttpResponseInternal(request));
+}
+
+HttpResponsePtr
+CtrlAgentResponseCreator::
+createDynamicHttpResponseInternal(HttpRequestPtr request) {
     // First check authentication.
     HttpResponseJsonPtr http_response;
 
@@ -73,10 +73,20 @@ private:
 
     /// @brief Creates implementation specific HTTP response.
     ///
+    /// The thread safe commands are processed concurrently. The other
+    /// commands are processed exclusively.
+    ///
     /// @param request Pointer to an object representing HTTP request.
     /// @return Pointer to an object representing HTTP response.
     virtual http::HttpResponsePtr
     createDynamicHttpResponse(http::HttpRequestPtr request);
+
+    /// @brief Creates implementation specific HTTP response (thread unsafe).
+    ///
+    /// @param request Pointer to an object representing HTTP request.
+    /// @return Pointer to an object representing HTTP response.
+    http::HttpResponsePtr
+    createDynamicHttpResponseInternal(http::HttpRequestPtr request);
 };
 
 } // end of namespace isc::agent
@@ -65,6 +65,9 @@ TEST(CtrlAgentCfgMgr, contextHttpParams) {
 
     ctx.setHttpHost("alnitak");
     EXPECT_EQ("alnitak", ctx.getHttpHost());
+
+    ctx.setHttpThreads(4);
+    EXPECT_EQ(4, ctx.getHttpThreads());
 }
 
 // Tests if context can store and retrieve TLS parameters.
@@ -233,7 +236,8 @@ const char* AGENT_CONFIGS[] = {
 
     // Configuration 1: http parameters only (no control sockets, not hooks)
     "{   \"http-host\": \"betelgeuse\",\n"
-    "    \"http-port\": 8001\n"
+    "    \"http-port\": 8001,\n"
+    "    \"http-threads\": 4\n"
     "}",
 
     // Configuration 2: http and 1 socket
@@ -422,6 +426,7 @@ TEST_F(AgentParserTest, configParseHttpOnly) {
     ASSERT_TRUE(ctx);
     EXPECT_EQ("betelgeuse", ctx->getHttpHost());
     EXPECT_EQ(8001, ctx->getHttpPort());
+    EXPECT_EQ(4, ctx->getHttpThreads());
 }
 
 // Tests if a single socket can be configured. BTW this test also checks
@@ -423,3 +423,20 @@ TEST_F(CtrlAgentCommandMgrTest, forwardListCommands) {
 }
 
 }
+
+// Check which commands can be processed concurrently.
+TEST_F(CtrlAgentCommandMgrTest, isThreadSafe) {
+    // The forwarded commands are thread safe.
+    EXPECT_TRUE(mgr_.isThreadSafe(createCommand("config-set", "dhcp4")));
+
+    // The commands handled by the agent must be marked.
+    EXPECT_FALSE(mgr_.isThreadSafe(createCommand("config-get", "")));
+    mgr_.setThreadSafe("config-get");
+    EXPECT_TRUE(mgr_.isThreadSafe(createCommand("config-get", "")));
+    EXPECT_FALSE(mgr_.isThreadSafe(createCommand("config-set", "")));
+
+    // Malformed commands are not thread safe.
+    EXPECT_FALSE(mgr_.isThreadSafe(ConstElementPtr()));
+    EXPECT_FALSE(mgr_.isThreadSafe(Element::fromJSON("[ \"config-get\" ]")));
+    EXPECT_FALSE(mgr_.isThreadSafe(Element::fromJSON("{ \"command\": 1 }")));
+}
@@ -1,4 +1,4 @@
-// Copyright (C) 2016-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2016-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -9,6 +9,7 @@
 #include <agent/ca_process.h>
 #include <asiolink/interval_timer.h>
 #include <asiolink/io_service.h>
+#include <cc/command_interpreter.h>
 #include <process/testutils/d_test_stubs.h>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <gtest/gtest.h>
@@ -18,6 +19,8 @@ using namespace boost::posix_time;
 using namespace isc;
 using namespace isc::agent;
 using namespace isc::asiolink;
+using namespace isc::config;
+using namespace isc::data;
 using namespace isc::process;
 
 namespace {
@@ -86,5 +89,67 @@ TEST_F(CtrlAgentProcessTest, shutdown) {
                 elapsed.total_milliseconds() <= 400);
 }
 
+// Verifies that the number of HTTP threads is taken from the first
+// configuration.
+TEST(CtrlAgentProcess, httpThreads) {
+    IOServicePtr io_service(new IOService());
+    CtrlAgentProcess agent_process("TestProcess", io_service);
+    EXPECT_EQ(0, agent_process.getHttpThreads());
+
+    ConstElementPtr config = Element::fromJSON(
+        "{ \"http-host\": \"127.0.0.1\", \"http-port\": 8081,"
+        "  \"http-threads\": 2 }");
+    ConstElementPtr answer = agent_process.configure(config, false);
+    int rcode = -1;
+    parseAnswer(rcode, answer);
+    ASSERT_EQ(0, rcode);
+    EXPECT_EQ(2, agent_process.getHttpThreads());
+
+    // The pool keeps its size when the configuration changes.
+    config = Element::fromJSON(
+        "{ \"http-host\": \"127.0.0.1\", \"http-port\": 8082,"
+        "  \"http-threads\": 4 }");
+    answer = agent_process.configure(config, false);
+    parseAnswer(rcode, answer);
+    ASSERT_EQ(0, rcode);
+    EXPECT_EQ(2, agent_process.getHttpThreads());
+}
+
+// Verifies that the HTTP requests are processed by the main thread
+// by default.
+TEST(CtrlAgentProcess, noHttpThreads) {
+    IOServicePtr io_service(new IOService());
+    CtrlAgentProcess agent_process("TestProcess", io_service);
+
+    ConstElementPtr config = Element::fromJSON(
+        "{ \"http-host\": \"127.0.0.1\", \"http-port\": 8081 }");
+    ConstElementPtr answer = agent_process.configure(config, false);
+    int rcode = -1;
+    parseAnswer(rcode, answer);
+    ASSERT_EQ(0, rcode);
+    EXPECT_EQ(0, agent_process.getHttpThreads());
+}
+
+// Verifies that the run method exits gracefully when the HTTP threads
+// are used.
+TEST(CtrlAgentProcess, shutdownHttpThreads) {
+    IOServicePtr io_service(new IOService());
+    CtrlAgentProcess agent_process("TestProcess", io_service);
+    ConstElementPtr config = Element::fromJSON(
+        "{ \"http-host\": \"127.0.0.1\", \"http-port\": 8081,"
+        "  \"http-threads\": 2 }");
+    ConstElementPtr answer = agent_process.configure(config, false);
+    int rcode = -1;
+    parseAnswer(rcode, answer);
+    ASSERT_EQ(0, rcode);
+    ASSERT_EQ(2, agent_process.getHttpThreads());
+
+    IntervalTimer timer(*io_service);
+    timer.setup([&agent_process]() {
+        agent_process.shutdown(isc::data::ConstElementPtr());
+    }, 200);
+
+    EXPECT_NO_THROW(agent_process.run());
+}
 
 }
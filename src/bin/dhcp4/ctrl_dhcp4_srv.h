@@ -12,6 +12,7 @@
 #include <cc/data.h>
 #include <cc/command_interpreter.h>
 #include <database/database_connection.h>
+#include <dhcpsrv/lease_reclaimer.h>
 #include <dhcpsrv/timer_mgr.h>
 #include <dhcp4/dhcp4_srv.h>
 
@@ -138,6 +139,37 @@ private:
     /// (that was sent from some yet unspecified sender).
     static void sessionReader(void);
 
+    /// @brief Applies a parsed configuration.
+    ///
+    /// Reopens the databases, restarts the DDNS client, the DHCPv4-over-DHCPv6
+    /// IPC and the packet queueing, opens the sockets, sets the timers up,
+    /// commits the runtime option definitions, calls the dhcp4_srv_configured
+    /// hook point and applies the multi-threading settings of the staging
+    /// configuration.
+    ///
+    /// @param config JSON representation of the new configuration.
+    /// @param answer Answer of the successful parsing of the configuration.
+    ///
+    /// @return status of the config update
+    static isc::data::ConstElementPtr
+    applyConfig(isc::data::ConstElementPtr config,
+                isc::data::ConstElementPtr answer);
+
+    /// @brief Configuration processor parsing the configuration in the
+    /// background.
+    ///
+    /// Used by the config-set command when the "background-config-parsing"
+    /// multi-threading parameter is enabled. The new configuration is
+    /// parsed by the calling thread while the packet processing threads
+    /// keep serving the clients with the current configuration. The parsed
+    /// configuration is then committed and applied in a critical section.
+    ///
+    /// @param config JSON representation of the new configuration.
+    ///
+    /// @return status of the config update
+    isc::data::ConstElementPtr
+    processConfigInBackground(isc::data::ConstElementPtr config);
+
     /// @brief Handler for processing 'shutdown' command
     ///
     /// This handler processes shutdown command, which initializes shutdown
@@ -449,6 +481,14 @@ private:
     /// Shared pointer to the instance of timer @c TimerMgr is held here to
     /// make sure that the @c TimerMgr outlives instance of this class.
     TimerMgrPtr timer_mgr_;
+
+    /// @brief Background leases reclaimer.
+    ///
+    /// Created by the first configuration. It reclaims the expired leases
+    /// instead of the reclamation timer when the "background-reclamation"
+    /// parameter of "expired-leases-processing" is enabled in
+    /// multi-threading mode.
+    LeaseReclaimerPtr lease_reclaimer_;
 };
 
 }  // namespace dhcp
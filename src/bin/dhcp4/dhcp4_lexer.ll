@@ -1529,6 +1529,15 @@ ControlCharacterFill            [^"\\]|\\["\\/bfnrtu]
     }
 }
 
+\"background-reclamation\" {
+    switch(driver.ctx_) {
+    case isc::dhcp::Parser4Context::EXPIRED_LEASES_PROCESSING:
+        return isc::dhcp::Dhcp4Parser::make_BACKGROUND_RECLAMATION(driver.loc_);
+    default:
+        return isc::dhcp::Dhcp4Parser::make_STRING("background-reclamation", driver.loc_);
+    }
+}
+
 \"dhcp4o6-port\" {
     switch(driver.ctx_) {
     case isc::dhcp::Parser4Context::DHCP4:
@@ -1574,6 +1583,51 @@ ControlCharacterFill            [^"\\]|\\["\\/bfnrtu]
     }
 }
 
+\"receiver-threads\" {
+    switch(driver.ctx_) {
+    case isc::dhcp::Parser4Context::DHCP_MULTI_THREADING:
+        return isc::dhcp::Dhcp4Parser::make_RECEIVER_THREADS(driver.loc_);
+    default:
+        return isc::dhcp::Dhcp4Parser::make_STRING("receiver-threads", driver.loc_);
+    }
+}
+
+\"send-batch-size\" {
+    switch(driver.ctx_) {
+    case isc::dhcp::Parser4Context::DHCP_MULTI_THREADING:
+        return isc::dhcp::Dhcp4Parser::make_SEND_BATCH_SIZE(driver.loc_);
+    default:
+        return isc::dhcp::Dhcp4Parser::make_STRING("send-batch-size", driver.loc_);
+    }
+}
+
+\"send-batch-delay\" {
+    switch(driver.ctx_) {
+    case isc::dhcp::Parser4Context::DHCP_MULTI_THREADING:
+        return isc::dhcp::Dhcp4Parser::make_SEND_BATCH_DELAY(driver.loc_);
+    default:
+        return isc::dhcp::Dhcp4Parser::make_STRING("send-batch-delay", driver.loc_);
+    }
+}
+
+\"background-config-parsing\" {
+    switch(driver.ctx_) {
+    case isc::dhcp::Parser4Context::DHCP_MULTI_THREADING:
+        return isc::dhcp::Dhcp4Parser::make_BACKGROUND_CONFIG_PARSING(driver.loc_);
+    default:
+        return isc::dhcp::Dhcp4Parser::make_STRING("background-config-parsing", driver.loc_);
+    }
+}
+
+\"command-threads\" {
+    switch(driver.ctx_) {
+    case isc::dhcp::Parser4Context::DHCP_MULTI_THREADING:
+        return isc::dhcp::Dhcp4Parser::make_COMMAND_THREADS(driver.loc_);
+    default:
+        return isc::dhcp::Dhcp4Parser::make_STRING("command-threads", driver.loc_);
+    }
+}
+
 \"control-socket\" {
     switch(driver.ctx_) {
     case isc::dhcp::Parser4Context::DHCP4:
@@ -196,6 +196,7 @@ using namespace std;
   MAX_RECLAIM_LEASES "max-reclaim-leases"
   MAX_RECLAIM_TIME "max-reclaim-time"
   UNWARNED_RECLAIM_CYCLES "unwarned-reclaim-cycles"
+  BACKGROUND_RECLAMATION "background-reclamation"
 
   DHCP4O6_PORT "dhcp4o6-port"
 
@@ -203,6 +204,11 @@ using namespace std;
   ENABLE_MULTI_THREADING "enable-multi-threading"
   THREAD_POOL_SIZE "thread-pool-size"
   PACKET_QUEUE_SIZE "packet-queue-size"
+  RECEIVER_THREADS "receiver-threads"
+  SEND_BATCH_SIZE "send-batch-size"
+  SEND_BATCH_DELAY "send-batch-delay"
+  BACKGROUND_CONFIG_PARSING "background-config-parsing"
+  COMMAND_THREADS "command-threads"
 
   CONTROL_SOCKET "control-socket"
   SOCKET_TYPE "socket-type"
@@ -1171,6 +1177,11 @@ multi_threading_params: multi_threading_param
 multi_threading_param: enable_multi_threading
                      | thread_pool_size
                      | packet_queue_size
+                     | receiver_threads
+                     | send_batch_size
+                     | send_batch_delay
+                     | background_config_parsing
+                     | command_threads
                      | user_context
                      | comment
                      | unknown_map_entry
@@ -1194,6 +1205,36 @@ packet_queue_size: PACKET_QUEUE_SIZE COLON INTEGER {
     ctx.stack_.back()->set("packet-queue-size", prf);
 };
 
+receiver_threads: RECEIVER_THREADS COLON BOOLEAN {
+    ctx.unique("receiver-threads", ctx.loc2pos(@1));
+    ElementPtr b(new BoolElement($3, ctx.loc2pos(@3)));
+    ctx.stack_.back()->set("receiver-threads", b);
+};
+
+send_batch_size: SEND_BATCH_SIZE COLON INTEGER {
+    ctx.unique("send-batch-size", ctx.loc2pos(@1));
+    ElementPtr prf(new IntElement($3, ctx.loc2pos(@3)));
+    ctx.stack_.back()->set("send-batch-size", prf);
+};
+
+send_batch_delay: SEND_BATCH_DELAY COLON INTEGER {
+    ctx.unique("send-batch-delay", ctx.loc2pos(@1));
+    ElementPtr prf(new IntElement($3, ctx.loc2pos(@3)));
+    ctx.stack_.back()->set("send-batch-delay", prf);
+};
+
+background_config_parsing: BACKGROUND_CONFIG_PARSING COLON BOOLEAN {
+    ctx.unique("background-config-parsing", ctx.loc2pos(@1));
+    ElementPtr b(new BoolElement($3, ctx.loc2pos(@3)));
+    ctx.stack_.back()->set("background-config-parsing", b);
+};
+
+command_threads: COMMAND_THREADS COLON INTEGER {
+    ctx.unique("command-threads", ctx.loc2pos(@1));
+    ElementPtr prf(new IntElement($3, ctx.loc2pos(@3)));
+    ctx.stack_.back()->set("command-threads", prf);
+};
+
 hooks_libraries: HOOKS_LIBRARIES {
     ctx.unique("hooks-libraries", ctx.loc2pos(@1));
     ElementPtr l(new ListElement(ctx.loc2pos(@1)));
@@ -1282,6 +1323,7 @@ expired_leases_param: reclaim_timer_wait_time
                     | max_reclaim_leases
                     | max_reclaim_time
                     | unwarned_reclaim_cycles
+                    | background_reclamation
                     ;
 
 reclaim_timer_wait_time: RECLAIM_TIMER_WAIT_TIME COLON INTEGER {
@@ -1320,6 +1362,12 @@ unwarned_reclaim_cycles: UNWARNED_RECLAIM_CYCLES COLON INTEGER {
     ctx.stack_.back()->set("unwarned-reclaim-cycles", value);
 };
 
+background_reclamation: BACKGROUND_RECLAMATION COLON BOOLEAN {
+    ctx.unique("background-reclamation", ctx.loc2pos(@1));
+    ElementPtr value(new BoolElement($3, ctx.loc2pos(@3)));
+    ctx.stack_.back()->set("background-reclamation", value);
+};
+
 // --- subnet4 ------------------------------------------
 // This defines subnet4 as a list of maps.
 // "subnet4": [ ... ]
@@ -36,6 +36,7 @@
 #include <dhcpsrv/lease_mgr.h>
 #include <dhcpsrv/lease_mgr_factory.h>
 #include <dhcpsrv/ncr_generator.h>
+#include <dhcpsrv/packet_profiler.h>
 #include <dhcpsrv/shared_network.h>
 #include <dhcpsrv/subnet.h>
 #include <dhcpsrv/subnet_selector.h>
@@ -126,6 +127,7 @@ std::set<std::string> dhcp4_statistics = {
     "pkt4-inform-received",
     "pkt4-unknown-received",
     "pkt4-sent",
+    "pkt4-send-fail",
     "pkt4-offer-sent",
     "pkt4-ack-sent",
     "pkt4-nak-sent",
@@ -465,8 +467,11 @@ Dhcpv4Exchange::setHostIdentifiers() {
                 callout_handle->setArgument("id_value", id);
 
                 // Call callouts
-                HooksManager::callCallouts(Hooks.hook_index_host4_identifier_,
-                                           *callout_handle);
+                {
+                    PacketProfiler::StageTimer timer(PacketProfiler::STAGE_HOOKS);
+                    HooksManager::callCallouts(Hooks.hook_index_host4_identifier_,
+                                               *callout_handle);
+                }
 
                 callout_handle->getArgument("id_type", type);
                 callout_handle->getArgument("id_value", id);
@@ -690,6 +695,9 @@ Dhcpv4Srv::~Dhcpv4Srv() {
 
     IfaceMgr::instance().closeSockets();
 
+    // The interface receivers are stopped so the callback can be cleared.
+    IfaceMgr::instance().setPacketReceiverCallback4(IfaceMgr::PacketReceiverCallback4());
+
     // The lease manager was instantiated during DHCPv4Srv configuration,
     // so we should clean up after ourselves.
     LeaseMgrFactory::destroy();
@@ -718,6 +726,7 @@ Dhcpv4Srv::shutdown() {
 isc::dhcp::Subnet4Ptr
 Dhcpv4Srv::selectSubnet(const Pkt4Ptr& query, bool& drop,
                         bool sanity_only) const {
+    PacketProfiler::StageTimer timer(PacketProfiler::STAGE_SUBNET_SELECT);
 
     // DHCPv4-over-DHCPv6 is a special (and complex) case
     if (query->isDhcp4o6()) {
@@ -754,8 +763,11 @@ Dhcpv4Srv::selectSubnet(const Pkt4Ptr& query, bool& drop,
                                     getCfgSubnets4()->getAll());
 
         // Call user (and server-side) callouts
-        HooksManager::callCallouts(Hooks.hook_index_subnet4_select_,
-                                   *callout_handle);
+        {
+            PacketProfiler::StageTimer timer(PacketProfiler::STAGE_HOOKS);
+            HooksManager::callCallouts(Hooks.hook_index_subnet4_select_,
+                                       *callout_handle);
+        }
 
         // Callouts decided to skip this step. This means that no subnet
         // will be selected. Packet processing will continue, but it will
@@ -872,8 +884,11 @@ Dhcpv4Srv::selectSubnet4o6(const Pkt4Ptr& query, bool& drop,
                                     getCfgSubnets4()->getAll());
 
         // Call user (and server-side) callouts
-        HooksManager::callCallouts(Hooks.hook_index_subnet4_select_,
-                                   *callout_handle);
+        {
+            PacketProfiler::StageTimer timer(PacketProfiler::STAGE_HOOKS);
+            HooksManager::callCallouts(Hooks.hook_index_subnet4_select_,
+                                       *callout_handle);
+        }
 
         // Callouts decided to skip this step. This means that no subnet
         // will be selected. Packet processing will continue, but it will
@@ -1028,19 +1043,52 @@ Dhcpv4Srv::run_one() {
         return;
     } else {
         if (MultiThreadingMgr::instance().getMode()) {
-            typedef function<void()> CallBack;
-            boost::shared_ptr<CallBack> call_back =
-                boost::make_shared<CallBack>(std::bind(&Dhcpv4Srv::processPacketAndSendResponseNoThrow,
-                                                       this, query));
-            if (!MultiThreadingMgr::instance().getThreadPool().add(call_back)) {
-                LOG_DEBUG(dhcp4_logger, DBG_DHCP4_BASIC, DHCP4_PACKET_QUEUE_FULL);
-            }
+            addPacketToThreadPool(query);
         } else {
             processPacketAndSendResponse(query);
         }
     }
 }
 
+void
+Dhcpv4Srv::receivePacketCallback(const Pkt4Ptr& query) {
+    try {
+        LOG_DEBUG(packet4_logger, DBG_DHCP4_BASIC, DHCP4_BUFFER_RECEIVED)
+            .arg(query->getRemoteAddr().toText())
+            .arg(query->getRemotePort())
+            .arg(query->getLocalAddr().toText())
+            .arg(query->getLocalPort())
+            .arg(query->getIface());
+
+        // If the DHCP service has been globally disabled, drop the packet.
+        if (!network_state_->isServiceEnabled()) {
+            LOG_DEBUG(bad_packet4_logger, DBGLVL_PKT_HANDLING, DHCP4_PACKET_DROP_0008)
+                .arg(query->getLabel());
+            return;
+        }
+
+        // The packet is always processed by the thread pool: it is started
+        // once the multi-threading configuration is applied.
+        addPacketToThreadPool(query);
+    } catch (const std::exception& e) {
+        LOG_ERROR(packet4_logger, DHCP4_PACKET_PROCESS_STD_EXCEPTION)
+            .arg(e.what());
+    } catch (...) {
+        LOG_ERROR(packet4_logger, DHCP4_PACKET_PROCESS_EXCEPTION);
+    }
+}
+
+void
+Dhcpv4Srv::addPacketToThreadPool(const Pkt4Ptr& query) {
+    typedef function<void()> CallBack;
+    boost::shared_ptr<CallBack> call_back =
+        boost::make_shared<CallBack>(std::bind(&Dhcpv4Srv::processPacketAndSendResponseNoThrow,
+                                               this, query));
+    if (!MultiThreadingMgr::instance().getThreadPool().add(call_back)) {
+        LOG_DEBUG(dhcp4_logger, DBG_DHCP4_BASIC, DHCP4_PACKET_QUEUE_FULL);
+    }
+}
+
 void
 Dhcpv4Srv::processPacketAndSendResponseNoThrow(Pkt4Ptr& query) {
     try {
@@ -1055,13 +1103,17 @@ Dhcpv4Srv::processPacketAndSendResponseNoThrow(Pkt4Ptr& query) {
 
 void
 Dhcpv4Srv::processPacketAndSendResponse(Pkt4Ptr& query) {
+    // Profile the processing of the packet if it is sampled.
+    PacketProfiler::PacketScope profile(query->getTimestamp());
+
     Pkt4Ptr rsp;
     processPacket(query, rsp);
     if (!rsp) {
         return;
     }
 
-    CalloutHandlePtr callout_handle = getCalloutHandle(query);
+    CalloutHandlePtr callout_handle = getCalloutHandleIfPresent(query);
+    PacketProfiler::StageTimer timer(PacketProfiler::STAGE_PACK_SEND);
     processPacketBufferSend(callout_handle, rsp);
 }
 
@@ -1094,8 +1146,11 @@ Dhcpv4Srv::processPacket(Pkt4Ptr& query, Pkt4Ptr& rsp, bool allow_packet_park) {
         callout_handle->setArgument("query4", query);
 
         // Call callouts
-        HooksManager::callCallouts(Hooks.hook_index_buffer4_receive_,
-                                   *callout_handle);
+        {
+            PacketProfiler::StageTimer timer(PacketProfiler::STAGE_HOOKS);
+            HooksManager::callCallouts(Hooks.hook_index_buffer4_receive_,
+                                       *callout_handle);
+        }
 
         // Callouts decided to drop the received packet.
         // The response (rsp) is null so the caller (run_one) will
@@ -1133,6 +1188,7 @@ Dhcpv4Srv::processPacket(Pkt4Ptr& query, Pkt4Ptr& rsp, bool allow_packet_park) {
                 .arg(query->getRemoteAddr().toText())
                 .arg(query->getLocalAddr().toText())
                 .arg(query->getIface());
+            PacketProfiler::StageTimer timer(PacketProfiler::STAGE_UNPACK);
             query->unpack();
         } catch (const SkipRemainingOptionsError& e) {
             // An option failed to unpack but we are to attempt to process it
@@ -1163,7 +1219,10 @@ Dhcpv4Srv::processPacket(Pkt4Ptr& query, Pkt4Ptr& rsp, bool allow_packet_park) {
     // Assign this packet to one or more classes if needed. We need to do
     // this before calling accept(), because getSubnet4() may need client
     // class information.
-    classifyPacket(query);
+    {
+        PacketProfiler::StageTimer timer(PacketProfiler::STAGE_CLASSIFY);
+        classifyPacket(query);
+    }
 
     // Now it is classified the deferred unpacking can be done.
     deferredUnpack(query);
@@ -1208,8 +1267,11 @@ Dhcpv4Srv::processPacket(Pkt4Ptr& query, Pkt4Ptr& rsp, bool allow_packet_park) {
         callout_handle->setArgument("query4", query);
 
         // Call callouts
-        HooksManager::callCallouts(Hooks.hook_index_pkt4_receive_,
-                                   *callout_handle);
+        {
+            PacketProfiler::StageTimer timer(PacketProfiler::STAGE_HOOKS);
+            HooksManager::callCallouts(Hooks.hook_index_pkt4_receive_,
+                                       *callout_handle);
+        }
 
         // Callouts decided to skip the next processing step. The next
         // processing step would to process the packet, so skip at this
@@ -1246,7 +1308,7 @@ Dhcpv4Srv::processDhcp4QueryAndSendResponse(Pkt4Ptr& query, Pkt4Ptr& rsp,
             return;
         }
 
-        CalloutHandlePtr callout_handle = getCalloutHandle(query);
+        CalloutHandlePtr callout_handle = getCalloutHandleIfPresent(query);
         processPacketBufferSend(callout_handle, rsp);
     } catch (const std::exception& e) {
         LOG_ERROR(packet4_logger, DHCP4_PACKET_PROCESS_STD_EXCEPTION)
@@ -1327,7 +1389,7 @@ Dhcpv4Srv::processDhcp4Query(Pkt4Ptr& query, Pkt4Ptr& rsp,
                                                   static_cast<int64_t>(1));
     }
 
-    CalloutHandlePtr callout_handle = getCalloutHandle(query);
+    CalloutHandlePtr callout_handle = getCalloutHandleIfPresent(query);
     if (ctx && HooksManager::calloutsPresent(Hooks.hook_index_leases4_committed_)) {
         // Use the RAII wrapper to make sure that the callout handle state is
         // reset when this object goes out of scope. All hook points must do
@@ -1402,6 +1464,7 @@ Dhcpv4Srv::processDhcp4Query(Pkt4Ptr& query, Pkt4Ptr& rsp,
 
         try {
             // Call all installed callouts
+            PacketProfiler::StageTimer timer(PacketProfiler::STAGE_HOOKS);
             HooksManager::callCallouts(Hooks.hook_index_leases4_committed_,
                                        *callout_handle);
         } catch (...) {
@@ -1483,8 +1546,11 @@ Dhcpv4Srv::processPacketPktSend(hooks::CalloutHandlePtr& callout_handle,
         callout_handle->setArgument("response4", rsp);
 
         // Call all installed callouts
-        HooksManager::callCallouts(Hooks.hook_index_pkt4_send_,
-                                   *callout_handle);
+        {
+            PacketProfiler::StageTimer timer(PacketProfiler::STAGE_HOOKS);
+            HooksManager::callCallouts(Hooks.hook_index_pkt4_send_,
+                                       *callout_handle);
+        }
 
         // Callouts decided to skip the next processing step. The next
         // processing step would to pack the packet (create wire data).
@@ -1546,8 +1612,11 @@ Dhcpv4Srv::processPacketBufferSend(CalloutHandlePtr& callout_handle,
             callout_handle->setArgument("response4", rsp);
 
             // Call callouts
-            HooksManager::callCallouts(Hooks.hook_index_buffer4_send_,
-                                       *callout_handle);
+            {
+                PacketProfiler::StageTimer timer(PacketProfiler::STAGE_HOOKS);
+                HooksManager::callCallouts(Hooks.hook_index_buffer4_send_,
+                                           *callout_handle);
+            }
 
             // Callouts decided to skip the next processing step. The next
             // processing step would to parse the packet, so skip at this
@@ -2424,7 +2493,7 @@ Dhcpv4Srv::assignLease(Dhcpv4Exchange& ex) {
         }
     }
 
-    CalloutHandlePtr callout_handle = getCalloutHandle(query);
+    CalloutHandlePtr callout_handle = getCalloutHandleIfPresent(query);
 
     // We need to set these values in the context as they haven't been set yet.
     ctx->requested_address_ = hint;
@@ -2441,7 +2510,11 @@ Dhcpv4Srv::assignLease(Dhcpv4Exchange& ex) {
     processClientName(ex);
 
     // Get a lease.
-    Lease4Ptr lease = alloc_engine_->allocateLease4(*ctx);
+    Lease4Ptr lease;
+    {
+        PacketProfiler::StageTimer timer(PacketProfiler::STAGE_ALLOCATION);
+        lease = alloc_engine_->allocateLease4(*ctx);
+    }
 
     // Tracks whether or not the client name (FQDN or host) has changed since
     // the lease was allocated.
@@ -3224,8 +3297,11 @@ Dhcpv4Srv::processRelease(Pkt4Ptr& release, AllocEngine::ClientContext4Ptr& cont
             callout_handle->setArgument("lease4", lease);
 
             // Call all installed callouts
-            HooksManager::callCallouts(Hooks.hook_index_lease4_release_,
-                                       *callout_handle);
+            {
+                PacketProfiler::StageTimer timer(PacketProfiler::STAGE_HOOKS);
+                HooksManager::callCallouts(Hooks.hook_index_lease4_release_,
+                                           *callout_handle);
+            }
 
             // Callouts decided to skip the next processing step. The next
             // processing step would to send the packet, so skip at this
@@ -3376,8 +3452,11 @@ Dhcpv4Srv::declineLease(const Lease4Ptr& lease, const Pkt4Ptr& decline,
         callout_handle->setArgument("lease4", lease);
 
         // Call callouts
-        HooksManager::callCallouts(Hooks.hook_index_lease4_decline_,
-                                   *callout_handle);
+        {
+            PacketProfiler::StageTimer timer(PacketProfiler::STAGE_HOOKS);
+            HooksManager::callCallouts(Hooks.hook_index_lease4_decline_,
+                                       *callout_handle);
+        }
 
         // Check if callouts decided to skip the next processing step.
         // If any of them did, we will drop the packet.
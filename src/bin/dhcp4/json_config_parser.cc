@@ -39,6 +39,7 @@
 #include <hooks/hooks_parser.h>
 #include <config/command_mgr.h>
 #include <util/encode/hex.h>
+#include <util/stopwatch.h>
 #include <util/strutil.h>
 
 #include <boost/foreach.hpp>
@@ -272,6 +273,20 @@ public:
     }
 };
 
+/// @brief Closes the server resources depending on the configuration.
+///
+/// The DHCP sockets are closed, the timers are removed, the packets waiting
+/// for processing are discarded and the config backends are reset.
+///
+/// @param server Reference to the server.
+void
+closeServerResources(Dhcpv4Srv& server) {
+    IfaceMgr::instance().closeSockets();
+    TimerMgr::instance()->unregisterTimers();
+    server.discardPackets();
+    server.getCBControl()->reset();
+}
+
 } // anonymous namespace
 
 namespace isc {
@@ -319,8 +334,8 @@ void configureCommandChannel() {
 }
 
 isc::data::ConstElementPtr
-configureDhcp4Server(Dhcpv4Srv& server, isc::data::ConstElementPtr config_set,
-                     bool check_only) {
+parseDhcp4Server(Dhcpv4Srv& server, isc::data::ConstElementPtr config_set,
+                 bool check_only, bool background) {
     if (!config_set) {
         ConstElementPtr answer = isc::config::createAnswer(CONTROL_RESULT_ERROR,
                                  string("Can't parse NULL config"));
@@ -334,14 +349,6 @@ configureDhcp4Server(Dhcpv4Srv& server, isc::data::ConstElementPtr config_set,
     // so newly recreated configuration starts with first subnet-id equal 1.
     Subnet::resetSubnetID();
 
-    // Close DHCP sockets and remove any existing timers.
-    if (!check_only) {
-        IfaceMgr::instance().closeSockets();
-        TimerMgr::instance()->unregisterTimers();
-        server.discardPackets();
-        server.getCBControl()->reset();
-    }
-
     // Revert any runtime option definitions configured so far and not committed.
     LibDHCP::revertRuntimeOptionDefs();
     // Let's set empty container in case a user hasn't specified any configuration
@@ -446,7 +453,10 @@ configureDhcp4Server(Dhcpv4Srv& server, isc::data::ConstElementPtr config_set,
         ConstElementPtr ifaces_config = mutable_cfg->get("interfaces-config");
         if (ifaces_config) {
             parameter_name = "interfaces-config";
-            IfacesConfigParser parser(AF_INET, check_only);
+            // The interfaces in use are not re-detected when the
+            // configuration is parsed in the background: this is done
+            // by the commit.
+            IfacesConfigParser parser(AF_INET, check_only || background);
             CfgIfacePtr cfg_iface = srv_cfg->getCfgIface();
             parser.parse(cfg_iface, ifaces_config);
         }
@@ -555,8 +565,20 @@ configureDhcp4Server(Dhcpv4Srv& server, isc::data::ConstElementPtr config_set,
         if (subnet4) {
             parameter_name = "subnet4";
             Subnets4ListConfigParser subnets_parser;
-            // parse() returns number of subnets parsed. We may log it one day.
-            subnets_parser.parse(srv_cfg, subnet4);
+            // Take over the unchanged subnets of the current configuration
+            // when the option definitions their options depend on did not
+            // change.
+            SrvConfigPtr current_cfg = CfgMgr::instance().getCurrentCfg();
+            if (current_cfg->getCfgOptionDef()->equals(*srv_cfg->getCfgOptionDef())) {
+                subnets_parser.setCurrentSubnets(current_cfg->getCfgSubnets4());
+            }
+            util::Stopwatch stopwatch;
+            size_t subnets_count = subnets_parser.parse(srv_cfg, subnet4);
+            stopwatch.stop();
+            LOG_INFO(dhcp4_logger, DHCP4_CONFIG_SUBNETS)
+                .arg(subnets_count)
+                .arg(subnets_parser.getReusedCount())
+                .arg(stopwatch.logFormatLastDuration());
         }
 
         ConstElementPtr reservations = mutable_cfg->get("reservations");
@@ -729,6 +751,33 @@ configureDhcp4Server(Dhcpv4Srv& server, isc::data::ConstElementPtr config_set,
         }
     }
 
+    // Rollback changes as the configuration parsing failed.
+    if (rollback) {
+        // Revert to original configuration of runtime option definitions
+        // in the libdhcp++.
+        LibDHCP::revertRuntimeOptionDefs();
+        return (answer);
+    }
+
+    answer = isc::config::createAnswer(CONTROL_RESULT_SUCCESS, "Configuration parsed.");
+    return (answer);
+}
+
+isc::data::ConstElementPtr
+commitDhcp4Server(Dhcpv4Srv& server, bool background) {
+    // Answer will hold the result.
+    ConstElementPtr answer;
+    // Rollback informs whether error occurred and original data
+    // have to be restored to global storages.
+    bool rollback = false;
+    SrvConfigPtr srv_cfg = CfgMgr::instance().getStagingCfg();
+
+    // The server resources were left untouched by the parsing in the
+    // background.
+    if (background) {
+        closeServerResources(server);
+    }
+
     // So far so good, there was no parsing error so let's commit the
     // configuration. This will add created subnets and option values into
     // the server's configuration.
@@ -736,6 +785,13 @@ configureDhcp4Server(Dhcpv4Srv& server, isc::data::ConstElementPtr config_set,
     if (!rollback) {
         try {
 
+            // Re-detect the interfaces, which was skipped by the parsing
+            // in the background.
+            if (background && srv_cfg->getCfgIface()->getReDetect()) {
+                IfaceMgr::instance().clearIfaces();
+                IfaceMgr::instance().detectIfaces();
+            }
+
             // Setup the command channel.
             configureCommandChannel();
 
@@ -819,5 +875,28 @@ configureDhcp4Server(Dhcpv4Srv& server, isc::data::ConstElementPtr config_set,
     return (answer);
 }
 
+isc::data::ConstElementPtr
+configureDhcp4Server(Dhcpv4Srv& server, isc::data::ConstElementPtr config_set,
+                     bool check_only) {
+    if (!config_set) {
+        ConstElementPtr answer = isc::config::createAnswer(CONTROL_RESULT_ERROR,
+                                 string("Can't parse NULL config"));
+        return (answer);
+    }
+
+    // Close DHCP sockets and remove any existing timers.
+    if (!check_only) {
+        closeServerResources(server);
+    }
+
+    ConstElementPtr answer = parseDhcp4Server(server, config_set, check_only);
+    int rcode = CONTROL_RESULT_ERROR;
+    isc::config::parseAnswer(rcode, answer);
+    if (check_only || (rcode != CONTROL_RESULT_SUCCESS)) {
+        return (answer);
+    }
+    return (commitDhcp4Server(server));
+}
+
 }  // namespace dhcp
 }  // namespace isc
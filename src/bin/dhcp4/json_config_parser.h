@@ -1,4 +1,4 @@
-// Copyright (C) 2012-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2012-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -60,6 +60,42 @@ configureDhcp4Server(Dhcpv4Srv&,
                      isc::data::ConstElementPtr config_set,
                      bool check_only = false);
 
+/// @brief Parses a DHCPv4 server configuration.
+///
+/// This is the first step of @ref configureDhcp4Server: the configuration
+/// is parsed and validated into the staging configuration.
+///
+/// When the configuration is parsed in the background, i.e. while other
+/// threads process the packets with the current configuration, the server
+/// resources and the interfaces are left
+/// untouched: the commit takes care of them. The caller must restrict the
+/// uncommitted runtime option definitions to the parsing thread (see
+/// @c LibDHCP::setRuntimeOptionDefsThread) and allocate the staging
+/// configuration beforehand.
+///
+/// @param config_set a new configuration (JSON) for DHCPv4 server
+/// @param check_only whether this configuration is for testing only
+/// @param background whether the configuration is parsed in the background
+/// @return answer that contains result of the parsing
+isc::data::ConstElementPtr
+parseDhcp4Server(Dhcpv4Srv&,
+                 isc::data::ConstElementPtr config_set,
+                 bool check_only = false,
+                 bool background = false);
+
+/// @brief Commits a parsed DHCPv4 server configuration.
+///
+/// This is the second step of @ref configureDhcp4Server: the command
+/// channel, the DHCP-DDNS client, the hooks libraries and the config
+/// backends are configured from the staging configuration.
+///
+/// @param background whether the configuration was parsed in the
+/// background: the server resources are closed and the interfaces are
+/// re-detected, if configured, before the commit.
+/// @return answer that contains result of reconfiguration
+isc::data::ConstElementPtr
+commitDhcp4Server(Dhcpv4Srv&, bool background = false);
+
 }  // namespace dhcp
 }  // namespace isc
 
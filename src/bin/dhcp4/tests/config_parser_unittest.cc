@@ -5657,7 +5657,8 @@ TEST_F(Dhcp4ParserTest, expiredLeasesProcessing) {
         "    \"hold-reclaimed-time\": 1800,"
         "    \"max-reclaim-leases\": 50,"
         "    \"max-reclaim-time\": 100,"
-        "    \"unwarned-reclaim-cycles\": 10"
+        "    \"unwarned-reclaim-cycles\": 10,"
+        "    \"background-reclamation\": true"
         "},"
         "\"subnet4\": [ ]"
         "}";
@@ -5684,6 +5685,7 @@ TEST_F(Dhcp4ParserTest, expiredLeasesProcessing) {
     EXPECT_EQ(50, cfg->getMaxReclaimLeases());
     EXPECT_EQ(100, cfg->getMaxReclaimTime());
     EXPECT_EQ(10, cfg->getUnwarnedReclaimCycles());
+    EXPECT_TRUE(cfg->getBackgroundReclamation());
 }
 
 // Check that invalid configuration for the expired leases processing is
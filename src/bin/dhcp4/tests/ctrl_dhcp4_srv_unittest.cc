@@ -542,6 +542,8 @@ TEST_F(CtrlChannelDhcpv4SrvTest, commandsRegistration) {
     EXPECT_TRUE(command_list.find("\"config-write\"") != string::npos);
     EXPECT_TRUE(command_list.find("\"leases-reclaim\"") != string::npos);
     EXPECT_TRUE(command_list.find("\"libreload\"") != string::npos);
+    EXPECT_TRUE(command_list.find("\"packet-profile-get\"") != string::npos);
+    EXPECT_TRUE(command_list.find("\"packet-profile-set\"") != string::npos);
     EXPECT_TRUE(command_list.find("\"server-tag-get\"") != string::npos);
     EXPECT_TRUE(command_list.find("\"shutdown\"") != string::npos);
     EXPECT_TRUE(command_list.find("\"statistic-get\"") != string::npos);
@@ -623,6 +625,7 @@ TEST_F(CtrlChannelDhcpv4SrvTest, controlChannelStats) {
         "pkt4-inform-received",
         "pkt4-unknown-received",
         "pkt4-sent",
+        "pkt4-send-fail",
         "pkt4-offer-sent",
         "pkt4-ack-sent",
         "pkt4-nak-sent",
@@ -870,6 +873,160 @@ TEST_F(CtrlChannelDhcpv4SrvTest, configSet) {
     CfgMgr::instance().clear();
 }
 
+// Check that the "config-set" command parses the new configuration in the
+// background when it is enabled by the current configuration and that a
+// failed background parsing keeps the current configuration.
+TEST_F(CtrlChannelDhcpv4SrvTest, configSetBackground) {
+    createUnixChannelServer();
+
+    string set_config_txt = "{ \"command\": \"config-set\" \n";
+    string args_txt = " \"arguments\": { \n";
+    string dhcp4_cfg_txt =
+        "    \"Dhcp4\": { \n"
+        "        \"interfaces-config\": { \n"
+        "            \"interfaces\": [\"*\"] \n"
+        "        },   \n"
+        "        \"valid-lifetime\": 4000, \n"
+        "        \"renew-timer\": 1000, \n"
+        "        \"rebind-timer\": 2000, \n"
+        "        \"lease-database\": { \n"
+        "           \"type\": \"memfile\", \n"
+        "           \"persist\":false, \n"
+        "           \"lfc-interval\": 0  \n"
+        "        }, \n"
+        "        \"expired-leases-processing\": { \n"
+        "            \"reclaim-timer-wait-time\": 0, \n"
+        "            \"hold-reclaimed-time\": 0, \n"
+        "            \"flush-reclaimed-timer-wait-time\": 0 \n"
+        "        },"
+        "        \"multi-threading\": { \n"
+        "            \"enable-multi-threading\": true, \n"
+        "            \"thread-pool-size\": 2, \n"
+        "            \"packet-queue-size\": 16, \n"
+        "            \"background-config-parsing\": true \n"
+        "        },"
+        "        \"subnet4\": [ \n";
+    string subnet1 =
+        "               {\"subnet\": \"192.2.0.0/24\", \n"
+        "                \"pools\": [{ \"pool\": \"192.2.0.1-192.2.0.50\" }]}\n";
+    string subnet2 =
+        "               {\"subnet\": \"192.2.1.0/24\", \n"
+        "                \"pools\": [{ \"pool\": \"192.2.1.1-192.2.1.50\" }]}\n";
+    string bad_subnet =
+        "               {\"comment\": \"192.2.2.0/24\", \n"
+        "                \"pools\": [{ \"pool\": \"192.2.2.1-192.2.2.50\" }]}\n";
+    string subnet_footer =
+        "          ] \n";
+    string option_def =
+        "    ,\"option-def\": [\n"
+        "    {\n"
+        "        \"name\": \"foo\",\n"
+        "        \"code\": 163,\n"
+        "        \"type\": \"uint32\",\n"
+        "        \"space\": \"dhcp4\"\n"
+        "    }\n"
+        "]\n";
+    string bad_option_def =
+        "    ,\"option-def\": [\n"
+        "    {\n"
+        "        \"name\": \"bar\",\n"
+        "        \"code\": 164,\n"
+        "        \"type\": \"uint32\",\n"
+        "        \"space\": \"dhcp4\"\n"
+        "    }\n"
+        "]\n";
+    string control_socket_header =
+        "       ,\"control-socket\": { \n"
+        "       \"socket-type\": \"unix\", \n"
+        "       \"socket-name\": \"";
+    string control_socket_footer =
+        "\"   \n} \n";
+
+    // The current configuration does not enable the background parsing so
+    // this one is parsed by the usual path. It enables it for the next ones.
+    std::ostringstream os;
+    os << set_config_txt << ","
+        << args_txt
+        << dhcp4_cfg_txt
+        << subnet1
+        << subnet_footer
+        << control_socket_header
+        << socket_path_
+        << control_socket_footer
+        << "}\n"                      // close dhcp4
+        << "}}";
+
+    std::string response;
+    sendUnixCommand(os.str(), response);
+    EXPECT_EQ("{ \"result\": 0, \"text\": \"Configuration successful.\" }",
+              response);
+    ASSERT_TRUE(MultiThreadingMgr::instance().getMode());
+    EXPECT_EQ(2, MultiThreadingMgr::instance().getThreadPool().size());
+
+    // This configuration is parsed in the background while the packet
+    // processing threads run.
+    os.str("");
+    os << set_config_txt << ","
+        << args_txt
+        << dhcp4_cfg_txt
+        << subnet1
+        << ",\n"
+        << subnet2
+        << subnet_footer
+        << option_def
+        << control_socket_header
+        << socket_path_
+        << control_socket_footer
+        << "}\n"                      // close dhcp4
+        << "}}";
+
+    sendUnixCommand(os.str(), response);
+    EXPECT_EQ("{ \"result\": 0, \"text\": \"Configuration successful.\" }",
+              response);
+
+    // Check that the config was applied and that multi-threading was
+    // applied again.
+    const Subnet4Collection* subnets =
+        CfgMgr::instance().getCurrentCfg()->getCfgSubnets4()->getAll();
+    EXPECT_EQ(2, subnets->size());
+    EXPECT_TRUE(LibDHCP::getRuntimeOptionDef(DHCP4_OPTION_SPACE, 163));
+    ASSERT_TRUE(MultiThreadingMgr::instance().getMode());
+    EXPECT_EQ(2, MultiThreadingMgr::instance().getThreadPool().size());
+
+    // This configuration fails to parse in the background.
+    os.str("");
+    os << set_config_txt << ","
+        << args_txt
+        << dhcp4_cfg_txt
+        << bad_subnet
+        << subnet_footer
+        << bad_option_def
+        << control_socket_header
+        << socket_path_
+        << control_socket_footer
+        << "}\n"                      // close dhcp4
+        << "}}";
+
+    sendUnixCommand(os.str(), response);
+    EXPECT_EQ("{ \"result\": 1, "
+              "\"text\": \"subnet configuration failed: mandatory 'subnet' "
+              "parameter is missing for a subnet being configured (<wire>:24:17)\" }",
+              response);
+
+    // Check that the current config, the runtime option definitions and
+    // multi-threading were kept.
+    subnets = CfgMgr::instance().getCurrentCfg()->getCfgSubnets4()->getAll();
+    EXPECT_EQ(2, subnets->size());
+    EXPECT_TRUE(LibDHCP::getRuntimeOptionDef(DHCP4_OPTION_SPACE, 163));
+    EXPECT_FALSE(LibDHCP::getRuntimeOptionDef(DHCP4_OPTION_SPACE, 164));
+    EXPECT_TRUE(MultiThreadingMgr::instance().getMode());
+    EXPECT_EQ(2, MultiThreadingMgr::instance().getThreadPool().size());
+
+    // Clean up after the test.
+    MultiThreadingMgr::instance().apply(false, 0, 0);
+    CfgMgr::instance().clear();
+}
+
 // Tests if the server returns its configuration using config-get.
 // Note there are separate tests that verify if toElement() called by the
 // config-get handler are actually converting the configuration correctly.
@@ -1312,6 +1469,8 @@ TEST_F(CtrlChannelDhcpv4SrvTest, listCommands) {
     checkListCommands(rsp, "list-commands");
     checkListCommands(rsp, "leases-reclaim");
     checkListCommands(rsp, "libreload");
+    checkListCommands(rsp, "packet-profile-get");
+    checkListCommands(rsp, "packet-profile-set");
     checkListCommands(rsp, "version-get");
     checkListCommands(rsp, "server-tag-get");
     checkListCommands(rsp, "shutdown");
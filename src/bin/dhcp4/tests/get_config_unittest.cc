@@ -2357,6 +2357,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -2437,6 +2438,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -2541,6 +2543,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -2645,6 +2648,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -2755,6 +2759,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -2936,6 +2941,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3117,6 +3123,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3223,6 +3230,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3332,6 +3340,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3441,6 +3450,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": false,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3547,6 +3557,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3653,6 +3664,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3786,6 +3798,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3918,6 +3931,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4051,6 +4065,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4183,6 +4198,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4293,6 +4309,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4432,6 +4449,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4538,6 +4556,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4626,6 +4645,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4714,6 +4734,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4811,6 +4832,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4899,6 +4921,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4987,6 +5010,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5075,6 +5099,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5163,6 +5188,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5286,6 +5312,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5409,6 +5436,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5542,6 +5570,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5658,6 +5687,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5817,6 +5847,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5949,6 +5980,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6098,6 +6130,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6221,6 +6254,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6349,6 +6383,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6472,6 +6507,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6588,6 +6624,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6738,6 +6775,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6859,6 +6897,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6984,6 +7023,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7064,6 +7104,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7144,6 +7185,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7250,6 +7292,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7356,6 +7399,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7462,6 +7506,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7568,6 +7613,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7674,6 +7720,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7858,6 +7905,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7979,6 +8027,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8238,6 +8287,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8374,6 +8424,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8646,6 +8697,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8780,6 +8832,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8858,6 +8911,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8936,6 +8990,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9014,6 +9069,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 35,\n"
 "            \"hold-reclaimed-time\": 1800,\n"
 "            \"max-reclaim-leases\": 50,\n"
@@ -9092,6 +9148,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9198,6 +9255,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9304,6 +9362,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9410,6 +9469,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9516,6 +9576,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9648,6 +9709,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9775,6 +9837,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9877,6 +9940,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9983,6 +10047,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -10090,6 +10155,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -10201,6 +10267,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -10312,6 +10379,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -10450,6 +10518,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -10631,6 +10700,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -10817,6 +10887,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -10980,6 +11051,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -11111,6 +11183,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -11242,6 +11315,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -11322,6 +11396,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -11400,6 +11475,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        \"dhcp4o6-port\": 0,\n"
 "        \"echo-client-id\": true,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
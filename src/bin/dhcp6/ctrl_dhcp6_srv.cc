@@ -26,10 +26,14 @@
 #include <hooks/hooks_manager.h>
 #include <stats/stats_mgr.h>
 #include <util/multi_threading_mgr.h>
+#include <util/stopwatch.h>
 
 #include <signal.h>
 
+#include <atomic>
+#include <chrono>
 #include <sstream>
+#include <thread>
 
 using namespace isc::asiolink;
 using namespace isc::config;
@@ -84,6 +88,46 @@ void signalHandler(int signo) {
     }
 }
 
+/// @brief Minimum interval between two send batch failure reports.
+const chrono::seconds SEND_FAIL_LOG_INTERVAL(1);
+
+/// @brief Number of send batch failures not yet reported.
+atomic<uint64_t> send_fail_unreported(0);
+
+/// @brief Time of the last send batch failure report.
+atomic<chrono::steady_clock::rep> send_fail_last_report(0);
+
+/// @brief Handles the failures of the send batcher.
+///
+/// Called by the thread sending a batch: updates the pkt6-send-fail
+/// statistic and logs the failures at most once per second.
+///
+/// @param failures Number of messages of the batch which were not sent.
+/// @param error Last send error.
+void sendBatchErrorHandler(uint64_t failures, const string& error) {
+    StatsMgr::instance().addValue("pkt6-send-fail",
+                                  static_cast<int64_t>(failures));
+    send_fail_unreported += failures;
+
+    auto now = chrono::steady_clock::now().time_since_epoch().count();
+    auto last = send_fail_last_report.load();
+    auto interval = chrono::duration_cast<chrono::steady_clock::duration>(
+        SEND_FAIL_LOG_INTERVAL).count();
+    if ((last != 0) && (now - last < interval)) {
+        return;
+    }
+    if (!send_fail_last_report.compare_exchange_strong(last, now)) {
+        // Another thread is reporting.
+        return;
+    }
+    uint64_t count = send_fail_unreported.exchange(0);
+    if (count > 0) {
+        LOG_ERROR(packet6_logger, DHCP6_PACKET_SEND_BATCH_FAIL)
+            .arg(count)
+            .arg(error);
+    }
+}
+
 }
 
 namespace isc {
@@ -381,6 +425,15 @@ ControlledDhcpv6Srv::commandConfigSetHandler(const string&,
         return (result);
     }
 
+    // Parse the new configuration in the background when it is enabled
+    // by the current configuration.
+    if (MultiThreadingMgr::instance().getMode() &&
+        !MultiThreadingMgr::instance().isInCriticalSection() &&
+        CfgMultiThreading::backgroundConfigParsing(
+            CfgMgr::instance().getCurrentCfg()->getDHCPMultiThreading())) {
+        return (processConfigInBackground(dhcp6));
+    }
+
     // stop thread pool (if running)
     MultiThreadingCriticalSection cs;
 
@@ -884,6 +937,17 @@ ControlledDhcpv6Srv::processConfig(isc::data::ConstElementPtr config) {
         return (isc::config::createAnswer(1, err.str()));
     }
 
+    return (applyConfig(config, answer));
+}
+
+isc::data::ConstElementPtr
+ControlledDhcpv6Srv::applyConfig(isc::data::ConstElementPtr config,
+                                 isc::data::ConstElementPtr answer) {
+    ControlledDhcpv6Srv* srv = ControlledDhcpv6Srv::getInstance();
+
+    // Single stream instance used in all error clauses
+    std::ostringstream err;
+
     // Re-open lease and host database with new parameters.
     try {
         DatabaseConnection::db_lost_callback_ =
@@ -958,6 +1022,44 @@ ControlledDhcpv6Srv::processConfig(isc::data::ConstElementPtr config) {
         return (isc::config::createAnswer(1, err.str()));
     }
 
+    // Configure the interface receiver threads. When they are enabled the
+    // packets are read by one thread per interface and handed in turn to
+    // the per thread queues of the thread pool. The receivers are started
+    // when the sockets are opened below.
+    try {
+        bool receiver_threads = CfgMultiThreading::receiverThreads(
+            CfgMgr::instance().getStagingCfg()->getDHCPMultiThreading());
+        IfaceMgr::instance().stopIfaceReceivers();
+        if (receiver_threads) {
+            IfaceMgr::instance().setPacketReceiverCallback6(
+                std::bind(&Dhcpv6Srv::receivePacketCallback, srv, ph::_1));
+        } else {
+            IfaceMgr::instance().setPacketReceiverCallback6(IfaceMgr::PacketReceiverCallback6());
+        }
+        MultiThreadingMgr::instance().getThreadPool().setThreadQueues(receiver_threads);
+    } catch (const std::exception& ex) {
+        err << "Error setting receiver threads after server reconfiguration: "
+            << ex.what();
+        return (isc::config::createAnswer(1, err.str()));
+    }
+
+    // Configure the batching of the sent packets.
+    try {
+        data::ConstElementPtr mt =
+            CfgMgr::instance().getStagingCfg()->getDHCPMultiThreading();
+        IfaceMgr::instance().configureSendBatcher(
+            CfgMultiThreading::sendBatchSize(mt),
+            CfgMultiThreading::sendBatchDelay(mt));
+        PktSendBatcherPtr batcher = IfaceMgr::instance().getSendBatcher();
+        if (batcher) {
+            batcher->setErrorHandler(sendBatchErrorHandler);
+        }
+    } catch (const std::exception& ex) {
+        err << "Error setting send batching after server reconfiguration: "
+            << ex.what();
+        return (isc::config::createAnswer(1, err.str()));
+    }
+
     // Configuration may change active interfaces. Therefore, we have to reopen
     // sockets according to new configuration. It is possible that this
     // operation will fail for some interfaces but the openSockets function
@@ -968,12 +1070,29 @@ ControlledDhcpv6Srv::processConfig(isc::data::ConstElementPtr config) {
     CfgMgr::instance().getStagingCfg()->getCfgIface()->
         openSockets(AF_INET6, srv->getServerPort());
 
-    // Install the timers for handling leases reclamation.
+    // Install the timers for handling leases reclamation. When the leases
+    // are reclaimed by the background thread only the timer flushing the
+    // expired-reclaimed leases is installed.
     try {
-        CfgMgr::instance().getStagingCfg()->getCfgExpiration()->
-            setupTimers(&ControlledDhcpv6Srv::reclaimExpiredLeases,
-                        &ControlledDhcpv6Srv::deleteExpiredReclaimedLeases,
-                        server_);
+        ConstCfgExpirationPtr cfg_expiration =
+            CfgMgr::instance().getStagingCfg()->getCfgExpiration();
+        // The background thread is used only in multi-threading mode.
+        bool enabled = false;
+        uint32_t thread_count = 0;
+        uint32_t queue_size = 0;
+        CfgMultiThreading::extract(
+            CfgMgr::instance().getStagingCfg()->getDHCPMultiThreading(),
+            enabled, thread_count, queue_size);
+        bool background = enabled && cfg_expiration->getBackgroundReclamation();
+        if (!srv->lease_reclaimer_) {
+            srv->lease_reclaimer_.reset(new LeaseReclaimer(srv->alloc_engine_,
+                                                           AF_INET6,
+                                                           srv->inTestMode()));
+        }
+        srv->lease_reclaimer_->configure(background, *cfg_expiration);
+        cfg_expiration->setupTimers(&ControlledDhcpv6Srv::reclaimExpiredLeases,
+                                    &ControlledDhcpv6Srv::deleteExpiredReclaimedLeases,
+                                    server_, !srv->lease_reclaimer_->isEnabled());
 
     } catch (const std::exception& ex) {
         err << "unable to setup timers for periodically running the"
@@ -1046,6 +1165,114 @@ ControlledDhcpv6Srv::processConfig(isc::data::ConstElementPtr config) {
         return (isc::config::createAnswer(CONTROL_RESULT_ERROR, err.str()));
     }
 
+    // Set the number of threads processing the thread safe commands. Inside
+    // a critical section they are started when the critical section is exited.
+    try {
+        CommandMgr::instance().setThreadPoolSize(CfgMultiThreading::commandThreads(
+            CfgMgr::instance().getStagingCfg()->getDHCPMultiThreading()));
+    } catch (const std::exception& ex) {
+        err << "Error starting the command threads: " << ex.what();
+        return (isc::config::createAnswer(CONTROL_RESULT_ERROR, err.str()));
+    }
+
+    // Start the background leases reclaimer. Inside a critical section it
+    // is started when the critical section is exited.
+    if (!MultiThreadingMgr::instance().isInCriticalSection()) {
+        try {
+            srv->lease_reclaimer_->start();
+        } catch (const std::exception& ex) {
+            err << "Error starting the background leases reclamation: "
+                << ex.what();
+            return (isc::config::createAnswer(CONTROL_RESULT_ERROR, err.str()));
+        }
+    }
+
+    return (answer);
+}
+
+isc::data::ConstElementPtr
+ControlledDhcpv6Srv::processConfigInBackground(isc::data::ConstElementPtr config) {
+    LOG_DEBUG(dhcp6_logger, DBG_DHCP6_COMMAND, DHCP6_CONFIG_RECEIVED)
+        .arg(redactConfig(config)->str());
+
+    // Remove the staging configuration of previous attempts and parse the
+    // logger configuration into a new one.
+    CfgMgr::instance().rollback();
+    Daemon::configureLogger(config, CfgMgr::instance().getStagingCfg());
+
+    // Parse the configuration on this thread without stopping the packet
+    // processing threads: they keep using the current configuration and
+    // the committed runtime option definitions, the staged ones are only
+    // visible to this thread.
+    Stopwatch parse_stopwatch;
+    ConstElementPtr answer;
+    LibDHCP::setRuntimeOptionDefsThread(std::this_thread::get_id());
+    try {
+        answer = parseDhcp6Server(*this, config, false, true);
+    } catch (const std::exception& ex) {
+        answer = isc::config::createAnswer(CONTROL_RESULT_ERROR, ex.what());
+    }
+    parse_stopwatch.stop();
+
+    // The runtime option definitions thread is cleared only with the
+    // packet processing threads stopped, after the staged definitions
+    // were committed or reverted, so they never see staged definitions.
+    int rcode = CONTROL_RESULT_ERROR;
+    isc::config::parseAnswer(rcode, answer);
+    if (rcode != CONTROL_RESULT_SUCCESS) {
+        MultiThreadingCriticalSection cs;
+        LibDHCP::revertRuntimeOptionDefs();
+        LibDHCP::setRuntimeOptionDefsThread(std::thread::id());
+        CfgMgr::instance().rollback();
+        return (answer);
+    }
+
+    // Commit and apply the new configuration. The packet processing
+    // threads are stopped only for this part.
+    Stopwatch commit_stopwatch;
+    {
+        MultiThreadingCriticalSection cs;
+
+        // The commit uses the staged runtime option definitions.
+        LibDHCP::setRuntimeOptionDefsThread(std::thread::id());
+
+        // Disable multi-threading (it will be applied by new configuration).
+        MultiThreadingMgr::instance().apply(false, 0, 0);
+
+        // Apply the new logging before the commit so what is wrong with
+        // the new configuration is logged with it.
+        CfgMgr::instance().getStagingCfg()->applyLoggingCfg();
+
+        answer = commitDhcp6Server(*this, true);
+        isc::config::parseAnswer(rcode, answer);
+        if (rcode == CONTROL_RESULT_SUCCESS) {
+            answer = applyConfig(config, answer);
+            isc::config::parseAnswer(rcode, answer);
+        }
+
+        if (rcode == CONTROL_RESULT_SUCCESS) {
+            // Use new configuration.
+            CfgMgr::instance().commit();
+        } else {
+            // Revert the runtime option definitions if they were not
+            // committed.
+            LibDHCP::revertRuntimeOptionDefs();
+
+            // Revert to the previous logging configuration.
+            CfgMgr::instance().getCurrentCfg()->applyLoggingCfg();
+
+            if (CfgMgr::instance().getCurrentCfg()->getSequence() != 0) {
+                LOG_FATAL(dhcp6_logger, DHCP6_CONFIG_UNRECOVERABLE_ERROR);
+            }
+            return (answer);
+        }
+    }
+    commit_stopwatch.stop();
+
+    LOG_INFO(dhcp6_logger, DHCP6_CONFIG_BACKGROUND)
+        .arg(parse_stopwatch.logFormatLastDuration())
+        .arg(commit_stopwatch.logFormatLastDuration());
+
     return (answer);
 }
 
@@ -1164,6 +1391,14 @@ ControlledDhcpv6Srv::ControlledDhcpv6Srv(uint16_t server_port,
 
     CommandMgr::instance().registerCommand("statistic-sample-count-set-all",
         std::bind(&ControlledDhcpv6Srv::commandStatisticSetMaxSampleCountAllHandler, this, ph::_1, ph::_2));
+
+    // Mark the commands which can be processed by the command threads.
+    // Only one config-get is processed at a time as it is expensive.
+    CommandMgr::instance().setThreadSafe("build-report");
+    CommandMgr::instance().setThreadSafe("config-get", 1);
+    CommandMgr::instance().setThreadSafe("statistic-get");
+    CommandMgr::instance().setThreadSafe("statistic-get-all");
+    CommandMgr::instance().setThreadSafe("version-get");
 }
 
 void ControlledDhcpv6Srv::shutdownServer(int exit_value) {
@@ -1174,6 +1409,12 @@ void ControlledDhcpv6Srv::shutdownServer(int exit_value) {
 
 ControlledDhcpv6Srv::~ControlledDhcpv6Srv() {
     try {
+        // Stop the command threads before the lease database is closed.
+        CommandMgr::instance().setThreadPoolSize(0);
+
+        // Stop the background leases reclaimer before the lease database
+        // is closed.
+        lease_reclaimer_.reset();
         LeaseMgrFactory::destroy();
         HostMgr::create();
         cleanup();
@@ -192,6 +192,7 @@ std::set<std::string> dhcp6_statistics = {
     "pkt6-dhcpv4-response-received",
     "pkt6-unknown-received",
     "pkt6-sent",
+    "pkt6-send-fail",
     "pkt6-advertise-sent",
     "pkt6-reply-sent",
     "pkt6-dhcpv4-response-sent",
@@ -280,6 +281,9 @@ Dhcpv6Srv::~Dhcpv6Srv() {
 
     IfaceMgr::instance().closeSockets();
 
+    // The interface receivers are stopped so the callback can be cleared.
+    IfaceMgr::instance().setPacketReceiverCallback6(IfaceMgr::PacketReceiverCallback6());
+
     LeaseMgrFactory::destroy();
 
     // Explicitly unload hooks
@@ -363,7 +367,7 @@ Dhcpv6Srv::initContext(const Pkt6Ptr& pkt,
     ctx.rev_dns_update_ = false;
     ctx.hostname_ = "";
     ctx.query_ = pkt;
-    ctx.callout_handle_ = getCalloutHandle(pkt);
+    ctx.callout_handle_ = getCalloutHandleIfPresent(pkt);
     ctx.hwaddr_ = getMAC(pkt);
 
     if (drop) {
@@ -608,19 +612,55 @@ void Dhcpv6Srv::run_one() {
         return;
     } else {
         if (MultiThreadingMgr::instance().getMode()) {
-            typedef function<void()> CallBack;
-            boost::shared_ptr<CallBack> call_back =
-                boost::make_shared<CallBack>(std::bind(&Dhcpv6Srv::processPacketAndSendResponseNoThrow,
-                                                       this, query));
-            if (!MultiThreadingMgr::instance().getThreadPool().add(call_back)) {
-                LOG_DEBUG(dhcp6_logger, DBG_DHCP6_BASIC, DHCP6_PACKET_QUEUE_FULL);
-            }
+            addPacketToThreadPool(query);
         } else {
             processPacketAndSendResponse(query);
         }
     }
 }
 
+void
+Dhcpv6Srv::receivePacketCallback(const Pkt6Ptr& query) {
+    try {
+        LOG_DEBUG(packet6_logger, DBG_DHCP6_BASIC, DHCP6_BUFFER_RECEIVED)
+            .arg(query->getRemoteAddr().toText())
+            .arg(query->getRemotePort())
+            .arg(query->getLocalAddr().toText())
+            .arg(query->getLocalPort())
+            .arg(query->getIface());
+
+        // Log reception of the packet (see run_one).
+        StatsMgr::instance().addValue("pkt6-received", static_cast<int64_t>(1));
+
+        // If the DHCP service has been globally disabled, drop the packet.
+        if (!network_state_->isServiceEnabled()) {
+            LOG_DEBUG(bad_packet6_logger, DBGLVL_PKT_HANDLING, DHCP6_PACKET_DROP_DHCP_DISABLED)
+                .arg(query->getLabel());
+            return;
+        }
+
+        // The packet is always processed by the thread pool: it is started
+        // once the multi-threading configuration is applied.
+        addPacketToThreadPool(query);
+    } catch (const std::exception& e) {
+        LOG_ERROR(packet6_logger, DHCP6_PACKET_PROCESS_STD_EXCEPTION)
+            .arg(e.what());
+    } catch (...) {
+        LOG_ERROR(packet6_logger, DHCP6_PACKET_PROCESS_EXCEPTION);
+    }
+}
+
+void
+Dhcpv6Srv::addPacketToThreadPool(const Pkt6Ptr& query) {
+    typedef function<void()> CallBack;
+    boost::shared_ptr<CallBack> call_back =
+        boost::make_shared<CallBack>(std::bind(&Dhcpv6Srv::processPacketAndSendResponseNoThrow,
+                                               this, query));
+    if (!MultiThreadingMgr::instance().getThreadPool().add(call_back)) {
+        LOG_DEBUG(dhcp6_logger, DBG_DHCP6_BASIC, DHCP6_PACKET_QUEUE_FULL);
+    }
+}
+
 void
 Dhcpv6Srv::processPacketAndSendResponseNoThrow(Pkt6Ptr& query) {
     try {
@@ -641,7 +681,7 @@ Dhcpv6Srv::processPacketAndSendResponse(Pkt6Ptr& query) {
         return;
     }
 
-    CalloutHandlePtr callout_handle = getCalloutHandle(query);
+    CalloutHandlePtr callout_handle = getCalloutHandleIfPresent(query);
     processPacketBufferSend(callout_handle, rsp);
 }
 
@@ -974,7 +1014,7 @@ Dhcpv6Srv::processDhcp6Query(Pkt6Ptr& query, Pkt6Ptr& rsp) {
     rsp->setIndex(query->getIndex());
     rsp->setIface(query->getIface());
 
-    CalloutHandlePtr callout_handle = getCalloutHandle(query);
+    CalloutHandlePtr callout_handle = getCalloutHandleIfPresent(query);
     if (!ctx.fake_allocation_ && (ctx.query_->getType() != DHCPV6_CONFIRM) &&
         (ctx.query_->getType() != DHCPV6_INFORMATION_REQUEST) &&
         HooksManager::calloutsPresent(Hooks.hook_index_leases6_committed_)) {
@@ -149,6 +149,21 @@ public:
     /// a response.
     void run_one();
 
+    /// @brief Handles a packet read by an interface receiver thread.
+    ///
+    /// Called in the interface receiver threads when they are enabled (see
+    /// @c IfaceMgr::setPacketReceiverCallback6). It drops the packet when
+    /// the service is disabled, otherwise it adds the packet to the thread
+    /// pool.
+    ///
+    /// @param query A pointer to the received packet.
+    void receivePacketCallback(const Pkt6Ptr& query);
+
+    /// @brief Adds a received packet to the thread pool.
+    ///
+    /// @param query A pointer to the packet to be processed.
+    void addPacketToThreadPool(const Pkt6Ptr& query);
+
     /// @brief Process a single incoming DHCPv6 packet and sends the response.
     ///
     /// It verifies correctness of the passed packet, calls per-type processXXX
@@ -44,6 +44,7 @@
 #include <process/config_ctl_parser.h>
 
 #include <util/encode/hex.h>
+#include <util/stopwatch.h>
 #include <util/strutil.h>
 
 #include <boost/algorithm/string.hpp>
@@ -375,6 +376,20 @@ public:
     }
 };
 
+/// @brief Closes the server resources depending on the configuration.
+///
+/// The DHCP sockets are closed, the timers are removed, the packets waiting
+/// for processing are discarded and the config backends are reset.
+///
+/// @param server Reference to the server.
+void
+closeServerResources(Dhcpv6Srv& server) {
+    IfaceMgr::instance().closeSockets();
+    TimerMgr::instance()->unregisterTimers();
+    server.discardPackets();
+    server.getCBControl()->reset();
+}
+
 } // anonymous namespace
 
 namespace isc {
@@ -422,8 +437,8 @@ void configureCommandChannel() {
 }
 
 isc::data::ConstElementPtr
-configureDhcp6Server(Dhcpv6Srv& server, isc::data::ConstElementPtr config_set,
-                     bool check_only) {
+parseDhcp6Server(Dhcpv6Srv& server, isc::data::ConstElementPtr config_set,
+                 bool check_only, bool background) {
     if (!config_set) {
         ConstElementPtr answer = isc::config::createAnswer(1,
                                  string("Can't parse NULL config"));
@@ -437,14 +452,6 @@ configureDhcp6Server(Dhcpv6Srv& server, isc::data::ConstElementPtr config_set,
     // so newly recreated configuration starts with first subnet-id equal 1.
     Subnet::resetSubnetID();
 
-    // Close DHCP sockets and remove any existing timers.
-    if (!check_only) {
-        IfaceMgr::instance().closeSockets();
-        TimerMgr::instance()->unregisterTimers();
-        server.discardPackets();
-        server.getCBControl()->reset();
-    }
-
     // Revert any runtime option definitions configured so far and not committed.
     LibDHCP::revertRuntimeOptionDefs();
     // Let's set empty container in case a user hasn't specified any configuration
@@ -572,7 +579,10 @@ configureDhcp6Server(Dhcpv6Srv& server, isc::data::ConstElementPtr config_set,
         ConstElementPtr ifaces_config = mutable_cfg->get("interfaces-config");
         if (ifaces_config) {
             parameter_name = "interfaces-config";
-            IfacesConfigParser parser(AF_INET6, check_only);
+            // The interfaces in use are not re-detected when the
+            // configuration is parsed in the background: this is done
+            // by the commit.
+            IfacesConfigParser parser(AF_INET6, check_only || background);
             CfgIfacePtr cfg_iface = srv_config->getCfgIface();
             parser.parse(cfg_iface, ifaces_config);
         }
@@ -681,8 +691,20 @@ configureDhcp6Server(Dhcpv6Srv& server, isc::data::ConstElementPtr config_set,
         if (subnet6) {
             parameter_name = "subnet6";
             Subnets6ListConfigParser subnets_parser;
-            // parse() returns number of subnets parsed. We may log it one day.
-            subnets_parser.parse(srv_config, subnet6);
+            // Take over the unchanged subnets of the current configuration
+            // when the option definitions their options depend on did not
+            // change.
+            SrvConfigPtr current_cfg = CfgMgr::instance().getCurrentCfg();
+            if (current_cfg->getCfgOptionDef()->equals(*srv_config->getCfgOptionDef())) {
+                subnets_parser.setCurrentSubnets(current_cfg->getCfgSubnets6());
+            }
+            util::Stopwatch stopwatch;
+            size_t subnets_count = subnets_parser.parse(srv_config, subnet6);
+            stopwatch.stop();
+            LOG_INFO(dhcp6_logger, DHCP6_CONFIG_SUBNETS)
+                .arg(subnets_count)
+                .arg(subnets_parser.getReusedCount())
+                .arg(stopwatch.logFormatLastDuration());
         }
 
         ConstElementPtr reservations = mutable_cfg->get("reservations");
@@ -863,6 +885,33 @@ configureDhcp6Server(Dhcpv6Srv& server, isc::data::ConstElementPtr config_set,
         }
     }
 
+    // Rollback changes as the configuration parsing failed.
+    if (rollback) {
+        // Revert to original configuration of runtime option definitions
+        // in the libdhcp++.
+        LibDHCP::revertRuntimeOptionDefs();
+        return (answer);
+    }
+
+    answer = isc::config::createAnswer(0, "Configuration parsed.");
+    return (answer);
+}
+
+isc::data::ConstElementPtr
+commitDhcp6Server(Dhcpv6Srv& server, bool background) {
+    // Answer will hold the result.
+    ConstElementPtr answer;
+    // Rollback informs whether error occurred and original data
+    // have to be restored to global storages.
+    bool rollback = false;
+    SrvConfigPtr srv_config = CfgMgr::instance().getStagingCfg();
+
+    // The server resources were left untouched by the parsing in the
+    // background.
+    if (background) {
+        closeServerResources(server);
+    }
+
     // So far so good, there was no parsing error so let's commit the
     // configuration. This will add created subnets and option values into
     // the server's configuration.
@@ -870,6 +919,13 @@ configureDhcp6Server(Dhcpv6Srv& server, isc::data::ConstElementPtr config_set,
     if (!rollback) {
         try {
 
+            // Re-detect the interfaces, which was skipped by the parsing
+            // in the background.
+            if (background && srv_config->getCfgIface()->getReDetect()) {
+                IfaceMgr::instance().clearIfaces();
+                IfaceMgr::instance().detectIfaces();
+            }
+
             // Setup the command channel.
             configureCommandChannel();
 
@@ -953,5 +1009,28 @@ configureDhcp6Server(Dhcpv6Srv& server, isc::data::ConstElementPtr config_set,
     return (answer);
 }
 
+isc::data::ConstElementPtr
+configureDhcp6Server(Dhcpv6Srv& server, isc::data::ConstElementPtr config_set,
+                     bool check_only) {
+    if (!config_set) {
+        ConstElementPtr answer = isc::config::createAnswer(1,
+                                 string("Can't parse NULL config"));
+        return (answer);
+    }
+
+    // Close DHCP sockets and remove any existing timers.
+    if (!check_only) {
+        closeServerResources(server);
+    }
+
+    ConstElementPtr answer = parseDhcp6Server(server, config_set, check_only);
+    int rcode = 1;
+    isc::config::parseAnswer(rcode, answer);
+    if (check_only || (rcode != 0)) {
+        return (answer);
+    }
+    return (commitDhcp6Server(server));
+}
+
 }  // namespace dhcp
 }  // namespace isc
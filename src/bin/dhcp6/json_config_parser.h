@@ -1,4 +1,4 @@
-// Copyright (C) 2012-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2012-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -44,6 +44,43 @@ isc::data::ConstElementPtr
 configureDhcp6Server(Dhcpv6Srv& server, isc::data::ConstElementPtr config_set,
                      bool check_only = false);
 
+/// @brief Parses a DHCPv6 server configuration.
+///
+/// This is the first step of @ref configureDhcp6Server: the configuration
+/// is parsed and validated into the staging configuration.
+///
+/// When the configuration is parsed in the background, i.e. while other
+/// threads process the packets with the current configuration, the server
+/// resources and the interfaces are left
+/// untouched: the commit takes care of them. The caller must restrict the
+/// uncommitted runtime option definitions to the parsing thread (see
+/// @c LibDHCP::setRuntimeOptionDefsThread) and allocate the staging
+/// configuration beforehand.
+///
+/// @param server DHCPv6 server object.
+/// @param config_set a new configuration (JSON) for DHCPv6 server
+/// @param check_only whether this configuration is for testing only
+/// @param background whether the configuration is parsed in the background
+/// @return answer that contains result of the parsing
+isc::data::ConstElementPtr
+parseDhcp6Server(Dhcpv6Srv& server, isc::data::ConstElementPtr config_set,
+                 bool check_only = false,
+                 bool background = false);
+
+/// @brief Commits a parsed DHCPv6 server configuration.
+///
+/// This is the second step of @ref configureDhcp6Server: the command
+/// channel, the DHCP-DDNS client, the hooks libraries and the config
+/// backends are configured from the staging configuration.
+///
+/// @param server DHCPv6 server object.
+/// @param background whether the configuration was parsed in the
+/// background: the server resources are closed and the interfaces are
+/// re-detected, if configured, before the commit.
+/// @return answer that contains result of reconfiguration
+isc::data::ConstElementPtr
+commitDhcp6Server(Dhcpv6Srv& server, bool background = false);
+
 }  // namespace dhcp
 }  // namespace isc
 
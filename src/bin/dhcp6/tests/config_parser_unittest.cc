@@ -6282,7 +6282,8 @@ TEST_F(Dhcp6ParserTest, expiredLeasesProcessing) {
         "    \"hold-reclaimed-time\": 1800,"
         "    \"max-reclaim-leases\": 50,"
         "    \"max-reclaim-time\": 100,"
-        "    \"unwarned-reclaim-cycles\": 10"
+        "    \"unwarned-reclaim-cycles\": 10,"
+        "    \"background-reclamation\": true"
         "},"
         "\"subnet6\": [ ]"
         "}";
@@ -6309,6 +6310,7 @@ TEST_F(Dhcp6ParserTest, expiredLeasesProcessing) {
     EXPECT_EQ(50, cfg->getMaxReclaimLeases());
     EXPECT_EQ(100, cfg->getMaxReclaimTime());
     EXPECT_EQ(10, cfg->getUnwarnedReclaimCycles());
+    EXPECT_TRUE(cfg->getBackgroundReclamation());
 }
 
 // Check that invalid configuration for the expired leases processing is
@@ -783,6 +783,161 @@ TEST_F(CtrlChannelDhcpv6SrvTest, configSet) {
     CfgMgr::instance().clear();
 }
 
+// Check that the "config-set" command parses the new configuration in the
+// background when it is enabled by the current configuration and that a
+// failed background parsing keeps the current configuration.
+TEST_F(CtrlChannelDhcpv6SrvTest, configSetBackground) {
+    createUnixChannelServer();
+
+    string set_config_txt = "{ \"command\": \"config-set\" \n";
+    string args_txt = " \"arguments\": { \n";
+    string dhcp6_cfg_txt =
+        "    \"Dhcp6\": { \n"
+        "        \"interfaces-config\": { \n"
+        "            \"interfaces\": [\"*\"] \n"
+        "        },   \n"
+        "        \"preferred-lifetime\": 3000, \n"
+        "        \"valid-lifetime\": 4000, \n"
+        "        \"renew-timer\": 1000, \n"
+        "        \"rebind-timer\": 2000, \n"
+        "        \"lease-database\": { \n"
+        "           \"type\": \"memfile\", \n"
+        "           \"persist\":false, \n"
+        "           \"lfc-interval\": 0  \n"
+        "        }, \n"
+        "        \"expired-leases-processing\": { \n"
+        "            \"reclaim-timer-wait-time\": 0, \n"
+        "            \"hold-reclaimed-time\": 0, \n"
+        "            \"flush-reclaimed-timer-wait-time\": 0 \n"
+        "        },"
+        "        \"multi-threading\": { \n"
+        "            \"enable-multi-threading\": true, \n"
+        "            \"thread-pool-size\": 2, \n"
+        "            \"packet-queue-size\": 16, \n"
+        "            \"background-config-parsing\": true \n"
+        "        },"
+        "        \"subnet6\": [ \n";
+    string subnet1 =
+        "               {\"subnet\": \"3002::/64\", \n"
+        "                \"pools\": [{ \"pool\": \"3002::100-3002::200\" }]}\n";
+    string subnet2 =
+        "               {\"subnet\": \"3003::/64\", \n"
+        "                \"pools\": [{ \"pool\": \"3003::100-3003::200\" }]}\n";
+    string bad_subnet =
+        "               {\"comment\": \"3005::/64\", \n"
+        "                \"pools\": [{ \"pool\": \"3005::100-3005::200\" }]}\n";
+    string subnet_footer =
+        "          ] \n";
+    string option_def =
+        "    ,\"option-def\": [\n"
+        "    {\n"
+        "        \"name\": \"foo\",\n"
+        "        \"code\": 163,\n"
+        "        \"type\": \"uint32\",\n"
+        "        \"space\": \"dhcp6\"\n"
+        "    }\n"
+        "]\n";
+    string bad_option_def =
+        "    ,\"option-def\": [\n"
+        "    {\n"
+        "        \"name\": \"bar\",\n"
+        "        \"code\": 164,\n"
+        "        \"type\": \"uint32\",\n"
+        "        \"space\": \"dhcp6\"\n"
+        "    }\n"
+        "]\n";
+    string control_socket_header =
+        "       ,\"control-socket\": { \n"
+        "       \"socket-type\": \"unix\", \n"
+        "       \"socket-name\": \"";
+    string control_socket_footer =
+        "\"   \n} \n";
+
+    // The current configuration does not enable the background parsing so
+    // this one is parsed by the usual path. It enables it for the next ones.
+    std::ostringstream os;
+    os << set_config_txt << ","
+        << args_txt
+        << dhcp6_cfg_txt
+        << subnet1
+        << subnet_footer
+        << control_socket_header
+        << socket_path_
+        << control_socket_footer
+        << "}\n"                      // close dhcp6
+        << "}}";
+
+    std::string response;
+    sendUnixCommand(os.str(), response);
+    EXPECT_EQ("{ \"result\": 0, \"text\": \"Configuration successful.\" }",
+              response);
+    ASSERT_TRUE(MultiThreadingMgr::instance().getMode());
+    EXPECT_EQ(2, MultiThreadingMgr::instance().getThreadPool().size());
+
+    // This configuration is parsed in the background while the packet
+    // processing threads run.
+    os.str("");
+    os << set_config_txt << ","
+        << args_txt
+        << dhcp6_cfg_txt
+        << subnet1
+        << ",\n"
+        << subnet2
+        << subnet_footer
+        << option_def
+        << control_socket_header
+        << socket_path_
+        << control_socket_footer
+        << "}\n"                      // close dhcp6
+        << "}}";
+
+    sendUnixCommand(os.str(), response);
+    EXPECT_EQ("{ \"result\": 0, \"text\": \"Configuration successful.\" }",
+              response);
+
+    // Check that the config was applied and that multi-threading was
+    // applied again.
+    const Subnet6Collection* subnets =
+        CfgMgr::instance().getCurrentCfg()->getCfgSubnets6()->getAll();
+    EXPECT_EQ(2, subnets->size());
+    EXPECT_TRUE(LibDHCP::getRuntimeOptionDef(DHCP6_OPTION_SPACE, 163));
+    ASSERT_TRUE(MultiThreadingMgr::instance().getMode());
+    EXPECT_EQ(2, MultiThreadingMgr::instance().getThreadPool().size());
+
+    // This configuration fails to parse in the background.
+    os.str("");
+    os << set_config_txt << ","
+        << args_txt
+        << dhcp6_cfg_txt
+        << bad_subnet
+        << subnet_footer
+        << bad_option_def
+        << control_socket_header
+        << socket_path_
+        << control_socket_footer
+        << "}\n"                      // close dhcp6
+        << "}}";
+
+    sendUnixCommand(os.str(), response);
+    EXPECT_EQ("{ \"result\": 1, "
+              "\"text\": \"subnet configuration failed: mandatory 'subnet' "
+              "parameter is missing for a subnet being configured (<wire>:25:17)\" }",
+              response);
+
+    // Check that the current config, the runtime option definitions and
+    // multi-threading were kept.
+    subnets = CfgMgr::instance().getCurrentCfg()->getCfgSubnets6()->getAll();
+    EXPECT_EQ(2, subnets->size());
+    EXPECT_TRUE(LibDHCP::getRuntimeOptionDef(DHCP6_OPTION_SPACE, 163));
+    EXPECT_FALSE(LibDHCP::getRuntimeOptionDef(DHCP6_OPTION_SPACE, 164));
+    EXPECT_TRUE(MultiThreadingMgr::instance().getMode());
+    EXPECT_EQ(2, MultiThreadingMgr::instance().getThreadPool().size());
+
+    // Clean up after the test.
+    MultiThreadingMgr::instance().apply(false, 0, 0);
+    CfgMgr::instance().clear();
+}
+
 // Tests if the server returns its configuration using config-get.
 // Note there are separate tests that verify if toElement() called by the
 // config-get handler are actually converting the configuration correctly.
@@ -1245,6 +1400,7 @@ TEST_F(CtrlChannelDhcpv6SrvTest, controlChannelStats) {
         "pkt6-dhcpv4-response-received",
         "pkt6-unknown-received",
         "pkt6-sent",
+        "pkt6-send-fail",
         "pkt6-advertise-sent",
         "pkt6-reply-sent",
         "pkt6-dhcpv4-response-sent",
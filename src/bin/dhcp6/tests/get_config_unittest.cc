@@ -2079,6 +2079,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -2164,6 +2165,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -2283,6 +2285,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -2469,6 +2472,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -2655,6 +2659,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -2841,6 +2846,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -2960,6 +2966,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3072,6 +3079,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3184,6 +3192,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3328,6 +3337,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3439,6 +3449,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3552,6 +3563,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3667,6 +3679,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3797,6 +3810,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -3910,6 +3924,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4003,6 +4018,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4096,6 +4112,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4198,6 +4215,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4291,6 +4309,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4384,6 +4403,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4512,6 +4532,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4640,6 +4661,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4778,6 +4800,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -4899,6 +4922,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5063,6 +5087,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5217,6 +5242,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5381,6 +5407,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5507,6 +5534,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5637,6 +5665,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5722,6 +5751,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5807,6 +5837,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -5918,6 +5949,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6029,6 +6061,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6218,6 +6251,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6344,6 +6378,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6478,6 +6513,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6589,6 +6625,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6700,6 +6737,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -6811,6 +6849,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7047,6 +7086,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7181,6 +7221,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7266,6 +7307,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7351,6 +7393,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7628,6 +7671,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7767,6 +7811,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7852,6 +7897,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -7935,6 +7981,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8018,6 +8065,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8101,6 +8149,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 35,\n"
 "            \"hold-reclaimed-time\": 1800,\n"
 "            \"max-reclaim-leases\": 50,\n"
@@ -8198,6 +8247,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8309,6 +8359,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8420,6 +8471,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8532,6 +8584,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8649,6 +8702,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8766,6 +8820,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8879,6 +8934,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -8993,6 +9049,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9112,6 +9169,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9243,6 +9301,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9442,6 +9501,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9645,6 +9705,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9730,6 +9791,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9813,6 +9875,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -9912,6 +9975,7 @@ const char* UNPARSED_CONFIGS[] = {
 "        },\n"
 "        \"dhcp4o6-port\": 0,\n"
 "        \"expired-leases-processing\": {\n"
+"            \"background-reclamation\": false,\n"
 "            \"flush-reclaimed-timer-wait-time\": 25,\n"
 "            \"hold-reclaimed-time\": 3600,\n"
 "            \"max-reclaim-leases\": 100,\n"
@@ -44,6 +44,11 @@ public:
     /// \return execution status.
     virtual int run() = 0;
 
+    /// \brief Get statistics gathered by the scenario.
+    ///
+    /// \return reference to the statistics manager.
+    StatsMgr& getStatsMgr() { return (tc_.getStatsMgr()); }
+
     /// \brief Trivial virtual destructor.
     virtual ~AbstractScen() {};
 
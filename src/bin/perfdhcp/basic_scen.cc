@@ -121,22 +121,11 @@ BasicScen::checkExitConditions() {
     return (false);
 }
 
-int
-BasicScen::run() {
-    StatsMgr& stats_mgr(tc_.getStatsMgr());
-
-    // Preload server with the number of packets.
-    if (options_.getPreload() > 0) {
-        tc_.sendPackets(options_.getPreload(), true);
-    }
-
-    // Fork and run command specified with -w<wrapped-command>
-    if (!options_.getWrapped().empty()) {
-        tc_.runWrapped();
-    }
-
+void
+BasicScen::generateTraffic() {
     tc_.start();
 
+    StatsMgr& stats_mgr(tc_.getStatsMgr());
     for (;;) {
         // Calculate number of packets to be sent to stay
         // catch up with rate.
@@ -213,6 +202,33 @@ BasicScen::run() {
     }
 
     tc_.stop();
+}
+
+void
+BasicScen::runWorker() {
+    // Preload server with the worker's share of packets.
+    if (options_.getPreload() > 0) {
+        tc_.sendPackets(options_.getPreload(), true);
+    }
+
+    generateTraffic();
+}
+
+int
+BasicScen::run() {
+    StatsMgr& stats_mgr(tc_.getStatsMgr());
+
+    // Preload server with the number of packets.
+    if (options_.getPreload() > 0) {
+        tc_.sendPackets(options_.getPreload(), true);
+    }
+
+    // Fork and run command specified with -w<wrapped-command>
+    if (!options_.getWrapped().empty()) {
+        tc_.runWrapped();
+    }
+
+    generateTraffic();
 
     tc_.printStats();
 
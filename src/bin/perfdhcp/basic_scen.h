@@ -1,4 +1,4 @@
-// Copyright (C) 2012-2019 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2012-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -45,6 +45,14 @@ public:
     /// \return execution status.
     int run() override;
 
+    /// \brief Run the part of the performance test done by a worker.
+    ///
+    /// When the load is generated by multiple workers each of them
+    /// sends its preload and runs the traffic generation loop until
+    /// the exit conditions are met. The statistics are reported
+    /// by \ref ParallelScen after all workers are finished.
+    void runWorker();
+
 protected:
     /// \brief A rate control class for Discover and Solicit messages.
     RateControl basic_rate_control_;
@@ -64,6 +72,13 @@ protected:
     ///
     /// \return true if any of the exit conditions is fulfilled.
     bool checkExitConditions();
+
+    /// \brief Run the traffic generation loop.
+    ///
+    /// Method starts the receiver, sends packets according to the
+    /// rates and processes received packets until the exit conditions
+    /// are met. Then it stops the receiver.
+    void generateTraffic();
 };
 
 }
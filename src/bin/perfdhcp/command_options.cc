@@ -23,6 +23,7 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <unistd.h>
+#include <algorithm>
 #include <fstream>
 #include <thread>
 #include <getopt.h>
@@ -166,6 +167,10 @@ CommandOptions::reset() {
         single_thread_mode_ = false;
     }
     scenario_ = Scenario::BASIC;
+    workers_ = 1;
+    worker_index_ = 0;
+    latency_csv_.clear();
+    release_on_exit_ = false;
 }
 
 bool
@@ -215,6 +220,12 @@ CommandOptions::parse(int argc, char** const argv, bool print_cmd_line) {
 }
 
 const int LONG_OPT_SCENARIO = 300;
+const int LONG_OPT_WORKERS = 301;
+const int LONG_OPT_LATENCY_CSV = 302;
+const int LONG_OPT_RELEASE_ON_EXIT = 303;
+
+/// Maximum number of workers which can be specified with --workers.
+const uint32_t MAX_WORKERS = 1024;
 
 bool
 CommandOptions::initialize(int argc, char** argv, bool print_cmd_line) {
@@ -235,6 +246,9 @@ CommandOptions::initialize(int argc, char** argv, bool print_cmd_line) {
 
     struct option long_options[] = {
         {"scenario", required_argument, 0, LONG_OPT_SCENARIO},
+        {"workers",  required_argument, 0, LONG_OPT_WORKERS},
+        {"latency-csv", required_argument, 0, LONG_OPT_LATENCY_CSV},
+        {"release-on-exit", no_argument, 0, LONG_OPT_RELEASE_ON_EXIT},
         {0,          0,                 0, 0}
     };
 
@@ -591,11 +605,28 @@ CommandOptions::initialize(int argc, char** argv, bool print_cmd_line) {
                 scenario_ = Scenario::BASIC;
             } else if (optarg_text == "avalanche") {
                 scenario_ = Scenario::AVALANCHE;
+            } else if (optarg_text == "lifecycle") {
+                scenario_ = Scenario::LIFECYCLE;
             } else {
-                isc_throw(InvalidParameter, "scenario value '" << optarg << "' is wrong - should be 'basic' or 'avalanche'");
+                isc_throw(InvalidParameter, "scenario value '" << optarg << "' is wrong - should be 'basic', 'avalanche' or 'lifecycle'");
             }
             break;
         }
+
+        case LONG_OPT_WORKERS:
+            workers_ = positiveInteger("number of workers:"
+                                       " --workers<value> must be a positive"
+                                       " integer");
+            break;
+
+        case LONG_OPT_LATENCY_CSV:
+            latency_csv_ = std::string(optarg);
+            break;
+
+        case LONG_OPT_RELEASE_ON_EXIT:
+            release_on_exit_ = true;
+            break;
+
         default:
             isc_throw(isc::InvalidParameter, "wrong command line option");
         }
@@ -650,11 +681,18 @@ CommandOptions::initialize(int argc, char** argv, bool print_cmd_line) {
             std::cout << "Scenario: basic." << std::endl;
         } else if (scenario_ == Scenario::AVALANCHE) {
             std::cout << "Scenario: avalanche." << std::endl;
+        } else if (scenario_ == Scenario::LIFECYCLE) {
+            std::cout << "Scenario: lifecycle." << std::endl;
         }
 
         if (!isSingleThreaded()) {
             std::cout << "Multi-thread mode enabled." << std::endl;
         }
+
+        if (workers_ > 1) {
+            std::cout << "Load generated by " << workers_ << " workers."
+                      << std::endl;
+        }
     }
 
     // Handle the local '-l' address/interface
@@ -1004,6 +1042,78 @@ CommandOptions::validate() {
             std::cout << "INFO: in avalanche scenario drop time is ignored" << std::endl;
         }
     }
+
+    if (scenario_ == Scenario::LIFECYCLE) {
+        check(getClientsNum() <= 0,
+              "in case of lifecycle scenario the size of the client"
+              " population must be specified using -R option explicitly");
+        check(getExchangeMode() == DO_SA,
+              "-i is not compatible with the lifecycle scenario");
+        check(getRenewRate() != 0,
+              "-f<renew-rate> is not compatible with the lifecycle scenario,"
+              " renewals are sent by the clients at T1");
+        check(!getMacListFile().empty(),
+              "-M<mac-list-file> is not compatible with the lifecycle"
+              " scenario");
+        check(!getTemplateFiles().empty(),
+              "-T<template-file> is not compatible with the lifecycle"
+              " scenario");
+    }
+    check(release_on_exit_ && (scenario_ != Scenario::LIFECYCLE),
+          "--release-on-exit can be only used with the lifecycle scenario");
+
+    check(!latency_csv_.empty() && (report_delay_ == 0),
+          "--latency-csv<file> requires periodic reports enabled with"
+          " -t<report>");
+
+    if (workers_ > 1) {
+        check(!latency_csv_.empty(),
+              "--latency-csv<file> can't be used with multiple workers");
+        check(scenario_ != Scenario::BASIC,
+              "--workers<value> can be only used with the basic scenario");
+        check(workers_ > MAX_WORKERS,
+              "--workers<value> must not be greater than 1024");
+        check((rate_ != 0) && (rate_ < workers_),
+              "exchange rate specified with -r<rate> must not be lower"
+              " than the number of workers");
+        check((getClientsNum() > 1) && (getClientsNum() < workers_),
+              "number of clients specified with -R<value> must not be lower"
+              " than the number of workers");
+        if (report_delay_ > 0) {
+            std::cout << "INFO: with multiple workers intermediate reports"
+                      " are not printed" << std::endl;
+        }
+    }
+}
+
+void
+CommandOptions::setWorkerShare(uint32_t worker_index) {
+    if (worker_index >= workers_) {
+        isc_throw(isc::OutOfRange, "worker index " << worker_index
+                  << " is out of range, number of workers is " << workers_);
+    }
+    worker_index_ = worker_index;
+
+    // Give each worker its part of the value, the first workers take
+    // one more unit when the value is not divisible by the number
+    // of workers.
+    auto share = [this](uint64_t value) -> uint64_t {
+        return (value / workers_ + ((value % workers_) > worker_index_ ? 1 : 0));
+    };
+    rate_ = share(rate_);
+    renew_rate_ = share(renew_rate_);
+    release_rate_ = share(release_rate_);
+    preload_ = share(preload_);
+    for (auto& num_request : num_request_) {
+        num_request = share(num_request);
+    }
+
+    // Reporting and the wrapped command are handled once for all workers
+    // and the packets are received in the worker's own loop.
+    report_delay_ = 0;
+    wrapped_.clear();
+    diags_.erase(std::remove(diags_.begin(), diags_.end(), 'a'), diags_.end());
+    single_thread_mode_ = true;
 }
 
 void
@@ -1161,6 +1271,15 @@ CommandOptions::printCommandLine() const {
     } else {
         std::cout << "multi-thread-mode" << std::endl;
     }
+    if (workers_ > 1) {
+        std::cout << "workers=" << workers_ << std::endl;
+    }
+    if (!latency_csv_.empty()) {
+        std::cout << "latency-csv=" << latency_csv_ << std::endl;
+    }
+    if (release_on_exit_) {
+        std::cout << "release-on-exit" << std::endl;
+    }
 }
 
 void
@@ -1170,12 +1289,15 @@ R"(perfdhcp [-1] [-4 | -6] [-A encapsulation-level] [-b base] [-B] [-c]
          [-C separator] [-d drop-time] [-D max-drop] [-e lease-type]
          [-E time-offset] [-f renew-rate] [-F release-rate] [-g thread-mode]
          [-h] [-i] [-I ip-offset] [-J remote-address-list-file]
-         [-l local-address|interface] [-L local-port] [-M mac-list-file]
+         [-l local-address|interface] [-L local-port] [--latency-csv file]
+         [-M mac-list-file]
          [-n num-request] [-N remote-port] [-O random-offset]
          [-o code,hexstring] [-p test-period] [-P preload] [-r rate]
-         [-R num-clients] [-s seed] [-S srvid-offset] [--scenario name]
-         [-t report] [-T template-file] [-u] [-v] [-W exit-wait-time]
-         [-w script_name] [-x diagnostic-selector] [-X xid-offset] [server]
+         [-R num-clients] [--release-on-exit] [-s seed] [-S srvid-offset]
+         [--scenario name] [-t report] [-T template-file] [-u] [-v]
+         [-W exit-wait-time]
+         [-w script_name] [--workers num-workers] [-x diagnostic-selector]
+         [-X xid-offset] [server]
 
 The [server] argument is the name/address of the DHCP server to
 contact.  For DHCPv4 operation, exchanges are initiated by
@@ -1198,6 +1320,11 @@ The other scenario is an avalanche which is selected by
 messages as request in -R option then back off mechanism is used for
 each simulated client until all requests are answered. At the end
 time of whole scenario is reported.
+The lifecycle scenario, selected by --scenario lifecycle, simulates
+a population of -R clients which keep their leases: they join at
+the -r rate, renew at T1, rebind at T2, rejoin when the lease expires
+and leave and rejoin at the -F churn rate. Per exchange type rates
+and latencies are reported.
 
 Options:
 -1: Take the server-ID option from the first received message.
@@ -1225,7 +1352,8 @@ Options:
     a server. This value is only valid when used in conjunction with
     the exchange rate (given by -r<rate>).  Furthermore the sum of
     this value and the renew-rate (given by -f<rate>) must be equal
-    to or less than the exchange rate.
+    to or less than the exchange rate. In the lifecycle scenario it is
+    the rate at which bound clients release their leases and rejoin.
 -f<renew-rate>: Rate at which DHCPv4 or DHCPv6 renew requests are sent
     to a server. This value is only valid when used in conjunction
     with the exchange rate (given by -r<rate>).  Furthermore the sum of
@@ -1251,6 +1379,11 @@ Options:
     via which exchanges are initiated.
 -L<local-port>: Specify the local port to use
     (the value 0 means to use the default).
+--latency-csv <file>: At each periodic report (-t) append to the file
+    one CSV line per exchange with the elapsed time, the number of
+    responses and the min, 50th, 90th, 99th and 99.9th percentiles and
+    max of the delays (in ms) of responses received since the previous
+    report.
 -M<mac-list-file>: A text file containing a list of MAC addresses,
    one per line. If provided, a MAC address will be chosen randomly
    from this list for every new exchange. In the DHCPv6 case, MAC
@@ -1270,7 +1403,11 @@ Options:
 -R<range>: Specify how many different clients are used. With 1
     (the default), all requests seem to come from the same client.
 -s<seed>: Specify the seed for randomization, making it repeatable.
---scenario <name>: where name is 'basic' (default) or 'avalanche'.
+--release-on-exit: In the lifecycle scenario release the leases of
+    all bound clients when the test ends and wait -W<time> for the
+    responses.
+--scenario <name>: where name is 'basic' (default), 'avalanche' or
+    'lifecycle'.
 -S<srvid-offset>: Offset of the server-ID option in the
     (second/request) template.
 -T<template-file>: The name of a file containing the template to use
@@ -1284,6 +1421,12 @@ Options:
     packets without sending any new packets. Expressed in microseconds.
 -w<wrapped>: Command to call with start/stop at the beginning/end of
     the program.
+--workers <num-workers>: Generate the load with the given number of
+    worker threads (basic scenario only). Each worker simulates its own
+    slice of the clients and sends its share of the rate, the number of
+    requests and the preload. Each worker receives the responses to its
+    requests from its own socket. Statistics of all workers are merged in the final
+    report; intermediate reports (-t) are not printed.
 -x<diagnostic-selector>: Include extended diagnostics in the output.
     <diagnostic-selector> is a string of single-keywords specifying
     the operations for which verbose output is desired.  The selector
@@ -1327,7 +1470,9 @@ The remaining options are typically used in conjunction with -r:
     specified in the same manner as -d.  This can be used as an
     alternative to -n, or both options can be given, in which case the
     testing is completed when either limit is reached.
--t<report>: Delay in seconds between two periodic reports.
+-t<report>: Delay in seconds between two periodic reports. Reports
+    include the percentiles of the delays of responses received since
+    the previous report.
 -C<separator>: Output reduced, an argument is a separator for periodic
     (-t) reports generated in easy parsable mode. Data output won't be
     changed, remain identical as in -t option.
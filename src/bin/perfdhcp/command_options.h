@@ -9,7 +9,6 @@
 
 #include <dhcp/option.h>
 
-#include <boost/noncopyable.hpp>
 #include <stdint.h>
 #include <string>
 #include <vector>
@@ -19,7 +18,8 @@ namespace perfdhcp {
 
 enum class Scenario {
     BASIC,
-    AVALANCHE
+    AVALANCHE,
+    LIFECYCLE
 };
 
 /// \brief Command Options.
@@ -27,7 +27,10 @@ enum class Scenario {
 /// This class is responsible for parsing the command-line and storing the
 /// specified options.
 ///
-class CommandOptions : public boost::noncopyable {
+/// The class is copyable so as a per worker copy of the options can be
+/// made when the load is generated by multiple workers (see
+/// \ref CommandOptions::setWorkerShare).
+class CommandOptions {
 public:
 
     /// \brief Default Constructor.
@@ -387,6 +390,45 @@ public:
     /// \return enum Scenario.
     Scenario getScenario() const { return scenario_; }
 
+    /// \brief Returns number of workers generating the load.
+    ///
+    /// \return number of workers, 1 when the load is generated by
+    /// a single sender.
+    uint32_t getWorkers() const { return workers_; }
+
+    /// \brief Returns name of the CSV file packet delays are written to.
+    ///
+    /// \return name of the file or empty string if delays are not
+    /// written.
+    std::string getLatencyCsv() const { return latency_csv_; }
+
+    /// \brief Check if leases are released when the test ends.
+    ///
+    /// \return true if the lifecycle scenario sends Release messages
+    /// for all bound clients before exiting.
+    bool isReleaseOnExit() const { return release_on_exit_; }
+
+    /// \brief Returns index of the worker these options belong to.
+    ///
+    /// \return worker index in the range of 0 to \ref getWorkers() - 1.
+    uint32_t getWorkerIndex() const { return worker_index_; }
+
+    /// \brief Turns these options into the options of a single worker.
+    ///
+    /// The rates, the number of requests and the preload are divided
+    /// between workers so as the sum over all workers equals to the
+    /// values specified in the command line. The remainder of the
+    /// division is given to the workers with the lowest indexes.
+    /// The intermediate reports and the wrapped command are disabled
+    /// as they are handled once for all workers. Workers are always
+    /// single-threaded because each of them receives the packets from
+    /// its own socket in its own loop.
+    ///
+    /// \param worker_index index of the worker.
+    /// \throw isc::OutOfRange if the index is not lower than the
+    /// number of workers.
+    void setWorkerShare(uint32_t worker_index);
+
     /// \brief Returns server name.
     ///
     /// \return server name.
@@ -756,6 +798,20 @@ private:
 
     /// @brief Selected performance scenario. Default is basic.
     Scenario scenario_;
+
+    /// @brief Number of workers generating the load.
+    uint32_t workers_;
+
+    /// @brief Index of the worker these options belong to.
+    uint32_t worker_index_;
+
+    /// @brief Name of the CSV file packet delays are written to at each
+    /// periodic report.
+    std::string latency_csv_;
+
+    /// @brief Indicates that the lifecycle scenario releases the leases
+    /// of all bound clients before exiting.
+    bool release_on_exit_;
 };
 
 }  // namespace perfdhcp
@@ -0,0 +1,127 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <perfdhcp/latency_histogram.h>
+#include <exceptions/exceptions.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace isc {
+namespace perfdhcp {
+
+const unsigned int LatencyHistogram::SUB_BUCKET_BITS;
+const uint64_t LatencyHistogram::SUB_BUCKETS;
+const uint64_t LatencyHistogram::MAX_VALUE;
+
+namespace {
+
+/// \brief Number of buckets in each range of values above SUB_BUCKETS.
+const uint64_t HALF_SUB_BUCKETS = LatencyHistogram::SUB_BUCKETS / 2;
+
+}
+
+LatencyHistogram::LatencyHistogram()
+    : counts_(getBucketIndex(MAX_VALUE) + 1, 0), count_(0),
+      min_(std::numeric_limits<uint64_t>::max()), max_(0) {
+}
+
+size_t
+LatencyHistogram::getBucketIndex(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return (value);
+    }
+    value = std::min(value, MAX_VALUE);
+    unsigned int msb = 0;
+    for (uint64_t v = value; v > 1; v >>= 1) {
+        ++msb;
+    }
+    // Shift which brings the value to the [SUB_BUCKETS/2, SUB_BUCKETS)
+    // range. It is at least 1 here.
+    unsigned int shift = msb - SUB_BUCKET_BITS + 1;
+    return (SUB_BUCKETS + (shift - 1) * HALF_SUB_BUCKETS +
+            ((value >> shift) - HALF_SUB_BUCKETS));
+}
+
+uint64_t
+LatencyHistogram::getBucketLowest(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return (index);
+    }
+    uint64_t range = index - SUB_BUCKETS;
+    unsigned int shift = range / HALF_SUB_BUCKETS + 1;
+    uint64_t sub = range % HALF_SUB_BUCKETS + HALF_SUB_BUCKETS;
+    return (sub << shift);
+}
+
+uint64_t
+LatencyHistogram::getBucketHighest(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return (index);
+    }
+    unsigned int shift = (index - SUB_BUCKETS) / HALF_SUB_BUCKETS + 1;
+    return (getBucketLowest(index) + (static_cast<uint64_t>(1) << shift) - 1);
+}
+
+void
+LatencyHistogram::record(uint64_t usec) {
+    ++counts_[getBucketIndex(usec)];
+    ++count_;
+    min_ = std::min(min_, usec);
+    max_ = std::max(max_, usec);
+}
+
+void
+LatencyHistogram::recordSeconds(double delay) {
+    record(delay > 0. ? static_cast<uint64_t>(std::llround(delay * 1e6)) : 0);
+}
+
+void
+LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        counts_[i] += other.counts_[i];
+    }
+    count_ += other.count_;
+    min_ = std::min(min_, other.min_);
+    max_ = std::max(max_, other.max_);
+}
+
+void
+LatencyHistogram::reset() {
+    std::fill(counts_.begin(), counts_.end(), 0);
+    count_ = 0;
+    min_ = std::numeric_limits<uint64_t>::max();
+    max_ = 0;
+}
+
+uint64_t
+LatencyHistogram::getPercentile(double percentile) const {
+    if ((percentile < 0.) || (percentile > 100.)) {
+        isc_throw(BadValue, "percentile " << percentile
+                  << " is out of range 0..100");
+    }
+    if (count_ == 0) {
+        return (0);
+    }
+    // Rank of the value at the percentile, counted from 1.
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100. *
+                                                    count_));
+    rank = std::max(rank, static_cast<uint64_t>(1));
+    uint64_t cumulated = 0;
+    for (size_t i = 0; i < counts_.size(); ++i) {
+        cumulated += counts_[i];
+        if (cumulated >= rank) {
+            return (std::max(min_, std::min(max_, getBucketHighest(i))));
+        }
+    }
+    return (max_);
+}
+
+}
+}
@@ -0,0 +1,131 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace isc {
+namespace perfdhcp {
+
+/// \brief Fixed memory histogram of packet delays.
+///
+/// This class records delays between sent and received packets in
+/// a log-linear (HDR-style) histogram so as the percentiles of the
+/// delays can be reported without storing the packets. Delays are
+/// recorded in microseconds.
+///
+/// The first \c SUB_BUCKETS buckets hold the values from 0 to
+/// \c SUB_BUCKETS - 1 exactly. The following buckets are grouped in
+/// ranges covering values from 2^n to 2^(n+1) - 1, each range being
+/// divided into \c SUB_BUCKETS / 2 buckets of the same width. As a
+/// result, the value reported for a bucket differs from the recorded
+/// values by less than 1% while the histogram takes less than 32kB
+/// regardless of the number of recorded values. Values greater than
+/// \c MAX_VALUE are counted in the last bucket but the maximum is
+/// always reported exactly.
+class LatencyHistogram {
+public:
+    /// \brief Number of bits of the sub-bucket index.
+    static const unsigned int SUB_BUCKET_BITS = 8;
+
+    /// \brief Number of buckets holding exact values.
+    static const uint64_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+    /// \brief Greatest value distinguished by the histogram
+    /// (more than one hour).
+    static const uint64_t MAX_VALUE = 0xFFFFFFFF;
+
+    /// \brief Constructor.
+    LatencyHistogram();
+
+    /// \brief Record a delay.
+    ///
+    /// \param usec delay in microseconds.
+    void record(uint64_t usec);
+
+    /// \brief Record a delay.
+    ///
+    /// \param delay delay in seconds as used by \ref ExchangeStats.
+    void recordSeconds(double delay);
+
+    /// \brief Add values recorded by another histogram.
+    ///
+    /// \param other histogram to be merged.
+    void merge(const LatencyHistogram& other);
+
+    /// \brief Remove all recorded values.
+    void reset();
+
+    /// \brief Return number of recorded values.
+    uint64_t getCount() const {
+        return (count_);
+    }
+
+    /// \brief Return the smallest recorded value in microseconds.
+    ///
+    /// \return smallest value or 0 if no value was recorded.
+    uint64_t getMin() const {
+        return (count_ ? min_ : 0);
+    }
+
+    /// \brief Return the greatest recorded value in microseconds.
+    ///
+    /// \return greatest value or 0 if no value was recorded.
+    uint64_t getMax() const {
+        return (max_);
+    }
+
+    /// \brief Return the value at the given percentile in microseconds.
+    ///
+    /// The returned value is the greatest value falling into the same
+    /// bucket as the value at the percentile, limited to the range of
+    /// recorded values.
+    ///
+    /// \param percentile percentile between 0 and 100.
+    /// \throw isc::BadValue if the percentile is out of range.
+    /// \return value at the percentile or 0 if no value was recorded.
+    uint64_t getPercentile(double percentile) const;
+
+    /// \brief Return index of the bucket for a value.
+    ///
+    /// \param value value in microseconds.
+    /// \return index of the bucket.
+    static size_t getBucketIndex(uint64_t value);
+
+    /// \brief Return the smallest value falling into the bucket.
+    ///
+    /// \param index index of the bucket.
+    /// \return smallest value of the bucket.
+    static uint64_t getBucketLowest(size_t index);
+
+    /// \brief Return the greatest value falling into the bucket.
+    ///
+    /// \param index index of the bucket.
+    /// \return greatest value of the bucket.
+    static uint64_t getBucketHighest(size_t index);
+
+private:
+    /// \brief Counts of values in buckets.
+    std::vector<uint64_t> counts_;
+
+    /// \brief Number of recorded values.
+    uint64_t count_;
+
+    /// \brief Smallest recorded value.
+    uint64_t min_;
+
+    /// \brief Greatest recorded value.
+    uint64_t max_;
+};
+
+}
+}
+
+#endif // LATENCY_HISTOGRAM_H
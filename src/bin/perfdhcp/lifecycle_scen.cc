@@ -0,0 +1,539 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <perfdhcp/lifecycle_scen.h>
+
+#include <dhcp/dhcp4.h>
+#include <dhcp/dhcp6.h>
+#include <dhcp/option6_ia.h>
+#include <dhcp/option6_iaaddr.h>
+#include <dhcp/pkt4.h>
+#include <dhcp/pkt6.h>
+#include <exceptions/exceptions.h>
+#include <util/io_utilities.h>
+
+#include <algorithm>
+#include <iterator>
+
+using namespace std;
+using namespace boost::posix_time;
+using namespace isc;
+using namespace isc::dhcp;
+
+
+namespace isc {
+namespace perfdhcp {
+
+namespace {
+
+/// \brief Infinite lifetime, the lease never expires.
+const uint32_t INFINITE_LIFETIME = 0xFFFFFFFF;
+
+/// \brief Number of clients probed when looking for a bound client
+/// to churn.
+const int CHURN_PROBES = 16;
+
+/// \brief Return the value of a 32 bits DHCPv4 option.
+///
+/// \param pkt DHCPv4 packet.
+/// \param code option code.
+/// \param [out] value option value.
+/// \return true if the option was found.
+bool
+getUint32Option(const Pkt4Ptr& pkt, uint16_t code, uint32_t& value) {
+    OptionPtr opt = pkt->getOption(code);
+    if (!opt) {
+        return (false);
+    }
+    // The option may be an OptionInt holding the value outside of the
+    // raw data, so pack it.
+    std::vector<uint8_t> data = opt->toBinary();
+    if (data.size() < sizeof(uint32_t)) {
+        return (false);
+    }
+    value = isc::util::readUint32(&data[0], data.size());
+    return (true);
+}
+
+}
+
+LifecycleScen::LifecycleScen(CommandOptions& options,
+                             BasePerfSocket &socket) :
+    AbstractScen(options, socket),
+    clients_(options.getClientsNum()),
+    client_gen_(new ClientGenerator()) {
+    StatsMgr& stats_mgr(tc_.getStatsMgr());
+    if (options_.getIpVersion() == 4) {
+        // The DHCPv4 rebind is a DHCPREQUEST without server identifier,
+        // the same as a renewal.
+        renew_xchg_ = ExchangeType::RNA;
+        rebind_xchg_ = ExchangeType::RNA;
+        release_xchg_ = ExchangeType::RLA;
+    } else {
+        renew_xchg_ = ExchangeType::RN;
+        rebind_xchg_ = ExchangeType::RB;
+        release_xchg_ = ExchangeType::RL;
+    }
+    for (auto xchg_type : { renew_xchg_, rebind_xchg_, release_xchg_ }) {
+        if (!stats_mgr.hasExchangeStats(xchg_type)) {
+            stats_mgr.addExchangeStats(xchg_type, options_.getDropTime()[1]);
+        }
+    }
+    stats_mgr.addCustomCounter("joins", "Clients joined");
+    stats_mgr.addCustomCounter("renewals", "Leases renewed at T1");
+    stats_mgr.addCustomCounter("rebinds", "Leases rebound at T2");
+    stats_mgr.addCustomCounter("releases", "Leases released");
+    stats_mgr.addCustomCounter("expired", "Leases expired");
+
+    tc_.setMacAddrGenerator(client_gen_);
+    tc_.setResponseHandler(std::bind(&LifecycleScen::processResponse, this,
+                                     std::placeholders::_1,
+                                     std::placeholders::_2));
+
+    join_rate_control_.setRate(options_.getRate());
+    churn_rate_control_.setRate(options_.getReleaseRate());
+
+    // All clients join at the beginning of the test.
+    for (uint32_t index = 0; index < clients_.size(); ++index) {
+        joins_.push_back(index);
+    }
+}
+
+LifecycleScen::ClientState
+LifecycleScen::getClientState(uint32_t index) const {
+    if (index >= clients_.size()) {
+        isc_throw(OutOfRange, "client index " << index
+                  << " is out of range, number of clients is "
+                  << clients_.size());
+    }
+    return (clients_[index].state_);
+}
+
+size_t
+LifecycleScen::getClientsNum(ClientState state) const {
+    return (std::count_if(clients_.begin(), clients_.end(),
+                          [state](const Client& client) {
+                              return (client.state_ == state);
+                          }));
+}
+
+std::string
+LifecycleScen::getClientKey(const PktPtr& pkt) const {
+    std::vector<uint8_t> key;
+    if (options_.getIpVersion() == 4) {
+        Pkt4Ptr pkt4 = boost::dynamic_pointer_cast<Pkt4>(pkt);
+        if (pkt4 && pkt4->getHWAddr()) {
+            key = pkt4->getHWAddr()->hwaddr_;
+        }
+    } else {
+        OptionPtr client_id = pkt->getOption(D6O_CLIENTID);
+        if (client_id) {
+            key = client_id->getData();
+        }
+    }
+    return (std::string(key.begin(), key.end()));
+}
+
+bool
+LifecycleScen::getLeaseTimes(const PktPtr& pkt, uint32_t& t1, uint32_t& t2,
+                             uint32_t& valid) const {
+    t1 = 0;
+    t2 = 0;
+    valid = 0;
+    if (options_.getIpVersion() == 4) {
+        Pkt4Ptr ack = boost::dynamic_pointer_cast<Pkt4>(pkt);
+        if (!ack || ack->getYiaddr().isV4Zero() ||
+            !getUint32Option(ack, DHO_DHCP_LEASE_TIME, valid)) {
+            return (false);
+        }
+        getUint32Option(ack, DHO_DHCP_RENEWAL_TIME, t1);
+        getUint32Option(ack, DHO_DHCP_REBINDING_TIME, t2);
+        if (t2 == 0) {
+            t2 = static_cast<uint32_t>(valid * 0.875);
+        }
+    } else {
+        // The lease lasts as long as the shortest of the lifetimes.
+        bool found = false;
+        for (uint16_t code : { D6O_IA_NA, D6O_IA_PD }) {
+            Option6IAPtr ia =
+                boost::dynamic_pointer_cast<Option6IA>(pkt->getOption(code));
+            if (!ia) {
+                continue;
+            }
+            Option6IAAddrPtr iaaddr = boost::dynamic_pointer_cast<
+                Option6IAAddr>(ia->getOption(code == D6O_IA_NA ?
+                                             D6O_IAADDR : D6O_IAPREFIX));
+            if (!iaaddr || (iaaddr->getValid() == 0)) {
+                return (false);
+            }
+            if (!found || (iaaddr->getValid() < valid)) {
+                valid = iaaddr->getValid();
+                t1 = ia->getT1();
+                t2 = ia->getT2();
+            }
+            found = true;
+        }
+        if (!found) {
+            return (false);
+        }
+        if (t2 == 0) {
+            t2 = static_cast<uint32_t>(valid * 0.8);
+        }
+    }
+    if (t1 == 0) {
+        t1 = valid / 2;
+    }
+    return (valid != 0);
+}
+
+void
+LifecycleScen::schedule(uint32_t index, EventType type, double seconds) {
+    Event event;
+    event.time_ = microsec_clock::universal_time() +
+        microseconds(static_cast<int64_t>(seconds * 1e6));
+    event.client_ = index;
+    event.seq_ = clients_[index].seq_;
+    event.type_ = type;
+    events_.push(event);
+}
+
+void
+LifecycleScen::join(uint32_t index) {
+    Client& client = clients_[index];
+    client.state_ = ClientState::SELECTING;
+    ++client.seq_;
+    client.lease_.reset();
+
+    client_gen_->setNext(index);
+    tc_.sendPackets(1);
+
+    // Learn the identity of the client from the packet just sent, so as
+    // the responses can be matched with the client.
+    StatsMgr& stats_mgr(tc_.getStatsMgr());
+    auto sent_packets_its = stats_mgr.getSentPackets(stage1_xchg_);
+    if (std::get<0>(sent_packets_its) != std::get<1>(sent_packets_its)) {
+        auto last_it = std::prev(std::get<1>(sent_packets_its));
+        client_keys_[getClientKey(*last_it)] = index;
+    }
+
+    std::vector<double> drop_time = options_.getDropTime();
+    schedule(index, EventType::TIMEOUT, drop_time[0] + drop_time[1]);
+    stats_mgr.incrementCounter("joins");
+}
+
+void
+LifecycleScen::restart(uint32_t index) {
+    Client& client = clients_[index];
+    client.state_ = ClientState::INIT;
+    ++client.seq_;
+    client.lease_.reset();
+    joins_.push_back(index);
+}
+
+bool
+LifecycleScen::bind(uint32_t index, const PktPtr& lease) {
+    uint32_t t1;
+    uint32_t t2;
+    uint32_t valid;
+    if (!getLeaseTimes(lease, t1, t2, valid)) {
+        return (false);
+    }
+    Client& client = clients_[index];
+    client.state_ = ClientState::BOUND;
+    ++client.seq_;
+    client.lease_ = lease;
+    if (valid == INFINITE_LIFETIME) {
+        return (true);
+    }
+    if (t1 < valid) {
+        schedule(index, EventType::RENEW, t1);
+    }
+    if ((t2 > t1) && (t2 < valid)) {
+        schedule(index, EventType::REBIND, t2);
+    }
+    schedule(index, EventType::EXPIRE, valid);
+    return (true);
+}
+
+void
+LifecycleScen::release(uint32_t index) {
+    Client& client = clients_[index];
+    if (options_.getIpVersion() == 4) {
+        tc_.sendMessageFromAck(DHCPRELEASE,
+                               boost::dynamic_pointer_cast<Pkt4>(client.lease_));
+    } else {
+        tc_.sendMessageFromReply(DHCPV6_RELEASE,
+                                 boost::dynamic_pointer_cast<Pkt6>(client.lease_));
+    }
+    tc_.getStatsMgr().incrementCounter("releases");
+}
+
+void
+LifecycleScen::processResponse(const ExchangeType xchg_type,
+                               const PktPtr& pkt) {
+    // Replies to Release carry no lease.
+    if (xchg_type == release_xchg_) {
+        return;
+    }
+    auto key_it = client_keys_.find(getClientKey(pkt));
+    if (key_it == client_keys_.end()) {
+        return;
+    }
+    uint32_t index = key_it->second;
+    ClientState state = clients_[index].state_;
+    if (xchg_type == stage2_xchg_) {
+        if (state != ClientState::SELECTING) {
+            return;
+        }
+    } else if ((state != ClientState::RENEWING) &&
+               (state != ClientState::REBINDING)) {
+        return;
+    }
+    // The server refused to extend the lease: start over.
+    if (!bind(index, pkt)) {
+        restart(index);
+    }
+}
+
+void
+LifecycleScen::processEvents() {
+    StatsMgr& stats_mgr(tc_.getStatsMgr());
+    ptime now = microsec_clock::universal_time();
+    while (!events_.empty() && (events_.top().time_ <= now)) {
+        Event event = events_.top();
+        events_.pop();
+        Client& client = clients_[event.client_];
+        // The client changed its state since the event was scheduled.
+        if (event.seq_ != client.seq_) {
+            continue;
+        }
+        switch (event.type_) {
+        case EventType::TIMEOUT:
+            if (client.state_ == ClientState::SELECTING) {
+                restart(event.client_);
+            }
+            break;
+        case EventType::RENEW:
+            if (client.state_ == ClientState::BOUND) {
+                client.state_ = ClientState::RENEWING;
+                if (options_.getIpVersion() == 4) {
+                    tc_.sendMessageFromAck(DHCPREQUEST,
+                        boost::dynamic_pointer_cast<Pkt4>(client.lease_));
+                } else {
+                    tc_.sendMessageFromReply(DHCPV6_RENEW,
+                        boost::dynamic_pointer_cast<Pkt6>(client.lease_));
+                }
+                stats_mgr.incrementCounter("renewals");
+            }
+            break;
+        case EventType::REBIND:
+            if ((client.state_ == ClientState::BOUND) ||
+                (client.state_ == ClientState::RENEWING)) {
+                client.state_ = ClientState::REBINDING;
+                if (options_.getIpVersion() == 4) {
+                    tc_.sendMessageFromAck(DHCPREQUEST,
+                        boost::dynamic_pointer_cast<Pkt4>(client.lease_));
+                } else {
+                    tc_.sendMessageFromReply(DHCPV6_REBIND,
+                        boost::dynamic_pointer_cast<Pkt6>(client.lease_));
+                }
+                stats_mgr.incrementCounter("rebinds");
+            }
+            break;
+        case EventType::EXPIRE:
+            stats_mgr.incrementCounter("expired");
+            restart(event.client_);
+            break;
+        }
+    }
+}
+
+void
+LifecycleScen::processJoins() {
+    uint64_t due = joins_.size();
+    if (options_.getRate() != 0) {
+        due = std::min(due, join_rate_control_.getOutboundMessageCount());
+    }
+    for (; due > 0; --due) {
+        uint32_t index = joins_.front();
+        joins_.pop_front();
+        join(index);
+    }
+}
+
+void
+LifecycleScen::churn(uint64_t num) {
+    for (; num > 0; --num) {
+        for (int probe = 0; probe < CHURN_PROBES; ++probe) {
+            uint32_t index = random() % clients_.size();
+            ClientState state = clients_[index].state_;
+            if ((state == ClientState::BOUND) ||
+                (state == ClientState::RENEWING) ||
+                (state == ClientState::REBINDING)) {
+                release(index);
+                restart(index);
+                break;
+            }
+        }
+    }
+}
+
+void
+LifecycleScen::releaseAll() {
+    for (uint32_t index = 0; index < clients_.size(); ++index) {
+        if (clients_[index].lease_) {
+            release(index);
+            clients_[index].state_ = ClientState::INIT;
+            ++clients_[index].seq_;
+            clients_[index].lease_.reset();
+        }
+    }
+}
+
+bool
+LifecycleScen::checkExitConditions() {
+    if (tc_.interrupted()) {
+        return (true);
+    }
+
+    // Check if test period passed.
+    if (options_.getPeriod() != 0) {
+        time_period period(tc_.getStatsMgr().getTestPeriod());
+        if (period.length().total_seconds() >= options_.getPeriod()) {
+            if (options_.testDiags('e')) {
+                std::cout << "reached test-period." << std::endl;
+            }
+            return (true);
+        }
+    }
+    return (false);
+}
+
+void
+LifecycleScen::drainResponses() {
+    ptime exit_time = microsec_clock::universal_time() +
+        microseconds(options_.getExitWaitTime());
+    while (!tc_.interrupted() &&
+           (microsec_clock::universal_time() < exit_time)) {
+        if (tc_.consumeReceivedPackets() == 0) {
+            usleep(1);
+        }
+    }
+}
+
+void
+LifecycleScen::printLifecycleStats() {
+    StatsMgr& stats_mgr(tc_.getStatsMgr());
+    double duration =
+        stats_mgr.getTestPeriod().length().total_nanoseconds() / 1e9;
+    std::cout << "***Lifecycle statistics***" << std::endl;
+    std::vector<ExchangeType> xchg_types;
+    if (options_.getIpVersion() == 4) {
+        xchg_types = { ExchangeType::DO, ExchangeType::RA,
+                       ExchangeType::RNA, ExchangeType::RLA };
+    } else {
+        xchg_types = { ExchangeType::SA, ExchangeType::RR, ExchangeType::RN,
+                       ExchangeType::RB, ExchangeType::RL };
+    }
+    for (auto xchg_type : xchg_types) {
+        if (!stats_mgr.hasExchangeStats(xchg_type)) {
+            continue;
+        }
+        std::cout << xchg_type << ": sent "
+                  << stats_mgr.getSentPacketsNum(xchg_type) / duration
+                  << "/second, received "
+                  << stats_mgr.getRcvdPacketsNum(xchg_type) / duration
+                  << "/second" << std::endl;
+    }
+    for (auto name : { "joins", "renewals", "rebinds", "releases",
+                       "expired" }) {
+        std::cout << stats_mgr.getCounter(name)->getName() << ": "
+                  << stats_mgr.getCounter(name)->getValue() << std::endl;
+    }
+    std::cout << "Bound clients: "
+              << getClientsNum(ClientState::BOUND) +
+                 getClientsNum(ClientState::RENEWING) +
+                 getClientsNum(ClientState::REBINDING)
+              << " of " << clients_.size() << std::endl;
+}
+
+int
+LifecycleScen::run() {
+    StatsMgr& stats_mgr(tc_.getStatsMgr());
+
+    // Fork and run command specified with -w<wrapped-command>
+    if (!options_.getWrapped().empty()) {
+        tc_.runWrapped();
+    }
+
+    tc_.start();
+    for (;;) {
+        // Pull some packets from receiver thread, process them, update
+        // the state of the clients and respond to the server if needed.
+        auto pkt_count = tc_.consumeReceivedPackets();
+
+        if (checkExitConditions()) {
+            break;
+        }
+
+        // Send renewals and rebinds due and restart the clients which
+        // didn't get a lease or lost it.
+        processEvents();
+
+        // Send Discover or Solicit for the joining clients.
+        processJoins();
+
+        // Release the leases of random clients which rejoin later.
+        if (options_.getReleaseRate() != 0) {
+            churn(churn_rate_control_.getOutboundMessageCount());
+        }
+
+        if (options_.getReportDelay() > 0) {
+            tc_.printIntermediateStats();
+        }
+
+        if ((pkt_count == 0) && (options_.getRate() < 10000)) {
+            usleep(1);
+        }
+    }
+
+    if (options_.isReleaseOnExit()) {
+        releaseAll();
+    }
+    drainResponses();
+    tc_.stop();
+
+    tc_.printStats();
+    printLifecycleStats();
+
+    if (!options_.getWrapped().empty()) {
+        // true means that we execute wrapped command with 'stop' argument.
+        tc_.runWrapped(true);
+    }
+
+    // Print packet timestamps
+    if (options_.testDiags('t')) {
+        stats_mgr.printTimestamps();
+    }
+
+    // Print server id.
+    if (options_.testDiags('s') && tc_.serverIdReceived()) {
+        std::cout << "Server id: " << tc_.getServerId() << std::endl;
+    }
+
+    // Print any received leases.
+    if (options_.testDiags('l')) {
+        stats_mgr.printLeases();
+    }
+
+    // Check if any packet drops occurred.
+    return (stats_mgr.droppedPackets() ? 3 : 0);
+}
+
+}  // namespace perfdhcp
+}  // namespace isc
@@ -0,0 +1,261 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef LIFECYCLE_SCEN_H
+#define LIFECYCLE_SCEN_H
+
+#include <config.h>
+
+#include <perfdhcp/abstract_scen.h>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <deque>
+#include <functional>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace isc {
+namespace perfdhcp {
+
+/// \brief Lease lifecycle Scenario class.
+///
+/// This class is used to run the performance test where the DHCP server
+/// serves a population of long-lived clients. The number of clients is
+/// given by -R. Each client obtains a lease (DORA or SARR), renews it
+/// at T1, rebinds it at T2 when the renewal was not answered and starts
+/// over when the lease expires. Clients join at the rate given by -r.
+/// Bound clients are picked at random to release their leases and
+/// rejoin at the rate given by -F (churn). With --release-on-exit all
+/// bound clients release their leases when the test ends.
+///
+/// The state of the clients is driven by timers held in a priority
+/// queue. The timers of a client are invalidated by bumping its
+/// sequence number when the client changes its state, so as the
+/// queue never needs to be searched.
+class LifecycleScen : public AbstractScen {
+public:
+    /// \brief State of a simulated client.
+    enum class ClientState {
+        INIT,      ///< Waiting to join.
+        SELECTING, ///< Discover/Solicit sent, waiting for the lease.
+        BOUND,     ///< Lease obtained.
+        RENEWING,  ///< Renewal sent at T1.
+        REBINDING  ///< Rebind sent at T2.
+    };
+
+    /// \brief Default and the only constructor of LifecycleScen.
+    ///
+    /// \param options reference to command options,
+    /// \param socket reference to a socket.
+    LifecycleScen(CommandOptions& options, BasePerfSocket &socket);
+
+    /// brief\ Run performance test.
+    ///
+    /// Method runs whole performance test.
+    ///
+    /// \return execution status.
+    int run() override;
+
+    /// \brief Return the state of a client.
+    ///
+    /// \param index index of the client.
+    /// \throw isc::OutOfRange if the index is out of range.
+    /// \return state of the client.
+    ClientState getClientState(uint32_t index) const;
+
+    /// \brief Return the number of clients in a state.
+    ///
+    /// \param state state of the clients.
+    /// \return number of clients.
+    size_t getClientsNum(ClientState state) const;
+
+protected:
+    /// \brief Timer event types.
+    enum class EventType {
+        TIMEOUT, ///< Lease not obtained within drop time.
+        RENEW,   ///< T1 elapsed.
+        REBIND,  ///< T2 elapsed.
+        EXPIRE   ///< Valid lifetime elapsed.
+    };
+
+    /// \brief Timer event of a client.
+    struct Event {
+        boost::posix_time::ptime time_; ///< Time the event fires.
+        uint32_t client_;               ///< Index of the client.
+        uint32_t seq_;                  ///< Sequence number of the client.
+        EventType type_;                ///< Type of the event.
+
+        /// \brief Order events by time, the earliest first.
+        bool operator>(const Event& other) const {
+            return (time_ > other.time_);
+        }
+    };
+
+    /// \brief Simulated client.
+    struct Client {
+        /// \brief Constructor.
+        Client() : state_(ClientState::INIT), seq_(0) {
+        }
+
+        ClientState state_;  ///< Current state.
+        uint32_t seq_;       ///< Sequence number invalidating timers.
+        dhcp::PktPtr lease_; ///< DHCPACK or Reply holding the lease.
+    };
+
+    /// \brief Generator returning the index of the client to join.
+    ///
+    /// It replaces the sequential MAC address generator of the
+    /// \ref TestControl so as the Discover or Solicit is sent on
+    /// behalf of a given client.
+    class ClientGenerator : public TestControl::NumberGenerator {
+    public:
+        /// \brief Constructor.
+        ClientGenerator() : next_(0) {
+        }
+
+        /// \brief Set the index of the next client.
+        ///
+        /// \param index index of the client.
+        void setNext(uint32_t index) {
+            next_ = index;
+        }
+
+        /// \brief Return the index of the next client.
+        ///
+        /// \return index of the client.
+        uint32_t generate() override {
+            return (next_);
+        }
+
+    private:
+        uint32_t next_; ///< Index of the next client.
+    };
+
+    /// \brief Pointer to the client generator.
+    typedef boost::shared_ptr<ClientGenerator> ClientGeneratorPtr;
+
+    /// \brief Send Discover or Solicit on behalf of a client.
+    ///
+    /// \param index index of the client.
+    void join(uint32_t index);
+
+    /// \brief Send Release on behalf of a bound client.
+    ///
+    /// \param index index of the client.
+    void release(uint32_t index);
+
+    /// \brief Release the leases of the given number of random clients
+    /// and make them rejoin.
+    ///
+    /// \param num number of clients to churn.
+    void churn(uint64_t num);
+
+    /// \brief Release the leases of all bound clients.
+    void releaseAll();
+
+    /// \brief Handle a response confirming a lease.
+    ///
+    /// It is installed as the \ref TestControl::ResponseHandler.
+    ///
+    /// \param xchg_type exchange type the response belongs to.
+    /// \param pkt received DHCPACK or Reply.
+    void processResponse(const ExchangeType xchg_type,
+                         const dhcp::PktPtr& pkt);
+
+    /// \brief Store the lease of a client and start its timers.
+    ///
+    /// \param index index of the client.
+    /// \param lease DHCPACK or Reply holding the lease.
+    /// \return false if the response holds no usable lease.
+    bool bind(uint32_t index, const dhcp::PktPtr& lease);
+
+    /// \brief Move a client to the INIT state and queue it to join.
+    ///
+    /// \param index index of the client.
+    void restart(uint32_t index);
+
+    /// \brief Schedule a timer event of a client.
+    ///
+    /// \param index index of the client.
+    /// \param type type of the event.
+    /// \param seconds delay of the event in seconds.
+    void schedule(uint32_t index, EventType type, double seconds);
+
+    /// \brief Process the timer events which are due.
+    void processEvents();
+
+    /// \brief Send the queued Discover or Solicit messages due.
+    void processJoins();
+
+    /// \brief Check if test exit conditions fulfilled.
+    ///
+    /// \return true if the test was interrupted or the test period
+    /// has elapsed.
+    bool checkExitConditions();
+
+    /// \brief Receive packets for the exit wait time (-W).
+    void drainResponses();
+
+    /// \brief Print per exchange rates and client counters.
+    void printLifecycleStats();
+
+    /// \brief Return the key identifying the client sending or
+    /// receiving a packet.
+    ///
+    /// \param pkt packet.
+    /// \return hardware address (DHCPv4) or client identifier (DHCPv6)
+    /// as a string of bytes.
+    std::string getClientKey(const dhcp::PktPtr& pkt) const;
+
+    /// \brief Extract the lease times from a DHCPACK or Reply.
+    ///
+    /// When the T1 or T2 times are not given by the server they are
+    /// set to 50% and 87.5% (DHCPv4) or 80% (DHCPv6) of the valid
+    /// lifetime.
+    ///
+    /// \param pkt DHCPACK or Reply.
+    /// \param [out] t1 renewal time in seconds.
+    /// \param [out] t2 rebind time in seconds.
+    /// \param [out] valid valid lifetime in seconds.
+    /// \return true if the packet holds a lease with non-zero lifetime.
+    bool getLeaseTimes(const dhcp::PktPtr& pkt, uint32_t& t1,
+                       uint32_t& t2, uint32_t& valid) const;
+
+    /// \brief Simulated clients.
+    std::vector<Client> clients_;
+
+    /// \brief Index of the clients by hardware address or client id.
+    std::unordered_map<std::string, uint32_t> client_keys_;
+
+    /// \brief Timer events, the earliest first.
+    std::priority_queue<Event, std::vector<Event>,
+                        std::greater<Event> > events_;
+
+    /// \brief Clients waiting to join.
+    std::deque<uint32_t> joins_;
+
+    /// \brief Generator selecting the joining client.
+    ClientGeneratorPtr client_gen_;
+
+    /// \brief A rate control class for joining clients.
+    RateControl join_rate_control_;
+
+    /// \brief A rate control class for churning clients.
+    RateControl churn_rate_control_;
+
+    /// \brief Exchange types of renewals, rebinds and releases.
+    ExchangeType renew_xchg_;
+    ExchangeType rebind_xchg_;
+    ExchangeType release_xchg_;
+};
+
+}
+}
+
+#endif // LIFECYCLE_SCEN_H
@@ -9,6 +9,8 @@
 #include <perfdhcp/avalanche_scen.h>
 #include <perfdhcp/basic_scen.h>
 #include <perfdhcp/command_options.h>
+#include <perfdhcp/lifecycle_scen.h>
+#include <perfdhcp/parallel_scen.h>
 
 #include <exceptions/exceptions.h>
 
@@ -38,12 +40,18 @@ main(int argc, char* argv[]) {
         parser_error = false;
         auto scenario = command_options.getScenario();
         PerfSocket socket(command_options);
-        if (scenario == Scenario::BASIC) {
+        if (command_options.getWorkers() > 1) {
+            ParallelScen scen(command_options, socket);
+            ret_code = scen.run();
+        } else if (scenario == Scenario::BASIC) {
             BasicScen scen(command_options, socket);
             ret_code = scen.run();
         } else if (scenario == Scenario::AVALANCHE) {
             AvalancheScen scen(command_options, socket);
             ret_code = scen.run();
+        } else if (scenario == Scenario::LIFECYCLE) {
+            LifecycleScen scen(command_options, socket);
+            ret_code = scen.run();
         }
     } catch (const std::exception& e) {
         ret_code = 1;
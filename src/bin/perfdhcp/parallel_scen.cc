@@ -0,0 +1,147 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <perfdhcp/parallel_scen.h>
+#include <util/multi_threading_mgr.h>
+
+#include <functional>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+using namespace isc;
+using namespace isc::dhcp;
+using namespace isc::util;
+namespace ph = std::placeholders;
+
+
+namespace isc {
+namespace perfdhcp {
+
+namespace {
+
+/// \brief Returns copy of the command options with the worker's share.
+///
+/// \param options command options of the whole test,
+/// \param index index of the worker.
+CommandOptions
+workerOptions(const CommandOptions& options, uint32_t index) {
+    CommandOptions worker_options(options);
+    worker_options.setWorkerShare(index);
+    return (worker_options);
+}
+
+}
+
+ParallelScen::Worker::Worker(const CommandOptions& options, uint32_t index,
+                             BasePerfSocket& socket,
+                             std::unique_ptr<BasePerfSocket> receiver,
+                             const WorkerSocket::Forwarder& forward) :
+    options_(workerOptions(options, index)),
+    receiver_(std::move(receiver)),
+    socket_(socket, *receiver_, forward),
+    scen_(options_, socket_) {
+}
+
+void
+ParallelScen::createWorkers() {
+    workers_.clear();
+    // Workers are created sequentially because the test controller
+    // initializes global state, e.g. registers option factories, and
+    // because the sockets of the workers are opened in their order.
+    for (uint32_t index = 0; index < options_.getWorkers(); ++index) {
+        WorkerSocket::Forwarder forwarder =
+            std::bind(&ParallelScen::forward, this, index, ph::_1);
+        workers_.push_back(WorkerPtr(new Worker(options_, index, socket_,
+                                                socket_.openWorkerSocket(index),
+                                                forwarder)));
+    }
+}
+
+void
+ParallelScen::runWorker(Worker& worker) {
+    try {
+        worker.scen_.runWorker();
+    } catch (...) {
+        worker.error_ = std::current_exception();
+    }
+}
+
+bool
+ParallelScen::forward(uint32_t index, const PktPtr& pkt) {
+    uint32_t owner = TestControl::getWorkerByTransid(options_,
+                                                     pkt->getTransid());
+    if (owner == index) {
+        return (false);
+    }
+    workers_[owner]->socket_.push(pkt);
+    return (true);
+}
+
+int
+ParallelScen::run() {
+    // Fork and run command specified with -w<wrapped-command>
+    if (!options_.getWrapped().empty()) {
+        tc_.runWrapped();
+    }
+
+    createWorkers();
+
+    // The workers look up interfaces in IfaceMgr concurrently.
+    MultiThreadingMgr::instance().setMode(true);
+    std::vector<std::thread> threads;
+    for (auto const& worker : workers_) {
+        threads.push_back(std::thread(std::bind(&ParallelScen::runWorker,
+                                                this, std::ref(*worker))));
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    MultiThreadingMgr::instance().setMode(false);
+
+    for (auto const& worker : workers_) {
+        if (worker->error_) {
+            std::rethrow_exception(worker->error_);
+        }
+    }
+
+    // Merge statistics gathered by all workers.
+    StatsMgr& stats_mgr(tc_.getStatsMgr());
+    for (auto const& worker : workers_) {
+        stats_mgr.merge(worker->scen_.getStatsMgr());
+    }
+
+    tc_.printStats();
+
+    if (!options_.getWrapped().empty()) {
+        // true means that we execute wrapped command with 'stop' argument.
+        tc_.runWrapped(true);
+    }
+
+    // Print packet timestamps
+    if (options_.testDiags('t')) {
+        stats_mgr.printTimestamps();
+    }
+
+    // Diagnostics flag 'e' means show exit reason.
+    if (options_.testDiags('e')) {
+        std::cout << "Interrupted" << std::endl;
+    }
+
+    // Print any received leases.
+    if (options_.testDiags('l')) {
+        stats_mgr.printLeases();
+    }
+
+    // Check if any packet drops occurred.
+    return (stats_mgr.droppedPackets() ? 3 : 0);
+}
+
+}  // namespace perfdhcp
+}  // namespace isc
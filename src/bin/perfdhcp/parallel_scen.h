@@ -0,0 +1,120 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PARALLEL_SCEN_H
+#define PARALLEL_SCEN_H
+
+#include <config.h>
+
+#include <perfdhcp/abstract_scen.h>
+#include <perfdhcp/basic_scen.h>
+
+#include <exception>
+#include <memory>
+#include <vector>
+
+namespace isc {
+namespace perfdhcp {
+
+/// \brief Parallel Scenario class.
+///
+/// This class is used to run the basic scenario with the load generated
+/// by multiple workers. Each worker runs in its own thread and has its
+/// own \ref TestControl with its own statistics, its share of the rates
+/// and of the number of requests, its own slice of the simulated clients
+/// and its own block of transaction ids (see
+/// \ref CommandOptions::setWorkerShare).
+///
+/// All workers send packets through the same socket because the server
+/// responds to the relay address or to the source address and port of
+/// the request, which are the same for all workers. Each worker receives
+/// the responses in its own loop from its own socket bound to the same
+/// address and port (see \ref PerfSocket::openWorkerSocket): the kernel
+/// steers the packets to the workers by the transaction id and the rare
+/// packets received by another worker are forwarded to their owner.
+/// When all workers are finished their statistics are merged and
+/// reported.
+class ParallelScen : public AbstractScen {
+public:
+    /// \brief Default and the only constructor of ParallelScen.
+    ///
+    /// \param options reference to command options,
+    /// \param socket reference to a socket.
+    ParallelScen(CommandOptions& options, BasePerfSocket &socket) :
+        AbstractScen(options, socket),
+        socket_(socket) {};
+
+    /// \brief Run performance test.
+    ///
+    /// Method starts the workers, waits until all of them are finished,
+    /// then prints merged statistics.
+    ///
+    /// \return execution status.
+    int run() override;
+
+protected:
+    /// \brief Worker generating a part of the load.
+    struct Worker {
+        /// \brief Constructor.
+        ///
+        /// \param options command options of the whole test,
+        /// \param index index of the worker,
+        /// \param socket shared socket,
+        /// \param receiver socket receiving the packets of the worker,
+        /// \param forward callback forwarding the packets of other workers.
+        Worker(const CommandOptions& options, uint32_t index,
+               BasePerfSocket& socket,
+               std::unique_ptr<BasePerfSocket> receiver,
+               const WorkerSocket::Forwarder& forward);
+
+        /// \brief Command options with the worker's share of the load.
+        CommandOptions options_;
+
+        /// \brief Socket receiving the packets of the worker.
+        std::unique_ptr<BasePerfSocket> receiver_;
+
+        /// \brief Socket wrapper used by the worker.
+        WorkerSocket socket_;
+
+        /// \brief Scenario run by the worker.
+        BasicScen scen_;
+
+        /// \brief Error which terminated the worker.
+        std::exception_ptr error_;
+    };
+
+    /// \brief Pointer to a worker.
+    typedef std::unique_ptr<Worker> WorkerPtr;
+
+    /// \brief Create the workers.
+    void createWorkers();
+
+    /// \brief Run the worker.
+    ///
+    /// This is the body of the worker threads.
+    ///
+    /// \param worker worker to be run.
+    void runWorker(Worker& worker);
+
+    /// \brief Forward a packet received by a worker to the worker
+    /// which sent the request with the same transaction id.
+    ///
+    /// \param index index of the worker which received the packet,
+    /// \param pkt received packet.
+    /// \return true if the packet was forwarded to another worker.
+    bool forward(uint32_t index, const dhcp::PktPtr& pkt);
+
+    /// \brief Shared socket.
+    BasePerfSocket& socket_;
+
+    /// \brief Workers generating the load.
+    std::vector<WorkerPtr> workers_;
+};
+
+}
+}
+
+#endif // PARALLEL_SCEN_H
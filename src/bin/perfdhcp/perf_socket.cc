@@ -1,4 +1,4 @@
-// Copyright (C) 2012-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2012-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -10,19 +10,144 @@
 #include <perfdhcp/perf_socket.h>
 #include <perfdhcp/command_options.h>
 #include <perfdhcp/stats_mgr.h>
+#include <perfdhcp/test_control.h>
 
+#include <dhcp/dhcp6.h>
 #include <dhcp/iface_mgr.h>
+#include <dhcp/pkt_filter_inet.h>
+#include <dhcp/pkt_filter_inet6.h>
 #include <asiolink/io_address.h>
 
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
+
+#ifdef OS_LINUX
+#include <linux/filter.h>
+#endif
+
 using namespace isc::dhcp;
 using namespace isc::asiolink;
 
 namespace isc {
 namespace perfdhcp {
 
+namespace {
+
+/// \brief Unpack a received packet.
+///
+/// Malformed packets are counted and returned as they are.
+///
+/// \param pkt received packet.
+void
+unpackPacket(const PktPtr& pkt) {
+    if (pkt) {
+        try {
+            pkt->unpack();
+        } catch (const std::exception &e) {
+                ExchangeStats::malformed_pkts_++;
+                std::cout << "Incorrect DHCP packet received"
+                          << e.what() << std::endl;
+        }
+    }
+}
+
+/// \brief Open an IPv4 socket with the SO_REUSEPORT option.
+///
+/// The socket is set up as the sockets opened by PktFilterInet but
+/// it may share its address and port with other sockets.
+///
+/// \param addr address to bind the socket to,
+/// \param port port to bind the socket to.
+/// \return socket descriptor.
+/// \throw isc::Unexpected if the socket can't be opened.
+int
+openReusePortSocket4(const IOAddress& addr, uint16_t port) {
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) {
+        isc_throw(Unexpected, "unable to open UDP4 socket: "
+                  << strerror(errno));
+    }
+
+    int flag = 1;
+    if ((fcntl(sock, F_SETFD, FD_CLOEXEC) < 0) ||
+        (setsockopt(sock, SOL_SOCKET, SO_REUSEADDR,
+                    &flag, sizeof(flag)) < 0) ||
+        (setsockopt(sock, SOL_SOCKET, SO_REUSEPORT,
+                    &flag, sizeof(flag)) < 0)) {
+        close(sock);
+        isc_throw(Unexpected, "unable to set up UDP4 socket for workers: "
+                  << strerror(errno));
+    }
+
+    struct sockaddr_in addr4;
+    memset(&addr4, 0, sizeof(addr4));
+    addr4.sin_family = AF_INET;
+    addr4.sin_port = htons(port);
+    addr4.sin_addr.s_addr = htonl(addr.toUint32());
+    if (bind(sock, reinterpret_cast<struct sockaddr*>(&addr4),
+             sizeof(addr4)) < 0) {
+        close(sock);
+        isc_throw(Unexpected, "unable to bind UDP4 socket to " << addr
+                  << "/port=" << port << ": " << strerror(errno));
+    }
+
+    // The destination address is retrieved in the same way as PktFilterInet.
+#if defined (IP_PKTINFO) && defined (OS_LINUX)
+    if (setsockopt(sock, IPPROTO_IP, IP_PKTINFO, &flag, sizeof(flag)) != 0) {
+        close(sock);
+        isc_throw(Unexpected, "setsockopt: IP_PKTINFO: failed.");
+    }
+#elif defined (IP_RECVDSTADDR) && defined (OS_BSD)
+    if (setsockopt(sock, IPPROTO_IP, IP_RECVDSTADDR, &flag, sizeof(flag)) != 0) {
+        close(sock);
+        isc_throw(Unexpected, "setsockopt: IP_RECVDSTADDR: failed.");
+    }
+#endif
+
+    return (sock);
+}
+
+/// \brief Reopen an IPv4 socket opened by IfaceMgr with SO_REUSEPORT.
+///
+/// IfaceMgr resolves the address and the interface to bind to but it
+/// does not allow other sockets on the same address and port. The
+/// socket is replaced on its interface by a socket which does.
+///
+/// \param sock descriptor of the socket opened by IfaceMgr.
+/// \return descriptor of the new socket.
+int
+reopenReusePortSocket4(int sock) {
+    for (IfacePtr iface : IfaceMgr::instance().getIfaces()) {
+        for (SocketInfo s : iface->getSockets()) {
+            if (s.sockfd_ == sock) {
+                iface->delSocket(sock);
+                int new_sock = openReusePortSocket4(s.addr_, s.port_);
+                iface->addSocket(SocketInfo(s.addr_, s.port_, new_sock));
+                return (new_sock);
+            }
+        }
+    }
+    isc_throw(BadValue, "interface for specified socket descriptor not found");
+}
+
+}
+
+std::unique_ptr<BasePerfSocket>
+BasePerfSocket::openWorkerSocket(uint32_t) {
+    isc_throw(NotImplemented, "sockets of workers are not supported");
+}
+
 PerfSocket::PerfSocket(CommandOptions& options) {
     sockfd_ = openSocket(options);
     initSocketData();
+    if (options.getWorkers() > 1) {
+        steerToWorkers(options);
+    }
 }
 
 
@@ -83,6 +208,13 @@ PerfSocket::openSocket(CommandOptions& options) const {
                   "DHCP server");
     }
 
+    // When the load is generated by multiple workers each of them
+    // receives from its own socket bound to the same address and port.
+    // IfaceMgr sets SO_REUSEPORT on IPv6 sockets only.
+    if ((options.getWorkers() > 1) && (family == AF_INET)) {
+        sock = reopenReusePortSocket4(sock);
+    }
+
     // IfaceMgr does not set broadcast option on the socket. We rely
     // on CommandOptions object to find out if socket has to have
     // broadcast enabled.
@@ -139,6 +271,8 @@ PerfSocket::initSocketData() {
             if (s.sockfd_ == sockfd_) {
                 ifindex_ = iface->getIndex();
                 addr_ = s.addr_;
+                port_ = s.port_;
+                family_ = s.family_;
                 return;
             }
         }
@@ -149,30 +283,14 @@ PerfSocket::initSocketData() {
 Pkt4Ptr
 PerfSocket::receive4(uint32_t timeout_sec, uint32_t timeout_usec) {
     Pkt4Ptr pkt = IfaceMgr::instance().receive4(timeout_sec, timeout_usec);
-    if (pkt) {
-        try {
-            pkt->unpack();
-        } catch (const std::exception &e) {
-                ExchangeStats::malformed_pkts_++;
-                std::cout << "Incorrect DHCP packet received"
-                          << e.what() << std::endl;
-        }
-    }
+    unpackPacket(pkt);
     return (pkt);
 }
 
 Pkt6Ptr
 PerfSocket::receive6(uint32_t timeout_sec, uint32_t timeout_usec) {
     Pkt6Ptr pkt = IfaceMgr::instance().receive6(timeout_sec, timeout_usec);
-    if (pkt) {
-        try {
-            pkt->unpack();
-        } catch (const std::exception &e) {
-                ExchangeStats::malformed_pkts_++;
-                std::cout << "Incorrect DHCP packet received"
-                          << e.what() << std::endl;
-        }
-    }
+    unpackPacket(pkt);
     return (pkt);
 }
 
@@ -191,5 +309,219 @@ PerfSocket::getIface() {
     return (IfaceMgr::instance().getIface(ifindex_));
 }
 
+std::unique_ptr<BasePerfSocket>
+PerfSocket::openWorkerSocket(uint32_t index) {
+    return (std::unique_ptr<BasePerfSocket>(new ReceiverSocket(*this,
+                                                               index == 0 ?
+                                                               sockfd_ : -1)));
+}
+
+void
+PerfSocket::steerToWorkers(const CommandOptions& options) {
+#if defined(OS_LINUX) && defined(SO_ATTACH_REUSEPORT_CBPF)
+    // The program runs on the UDP payload and returns the index of the
+    // socket in the group, i.e. the index of the worker as the sockets
+    // are opened in this order. An index out of range makes the kernel
+    // fall back to the hash of the source.
+    uint32_t block_size = TestControl::getTransidBlockSize(options);
+    uint32_t last = options.getWorkers() - 1;
+    std::vector<struct sock_filter> filter;
+    if (options.getIpVersion() == 4) {
+        // The transaction id follows op, htype, hlen and hops.
+        filter.push_back(BPF_STMT(BPF_LD + BPF_W + BPF_ABS, 4));
+    } else {
+        uint32_t offset = 0;
+        if (options.isUseRelayedV6()) {
+            // The relay-reply header (msg-type, hop-count, link-address
+            // and peer-address) is followed by the relay message option
+            // as perfdhcp does not add other relay options.
+            filter.push_back(BPF_STMT(BPF_LD + BPF_H + BPF_ABS, 34));
+            filter.push_back(BPF_JUMP(BPF_JMP + BPF_JEQ + BPF_K,
+                                      D6O_RELAY_MSG, 1, 0));
+            filter.push_back(BPF_STMT(BPF_RET + BPF_K, 0xffffffff));
+            offset = 38;
+        }
+        // The transaction id is in the 3 bytes following msg-type.
+        filter.push_back(BPF_STMT(BPF_LD + BPF_W + BPF_ABS, offset));
+        filter.push_back(BPF_STMT(BPF_ALU + BPF_AND + BPF_K, 0x00ffffff));
+    }
+    filter.push_back(BPF_STMT(BPF_ALU + BPF_DIV + BPF_K, block_size));
+    // Transaction ids above the last block belong to the last worker.
+    filter.push_back(BPF_JUMP(BPF_JMP + BPF_JGT + BPF_K, last, 0, 1));
+    filter.push_back(BPF_STMT(BPF_RET + BPF_K, last));
+    filter.push_back(BPF_STMT(BPF_RET + BPF_A, 0));
+
+    struct sock_fprog prog;
+    memset(&prog, 0, sizeof(prog));
+    prog.len = filter.size();
+    prog.filter = &filter[0];
+    if (setsockopt(sockfd_, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF,
+                   &prog, sizeof(prog)) < 0) {
+        std::cout << "Unable to steer received packets to workers: "
+                  << strerror(errno) << std::endl;
+    }
+#else
+    static_cast<void>(options);
+#endif
+}
+
+ReceiverSocket::ReceiverSocket(BasePerfSocket& socket, int sockfd) :
+    socket_(socket), owned_(sockfd < 0) {
+    ifindex_ = socket.ifindex_;
+    addr_ = socket.addr_;
+    port_ = socket.port_;
+    family_ = socket.family_;
+    sockfd_ = sockfd;
+    if (!owned_) {
+        return;
+    }
+    if (family_ == AF_INET) {
+        sockfd_ = openReusePortSocket4(addr_, port_);
+    } else {
+        IfacePtr iface = socket_.getIface();
+        if (!iface) {
+            isc_throw(Unexpected, "interface of the socket not found");
+        }
+        // IPv6 sockets are opened with SO_REUSEPORT by PktFilterInet6.
+        sockfd_ = PktFilterInet6().openSocket(*iface, addr_, port_,
+                                              false).sockfd_;
+    }
+}
+
+ReceiverSocket::~ReceiverSocket() {
+    if (owned_) {
+        close(sockfd_);
+    }
+}
+
+bool
+ReceiverSocket::waitForPacket(uint32_t timeout_sec, uint32_t timeout_usec) {
+    fd_set sockets;
+    FD_ZERO(&sockets);
+    FD_SET(sockfd_, &sockets);
+    struct timeval select_timeout;
+    select_timeout.tv_sec = timeout_sec + timeout_usec / 1000000;
+    select_timeout.tv_usec = timeout_usec % 1000000;
+    int result = select(sockfd_ + 1, &sockets, 0, 0, &select_timeout);
+    if ((result < 0) && (errno != EINTR)) {
+        isc_throw(Unexpected, "failed to wait for a packet: "
+                  << strerror(errno));
+    }
+    return (result > 0);
+}
+
+Pkt4Ptr
+ReceiverSocket::receive4(uint32_t timeout_sec, uint32_t timeout_usec) {
+    if (!waitForPacket(timeout_sec, timeout_usec)) {
+        return (Pkt4Ptr());
+    }
+    IfacePtr iface = getIface();
+    if (!iface) {
+        isc_throw(Unexpected, "interface of the socket not found");
+    }
+    Pkt4Ptr pkt = PktFilterInet().receive(*iface, *this);
+    unpackPacket(pkt);
+    return (pkt);
+}
+
+Pkt6Ptr
+ReceiverSocket::receive6(uint32_t timeout_sec, uint32_t timeout_usec) {
+    if (!waitForPacket(timeout_sec, timeout_usec)) {
+        return (Pkt6Ptr());
+    }
+    Pkt6Ptr pkt = PktFilterInet6().receive(*this);
+    unpackPacket(pkt);
+    return (pkt);
+}
+
+bool
+ReceiverSocket::send(const Pkt4Ptr& pkt) {
+    return (socket_.send(pkt));
+}
+
+bool
+ReceiverSocket::send(const Pkt6Ptr& pkt) {
+    return (socket_.send(pkt));
+}
+
+IfacePtr
+ReceiverSocket::getIface() {
+    return (socket_.getIface());
+}
+
+WorkerSocket::WorkerSocket(BasePerfSocket& socket, BasePerfSocket& receiver,
+                           const Forwarder& forward) :
+    socket_(socket), receiver_(receiver), forward_(forward) {
+    ifindex_ = receiver.ifindex_;
+    addr_ = receiver.addr_;
+    port_ = receiver.port_;
+    family_ = receiver.family_;
+    sockfd_ = receiver.sockfd_;
+    fallbackfd_ = receiver.fallbackfd_;
+}
+
+void
+WorkerSocket::push(const PktPtr& pkt) {
+    std::lock_guard<std::mutex> lock(pkt_queue_mutex_);
+    pkt_queue_.push(pkt);
+}
+
+PktPtr
+WorkerSocket::pop() {
+    std::lock_guard<std::mutex> lock(pkt_queue_mutex_);
+    if (pkt_queue_.empty()) {
+        return (PktPtr());
+    }
+    PktPtr pkt = pkt_queue_.front();
+    pkt_queue_.pop();
+    return (pkt);
+}
+
+bool
+WorkerSocket::forward(const PktPtr& pkt) {
+    return (pkt && forward_ && forward_(pkt));
+}
+
+Pkt4Ptr
+WorkerSocket::receive4(uint32_t timeout_sec, uint32_t timeout_usec) {
+    // Packets forwarded by other workers are received first.
+    PktPtr pkt = pop();
+    if (!pkt) {
+        pkt = receiver_.receive4(timeout_sec, timeout_usec);
+        if (forward(pkt)) {
+            return (Pkt4Ptr());
+        }
+    }
+    return (boost::dynamic_pointer_cast<Pkt4>(pkt));
+}
+
+Pkt6Ptr
+WorkerSocket::receive6(uint32_t timeout_sec, uint32_t timeout_usec) {
+    // Packets forwarded by other workers are received first.
+    PktPtr pkt = pop();
+    if (!pkt) {
+        pkt = receiver_.receive6(timeout_sec, timeout_usec);
+        if (forward(pkt)) {
+            return (Pkt6Ptr());
+        }
+    }
+    return (boost::dynamic_pointer_cast<Pkt6>(pkt));
+}
+
+bool
+WorkerSocket::send(const Pkt4Ptr& pkt) {
+    return (socket_.send(pkt));
+}
+
+bool
+WorkerSocket::send(const Pkt6Ptr& pkt) {
+    return (socket_.send(pkt));
+}
+
+IfacePtr
+WorkerSocket::getIface() {
+    return (socket_.getIface());
+}
+
 }
 }
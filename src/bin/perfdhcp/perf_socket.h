@@ -1,4 +1,4 @@
-// Copyright (C) 2012-2019 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2012-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -14,6 +14,11 @@
 #include <dhcp/socket_info.h>
 #include <dhcp/iface_mgr.h>
 
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+
 namespace isc {
 namespace perfdhcp {
 
@@ -50,6 +55,11 @@ public:
 
     /// \brief See description of this method in PerfSocket class below.
     virtual dhcp::IfacePtr getIface() = 0;
+
+    /// \brief See description of this method in PerfSocket class below.
+    ///
+    /// The default implementation throws isc::NotImplemented.
+    virtual std::unique_ptr<BasePerfSocket> openWorkerSocket(uint32_t index);
 };
 
 /// \brief Socket wrapper structure.
@@ -106,7 +116,35 @@ public:
     /// \return shared pointer to Iface.
     virtual dhcp::IfacePtr getIface() override;
 
+    /// \brief Open the socket receiving the packets of a worker.
+    ///
+    /// When the load is generated by multiple workers this socket is
+    /// opened with the SO_REUSEPORT option and each worker receives
+    /// from its own socket bound to the same address and port. The
+    /// first worker receives from this socket, the sockets of the other
+    /// workers must be opened in the order of their indexes because
+    /// the kernel steers the received packets to the sockets by the
+    /// transaction id (see \ref steerToWorkers).
+    ///
+    /// \param index index of the worker.
+    /// \return socket receiving the packets of the worker.
+    virtual std::unique_ptr<BasePerfSocket> openWorkerSocket(uint32_t index) override;
+
 protected:
+    /// \brief Steer received packets to the sockets of the workers.
+    ///
+    /// This method attaches a classic BPF program to the group of
+    /// sockets sharing the address and port of this socket. The program
+    /// extracts the transaction id from the received packet and returns
+    /// the index of the worker owning its block of transaction ids (see
+    /// \ref TestControl::getWorkerByTransid). When the program can't be
+    /// attached the kernel distributes the packets by the hash of their
+    /// source and the workers forward the packets which are not theirs
+    /// (see \ref WorkerSocket).
+    ///
+    /// \param options command options.
+    void steerToWorkers(const CommandOptions& options);
+
     /// \brief Initialize socket data.
     ///
     /// This method initializes members of the class that Interface
@@ -125,7 +163,9 @@ protected:
     /// reason, exception is thrown.
     /// If destination address is broadcast (for DHCPv4) or multicast
     /// (for DHCPv6) than broadcast or multicast option is set on
-    /// the socket. Opened socket is registered and managed by IfaceMgr.
+    /// the socket. When the load is generated by multiple workers the
+    /// SO_REUSEPORT option is set on the socket. Opened socket is
+    /// registered and managed by IfaceMgr.
     ///
     /// \throw isc::BadValue if socket can't be created for given
     /// interface, local address or remote address.
@@ -137,6 +177,170 @@ protected:
     int openSocket(CommandOptions& options) const;
 };
 
+/// \brief Socket receiving the packets of a worker.
+///
+/// It is opened by \ref PerfSocket::openWorkerSocket and it is bound
+/// to the same address and port as the \ref PerfSocket. The packets
+/// are received directly from the socket, without IfaceMgr, and they
+/// are sent through the \ref PerfSocket.
+class ReceiverSocket : public BasePerfSocket {
+public:
+    /// \brief Constructor.
+    ///
+    /// \param socket socket used to send packets, the new socket is
+    /// bound to its address and port,
+    /// \param sockfd descriptor of the socket to receive from or -1
+    /// to open a new socket.
+    /// \throw isc::Unexpected if the socket can't be opened.
+    ReceiverSocket(BasePerfSocket& socket, int sockfd = -1);
+
+    /// \brief Destructor.
+    ///
+    /// Destructor closes the socket opened by the constructor.
+    virtual ~ReceiverSocket();
+
+    /// \brief Receive DHCPv4 packet from the socket.
+    ///
+    /// \param timeout_sec number of seconds for waiting for a packet,
+    /// \param timeout_usec number of microseconds for waiting for a packet,
+    /// \return received packet or nullptr if timed out
+    virtual dhcp::Pkt4Ptr receive4(uint32_t timeout_sec, uint32_t timeout_usec) override;
+
+    /// \brief Receive DHCPv6 packet from the socket.
+    ///
+    /// \param timeout_sec number of seconds for waiting for a packet,
+    /// \param timeout_usec number of microseconds for waiting for a packet,
+    /// \return received packet or nullptr if timed out
+    virtual dhcp::Pkt6Ptr receive6(uint32_t timeout_sec, uint32_t timeout_usec) override;
+
+    /// \brief Send DHCPv4 packet through the shared socket.
+    ///
+    /// \param pkt a packet for sending
+    /// \return true if operation succeeded
+    virtual bool send(const dhcp::Pkt4Ptr& pkt) override;
+
+    /// \brief Send DHCPv6 packet through the shared socket.
+    ///
+    /// \param pkt a packet for sending
+    /// \return true if operation succeeded
+    virtual bool send(const dhcp::Pkt6Ptr& pkt) override;
+
+    /// \brief Get interface of the shared socket.
+    ///
+    /// \return shared pointer to Iface.
+    virtual dhcp::IfacePtr getIface() override;
+
+private:
+    /// \brief Wait until a packet can be read from the socket.
+    ///
+    /// \param timeout_sec number of seconds for waiting for a packet,
+    /// \param timeout_usec number of microseconds for waiting for a packet,
+    /// \return true if a packet can be read, false if timed out.
+    bool waitForPacket(uint32_t timeout_sec, uint32_t timeout_usec);
+
+    /// \brief Socket used to send packets.
+    BasePerfSocket& socket_;
+
+    /// \brief Indicates if the socket was opened by the constructor.
+    bool owned_;
+};
+
+/// \brief Socket wrapper used by a worker generating the load.
+///
+/// When the load is generated by multiple workers they send packets
+/// through the socket opened by \ref PerfSocket and each of them
+/// receives packets in its own loop from its own socket (see
+/// \ref PerfSocket::openWorkerSocket). The kernel steers the packets
+/// to the sockets of the workers which sent the matching requests.
+/// When a worker receives a packet of another worker anyway, e.g.
+/// because the steering program couldn't be attached, the packet is
+/// forwarded to the queue of the other worker, which is checked before
+/// the worker's socket.
+class WorkerSocket : public BasePerfSocket {
+public:
+    /// \brief Type of the callback forwarding a received packet.
+    ///
+    /// It returns true if the packet belongs to another worker and it
+    /// was forwarded to it, false otherwise.
+    typedef std::function<bool(const dhcp::PktPtr&)> Forwarder;
+
+    /// \brief Constructor.
+    ///
+    /// \param socket shared socket used to send packets,
+    /// \param receiver socket receiving the packets of the worker,
+    /// \param forward callback forwarding the packets of other workers.
+    WorkerSocket(BasePerfSocket& socket, BasePerfSocket& receiver,
+                 const Forwarder& forward = Forwarder());
+
+    /// \brief Destructor.
+    virtual ~WorkerSocket() = default;
+
+    /// \brief Push a packet forwarded by another worker to the queue.
+    ///
+    /// \param pkt received packet.
+    void push(const dhcp::PktPtr& pkt);
+
+    /// \brief Receive DHCPv4 packet of the worker.
+    ///
+    /// \param timeout_sec number of seconds for waiting for a packet,
+    /// \param timeout_usec number of microseconds for waiting for a packet,
+    /// \return received packet or nullptr if timed out or if the
+    /// received packet was forwarded to another worker.
+    virtual dhcp::Pkt4Ptr receive4(uint32_t timeout_sec, uint32_t timeout_usec) override;
+
+    /// \brief Receive DHCPv6 packet of the worker.
+    ///
+    /// \param timeout_sec number of seconds for waiting for a packet,
+    /// \param timeout_usec number of microseconds for waiting for a packet,
+    /// \return received packet or nullptr if timed out or if the
+    /// received packet was forwarded to another worker.
+    virtual dhcp::Pkt6Ptr receive6(uint32_t timeout_sec, uint32_t timeout_usec) override;
+
+    /// \brief Send DHCPv4 packet through the shared socket.
+    ///
+    /// \param pkt a packet for sending
+    /// \return true if operation succeeded
+    virtual bool send(const dhcp::Pkt4Ptr& pkt) override;
+
+    /// \brief Send DHCPv6 packet through the shared socket.
+    ///
+    /// \param pkt a packet for sending
+    /// \return true if operation succeeded
+    virtual bool send(const dhcp::Pkt6Ptr& pkt) override;
+
+    /// \brief Get interface of the shared socket.
+    ///
+    /// \return shared pointer to Iface.
+    virtual dhcp::IfacePtr getIface() override;
+
+private:
+    /// \brief Take a forwarded packet from the queue.
+    ///
+    /// \return forwarded packet or nullptr if the queue is empty.
+    dhcp::PktPtr pop();
+
+    /// \brief Forward the packet if it belongs to another worker.
+    ///
+    /// \param pkt received packet.
+    /// \return true if the packet was forwarded.
+    bool forward(const dhcp::PktPtr& pkt);
+
+    /// \brief Shared socket.
+    BasePerfSocket& socket_;
+
+    /// \brief Socket receiving the packets of the worker.
+    BasePerfSocket& receiver_;
+
+    /// \brief Callback forwarding the packets of other workers.
+    Forwarder forward_;
+
+    /// \brief Queue of packets forwarded by other workers.
+    std::queue<dhcp::PktPtr> pkt_queue_;
+
+    /// \brief Mutex protecting the queue.
+    std::mutex pkt_queue_mutex_;
+};
+
 }
 }
 
@@ -40,6 +40,7 @@ int dhcpVersion(ExchangeType const exchange_type) {
     case ExchangeType::RR:
     case ExchangeType::RN:
     case ExchangeType::RL:
+    case ExchangeType::RB:
         return 6;
     default:
         isc_throw(BadValue,
@@ -66,6 +67,8 @@ std::ostream& operator<<(std::ostream& os, ExchangeType xchg_type)
         return(os << "RENEW-REPLY");
     case ExchangeType::RL:
         return(os << "RELEASE-REPLY");
+    case ExchangeType::RB:
+        return(os << "REBIND-REPLY");
     default:
         return(os << "Unknown exchange type");
     }
@@ -86,6 +89,8 @@ ExchangeStats::ExchangeStats(const ExchangeType xchg_type,
       max_delay_(0.),
       sum_delay_(0.),
       sum_delay_squared_(0.),
+      delays_(),
+      interval_delays_(),
       orphans_(0),
       collected_(0),
       unordered_lookup_size_sum_(0),
@@ -149,6 +154,9 @@ ExchangeStats::updateDelays(const PktPtr& sent_packet,
     // mean delays.
     sum_delay_ += delta;
     sum_delay_squared_ += delta * delta;
+    // Record the delay in histograms used to calculate percentiles.
+    delays_.recordSeconds(delta);
+    interval_delays_.recordSeconds(delta);
 }
 
 PktPtr
@@ -298,6 +306,38 @@ ExchangeStats::matchPackets(const PktPtr& rcvd_packet) {
 }
 
 
+void
+ExchangeStats::merge(const ExchangeStats& other) {
+    if (other.xchg_type_ != xchg_type_) {
+        isc_throw(BadValue, "unable to merge statistics of " << other.xchg_type_
+                  << " exchange into statistics of " << xchg_type_
+                  << " exchange");
+    }
+    min_delay_ = std::min(min_delay_, other.min_delay_);
+    max_delay_ = std::max(max_delay_, other.max_delay_);
+    sum_delay_ += other.sum_delay_;
+    sum_delay_squared_ += other.sum_delay_squared_;
+    delays_.merge(other.delays_);
+    interval_delays_.merge(other.interval_delays_);
+    orphans_ += other.orphans_;
+    collected_ += other.collected_;
+    unordered_lookup_size_sum_ += other.unordered_lookup_size_sum_;
+    unordered_lookups_ += other.unordered_lookups_;
+    ordered_lookups_ += other.ordered_lookups_;
+    sent_packets_num_ += other.sent_packets_num_;
+    rcvd_packets_num_ += other.rcvd_packets_num_;
+    non_unique_addr_num_ += other.non_unique_addr_num_;
+    rejected_leases_num_ += other.rejected_leases_num_;
+    if (archive_enabled_) {
+        for (PktPtr const& packet : other.archived_packets_) {
+            static_cast<void>(archived_packets_.push_back(packet));
+        }
+        for (PktPtr const& packet : other.rcvd_packets_) {
+            static_cast<void>(rcvd_packets_.push_back(packet));
+        }
+    }
+}
+
 void
 ExchangeStats::printTimestamps() {
     // If archive mode is disabled there is no sense to proceed
@@ -391,6 +431,47 @@ StatsMgr::StatsMgr(CommandOptions& options) :
     }
 }
 
+void
+StatsMgr::merge(const StatsMgr& other) {
+    for (auto const& exchange : other.exchanges_) {
+        if (!hasExchangeStats(exchange.first)) {
+            addExchangeStats(exchange.first);
+        }
+        getExchangeStats(exchange.first)->merge(*exchange.second);
+    }
+    for (auto const& counter : other.custom_counters_) {
+        if (custom_counters_.find(counter.first) == custom_counters_.end()) {
+            addCustomCounter(counter.first, counter.second->getName());
+        }
+        incrementCounter(counter.first, counter.second->getValue());
+    }
+}
+
+void
+StatsMgr::printLatencyCsvHeader(std::ostream& out) {
+    out << "time,exchange,responses,min,p50,p90,p99,p99.9,max" << std::endl;
+}
+
+void
+StatsMgr::printLatencyCsv(std::ostream& out) const {
+    boost::posix_time::time_period elapsed(boot_time_,
+        boost::posix_time::microsec_clock::universal_time());
+    std::ostringstream time;
+    time << std::fixed << std::setprecision(3)
+         << elapsed.length().total_milliseconds() / 1e3;
+    for (auto const& exchange : exchanges_) {
+        const LatencyHistogram& delays = exchange.second->getIntervalDelays();
+        out << time.str() << ",\"" << exchange.first << "\","
+            << delays.getCount() << std::fixed << std::setprecision(3)
+            << "," << delays.getMin() / 1e3
+            << "," << delays.getPercentile(50) / 1e3
+            << "," << delays.getPercentile(90) / 1e3
+            << "," << delays.getPercentile(99) / 1e3
+            << "," << delays.getPercentile(99.9) / 1e3
+            << "," << delays.getMax() / 1e3 << std::endl;
+    }
+}
+
 std::string
 ExchangeStats::receivedLeases() const {
     // Get DHCP version.
@@ -467,7 +548,7 @@ void StatsMgr::printLeases() const {
     }
 }
 
-int ExchangeStats::malformed_pkts_{0};
+std::atomic<int> ExchangeStats::malformed_pkts_{0};
 
 }  // namespace perfdhcp
 }  // namespace isc
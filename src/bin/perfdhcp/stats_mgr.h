@@ -10,6 +10,7 @@
 #include <dhcp/pkt.h>
 #include <exceptions/exceptions.h>
 #include <perfdhcp/command_options.h>
+#include <perfdhcp/latency_histogram.h>
 
 #include <boost/noncopyable.hpp>
 #include <boost/shared_ptr.hpp>
@@ -20,9 +21,12 @@
 #include <boost/multi_index/mem_fun.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#include <atomic>
+#include <iomanip>
 #include <iostream>
 #include <map>
 #include <queue>
+#include <sstream>
 
 
 namespace isc {
@@ -37,7 +41,8 @@ enum class ExchangeType {
     SA,  ///< DHCPv6 SOLICIT-ADVERTISE
     RR,  ///< DHCPv6 REQUEST-REPLY
     RN,  ///< DHCPv6 RENEW-REPLY
-    RL   ///< DHCPv6 RELEASE-REPLY
+    RL,  ///< DHCPv6 RELEASE-REPLY
+    RB   ///< DHCPv6 REBIND-REPLY
 };
 
 /// \brief Get the DHCP version that fits the exchange type.
@@ -389,6 +394,37 @@ public:
                     getAvgDelay() * getAvgDelay()));
     }
 
+    /// \brief Return packet delay at the given percentile.
+    ///
+    /// Method returns the delay at the percentile of all delays recorded
+    /// in the histogram of this exchange. The value is accurate within 1%.
+    ///
+    /// \param percentile percentile between 0 and 100.
+    /// \throw isc::BadValue if percentile is out of range.
+    /// \return packet delay or 0 if no packets have been received.
+    double getDelayPercentile(double percentile) const {
+        return (delays_.getPercentile(percentile) / 1e6);
+    }
+
+    /// \brief Return histogram of all packet delays.
+    ///
+    /// \return histogram of delays in microseconds.
+    const LatencyHistogram& getDelays() const { return (delays_); }
+
+    /// \brief Return histogram of packet delays in the current interval.
+    ///
+    /// The interval starts when the exchange is created or when
+    /// \ref resetIntervalDelays is called. It is used by intermediate
+    /// reports.
+    ///
+    /// \return histogram of delays in microseconds.
+    const LatencyHistogram& getIntervalDelays() const {
+        return (interval_delays_);
+    }
+
+    /// \brief Start new interval of packet delays.
+    void resetIntervalDelays() { interval_delays_.reset(); }
+
     /// \brief Return number of orphan packets.
     ///
     /// Method returns number of received packets that had no matching
@@ -530,9 +566,10 @@ public:
     ///
     /// Method prints round trip time packets statistics. Statistics
     /// includes minimum packet delay, maximum packet delay, average
-    /// packet delay and standard deviation of delays. Packet delay
-    /// is a duration between sending a packet to server and receiving
-    /// response from server.
+    /// packet delay, standard deviation of delays and delays at 50th,
+    /// 90th, 99th and 99.9th percentiles. Packet delay is a duration
+    /// between sending a packet to server and receiving response from
+    /// server.
     void printRTTStats() const {
         using namespace std;
         try {
@@ -542,6 +579,14 @@ public:
                  << "max delay: " << getMaxDelay() * 1e3 << " ms" << endl
                  << "std deviation: " << getStdDevDelay() * 1e3 << " ms"
                  << endl
+                 << "p50 delay: " << getDelayPercentile(50) * 1e3 << " ms"
+                 << endl
+                 << "p90 delay: " << getDelayPercentile(90) * 1e3 << " ms"
+                 << endl
+                 << "p99 delay: " << getDelayPercentile(99) * 1e3 << " ms"
+                 << endl
+                 << "p99.9 delay: " << getDelayPercentile(99.9) * 1e3
+                 << " ms" << endl
                  << "collected packets: " << getCollectedNum() << endl;
         } catch (const Exception&) {
             // repeated output for easier automated parsing
@@ -549,10 +594,28 @@ public:
                  << "avg delay: n/a" << endl
                  << "max delay: n/a" << endl
                  << "std deviation: n/a" << endl
+                 << "p50 delay: n/a" << endl
+                 << "p90 delay: n/a" << endl
+                 << "p99 delay: n/a" << endl
+                 << "p99.9 delay: n/a" << endl
                  << "collected packets: 0" << endl;
         }
     }
 
+    /// \brief Merge statistics of the same exchange type.
+    ///
+    /// Method adds counters and delays gathered by another object to
+    /// this object. It is used to combine the statistics gathered by
+    /// the workers generating the load. Packets which are still waiting
+    /// for responses in the other object are counted as sent but they
+    /// are not moved, so they can't be matched with responses anymore.
+    /// Archived packets are appended to this object's archive when
+    /// archive mode is enabled.
+    ///
+    /// \param other statistics to be merged.
+    /// \throw isc::BadValue if exchange types are different.
+    void merge(const ExchangeStats& other);
+
     //// \brief Print timestamps for sent and received packets.
     ///
     /// Method prints timestamps for all sent and received packets for
@@ -582,7 +645,11 @@ public:
     /// \brief Print the list of received leases.
     void printLeases() const;
 
-    static int malformed_pkts_;
+    /// \brief Number of malformed packets.
+    ///
+    /// It is atomic because packets can be received and parsed in
+    /// multiple threads.
+    static std::atomic<int> malformed_pkts_;
 
 // Private stuff of ExchangeStats class
 private:
@@ -656,6 +723,10 @@ private:
     double sum_delay_squared_;     ///< Squared sum of delays between
                                    ///< sent and received packets.
 
+    LatencyHistogram delays_;          ///< Histogram of all delays.
+    LatencyHistogram interval_delays_; ///< Histogram of delays in the
+                                       ///< current interval.
+
     uint64_t orphans_;   ///< Number of orphan received packets.
 
     uint64_t collected_; ///< Number of garbage collected packets.
@@ -910,6 +981,22 @@ public:
         return(xchg_stats->getStdDevDelay());
     }
 
+    /// \brief Return packet delay at the given percentile.
+    ///
+    /// Method returns packet delay at the percentile for specified
+    /// exchange type.
+    ///
+    /// \param xchg_type exchange type.
+    /// \param percentile percentile between 0 and 100.
+    /// \throw isc::BadValue if invalid exchange type specified or
+    /// percentile is out of range.
+    /// \return packet delay.
+    double getDelayPercentile(const ExchangeType xchg_type,
+                              double percentile) const {
+        ExchangeStatsPtr xchg_stats = getExchangeStats(xchg_type);
+        return(xchg_stats->getDelayPercentile(percentile));
+    }
+
     /// \brief Return number of orphan packets.
     ///
     /// Method returns number of orphan packets for specified
@@ -1115,7 +1202,9 @@ public:
     ///
     /// Method prints intermediate statistics for all exchanges.
     /// Statistics includes sent, received and dropped packets
-    /// counters.
+    /// counters and the 50th, 90th, 99th and 99.9th percentiles and
+    /// the maximum of packet delays in the current interval (see
+    /// \ref resetIntervalDelays).
     ///
     /// \param clean_report value to generate easy to parse report.
     /// \param clean_sep string used as separator if clean_report enabled..
@@ -1125,6 +1214,15 @@ public:
         std::ostringstream stream_rcvd;
         std::ostringstream stream_drops;
         std::ostringstream stream_reject;
+        std::ostringstream stream_p50;
+        std::ostringstream stream_p90;
+        std::ostringstream stream_p99;
+        std::ostringstream stream_p999;
+        std::ostringstream stream_max;
+        for (auto stream : { &stream_p50, &stream_p90, &stream_p99,
+                             &stream_p999, &stream_max }) {
+            *stream << std::fixed << std::setprecision(3);
+        }
         std::string sep("");
         for (ExchangesMapIterator it = exchanges_.begin();
              it != exchanges_.end(); ++it) {
@@ -1140,6 +1238,12 @@ public:
             stream_rcvd << sep << it->second->getRcvdPacketsNum();
             stream_drops << sep << it->second->getDroppedPacketsNum();
             stream_reject << sep << it->second->getRejLeasesNum();
+            const LatencyHistogram& delays = it->second->getIntervalDelays();
+            stream_p50 << sep << delays.getPercentile(50) / 1e3;
+            stream_p90 << sep << delays.getPercentile(90) / 1e3;
+            stream_p99 << sep << delays.getPercentile(99) / 1e3;
+            stream_p999 << sep << delays.getPercentile(99.9) / 1e3;
+            stream_max << sep << delays.getMax() / 1e3;
         }
 
         if (clean_report) {
@@ -1147,6 +1251,11 @@ public:
                   << clean_sep << stream_rcvd.str()
                   << clean_sep << stream_drops.str()
                   << clean_sep << stream_reject.str()
+                  << clean_sep << stream_p50.str()
+                  << clean_sep << stream_p90.str()
+                  << clean_sep << stream_p99.str()
+                  << clean_sep << stream_p999.str()
+                  << clean_sep << stream_max.str()
                   << std::endl;
 
         } else {
@@ -1154,10 +1263,42 @@ public:
                   << "; received: " << stream_rcvd.str()
                   << "; drops: " << stream_drops.str()
                   << "; rejected: " << stream_reject.str()
+                  << "; p50: " << stream_p50.str()
+                  << "; p90: " << stream_p90.str()
+                  << "; p99: " << stream_p99.str()
+                  << "; p99.9: " << stream_p999.str()
+                  << "; max: " << stream_max.str() << " ms"
                   << std::endl;
         }
     }
 
+    /// \brief Start new interval of packet delays for all exchanges.
+    ///
+    /// Delays recorded in the interval are reported by
+    /// \ref printIntermediateStats and \ref printLatencyCsv.
+    void resetIntervalDelays() {
+        for (auto const& exchange : exchanges_) {
+            exchange.second->resetIntervalDelays();
+        }
+    }
+
+    /// \brief Print header of the CSV file with packet delays.
+    ///
+    /// \param out stream the header is written to.
+    static void printLatencyCsvHeader(std::ostream& out);
+
+    /// \brief Print packet delays in the current interval in CSV format.
+    ///
+    /// Method prints one line for each exchange type holding the time
+    /// elapsed since the start of the test in seconds, the exchange
+    /// type, the number of received responses in the interval and
+    /// the minimum, the 50th, 90th, 99th and 99.9th percentiles and the
+    /// maximum of the packet delays in milliseconds. It is used to
+    /// correlate latency spikes with events on the server.
+    ///
+    /// \param out stream the lines are written to.
+    void printLatencyCsv(std::ostream& out) const;
+
     /// \brief Print timestamps of all packets.
     ///
     /// Method prints timestamps of all sent and received
@@ -1189,6 +1330,16 @@ public:
     /// \brief Delegate to all exchanges to print their leases.
     void printLeases() const;
 
+    /// \brief Merge statistics gathered by another manager.
+    ///
+    /// Method merges statistics of all exchange types and values of all
+    /// custom counters gathered by another manager into this manager.
+    /// Exchange types and custom counters which are not tracked by this
+    /// manager are added.
+    ///
+    /// \param other statistics manager to be merged.
+    void merge(const StatsMgr& other);
+
     /// \brief Print names and values of custom counters.
     ///
     /// Method prints names and values of custom counters. Custom counters
@@ -224,17 +224,19 @@ TestControl::createMessageFromAck(const uint16_t msg_type,
 Pkt6Ptr
 TestControl::createMessageFromReply(const uint16_t msg_type,
                                     const dhcp::Pkt6Ptr& reply) {
-    // Restrict messages to Release and Renew.
-    if (msg_type != DHCPV6_RENEW && msg_type != DHCPV6_RELEASE) {
+    // Restrict messages to Release, Renew and Rebind.
+    if (msg_type != DHCPV6_RENEW && msg_type != DHCPV6_REBIND &&
+        msg_type != DHCPV6_RELEASE) {
         isc_throw(isc::BadValue, "invalid message type " << msg_type
-                  << " to be created from Reply, expected DHCPV6_RENEW or"
-                  " DHCPV6_RELEASE");
+                  << " to be created from Reply, expected DHCPV6_RENEW,"
+                  " DHCPV6_REBIND or DHCPV6_RELEASE");
     }
 
     // Get the string representation of the message - to be used for error
     // logging purposes.
     auto msg_type_str = [=]() -> const char* {
-        return (msg_type == DHCPV6_RENEW ? "Renew" : "Release");
+        return (msg_type == DHCPV6_RENEW ? "Renew" :
+                (msg_type == DHCPV6_REBIND ? "Rebind" : "Release"));
     };
 
     // Reply message must be specified.
@@ -253,14 +255,16 @@ TestControl::createMessageFromReply(const uint16_t msg_type,
                   " in the Reply message");
     }
     msg->addOption(opt_clientid);
-    // Server id.
-    OptionPtr opt_serverid = reply->getOption(D6O_SERVERID);
-    if (!opt_serverid) {
-        isc_throw(isc::Unexpected, "failed to create " << msg_type_str()
-                  << " because server id option has not been found in the"
-                  " Reply message");
+    // Server id. Rebind is sent to any server (RFC 8415, section 18.2.5).
+    if (msg_type != DHCPV6_REBIND) {
+        OptionPtr opt_serverid = reply->getOption(D6O_SERVERID);
+        if (!opt_serverid) {
+            isc_throw(isc::Unexpected, "failed to create " << msg_type_str()
+                      << " because server id option has not been found in the"
+                      " Reply message");
+        }
+        msg->addOption(opt_serverid);
     }
-    msg->addOption(opt_serverid);
     copyIaOptions(reply, msg);
     return (msg);
 }
@@ -733,6 +737,12 @@ TestControl::printIntermediateStats() {
     if (time_since_report.length().total_seconds() >= delay) {
         stats_mgr_.printIntermediateStats(options_.getCleanReport(),
                                           options_.getCleanReportSeparator());
+        if (latency_csv_.is_open()) {
+            stats_mgr_.printLatencyCsv(latency_csv_);
+            latency_csv_.flush();
+        }
+        // The next report shows delays of the next interval.
+        stats_mgr_.resetIntervalDelays();
         last_report_ = now;
     }
 }
@@ -836,8 +846,11 @@ TestControl::processReceivedPacket4(const Pkt4Ptr& pkt4) {
             // So, we may need to keep this DHCPACK in the storage if renews.
             // Note that, DHCPACK messages hold the information about
             // leases assigned. We use this information to renew.
-            if (stats_mgr_.hasExchangeStats(ExchangeType::RNA) ||
-                stats_mgr_.hasExchangeStats(ExchangeType::RLA)) {
+            if (response_handler_) {
+                // The scenario tracks the leases itself.
+                response_handler_(ExchangeType::RA, pkt4);
+            } else if (stats_mgr_.hasExchangeStats(ExchangeType::RNA) ||
+                       stats_mgr_.hasExchangeStats(ExchangeType::RLA)) {
                 // Renew or release messages are sent, because StatsMgr has the
                 // specific exchange type specified. Let's append the DHCPACK
                 // message to a storage.
@@ -849,7 +862,10 @@ TestControl::processReceivedPacket4(const Pkt4Ptr& pkt4) {
         // for renew specified, and if it has, if there is a corresponding
         // renew message for the received DHCPACK.
         } else if (stats_mgr_.hasExchangeStats(ExchangeType::RNA)) {
-            stats_mgr_.passRcvdPacket(ExchangeType::RNA, pkt4);
+            if (stats_mgr_.passRcvdPacket(ExchangeType::RNA, pkt4) &&
+                response_handler_) {
+                response_handler_(ExchangeType::RNA, pkt4);
+            }
         }
     }
 }
@@ -977,8 +993,11 @@ TestControl::processReceivedPacket6(const Pkt6Ptr& pkt6) {
                 // if address is correct - check uniqueness
                 address6Uniqueness(pkt6, ExchangeType::RR);
                 // check if there is correct IA to continue with Renew/Release
-                if (stats_mgr_.hasExchangeStats(ExchangeType::RN) ||
-                    stats_mgr_.hasExchangeStats(ExchangeType::RL)) {
+                if (response_handler_) {
+                    // The scenario tracks the leases itself.
+                    response_handler_(ExchangeType::RR, pkt6);
+                } else if (stats_mgr_.hasExchangeStats(ExchangeType::RN) ||
+                           stats_mgr_.hasExchangeStats(ExchangeType::RL)) {
                     // Renew or Release messages are sent, because StatsMgr has the
                     // specific exchange type specified. Let's append the Reply
                     // message to a storage.
@@ -988,18 +1007,22 @@ TestControl::processReceivedPacket6(const Pkt6Ptr& pkt6) {
                 stats_mgr_.updateRejLeases(ExchangeType::RR);
             }
         // The Reply message is not a server's response to the Request message
-        // sent within the 4-way exchange. It may be a response to the Renew
-        // or Release message. In the if clause we first check if StatsMgr
+        // sent within the 4-way exchange. It may be a response to the Renew,
+        // Rebind or Release message. In the if clauses we check if StatsMgr
         // has exchange type for Renew specified, and if it has, if there is
         // a corresponding Renew message for the received Reply. If not,
-        // we check that StatsMgr has exchange type for Release specified,
-        // as possibly the Reply has been sent in response to Release.
-        } else if (!(stats_mgr_.hasExchangeStats(ExchangeType::RN) &&
-                     stats_mgr_.passRcvdPacket(ExchangeType::RN, pkt6)) &&
-                   stats_mgr_.hasExchangeStats(ExchangeType::RL)) {
-            // At this point, it is only possible that the Reply has been sent
-            // in response to a Release. Try to match the Reply with Release.
-            stats_mgr_.passRcvdPacket(ExchangeType::RL, pkt6);
+        // we do the same for Rebind and then for Release.
+        } else {
+            for (auto xchg_type : { ExchangeType::RN, ExchangeType::RB,
+                                    ExchangeType::RL }) {
+                if (stats_mgr_.hasExchangeStats(xchg_type) &&
+                    stats_mgr_.passRcvdPacket(xchg_type, pkt6)) {
+                    if (response_handler_) {
+                        response_handler_(xchg_type, pkt6);
+                    }
+                    break;
+                }
+            }
         }
     }
 }
@@ -1094,6 +1117,26 @@ TestControl::registerOptionFactories() const {
     }
 }
 
+uint32_t
+TestControl::getTransidBlockSize(const CommandOptions& options) {
+    uint32_t transid_range = options.getIpVersion() == 6 ?
+        0x00FFFFFF : 0xFFFFFFFF;
+    return (transid_range / options.getWorkers());
+}
+
+uint32_t
+TestControl::getWorkerByTransid(const CommandOptions& options,
+                                const uint32_t transid) {
+    uint32_t worker = transid / getTransidBlockSize(options);
+    if (worker >= options.getWorkers()) {
+        // The transaction id above the blocks of all workers was not
+        // sent by perfdhcp. Give it to the last worker which will
+        // count it as an orphan.
+        worker = options.getWorkers() - 1;
+    }
+    return (worker);
+}
+
 void
 TestControl::reset() {
     transid_gen_.reset();
@@ -1127,16 +1170,44 @@ TestControl::TestControl(CommandOptions& options, BasePerfSocket &socket) :
     } else if (options_.getIpVersion() == 4) {
         // Turn off packet queueing.
         IfaceMgr::instance().configureDHCPPacketQueue(AF_INET, data::ElementPtr());
-        setTransidGenerator(NumberGeneratorPtr(new SequentialGenerator()));
     } else {
         // Turn off packet queueing.
         IfaceMgr::instance().configureDHCPPacketQueue(AF_INET6, data::ElementPtr());
-        setTransidGenerator(NumberGeneratorPtr(new SequentialGenerator(0x00FFFFFF)));
     }
 
+    // When the load is generated by multiple workers, each worker
+    // uses its own block of transaction ids, so as the responses can be
+    // steered to the worker which sent the request. Each worker
+    // also simulates its own clients.
+    uint32_t workers = options_.getWorkers();
+    uint32_t worker_index = options_.getWorkerIndex();
+    uint32_t transid_block = getTransidBlockSize(options_);
+    uint32_t transid_first = transid_block * worker_index;
+    setTransidGenerator(NumberGeneratorPtr(new SequentialGenerator(transid_first +
+                                                                   transid_block,
+                                                                   transid_first)));
+
     uint32_t clients_num = options_.getClientsNum() == 0 ?
         1 : options_.getClientsNum();
-    setMacAddrGenerator(NumberGeneratorPtr(new SequentialGenerator(clients_num)));
+    if (clients_num < 2) {
+        // All workers simulate the same client.
+        worker_index = 0;
+        workers = 1;
+    }
+    setMacAddrGenerator(NumberGeneratorPtr(new SequentialGenerator(clients_num,
+                                                                   worker_index,
+                                                                   workers)));
+
+    // Open the file packet delays are written to.
+    if (!options_.getLatencyCsv().empty()) {
+        latency_csv_.open(options_.getLatencyCsv().c_str(),
+                          std::ios::out | std::ios::trunc);
+        if (!latency_csv_.is_open()) {
+            isc_throw(BadValue, "unable to open the latency CSV file: "
+                      << options_.getLatencyCsv());
+        }
+        StatsMgr::printLatencyCsvHeader(latency_csv_);
+    }
 
     // Diagnostics are command line options mainly.
     printDiagnostics();
@@ -1314,6 +1385,13 @@ TestControl::sendMessageFromAck(const uint16_t msg_type) {
         return (false);
     }
 
+    sendMessageFromAck(msg_type, ack);
+    return (true);
+}
+
+void
+TestControl::sendMessageFromAck(const uint16_t msg_type,
+                                const dhcp::Pkt4Ptr& ack) {
     // Create message of the specified type.
     Pkt4Ptr msg = createMessageFromAck(msg_type, ack);
     setDefaults4(msg);
@@ -1333,7 +1411,6 @@ TestControl::sendMessageFromAck(const uint16_t msg_type) {
     stats_mgr_.passSentPacket((msg_type == DHCPREQUEST ? ExchangeType::RNA :
                                                          ExchangeType::RLA),
                               msg);
-    return (true);
 }
 
 
@@ -1350,6 +1427,14 @@ TestControl::sendMessageFromReply(const uint16_t msg_type) {
     if (!reply) {
         return (false);
     }
+
+    sendMessageFromReply(msg_type, reply);
+    return (true);
+}
+
+void
+TestControl::sendMessageFromReply(const uint16_t msg_type,
+                                  const dhcp::Pkt6Ptr& reply) {
     // Prepare the message of the specified type.
     Pkt6Ptr msg = createMessageFromReply(msg_type, reply);
     setDefaults6(msg);
@@ -1363,9 +1448,13 @@ TestControl::sendMessageFromReply(const uint16_t msg_type) {
     // And send it.
     socket_.send(msg);
     address6Uniqueness(msg, ExchangeType::RL);
-    stats_mgr_.passSentPacket((msg_type == DHCPV6_RENEW ? ExchangeType::RN
-                                : ExchangeType::RL), msg);
-    return (true);
+    ExchangeType xchg_type = ExchangeType::RL;
+    if (msg_type == DHCPV6_RENEW) {
+        xchg_type = ExchangeType::RN;
+    } else if (msg_type == DHCPV6_REBIND) {
+        xchg_type = ExchangeType::RB;
+    }
+    stats_mgr_.passSentPacket(xchg_type, msg);
 }
 
 void
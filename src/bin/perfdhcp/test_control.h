@@ -25,6 +25,8 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 
+#include <fstream>
+#include <functional>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -155,19 +157,39 @@ public:
     typedef boost::shared_ptr<NumberGenerator> NumberGeneratorPtr;
 
     /// \brief Sequential numbers generator class.
+    ///
+    /// By default the generator returns all numbers of the range. The
+    /// first number and the step can be changed so as the workers
+    /// generating the load use disjoint sets of numbers, e.g. each worker
+    /// uses MAC addresses starting at its index with the step equal to
+    /// the number of workers.
     class SequentialGenerator : public NumberGenerator {
     public:
         /// \brief Constructor.
         ///
         /// \param range maximum number generated. If 0 is given then
         /// range defaults to maximum uint32_t value.
-        SequentialGenerator(uint32_t range = 0xFFFFFFFF) :
+        /// \param first first number generated.
+        /// \param step difference between subsequent numbers. If 0 is
+        /// given then step defaults to 1.
+        SequentialGenerator(uint32_t range = 0xFFFFFFFF,
+                            uint32_t first = 0,
+                            uint32_t step = 1) :
             NumberGenerator(),
-            num_(0),
+            num_(first),
+            first_(first),
+            step_(step),
             range_(range) {
             if (range_ == 0) {
                 range_ = 0xFFFFFFFF;
             }
+            if (step_ == 0) {
+                step_ = 1;
+            }
+            if (first_ >= range_) {
+                isc_throw(isc::BadValue, "first generated number " << first_
+                          << " is out of range " << range_);
+            }
         }
 
         /// \brief Generate number sequentially.
@@ -175,11 +197,14 @@ public:
         /// \return generated number.
         virtual uint32_t generate() {
             uint32_t num = num_;
-            num_ = (num_ + 1) % range_;
+            uint64_t next = static_cast<uint64_t>(num_) + step_;
+            num_ = (next < range_ ? static_cast<uint32_t>(next) : first_);
             return (num);
         }
     private:
         uint32_t num_;   ///< Current number.
+        uint32_t first_; ///< First number generated.
+        uint32_t step_;  ///< Difference between subsequent numbers.
         uint32_t range_; ///< Number of unique numbers generated.
     };
 
@@ -189,6 +214,25 @@ public:
     /// address is longer than this (e.g. 20 bytes).
     static const uint8_t HW_ETHER_LEN = 6;
 
+    /// \brief Returns the number of transaction ids owned by each worker.
+    ///
+    /// Transaction ids are divided into equal blocks, one per worker.
+    /// When the load is generated by a single sender it owns all
+    /// transaction ids.
+    ///
+    /// \param options command options.
+    /// \return number of transaction ids in a block.
+    static uint32_t getTransidBlockSize(const CommandOptions& options);
+
+    /// \brief Returns the index of the worker owning a transaction id.
+    ///
+    /// \param options command options.
+    /// \param transid transaction id of a received packet.
+    /// \return index of the worker which sent the packet with this
+    /// transaction id.
+    static uint32_t getWorkerByTransid(const CommandOptions& options,
+                                       const uint32_t transid);
+
     /// \brief Set new transaction id generator.
     ///
     /// \param generator generator object to be used.
@@ -287,6 +331,44 @@ public:
     uint64_t sendMultipleMessages6(const uint32_t msg_type,
                                    const uint64_t msg_num);
 
+    /// \brief Send DHCPv4 renew (DHCPREQUEST) or DHCPRELEASE for a lease.
+    ///
+    /// \param msg_type A type of the message to be sent (DHCPREQUEST or
+    /// DHCPRELEASE).
+    /// \param ack DHCPACK message holding the lease.
+    /// \throw isc::BadValue if the message can't be created.
+    void sendMessageFromAck(const uint16_t msg_type,
+                            const dhcp::Pkt4Ptr& ack);
+
+    /// \brief Send DHCPv6 Renew, Rebind or Release message for a lease.
+    ///
+    /// \param msg_type A type of the message to be sent (DHCPV6_RENEW,
+    /// DHCPV6_REBIND or DHCPV6_RELEASE).
+    /// \param reply Reply message holding the lease.
+    /// \throw isc::BadValue or isc::Unexpected if the message can't be
+    /// created.
+    void sendMessageFromReply(const uint16_t msg_type,
+                              const dhcp::Pkt6Ptr& reply);
+
+    /// \brief Handler of the responses confirming leases.
+    ///
+    /// It is called with the exchange type and the received DHCPACK
+    /// or Reply message when the response matches a sent DHCPREQUEST
+    /// (RA, RNA) or Request, Renew, Rebind or Release (RR, RN, RB, RL).
+    typedef std::function<void(const ExchangeType,
+                               const dhcp::PktPtr&)> ResponseHandler;
+
+    /// \brief Set the handler of the responses confirming leases.
+    ///
+    /// It is used by the scenarios which track the state of the leases
+    /// of the simulated clients. When the handler is set, the responses
+    /// are not cached to send renews and releases at random.
+    ///
+    /// \param handler handler to be called.
+    void setResponseHandler(const ResponseHandler& handler) {
+        response_handler_ = handler;
+    }
+
     /// \brief Pull packets from receiver and process them.
     ///
     /// It runs in a loop until there are no packets in receiver.
@@ -295,7 +377,9 @@ public:
     /// \brief Print intermediate statistics.
     ///
     /// Print brief statistics regarding number of sent packets,
-    /// received packets and dropped packets so far.
+    /// received packets and dropped packets so far and percentiles
+    /// of packet delays since the previous report. The delays are
+    /// also appended to the CSV file specified with --latency-csv.
     void printIntermediateStats();
 
     /// \brief Print performance statistics.
@@ -361,17 +445,17 @@ protected:
 
     /// \brief Creates DHCPv6 message from the Reply packet.
     ///
-    /// This function creates DHCPv6 Renew or Release message using the
-    /// data from the Reply message by copying options from the Reply
-    /// message.
+    /// This function creates DHCPv6 Renew, Rebind or Release message
+    /// using the data from the Reply message by copying options from the
+    /// Reply message. The Rebind message doesn't include the server id.
     ///
     /// \param msg_type A type of the message to be created.
     /// \param reply An instance of the Reply packet which contents should
     /// be used to create an instance of the new message.
     ///
-    /// \return created Release or Renew message
-    /// \throw isc::BadValue if the msg_type is neither DHCPV6_RENEW nor
-    /// DHCPV6_RELEASE or if the reply is NULL.
+    /// \return created Release, Renew or Rebind message
+    /// \throw isc::BadValue if the msg_type is neither DHCPV6_RENEW,
+    /// DHCPV6_REBIND nor DHCPV6_RELEASE or if the reply is NULL.
     /// \throw isc::Unexpected if mandatory options are missing in the
     /// Reply message.
     dhcp::Pkt6Ptr createMessageFromReply(const uint16_t msg_type,
@@ -1072,6 +1156,10 @@ protected:
     /// \brief Last intermediate report time.
     boost::posix_time::ptime last_report_;
 
+    /// \brief CSV file packet delays are written to at each
+    /// intermediate report.
+    std::ofstream latency_csv_;
+
     /// \brief Statistics Manager.
     StatsMgr stats_mgr_;
 
@@ -1081,6 +1169,9 @@ protected:
     /// \brief Storage for reply messages.
     PacketStorage<dhcp::Pkt6> reply_storage_;
 
+    /// \brief Handler of the responses confirming leases.
+    ResponseHandler response_handler_;
+
     /// \brief Transaction id generator.
     NumberGeneratorPtr transid_gen_;
 
@@ -898,3 +898,140 @@ TEST_F(CommandOptionsTest, ElapsedTime) {
     EXPECT_EQ(3, opt.getIncreaseElapsedTime());
     EXPECT_EQ(10, opt.getWaitForElapsedTime());
 }
+
+TEST_F(CommandOptionsTest, Workers) {
+    CommandOptions opt;
+    EXPECT_NO_THROW(process(opt, "perfdhcp -l ethx all"));
+    EXPECT_EQ(1, opt.getWorkers());
+    EXPECT_EQ(0, opt.getWorkerIndex());
+
+    EXPECT_NO_THROW(process(opt, "perfdhcp --workers 4 -r 100 -R 1000 -l ethx all"));
+    EXPECT_EQ(4, opt.getWorkers());
+    EXPECT_EQ(0, opt.getWorkerIndex());
+
+    // Negative test cases
+    // Number of workers must be a positive integer.
+    EXPECT_THROW(process(opt, "perfdhcp --workers 0 -l ethx all"),
+                 isc::InvalidParameter);
+    EXPECT_THROW(process(opt, "perfdhcp --workers -2 -l ethx all"),
+                 isc::InvalidParameter);
+    EXPECT_THROW(process(opt, "perfdhcp --workers 2000 -l ethx all"),
+                 isc::InvalidParameter);
+    // Multiple workers are supported only in the basic scenario.
+    EXPECT_THROW(process(opt, "perfdhcp --workers 2 -R 10 --scenario avalanche"
+                         " -l ethx all"), isc::InvalidParameter);
+    // Each worker must send at least one exchange per second.
+    EXPECT_THROW(process(opt, "perfdhcp --workers 4 -r 3 -l ethx all"),
+                 isc::InvalidParameter);
+    // Each worker must simulate at least one client.
+    EXPECT_THROW(process(opt, "perfdhcp --workers 4 -R 3 -l ethx all"),
+                 isc::InvalidParameter);
+}
+
+TEST_F(CommandOptionsTest, LatencyCsv) {
+    CommandOptions opt;
+    EXPECT_NO_THROW(process(opt, "perfdhcp -l ethx all"));
+    EXPECT_TRUE(opt.getLatencyCsv().empty());
+
+    EXPECT_NO_THROW(process(opt, "perfdhcp -t 1 --latency-csv delays.csv"
+                            " -l ethx all"));
+    EXPECT_EQ("delays.csv", opt.getLatencyCsv());
+
+    // Negative test cases
+    // Delays are written at periodic reports.
+    EXPECT_THROW(process(opt, "perfdhcp --latency-csv delays.csv -l ethx all"),
+                 isc::InvalidParameter);
+    // Periodic reports are not printed with multiple workers.
+    EXPECT_THROW(process(opt, "perfdhcp -t 1 --latency-csv delays.csv"
+                         " --workers 2 -l ethx all"), isc::InvalidParameter);
+}
+
+TEST_F(CommandOptionsTest, Lifecycle) {
+    CommandOptions opt;
+    EXPECT_NO_THROW(process(opt, "perfdhcp -l ethx all"));
+    EXPECT_FALSE(opt.isReleaseOnExit());
+
+    EXPECT_NO_THROW(process(opt, "perfdhcp --scenario lifecycle -R 100"
+                            " -r 10 -F 5 -p 60 --release-on-exit -l ethx all"));
+    EXPECT_EQ(Scenario::LIFECYCLE, opt.getScenario());
+    EXPECT_EQ(100, opt.getClientsNum());
+    EXPECT_EQ(5, opt.getReleaseRate());
+    EXPECT_TRUE(opt.isReleaseOnExit());
+
+    // Negative test cases
+    // The population size must be given.
+    EXPECT_THROW(process(opt, "perfdhcp --scenario lifecycle -l ethx all"),
+                 isc::InvalidParameter);
+    // Renewals are driven by the lease times.
+    EXPECT_THROW(process(opt, "perfdhcp --scenario lifecycle -R 100 -r 10"
+                         " -f 5 -l ethx all"), isc::InvalidParameter);
+    // Leases are obtained with DORA/SARR.
+    EXPECT_THROW(process(opt, "perfdhcp --scenario lifecycle -R 100 -i"
+                         " -l ethx all"), isc::InvalidParameter);
+    // Release on exit is specific to the lifecycle scenario.
+    EXPECT_THROW(process(opt, "perfdhcp --release-on-exit -l ethx all"),
+                 isc::InvalidParameter);
+    // Multiple workers are not supported.
+    EXPECT_THROW(process(opt, "perfdhcp --scenario lifecycle -R 100"
+                         " --workers 2 -l ethx all"), isc::InvalidParameter);
+}
+
+TEST_F(CommandOptionsTest, WorkerShare) {
+    CommandOptions opt;
+    EXPECT_NO_THROW(process(opt, "perfdhcp --workers 3 -r 100 -f 20 -F 10"
+                            " -n 10 -n 5 -P 7 -t 2 -w foo -x aeT -g multi"
+                            " -l ethx all"));
+
+    int rate = 0;
+    int renew_rate = 0;
+    int release_rate = 0;
+    int num_request1 = 0;
+    int num_request2 = 0;
+    int preload = 0;
+    for (uint32_t index = 0; index < 3; ++index) {
+        CommandOptions worker_opt(opt);
+        ASSERT_NO_THROW(worker_opt.setWorkerShare(index));
+        EXPECT_EQ(index, worker_opt.getWorkerIndex());
+        EXPECT_EQ(3, worker_opt.getWorkers());
+        rate += worker_opt.getRate();
+        renew_rate += worker_opt.getRenewRate();
+        release_rate += worker_opt.getReleaseRate();
+        ASSERT_EQ(2, worker_opt.getNumRequests().size());
+        num_request1 += worker_opt.getNumRequests()[0];
+        num_request2 += worker_opt.getNumRequests()[1];
+        preload += worker_opt.getPreload();
+        // Reporting and the wrapped command are handled once.
+        EXPECT_EQ(0, worker_opt.getReportDelay());
+        EXPECT_TRUE(worker_opt.getWrapped().empty());
+        EXPECT_FALSE(worker_opt.testDiags('a'));
+        EXPECT_TRUE(worker_opt.testDiags('e'));
+        EXPECT_TRUE(worker_opt.testDiags('T'));
+        // Packets are received in the worker's own loop.
+        EXPECT_TRUE(worker_opt.isSingleThreaded());
+    }
+    // The sums over all workers should be equal to the original values.
+    EXPECT_EQ(100, rate);
+    EXPECT_EQ(20, renew_rate);
+    EXPECT_EQ(10, release_rate);
+    EXPECT_EQ(10, num_request1);
+    EXPECT_EQ(5, num_request2);
+    EXPECT_EQ(7, preload);
+
+    // The remainder goes to the first workers.
+    CommandOptions first_opt(opt);
+    first_opt.setWorkerShare(0);
+    EXPECT_EQ(34, first_opt.getRate());
+    EXPECT_EQ(4, first_opt.getNumRequests()[0]);
+    CommandOptions last_opt(opt);
+    last_opt.setWorkerShare(2);
+    EXPECT_EQ(33, last_opt.getRate());
+    EXPECT_EQ(3, last_opt.getNumRequests()[0]);
+
+    // The original options are not modified.
+    EXPECT_EQ(100, opt.getRate());
+    EXPECT_EQ(2, opt.getReportDelay());
+
+    // The index must be lower than the number of workers.
+    CommandOptions bad_opt(opt);
+    EXPECT_THROW(bad_opt.setWorkerShare(3), isc::OutOfRange);
+}
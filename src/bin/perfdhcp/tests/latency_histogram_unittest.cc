@@ -0,0 +1,122 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <exceptions/exceptions.h>
+#include "latency_histogram.h"
+#include <gtest/gtest.h>
+
+
+using namespace isc;
+using namespace isc::perfdhcp;
+
+namespace {
+
+// Test that buckets cover all values without gaps and that their
+// width is below 1% of the values.
+TEST(LatencyHistogram, buckets) {
+    // Small values are exact.
+    for (uint64_t value = 0; value < LatencyHistogram::SUB_BUCKETS; ++value) {
+        EXPECT_EQ(value, LatencyHistogram::getBucketIndex(value));
+        EXPECT_EQ(value, LatencyHistogram::getBucketLowest(value));
+        EXPECT_EQ(value, LatencyHistogram::getBucketHighest(value));
+    }
+
+    size_t last = LatencyHistogram::getBucketIndex(LatencyHistogram::MAX_VALUE);
+    EXPECT_EQ(LatencyHistogram::MAX_VALUE,
+              LatencyHistogram::getBucketHighest(last));
+    for (size_t index = 1; index <= last; ++index) {
+        uint64_t lowest = LatencyHistogram::getBucketLowest(index);
+        uint64_t highest = LatencyHistogram::getBucketHighest(index);
+        // The bucket follows the previous one.
+        ASSERT_EQ(LatencyHistogram::getBucketHighest(index - 1) + 1, lowest);
+        ASSERT_LE(lowest, highest);
+        ASSERT_EQ(index, LatencyHistogram::getBucketIndex(lowest));
+        ASSERT_EQ(index, LatencyHistogram::getBucketIndex(highest));
+        ASSERT_LT(static_cast<double>(highest - lowest), lowest / 100.);
+    }
+
+    // Values above the maximum go to the last bucket.
+    EXPECT_EQ(last, LatencyHistogram::getBucketIndex(LatencyHistogram::MAX_VALUE + 1));
+}
+
+// Test recording values and calculating percentiles.
+TEST(LatencyHistogram, percentiles) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(0, histogram.getCount());
+    EXPECT_EQ(0, histogram.getMin());
+    EXPECT_EQ(0, histogram.getMax());
+    EXPECT_EQ(0, histogram.getPercentile(50));
+
+    // Record 1ms to 10s.
+    for (uint64_t value = 1; value <= 10000; ++value) {
+        histogram.record(value * 1000);
+    }
+    EXPECT_EQ(10000, histogram.getCount());
+    EXPECT_EQ(1000, histogram.getMin());
+    EXPECT_EQ(10000000, histogram.getMax());
+
+    // Percentiles are accurate within 1%.
+    EXPECT_NEAR(5000000, histogram.getPercentile(50), 50000);
+    EXPECT_NEAR(9000000, histogram.getPercentile(90), 90000);
+    EXPECT_NEAR(9900000, histogram.getPercentile(99), 99000);
+    EXPECT_NEAR(9990000, histogram.getPercentile(99.9), 99900);
+    EXPECT_EQ(10000000, histogram.getPercentile(100));
+    EXPECT_NEAR(1000, histogram.getPercentile(0), 10);
+
+    EXPECT_THROW(histogram.getPercentile(-1), BadValue);
+    EXPECT_THROW(histogram.getPercentile(100.1), BadValue);
+
+    // Delays in seconds are converted to microseconds.
+    histogram.recordSeconds(20.5);
+    EXPECT_EQ(20500000, histogram.getMax());
+
+    histogram.reset();
+    EXPECT_EQ(0, histogram.getCount());
+    EXPECT_EQ(0, histogram.getMax());
+    EXPECT_EQ(0, histogram.getPercentile(99));
+}
+
+// Test that the tail of the distribution is reported.
+TEST(LatencyHistogram, tail) {
+    LatencyHistogram histogram;
+    // 990 fast responses and 10 slow ones.
+    for (int i = 0; i < 990; ++i) {
+        histogram.record(100);
+    }
+    for (int i = 0; i < 10; ++i) {
+        histogram.record(500000);
+    }
+    EXPECT_EQ(100, histogram.getPercentile(50));
+    EXPECT_EQ(100, histogram.getPercentile(99));
+    EXPECT_NEAR(500000, histogram.getPercentile(99.9), 5000);
+    EXPECT_EQ(500000, histogram.getMax());
+}
+
+// Test merging histograms.
+TEST(LatencyHistogram, merge) {
+    LatencyHistogram histogram1;
+    LatencyHistogram histogram2;
+    histogram1.record(10);
+    histogram1.record(20);
+    histogram2.record(5);
+    histogram2.record(3000);
+
+    histogram1.merge(histogram2);
+    EXPECT_EQ(4, histogram1.getCount());
+    EXPECT_EQ(5, histogram1.getMin());
+    EXPECT_EQ(3000, histogram1.getMax());
+    EXPECT_EQ(10, histogram1.getPercentile(50));
+    EXPECT_EQ(20, histogram1.getPercentile(75));
+
+    // Merging empty histogram doesn't change anything.
+    histogram1.merge(LatencyHistogram());
+    EXPECT_EQ(4, histogram1.getCount());
+    EXPECT_EQ(5, histogram1.getMin());
+}
+
+}
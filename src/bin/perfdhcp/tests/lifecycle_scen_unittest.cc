@@ -0,0 +1,298 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include "command_options_helper.h"
+#include "../lifecycle_scen.h"
+
+#include <asiolink/io_address.h>
+#include <exceptions/exceptions.h>
+#include <dhcp/dhcp4.h>
+#include <dhcp/dhcp6.h>
+#include <dhcp/pkt4.h>
+#include <dhcp/pkt6.h>
+#include <dhcp/iface_mgr.h>
+#include <dhcp/option6_ia.h>
+#include <dhcp/option6_iaaddr.h>
+
+#include <list>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace isc;
+using namespace isc::dhcp;
+using namespace isc::perfdhcp;
+
+namespace {
+
+/// \brief FakeLifecyclePerfSocket class that mocks PerfSocket.
+///
+/// It simulates a DHCP server granting leases with T1 of 1 second,
+/// T2 of 2 seconds and valid lifetime of 3 seconds.
+class FakeLifecyclePerfSocket: public BasePerfSocket {
+public:
+    /// \brief Constructor.
+    FakeLifecyclePerfSocket() :
+        iface_(boost::make_shared<Iface>("fake", 0)),
+        answer_renew_(true),
+        rebind_with_serverid_(0) {
+    }
+
+    IfacePtr iface_;  ///< Local fake interface.
+
+    /// Responses planned to be sent to perfdhcp.
+    std::list<PktPtr> planned_responses_;
+
+    /// Counters of the sent messages by message type.
+    std::map<uint8_t, int> sent_;
+
+    /// Indicates if the renewals are answered.
+    bool answer_renew_;
+
+    /// Number of DHCPv6 Rebind messages holding a server identifier.
+    int rebind_with_serverid_;
+
+    /// Mutex to protect internal state.
+    std::mutex mutex_;
+
+    /// \brief Simulate receiving DHCPv4 packet.
+    virtual dhcp::Pkt4Ptr receive4(uint32_t /*timeout_sec*/, uint32_t /*timeout_usec*/) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (planned_responses_.empty()) {
+            return (Pkt4Ptr());
+        }
+        Pkt4Ptr pkt = boost::dynamic_pointer_cast<Pkt4>(planned_responses_.front());
+        planned_responses_.pop_front();
+        pkt->updateTimestamp();
+        return (pkt);
+    }
+
+    /// \brief Simulate receiving DHCPv6 packet.
+    virtual dhcp::Pkt6Ptr receive6(uint32_t /*timeout_sec*/, uint32_t /*timeout_usec*/) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (planned_responses_.empty()) {
+            return (Pkt6Ptr());
+        }
+        Pkt6Ptr pkt = boost::dynamic_pointer_cast<Pkt6>(planned_responses_.front());
+        planned_responses_.pop_front();
+        pkt->updateTimestamp();
+        return (pkt);
+    }
+
+    /// \brief Create 32 bits DHCPv4 option.
+    static OptionPtr createUint32Option(uint16_t code, uint32_t value) {
+        OptionBuffer buf = { static_cast<uint8_t>(value >> 24),
+                             static_cast<uint8_t>(value >> 16),
+                             static_cast<uint8_t>(value >> 8),
+                             static_cast<uint8_t>(value) };
+        return (OptionPtr(new Option(Option::V4, code, buf)));
+    }
+
+    /// \brief Simulate sending DHCPv4 packet.
+    virtual bool send(const dhcp::Pkt4Ptr& pkt) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pkt->updateTimestamp();
+        ++sent_[pkt->getType()];
+        uint8_t response_type;
+        if (pkt->getType() == DHCPDISCOVER) {
+            response_type = DHCPOFFER;
+        } else if (pkt->getType() == DHCPREQUEST) {
+            // Renewals have ciaddr set.
+            if (!pkt->getCiaddr().isV4Zero() && !answer_renew_) {
+                return (true);
+            }
+            response_type = DHCPACK;
+        } else {
+            return (true);
+        }
+        Pkt4Ptr response(new Pkt4(response_type, pkt->getTransid()));
+        response->setHWAddr(pkt->getHWAddr());
+        response->setYiaddr(asiolink::IOAddress("127.0.0.1"));
+        response->addOption(Option::factory(Option::V4,
+                                            DHO_DHCP_SERVER_IDENTIFIER,
+                                            OptionBuffer(4, 1)));
+        response->addOption(createUint32Option(DHO_DHCP_LEASE_TIME, 3));
+        response->addOption(createUint32Option(DHO_DHCP_RENEWAL_TIME, 1));
+        response->addOption(createUint32Option(DHO_DHCP_REBINDING_TIME, 2));
+        planned_responses_.push_back(response);
+        return (true);
+    }
+
+    /// \brief Simulate sending DHCPv6 packet.
+    virtual bool send(const dhcp::Pkt6Ptr& pkt) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pkt->updateTimestamp();
+        ++sent_[pkt->getType()];
+        uint8_t response_type;
+        switch (pkt->getType()) {
+        case DHCPV6_SOLICIT:
+            response_type = DHCPV6_ADVERTISE;
+            break;
+        case DHCPV6_RENEW:
+            if (!answer_renew_) {
+                return (true);
+            }
+            response_type = DHCPV6_REPLY;
+            break;
+        case DHCPV6_REBIND:
+            if (pkt->getOption(D6O_SERVERID)) {
+                ++rebind_with_serverid_;
+            }
+            response_type = DHCPV6_REPLY;
+            break;
+        case DHCPV6_REQUEST:
+        case DHCPV6_RELEASE:
+            response_type = DHCPV6_REPLY;
+            break;
+        default:
+            return (true);
+        }
+        Pkt6Ptr response(new Pkt6(response_type, pkt->getTransid()));
+        if (pkt->getType() != DHCPV6_RELEASE) {
+            Option6IAPtr ia(new Option6IA(D6O_IA_NA, 1));
+            ia->setT1(1);
+            ia->setT2(2);
+            ia->addOption(OptionPtr(new Option6IAAddr(D6O_IAADDR,
+                                    asiolink::IOAddress("2001:db8::1"),
+                                    3, 3)));
+            response->addOption(ia);
+        }
+        std::vector<uint8_t> duid({0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+        response->addOption(OptionPtr(new Option(Option::V6, D6O_SERVERID,
+                                                 duid)));
+        response->addOption(pkt->getOption(D6O_CLIENTID));
+        planned_responses_.push_back(response);
+        return (true);
+    }
+
+    /// \brief Override getting interface.
+    virtual IfacePtr getIface() override { return iface_; }
+};
+
+/// \brief NakedLifecycleScen class.
+///
+/// It exposes LifecycleScen internals for UT.
+class NakedLifecycleScen: public LifecycleScen {
+public:
+    using LifecycleScen::tc_;
+    using LifecycleScen::join_rate_control_;
+    using LifecycleScen::churn_rate_control_;
+
+    NakedLifecycleScen(CommandOptions &opt, FakeLifecyclePerfSocket& socket) :
+        LifecycleScen(opt, socket) {
+    }
+
+    /// \brief Return the value of a custom counter.
+    uint64_t getCounter(const std::string& name) {
+        return (tc_.getStatsMgr().getCounter(name)->getValue());
+    }
+};
+
+/// \brief Test Fixture Class
+///
+/// This test fixture class is used to perform
+/// unit tests on perfdhcp LifecycleScen class.
+class LifecycleScenTest : public virtual ::testing::Test {
+public:
+    LifecycleScenTest() { }
+
+    /// \brief Parse command line string with CommandOptions.
+    ///
+    /// \param cmdline command line string to be parsed.
+    void processCmdLine(CommandOptions &opt, const std::string& cmdline) const {
+        CommandOptionsHelper::process(opt, cmdline);
+    }
+
+    /// \brief Fake socket the scenarios use.
+    FakeLifecyclePerfSocket socket_;
+};
+
+// This test verifies that the rates are set from the command line.
+TEST_F(LifecycleScenTest, initialSettings) {
+    CommandOptions opt;
+    processCmdLine(opt, "perfdhcp -l fake --scenario lifecycle -R 20"
+                   " -r 50 -F 10 -g single 127.0.0.1");
+    NakedLifecycleScen ls(opt, socket_);
+
+    EXPECT_EQ(50, ls.join_rate_control_.getRate());
+    EXPECT_EQ(10, ls.churn_rate_control_.getRate());
+    EXPECT_EQ(20, ls.getClientsNum(LifecycleScen::ClientState::INIT));
+    EXPECT_TRUE(ls.tc_.getStatsMgr().hasExchangeStats(ExchangeType::RNA));
+    EXPECT_TRUE(ls.tc_.getStatsMgr().hasExchangeStats(ExchangeType::RLA));
+    EXPECT_THROW(ls.getClientState(20), OutOfRange);
+}
+
+// This test verifies that DHCPv4 clients obtain leases and renew
+// them at T1.
+TEST_F(LifecycleScenTest, renew4) {
+    CommandOptions opt;
+    processCmdLine(opt, "perfdhcp -l fake --scenario lifecycle -R 10"
+                   " -p 3 -g single 127.0.0.1");
+    NakedLifecycleScen ls(opt, socket_);
+    ls.run();
+
+    StatsMgr& stats_mgr = ls.tc_.getStatsMgr();
+    // Each client joined once and got its lease.
+    EXPECT_EQ(10, ls.getCounter("joins"));
+    EXPECT_EQ(10, stats_mgr.getRcvdPacketsNum(ExchangeType::RA));
+    // The leases were renewed at least once and never expired.
+    EXPECT_GE(ls.getCounter("renewals"), 10);
+    EXPECT_GE(stats_mgr.getRcvdPacketsNum(ExchangeType::RNA), 10);
+    EXPECT_EQ(0, ls.getCounter("rebinds"));
+    EXPECT_EQ(0, ls.getCounter("expired"));
+    EXPECT_EQ(0, ls.getClientsNum(LifecycleScen::ClientState::INIT));
+    EXPECT_EQ(0, ls.getClientsNum(LifecycleScen::ClientState::SELECTING));
+}
+
+// This test verifies that DHCPv6 clients rebind at T2 when renewals
+// are not answered.
+TEST_F(LifecycleScenTest, rebind6) {
+    CommandOptions opt;
+    processCmdLine(opt, "perfdhcp -6 -l fake --scenario lifecycle -R 5"
+                   " -p 3 -g single ::1");
+    socket_.answer_renew_ = false;
+    NakedLifecycleScen ls(opt, socket_);
+    ls.run();
+
+    StatsMgr& stats_mgr = ls.tc_.getStatsMgr();
+    EXPECT_EQ(5, stats_mgr.getRcvdPacketsNum(ExchangeType::RR));
+    EXPECT_GE(ls.getCounter("renewals"), 5);
+    EXPECT_EQ(0, stats_mgr.getRcvdPacketsNum(ExchangeType::RN));
+    // The leases were rebound before they expired.
+    EXPECT_GE(ls.getCounter("rebinds"), 5);
+    EXPECT_GE(stats_mgr.getRcvdPacketsNum(ExchangeType::RB), 5);
+    EXPECT_EQ(0, ls.getCounter("expired"));
+    // Rebind is not sent to a particular server.
+    EXPECT_EQ(0, socket_.rebind_with_serverid_);
+}
+
+// This test verifies that the clients release their leases at the
+// churn rate and at exit.
+TEST_F(LifecycleScenTest, release4) {
+    CommandOptions opt;
+    processCmdLine(opt, "perfdhcp -l fake --scenario lifecycle -R 10"
+                   " -r 100 -F 10 -p 1 --release-on-exit -g single"
+                   " 127.0.0.1");
+    NakedLifecycleScen ls(opt, socket_);
+    ls.run();
+
+    StatsMgr& stats_mgr = ls.tc_.getStatsMgr();
+    // Released clients rejoined.
+    EXPECT_GT(ls.getCounter("releases"), 10);
+    EXPECT_GT(ls.getCounter("joins"), 10);
+    EXPECT_EQ(ls.getCounter("releases"),
+              stats_mgr.getSentPacketsNum(ExchangeType::RLA));
+    EXPECT_EQ(ls.getCounter("releases"), socket_.sent_[DHCPRELEASE]);
+    // No client holds a lease at the end.
+    EXPECT_EQ(0, ls.getClientsNum(LifecycleScen::ClientState::BOUND));
+    EXPECT_EQ(0, ls.getClientsNum(LifecycleScen::ClientState::RENEWING));
+}
+
+}
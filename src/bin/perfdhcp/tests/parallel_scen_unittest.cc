@@ -0,0 +1,303 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include "command_options_helper.h"
+#include "../parallel_scen.h"
+
+#include <asiolink/io_address.h>
+#include <exceptions/exceptions.h>
+#include <dhcp/dhcp4.h>
+#include <dhcp/dhcp6.h>
+#include <dhcp/pkt4.h>
+#include <dhcp/pkt6.h>
+#include <dhcp/iface_mgr.h>
+#include <dhcp/option6_iaaddr.h>
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <gtest/gtest.h>
+
+using namespace std;
+using namespace isc;
+using namespace isc::dhcp;
+using namespace isc::perfdhcp;
+
+namespace {
+
+/// \brief Socket simulating a DHCP server shared by the workers.
+///
+/// It responds to all sent packets and records the client identifiers
+/// used with each transaction id.
+class FakeParallelPerfSocket: public BasePerfSocket {
+public:
+    /// \brief Constructor.
+    FakeParallelPerfSocket() :
+        iface_(boost::make_shared<Iface>("fake", 0)),
+        sent_cnt_(0) {};
+
+    IfacePtr iface_;  ///< Local fake interface.
+
+    int sent_cnt_;  ///< Counter of sent packets.
+
+    /// List of pairs <msg_type, trans_id> containing responses
+    /// planned to send to perfdhcp.
+    std::list<std::tuple<uint8_t, uint32_t>> planned_responses_;
+
+    /// Client identifiers (MAC or DUID) of sent DISCOVER or SOLICIT
+    /// packets by transaction id.
+    std::map<uint32_t, std::vector<uint8_t>> clients_;
+
+    /// Mutex to protect internal state.
+    std::mutex mutex_;
+
+    /// \brief Take the next planned response.
+    bool nextResponse(uint8_t& msg_type, uint32_t& transid) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (planned_responses_.empty()) {
+            return (false);
+        }
+        std::tie(msg_type, transid) = planned_responses_.front();
+        planned_responses_.pop_front();
+        return (true);
+    }
+
+    /// \brief Simulate receiving DHCPv4 packet.
+    virtual Pkt4Ptr receive4(uint32_t, uint32_t timeout_usec) override {
+        uint8_t msg_type;
+        uint32_t transid;
+        if (!nextResponse(msg_type, transid)) {
+            usleep(std::min(timeout_usec, 100U));
+            return (Pkt4Ptr());
+        }
+        Pkt4Ptr pkt(new Pkt4(msg_type, transid));
+        OptionPtr opt_serverid = Option::factory(Option::V4,
+                                                 DHO_DHCP_SERVER_IDENTIFIER,
+                                                 OptionBuffer(4, 1));
+        pkt->setYiaddr(asiolink::IOAddress("127.0.0.1"));
+        pkt->addOption(opt_serverid);
+        pkt->updateTimestamp();
+        return (pkt);
+    };
+
+    /// \brief Simulate receiving DHCPv6 packet.
+    virtual Pkt6Ptr receive6(uint32_t, uint32_t timeout_usec) override {
+        uint8_t msg_type;
+        uint32_t transid;
+        if (!nextResponse(msg_type, transid)) {
+            usleep(std::min(timeout_usec, 100U));
+            return (Pkt6Ptr());
+        }
+        Pkt6Ptr pkt(new Pkt6(msg_type, transid));
+        OptionPtr opt_ia_na = Option::factory(Option::V6, D6O_IA_NA);
+        OptionPtr iaaddr(new Option6IAAddr(D6O_IAADDR,
+                         isc::asiolink::IOAddress("fe80::abcd"), 300, 500));
+        opt_ia_na->addOption(iaaddr);
+        pkt->addOption(opt_ia_na);
+        OptionPtr opt_serverid(new Option(Option::V6, D6O_SERVERID));
+        std::vector<uint8_t> duid({0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+        OptionPtr opt_clientid(Option::factory(Option::V6, D6O_CLIENTID, duid));
+        pkt->addOption(opt_serverid);
+        pkt->addOption(opt_clientid);
+        pkt->updateTimestamp();
+        return (pkt);
+    };
+
+    /// \brief Simulate sending DHCPv4 packet.
+    virtual bool send(const Pkt4Ptr& pkt) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sent_cnt_++;
+        pkt->updateTimestamp();
+        if (pkt->getType() == DHCPDISCOVER) {
+            clients_[pkt->getTransid()] = pkt->getHWAddr()->hwaddr_;
+            planned_responses_.push_back(std::make_tuple(DHCPOFFER, pkt->getTransid()));
+        } else if (pkt->getType() == DHCPREQUEST) {
+            planned_responses_.push_back(std::make_tuple(DHCPACK, pkt->getTransid()));
+        }
+        return (true);
+    };
+
+    /// \brief Simulate sending DHCPv6 packet.
+    virtual bool send(const Pkt6Ptr& pkt) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sent_cnt_++;
+        pkt->updateTimestamp();
+        if (pkt->getType() == DHCPV6_SOLICIT) {
+            clients_[pkt->getTransid()] = pkt->getOption(D6O_CLIENTID)->getData();
+            planned_responses_.push_back(std::make_tuple(DHCPV6_ADVERTISE, pkt->getTransid()));
+        } else if (pkt->getType() == DHCPV6_REQUEST) {
+            planned_responses_.push_back(std::make_tuple(DHCPV6_REPLY, pkt->getTransid()));
+        }
+        return (true);
+    };
+
+    /// \brief Override getting interface.
+    virtual IfacePtr getIface() override { return (iface_); }
+
+    /// \brief Open a socket receiving the responses for a worker.
+    virtual std::unique_ptr<BasePerfSocket> openWorkerSocket(uint32_t index) override;
+
+    /// Number of packets received by each worker from its own socket.
+    std::map<uint32_t, int> worker_received_;
+};
+
+/// \brief Socket of a worker receiving from the fake server.
+///
+/// The fake server doesn't steer the responses so a worker receives
+/// responses of the other workers too.
+class FakeWorkerReceiver: public BasePerfSocket {
+public:
+    /// \brief Constructor.
+    FakeWorkerReceiver(FakeParallelPerfSocket& server, uint32_t index) :
+        server_(server), index_(index) {};
+
+    /// \brief Receive DHCPv4 packet from the fake server.
+    virtual Pkt4Ptr receive4(uint32_t timeout_sec, uint32_t timeout_usec) override {
+        return (count(server_.receive4(timeout_sec, timeout_usec)));
+    }
+
+    /// \brief Receive DHCPv6 packet from the fake server.
+    virtual Pkt6Ptr receive6(uint32_t timeout_sec, uint32_t timeout_usec) override {
+        return (count(server_.receive6(timeout_sec, timeout_usec)));
+    }
+
+    /// \brief Send DHCPv4 packet to the fake server.
+    virtual bool send(const Pkt4Ptr& pkt) override { return (server_.send(pkt)); }
+
+    /// \brief Send DHCPv6 packet to the fake server.
+    virtual bool send(const Pkt6Ptr& pkt) override { return (server_.send(pkt)); }
+
+    /// \brief Override getting interface.
+    virtual IfacePtr getIface() override { return (server_.getIface()); }
+
+private:
+    /// \brief Count received packet.
+    template<typename PktPtrType>
+    PktPtrType count(const PktPtrType& pkt) {
+        if (pkt) {
+            std::lock_guard<std::mutex> lock(server_.mutex_);
+            ++server_.worker_received_[index_];
+        }
+        return (pkt);
+    }
+
+    FakeParallelPerfSocket& server_;  ///< Fake server.
+    uint32_t index_;  ///< Index of the worker.
+};
+
+std::unique_ptr<BasePerfSocket>
+FakeParallelPerfSocket::openWorkerSocket(uint32_t index) {
+    return (std::unique_ptr<BasePerfSocket>(new FakeWorkerReceiver(*this, index)));
+}
+
+/// \brief NakedParallelScen class.
+///
+/// It exposes ParallelScen internals for UT.
+class NakedParallelScen: public ParallelScen {
+public:
+    using ParallelScen::tc_;
+    using ParallelScen::workers_;
+
+    FakeParallelPerfSocket fake_sock_;
+
+    NakedParallelScen(CommandOptions &opt) : ParallelScen(opt, fake_sock_) {};
+};
+
+/// \brief Test Fixture Class
+///
+/// This test fixture class is used to perform
+/// unit tests on perfdhcp ParallelScen class.
+class ParallelScenTest : public virtual ::testing::Test
+{
+public:
+    ParallelScenTest() { }
+
+    /// \brief Parse command line string with CommandOptions.
+    ///
+    /// \param cmdline command line string to be parsed.
+    void processCmdLine(CommandOptions &opt, const std::string& cmdline) const {
+        CommandOptionsHelper::process(opt, cmdline);
+    }
+
+    /// \brief Check that the workers simulated disjoint sets of clients.
+    ///
+    /// \param opt command options of the test.
+    /// \param ps finished scenario.
+    void checkClients(const CommandOptions& opt, NakedParallelScen& ps) {
+        std::map<std::vector<uint8_t>, uint32_t> client_workers;
+        std::set<uint32_t> workers;
+        for (auto const& client : ps.fake_sock_.clients_) {
+            uint32_t worker = TestControl::getWorkerByTransid(opt, client.first);
+            workers.insert(worker);
+            auto it = client_workers.find(client.second);
+            if (it == client_workers.end()) {
+                client_workers[client.second] = worker;
+            } else {
+                EXPECT_EQ(it->second, worker);
+            }
+        }
+        // All workers have sent packets.
+        EXPECT_EQ(opt.getWorkers(), workers.size());
+        // All workers have received packets from their own sockets.
+        EXPECT_EQ(opt.getWorkers(), ps.fake_sock_.worker_received_.size());
+    }
+};
+
+}
+
+// This test verifies that DHCPv4 exchanges are run by multiple workers
+// and their statistics are merged.
+TEST_F(ParallelScenTest, Packet4Exchange) {
+    CommandOptions opt;
+    processCmdLine(opt, "perfdhcp -l fake --workers 4 -r 400 -R 100 -n 40 -n 40"
+                   " -W 1000000 127.0.0.1");
+    NakedParallelScen ps(opt);
+    EXPECT_EQ(0, ps.run());
+
+    ASSERT_EQ(4, ps.workers_.size());
+    // The command line restricts the number of exchanges to 40, i.e.
+    // 10 per worker.
+    for (auto const& worker : ps.workers_) {
+        EXPECT_GE(worker->scen_.getStatsMgr().getSentPacketsNum(ExchangeType::DO), 10);
+    }
+    StatsMgr& stats_mgr = ps.tc_.getStatsMgr();
+    EXPECT_GE(ps.fake_sock_.sent_cnt_, 80); // Discovery + Request
+    EXPECT_GE(stats_mgr.getSentPacketsNum(ExchangeType::DO), 40);
+    EXPECT_GE(stats_mgr.getRcvdPacketsNum(ExchangeType::DO), 40);
+    EXPECT_GE(stats_mgr.getSentPacketsNum(ExchangeType::RA), 40);
+    EXPECT_GE(stats_mgr.getRcvdPacketsNum(ExchangeType::RA), 40);
+    EXPECT_EQ(0, stats_mgr.getOrphans(ExchangeType::DO));
+    EXPECT_EQ(0, stats_mgr.getOrphans(ExchangeType::RA));
+
+    checkClients(opt, ps);
+}
+
+// This test verifies that DHCPv6 exchanges are run by multiple workers
+// and their statistics are merged.
+TEST_F(ParallelScenTest, Packet6Exchange) {
+    CommandOptions opt;
+    processCmdLine(opt, "perfdhcp -6 -l fake --workers 3 -r 300 -R 90 -n 30 -n 30"
+                   " -W 1000000 ::1");
+    NakedParallelScen ps(opt);
+    EXPECT_EQ(0, ps.run());
+
+    ASSERT_EQ(3, ps.workers_.size());
+    StatsMgr& stats_mgr = ps.tc_.getStatsMgr();
+    EXPECT_GE(ps.fake_sock_.sent_cnt_, 60); // Solicit + Request
+    EXPECT_GE(stats_mgr.getSentPacketsNum(ExchangeType::SA), 30);
+    EXPECT_GE(stats_mgr.getRcvdPacketsNum(ExchangeType::SA), 30);
+    EXPECT_GE(stats_mgr.getSentPacketsNum(ExchangeType::RR), 30);
+    EXPECT_GE(stats_mgr.getRcvdPacketsNum(ExchangeType::RR), 30);
+    EXPECT_EQ(0, stats_mgr.getOrphans(ExchangeType::SA));
+    EXPECT_EQ(0, stats_mgr.getOrphans(ExchangeType::RR));
+
+    checkClients(opt, ps);
+}
@@ -1,4 +1,4 @@
-// Copyright (C) 2019 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2019-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,27 +8,36 @@
 
 #include "command_options_helper.h"
 #include "../perf_socket.h"
+#include "../test_control.h"
 
 #include <asiolink/io_address.h>
 #include <exceptions/exceptions.h>
 #include <dhcp/dhcp4.h>
 #include <dhcp/pkt4.h>
+#include <dhcp/pkt6.h>
 #include <dhcp/iface_mgr.h>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/foreach.hpp>
 
 #include <algorithm>
+#include <list>
+#include <memory>
 #include <cstddef>
 #include <stdint.h>
 #include <string>
 #include <fstream>
+#include <vector>
 #include <gtest/gtest.h>
 
+#include <sys/socket.h>
+#include <unistd.h>
+
 using namespace std;
 using namespace boost::posix_time;
 using namespace isc;
 using namespace isc::dhcp;
+using namespace isc::util;
 using namespace isc::perfdhcp;
 
 
@@ -56,3 +65,182 @@ TEST_F(PerfSocketTest, WrongCommandOptions) {
     CommandOptionsHelper::process(opt, "perfdhcp -l 127.0.0.1 -4 ff02::1:2");
     EXPECT_THROW(PerfSocket sock(opt), isc::InvalidParameter);
 }
+
+/// \brief Socket which counts sent packets.
+class CountingPerfSocket : public BasePerfSocket {
+public:
+    CountingPerfSocket() : iface_(boost::make_shared<Iface>("fake", 7)),
+                           sent4_(0), sent6_(0) {
+        ifindex_ = 7;
+        sockfd_ = 123;
+    }
+
+    virtual Pkt4Ptr receive4(uint32_t, uint32_t) override { return (Pkt4Ptr()); }
+    virtual Pkt6Ptr receive6(uint32_t, uint32_t) override { return (Pkt6Ptr()); }
+    virtual bool send(const Pkt4Ptr&) override { ++sent4_; return (true); }
+    virtual bool send(const Pkt6Ptr&) override { ++sent6_; return (true); }
+    virtual IfacePtr getIface() override { return (iface_); }
+
+    IfacePtr iface_;
+    int sent4_;
+    int sent6_;
+};
+
+TEST_F(PerfSocketTest, WorkerSocket) {
+    CountingPerfSocket shared;
+    CountingPerfSocket receiver;
+    receiver.sockfd_ = 456;
+    std::vector<PktPtr> forwarded;
+    WorkerSocket sock(shared, receiver, [&forwarded](const PktPtr& pkt) {
+        // Odd transaction ids belong to another worker.
+        if (pkt->getTransid() % 2) {
+            forwarded.push_back(pkt);
+            return (true);
+        }
+        return (false);
+    });
+
+    // The worker socket describes its receiving socket.
+    EXPECT_EQ(7, sock.ifindex_);
+    EXPECT_EQ(456, sock.sockfd_);
+    EXPECT_EQ(shared.iface_, sock.getIface());
+
+    // Packets are sent through the shared socket.
+    EXPECT_TRUE(sock.send(Pkt4Ptr(new Pkt4(DHCPDISCOVER, 1))));
+    EXPECT_TRUE(sock.send(Pkt6Ptr(new Pkt6(DHCPV6_SOLICIT, 2))));
+    EXPECT_EQ(1, shared.sent4_);
+    EXPECT_EQ(1, shared.sent6_);
+    EXPECT_EQ(0, receiver.sent4_);
+    EXPECT_EQ(0, receiver.sent6_);
+
+    // Nothing was received yet.
+    EXPECT_FALSE(sock.receive4(0, 0));
+    EXPECT_FALSE(sock.receive6(0, 1000));
+
+    // Packets forwarded by other workers are received in order.
+    sock.push(Pkt4Ptr(new Pkt4(DHCPOFFER, 2)));
+    sock.push(Pkt4Ptr(new Pkt4(DHCPACK, 4)));
+    Pkt4Ptr pkt4 = sock.receive4(0, 0);
+    ASSERT_TRUE(pkt4);
+    EXPECT_EQ(2, pkt4->getTransid());
+    pkt4 = sock.receive4(0, 0);
+    ASSERT_TRUE(pkt4);
+    EXPECT_EQ(4, pkt4->getTransid());
+    EXPECT_FALSE(sock.receive4(0, 0));
+    EXPECT_TRUE(forwarded.empty());
+}
+
+/// \brief Socket which receives the given packets.
+class QueuedPerfSocket : public CountingPerfSocket {
+public:
+    virtual Pkt4Ptr receive4(uint32_t, uint32_t) override {
+        return (boost::dynamic_pointer_cast<Pkt4>(next()));
+    }
+    virtual Pkt6Ptr receive6(uint32_t, uint32_t) override {
+        return (boost::dynamic_pointer_cast<Pkt6>(next()));
+    }
+
+    PktPtr next() {
+        if (pkts_.empty()) {
+            return (PktPtr());
+        }
+        PktPtr pkt = pkts_.front();
+        pkts_.pop_front();
+        return (pkt);
+    }
+
+    std::list<PktPtr> pkts_;
+};
+
+TEST_F(PerfSocketTest, WorkerSocketForward) {
+    CountingPerfSocket shared;
+    QueuedPerfSocket receiver;
+    std::vector<PktPtr> forwarded;
+    WorkerSocket sock(shared, receiver, [&forwarded](const PktPtr& pkt) {
+        // Odd transaction ids belong to another worker.
+        if (pkt->getTransid() % 2) {
+            forwarded.push_back(pkt);
+            return (true);
+        }
+        return (false);
+    });
+
+    // The packets of the worker are received from its socket, the
+    // packets of other workers are forwarded.
+    receiver.pkts_.push_back(Pkt6Ptr(new Pkt6(DHCPV6_ADVERTISE, 1)));
+    receiver.pkts_.push_back(Pkt6Ptr(new Pkt6(DHCPV6_ADVERTISE, 2)));
+    EXPECT_FALSE(sock.receive6(0, 0));
+    ASSERT_EQ(1, forwarded.size());
+    EXPECT_EQ(1, forwarded[0]->getTransid());
+    Pkt6Ptr pkt6 = sock.receive6(0, 0);
+    ASSERT_TRUE(pkt6);
+    EXPECT_EQ(2, pkt6->getTransid());
+
+    // Forwarded packets are received before the packets of the socket.
+    receiver.pkts_.push_back(Pkt6Ptr(new Pkt6(DHCPV6_REPLY, 4)));
+    sock.push(Pkt6Ptr(new Pkt6(DHCPV6_REPLY, 6)));
+    pkt6 = sock.receive6(0, 0);
+    ASSERT_TRUE(pkt6);
+    EXPECT_EQ(6, pkt6->getTransid());
+    pkt6 = sock.receive6(0, 0);
+    ASSERT_TRUE(pkt6);
+    EXPECT_EQ(4, pkt6->getTransid());
+    EXPECT_EQ(1, forwarded.size());
+}
+
+#if defined(OS_LINUX) && defined(SO_ATTACH_REUSEPORT_CBPF)
+// This test verifies that the kernel steers the received packets to the
+// sockets of the workers by the transaction id.
+TEST_F(PerfSocketTest, SteerToWorkers) {
+    IfaceMgr::instance().closeSockets();
+    CommandOptions opt;
+    CommandOptionsHelper::process(opt, "perfdhcp -l 127.0.0.1 -L 10067"
+                                  " --workers 2 127.0.0.1");
+    std::unique_ptr<PerfSocket> sock;
+    try {
+        sock.reset(new PerfSocket(opt));
+    } catch (const std::exception& ex) {
+        // No loopback interface in the test environment.
+        std::cout << "skipping test: " << ex.what() << std::endl;
+        return;
+    }
+    std::unique_ptr<BasePerfSocket> receiver0 = sock->openWorkerSocket(0);
+    std::unique_ptr<BasePerfSocket> receiver1 = sock->openWorkerSocket(1);
+    EXPECT_EQ(sock->sockfd_, receiver0->sockfd_);
+    EXPECT_NE(sock->sockfd_, receiver1->sockfd_);
+
+    // Send responses of both workers from another socket.
+    int client = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(client, 0);
+    struct sockaddr_in to;
+    memset(&to, 0, sizeof(to));
+    to.sin_family = AF_INET;
+    to.sin_port = htons(10067);
+    to.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    uint32_t block = TestControl::getTransidBlockSize(opt);
+    std::vector<uint32_t> transids = { 1, block + 1, 2, block + 2 };
+    for (auto transid : transids) {
+        Pkt4Ptr pkt(new Pkt4(DHCPOFFER, transid));
+        pkt->pack();
+        const OutputBuffer& buf = pkt->getBuffer();
+        ASSERT_EQ(buf.getLength(),
+                  sendto(client, buf.getData(), buf.getLength(), 0,
+                         reinterpret_cast<struct sockaddr*>(&to), sizeof(to)));
+    }
+    close(client);
+
+    // Each worker receives its own responses.
+    for (auto expected : { 1, 2 }) {
+        Pkt4Ptr pkt = receiver0->receive4(1, 0);
+        ASSERT_TRUE(pkt);
+        EXPECT_EQ(expected, pkt->getTransid());
+    }
+    for (auto expected : { block + 1, block + 2 }) {
+        Pkt4Ptr pkt = receiver1->receive4(1, 0);
+        ASSERT_TRUE(pkt);
+        EXPECT_EQ(expected, pkt->getTransid());
+    }
+    EXPECT_FALSE(receiver0->receive4(0, 0));
+    EXPECT_FALSE(receiver1->receive4(0, 0));
+}
+#endif
@@ -491,6 +491,60 @@ TEST_F(StatsMgrTest, Delays) {
     EXPECT_GT(stats_mgr->getStdDevDelay(ExchangeType::DO), 0);
 }
 
+TEST_F(StatsMgrTest, DelayPercentiles) {
+    CommandOptions opt;
+    boost::shared_ptr<StatsMgr> stats_mgr(new StatsMgr(opt));
+    stats_mgr->addExchangeStats(ExchangeType::DO, 5);
+
+    // No packets received so far.
+    EXPECT_EQ(0, stats_mgr->getDelayPercentile(ExchangeType::DO, 99));
+
+    // Nine exchanges with 1s delay and one with 3s delay.
+    for (unsigned int i = 0; i < 9; ++i) {
+        passDOPacketsWithDelay(stats_mgr, 1, common_transid + i);
+    }
+    passDOPacketsWithDelay(stats_mgr, 3, common_transid + 9);
+
+    EXPECT_NEAR(1, stats_mgr->getDelayPercentile(ExchangeType::DO, 50), 0.01);
+    EXPECT_NEAR(1, stats_mgr->getDelayPercentile(ExchangeType::DO, 90), 0.01);
+    EXPECT_NEAR(3, stats_mgr->getDelayPercentile(ExchangeType::DO, 99), 0.03);
+    EXPECT_NEAR(3, stats_mgr->getDelayPercentile(ExchangeType::DO, 99.9), 0.03);
+    EXPECT_THROW(stats_mgr->getDelayPercentile(ExchangeType::DO, 101),
+                 BadValue);
+    EXPECT_THROW(stats_mgr->getDelayPercentile(ExchangeType::RA, 50),
+                 BadValue);
+
+    // The interval histogram is reset while the histogram of the whole
+    // test is kept.
+    stats_mgr->resetIntervalDelays();
+    passDOPacketsWithDelay(stats_mgr, 2, common_transid + 10);
+    EXPECT_NEAR(1, stats_mgr->getDelayPercentile(ExchangeType::DO, 50), 0.01);
+
+    std::ostringstream csv;
+    StatsMgr::printLatencyCsvHeader(csv);
+    stats_mgr->printLatencyCsv(csv);
+    std::istringstream lines(csv.str());
+    std::string header;
+    std::string line;
+    ASSERT_TRUE(std::getline(lines, header));
+    EXPECT_EQ("time,exchange,responses,min,p50,p90,p99,p99.9,max", header);
+    ASSERT_TRUE(std::getline(lines, line));
+    // Only the exchange with 2s delay belongs to the interval. The delay
+    // includes the time elapsed between passing the two packets.
+    std::string prefix(",\"DISCOVER-OFFER\",1,");
+    size_t pos = line.find(prefix);
+    ASSERT_NE(std::string::npos, pos) << line;
+    std::istringstream values(line.substr(pos + prefix.size()));
+    std::string value;
+    unsigned int count = 0;
+    while (std::getline(values, value, ',')) {
+        EXPECT_NEAR(2000, std::stod(value), 1) << line;
+        ++count;
+    }
+    EXPECT_EQ(6, count) << line;
+    EXPECT_FALSE(std::getline(lines, line));
+}
+
 TEST_F(StatsMgrTest, CustomCounters) {
     CommandOptions opt;
     boost::scoped_ptr<StatsMgr> stats_mgr(new StatsMgr(opt));
@@ -531,6 +585,60 @@ TEST_F(StatsMgrTest, CustomCounters) {
 
 }
 
+TEST_F(StatsMgrTest, Merge) {
+    CommandOptions opt;
+    boost::shared_ptr<StatsMgr> stats_mgr(new StatsMgr(opt));
+    stats_mgr->addExchangeStats(ExchangeType::DO, 5);
+    stats_mgr->addCustomCounter("shortwait", "Short waits for packets");
+    stats_mgr->incrementCounter("shortwait", 3);
+
+    boost::shared_ptr<StatsMgr> other_mgr(new StatsMgr(opt));
+    other_mgr->addExchangeStats(ExchangeType::DO, 5);
+    other_mgr->addExchangeStats(ExchangeType::RA, 5);
+    other_mgr->addCustomCounter("shortwait", "Short waits for packets");
+    other_mgr->incrementCounter("shortwait", 2);
+    other_mgr->addCustomCounter("toolate", "Packets sent too late");
+    other_mgr->incrementCounter("toolate", 1);
+
+    // One exchange with 1s delay in the first manager, one with
+    // 2s delay, one unanswered request and one orphan in the other.
+    passDOPacketsWithDelay(stats_mgr, 1, common_transid);
+    passDOPacketsWithDelay(other_mgr, 2, common_transid + 1);
+    boost::shared_ptr<Pkt4> sent_packet(createPacket4(DHCPDISCOVER,
+                                                      common_transid + 2));
+    other_mgr->passSentPacket(ExchangeType::DO, sent_packet);
+    boost::shared_ptr<Pkt4> rcvd_packet(createPacket4(DHCPOFFER,
+                                                      common_transid + 3));
+    other_mgr->passRcvdPacket(ExchangeType::DO, rcvd_packet);
+
+    ASSERT_NO_THROW(stats_mgr->merge(*other_mgr));
+
+    EXPECT_EQ(3, stats_mgr->getSentPacketsNum(ExchangeType::DO));
+    EXPECT_EQ(2, stats_mgr->getRcvdPacketsNum(ExchangeType::DO));
+    EXPECT_EQ(1, stats_mgr->getDroppedPacketsNum(ExchangeType::DO));
+    EXPECT_EQ(1, stats_mgr->getOrphans(ExchangeType::DO));
+    EXPECT_GE(stats_mgr->getMinDelay(ExchangeType::DO), 1);
+    EXPECT_LT(stats_mgr->getMinDelay(ExchangeType::DO), 2);
+    EXPECT_GE(stats_mgr->getMaxDelay(ExchangeType::DO), 2);
+    EXPECT_GE(stats_mgr->getAvgDelay(ExchangeType::DO), 1.5);
+    EXPECT_GT(stats_mgr->getStdDevDelay(ExchangeType::DO), 0);
+
+    // Exchanges and counters which were not tracked are added.
+    ASSERT_TRUE(stats_mgr->hasExchangeStats(ExchangeType::RA));
+    EXPECT_EQ(0, stats_mgr->getSentPacketsNum(ExchangeType::RA));
+    EXPECT_EQ(5, stats_mgr->getCounter("shortwait")->getValue());
+    EXPECT_EQ(1, stats_mgr->getCounter("toolate")->getValue());
+    EXPECT_EQ("Packets sent too late",
+              stats_mgr->getCounter("toolate")->getName());
+
+    // Statistics of different exchange types can't be merged.
+    ExchangeStats do_stats(ExchangeType::DO, -1, false,
+                           boost::posix_time::microsec_clock::universal_time());
+    ExchangeStats ra_stats(ExchangeType::RA, -1, false,
+                           boost::posix_time::microsec_clock::universal_time());
+    EXPECT_THROW(do_stats.merge(ra_stats), BadValue);
+}
+
 TEST_F(StatsMgrTest, PrintStats) {
     std::cout << "This unit test is checking statistics printing "
               << "capabilities. It is expected that some counters "
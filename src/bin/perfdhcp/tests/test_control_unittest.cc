@@ -1272,6 +1272,59 @@ TEST_F(TestControlTest, GenerateMacAddress) {
     ASSERT_TRUE(std::find(macs.begin(), macs.end(), mac) !=  macs.end());
 }
 
+// This test verifies that the sequential generator returns the numbers
+// of the range starting at the first number with the given step.
+TEST_F(TestControlTest, SequentialGenerator) {
+    // By default all numbers of the range are generated.
+    TestControl::SequentialGenerator gen(3);
+    EXPECT_EQ(0, gen.generate());
+    EXPECT_EQ(1, gen.generate());
+    EXPECT_EQ(2, gen.generate());
+    EXPECT_EQ(0, gen.generate());
+
+    // The generator used by the second of three workers.
+    TestControl::SequentialGenerator worker_gen(10, 1, 3);
+    EXPECT_EQ(1, worker_gen.generate());
+    EXPECT_EQ(4, worker_gen.generate());
+    EXPECT_EQ(7, worker_gen.generate());
+    EXPECT_EQ(1, worker_gen.generate());
+
+    // The step must not overflow at the end of the uint32_t range.
+    TestControl::SequentialGenerator max_gen(0, 0xFFFFFFF0, 0x10);
+    EXPECT_EQ(0xFFFFFFF0, max_gen.generate());
+    EXPECT_EQ(0xFFFFFFF0, max_gen.generate());
+
+    // The first number must be in the range.
+    EXPECT_THROW(TestControl::SequentialGenerator(10, 10), isc::BadValue);
+}
+
+// This test verifies that each worker uses its own block of transaction
+// ids and that the workers are found by the transaction ids.
+TEST_F(TestControlTest, WorkerTransid) {
+    for (auto const& cmdline : { "perfdhcp -4 --workers 4 -r 100 127.0.0.1",
+                                 "perfdhcp -6 --workers 4 -r 100 ::1" }) {
+        CommandOptions opt;
+        processCmdLine(opt, cmdline);
+        std::set<uint32_t> transids;
+        for (uint32_t index = 0; index < 4; ++index) {
+            CommandOptions worker_opt(opt);
+            worker_opt.setWorkerShare(index);
+            NakedTestControl tc(worker_opt);
+            for (int i = 0; i < 10; ++i) {
+                uint32_t transid = tc.transid_gen_->generate();
+                EXPECT_EQ(index, TestControl::getWorkerByTransid(opt, transid));
+                EXPECT_TRUE(transids.insert(transid).second);
+            }
+        }
+    }
+
+    // Without workers all transaction ids belong to the only sender.
+    CommandOptions opt;
+    processCmdLine(opt, "perfdhcp -4 127.0.0.1");
+    EXPECT_EQ(0xFFFFFFFF, TestControl::getTransidBlockSize(opt));
+    EXPECT_EQ(0, TestControl::getWorkerByTransid(opt, 0xFFFFFFFF));
+}
+
 TEST_F(TestControlTest, Options4) {
     using namespace isc::dhcp;
     CommandOptions opt;
@@ -10,7 +10,11 @@
 #include <cc/command_interpreter.h>
 #include <exceptions/exceptions.h>
 #include <boost/pointer_cast.hpp>
+#include <map>
+#include <utility>
+#include <vector>
 
+using namespace isc::asiolink;
 using namespace isc::data;
 using namespace isc::dhcp;
 
@@ -136,16 +140,39 @@ CommandCreator::createLease6BulkApply(const Lease6CollectionPtr& leases,
 }
 
 ConstElementPtr
-CommandCreator::createLease6BulkApply(LeaseUpdateBacklog& leases) {
-    ElementPtr deleted_leases_list = Element::createList();
-    ElementPtr leases_list = Element::createList();
+CommandCreator::createLease6BulkApply(LeaseUpdateBacklog& leases,
+                                      const size_t limit) {
+    // The backlog may return several updates of the same lease when some
+    // of them were spilled. The lease6-bulk-apply command deletes the
+    // leases before it updates the others, so only the last update of
+    // each lease is included.
+    std::vector<std::pair<LeaseUpdateBacklog::OpType, Lease6Ptr> > updates;
+    std::map<std::pair<Lease::Type, IOAddress>, size_t> positions;
 
     LeaseUpdateBacklog::OpType op_type;
     Lease6Ptr lease;
-    while ((lease = boost::dynamic_pointer_cast<Lease6>(leases.pop(op_type)))) {
-        ElementPtr lease_as_json = lease->toElement();
+    size_t count = 0;
+    while (((limit == 0) || (count < limit)) &&
+           (lease = boost::dynamic_pointer_cast<Lease6>(leases.pop(op_type)))) {
+        ++count;
+        auto key = std::make_pair(lease->type_, lease->addr_);
+        auto position = positions.find(key);
+        if (position != positions.end()) {
+            updates[position->second].second.reset();
+        }
+        positions[key] = updates.size();
+        updates.push_back(std::make_pair(op_type, lease));
+    }
+
+    ElementPtr deleted_leases_list = Element::createList();
+    ElementPtr leases_list = Element::createList();
+    for (auto const& update : updates) {
+        if (!update.second) {
+            continue;
+        }
+        ElementPtr lease_as_json = update.second->toElement();
         insertLeaseExpireTime(lease_as_json);
-        if (op_type == LeaseUpdateBacklog::DELETE) {
+        if (update.first == LeaseUpdateBacklog::DELETE) {
             deleted_leases_list->add(lease_as_json);
         } else {
             leases_list->add(lease_as_json);
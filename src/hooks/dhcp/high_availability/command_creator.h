@@ -108,12 +108,16 @@ public:
     /// @brief Creates lease6-bulk-apply command.
     ///
     /// This command pops the leases from the backlog. As a result, the
-    /// backlog is empty after calling this function.
+    /// backlog is empty after calling this function unless the number of
+    /// the lease updates is limited. When the backlog holds more than one
+    /// update of a lease, only the last popped one is included.
     ///
     /// @param leases Reference to the collection of DHCPv6 leases backlog.
+    /// @param limit Maximum number of lease updates to pop from the backlog.
+    /// The value of 0 means that all lease updates are popped.
     /// @return Pointer to the JSON representation of the command.
     static data::ConstElementPtr
-    createLease6BulkApply(LeaseUpdateBacklog& leases);
+    createLease6BulkApply(LeaseUpdateBacklog& leases, const size_t limit = 0);
 
     /// @brief Creates lease6-update command.
     ///
@@ -14,6 +14,7 @@
 #include <ha_log.h>
 #include <asiolink/io_service.h>
 #include <cc/command_interpreter.h>
+#include <config/command_mgr.h>
 #include <dhcpsrv/cfgmgr.h>
 #include <dhcpsrv/network_state.h>
 #include <exceptions/exceptions.h>
@@ -335,6 +336,9 @@ int load(LibraryHandle& handle) {
         handle.registerCommandCallout("ha-reset", ha_reset_command);
         handle.registerCommandCallout("ha-sync-complete-notify", sync_complete_notify_command);
 
+        // The heartbeats must not be delayed by the other commands.
+        CommandMgr::instance().setThreadSafe("ha-heartbeat");
+
     } catch (const std::exception& ex) {
         LOG_ERROR(ha_logger, HA_CONFIGURATION_FAILED)
             .arg(ex.what());
@@ -349,6 +353,7 @@ int load(LibraryHandle& handle) {
 ///
 /// @return 0 if deregistration was successful, 1 otherwise
 int unload() {
+    CommandMgr::instance().clearThreadSafe("ha-heartbeat");
     impl.reset();
     LOG_INFO(ha_logger, HA_DEINIT_OK);
     return (0);
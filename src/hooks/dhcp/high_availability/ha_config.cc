@@ -11,12 +11,16 @@
 #include <asiolink/crypto_tls.h>
 #include <dhcpsrv/cfgmgr.h>
 #include <dhcpsrv/cfg_multi_threading.h>
+#include <dhcpsrv/client_class_def.h>
+#include <eval/token.h>
 #include <exceptions/exceptions.h>
 #include <util/multi_threading_mgr.h>
 #include <util/strutil.h>
 #include <ha_log.h>
 #include <ha_config.h>
 #include <ha_service_states.h>
+#include <boost/pointer_cast.hpp>
+#include <set>
 #include <sstream>
 
 using namespace isc::asiolink;
@@ -24,12 +28,49 @@ using namespace isc::http;
 using namespace isc::util;
 using namespace isc::dhcp;
 
+namespace {
+
+/// @brief Collects the servers of the HA classes a client class depends on.
+///
+/// @param dictionary client classes dictionary.
+/// @param name name of the client class.
+/// @param [out] servers names of the servers of the HA classes found.
+/// @param [out] visited names of the client classes already walked.
+void
+getClassServers(const ClientClassDictionaryPtr& dictionary,
+                const std::string& name, std::set<std::string>& servers,
+                std::set<std::string>& visited) {
+    if (name.empty() || !visited.insert(name).second) {
+        return;
+    }
+
+    if (name.compare(0, 3, "HA_") == 0) {
+        servers.insert(name.substr(3));
+        return;
+    }
+
+    ClientClassDefPtr def = dictionary->findClass(name);
+    if (!def || !def->getMatchExpr()) {
+        return;
+    }
+    for (auto token : *def->getMatchExpr()) {
+        auto member = boost::dynamic_pointer_cast<TokenMember>(token);
+        if (member) {
+            getClassServers(dictionary, member->getClientClass(), servers,
+                            visited);
+        }
+    }
+}
+
+} // end of anonymous namespace
+
 namespace isc {
 namespace ha {
 
 HAConfig::PeerConfig::PeerConfig()
     : tls_context_(), name_(), url_(""), trust_anchor_(), cert_file_(),
-      key_file_(), role_(STANDBY), auto_failover_(false), basic_auth_() {
+      key_file_(), role_(STANDBY), auto_failover_(false), partner_(),
+      replication_port_(0), basic_auth_() {
 }
 
 void
@@ -162,11 +203,13 @@ HAConfig::StateMachineConfig::getStateConfig(const int state) {
 HAConfig::HAConfig()
     : this_server_name_(), ha_mode_(HOT_STANDBY), send_lease_updates_(true),
       sync_leases_(true), sync_timeout_(60000), sync_page_limit_(10000),
-      delayed_updates_limit_(0), heartbeat_delay_(10000), max_response_delay_(60000),
+      delayed_updates_limit_(0), delayed_updates_spill_file_(),
+      delayed_updates_spill_max_size_(0),
+      heartbeat_delay_(10000), max_response_delay_(60000),
       max_ack_delay_(10000), max_unacked_clients_(10), wait_backup_ack_(false),
       enable_multi_threading_(false), http_dedicated_listener_(false),
       http_listener_threads_(0), http_client_threads_(0),
-      trust_anchor_(), cert_file_(), key_file_(),
+      binary_lease_updates_(false), trust_anchor_(), cert_file_(), key_file_(),
       peers_(), state_machine_(new StateMachineConfig()) {
 }
 
@@ -247,6 +290,11 @@ HAConfig::getPeerConfig(const std::string& name) const {
 
 HAConfig::PeerConfigPtr
 HAConfig::getFailoverPeerConfig() const {
+    std::string partner = getThisServerConfig()->getPartner();
+    if (!partner.empty()) {
+        return (getPeerConfig(partner));
+    }
+
     PeerConfigMap servers = getOtherServersConfig();
     for (auto peer = servers.begin(); peer != servers.end(); ++peer) {
         if (peer->second->getRole() != HAConfig::PeerConfig::BACKUP) {
@@ -270,6 +318,24 @@ HAConfig::getOtherServersConfig() const {
     return (copy);
 }
 
+HAConfig::PeerConfigMap
+HAConfig::getLeaseUpdatesServersConfig() const {
+    PeerConfigMap servers = getOtherServersConfig();
+    std::string partner = getThisServerConfig()->getPartner();
+    if (partner.empty()) {
+        return (servers);
+    }
+    for (auto peer = servers.begin(); peer != servers.end(); ) {
+        if ((peer->second->getRole() != PeerConfig::BACKUP) &&
+            (peer->first != partner)) {
+            peer = servers.erase(peer);
+        } else {
+            ++peer;
+        }
+    }
+    return (servers);
+}
+
 void
 HAConfig::validate() {
     // Peers configurations must be provided.
@@ -280,6 +346,7 @@ HAConfig::validate() {
 
     // Gather all the roles and see how many occurrences of each role we get.
     std::map<PeerConfig::Role, unsigned> peers_cnt;
+    unsigned partners_cnt = 0;
     for (auto p = peers_.begin(); p != peers_.end(); ++p) {
         if (!p->second->getUrl().isValid()) {
             isc_throw(HAConfigValidationError, "invalid URL: "
@@ -339,6 +406,17 @@ HAConfig::validate() {
                                       ca.get(),
                                       cert.get(),
                                       key.get());
+                // This server accepts the TLS connections of its peers
+                // sending the binary lease updates. The peers are
+                // authenticated by their client certificates.
+                if (binary_lease_updates_ && (p->first == getThisServerName())) {
+                    TlsContext::configure(p->second->replication_tls_context_,
+                                          TlsRole::SERVER,
+                                          ca.get(),
+                                          cert.get(),
+                                          key.get(),
+                                          true);
+                }
             } catch (const isc::Exception& ex) {
                 isc_throw(HAConfigValidationError, "bad TLS config for server "
                           << p->second->getName() << ": " << ex.what());
@@ -354,17 +432,44 @@ HAConfig::validate() {
             }
         }
 
+        // The lease replication channel has no other authentication than
+        // the TLS client certificates.
+        if (binary_lease_updates_ && !use_tls) {
+            isc_throw(HAConfigValidationError, "'binary-lease-updates' requires"
+                      " TLS: the trust-anchor, cert-file and key-file parameters"
+                      " must be set for the server " << p->second->getName());
+        }
+
+        // The binary lease updates are sent to the replication port.
+        if (binary_lease_updates_ && (p->second->getReplicationPort() == 0)) {
+            isc_throw(HAConfigValidationError, "'replication-port' must be specified"
+                      " for the server " << p->second->getName() << " when"
+                      " 'binary-lease-updates' is enabled");
+        }
+
         ++peers_cnt[p->second->getRole()];
+        if (!p->second->getPartner().empty()) {
+            ++partners_cnt;
+        }
     }
 
-    // Only one primary server allowed.
-    if (peers_cnt.count(PeerConfig::PRIMARY) && (peers_cnt[PeerConfig::PRIMARY] > 1)) {
-        isc_throw(HAConfigValidationError, "multiple primary servers specified");
-    }
+    // The partners are only configured in the load balancing setup with
+    // more than two active servers. The active servers are grouped in
+    // failover pairs made of a primary and a secondary server.
+    if (partners_cnt > 0) {
+        validatePartners();
+        validatePartnerPools();
+
+    } else {
+        // Only one primary server allowed.
+        if (peers_cnt.count(PeerConfig::PRIMARY) && (peers_cnt[PeerConfig::PRIMARY] > 1)) {
+            isc_throw(HAConfigValidationError, "multiple primary servers specified");
+        }
 
-    // Only one secondary server allowed.
-    if (peers_cnt.count(PeerConfig::SECONDARY) && (peers_cnt[PeerConfig::SECONDARY] > 1)) {
-        isc_throw(HAConfigValidationError, "multiple secondary servers specified");
+        // Only one secondary server allowed.
+        if (peers_cnt.count(PeerConfig::SECONDARY) && (peers_cnt[PeerConfig::SECONDARY] > 1)) {
+            isc_throw(HAConfigValidationError, "multiple secondary servers specified");
+        }
     }
 
     // Only one standby server allowed.
@@ -453,6 +558,18 @@ HAConfig::validate() {
         }
     }
 
+    // The lease updates are only spilled when the backlog is full.
+    if (!delayed_updates_spill_file_.empty() && (delayed_updates_limit_ == 0)) {
+        isc_throw(HAConfigValidationError, "'delayed-updates-spill-file' requires"
+                  " 'delayed-updates-limit' greater than 0");
+    }
+
+    // The lease replication listener is driven by its own thread pool.
+    if (binary_lease_updates_ && !enable_multi_threading_) {
+        isc_throw(HAConfigValidationError, "'binary-lease-updates' requires"
+                  " 'enable-multi-threading' to be set to true");
+    }
+
     if (enable_multi_threading_) {
         // We get it from staging because applying the DHCP multi-threading configuration
         // occurs after library loading during the (re)configuration process.
@@ -466,6 +583,7 @@ HAConfig::validate() {
             // HA+MT requires DHCP multi-threading.
             LOG_INFO(ha_logger, HA_CONFIG_DHCP_MT_DISABLED);
             enable_multi_threading_ = false;
+            binary_lease_updates_ = false;
             return;
         }
 
@@ -476,6 +594,7 @@ HAConfig::validate() {
             if (!dhcp_threads) {
                 LOG_INFO(ha_logger, HA_CONFIG_SYSTEM_MT_UNSUPPORTED);
                 enable_multi_threading_ = false;
+                binary_lease_updates_ = false;
                 return;
             }
         }
@@ -494,5 +613,113 @@ HAConfig::validate() {
     }
 }
 
+void
+HAConfig::validatePartners() const {
+    if (ha_mode_ != LOAD_BALANCING) {
+        isc_throw(HAConfigValidationError, "'partner' is only supported in the"
+                  " load balancing configuration");
+    }
+
+    for (auto p = peers_.begin(); p != peers_.end(); ++p) {
+        PeerConfigPtr peer = p->second;
+        std::string partner = peer->getPartner();
+        if (peer->getRole() == PeerConfig::BACKUP) {
+            if (!partner.empty()) {
+                isc_throw(HAConfigValidationError, "'partner' must not be specified"
+                          " for the backup server " << peer->getName());
+            }
+            continue;
+        }
+
+        if (partner.empty()) {
+            isc_throw(HAConfigValidationError, "'partner' must be specified for the"
+                      " server " << peer->getName() << " when it is specified for"
+                      " other servers");
+        }
+
+        auto partner_peer = peers_.find(partner);
+        if (partner_peer == peers_.end()) {
+            isc_throw(HAConfigValidationError, "partner " << partner << " of the"
+                      " server " << peer->getName() << " is not configured");
+        }
+
+        PeerConfig::Role expected_role = (peer->getRole() == PeerConfig::PRIMARY ?
+                                          PeerConfig::SECONDARY : PeerConfig::PRIMARY);
+        if (partner_peer->second->getRole() != expected_role) {
+            isc_throw(HAConfigValidationError, "partner " << partner << " of the"
+                      " server " << peer->getName() << " must be a "
+                      << PeerConfig::roleToString(expected_role) << " server");
+        }
+    }
+
+    // The partners must designate each other.
+    for (auto p = peers_.begin(); p != peers_.end(); ++p) {
+        PeerConfigPtr peer = p->second;
+        if (peer->getRole() == PeerConfig::BACKUP) {
+            continue;
+        }
+        std::string partner = peer->getPartner();
+        auto partner_peer = peers_.find(partner);
+        if (partner_peer->second->getPartner() != peer->getName()) {
+            isc_throw(HAConfigValidationError, "partner of the server " << partner
+                      << " must be " << peer->getName());
+        }
+    }
+}
+
+void
+HAConfig::validatePartnerPools() const {
+    // The pools are parsed before the hook libraries are loaded.
+    CfgMgr& cfg_mgr = CfgMgr::instance();
+    SrvConfigPtr cfg = cfg_mgr.getStagingCfg();
+    ClientClassDictionaryPtr dictionary = cfg->getClientClassDictionary();
+
+    auto check_pool = [&](const SubnetPtr& subnet, const PoolPtr& pool) {
+        std::set<std::string> servers;
+        std::set<std::string> visited;
+        getClassServers(dictionary, subnet->getClientClass().get(), servers,
+                        visited);
+        getClassServers(dictionary, pool->getClientClass(), servers, visited);
+
+        // A failover pair is identified by the name of its primary server.
+        std::set<std::string> pairs;
+        for (auto server : servers) {
+            auto peer = peers_.find(server);
+            if ((peer == peers_.end()) ||
+                (peer->second->getRole() == PeerConfig::BACKUP)) {
+                continue;
+            }
+            pairs.insert(peer->second->getRole() == PeerConfig::PRIMARY ?
+                         peer->first : peer->second->getPartner());
+        }
+
+        if (pairs.size() != 1) {
+            isc_throw(HAConfigValidationError, "the pool " << pool->toText()
+                      << " in the subnet " << subnet->toText() << " must be"
+                      " guarded by the HA classes of the servers of a single"
+                      " failover pair when 'partner' is specified");
+        }
+    };
+
+    if (cfg_mgr.getFamily() == AF_INET) {
+        const Subnet4Collection* subnets = cfg->getCfgSubnets4()->getAll();
+        for (auto subnet : *subnets) {
+            for (auto pool : subnet->getPools(Lease::TYPE_V4)) {
+                check_pool(subnet, pool);
+            }
+        }
+
+    } else {
+        const Subnet6Collection* subnets = cfg->getCfgSubnets6()->getAll();
+        for (auto subnet : *subnets) {
+            for (auto type : { Lease::TYPE_NA, Lease::TYPE_TA, Lease::TYPE_PD }) {
+                for (auto pool : subnet->getPools(type)) {
+                    check_pool(subnet, pool);
+                }
+            }
+        }
+    }
+}
+
 } // end of namespace isc::ha
 } // end of namespace isc
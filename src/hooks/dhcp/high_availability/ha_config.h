@@ -58,10 +58,13 @@ public:
         /// The following roles are supported:
         /// - primary - server taking part in load balancing, hot standby or
         ///   passive-backup setup, taking leadership over other servers.
-        ///   There must be exactly one primary server.
+        ///   There must be exactly one primary server, except in the load
+        ///   balancing setup with more than two active servers where there
+        ///   is one primary server per failover pair.
         /// - secondary - server taking part in the load balancing setup. It is a slave
         ///   server to primary. There must be exactly one secondary server in the
-        ///   load balancing setup.
+        ///   load balancing setup, except with more than two active servers
+        ///   where there is one secondary server per failover pair.
         /// - standby - standby server taking part in the hot standby operation. It
         ///   doesn't run DHCP function until primary server crashes. There must be
         ///   exactly one standby server in the hot standby setup.
@@ -193,6 +196,41 @@ public:
             auto_failover_ = auto_failover;
         }
 
+        /// @brief Returns the name of the failover partner of the server.
+        ///
+        /// @return The name of the partner or an empty string when the
+        /// partner is not explicitly configured.
+        std::string getPartner() const {
+            return (partner_);
+        }
+
+        /// @brief Sets the name of the failover partner of the server.
+        ///
+        /// The partner must be configured for all the active servers in
+        /// the load balancing setup with more than two active servers.
+        ///
+        /// @param partner Name of the partner.
+        void setPartner(const std::string& partner) {
+            partner_ = partner;
+        }
+
+        /// @brief Returns the port of the server's lease replication listener.
+        ///
+        /// @return The port or 0 when it is not configured.
+        uint16_t getReplicationPort() const {
+            return (replication_port_);
+        }
+
+        /// @brief Sets the port of the server's lease replication listener.
+        ///
+        /// The server listens on the address of its URL and this port for
+        /// the binary lease updates sent by its peers.
+        ///
+        /// @param replication_port The port.
+        void setReplicationPort(const uint16_t replication_port) {
+            replication_port_ = replication_port;
+        }
+
         /// @brief Returns non-const basic HTTP authentication.
         http::BasicHttpAuthPtr& getBasicAuth() {
             return (basic_auth_);
@@ -213,6 +251,12 @@ public:
         /// @ref validate a friend so it may configure it.
         asiolink::TlsContextPtr tls_context_;
 
+        /// @brief Server TLS context of the lease replication listener.
+        ///
+        /// It is only configured for this server when TLS is used and the
+        /// binary lease updates are enabled.
+        asiolink::TlsContextPtr replication_tls_context_;
+
     private:
 
         std::string name_;                          ///< Server name.
@@ -222,6 +266,8 @@ public:
         util::Optional<std::string> key_file_;      ///< Server key file.
         Role role_;                                 ///< Server role.
         bool auto_failover_;                        ///< Auto failover state.
+        std::string partner_;                       ///< Failover partner name.
+        uint16_t replication_port_;                 ///< Lease replication port.
         http::BasicHttpAuthPtr basic_auth_;         ///< Basic HTTP authentication.
     };
 
@@ -465,6 +511,48 @@ public:
         delayed_updates_limit_ = delayed_updates_limit;
     }
 
+    /// @brief Returns the name of the file holding the lease updates
+    /// which don't fit in the backlog.
+    ///
+    /// When the number of lease updates held in the communication-recovery
+    /// state reaches the limit, they are moved to this file instead of
+    /// dropping them. The server can then send them to the partner when the
+    /// communication is resumed, rather than synchronizing the entire lease
+    /// database.
+    ///
+    /// @return Name of the spill file or an empty string if not used.
+    std::string getDelayedUpdatesSpillFile() const {
+        return (delayed_updates_spill_file_);
+    }
+
+    /// @brief Sets the name of the file holding the lease updates which
+    /// don't fit in the backlog.
+    ///
+    /// @param delayed_updates_spill_file name of the spill file or an empty
+    /// string to not use it.
+    void setDelayedUpdatesSpillFile(const std::string& delayed_updates_spill_file) {
+        delayed_updates_spill_file_ = delayed_updates_spill_file;
+    }
+
+    /// @brief Returns the maximum size of the spill file in bytes.
+    ///
+    /// When the lease updates moved to the spill file would make it
+    /// larger, the backlog is overflown and the lease database is
+    /// synchronized when the communication is resumed.
+    ///
+    /// @return Maximum size of the spill file (0 for no limit).
+    uint64_t getDelayedUpdatesSpillMaxSize() const {
+        return (delayed_updates_spill_max_size_);
+    }
+
+    /// @brief Sets the maximum size of the spill file in bytes.
+    ///
+    /// @param delayed_updates_spill_max_size new maximum size (0 for no
+    /// limit).
+    void setDelayedUpdatesSpillMaxSize(const uint64_t delayed_updates_spill_max_size) {
+        delayed_updates_spill_max_size_ = delayed_updates_spill_max_size;
+    }
+
     /// @brief Convenience function checking if communication recovery is allowed.
     ///
     /// Communication recovery is only allowed in load-balancing configurations.
@@ -632,6 +720,26 @@ public:
         http_client_threads_ = http_client_threads;
     }
 
+    /// @brief Checks if the lease updates are sent over the binary lease
+    /// replication channel.
+    ///
+    /// @return true if the binary lease updates are enabled.
+    bool getBinaryLeaseUpdates() const {
+        return (binary_lease_updates_);
+    }
+
+    /// @brief Enables/disables the binary lease updates.
+    ///
+    /// When enabled, the lease updates are sent to the peers over a
+    /// persistent connection to their lease replication listeners rather
+    /// than as control commands over HTTP. It requires multi-threading.
+    ///
+    /// @param binary_lease_updates flag that enables the binary lease
+    /// updates when true.
+    void setBinaryLeaseUpdates(bool binary_lease_updates) {
+        binary_lease_updates_ = binary_lease_updates;
+    }
+
     /// @brief Returns global trust-anchor.
     util::Optional<std::string> getTrustAnchor() const {
         return (trust_anchor_);
@@ -682,7 +790,9 @@ public:
     /// The server for which the configuration is returned is a "primary",
     /// "secondary" or "standby". This method is typically used to locate
     /// the configuration of the server to which heartbeat command is to
-    /// be sent.
+    /// be sent. When the partner of this server is explicitly configured,
+    /// i.e. in the load balancing setup with more than two active servers,
+    /// its configuration is returned.
     ///
     /// @return Pointer to the partner's configuration.
     /// @throw InvalidOperation if there is no suitable configuration found.
@@ -701,6 +811,19 @@ public:
     /// @return Map of pointers to the servers' configurations.
     PeerConfigMap getOtherServersConfig() const;
 
+    /// @brief Returns configuration of the servers receiving lease updates.
+    ///
+    /// Returns a map of pointers to the configuration of the failover
+    /// partner and of the backup servers. In the load balancing setup
+    /// with more than two active servers, the other active servers are
+    /// not included: they never serve the clients of this server nor of
+    /// its partner, and the pools of each failover pair are disjoint (see
+    /// @c validatePartnerPools), so they never allocate the leases of
+    /// this pair.
+    ///
+    /// @return Map of pointers to the servers' configurations.
+    PeerConfigMap getLeaseUpdatesServersConfig() const;
+
     /// @brief Returns configurations of all servers.
     ///
     /// @return Map of pointers to the servers' configurations.
@@ -725,12 +848,36 @@ public:
     /// the number of DHCP threads
     /// 3. If http-client-threads is 0, it will be replaced with
     /// the number of DHCP threads
+    /// 4. If HA+MT is disabled, the binary lease updates are disabled.
     ///
     /// As a side effect it fills the TLS context of peers when TLS is enabled.
     ///
     /// @throw HAConfigValidationError if configuration is invalid.
     void validate();
 
+    /// @brief Validates the failover partners of the servers.
+    ///
+    /// The partners are configured in the load balancing setup with more
+    /// than two active servers. Each primary server must be the partner
+    /// of a secondary server and vice versa. The backup servers have no
+    /// partner.
+    ///
+    /// @throw HAConfigValidationError if the partners are invalid.
+    void validatePartners() const;
+
+    /// @brief Validates the pools with failover partners.
+    ///
+    /// With more than two active servers, the lease updates are only sent
+    /// to the partner and to the backup servers, so the failover pairs
+    /// must not allocate leases from the same pools. Each pool of the
+    /// staging configuration must be guarded by the @c HA_<server> classes
+    /// of the servers of a single failover pair: the client class of the
+    /// pool or of its subnet must be such a class or depend on it through
+    /// the @c member expression.
+    ///
+    /// @throw HAConfigValidationError if a pool is shared by several pairs.
+    void validatePartnerPools() const;
+
     std::string this_server_name_;            ///< This server name.
     HAMode ha_mode_;                          ///< Mode of operation.
     bool send_lease_updates_;                 ///< Send lease updates to partner?
@@ -740,6 +887,9 @@ public:
                                               ///< synchronizing leases.
     uint32_t delayed_updates_limit_;          ///< Maximum number of lease updates held
                                               ///< for later send in communication-recovery.
+    std::string delayed_updates_spill_file_;  ///< File holding the lease updates
+                                              ///< exceeding the limit.
+    uint64_t delayed_updates_spill_max_size_; ///< Maximum size of the spill file.
     uint32_t heartbeat_delay_;                ///< Heartbeat delay in milliseconds.
     uint32_t max_response_delay_;             ///< Max delay in response to heartbeats.
     uint32_t max_ack_delay_;                  ///< Maximum DHCP message ack delay.
@@ -749,6 +899,7 @@ public:
     bool http_dedicated_listener_;            ///< Enable use of own HTTP listener.
     uint32_t http_listener_threads_;          ///< Number of HTTP listener threads.
     uint32_t http_client_threads_;            ///< Number of HTTP client threads.
+    bool binary_lease_updates_;               ///< Send binary lease updates?
     util::Optional<std::string> trust_anchor_; ///< Trust anchor.
     util::Optional<std::string> cert_file_;    ///< Certificate file.
     util::Optional<std::string> key_file_;     ///< Private key file.
@@ -25,20 +25,22 @@ const SimpleDefaults HA_CONFIG_LB_DEFAULTS = {
 
 /// @brief Default values for HA configuration.
 const SimpleDefaults HA_CONFIG_DEFAULTS = {
-    { "delayed-updates-limit",   Element::integer, "0" },
-    { "heartbeat-delay",         Element::integer, "10000" },
-    { "max-ack-delay",           Element::integer, "10000" },
-    { "max-response-delay",      Element::integer, "60000" },
-    { "max-unacked-clients",     Element::integer, "10" },
-    { "send-lease-updates",      Element::boolean, "true" },
-    { "sync-leases",             Element::boolean, "true" },
-    { "sync-timeout",            Element::integer, "60000" },
-    { "sync-page-limit",         Element::integer, "10000" },
-    { "wait-backup-ack",         Element::boolean, "false" }
+    { "delayed-updates-limit",          Element::integer, "0" },
+    { "delayed-updates-spill-max-size", Element::integer, "104857600" },
+    { "heartbeat-delay",                Element::integer, "10000" },
+    { "max-ack-delay",                  Element::integer, "10000" },
+    { "max-response-delay",             Element::integer, "60000" },
+    { "max-unacked-clients",            Element::integer, "10" },
+    { "send-lease-updates",             Element::boolean, "true" },
+    { "sync-leases",                    Element::boolean, "true" },
+    { "sync-timeout",                   Element::integer, "60000" },
+    { "sync-page-limit",                Element::integer, "10000" },
+    { "wait-backup-ack",                Element::boolean, "false" }
 };
 
 /// @brief Default values for HA multi-threading configuration.
 const SimpleDefaults HA_CONFIG_MT_DEFAULTS = {
+    { "binary-lease-updates",      Element::boolean, "false" },
     { "enable-multi-threading",    Element::boolean, "false" },
     { "http-client-threads",       Element::integer, "0" },
     { "http-dedicated-listener",   Element::boolean, "false" },
@@ -164,6 +166,15 @@ HAConfigParser::parseInternal(const HAConfigPtr& config_storage,
     uint32_t delayed_updates_limit = getAndValidateInteger<uint32_t>(c, "delayed-updates-limit");
     config_storage->setDelayedUpdatesLimit(delayed_updates_limit);
 
+    // Get optional 'delayed-updates-spill-file'.
+    if (c->contains("delayed-updates-spill-file")) {
+        config_storage->setDelayedUpdatesSpillFile(getString(c, "delayed-updates-spill-file"));
+    }
+
+    // Get 'delayed-updates-spill-max-size'.
+    uint64_t spill_max_size = getAndValidateInteger<uint64_t>(c, "delayed-updates-spill-max-size");
+    config_storage->setDelayedUpdatesSpillMaxSize(spill_max_size);
+
     // Get 'heartbeat-delay'.
     uint16_t heartbeat_delay = getAndValidateInteger<uint16_t>(c, "heartbeat-delay");
     config_storage->setHeartbeatDelay(heartbeat_delay);
@@ -210,6 +221,9 @@ HAConfigParser::parseInternal(const HAConfigPtr& config_storage,
     threads = getAndValidateInteger<uint32_t>(mt_config, "http-client-threads");
     config_storage->setHttpClientThreads(threads);
 
+    // Get 'binary-lease-updates'.
+    config_storage->setBinaryLeaseUpdates(getBoolean(mt_config, "binary-lease-updates"));
+
     // Get optional 'trust-anchor'.
     ConstElementPtr ca = c->get("trust-anchor");
     if (ca) {
@@ -268,6 +282,16 @@ HAConfigParser::parseInternal(const HAConfigPtr& config_storage,
         // Auto failover configuration.
         cfg->setAutoFailover(getBoolean(*p, "auto-failover"));
 
+        // Optional failover partner.
+        if ((*p)->contains("partner")) {
+            cfg->setPartner(getString(*p, "partner"));
+        }
+
+        // Optional lease replication port.
+        if ((*p)->contains("replication-port")) {
+            cfg->setReplicationPort(getAndValidateInteger<uint16_t>(*p, "replication-port"));
+        }
+
         // Basic HTTP authentication password.
         std::string password;
         if ((*p)->contains("basic-auth-password")) {
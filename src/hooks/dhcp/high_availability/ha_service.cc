@@ -48,6 +48,66 @@ public:
         CtrlChannelError(file, line, what) {}
 };
 
+/// @brief Stores the leases fetched from the partner in the lease database.
+///
+/// The leases are written using the batch operations of the lease manager,
+/// so as a page of leases is stored within one database transaction by the
+/// SQL backends.
+///
+/// @param added Leases which don't exist in the lease database.
+/// @param updated Leases which are newer than the leases in the lease
+/// database.
+/// @tparam LeaseCollectionType One of the @c Lease4Collection or
+/// @c Lease6Collection.
+template<typename LeaseCollectionType>
+void
+storeSyncedLeases(const LeaseCollectionType& added,
+                  const LeaseCollectionType& updated) {
+    LeaseMgr& lease_mgr = LeaseMgrFactory::instance();
+
+    // A lease added meanwhile by the local server is left as is.
+    try {
+        lease_mgr.addLeases(added);
+
+    } catch (const std::exception& ex) {
+        for (auto const& lease : added) {
+            LOG_WARN(isc::ha::ha_logger, isc::ha::HA_LEASE_SYNC_FAILED)
+                .arg(lease->toElement()->str())
+                .arg(ex.what());
+        }
+    }
+
+    try {
+        for (auto const& lease : lease_mgr.updateLeases(updated)) {
+            std::ostringstream error;
+            error << "unable to update lease for address " << lease->addr_
+                  << " as it does not exist";
+            LOG_WARN(isc::ha::ha_logger, isc::ha::HA_LEASE_SYNC_FAILED)
+                .arg(lease->toElement()->str())
+                .arg(error.str());
+        }
+
+    } catch (const std::exception& ex) {
+        for (auto const& lease : updated) {
+            LOG_WARN(isc::ha::ha_logger, isc::ha::HA_LEASE_SYNC_FAILED)
+                .arg(lease->toElement()->str())
+                .arg(ex.what());
+        }
+    }
+}
+
+/// @brief Returns the textual type of a DHCPv4 lease for logging.
+std::string
+leaseTypeText(const Lease4&) {
+    return (Lease::typeToText(Lease::TYPE_V4));
+}
+
+/// @brief Returns the textual type of a DHCPv6 lease for logging.
+std::string
+leaseTypeText(const Lease6& lease) {
+    return (Lease::typeToText(lease.type_));
+}
+
 }
 
 namespace isc {
@@ -68,7 +128,9 @@ HAService::HAService(const IOServicePtr& io_service, const NetworkStatePtr& netw
     : io_service_(io_service), network_state_(network_state), config_(config),
       server_type_(server_type), client_(), listener_(), communication_state_(),
       query_filter_(config), mutex_(), pending_requests_(),
-      lease_update_backlog_(config->getDelayedUpdatesLimit()),
+      lease_update_backlog_(config->getDelayedUpdatesLimit(),
+                            config->getDelayedUpdatesSpillFile(),
+                            config->getDelayedUpdatesSpillMaxSize()),
       sync_complete_notified_(false) {
 
     if (server_type == HAServerType::DHCPv4) {
@@ -112,6 +174,33 @@ HAService::HAService(const IOServicePtr& io_service, const NetworkStatePtr& netw
             listener_.reset(new CmdHttpListener(server_address, my_url.getPort(),
                                                 listener_threads));
         }
+
+        // If the lease updates are sent over the binary lease replication
+        // channel create its listener and a client for each peer.
+        if (config_->getBinaryLeaseUpdates()) {
+            auto my_config = config_->getThisServerConfig();
+            IOAddress server_address(IOAddress::IPV4_ZERO_ADDRESS());
+            try {
+                server_address = IOAddress(my_config->getUrl().getStrippedHostname());
+            } catch (const std::exception& ex) {
+                isc_throw(Unexpected, "server Url:" << my_config->getUrl().getStrippedHostname()
+                          << " is not a valid IP address");
+            }
+            replication_listener_.reset(new LeaseReplicationListener(server_address,
+                                                                     my_config->getReplicationPort(),
+                                                                     my_config->replication_tls_context_,
+                                                                     config_->getHttpListenerThreads()));
+
+            auto peers_configs = config_->getOtherServersConfig();
+            for (auto p = peers_configs.begin(); p != peers_configs.end(); ++p) {
+                IOAddress peer_address(p->second->getUrl().getStrippedHostname());
+                replication_clients_[p->first].reset(new LeaseReplicationClient(*client_->getThreadIOService(),
+                                                                                 peer_address,
+                                                                                 p->second->getReplicationPort(),
+                                                                                 p->second->getTlsContext(),
+                                                                                 TIMEOUT_DEFAULT_HTTP_CLIENT_REQUEST));
+            }
+        }
     }
 
     LOG_INFO(ha_logger, HA_SERVICE_STARTED)
@@ -1013,7 +1102,10 @@ HAService::inScopeInternal(QueryPtrType& query) {
     // If the query should be processed by the partner we need to check if
     // the partner responds. If the number of unanswered queries exceeds a
     // configured threshold, we will consider the partner to be offline.
-    if (!in_scope && communication_state_->isCommunicationInterrupted()) {
+    // With more than two active servers, only the queries which should
+    // be processed by the partner are considered.
+    if (!in_scope && communication_state_->isCommunicationInterrupted() &&
+        query_filter_.isPartnerScopeClass(scope_class)) {
         communication_state_->analyzeMessage(query);
     }
     // Indicate if the query is in scope.
@@ -1133,8 +1225,10 @@ HAService::asyncSendLeaseUpdates(const dhcp::Pkt4Ptr& query,
                                  const dhcp::Lease4CollectionPtr& deleted_leases,
                                  const hooks::ParkingLotHandlePtr& parking_lot) {
 
-    // Get configurations of the peers. Exclude this instance.
-    HAConfig::PeerConfigMap peers_configs = config_->getOtherServersConfig();
+    // Get configurations of the peers. Exclude this instance and, with
+    // more than two active servers, the active servers which are not the
+    // partner of this instance.
+    HAConfig::PeerConfigMap peers_configs = config_->getLeaseUpdatesServersConfig();
 
     size_t sent_num = 0;
 
@@ -1173,16 +1267,31 @@ HAService::asyncSendLeaseUpdates(const dhcp::Pkt4Ptr& query,
             continue;
         }
 
-        // Lease updates for deleted leases.
-        for (auto l = deleted_leases->begin(); l != deleted_leases->end(); ++l) {
-            asyncSendLeaseUpdate(query, conf, CommandCreator::createLease4Delete(**l),
-                                 parking_lot);
-        }
+        if (config_->getBinaryLeaseUpdates()) {
+            // Lease updates for deleted leases.
+            for (auto l = deleted_leases->begin(); l != deleted_leases->end(); ++l) {
+                asyncSendBinaryLeaseUpdate(query, conf, LeaseReplicationCodec::LEASE4_DELETE,
+                                           **l, parking_lot);
+            }
 
-        // Lease updates for new allocations and updated leases.
-        for (auto l = leases->begin(); l != leases->end(); ++l) {
-            asyncSendLeaseUpdate(query, conf, CommandCreator::createLease4Update(**l),
-                                 parking_lot);
+            // Lease updates for new allocations and updated leases.
+            for (auto l = leases->begin(); l != leases->end(); ++l) {
+                asyncSendBinaryLeaseUpdate(query, conf, LeaseReplicationCodec::LEASE4_UPDATE,
+                                           **l, parking_lot);
+            }
+
+        } else {
+            // Lease updates for deleted leases.
+            for (auto l = deleted_leases->begin(); l != deleted_leases->end(); ++l) {
+                asyncSendLeaseUpdate(query, conf, CommandCreator::createLease4Delete(**l),
+                                     parking_lot);
+            }
+
+            // Lease updates for new allocations and updated leases.
+            for (auto l = leases->begin(); l != leases->end(); ++l) {
+                asyncSendLeaseUpdate(query, conf, CommandCreator::createLease4Update(**l),
+                                     parking_lot);
+            }
         }
 
         // If we're contacting a backup server from which we don't expect a
@@ -1202,8 +1311,10 @@ HAService::asyncSendLeaseUpdates(const dhcp::Pkt6Ptr& query,
                                  const dhcp::Lease6CollectionPtr& deleted_leases,
                                  const hooks::ParkingLotHandlePtr& parking_lot) {
 
-    // Get configurations of the peers. Exclude this instance.
-    HAConfig::PeerConfigMap peers_configs = config_->getOtherServersConfig();
+    // Get configurations of the peers. Exclude this instance and, with
+    // more than two active servers, the active servers which are not the
+    // partner of this instance.
+    HAConfig::PeerConfigMap peers_configs = config_->getLeaseUpdatesServersConfig();
 
     size_t sent_num = 0;
 
@@ -1248,9 +1359,24 @@ HAService::asyncSendLeaseUpdates(const dhcp::Pkt6Ptr& query,
             ++sent_num;
         }
 
-        // Send new/updated leases and deleted leases in one command.
-        asyncSendLeaseUpdate(query, conf, CommandCreator::createLease6BulkApply(leases, deleted_leases),
-                             parking_lot);
+        if (config_->getBinaryLeaseUpdates()) {
+            // Lease updates for deleted leases.
+            for (auto l = deleted_leases->begin(); l != deleted_leases->end(); ++l) {
+                asyncSendBinaryLeaseUpdate(query, conf, LeaseReplicationCodec::LEASE6_DELETE,
+                                           **l, parking_lot);
+            }
+
+            // Lease updates for new allocations and updated leases.
+            for (auto l = leases->begin(); l != leases->end(); ++l) {
+                asyncSendBinaryLeaseUpdate(query, conf, LeaseReplicationCodec::LEASE6_UPDATE,
+                                           **l, parking_lot);
+            }
+
+        } else {
+            // Send new/updated leases and deleted leases in one command.
+            asyncSendLeaseUpdate(query, conf, CommandCreator::createLease6BulkApply(leases, deleted_leases),
+                                 parking_lot);
+        }
     }
 
     return (sent_num);
@@ -1389,38 +1515,7 @@ HAService::asyncSendLeaseUpdate(const QueryPtrType& query,
                 }
             }
 
-            // We don't care about the result of the lease update to the backup server.
-            // It is a best effort update.
-            if ((config->getRole() != HAConfig::PeerConfig::BACKUP) && !lease_update_success) {
-                // If we were unable to communicate with the partner we set partner's
-                // state as unavailable.
-                communication_state_->setPartnerState("unavailable");
-            }
-
-            // It is possible to configure the server to not wait for a response from
-            // the backup server before we unpark the packet and respond to the client.
-            // Here we check if we're dealing with such situation.
-            if (config_->amWaitingBackupAck() || (config->getRole() != HAConfig::PeerConfig::BACKUP)) {
-                // We're expecting a response from the backup server or it is not
-                // a backup server and the lease update was unsuccessful. In such
-                // case the DHCP exchange fails.
-                if (!lease_update_success) {
-                    parking_lot->drop(query);
-                }
-            } else {
-                // This was a response from the backup server and we're configured to
-                // not wait for their acknowledgments, so there is nothing more to do.
-                return;
-            }
-
-            if (leaseUpdateComplete(query, parking_lot)) {
-                // If we have finished sending the lease updates we need to run the
-                // state machine until the state machine finds that additional events
-                // are required, such as next heartbeat or a lease update. The runModel()
-                // may transition to another state, schedule asynchronous tasks etc.
-                // Then it returns control to the DHCP server.
-                runModel(HA_LEASE_UPDATES_COMPLETE_EVT);
-            }
+            processLeaseUpdateResult(query, config, parking_lot, lease_update_success);
         },
         HttpClient::RequestTimeout(TIMEOUT_DEFAULT_HTTP_CLIENT_REQUEST),
         std::bind(&HAService::clientConnectHandler, this, ph::_1, ph::_2),
@@ -1438,6 +1533,127 @@ HAService::asyncSendLeaseUpdate(const QueryPtrType& query,
     }
 }
 
+template<typename QueryPtrType, typename LeaseType>
+void
+HAService::asyncSendBinaryLeaseUpdate(const QueryPtrType& query,
+                                      const HAConfig::PeerConfigPtr& config,
+                                      const LeaseReplicationCodec::MessageType type,
+                                      const LeaseType& lease,
+                                      const ParkingLotHandlePtr& parking_lot) {
+    auto client = replication_clients_.find(config->getName());
+    if (client == replication_clients_.end()) {
+        isc_throw(Unexpected, "no lease replication client for the server "
+                  << config->getName());
+    }
+
+    // The number of pending requests must be updated before the update
+    // is sent because the acknowledgment may be received by another
+    // thread before this function returns.
+    if (config_->amWaitingBackupAck() || (config->getRole() != HAConfig::PeerConfig::BACKUP)) {
+        updatePendingRequest(query);
+    }
+
+    boost::weak_ptr<typename QueryPtrType::element_type> weak_query(query);
+    std::string address = lease.addr_.toText();
+    std::string lease_type = leaseTypeText(lease);
+    bool deleted = ((type == LeaseReplicationCodec::LEASE4_DELETE) ||
+                    (type == LeaseReplicationCodec::LEASE6_DELETE));
+
+    client->second->asyncSendLease(type, lease,
+        [this, weak_query, parking_lot, config, address, lease_type, deleted]
+            (const std::string& error,
+             const LeaseReplicationCodec::Status status,
+             const std::string& text) {
+            QueryPtrType query = weak_query.lock();
+            if (!query) {
+                isc_throw(Unexpected, "query is null while receiving response from"
+                          " HA peer. This is programmatic error");
+            }
+
+            bool lease_update_success = true;
+
+            if (!error.empty()) {
+                LOG_WARN(ha_logger, HA_LEASE_UPDATE_COMMUNICATIONS_FAILED)
+                    .arg(query->getLabel())
+                    .arg(config->getLogLabel())
+                    .arg(error);
+                lease_update_success = false;
+
+            } else if (status == LeaseReplicationCodec::STATUS_SUCCESS) {
+                // Nothing to do.
+
+            } else if (boost::dynamic_pointer_cast<Pkt6>(query)) {
+                // As for the lease6-bulk-apply command, the failures to
+                // apply the DHCPv6 leases are logged but do not fail the
+                // lease update.
+                if (deleted) {
+                    LOG_INFO(ha_logger, HA_LEASE_UPDATE_DELETE_FAILED_ON_PEER)
+                        .arg(query->getLabel())
+                        .arg(lease_type)
+                        .arg(address)
+                        .arg(text);
+                } else {
+                    LOG_INFO(ha_logger, HA_LEASE_UPDATE_CREATE_UPDATE_FAILED_ON_PEER)
+                        .arg(query->getLabel())
+                        .arg(lease_type)
+                        .arg(address)
+                        .arg(text);
+                }
+
+            } else if (!deleted || (status != LeaseReplicationCodec::STATUS_EMPTY)) {
+                // The deletion of a DHCPv4 lease which the peer doesn't have
+                // is not an error.
+                LOG_WARN(ha_logger, HA_LEASE_UPDATE_FAILED)
+                    .arg(query->getLabel())
+                    .arg(config->getLogLabel())
+                    .arg(text);
+                lease_update_success = false;
+            }
+
+            processLeaseUpdateResult(query, config, parking_lot, lease_update_success);
+        });
+}
+
+template<typename QueryPtrType>
+void
+HAService::processLeaseUpdateResult(QueryPtrType& query,
+                                    const HAConfig::PeerConfigPtr& config,
+                                    const ParkingLotHandlePtr& parking_lot,
+                                    const bool lease_update_success) {
+    // We don't care about the result of the lease update to the backup server.
+    // It is a best effort update.
+    if ((config->getRole() != HAConfig::PeerConfig::BACKUP) && !lease_update_success) {
+        // If we were unable to communicate with the partner we set partner's
+        // state as unavailable.
+        communication_state_->setPartnerState("unavailable");
+    }
+
+    // It is possible to configure the server to not wait for a response from
+    // the backup server before we unpark the packet and respond to the client.
+    // Here we check if we're dealing with such situation.
+    if (config_->amWaitingBackupAck() || (config->getRole() != HAConfig::PeerConfig::BACKUP)) {
+        // We're expecting a response from the backup server or it is not
+        // a backup server and the lease update was unsuccessful. In such
+        // case the DHCP exchange fails.
+        if (!lease_update_success) {
+            parking_lot->drop(query);
+        }
+    } else {
+        // This was a response from the backup server and we're configured to
+        // not wait for their acknowledgments, so there is nothing more to do.
+        return;
+    }
+
+    if (leaseUpdateComplete(query, parking_lot)) {
+        // If we have finished sending the lease updates we need to run the
+        // state machine until the state machine finds that additional events
+        // are required, such as next heartbeat or a lease update. The runModel()
+        // may transition to another state, schedule asynchronous tasks etc.
+        // Then it returns control to the DHCP server.
+        runModel(HA_LEASE_UPDATES_COMPLETE_EVT);
+    }
+}
+
 bool
 HAService::shouldSendLeaseUpdates(const HAConfig::PeerConfigPtr& peer_config) const {
     // Never send lease updates if they are administratively disabled.
@@ -2084,6 +2300,13 @@ HAService::asyncSyncLeasesInternal(http::HttpClient& http_client,
                         .arg(leases_element.size())
                         .arg(server_name);
 
+                    // Leases to be added and updated. They are written to the
+                    // database at once when the whole page has been processed.
+                    Lease4Collection added4;
+                    Lease4Collection updated4;
+                    Lease6Collection added6;
+                    Lease6Collection updated6;
+
                     for (auto l = leases_element.begin(); l != leases_element.end(); ++l) {
                         try {
 
@@ -2094,7 +2317,7 @@ HAService::asyncSyncLeasesInternal(http::HttpClient& http_client,
                                 Lease4Ptr existing_lease = LeaseMgrFactory::instance().getLease4(lease->addr_);
                                 if (!existing_lease) {
                                     // There is no such lease, so let's add it.
-                                    LeaseMgrFactory::instance().addLease(lease);
+                                    added4.push_back(lease);
 
                                 } else if (existing_lease->cltt_ < lease->cltt_) {
                                     // If the existing lease is older than the fetched lease, update
@@ -2103,7 +2326,7 @@ HAService::asyncSyncLeasesInternal(http::HttpClient& http_client,
                                     // database. Some database backends reject operations on the lease if
                                     // the current expiration time value does not match what is stored.
                                     Lease::syncCurrentExpirationTime(*existing_lease, *lease);
-                                    LeaseMgrFactory::instance().updateLease4(lease);
+                                    updated4.push_back(lease);
 
                                 } else {
                                     LOG_DEBUG(ha_logger, DBGLVL_TRACE_BASIC, HA_LEASE_SYNC_STALE_LEASE4_SKIP)
@@ -2127,7 +2350,7 @@ HAService::asyncSyncLeasesInternal(http::HttpClient& http_client,
                                                                                                  lease->addr_);
                                 if (!existing_lease) {
                                     // There is no such lease, so let's add it.
-                                    LeaseMgrFactory::instance().addLease(lease);
+                                    added6.push_back(lease);
 
                                 } else if (existing_lease->cltt_ < lease->cltt_) {
                                     // If the existing lease is older than the fetched lease, update
@@ -2136,7 +2359,7 @@ HAService::asyncSyncLeasesInternal(http::HttpClient& http_client,
                                     // database. Some database backends reject operations on the lease if
                                     // the current expiration time value does not match what is stored.
                                     Lease::syncCurrentExpirationTime(*existing_lease, *lease);
-                                    LeaseMgrFactory::instance().updateLease6(lease);
+                                    updated6.push_back(lease);
 
                                 } else {
                                     LOG_DEBUG(ha_logger, DBGLVL_TRACE_BASIC, HA_LEASE_SYNC_STALE_LEASE6_SKIP)
@@ -2160,6 +2383,12 @@ HAService::asyncSyncLeasesInternal(http::HttpClient& http_client,
                         }
                     }
 
+                    if (server_type_ == HAServerType::DHCPv4) {
+                        storeSyncedLeases(added4, updated4);
+                    } else {
+                        storeSyncedLeases(added6, updated6);
+                    }
+
                 } catch (const std::exception& ex) {
                     error_message = ex.what();
                     LOG_ERROR(ha_logger, HA_LEASES_SYNC_FAILED)
@@ -2333,7 +2562,13 @@ HAService::asyncSendLeaseUpdatesFromBacklog(HttpClient& http_client,
                                             const HAConfig::PeerConfigPtr& config,
                                             PostRequestCallback post_request_action) {
     if (lease_update_backlog_.size() == 0) {
-        post_request_action(true, "", CONTROL_RESULT_SUCCESS);
+        // Some lease updates are lost if the spill file could not be read.
+        if (lease_update_backlog_.wasOverflown()) {
+            post_request_action(false, "lease updates backlog was overflown",
+                                CONTROL_RESULT_ERROR);
+        } else {
+            post_request_action(true, "", CONTROL_RESULT_SUCCESS);
+        }
         return;
     }
 
@@ -2341,6 +2576,11 @@ HAService::asyncSendLeaseUpdatesFromBacklog(HttpClient& http_client,
     if (server_type_ == HAServerType::DHCPv4) {
         LeaseUpdateBacklog::OpType op_type;
         Lease4Ptr lease = boost::dynamic_pointer_cast<Lease4>(lease_update_backlog_.pop(op_type));
+        if (!lease) {
+            post_request_action(false, "lease updates backlog was overflown",
+                                CONTROL_RESULT_ERROR);
+            return;
+        }
         if (op_type == LeaseUpdateBacklog::ADD) {
             command = CommandCreator::createLease4Update(*lease);
         } else {
@@ -2348,7 +2588,8 @@ HAService::asyncSendLeaseUpdatesFromBacklog(HttpClient& http_client,
         }
 
     } else {
-        command = CommandCreator::createLease6BulkApply(lease_update_backlog_);
+        command = CommandCreator::createLease6BulkApply(lease_update_backlog_,
+                                                        config_->getSyncPageLimit());
     }
 
     // Create HTTP/1.1 request including our command.
@@ -2392,10 +2633,9 @@ HAService::asyncSendLeaseUpdatesFromBacklog(HttpClient& http_client,
              }
 
              // Recursively send all outstanding lease updates or break when an
-             // error occurs. In DHCPv6, this is a single iteration because we use
-             // lease6-bulk-apply, which combines many lease updates in a single
-             // transaction. In the case of DHCPv4, each update is sent in its own
-             // transaction.
+             // error occurs. In DHCPv6, we use lease6-bulk-apply, which combines
+             // up to sync-page-limit lease updates in a single transaction. In the
+             // case of DHCPv4, each update is sent in its own transaction.
              if (error_message.empty()) {
                  asyncSendLeaseUpdatesFromBacklog(http_client, config, post_request_action);
              } else {
@@ -3045,6 +3285,10 @@ HAService::checkPermissionsClientAndListener() {
         if (listener_) {
             listener_->checkPermissions();
         }
+
+        if (replication_listener_) {
+            replication_listener_->checkPermissions();
+        }
     } catch (const isc::MultiThreadingInvalidOperation& ex) {
         LOG_ERROR(ha_logger, HA_PAUSE_CLIENT_LISTENER_ILLEGAL)
                   .arg(ex.what());
@@ -3072,6 +3316,10 @@ HAService::startClientAndListener() {
     if (listener_) {
         listener_->start();
     }
+
+    if (replication_listener_) {
+        replication_listener_->start();
+    }
 }
 
 void
@@ -3086,6 +3334,10 @@ HAService::pauseClientAndListener() {
         if (listener_) {
             listener_->pause();
         }
+
+        if (replication_listener_) {
+            replication_listener_->pause();
+        }
     } catch (const std::exception& ex) {
         LOG_ERROR(ha_logger, HA_PAUSE_CLIENT_LISTENER_FAILED)
                   .arg(ex.what());
@@ -3104,6 +3356,10 @@ HAService::resumeClientAndListener() {
         if (listener_) {
             listener_->resume();
         }
+
+        if (replication_listener_) {
+            replication_listener_->resume();
+        }
     } catch (std::exception& ex) {
         LOG_ERROR(ha_logger, HA_RESUME_CLIENT_LISTENER_FAILED)
                   .arg(ex.what());
@@ -3119,9 +3375,18 @@ HAService::stopClientAndListener() {
         client_->stop();
     }
 
+    // Fail the lease updates not yet acknowledged by the peers.
+    for (auto const& client : replication_clients_) {
+        client.second->close();
+    }
+
     if (listener_) {
         listener_->stop();
     }
+
+    if (replication_listener_) {
+        replication_listener_->stop();
+    }
 }
 
 // Explicit instantiations.
@@ -10,6 +10,7 @@
 #include <communication_state.h>
 #include <ha_config.h>
 #include <ha_server_type.h>
+#include <lease_replication_channel.h>
 #include <lease_update_backlog.h>
 #include <query_filter.h>
 #include <asiolink/asio_wrapper.h>
@@ -588,6 +589,45 @@ protected:
                               const data::ConstElementPtr& command,
                               const hooks::ParkingLotHandlePtr& parking_lot);
 
+    /// @brief Asynchronously sends lease update to the peer over the binary
+    /// lease replication channel.
+    ///
+    /// @param query Pointer to the DHCP client's query.
+    /// @param config Pointer to the configuration of the server to which the
+    /// update should be sent.
+    /// @param type Type of the lease replication message.
+    /// @param lease The updated or deleted lease.
+    /// @param [out] parking_lot Parking lot where the query is parked.
+    /// @tparam QueryPtrType Type of the pointer to the DHCP client's message,
+    /// i.e. Pkt4Ptr or Pkt6Ptr.
+    /// @tparam LeaseType Type of the lease, i.e. Lease4 or Lease6.
+    /// @throw Unexpected when an unexpected error occurs.
+    template<typename QueryPtrType, typename LeaseType>
+    void asyncSendBinaryLeaseUpdate(const QueryPtrType& query,
+                                    const HAConfig::PeerConfigPtr& config,
+                                    const LeaseReplicationCodec::MessageType type,
+                                    const LeaseType& lease,
+                                    const hooks::ParkingLotHandlePtr& parking_lot);
+
+    /// @brief Processes the result of a lease update sent to the peer.
+    ///
+    /// Marks the partner as unavailable and drops the query when the update
+    /// failed, unparks the query when all its lease updates completed.
+    ///
+    /// @param query Pointer to the DHCP client's query.
+    /// @param config Pointer to the configuration of the server to which the
+    /// update was sent.
+    /// @param parking_lot Parking lot where the query is parked.
+    /// @param lease_update_success Boolean flag indicating whether the lease
+    /// update was successful.
+    /// @tparam QueryPtrType Type of the pointer to the DHCP client's message,
+    /// i.e. Pkt4Ptr or Pkt6Ptr.
+    template<typename QueryPtrType>
+    void processLeaseUpdateResult(QueryPtrType& query,
+                                  const HAConfig::PeerConfigPtr& config,
+                                  const hooks::ParkingLotHandlePtr& parking_lot,
+                                  const bool lease_update_success);
+
     /// @brief Log failed lease updates.
     ///
     /// Logs failed lease updates included in the "failed-deleted-leases"
@@ -1162,6 +1202,15 @@ protected:
     /// and lease updates.
     config::CmdHttpListenerPtr listener_;
 
+    /// @brief Listener receiving the binary lease updates from the peers.
+    ///
+    /// It is only created when the binary lease updates are enabled.
+    LeaseReplicationListenerPtr replication_listener_;
+
+    /// @brief Clients sending the binary lease updates to the peers, by
+    /// peer name.
+    std::map<std::string, LeaseReplicationClientPtr> replication_clients_;
+
     /// @brief Holds communication state with a peer.
     CommunicationStatePtr communication_state_;
 
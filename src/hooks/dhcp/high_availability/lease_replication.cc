@@ -0,0 +1,310 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <lease_replication.h>
+#include <cc/data.h>
+#include <dhcp/duid.h>
+#include <dhcp/hwaddr.h>
+#include <vector>
+
+using namespace isc::asiolink;
+using namespace isc::data;
+using namespace isc::dhcp;
+using namespace isc::util;
+
+namespace {
+
+/// @brief Flag set when the forward DNS update was performed.
+const uint8_t FLAG_FQDN_FWD = 0x01;
+
+/// @brief Flag set when the reverse DNS update was performed.
+const uint8_t FLAG_FQDN_REV = 0x02;
+
+/// @brief Writes the message header with a length to be filled in later.
+///
+/// @param buf Buffer the header is appended to.
+/// @param type Message type.
+/// @param sequence Sequence number.
+/// @return Position of the length field in the buffer.
+size_t
+writeHeader(OutputBuffer& buf, const uint8_t type, const uint32_t sequence) {
+    size_t start = buf.getLength();
+    buf.writeUint32(0);
+    buf.writeUint8(type);
+    buf.writeUint32(sequence);
+    return (start);
+}
+
+/// @brief Fills in the length of a message.
+///
+/// @param buf Buffer holding the message.
+/// @param start Position of the length field in the buffer.
+void
+writeLength(OutputBuffer& buf, const size_t start) {
+    size_t length = buf.getLength() - start - sizeof(uint32_t);
+    if (length > isc::ha::LeaseReplicationCodec::MAX_MESSAGE_LENGTH) {
+        isc_throw(isc::ha::LeaseReplicationError, "lease replication message"
+                  " too long: " << length);
+    }
+    buf.writeUint16At(static_cast<uint16_t>(length >> 16), start);
+    buf.writeUint16At(static_cast<uint16_t>(length & 0xffff), start + 2);
+}
+
+/// @brief Writes a variable length field with a 16 bits length.
+///
+/// @param buf Buffer the field is appended to.
+/// @param data Field data.
+/// @param len Field length.
+void
+writeField(OutputBuffer& buf, const void* data, const size_t len) {
+    if (len > 0xffff) {
+        isc_throw(isc::ha::LeaseReplicationError, "lease replication field"
+                  " too long: " << len);
+    }
+    buf.writeUint16(static_cast<uint16_t>(len));
+    if (len > 0) {
+        buf.writeData(data, len);
+    }
+}
+
+/// @brief Reads a variable length field with a 16 bits length.
+///
+/// @param buf Buffer the field is read from.
+/// @param [out] data Field data.
+void
+readField(InputBuffer& buf, std::vector<uint8_t>& data) {
+    size_t len = buf.readUint16();
+    data.clear();
+    if (len > 0) {
+        buf.readVector(data, len);
+    }
+}
+
+/// @brief Writes the fields common to the DHCPv4 and DHCPv6 leases.
+///
+/// @param buf Buffer the fields are appended to.
+/// @param lease The lease.
+void
+writeCommon(OutputBuffer& buf, const Lease& lease) {
+    buf.writeUint32(lease.valid_lft_);
+    buf.writeUint64(static_cast<uint64_t>(lease.cltt_));
+    buf.writeUint32(lease.subnet_id_);
+    buf.writeUint8((lease.fqdn_fwd_ ? FLAG_FQDN_FWD : 0) |
+                   (lease.fqdn_rev_ ? FLAG_FQDN_REV : 0));
+    writeField(buf, lease.hostname_.c_str(), lease.hostname_.size());
+    if (lease.hwaddr_ && !lease.hwaddr_->hwaddr_.empty()) {
+        buf.writeUint16(lease.hwaddr_->htype_);
+        writeField(buf, &lease.hwaddr_->hwaddr_[0], lease.hwaddr_->hwaddr_.size());
+    } else {
+        buf.writeUint16(0);
+        writeField(buf, 0, 0);
+    }
+    buf.writeUint32(lease.state_);
+    ConstElementPtr ctx = lease.getContext();
+    if (ctx) {
+        std::string text = ctx->str();
+        writeField(buf, text.c_str(), text.size());
+    } else {
+        writeField(buf, 0, 0);
+    }
+}
+
+/// @brief Reads the fields common to the DHCPv4 and DHCPv6 leases.
+///
+/// @param buf Buffer the fields are read from.
+/// @param [out] lease The lease.
+void
+readCommon(InputBuffer& buf, Lease& lease) {
+    lease.valid_lft_ = buf.readUint32();
+    uint64_t cltt = buf.readUint32();
+    cltt = (cltt << 32) | buf.readUint32();
+    lease.cltt_ = static_cast<time_t>(cltt);
+    lease.subnet_id_ = buf.readUint32();
+    uint8_t flags = buf.readUint8();
+    lease.fqdn_fwd_ = ((flags & FLAG_FQDN_FWD) != 0);
+    lease.fqdn_rev_ = ((flags & FLAG_FQDN_REV) != 0);
+    std::vector<uint8_t> data;
+    readField(buf, data);
+    lease.hostname_.assign(data.begin(), data.end());
+    uint16_t htype = buf.readUint16();
+    readField(buf, data);
+    if (!data.empty()) {
+        lease.hwaddr_.reset(new HWAddr(data, htype));
+    }
+    lease.state_ = buf.readUint32();
+    readField(buf, data);
+    if (!data.empty()) {
+        lease.setContext(Element::fromJSON(std::string(data.begin(), data.end())));
+    }
+    // The current values are the values of the lease as received.
+    lease.updateCurrentExpirationTime();
+}
+
+}
+
+namespace isc {
+namespace ha {
+
+void
+LeaseReplicationCodec::encodeLease4(OutputBuffer& buf, const MessageType type,
+                                    const uint32_t sequence, const Lease4& lease) {
+    size_t start = writeHeader(buf, type, sequence);
+    buf.writeUint32(lease.addr_.toUint32());
+    if (lease.client_id_) {
+        const std::vector<uint8_t>& client_id = lease.client_id_->getClientId();
+        writeField(buf, &client_id[0], client_id.size());
+    } else {
+        writeField(buf, 0, 0);
+    }
+    writeCommon(buf, lease);
+    writeLength(buf, start);
+}
+
+void
+LeaseReplicationCodec::encodeLease6(OutputBuffer& buf, const MessageType type,
+                                    const uint32_t sequence, const Lease6& lease) {
+    size_t start = writeHeader(buf, type, sequence);
+    buf.writeUint8(static_cast<uint8_t>(lease.type_));
+    std::vector<uint8_t> addr = lease.addr_.toBytes();
+    buf.writeData(&addr[0], addr.size());
+    buf.writeUint8(lease.prefixlen_);
+    buf.writeUint32(lease.iaid_);
+    if (lease.duid_) {
+        const std::vector<uint8_t>& duid = lease.duid_->getDuid();
+        writeField(buf, &duid[0], duid.size());
+    } else {
+        writeField(buf, 0, 0);
+    }
+    buf.writeUint32(lease.preferred_lft_);
+    writeCommon(buf, lease);
+    writeLength(buf, start);
+}
+
+void
+LeaseReplicationCodec::encodeAck(OutputBuffer& buf, const uint32_t sequence,
+                                 const Status status, const std::string& text) {
+    size_t start = writeHeader(buf, ACK, sequence);
+    buf.writeUint8(status);
+    writeField(buf, text.c_str(), std::min(text.size(), size_t(1024)));
+    writeLength(buf, start);
+}
+
+size_t
+LeaseReplicationCodec::getMessageLength(const uint8_t* data, const size_t size) {
+    if (size < sizeof(uint32_t)) {
+        return (0);
+    }
+    uint32_t length = (static_cast<uint32_t>(data[0]) << 24) |
+        (static_cast<uint32_t>(data[1]) << 16) |
+        (static_cast<uint32_t>(data[2]) << 8) |
+        static_cast<uint32_t>(data[3]);
+    if ((length < HEADER_LENGTH - sizeof(uint32_t)) || (length > MAX_MESSAGE_LENGTH)) {
+        isc_throw(LeaseReplicationError, "invalid lease replication message"
+                  " length: " << length);
+    }
+    if (size < length + sizeof(uint32_t)) {
+        return (0);
+    }
+    return (length + sizeof(uint32_t));
+}
+
+void
+LeaseReplicationCodec::decodeHeader(InputBuffer& buf, MessageType& type,
+                                    uint32_t& sequence) {
+    try {
+        static_cast<void>(buf.readUint32());
+        uint8_t value = buf.readUint8();
+        switch (value) {
+        case LEASE4_UPDATE:
+        case LEASE4_DELETE:
+        case LEASE6_UPDATE:
+        case LEASE6_DELETE:
+        case ACK:
+            type = static_cast<MessageType>(value);
+            break;
+        default:
+            isc_throw(LeaseReplicationError, "unsupported lease replication"
+                      " message type " << static_cast<unsigned>(value));
+        }
+        sequence = buf.readUint32();
+
+    } catch (const LeaseReplicationError&) {
+        throw;
+
+    } catch (const std::exception& ex) {
+        isc_throw(LeaseReplicationError, "malformed lease replication message"
+                  " header: " << ex.what());
+    }
+}
+
+Lease4Ptr
+LeaseReplicationCodec::decodeLease4(InputBuffer& buf) {
+    try {
+        Lease4Ptr lease(new Lease4());
+        lease->addr_ = IOAddress(buf.readUint32());
+        std::vector<uint8_t> client_id;
+        readField(buf, client_id);
+        if (!client_id.empty()) {
+            lease->client_id_.reset(new ClientId(client_id));
+        }
+        readCommon(buf, *lease);
+        return (lease);
+
+    } catch (const std::exception& ex) {
+        isc_throw(LeaseReplicationError, "malformed DHCPv4 lease in the lease"
+                  " replication message: " << ex.what());
+    }
+}
+
+Lease6Ptr
+LeaseReplicationCodec::decodeLease6(InputBuffer& buf) {
+    try {
+        Lease6Ptr lease(new Lease6());
+        uint8_t type = buf.readUint8();
+        if ((type != Lease::TYPE_NA) && (type != Lease::TYPE_TA) &&
+            (type != Lease::TYPE_PD)) {
+            isc_throw(BadValue, "invalid lease type " << static_cast<unsigned>(type));
+        }
+        lease->type_ = static_cast<Lease::Type>(type);
+        uint8_t addr[16];
+        buf.readData(addr, sizeof(addr));
+        lease->addr_ = IOAddress::fromBytes(AF_INET6, addr);
+        lease->prefixlen_ = buf.readUint8();
+        lease->iaid_ = buf.readUint32();
+        std::vector<uint8_t> duid;
+        readField(buf, duid);
+        if (!duid.empty()) {
+            lease->duid_.reset(new DUID(duid));
+        }
+        lease->preferred_lft_ = buf.readUint32();
+        readCommon(buf, *lease);
+        return (lease);
+
+    } catch (const std::exception& ex) {
+        isc_throw(LeaseReplicationError, "malformed DHCPv6 lease in the lease"
+                  " replication message: " << ex.what());
+    }
+}
+
+LeaseReplicationCodec::Status
+LeaseReplicationCodec::decodeAck(InputBuffer& buf, std::string& text) {
+    try {
+        uint8_t status = buf.readUint8();
+        std::vector<uint8_t> data;
+        readField(buf, data);
+        text.assign(data.begin(), data.end());
+        return (static_cast<Status>(status));
+
+    } catch (const std::exception& ex) {
+        isc_throw(LeaseReplicationError, "malformed lease replication"
+                  " acknowledgment: " << ex.what());
+    }
+}
+
+} // end of namespace isc::ha
+} // end of namespace isc
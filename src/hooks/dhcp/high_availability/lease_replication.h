@@ -0,0 +1,145 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef HA_LEASE_REPLICATION_H
+#define HA_LEASE_REPLICATION_H
+
+#include <dhcpsrv/lease.h>
+#include <exceptions/exceptions.h>
+#include <util/buffer.h>
+#include <cstdint>
+#include <string>
+
+namespace isc {
+namespace ha {
+
+/// @brief Exception thrown when a lease replication message is malformed.
+class LeaseReplicationError : public Exception {
+public:
+    LeaseReplicationError(const char* file, size_t line, const char* what) :
+        isc::Exception(file, line, what) { };
+};
+
+/// @brief Encoding of the binary lease replication messages.
+///
+/// When the binary lease updates are enabled, the lease updates are sent
+/// to the HA peers over a long-lived TCP (or TLS) connection carrying
+/// binary messages, rather than as control commands carried in HTTP
+/// requests. Each message is made of:
+///
+/// - the length of the message, not including this field (4 bytes),
+/// - the message type (1 byte),
+/// - the sequence number of the message (4 bytes),
+/// - the payload.
+///
+/// The payload of the lease update and delete messages is the encoded
+/// lease. The sender doesn't wait for the acknowledgment of a message
+/// before sending the next one. The receiver acknowledges each message,
+/// in order, with an @c ACK message carrying the sequence number of the
+/// acknowledged message, a status code and an optional error text.
+///
+/// All integers are in network byte order.
+class LeaseReplicationCodec {
+public:
+
+    /// @brief Message types.
+    enum MessageType : uint8_t {
+        LEASE4_UPDATE = 1,
+        LEASE4_DELETE = 2,
+        LEASE6_UPDATE = 3,
+        LEASE6_DELETE = 4,
+        ACK = 128
+    };
+
+    /// @brief Status codes carried in the @c ACK messages.
+    ///
+    /// They have the same meaning as the control command results
+    /// returned for the equivalent lease commands.
+    enum Status : uint8_t {
+        STATUS_SUCCESS = 0,
+        STATUS_ERROR = 1,
+        STATUS_EMPTY = 3
+    };
+
+    /// @brief Length of the message header, including the length field.
+    static const size_t HEADER_LENGTH = 9;
+
+    /// @brief Maximum length of a message, not including the length field.
+    static const uint32_t MAX_MESSAGE_LENGTH = 65536;
+
+    /// @brief Encodes a DHCPv4 lease update or delete message.
+    ///
+    /// @param [out] buf Buffer the message is appended to.
+    /// @param type One of the @c LEASE4_UPDATE or @c LEASE4_DELETE.
+    /// @param sequence Sequence number of the message.
+    /// @param lease The lease.
+    static void encodeLease4(util::OutputBuffer& buf, const MessageType type,
+                             const uint32_t sequence, const dhcp::Lease4& lease);
+
+    /// @brief Encodes a DHCPv6 lease update or delete message.
+    ///
+    /// @param [out] buf Buffer the message is appended to.
+    /// @param type One of the @c LEASE6_UPDATE or @c LEASE6_DELETE.
+    /// @param sequence Sequence number of the message.
+    /// @param lease The lease.
+    static void encodeLease6(util::OutputBuffer& buf, const MessageType type,
+                             const uint32_t sequence, const dhcp::Lease6& lease);
+
+    /// @brief Encodes an acknowledgment message.
+    ///
+    /// @param [out] buf Buffer the message is appended to.
+    /// @param sequence Sequence number of the acknowledged message.
+    /// @param status Status of the update.
+    /// @param text Error text, possibly empty.
+    static void encodeAck(util::OutputBuffer& buf, const uint32_t sequence,
+                          const Status status, const std::string& text);
+
+    /// @brief Returns the length of the first message of received data.
+    ///
+    /// @param data Pointer to the received data.
+    /// @param size Size of the received data.
+    /// @return Length of the message, including the length field, or 0 if
+    /// the received data don't contain the whole message yet.
+    /// @throw LeaseReplicationError if the length of the message is invalid.
+    static size_t getMessageLength(const uint8_t* data, const size_t size);
+
+    /// @brief Decodes the header of a message.
+    ///
+    /// @param buf Buffer holding one message, including the length field.
+    /// It is positioned at the payload on return.
+    /// @param [out] type Message type.
+    /// @param [out] sequence Sequence number of the message.
+    /// @throw LeaseReplicationError if the header is invalid.
+    static void decodeHeader(util::InputBuffer& buf, MessageType& type,
+                             uint32_t& sequence);
+
+    /// @brief Decodes the DHCPv4 lease carried by a message.
+    ///
+    /// @param buf Buffer positioned at the payload.
+    /// @return Pointer to the decoded lease.
+    /// @throw LeaseReplicationError if the lease is malformed.
+    static dhcp::Lease4Ptr decodeLease4(util::InputBuffer& buf);
+
+    /// @brief Decodes the DHCPv6 lease carried by a message.
+    ///
+    /// @param buf Buffer positioned at the payload.
+    /// @return Pointer to the decoded lease.
+    /// @throw LeaseReplicationError if the lease is malformed.
+    static dhcp::Lease6Ptr decodeLease6(util::InputBuffer& buf);
+
+    /// @brief Decodes the payload of an acknowledgment message.
+    ///
+    /// @param buf Buffer positioned at the payload.
+    /// @param [out] text Error text, possibly empty.
+    /// @return Status of the update.
+    /// @throw LeaseReplicationError if the message is malformed.
+    static Status decodeAck(util::InputBuffer& buf, std::string& text);
+};
+
+} // end of namespace isc::ha
+} // end of namespace isc
+
+#endif // HA_LEASE_REPLICATION_H
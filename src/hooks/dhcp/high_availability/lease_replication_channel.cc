@@ -0,0 +1,987 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <asiolink/asio_wrapper.h>
+#include <asiolink/tcp_endpoint.h>
+#include <database/db_exceptions.h>
+#include <dhcpsrv/dhcpsrv_exceptions.h>
+#include <dhcpsrv/lease_mgr_factory.h>
+#include <ha_log.h>
+#include <lease_replication_channel.h>
+#include <stats/stats_mgr.h>
+#include <util/multi_threading_mgr.h>
+#include <boost/pointer_cast.hpp>
+#include <boost/weak_ptr.hpp>
+
+using namespace isc::asiolink;
+using namespace isc::dhcp;
+using namespace isc::http;
+using namespace isc::log;
+using namespace isc::stats;
+using namespace isc::util;
+namespace ph = std::placeholders;
+
+namespace {
+
+/// @brief Adds a value to the statistics of a lease.
+///
+/// The expired-reclaimed leases are not counted.
+///
+/// @param lease The lease.
+/// @param assigned Name of the assigned leases statistic of the subnet.
+/// @param value The value to add (1 or -1).
+void
+countLease(const Lease& lease, const std::string& assigned, const int64_t value) {
+    if (lease.stateExpiredReclaimed()) {
+        return;
+    }
+    StatsMgr::instance().addValue(StatsMgr::generateName("subnet", lease.subnet_id_,
+                                                         assigned),
+                                  value);
+    if (lease.stateDeclined()) {
+        StatsMgr::instance().addValue("declined-addresses", value);
+        StatsMgr::instance().addValue(StatsMgr::generateName("subnet", lease.subnet_id_,
+                                                             "declined-addresses"),
+                                      value);
+    }
+}
+
+/// @brief Returns the name of the assigned leases statistic of a lease.
+///
+/// @param lease The DHCPv4 lease.
+std::string
+assignedStatName(const Lease4&) {
+    return ("assigned-addresses");
+}
+
+/// @brief Returns the name of the assigned leases statistic of a lease.
+///
+/// @param lease The DHCPv6 lease.
+std::string
+assignedStatName(const Lease6& lease) {
+    return (lease.type_ == Lease::TYPE_NA ? "assigned-nas" : "assigned-pds");
+}
+
+/// @brief Updates the lease statistics when a lease is changed.
+///
+/// @param existing The lease before the change, null if it was added.
+/// @param lease The lease after the change, null if it was deleted.
+/// @tparam LeasePtrType One of the @c Lease4Ptr or @c Lease6Ptr.
+template<typename LeasePtrType>
+void
+updateStats(const LeasePtrType& existing, const LeasePtrType& lease) {
+    if (existing) {
+        countLease(*existing, assignedStatName(*existing), -1);
+    }
+    if (lease) {
+        countLease(*lease, assignedStatName(*lease), 1);
+    }
+}
+
+/// @brief Updates a DHCPv4 lease in the lease database.
+///
+/// @param lease The lease.
+void
+updateLease(const Lease4Ptr& lease) {
+    LeaseMgrFactory::instance().updateLease4(lease);
+}
+
+/// @brief Updates a DHCPv6 lease in the lease database.
+///
+/// @param lease The lease.
+void
+updateLease(const Lease6Ptr& lease) {
+    LeaseMgrFactory::instance().updateLease6(lease);
+}
+
+/// @brief Adds or updates a lease.
+///
+/// @param existing The lease in the lease database, possibly null.
+/// @param lease The received lease.
+/// @tparam LeasePtrType One of the @c Lease4Ptr or @c Lease6Ptr.
+template<typename LeasePtrType>
+void
+addOrUpdate(const LeasePtrType& existing, const LeasePtrType& lease) {
+    LeaseMgr& lease_mgr = LeaseMgrFactory::instance();
+    if (!existing) {
+        if (!lease_mgr.addLease(lease)) {
+            isc_throw(isc::db::DuplicateEntry, "lost race between calls to get"
+                      " and add");
+        }
+
+    } else {
+        // Some database backends reject operations on the lease if the
+        // current expiration time does not match what is stored.
+        Lease::syncCurrentExpirationTime(*existing, *lease);
+        try {
+            updateLease(lease);
+        } catch (const NoSuchLease&) {
+            isc_throw(isc::InvalidOperation, "failed to update the lease with"
+                      " address " << lease->addr_ << " either because the lease"
+                      " has been deleted or it has changed in the database");
+        }
+    }
+    updateStats(existing, lease);
+}
+
+}
+
+namespace isc {
+namespace ha {
+
+void
+ReplicationSocketCallback::operator()(boost::system::error_code ec, size_t length) {
+    if (ec.value() == boost::asio::error::operation_aborted) {
+        return;
+    }
+    callback_(ec, length);
+}
+
+LeaseReplicationClient::LeaseReplicationClient(IOService& io_service,
+                                               const IOAddress& address,
+                                               const uint16_t port,
+                                               const TlsContextPtr& tls_context,
+                                               const long request_timeout)
+    : io_service_(io_service), address_(address), port_(port),
+      tls_context_(tls_context), request_timeout_(request_timeout), mutex_(),
+      tcp_socket_(), tls_socket_(), timer_(io_service), connection_(0),
+      connecting_(false), connected_(false), writing_(false), sequence_(0),
+      pending_(), output_(0), write_buf_(), read_buf_(), input_() {
+}
+
+LeaseReplicationClient::~LeaseReplicationClient() {
+    timer_.cancel();
+    if (tcp_socket_) {
+        tcp_socket_->close();
+    }
+    if (tls_socket_) {
+        tls_socket_->close();
+    }
+}
+
+void
+LeaseReplicationClient::asyncSendLease(const LeaseReplicationCodec::MessageType type,
+                                       const Lease4& lease,
+                                       const CompleteHandler& handler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t sequence = sequence_++;
+    LeaseReplicationCodec::encodeLease4(output_, type, sequence, lease);
+    queueMessage(sequence, handler);
+}
+
+void
+LeaseReplicationClient::asyncSendLease(const LeaseReplicationCodec::MessageType type,
+                                       const Lease6& lease,
+                                       const CompleteHandler& handler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t sequence = sequence_++;
+    LeaseReplicationCodec::encodeLease6(output_, type, sequence, lease);
+    queueMessage(sequence, handler);
+}
+
+void
+LeaseReplicationClient::queueMessage(const uint32_t sequence,
+                                     const CompleteHandler& handler) {
+    PendingUpdate update = { sequence, handler };
+    pending_.push_back(update);
+
+    if (connected_) {
+        // Start the timer for the first update waiting for an acknowledgment.
+        if (pending_.size() == 1) {
+            boost::weak_ptr<LeaseReplicationClient> weak_client(shared_from_this());
+            uint64_t connection = connection_;
+            timer_.setup([weak_client, connection]() {
+                LeaseReplicationClientPtr client = weak_client.lock();
+                if (client) {
+                    client->timeoutCallback(connection);
+                }
+            }, request_timeout_, IntervalTimer::ONE_SHOT);
+        }
+        doWrite();
+
+    } else if (!connecting_) {
+        connect();
+    }
+}
+
+void
+LeaseReplicationClient::connect() {
+    ++connection_;
+    connecting_ = true;
+    input_.clear();
+    write_buf_.clear();
+    writing_ = false;
+
+    // Open a fresh socket for each connection.
+    if (!tls_context_) {
+        tcp_socket_.reset(new TCPSocket<ReplicationSocketCallback>(io_service_));
+    } else {
+        tls_socket_.reset(new TLSSocket<ReplicationSocketCallback>(io_service_,
+                                                                   tls_context_));
+    }
+
+    ReplicationSocketCallback cb(std::bind(&LeaseReplicationClient::connectCallback,
+                                           shared_from_this(), connection_,
+                                           ph::_1)); // error_code
+    TCPEndpoint endpoint(address_, port_);
+    if (tcp_socket_) {
+        tcp_socket_->open(&endpoint, cb);
+    } else {
+        tls_socket_->open(&endpoint, cb);
+    }
+
+    // The timer also limits the time to establish the connection.
+    boost::weak_ptr<LeaseReplicationClient> weak_client(shared_from_this());
+    uint64_t connection = connection_;
+    timer_.setup([weak_client, connection]() {
+        LeaseReplicationClientPtr client = weak_client.lock();
+        if (client) {
+            client->timeoutCallback(connection);
+        }
+    }, request_timeout_, IntervalTimer::ONE_SHOT);
+}
+
+void
+LeaseReplicationClient::connectCallback(const uint64_t connection,
+                                        const boost::system::error_code& ec) {
+    std::vector<CompleteHandler> failed;
+    std::string error;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (connection != connection_) {
+            return;
+        }
+        if (ec && (ec.value() != boost::asio::error::in_progress) &&
+            (ec.value() != boost::asio::error::already_connected)) {
+            error = ec.message();
+            failInternal(error, failed);
+
+        } else if (tls_socket_) {
+            ReplicationSocketCallback cb(std::bind(&LeaseReplicationClient::handshakeCallback,
+                                                   shared_from_this(), connection,
+                                                   ph::_1)); // error_code
+            tls_socket_->handshake(cb);
+            return;
+
+        } else {
+            connecting_ = false;
+            connected_ = true;
+            doRead();
+            doWrite();
+        }
+    }
+    invokeFailed(error, failed);
+}
+
+void
+LeaseReplicationClient::handshakeCallback(const uint64_t connection,
+                                          const boost::system::error_code& ec) {
+    std::vector<CompleteHandler> failed;
+    std::string error;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (connection != connection_) {
+            return;
+        }
+        if (ec) {
+            error = ec.message();
+            failInternal(error, failed);
+
+        } else {
+            connecting_ = false;
+            connected_ = true;
+            doRead();
+            doWrite();
+        }
+    }
+    invokeFailed(error, failed);
+}
+
+void
+LeaseReplicationClient::doWrite() {
+    if (writing_ || (output_.getLength() == 0)) {
+        return;
+    }
+
+    // Write all the queued messages at once.
+    const uint8_t* data = static_cast<const uint8_t*>(output_.getData());
+    write_buf_.assign(data, data + output_.getLength());
+    output_.clear();
+    writing_ = true;
+    asyncSend();
+}
+
+void
+LeaseReplicationClient::asyncSend() {
+    ReplicationSocketCallback cb(std::bind(&LeaseReplicationClient::writeCallback,
+                                           shared_from_this(), connection_,
+                                           ph::_1,   // error_code
+                                           ph::_2)); // length
+    try {
+        if (tcp_socket_) {
+            tcp_socket_->asyncSend(&write_buf_[0], write_buf_.size(), cb);
+        } else {
+            tls_socket_->asyncSend(&write_buf_[0], write_buf_.size(), cb);
+        }
+    } catch (const std::exception& ex) {
+        postError(ex.what());
+    }
+}
+
+void
+LeaseReplicationClient::doRead() {
+    TCPEndpoint endpoint;
+    ReplicationSocketCallback cb(std::bind(&LeaseReplicationClient::readCallback,
+                                           shared_from_this(), connection_,
+                                           ph::_1,   // error_code
+                                           ph::_2)); // length
+    try {
+        if (tcp_socket_) {
+            tcp_socket_->asyncReceive(&read_buf_[0], read_buf_.size(), 0, &endpoint, cb);
+        } else {
+            tls_socket_->asyncReceive(&read_buf_[0], read_buf_.size(), 0, &endpoint, cb);
+        }
+    } catch (const std::exception& ex) {
+        postError(ex.what());
+    }
+}
+
+void
+LeaseReplicationClient::postError(const std::string& error) {
+    boost::weak_ptr<LeaseReplicationClient> weak_client(shared_from_this());
+    uint64_t connection = connection_;
+    io_service_.post([weak_client, connection, error]() {
+        LeaseReplicationClientPtr client = weak_client.lock();
+        if (client) {
+            client->errorCallback(connection, error);
+        }
+    });
+}
+
+void
+LeaseReplicationClient::writeCallback(const uint64_t connection,
+                                      const boost::system::error_code& ec,
+                                      size_t length) {
+    std::vector<CompleteHandler> failed;
+    std::string error;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (connection != connection_) {
+            return;
+        }
+        if (ec) {
+            error = ec.message();
+            failInternal(error, failed);
+
+        } else if (length < write_buf_.size()) {
+            // Partial write: send the remaining data first.
+            write_buf_.erase(write_buf_.begin(), write_buf_.begin() + length);
+            asyncSend();
+
+        } else {
+            writing_ = false;
+            write_buf_.clear();
+            doWrite();
+        }
+    }
+    invokeFailed(error, failed);
+}
+
+void
+LeaseReplicationClient::readCallback(const uint64_t connection,
+                                     const boost::system::error_code& ec,
+                                     size_t length) {
+    // Handlers of the acknowledged updates.
+    struct Completed {
+        CompleteHandler handler_;
+        LeaseReplicationCodec::Status status_;
+        std::string text_;
+    };
+    std::vector<Completed> completed;
+    std::vector<CompleteHandler> failed;
+    std::string error;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (connection != connection_) {
+            return;
+        }
+        if (ec) {
+            error = (ec.value() == boost::asio::error::eof ?
+                     std::string("connection closed by peer") : ec.message());
+            failInternal(error, failed);
+
+        } else {
+            input_.insert(input_.end(), read_buf_.begin(), read_buf_.begin() + length);
+            try {
+                size_t offset = 0;
+                size_t msg_length;
+                while ((msg_length = LeaseReplicationCodec::getMessageLength(input_.data() + offset,
+                                                                              input_.size() - offset)) > 0) {
+                    InputBuffer buf(input_.data() + offset, msg_length);
+                    offset += msg_length;
+                    LeaseReplicationCodec::MessageType type;
+                    uint32_t sequence;
+                    LeaseReplicationCodec::decodeHeader(buf, type, sequence);
+                    if ((type != LeaseReplicationCodec::ACK) || pending_.empty() ||
+                        (pending_.front().sequence_ != sequence)) {
+                        isc_throw(LeaseReplicationError, "unexpected lease replication"
+                                  " message with sequence number " << sequence);
+                    }
+                    Completed done;
+                    done.handler_ = pending_.front().handler_;
+                    done.status_ = LeaseReplicationCodec::decodeAck(buf, done.text_);
+                    completed.push_back(done);
+                    pending_.pop_front();
+                }
+                input_.erase(input_.begin(), input_.begin() + offset);
+
+                // Restart the timer for the next update, if any.
+                if (pending_.empty()) {
+                    timer_.cancel();
+
+                } else if (!completed.empty()) {
+                    boost::weak_ptr<LeaseReplicationClient> weak_client(shared_from_this());
+                    timer_.setup([weak_client, connection]() {
+                        LeaseReplicationClientPtr client = weak_client.lock();
+                        if (client) {
+                            client->timeoutCallback(connection);
+                        }
+                    }, request_timeout_, IntervalTimer::ONE_SHOT);
+                }
+                doRead();
+
+            } catch (const std::exception& ex) {
+                error = ex.what();
+                failInternal(error, failed);
+            }
+        }
+    }
+
+    for (auto const& done : completed) {
+        done.handler_("", done.status_, done.text_);
+    }
+    invokeFailed(error, failed);
+}
+
+void
+LeaseReplicationClient::timeoutCallback(const uint64_t connection) {
+    std::vector<CompleteHandler> failed;
+    std::string error("timeout waiting for the lease replication acknowledgment");
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if ((connection != connection_) || (!connecting_ && pending_.empty())) {
+            return;
+        }
+        failInternal(error, failed);
+    }
+    invokeFailed(error, failed);
+}
+
+void
+LeaseReplicationClient::errorCallback(const uint64_t connection,
+                                      const std::string& error) {
+    std::vector<CompleteHandler> failed;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (connection != connection_) {
+            return;
+        }
+        failInternal(error, failed);
+    }
+    invokeFailed(error, failed);
+}
+
+void
+LeaseReplicationClient::close() {
+    std::vector<CompleteHandler> failed;
+    std::string error("lease replication connection closed");
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        failInternal(error, failed);
+    }
+    invokeFailed(error, failed);
+}
+
+size_t
+LeaseReplicationClient::getPendingCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (pending_.size());
+}
+
+void
+LeaseReplicationClient::failInternal(const std::string&,
+                                     std::vector<CompleteHandler>& failed) {
+    for (auto const& update : pending_) {
+        failed.push_back(update.handler_);
+    }
+    pending_.clear();
+    output_.clear();
+    write_buf_.clear();
+    input_.clear();
+    writing_ = false;
+    connecting_ = false;
+    connected_ = false;
+    // Ignore the callbacks of the closed connection.
+    ++connection_;
+    timer_.cancel();
+    if (tcp_socket_) {
+        tcp_socket_->close();
+    }
+    if (tls_socket_) {
+        tls_socket_->close();
+    }
+}
+
+void
+LeaseReplicationClient::invokeFailed(const std::string& error,
+                                     const std::vector<CompleteHandler>& failed) {
+    for (auto const& handler : failed) {
+        handler(error, LeaseReplicationCodec::STATUS_ERROR, "");
+    }
+}
+
+/// @brief Connection accepted by the lease replication listener.
+///
+/// The received updates are applied in order and the acknowledgments
+/// are written as they are produced. The reads and the writes can be
+/// in progress at the same time, possibly in different threads of the
+/// listener, so the session state is protected by a mutex.
+class LeaseReplicationSession :
+        public boost::enable_shared_from_this<LeaseReplicationSession> {
+public:
+
+    /// @brief Constructor.
+    ///
+    /// @param listener The listener which accepted the connection.
+    LeaseReplicationSession(LeaseReplicationListener& listener)
+        : listener_(listener), mutex_(), tcp_socket_(), tls_socket_(),
+          closed_(false), writing_(false), read_buf_(), input_(), output_(0),
+          write_buf_() {
+        if (!listener.tls_context_) {
+            tcp_socket_.reset(new TCPSocket<ReplicationSocketCallback>(*listener.thread_io_service_));
+        } else {
+            tls_socket_.reset(new TLSSocket<ReplicationSocketCallback>(*listener.thread_io_service_,
+                                                                       listener.tls_context_));
+        }
+    }
+
+    /// @brief Starts accepting a connection.
+    void asyncAccept() {
+        LeaseReplicationListener::AcceptorCallback cb =
+            std::bind(&LeaseReplicationSession::acceptCallback,
+                      shared_from_this(), ph::_1);
+        if (tcp_socket_) {
+            listener_.acceptor_->asyncAccept(*tcp_socket_, cb);
+        } else {
+            boost::shared_ptr<TLSAcceptor<LeaseReplicationListener::AcceptorCallback> >
+                tls_acceptor = boost::dynamic_pointer_cast<
+                    TLSAcceptor<LeaseReplicationListener::AcceptorCallback> >(listener_.acceptor_);
+            tls_acceptor->asyncAccept(*tls_socket_, cb);
+        }
+    }
+
+    /// @brief Closes the connection.
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closeInternal();
+    }
+
+private:
+
+    /// @brief Closes the connection, must be called with the mutex held.
+    void closeInternal() {
+        closed_ = true;
+        if (tcp_socket_) {
+            tcp_socket_->close();
+        }
+        if (tls_socket_) {
+            tls_socket_->close();
+        }
+    }
+
+    /// @brief Closes the connection and removes the session.
+    ///
+    /// @param error Error text, empty when the peer closed the connection.
+    void terminate(const std::string& error) {
+        if (!error.empty()) {
+            LOG_DEBUG(ha_logger, DBGLVL_TRACE_BASIC, HA_LEASE_REPLICATION_SESSION_FAILED)
+                .arg(error);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closeInternal();
+        }
+        listener_.removeSession(shared_from_this());
+    }
+
+    /// @brief Callback invoked when the connection is accepted.
+    ///
+    /// @param ec Error code.
+    void acceptCallback(const boost::system::error_code& ec) {
+        if (ec.value() == boost::asio::error::operation_aborted) {
+            listener_.removeSession(shared_from_this());
+            return;
+        }
+
+        // Accept the next connection.
+        listener_.accept();
+
+        if (ec) {
+            terminate(ec.message());
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return;
+        }
+        if (tls_socket_) {
+            ReplicationSocketCallback cb(std::bind(&LeaseReplicationSession::handshakeCallback,
+                                                   shared_from_this(), ph::_1));
+            tls_socket_->handshake(cb);
+        } else {
+            doRead();
+        }
+    }
+
+    /// @brief Callback invoked when the TLS handshake is performed.
+    ///
+    /// @param ec Error code.
+    void handshakeCallback(const boost::system::error_code& ec) {
+        if (ec) {
+            terminate(ec.message());
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!closed_) {
+            doRead();
+        }
+    }
+
+    /// @brief Starts reading, must be called with the mutex held.
+    void doRead() {
+        TCPEndpoint endpoint;
+        ReplicationSocketCallback cb(std::bind(&LeaseReplicationSession::readCallback,
+                                               shared_from_this(),
+                                               ph::_1,   // error_code
+                                               ph::_2)); // length
+        try {
+            if (tcp_socket_) {
+                tcp_socket_->asyncReceive(&read_buf_[0], read_buf_.size(), 0, &endpoint, cb);
+            } else {
+                tls_socket_->asyncReceive(&read_buf_[0], read_buf_.size(), 0, &endpoint, cb);
+            }
+        } catch (const std::exception&) {
+            closeInternal();
+            listener_.removeSession(shared_from_this());
+        }
+    }
+
+    /// @brief Callback invoked when data were read.
+    ///
+    /// The complete messages are processed in order. The reads are not
+    /// concurrent so the input buffer is only used by this callback.
+    ///
+    /// @param ec Error code.
+    /// @param length Length of the read data.
+    void readCallback(const boost::system::error_code& ec, size_t length) {
+        if (ec) {
+            terminate(ec.value() == boost::asio::error::eof ? "" : ec.message());
+            return;
+        }
+
+        input_.insert(input_.end(), read_buf_.begin(), read_buf_.begin() + length);
+        OutputBuffer acks(0);
+        try {
+            size_t offset = 0;
+            size_t msg_length;
+            while ((msg_length = LeaseReplicationCodec::getMessageLength(input_.data() + offset,
+                                                                          input_.size() - offset)) > 0) {
+                InputBuffer buf(input_.data() + offset, msg_length);
+                offset += msg_length;
+                LeaseReplicationCodec::MessageType type;
+                uint32_t sequence;
+                LeaseReplicationCodec::decodeHeader(buf, type, sequence);
+                std::string text;
+                LeaseReplicationCodec::Status status =
+                    LeaseReplicationListener::processUpdate(type, buf, text);
+                LeaseReplicationCodec::encodeAck(acks, sequence, status, text);
+            }
+            input_.erase(input_.begin(), input_.begin() + offset);
+
+        } catch (const std::exception& ex) {
+            terminate(ex.what());
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return;
+        }
+        if (acks.getLength() > 0) {
+            output_.writeData(acks.getData(), acks.getLength());
+            doWrite();
+        }
+        doRead();
+    }
+
+    /// @brief Starts writing the acknowledgments, must be called with the
+    /// mutex held.
+    void doWrite() {
+        if (writing_ || (output_.getLength() == 0)) {
+            return;
+        }
+        const uint8_t* data = static_cast<const uint8_t*>(output_.getData());
+        write_buf_.assign(data, data + output_.getLength());
+        output_.clear();
+        writing_ = true;
+        asyncSend();
+    }
+
+    /// @brief Sends the write buffer, must be called with the mutex held.
+    void asyncSend() {
+        ReplicationSocketCallback cb(std::bind(&LeaseReplicationSession::writeCallback,
+                                               shared_from_this(),
+                                               ph::_1,   // error_code
+                                               ph::_2)); // length
+        try {
+            if (tcp_socket_) {
+                tcp_socket_->asyncSend(&write_buf_[0], write_buf_.size(), cb);
+            } else {
+                tls_socket_->asyncSend(&write_buf_[0], write_buf_.size(), cb);
+            }
+        } catch (const std::exception&) {
+            closeInternal();
+            listener_.removeSession(shared_from_this());
+        }
+    }
+
+    /// @brief Callback invoked when data were written.
+    ///
+    /// @param ec Error code.
+    /// @param length Length of the written data.
+    void writeCallback(const boost::system::error_code& ec, size_t length) {
+        if (ec) {
+            terminate(ec.message());
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closed_) {
+            return;
+        }
+        if (length < write_buf_.size()) {
+            write_buf_.erase(write_buf_.begin(), write_buf_.begin() + length);
+            asyncSend();
+            return;
+        }
+        writing_ = false;
+        write_buf_.clear();
+        doWrite();
+    }
+
+    /// @brief The listener which accepted the connection.
+    LeaseReplicationListener& listener_;
+
+    /// @brief Protects the session state.
+    std::mutex mutex_;
+
+    /// @brief TCP socket.
+    std::unique_ptr<TCPSocket<ReplicationSocketCallback> > tcp_socket_;
+
+    /// @brief TLS socket.
+    std::unique_ptr<TLSSocket<ReplicationSocketCallback> > tls_socket_;
+
+    /// @brief True when the session is closed.
+    bool closed_;
+
+    /// @brief True when a write is in progress.
+    bool writing_;
+
+    /// @brief Buffer receiving the data.
+    std::array<uint8_t, 16384> read_buf_;
+
+    /// @brief Received data not yet decoded.
+    std::vector<uint8_t> input_;
+
+    /// @brief Acknowledgments not yet written.
+    OutputBuffer output_;
+
+    /// @brief Data being written.
+    std::vector<uint8_t> write_buf_;
+};
+
+LeaseReplicationListener::LeaseReplicationListener(const IOAddress& address,
+                                                   const uint16_t port,
+                                                   const TlsContextPtr& tls_context,
+                                                   const uint16_t thread_pool_size)
+    : address_(address), port_(port), tls_context_(tls_context),
+      thread_pool_size_(thread_pool_size), thread_io_service_(),
+      thread_pool_(), acceptor_(), mutex_(), sessions_() {
+}
+
+LeaseReplicationListener::~LeaseReplicationListener() {
+    stop();
+}
+
+void
+LeaseReplicationListener::start() {
+    // We must be in multi-threading mode.
+    if (!MultiThreadingMgr::instance().getMode()) {
+        isc_throw(InvalidOperation, "LeaseReplicationListener cannot be started"
+                  " when multi-threading is disabled");
+    }
+
+    if (thread_io_service_) {
+        isc_throw(InvalidOperation, "LeaseReplicationListener already started");
+    }
+
+    thread_io_service_.reset(new IOService());
+    if (!tls_context_) {
+        acceptor_.reset(new TCPAcceptor<AcceptorCallback>(*thread_io_service_));
+    } else {
+        acceptor_.reset(new TLSAcceptor<AcceptorCallback>(*thread_io_service_));
+    }
+
+    try {
+        TCPEndpoint endpoint(address_, port_);
+        acceptor_->open(endpoint);
+        acceptor_->setOption(TCPAcceptor<AcceptorCallback>::ReuseAddress(true));
+        acceptor_->bind(endpoint);
+        acceptor_->listen();
+
+    } catch (const std::exception& ex) {
+        acceptor_.reset();
+        thread_io_service_.reset();
+        isc_throw(Unexpected, "unable to listen to the lease updates on "
+                  << address_ << " port " << port_ << ": " << ex.what());
+    }
+
+    accept();
+
+    thread_pool_.reset(new HttpThreadPool(thread_io_service_, thread_pool_size_));
+
+    LOG_INFO(ha_logger, HA_LEASE_REPLICATION_LISTENER_STARTED)
+        .arg(address_)
+        .arg(port_)
+        .arg(thread_pool_size_);
+}
+
+void
+LeaseReplicationListener::checkPermissions() {
+    if (thread_pool_) {
+        thread_pool_->checkPausePermissions();
+    }
+}
+
+void
+LeaseReplicationListener::pause() {
+    if (thread_pool_) {
+        thread_pool_->pause();
+    }
+}
+
+void
+LeaseReplicationListener::resume() {
+    if (thread_pool_) {
+        thread_pool_->run();
+    }
+}
+
+void
+LeaseReplicationListener::stop() {
+    if (!thread_io_service_) {
+        return;
+    }
+
+    acceptor_->close();
+    std::set<LeaseReplicationSessionPtr> sessions;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sessions.swap(sessions_);
+    }
+    for (auto const& session : sessions) {
+        session->close();
+    }
+    thread_pool_->stop();
+    thread_pool_.reset();
+    sessions.clear();
+    acceptor_.reset();
+    thread_io_service_.reset();
+}
+
+void
+LeaseReplicationListener::accept() {
+    if (!acceptor_ || !acceptor_->isOpen()) {
+        return;
+    }
+    LeaseReplicationSessionPtr session(new LeaseReplicationSession(*this));
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sessions_.insert(session);
+    }
+    session->asyncAccept();
+}
+
+void
+LeaseReplicationListener::removeSession(const LeaseReplicationSessionPtr& session) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    static_cast<void>(sessions_.erase(session));
+}
+
+LeaseReplicationCodec::Status
+LeaseReplicationListener::processUpdate(const LeaseReplicationCodec::MessageType type,
+                                        InputBuffer& buf, std::string& text) {
+    try {
+        LeaseMgr& lease_mgr = LeaseMgrFactory::instance();
+        switch (type) {
+        case LeaseReplicationCodec::LEASE4_UPDATE: {
+            Lease4Ptr lease = LeaseReplicationCodec::decodeLease4(buf);
+            addOrUpdate(lease_mgr.getLease4(lease->addr_), lease);
+            return (LeaseReplicationCodec::STATUS_SUCCESS);
+        }
+
+        case LeaseReplicationCodec::LEASE4_DELETE: {
+            Lease4Ptr lease = LeaseReplicationCodec::decodeLease4(buf);
+            Lease4Ptr existing = lease_mgr.getLease4(lease->addr_);
+            if (!existing || !lease_mgr.deleteLease(existing)) {
+                text = "IPv4 lease not found.";
+                return (LeaseReplicationCodec::STATUS_EMPTY);
+            }
+            updateStats(existing, Lease4Ptr());
+            return (LeaseReplicationCodec::STATUS_SUCCESS);
+        }
+
+        case LeaseReplicationCodec::LEASE6_UPDATE: {
+            Lease6Ptr lease = LeaseReplicationCodec::decodeLease6(buf);
+            addOrUpdate(lease_mgr.getLease6(lease->type_, lease->addr_), lease);
+            return (LeaseReplicationCodec::STATUS_SUCCESS);
+        }
+
+        case LeaseReplicationCodec::LEASE6_DELETE: {
+            Lease6Ptr lease = LeaseReplicationCodec::decodeLease6(buf);
+            Lease6Ptr existing = lease_mgr.getLease6(lease->type_, lease->addr_);
+            if (!existing || !lease_mgr.deleteLease(existing)) {
+                text = "IPv6 lease not found.";
+                return (LeaseReplicationCodec::STATUS_EMPTY);
+            }
+            updateStats(existing, Lease6Ptr());
+            return (LeaseReplicationCodec::STATUS_SUCCESS);
+        }
+
+        default:
+            text = "unexpected lease replication message";
+        }
+
+    } catch (const std::exception& ex) {
+        text = ex.what();
+    }
+    return (LeaseReplicationCodec::STATUS_ERROR);
+}
+
+} // end of namespace isc::ha
+} // end of namespace isc
@@ -0,0 +1,420 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef HA_LEASE_REPLICATION_CHANNEL_H
+#define HA_LEASE_REPLICATION_CHANNEL_H
+
+#include <lease_replication.h>
+#include <asiolink/asio_wrapper.h>
+#include <asiolink/interval_timer.h>
+#include <asiolink/io_address.h>
+#include <asiolink/io_service.h>
+#include <asiolink/tcp_socket.h>
+#include <asiolink/tls_acceptor.h>
+#include <asiolink/tls_socket.h>
+#include <dhcpsrv/lease.h>
+#include <http/http_thread_pool.h>
+#include <boost/enable_shared_from_this.hpp>
+#include <boost/shared_ptr.hpp>
+#include <array>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace isc {
+namespace ha {
+
+/// @brief Callback invoked by the sockets of the lease replication channel.
+///
+/// The operations aborted because the socket was closed are ignored.
+class ReplicationSocketCallback {
+public:
+
+    /// @brief Type of the wrapped function.
+    typedef std::function<void(boost::system::error_code ec, size_t length)>
+    Function;
+
+    /// @brief Constructor.
+    ///
+    /// @param callback Function invoked when the operation completes.
+    ReplicationSocketCallback(const Function& callback)
+        : callback_(callback) {
+    }
+
+    /// @brief Operator called when the socket operation completes.
+    ///
+    /// @param ec Error code.
+    /// @param length Length of the transferred data.
+    void operator()(boost::system::error_code ec, size_t length = 0);
+
+private:
+
+    /// @brief Wrapped function.
+    Function callback_;
+};
+
+/// @brief Client side of the lease replication channel.
+///
+/// It maintains a long-lived connection to the lease replication listener
+/// of an HA peer, opened on the first update and after a failure. The
+/// updates are sent without waiting for the acknowledgments of the
+/// previous ones, the acknowledgments are expected in order. When the
+/// connection fails or when no acknowledgment is received within the
+/// request timeout all the updates which were not acknowledged are
+/// failed and the connection is closed.
+///
+/// The client runs on the IO service it is given, possibly driven by a
+/// thread pool: the methods are thread safe and the completion handlers
+/// are invoked without holding the client lock.
+class LeaseReplicationClient :
+        public boost::enable_shared_from_this<LeaseReplicationClient> {
+public:
+
+    /// @brief Handler invoked when an update completes.
+    ///
+    /// The first argument is the error text, empty unless the update
+    /// could not be delivered. The second argument is the status of the
+    /// update and the third the error text returned by the peer.
+    typedef std::function<void(const std::string&,
+                               const LeaseReplicationCodec::Status,
+                               const std::string&)> CompleteHandler;
+
+    /// @brief Constructor.
+    ///
+    /// @param io_service IO service running the client.
+    /// @param address Address of the peer's lease replication listener.
+    /// @param port Port of the peer's lease replication listener.
+    /// @param tls_context TLS context, null when TLS is not used.
+    /// @param request_timeout Maximum time to wait for an acknowledgment
+    /// in milliseconds.
+    LeaseReplicationClient(asiolink::IOService& io_service,
+                           const asiolink::IOAddress& address,
+                           const uint16_t port,
+                           const asiolink::TlsContextPtr& tls_context,
+                           const long request_timeout);
+
+    /// @brief Destructor.
+    ~LeaseReplicationClient();
+
+    /// @brief Sends a DHCPv4 lease update or delete.
+    ///
+    /// @param type One of the @c LEASE4_UPDATE or @c LEASE4_DELETE.
+    /// @param lease The lease.
+    /// @param handler Handler invoked when the update completes.
+    void asyncSendLease(const LeaseReplicationCodec::MessageType type,
+                        const dhcp::Lease4& lease, const CompleteHandler& handler);
+
+    /// @brief Sends a DHCPv6 lease update or delete.
+    ///
+    /// @param type One of the @c LEASE6_UPDATE or @c LEASE6_DELETE.
+    /// @param lease The lease.
+    /// @param handler Handler invoked when the update completes.
+    void asyncSendLease(const LeaseReplicationCodec::MessageType type,
+                        const dhcp::Lease6& lease, const CompleteHandler& handler);
+
+    /// @brief Closes the connection.
+    ///
+    /// The updates which were not acknowledged are failed.
+    void close();
+
+    /// @brief Returns the number of updates which were not acknowledged.
+    size_t getPendingCount();
+
+private:
+
+    /// @brief Update waiting for an acknowledgment.
+    struct PendingUpdate {
+        /// @brief Sequence number of the update message.
+        uint32_t sequence_;
+
+        /// @brief Handler invoked when the update completes.
+        CompleteHandler handler_;
+    };
+
+    /// @brief Queues an encoded message and starts sending it.
+    ///
+    /// Must be called with the mutex held.
+    ///
+    /// @param sequence Sequence number of the message.
+    /// @param handler Handler invoked when the update completes.
+    void queueMessage(const uint32_t sequence, const CompleteHandler& handler);
+
+    /// @brief Opens a new connection.
+    ///
+    /// Must be called with the mutex held.
+    void connect();
+
+    /// @brief Starts writing the queued messages.
+    ///
+    /// Must be called with the mutex held.
+    void doWrite();
+
+    /// @brief Sends the data being written.
+    ///
+    /// Must be called with the mutex held.
+    void asyncSend();
+
+    /// @brief Starts reading the acknowledgments.
+    ///
+    /// Must be called with the mutex held.
+    void doRead();
+
+    /// @brief Callback invoked when the connection is established.
+    ///
+    /// @param connection Identifier of the connection.
+    /// @param ec Error code.
+    void connectCallback(const uint64_t connection,
+                         const boost::system::error_code& ec);
+
+    /// @brief Callback invoked when the TLS handshake is performed.
+    ///
+    /// @param connection Identifier of the connection.
+    /// @param ec Error code.
+    void handshakeCallback(const uint64_t connection,
+                           const boost::system::error_code& ec);
+
+    /// @brief Callback invoked when data were written.
+    ///
+    /// @param connection Identifier of the connection.
+    /// @param ec Error code.
+    /// @param length Length of the written data.
+    void writeCallback(const uint64_t connection,
+                       const boost::system::error_code& ec, size_t length);
+
+    /// @brief Callback invoked when data were read.
+    ///
+    /// @param connection Identifier of the connection.
+    /// @param ec Error code.
+    /// @param length Length of the read data.
+    void readCallback(const uint64_t connection,
+                      const boost::system::error_code& ec, size_t length);
+
+    /// @brief Callback invoked when the request timer expires.
+    ///
+    /// @param connection Identifier of the connection.
+    void timeoutCallback(const uint64_t connection);
+
+    /// @brief Callback invoked when a socket operation could not be started.
+    ///
+    /// @param connection Identifier of the connection.
+    /// @param error Error text.
+    void errorCallback(const uint64_t connection, const std::string& error);
+
+    /// @brief Schedules the failure of the current connection.
+    ///
+    /// Must be called with the mutex held. The failure is processed by
+    /// the IO service, when the mutex is no longer held.
+    ///
+    /// @param error Error text.
+    void postError(const std::string& error);
+
+    /// @brief Fails the pending updates and closes the connection.
+    ///
+    /// Must be called with the mutex held. The handlers are appended to
+    /// the list of handlers to invoke when the mutex is released.
+    ///
+    /// @param error Error text.
+    /// @param [out] failed Handlers to invoke with the error.
+    void failInternal(const std::string& error,
+                      std::vector<CompleteHandler>& failed);
+
+    /// @brief Invokes the handlers of failed updates.
+    ///
+    /// @param error Error text.
+    /// @param failed Handlers to invoke.
+    static void invokeFailed(const std::string& error,
+                             const std::vector<CompleteHandler>& failed);
+
+    /// @brief IO service running the client.
+    asiolink::IOService& io_service_;
+
+    /// @brief Address of the peer's listener.
+    asiolink::IOAddress address_;
+
+    /// @brief Port of the peer's listener.
+    uint16_t port_;
+
+    /// @brief TLS context, null when TLS is not used.
+    asiolink::TlsContextPtr tls_context_;
+
+    /// @brief Maximum time to wait for an acknowledgment.
+    long request_timeout_;
+
+    /// @brief Protects the client state.
+    std::mutex mutex_;
+
+    /// @brief TCP socket of the current connection.
+    std::unique_ptr<asiolink::TCPSocket<ReplicationSocketCallback> > tcp_socket_;
+
+    /// @brief TLS socket of the current connection.
+    std::unique_ptr<asiolink::TLSSocket<ReplicationSocketCallback> > tls_socket_;
+
+    /// @brief Timer detecting missing acknowledgments.
+    asiolink::IntervalTimer timer_;
+
+    /// @brief Identifier of the current connection.
+    ///
+    /// It is incremented when a connection is opened so the callbacks
+    /// of the previous connections are ignored.
+    uint64_t connection_;
+
+    /// @brief True when a connection is being established.
+    bool connecting_;
+
+    /// @brief True when the connection is established.
+    bool connected_;
+
+    /// @brief True when a write is in progress.
+    bool writing_;
+
+    /// @brief Sequence number of the next message.
+    uint32_t sequence_;
+
+    /// @brief Updates waiting for an acknowledgment, in sending order.
+    std::deque<PendingUpdate> pending_;
+
+    /// @brief Encoded messages not yet written.
+    util::OutputBuffer output_;
+
+    /// @brief Data being written.
+    std::vector<uint8_t> write_buf_;
+
+    /// @brief Buffer receiving the data.
+    std::array<uint8_t, 16384> read_buf_;
+
+    /// @brief Received data not yet decoded.
+    std::vector<uint8_t> input_;
+};
+
+/// @brief Pointer to the @c LeaseReplicationClient.
+typedef boost::shared_ptr<LeaseReplicationClient> LeaseReplicationClientPtr;
+
+class LeaseReplicationSession;
+
+/// @brief Pointer to a session of the lease replication listener.
+typedef boost::shared_ptr<LeaseReplicationSession> LeaseReplicationSessionPtr;
+
+/// @brief Server side of the lease replication channel.
+///
+/// It accepts the connections of the HA peers and applies the received
+/// lease updates to the lease database, acknowledging each update in
+/// order. It uses its own IO service driven by a thread pool, so it
+/// requires the multi-threading to be enabled.
+class LeaseReplicationListener {
+public:
+
+    /// @brief Constructor.
+    ///
+    /// @param address Address to listen on.
+    /// @param port Port to listen on.
+    /// @param tls_context TLS context, null when TLS is not used.
+    /// @param thread_pool_size Number of threads driving the listener.
+    LeaseReplicationListener(const asiolink::IOAddress& address,
+                             const uint16_t port,
+                             const asiolink::TlsContextPtr& tls_context,
+                             const uint16_t thread_pool_size = 1);
+
+    /// @brief Destructor.
+    ~LeaseReplicationListener();
+
+    /// @brief Opens the listening socket and starts the thread pool.
+    ///
+    /// @throw InvalidOperation if the multi-threading is disabled or if
+    /// the listener is already started.
+    void start();
+
+    /// @brief Check if the current thread can perform thread pool state
+    /// transition.
+    ///
+    /// @throw MultiThreadingInvalidOperation if the state transition is
+    /// done on any of the worker threads.
+    void checkPermissions();
+
+    /// @brief Pauses the thread pool.
+    void pause();
+
+    /// @brief Resumes the thread pool.
+    void resume();
+
+    /// @brief Closes the connections and stops the thread pool.
+    void stop();
+
+    /// @brief Applies a received lease update to the lease database.
+    ///
+    /// The DHCPv4 and DHCPv6 lease updates create the lease when it does
+    /// not exist and the lease deletes return the @c STATUS_EMPTY status
+    /// when the lease does not exist, as the equivalent lease commands
+    /// do. The lease statistics are updated accordingly.
+    ///
+    /// @param type Message type.
+    /// @param buf Buffer positioned at the message payload.
+    /// @param [out] text Error text.
+    /// @return Status of the update.
+    static LeaseReplicationCodec::Status
+    processUpdate(const LeaseReplicationCodec::MessageType type,
+                  util::InputBuffer& buf, std::string& text);
+
+    /// @brief Returns the IO service of the listener, null when it is
+    /// not started.
+    asiolink::IOServicePtr getThreadIOService() const {
+        return (thread_io_service_);
+    }
+
+private:
+
+    /// @brief Accepts the next connection.
+    void accept();
+
+    /// @brief Removes a closed session.
+    ///
+    /// @param session The session.
+    void removeSession(const LeaseReplicationSessionPtr& session);
+
+    /// @brief Type of the acceptor callback.
+    typedef std::function<void(const boost::system::error_code&)>
+    AcceptorCallback;
+
+    /// @brief Address to listen on.
+    asiolink::IOAddress address_;
+
+    /// @brief Port to listen on.
+    uint16_t port_;
+
+    /// @brief TLS context, null when TLS is not used.
+    asiolink::TlsContextPtr tls_context_;
+
+    /// @brief Number of threads driving the listener.
+    uint16_t thread_pool_size_;
+
+    /// @brief IO service of the listener.
+    asiolink::IOServicePtr thread_io_service_;
+
+    /// @brief Thread pool driving the IO service.
+    http::HttpThreadPoolPtr thread_pool_;
+
+    /// @brief TCP or TLS acceptor.
+    boost::shared_ptr<asiolink::TCPAcceptor<AcceptorCallback> > acceptor_;
+
+    /// @brief Protects the sessions.
+    std::mutex mutex_;
+
+    /// @brief Open sessions.
+    std::set<LeaseReplicationSessionPtr> sessions_;
+
+    friend class LeaseReplicationSession;
+};
+
+/// @brief Pointer to the @c LeaseReplicationListener.
+typedef boost::shared_ptr<LeaseReplicationListener> LeaseReplicationListenerPtr;
+
+} // end of namespace isc::ha
+} // end of namespace isc
+
+#endif // HA_LEASE_REPLICATION_CHANNEL_H
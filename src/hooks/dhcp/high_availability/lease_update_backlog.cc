@@ -6,16 +6,36 @@
 
 #include <config.h>
 
+#include <ha_log.h>
+#include <lease_replication.h>
 #include <lease_update_backlog.h>
+#include <util/buffer.h>
 #include <util/multi_threading_mgr.h>
+#include <boost/pointer_cast.hpp>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <vector>
 
+using namespace isc::asiolink;
 using namespace isc::dhcp;
+using namespace isc::util;
 
 namespace isc {
 namespace ha {
 
-LeaseUpdateBacklog::LeaseUpdateBacklog(const size_t limit)
-    : limit_(limit), overflown_(false), outstanding_updates_() {
+LeaseUpdateBacklog::LeaseUpdateBacklog(const size_t limit, const std::string& spill_file,
+                                       const uint64_t spill_max_size)
+    : limit_(limit), overflown_(false), outstanding_updates_(),
+      spill_file_(spill_file), spill_max_size_(spill_max_size), spill_stream_(),
+      spill_read_pos_(0), spill_write_pos_(0), spilled_(0) {
+}
+
+LeaseUpdateBacklog::~LeaseUpdateBacklog() {
+    if (spill_stream_.is_open()) {
+        spill_stream_.close();
+        static_cast<void>(std::remove(spill_file_.c_str()));
+    }
 }
 
 bool
@@ -49,41 +69,216 @@ void
 LeaseUpdateBacklog::clear() {
     if (util::MultiThreadingMgr::instance().getMode()) {
         std::lock_guard<std::mutex> lock(mutex_);
-        outstanding_updates_.clear();
-        overflown_ = false;
+        clearInternal();
+    } else {
+        clearInternal();
     }
-    outstanding_updates_.clear();
-    overflown_ = false;
 }
 
 size_t
 LeaseUpdateBacklog::size() {
     if (util::MultiThreadingMgr::instance().getMode()) {
         std::lock_guard<std::mutex> lock(mutex_);
-        return (outstanding_updates_.size());
+        return (outstanding_updates_.size() + spilled_);
     }
-    return (outstanding_updates_.size());
+    return (outstanding_updates_.size() + spilled_);
+}
+
+size_t
+LeaseUpdateBacklog::spilledSize() {
+    if (util::MultiThreadingMgr::instance().getMode()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return (spilled_);
+    }
+    return (spilled_);
 }
 
 bool
 LeaseUpdateBacklog::pushInternal(const LeaseUpdateBacklog::OpType op_type, const LeasePtr& lease) {
-    if (outstanding_updates_.size() >= limit_) {
-        overflown_ = true;
-        return (false);
+    Lease6Ptr lease6 = boost::dynamic_pointer_cast<Lease6>(lease);
+    Update update = { lease6 ? lease6->type_ : Lease::TYPE_V4, lease->addr_,
+                      op_type, lease };
+
+    // Replace the previous update of the lease, if any.
+    auto& index = outstanding_updates_.get<1>();
+    auto existing = index.find(boost::make_tuple(update.type_, update.address_));
+    if (existing != index.end()) {
+        outstanding_updates_.erase(outstanding_updates_.project<0>(existing));
+
+    } else if (outstanding_updates_.size() >= limit_) {
+        // Make room by moving the queued updates to the spill file. Once
+        // overflown, the backlog is useless so it is not spilled again.
+        if (spill_file_.empty() || overflown_ || outstanding_updates_.empty() ||
+            !spill()) {
+            overflown_ = true;
+            return (false);
+        }
     }
-    outstanding_updates_.push_back(std::make_pair(op_type, lease));
+    outstanding_updates_.push_back(update);
     return (true);
 }
 
 LeasePtr
 LeaseUpdateBacklog::popInternal(LeaseUpdateBacklog::OpType& op_type) {
+    // The spilled updates are older than the queued ones.
+    if (spilled_ > 0) {
+        LeasePtr lease = unspill(op_type);
+        if (lease) {
+            return (lease);
+        }
+    }
     if (outstanding_updates_.empty()) {
         return (LeasePtr());
     }
     auto item = outstanding_updates_.front();
     outstanding_updates_.pop_front();
-    op_type = item.first;
-    return (item.second);
+    op_type = item.op_type_;
+    return (item.lease_);
+}
+
+void
+LeaseUpdateBacklog::clearInternal() {
+    outstanding_updates_.clear();
+    if (spilled_ > 0) {
+        resetSpillFile();
+    }
+    overflown_ = false;
+}
+
+bool
+LeaseUpdateBacklog::spill() {
+    if (!spill_stream_.is_open()) {
+        resetSpillFile();
+        if (!spill_stream_.is_open()) {
+            LOG_WARN(ha_logger, HA_LEASES_BACKLOG_SPILL_FAILED)
+                .arg(spill_file_)
+                .arg(strerror(errno));
+            return (false);
+        }
+    }
+
+    // Lease updates are stored in the format of the lease replication
+    // messages.
+    OutputBuffer buf(0);
+    try {
+        for (auto const& update : outstanding_updates_) {
+            if (update.type_ == Lease::TYPE_V4) {
+                LeaseReplicationCodec::encodeLease4(buf, update.op_type_ == ADD ?
+                                                    LeaseReplicationCodec::LEASE4_UPDATE :
+                                                    LeaseReplicationCodec::LEASE4_DELETE,
+                                                    0, *boost::dynamic_pointer_cast<Lease4>(update.lease_));
+            } else {
+                LeaseReplicationCodec::encodeLease6(buf, update.op_type_ == ADD ?
+                                                    LeaseReplicationCodec::LEASE6_UPDATE :
+                                                    LeaseReplicationCodec::LEASE6_DELETE,
+                                                    0, *boost::dynamic_pointer_cast<Lease6>(update.lease_));
+            }
+        }
+    } catch (const std::exception& ex) {
+        LOG_WARN(ha_logger, HA_LEASES_BACKLOG_SPILL_FAILED)
+            .arg(spill_file_)
+            .arg(ex.what());
+        return (false);
+    }
+
+    // Do not let the spill file grow without bound.
+    if ((spill_max_size_ > 0) &&
+        (static_cast<uint64_t>(spill_write_pos_) + buf.getLength() > spill_max_size_)) {
+        LOG_WARN(ha_logger, HA_LEASES_BACKLOG_SPILL_FILE_FULL)
+            .arg(spill_file_)
+            .arg(spill_max_size_);
+        return (false);
+    }
+
+    spill_stream_.clear();
+    spill_stream_.seekp(spill_write_pos_);
+    spill_stream_.write(static_cast<const char*>(buf.getData()), buf.getLength());
+    spill_stream_.flush();
+    if (!spill_stream_.good()) {
+        LOG_WARN(ha_logger, HA_LEASES_BACKLOG_SPILL_FAILED)
+            .arg(spill_file_)
+            .arg(strerror(errno));
+        spill_stream_.clear();
+        return (false);
+    }
+
+    LOG_DEBUG(ha_logger, log::DBGLVL_TRACE_BASIC, HA_LEASES_BACKLOG_SPILLED)
+        .arg(outstanding_updates_.size())
+        .arg(spill_file_);
+
+    spill_write_pos_ += buf.getLength();
+    spilled_ += outstanding_updates_.size();
+    outstanding_updates_.clear();
+    return (true);
+}
+
+LeasePtr
+LeaseUpdateBacklog::unspill(LeaseUpdateBacklog::OpType& op_type) {
+    try {
+        spill_stream_.clear();
+        spill_stream_.seekg(spill_read_pos_);
+        std::vector<uint8_t> data(sizeof(uint32_t));
+        if (!spill_stream_.read(reinterpret_cast<char*>(&data[0]), data.size())) {
+            isc_throw(LeaseReplicationError, "unexpected end of file");
+        }
+        uint32_t length = InputBuffer(&data[0], data.size()).readUint32();
+        if (length > LeaseReplicationCodec::MAX_MESSAGE_LENGTH) {
+            isc_throw(LeaseReplicationError, "invalid message length " << length);
+        }
+        data.resize(sizeof(uint32_t) + length);
+        if (!spill_stream_.read(reinterpret_cast<char*>(&data[sizeof(uint32_t)]), length)) {
+            isc_throw(LeaseReplicationError, "unexpected end of file");
+        }
+
+        InputBuffer in(&data[0], data.size());
+        LeaseReplicationCodec::MessageType type;
+        uint32_t sequence;
+        LeaseReplicationCodec::decodeHeader(in, type, sequence);
+        LeasePtr lease;
+        switch (type) {
+        case LeaseReplicationCodec::LEASE4_UPDATE:
+        case LeaseReplicationCodec::LEASE4_DELETE:
+            lease = LeaseReplicationCodec::decodeLease4(in);
+            break;
+        case LeaseReplicationCodec::LEASE6_UPDATE:
+        case LeaseReplicationCodec::LEASE6_DELETE:
+            lease = LeaseReplicationCodec::decodeLease6(in);
+            break;
+        default:
+            isc_throw(LeaseReplicationError, "unexpected message type");
+        }
+        op_type = ((type == LeaseReplicationCodec::LEASE4_DELETE) ||
+                   (type == LeaseReplicationCodec::LEASE6_DELETE) ? DELETE : ADD);
+
+        spill_read_pos_ += data.size();
+        if (--spilled_ == 0) {
+            resetSpillFile();
+        }
+        return (lease);
+
+    } catch (const std::exception& ex) {
+        // The remaining spilled updates are lost so the partner's lease
+        // database must be synchronized.
+        LOG_WARN(ha_logger, HA_LEASES_BACKLOG_UNSPILL_FAILED)
+            .arg(spill_file_)
+            .arg(ex.what());
+        overflown_ = true;
+        resetSpillFile();
+    }
+    return (LeasePtr());
+}
+
+void
+LeaseUpdateBacklog::resetSpillFile() {
+    if (spill_stream_.is_open()) {
+        spill_stream_.close();
+    }
+    spill_stream_.clear();
+    spill_stream_.open(spill_file_.c_str(), std::ios::in | std::ios::out |
+                       std::ios::trunc | std::ios::binary);
+    spill_read_pos_ = 0;
+    spill_write_pos_ = 0;
+    spilled_ = 0;
 }
 
 } // end of namespace isc::ha
@@ -7,10 +7,17 @@
 #ifndef HA_LEASE_BACKLOG_H
 #define HA_LEASE_BACKLOG_H
 
+#include <asiolink/io_address.h>
 #include <dhcpsrv/lease.h>
-#include <deque>
+#include <boost/multi_index_container.hpp>
+#include <boost/multi_index/composite_key.hpp>
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/indexed_by.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/sequenced_index.hpp>
+#include <fstream>
 #include <mutex>
-#include <utility>
+#include <string>
 
 namespace isc {
 namespace ha {
@@ -24,24 +31,24 @@ namespace ha {
 /// lease updates and later send them when the communication is resumed.
 /// The lease updates are stored in this queue.
 ///
-/// This queue has configurable size. If the number of leases appended
-/// to the queue reaches the limit, no more updates can be added to it.
-/// This prevents inifinite growth of the queue and excessive memory
-/// consumption.
-///
 /// There are two types of lease updates: "Add" and "Delete". The type
 /// is specified when the lease is appended to the queue.
 ///
-/// The backlog queue holds both "Add" and "Delete" lease updates in a
-/// single std::deque container, which allows for ordering them
-/// chronologically and using this ordering for queue optimizations in
-/// the future. For example, if the queue contains consecutive "Delete"
-/// updates for a particular IP address, the server could only delete
-/// the lease once. If the queue contains multiple "Delete" lease updates
-/// followed by an "Add" update, the server could skip sending "Delete"
-/// updates.
+/// The queue only holds the latest update of each lease: an update for
+/// a lease which is already in the queue replaces the previous update,
+/// which is removed, and is moved to the end of the queue. Sending the
+/// latest update of each lease in the order the leases were last updated
+/// leaves the partner with the same leases as sending all of them.
 ///
-/// Queue optimizations will be subject to future work!
+/// This queue has configurable size. If the number of leases in the
+/// queue reaches the limit, no more updates can be added to it. This
+/// prevents inifinite growth of the queue and excessive memory
+/// consumption. When a spill file is configured, the queued updates are
+/// instead moved to this file and the queue accepts new updates. The
+/// spilled updates are returned first by @c pop, in order. They are not
+/// coalesced with the updates queued after them, which only costs some
+/// unnecessary updates of the partner. The spill file has a maximum size:
+/// when the queued updates do not fit in it, the queue is overflown.
 class LeaseUpdateBacklog {
 public:
 
@@ -55,7 +62,18 @@ public:
     ///
     /// @param limit specifies the maximum number of lease updates which
     /// can be stored in the queue.
-    LeaseUpdateBacklog(const size_t limit);
+    /// @param spill_file name of the file the queued lease updates are
+    /// moved to when the limit is reached. The queue overflows at the limit
+    /// when it is empty.
+    /// @param spill_max_size maximum size of the spill file in bytes
+    /// (0 for no limit).
+    LeaseUpdateBacklog(const size_t limit, const std::string& spill_file = "",
+                       const uint64_t spill_max_size = 0);
+
+    /// @brief Destructor.
+    ///
+    /// Removes the spill file.
+    ~LeaseUpdateBacklog();
 
     /// @brief Appends lease update to the queue.
     ///
@@ -75,8 +93,10 @@ public:
     /// @brief Checks if the queue was overflown.
     ///
     /// This method returns true if the number of lease updates exceeded
-    /// the queue size limit at any point. The HA service checks this
-    /// flag when the communication with the partner is resumed to make
+    /// the queue size limit at any point, or if the lease updates could
+    /// not be written to or read from the spill file, or did not fit in
+    /// its maximum size. The HA service checks
+    /// this flag when the communication with the partner is resumed to make
     /// decisions about lease synchronization. If the queue was not
     /// overflown, the server will send lease updates which are sitting
     /// in the queue. Otherwise, it will go over the fully blown lease
@@ -93,10 +113,50 @@ public:
     void clear();
 
     /// @brief Returns the current size of the queue.
+    ///
+    /// It includes the lease updates moved to the spill file.
     size_t size();
 
+    /// @brief Returns the number of lease updates in the spill file.
+    size_t spilledSize();
+
 private:
 
+    /// @brief Lease update held in the queue.
+    struct Update {
+        /// @brief Lease type, @c Lease::TYPE_V4 for the DHCPv4 leases.
+        dhcp::Lease::Type type_;
+
+        /// @brief Leased address or prefix.
+        asiolink::IOAddress address_;
+
+        /// @brief Type of the lease update.
+        OpType op_type_;
+
+        /// @brief Pointer to the lease.
+        dhcp::LeasePtr lease_;
+    };
+
+    /// @brief Container holding the lease updates.
+    ///
+    /// The first index keeps the updates in the order they were queued.
+    /// The second index finds the update of a lease.
+    typedef boost::multi_index_container<
+        Update,
+        boost::multi_index::indexed_by<
+            boost::multi_index::sequenced<>,
+            boost::multi_index::hashed_unique<
+                boost::multi_index::composite_key<
+                    Update,
+                    boost::multi_index::member<Update, dhcp::Lease::Type,
+                                               &Update::type_>,
+                    boost::multi_index::member<Update, asiolink::IOAddress,
+                                               &Update::address_>
+                >
+            >
+        >
+    > UpdateContainer;
+
     /// @brief Appends lease update to the queue (thread unsafe).
     ///
     /// @param op_type type of the lease update (operation type).
@@ -112,14 +172,49 @@ private:
     /// when the queue is empty.
     dhcp::LeasePtr popInternal(OpType& op_type);
 
+    /// @brief Removes all lease updates from the queue (thread unsafe).
+    void clearInternal();
+
+    /// @brief Moves the queued lease updates to the spill file (thread unsafe).
+    ///
+    /// @return true if the lease updates were written, false otherwise.
+    bool spill();
+
+    /// @brief Reads the next lease update from the spill file (thread unsafe).
+    ///
+    /// @param [out] op_type reference to the value receiving lease update type.
+    /// @return pointer to the lease or null pointer when it couldn't be read.
+    dhcp::LeasePtr unspill(OpType& op_type);
+
+    /// @brief Truncates the spill file (thread unsafe).
+    void resetSpillFile();
+
     /// @brief Holds the queue size limit.
     size_t limit_;
 
     /// @brief Remembers whether the queue was overflown.
     bool overflown_;
 
-    /// @brief Actual queue of lease updates and their types.
-    std::deque<std::pair<OpType, dhcp::LeasePtr> > outstanding_updates_;
+    /// @brief Actual queue of lease updates.
+    UpdateContainer outstanding_updates_;
+
+    /// @brief Name of the spill file, empty when it is not used.
+    std::string spill_file_;
+
+    /// @brief Maximum size of the spill file in bytes (0 for no limit).
+    uint64_t spill_max_size_;
+
+    /// @brief Stream of the spill file.
+    std::fstream spill_stream_;
+
+    /// @brief Position of the next lease update to read from the spill file.
+    std::streamoff spill_read_pos_;
+
+    /// @brief Position where the next lease updates are written.
+    std::streamoff spill_write_pos_;
+
+    /// @brief Number of lease updates in the spill file.
+    size_t spilled_;
 
     /// @brief Mutex to protect internal state.
     std::mutex mutex_;
@@ -1,4 +1,4 @@
-// Copyright (C) 2018-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2018-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -12,14 +12,18 @@
 #include <dhcp/dhcp6.h>
 #include <dhcp/option.h>
 #include <exceptions/exceptions.h>
+#include <stats/stats_mgr.h>
+#include <util/hash.h>
 #include <util/multi_threading_mgr.h>
 
+#include <algorithm>
 #include <array>
 #include <iostream>
 #include <sstream>
 
 using namespace isc::dhcp;
 using namespace isc::log;
+using namespace isc::stats;
 using namespace isc::util;
 
 namespace {
@@ -53,8 +57,8 @@ namespace isc {
 namespace ha {
 
 QueryFilter::QueryFilter(const HAConfigPtr& config)
-    : config_(config), peers_(), scopes_(), active_servers_(0),
-      mutex_(new std::mutex) {
+    : config_(config), peers_(), scopes_(), active_servers_(0), ring_(),
+      stat_names_(), other_scope_classes_(), mutex_(new std::mutex) {
 
     // Make sure that the configuration is valid. We make certain
     // assumptions about the availability of the servers' configurations
@@ -95,6 +99,28 @@ QueryFilter::QueryFilter(const HAConfigPtr& config)
         peers_.insert(peers_.end(), backup_peers.begin(), backup_peers.end());
     }
 
+    for (auto peer = peers_.begin(); peer != peers_.end(); ++peer) {
+        stat_names_.push_back(StatsMgr::generateName("ha-scope", (*peer)->getName(),
+                                                     "queries"));
+    }
+
+    // With more than two active servers, this server only monitors its
+    // partner.
+    std::string my_name = config_->getThisServerName();
+    std::string partner = config_->getThisServerConfig()->getPartner();
+    if (!partner.empty()) {
+        for (int i = 0; i < active_servers_; ++i) {
+            std::string name = peers_[i]->getName();
+            if ((name != my_name) && (name != partner)) {
+                other_scope_classes_.insert(makeScopeClass(name));
+            }
+        }
+    }
+
+    if (active_servers_ > 2) {
+        buildRing();
+    }
+
     // The query filter is initially setup to serve default scopes, i.e. for the
     // load balancing case the primary and secondary are responsible for their
     // own scopes. The backup servers are not responding to any queries. In the
@@ -103,6 +129,29 @@ QueryFilter::QueryFilter(const HAConfigPtr& config)
     serveDefaultScopes();
 }
 
+void
+QueryFilter::buildRing() {
+    for (int i = 0; i < active_servers_; ++i) {
+        std::string name = peers_[i]->getName();
+        for (unsigned point = 0; point < RING_POINTS_PER_SERVER; ++point) {
+            std::ostringstream point_name;
+            point_name << name << "#" << point;
+            std::string key = point_name.str();
+            ring_.push_back(std::make_pair(ringHash(reinterpret_cast<const uint8_t*>(key.c_str()),
+                                                    key.size()), i));
+        }
+    }
+    // Ties are broken by the index so the ring is the same whatever the
+    // order of the servers.
+    std::sort(ring_.begin(), ring_.end(),
+              [this](const std::pair<uint64_t, int>& a, const std::pair<uint64_t, int>& b) {
+        if (a.first != b.first) {
+            return (a.first < b.first);
+        }
+        return (peers_[a.second]->getName() < peers_[b.second]->getName());
+    });
+}
+
 void
 QueryFilter::serveScope(const std::string& scope_name) {
     if (MultiThreadingMgr::instance().getMode()) {
@@ -207,6 +256,11 @@ QueryFilter::serveFailoverScopesInternal() {
     // Clear scopes.
     serveNoScopesInternal();
 
+    // With more than two active servers, this server only takes over
+    // the scope of its partner.
+    std::string my_name = config_->getThisServerName();
+    std::string partner = config_->getThisServerConfig()->getPartner();
+
     // Iterate over the roles of all servers to see which scope should
     // be enabled.
     for (auto peer = peers_.begin(); peer != peers_.end(); ++peer) {
@@ -216,8 +270,10 @@ QueryFilter::serveFailoverScopesInternal() {
         // I will start serving queries from both scopes. If I am a
         // standby server, I will start serving the scope of the primary
         // server.
-        if (((*peer)->getRole() == HAConfig::PeerConfig::PRIMARY) ||
-            ((*peer)->getRole() == HAConfig::PeerConfig::SECONDARY)) {
+        if ((((*peer)->getRole() == HAConfig::PeerConfig::PRIMARY) ||
+             ((*peer)->getRole() == HAConfig::PeerConfig::SECONDARY)) &&
+            (partner.empty() || ((*peer)->getName() == my_name) ||
+             ((*peer)->getName() == partner))) {
             serveScopeInternal((*peer)->getName());
         }
     }
@@ -321,6 +377,9 @@ QueryFilter::inScopeInternal(const QueryPtrType& query,
         }
     }
 
+    StatsMgr::instance().addValue(stat_names_[candidate_server],
+                                  static_cast<int64_t>(1));
+
     auto scope = peers_[candidate_server]->getName();
     scope_class = makeScopeClass(scope);
     return ((candidate_server >= 0) && amServingScopeInternal(scope));
@@ -328,19 +387,18 @@ QueryFilter::inScopeInternal(const QueryPtrType& query,
 
 int
 QueryFilter::loadBalance(const dhcp::Pkt4Ptr& query4) const {
-    uint8_t lb_hash = 0;
     // Try to compute the hash by client identifier if the client
     // identifier has been specified.
     OptionPtr opt_client_id = query4->getOption(DHO_DHCP_CLIENT_IDENTIFIER);
     if (opt_client_id && !opt_client_id->getData().empty()) {
         const auto& client_id_key = opt_client_id->getData();
-        lb_hash = loadBalanceHash(&client_id_key[0], client_id_key.size());
+        return (loadBalanceKey(&client_id_key[0], client_id_key.size()));
 
     } else {
         // No client identifier available. Use the HW address instead.
         HWAddrPtr hwaddr = query4->getHWAddr();
         if (hwaddr && !hwaddr->hwaddr_.empty()) {
-            lb_hash = loadBalanceHash(&hwaddr->hwaddr_[0], hwaddr->hwaddr_.size());
+            return (loadBalanceKey(&hwaddr->hwaddr_[0], hwaddr->hwaddr_.size()));
 
         } else {
             // No client identifier and no HW address. Indicate an
@@ -352,20 +410,15 @@ QueryFilter::loadBalance(const dhcp::Pkt4Ptr& query4) const {
             return (-1);
         }
     }
-
-    // The hash value modulo number of active servers gives an index
-    // of the server to process the packet.
-    return (active_servers_ > 0 ? static_cast<int>(lb_hash % active_servers_) : -1);
 }
 
 int
 QueryFilter::loadBalance(const dhcp::Pkt6Ptr& query6) const {
-    uint8_t lb_hash = 0;
     // Compute the hash by DUID if the DUID.
     OptionPtr opt_duid = query6->getOption(D6O_CLIENTID);
     if (opt_duid && !opt_duid->getData().empty()) {
         const auto& duid_key = opt_duid->getData();
-        lb_hash = loadBalanceHash(&duid_key[0], duid_key.size());
+        return (loadBalanceKey(&duid_key[0], duid_key.size()));
 
     } else {
         // No DUID. Indicate an error.
@@ -375,12 +428,44 @@ QueryFilter::loadBalance(const dhcp::Pkt6Ptr& query6) const {
             .arg(xid.str());
         return (-1);
     }
+}
+
+int
+QueryFilter::loadBalanceKey(const uint8_t* key, const size_t key_len) const {
+    if (!ring_.empty()) {
+        // The owner of the first point following the key hash, wrapping
+        // around at the end of the ring.
+        auto point = std::upper_bound(ring_.begin(), ring_.end(),
+                                      ringHash(key, key_len),
+                                      [](const uint64_t hash,
+                                         const std::pair<uint64_t, int>& p) {
+            return (hash < p.first);
+        });
+        if (point == ring_.end()) {
+            point = ring_.begin();
+        }
+        return (point->second);
+    }
 
     // The hash value modulo number of active servers gives an index
     // of the server to process the packet.
+    uint8_t lb_hash = loadBalanceHash(key, key_len);
     return (active_servers_ > 0 ? static_cast<int>(lb_hash % active_servers_) : -1);
 }
 
+uint64_t
+QueryFilter::ringHash(const uint8_t* key, const size_t key_len) {
+    // FNV-1a followed by the MurmurHash3 finalizer which spreads the
+    // small differences between the keys over all the bits.
+    uint64_t hash = Hash64::hash(key, key_len);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ull;
+    hash ^= hash >> 33;
+    return (hash);
+}
+
 uint8_t
 QueryFilter::loadBalanceHash(const uint8_t* key, const size_t key_len) const {
     uint8_t hash  = static_cast<uint8_t>(key_len);
@@ -1,4 +1,4 @@
-// Copyright (C) 2018-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2018-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -30,10 +30,19 @@ namespace ha {
 /// load balancing of the DHCP queries, when configured to do so.
 ///
 /// The query filter uses a term "scope" to identify group of DHCP queries
-/// processed by a given server. Currently, we support load balanacing
-/// between two servers. Therefore, in this mode of operation, there are two
-/// scopes named after servers responsible for processing packets belonging
-/// to those scopes, e.g. "server1" and "server2".
+/// processed by a given server. In the load balancing mode of operation,
+/// there is one scope per active server, named after the server responsible
+/// for processing packets belonging to this scope, e.g. "server1" and
+/// "server2".
+///
+/// With more than two active servers, the queries are distributed using
+/// a consistent hash ring: each active server owns a number of points on
+/// the ring and a query belongs to the server owning the first point
+/// following the hash of the client identifier. Adding or removing a
+/// server only moves the clients of the ranges it gains or loses, i.e.
+/// about 1/N of the clients, rather than most of them as with a modulo.
+/// The number of received queries belonging to each scope is counted in
+/// the "ha-scope[name].queries" statistic.
 ///
 /// In the hot-standby mode, there is only one server processing incoming
 /// DHCP queries. Thus, there is only one scope named after the primary
@@ -69,13 +78,13 @@ public:
     /// - backup servers configurations
     ///
     /// It also sets the @c active_servers_ value to the number of active
-    /// servers (responding to DHCP queries) for a given HA mode. In our case,
-    /// this is 2 for the load balancing case and 1 for the hot-standby.
+    /// servers (responding to DHCP queries) for a given HA mode. This is
+    /// at least 2 for the load balancing case and 1 for the hot-standby.
     /// Such organization of the configurations makes it easier for the
-    /// load balancing algorithm to distribute queries between active servers.
-    /// In our simple case, the load balancing algorithm can produce a value
-    /// of 0 or 1, which points to a primary or secondary server in the
-    /// configuration vector.
+    /// load balancing algorithm to distribute queries between active servers:
+    /// it produces an index lower than @c active_servers_, which points to
+    /// a primary or secondary server in the configuration vector. With more
+    /// than two active servers, the hash ring is built.
     ///
     /// @param config pointer to the HA configuration.
     /// @throw HAConfigValidationError if provided configuration is invalid.
@@ -116,9 +125,10 @@ public:
     ///
     /// In the load balancing case, the scopes of the primary and secondary
     /// servers are enabled (this server will handle the entire traffic).
-    /// In the hot standby case, the primary server's scope is enabled
-    /// (this server will handle the entire traffic normally processed by
-    /// the primary server).
+    /// With more than two active servers, only the scopes of this server
+    /// and of its partner are enabled. In the hot standby case, the primary
+    /// server's scope is enabled (this server will handle the entire traffic
+    /// normally processed by the primary server).
     void serveFailoverScopes();
 
     /// @brief Disables all scopes.
@@ -168,6 +178,19 @@ public:
     /// server, false otherwise.
     bool inScope(const dhcp::Pkt6Ptr& query6, std::string& scope_class) const;
 
+    /// @brief Checks if a query not in scope may be answered by the partner.
+    ///
+    /// With more than two active servers, this server only monitors its
+    /// partner so the queries belonging to the scopes of the other active
+    /// servers must not be used to detect a partner failure.
+    ///
+    /// @param scope_class name of the class returned by @c inScope.
+    /// @return false if the query belongs to the scope of an active server
+    /// which is not the partner of this server, true otherwise.
+    bool isPartnerScopeClass(const std::string& scope_class) const {
+        return (other_scope_classes_.count(scope_class) == 0);
+    }
+
 private:
     /// @brief Enable scope.
     ///
@@ -263,9 +286,8 @@ protected:
     ///
     /// This method returns an index of the server configuration
     /// held within @c peers_ vector. This points to a server
-    /// which should process the given query. Currently, we only
-    /// support load balancing between two servers, therefore this
-    /// value should be 0 or 1.
+    /// which should process the given query. This value is lower
+    /// than the number of active servers.
     ///
     /// @param query4 pointer to the DHCPv4 query instance.
     /// @return Index of the server which should process the query. It
@@ -277,9 +299,8 @@ protected:
     ///
     /// This method returns an index of the server configuration
     /// held within @c peers_ vector. This points to a server
-    /// which should process the given query. Currently, we only
-    /// support load balancing between two servers, therefore this
-    /// value should be 0 or 1.
+    /// which should process the given query. This value is lower
+    /// than the number of active servers.
     ///
     /// @param query6 pointer to the DHCPv6 query instance.
     /// @return Index of the server which should process the query. It
@@ -299,6 +320,33 @@ protected:
     /// @return Computed hash value.
     uint8_t loadBalanceHash(const uint8_t* key, const size_t key_len) const;
 
+    /// @brief Selects the server owning a client identifier.
+    ///
+    /// With two active servers, the load balancing hash modulo the number
+    /// of active servers is used. With more than two active servers, the
+    /// owner is found on the hash ring.
+    ///
+    /// @param key identifier of the client, i.e. HW address, client
+    /// identifier or DUID.
+    /// @param key_len length of the key.
+    ///
+    /// @return Index of the server which should process the query.
+    int loadBalanceKey(const uint8_t* key, const size_t key_len) const;
+
+    /// @brief Compute the hash ring position of a key.
+    ///
+    /// @param key identifier used to compute a hash.
+    /// @param key_len length of the key.
+    ///
+    /// @return Position on the hash ring.
+    static uint64_t ringHash(const uint8_t* key, const size_t key_len);
+
+    /// @brief Builds the hash ring of the active servers.
+    ///
+    /// The points of a server only depend on its name so all the servers
+    /// build the same ring.
+    void buildRing();
+
     /// @brief Checks if the scope name matches a name of any of the
     /// configured servers.
     ///
@@ -335,6 +383,23 @@ protected:
     /// @brief Number of the active servers in the given HA mode.
     int active_servers_;
 
+    /// @brief Number of points of each active server on the hash ring.
+    static const unsigned RING_POINTS_PER_SERVER = 128;
+
+    /// @brief Hash ring: sorted points and the indexes in @c peers_ of
+    /// the servers owning them.
+    ///
+    /// Empty unless there are more than two active servers.
+    std::vector<std::pair<uint64_t, int> > ring_;
+
+    /// @brief Names of the per scope query statistics, by index in
+    /// @c peers_.
+    std::vector<std::string> stat_names_;
+
+    /// @brief Scope classes of the active servers which are neither this
+    /// server nor its partner.
+    std::set<std::string> other_scope_classes_;
+
     /// @brief Mutex to protect the internal state.
     boost::scoped_ptr<std::mutex> mutex_;
 };
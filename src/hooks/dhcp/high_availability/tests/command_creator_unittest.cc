@@ -386,6 +386,7 @@ TEST(CommandCreatorTest, createLease6BulkApply) {
 TEST(CommandCreatorTest, createLease6BulkApplyFromBacklog) {
     Lease6Ptr lease = createLease6();
     Lease6Ptr deleted_lease = createLease6();
+    deleted_lease->addr_ = IOAddress("2001:db8:1::beef");
 
     LeaseUpdateBacklog backlog(100);
     backlog.push(LeaseUpdateBacklog::ADD, lease);
@@ -402,7 +403,7 @@ TEST(CommandCreatorTest, createLease6BulkApplyFromBacklog) {
     ASSERT_EQ(Element::list, deleted_leases_json->getType());
     ASSERT_EQ(1, deleted_leases_json->size());
     auto lease_as_json = deleted_leases_json->get(0);
-    EXPECT_EQ(leaseAsJson(createLease6())->str(), lease_as_json->str());
+    EXPECT_EQ(leaseAsJson(deleted_lease)->str(), lease_as_json->str());
 
     // Verify leases.
     auto leases_json = arguments->get("leases");
@@ -416,6 +417,60 @@ TEST(CommandCreatorTest, createLease6BulkApplyFromBacklog) {
     EXPECT_EQ(0, backlog.size());
 }
 
+// This test verifies that the lease6-bulk-apply command created from the
+// backlog holds at most the specified number of lease updates and only
+// the last update of each lease.
+TEST(CommandCreatorTest, createLease6BulkApplyFromBacklogLimit) {
+    std::string spill_file = "/tmp/ha-command-creator-backlog";
+    LeaseUpdateBacklog backlog(2, spill_file);
+
+    Lease6Ptr lease = createLease6();
+    std::vector<Lease6Ptr> other_leases;
+    for (auto address : { "2001:db8:1::1", "2001:db8:1::2", "2001:db8:1::3" }) {
+        Lease6Ptr other_lease = createLease6();
+        other_lease->addr_ = IOAddress(address);
+        other_leases.push_back(other_lease);
+    }
+
+    // The lease deletion is spilled before the lease is updated again,
+    // so the backlog returns both updates of this lease.
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::DELETE, lease));
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, other_leases[0]));
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, other_leases[1]));
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, lease));
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, other_leases[2]));
+    ASSERT_EQ(5, backlog.size());
+    ASSERT_EQ(4, backlog.spilledSize());
+
+    ConstElementPtr command = CommandCreator::createLease6BulkApply(backlog, 4);
+    ConstElementPtr arguments;
+    ASSERT_NO_FATAL_FAILURE(testCommandBasics(command, "lease6-bulk-apply",
+                                              "dhcp6", arguments));
+
+    // The lease deletion has been replaced by the later update.
+    auto deleted_leases_json = arguments->get("deleted-leases");
+    ASSERT_TRUE(deleted_leases_json);
+    EXPECT_EQ(0, deleted_leases_json->size());
+
+    auto leases_json = arguments->get("leases");
+    ASSERT_TRUE(leases_json);
+    ASSERT_EQ(3, leases_json->size());
+    EXPECT_EQ(leaseAsJson(other_leases[0])->str(), leases_json->get(0)->str());
+    EXPECT_EQ(leaseAsJson(other_leases[1])->str(), leases_json->get(1)->str());
+    EXPECT_EQ(leaseAsJson(lease)->str(), leases_json->get(2)->str());
+
+    // The last lease update remains in the backlog.
+    EXPECT_EQ(1, backlog.size());
+    command = CommandCreator::createLease6BulkApply(backlog, 4);
+    ASSERT_NO_FATAL_FAILURE(testCommandBasics(command, "lease6-bulk-apply",
+                                              "dhcp6", arguments));
+    leases_json = arguments->get("leases");
+    ASSERT_TRUE(leases_json);
+    ASSERT_EQ(1, leases_json->size());
+    EXPECT_EQ(leaseAsJson(other_leases[2])->str(), leases_json->get(0)->str());
+    EXPECT_EQ(0, backlog.size());
+}
+
 // This test verifies that the lease6-get-all command is correct.
 TEST(CommandCreatorTest, createLease6GetAll) {
     ConstElementPtr command = CommandCreator::createLease6GetAll();
@@ -13,14 +13,19 @@
 #include <cc/data.h>
 #include <cc/dhcp_config_error.h>
 #include <config/command_mgr.h>
+#include <dhcpsrv/cfgmgr.h>
+#include <eval/token.h>
 #include <util/state_model.h>
 #include <util/multi_threading_mgr.h>
 #include <testutils/gtest_utils.h>
 #include <string>
+#include <vector>
 
 using namespace isc;
+using namespace isc::asiolink;
 using namespace isc::config;
 using namespace isc::data;
+using namespace isc::dhcp;
 using namespace isc::ha;
 using namespace isc::hooks;
 using namespace isc::ha::test;
@@ -38,6 +43,13 @@ public:
         : HATest() {
     }
 
+    /// @brief Destructor.
+    ///
+    /// Removes the subnets and classes added to the staging configuration.
+    virtual ~HAConfigTest() {
+        CfgMgr::instance().clear();
+    }
+
     /// @brief Verifies if an exception is thrown if provided HA
     /// configuration is invalid.
     ///
@@ -82,6 +94,83 @@ public:
         }
         return (result);
     }
+
+    /// @brief Adds a client class to the staging configuration.
+    ///
+    /// The class matches the queries of any of the given servers.
+    ///
+    /// @param name Name of the class.
+    /// @param servers Names of the servers of the HA classes.
+    void addStagingClass(const std::string& name,
+                         const std::vector<std::string>& servers) {
+        ExpressionPtr expr(new Expression());
+        std::string test;
+        for (auto server : servers) {
+            expr->push_back(TokenPtr(new TokenMember("HA_" + server)));
+            if (!test.empty()) {
+                expr->push_back(TokenPtr(new TokenOr()));
+                test += " or ";
+            }
+            test += "member('HA_" + server + "')";
+        }
+        CfgMgr::instance().getStagingCfg()->getClientClassDictionary()->
+            addClass(name, expr, test, false, false, CfgOptionPtr());
+    }
+
+    /// @brief Adds a subnet with pools to the staging configuration.
+    ///
+    /// @param pool_classes Client classes of the pools of the subnet, the
+    /// empty string for a pool without client class.
+    void addStagingPools(const std::vector<std::string>& pool_classes) {
+        Subnet4Ptr subnet(new Subnet4(IOAddress("192.0.2.0"), 24, 30, 40,
+                                      60, SubnetID(1)));
+        uint32_t first = IOAddress("192.0.2.10").toUint32();
+        for (auto pool_class : pool_classes) {
+            Pool4Ptr pool(new Pool4(IOAddress(first), IOAddress(first + 9)));
+            if (!pool_class.empty()) {
+                pool->allowClientClass(pool_class);
+            }
+            subnet->addPool(pool);
+            first += 10;
+        }
+        CfgMgr::instance().getStagingCfg()->getCfgSubnets4()->add(subnet);
+    }
+
+    /// @brief Returns the configuration of two failover pairs.
+    std::string getPartnersConfig() const {
+        return ("["
+                "    {"
+                "        \"this-server-name\": \"server1\","
+                "        \"mode\": \"load-balancing\","
+                "        \"peers\": ["
+                "            {"
+                "                \"name\": \"server1\","
+                "                \"url\": \"http://127.0.0.1:8080/\","
+                "                \"role\": \"primary\","
+                "                \"partner\": \"server2\""
+                "            },"
+                "            {"
+                "                \"name\": \"server2\","
+                "                \"url\": \"http://127.0.0.1:8081/\","
+                "                \"role\": \"secondary\","
+                "                \"partner\": \"server1\""
+                "            },"
+                "            {"
+                "                \"name\": \"server3\","
+                "                \"url\": \"http://127.0.0.1:8082/\","
+                "                \"role\": \"primary\","
+                "                \"partner\": \"server4\""
+                "            },"
+                "            {"
+                "                \"name\": \"server4\","
+                "                \"url\": \"http://127.0.0.1:8083/\","
+                "                \"role\": \"secondary\","
+                "                \"partner\": \"server3\""
+                "            }"
+                "        ]"
+                "    }"
+                "]");
+    }
 };
 
 // Verifies that load balancing configuration is parsed correctly.
@@ -96,6 +185,8 @@ TEST_F(HAConfigTest, configureLoadBalancing) {
         "        \"sync-timeout\": 20000,"
         "        \"sync-page-limit\": 3,"
         "        \"delayed-updates-limit\": 111,"
+        "        \"delayed-updates-spill-file\": \"/tmp/ha-backlog\","
+        "        \"delayed-updates-spill-max-size\": 1048576,"
         "        \"heartbeat-delay\": 8,"
         "        \"max-response-delay\": 11,"
         "        \"max-ack-delay\": 5,"
@@ -152,6 +243,8 @@ TEST_F(HAConfigTest, configureLoadBalancing) {
     EXPECT_EQ(20000, impl->getConfig()->getSyncTimeout());
     EXPECT_EQ(3, impl->getConfig()->getSyncPageLimit());
     EXPECT_EQ(111, impl->getConfig()->getDelayedUpdatesLimit());
+    EXPECT_EQ("/tmp/ha-backlog", impl->getConfig()->getDelayedUpdatesSpillFile());
+    EXPECT_EQ(1048576, impl->getConfig()->getDelayedUpdatesSpillMaxSize());
     EXPECT_TRUE(impl->getConfig()->amAllowingCommRecovery());
     EXPECT_EQ(8, impl->getConfig()->getHeartbeatDelay());
     EXPECT_EQ(11, impl->getConfig()->getMaxResponseDelay());
@@ -235,6 +328,8 @@ TEST_F(HAConfigTest, configureLoadBalancing) {
     EXPECT_FALSE(impl->getConfig()->getHttpDedicatedListener());
     EXPECT_EQ(0, impl->getConfig()->getHttpListenerThreads());
     EXPECT_EQ(0, impl->getConfig()->getHttpClientThreads());
+    EXPECT_FALSE(impl->getConfig()->getBinaryLeaseUpdates());
+    EXPECT_EQ(0, impl->getConfig()->getThisServerConfig()->getReplicationPort());
 }
 
 // Verifies that hot standby configuration is parsed correctly.
@@ -277,6 +372,8 @@ TEST_F(HAConfigTest, configureHotStandby) {
     EXPECT_EQ(60000, impl->getConfig()->getSyncTimeout());
     EXPECT_EQ(10000, impl->getConfig()->getSyncPageLimit());
     EXPECT_EQ(0, impl->getConfig()->getDelayedUpdatesLimit());
+    EXPECT_TRUE(impl->getConfig()->getDelayedUpdatesSpillFile().empty());
+    EXPECT_EQ(104857600, impl->getConfig()->getDelayedUpdatesSpillMaxSize());
     EXPECT_FALSE(impl->getConfig()->amAllowingCommRecovery());
     EXPECT_EQ(10000, impl->getConfig()->getHeartbeatDelay());
     EXPECT_EQ(10000, impl->getConfig()->getMaxAckDelay());
@@ -964,6 +1061,349 @@ TEST_F(HAConfigTest, hotStandbySecondary) {
         "secondary servers not allowed in the hot standby configuration");
 }
 
+// Verifies that the load balancing configuration with more than two active
+// servers grouped in failover pairs is parsed correctly.
+TEST_F(HAConfigTest, configureLoadBalancingPartners) {
+    const std::string ha_config =
+        "["
+        "    {"
+        "        \"this-server-name\": \"server1\","
+        "        \"mode\": \"load-balancing\","
+        "        \"peers\": ["
+        "            {"
+        "                \"name\": \"server1\","
+        "                \"url\": \"http://127.0.0.1:8080/\","
+        "                \"role\": \"primary\","
+        "                \"partner\": \"server2\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server2\","
+        "                \"url\": \"http://127.0.0.1:8081/\","
+        "                \"role\": \"secondary\","
+        "                \"partner\": \"server1\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server3\","
+        "                \"url\": \"http://127.0.0.1:8082/\","
+        "                \"role\": \"primary\","
+        "                \"partner\": \"server4\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server4\","
+        "                \"url\": \"http://127.0.0.1:8083/\","
+        "                \"role\": \"secondary\","
+        "                \"partner\": \"server3\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server5\","
+        "                \"url\": \"http://127.0.0.1:8084/\","
+        "                \"role\": \"backup\","
+        "                \"auto-failover\": true"
+        "            }"
+        "        ]"
+        "    }"
+        "]";
+
+    HAImplPtr impl(new HAImpl());
+    ASSERT_NO_THROW(impl->configure(Element::fromJSON(ha_config)));
+    HAConfigPtr config = impl->getConfig();
+    EXPECT_EQ("server2", config->getThisServerConfig()->getPartner());
+    EXPECT_EQ("server3", config->getPeerConfig("server4")->getPartner());
+    EXPECT_TRUE(config->getPeerConfig("server5")->getPartner().empty());
+
+    // The failover partner is the configured one.
+    ASSERT_TRUE(config->getFailoverPeerConfig());
+    EXPECT_EQ("server2", config->getFailoverPeerConfig()->getName());
+
+    // The lease updates are sent to the partner and to the backup server.
+    HAConfig::PeerConfigMap servers = config->getLeaseUpdatesServersConfig();
+    ASSERT_EQ(2, servers.size());
+    EXPECT_EQ(1, servers.count("server2"));
+    EXPECT_EQ(1, servers.count("server5"));
+}
+
+// The partners are only supported in the load balancing mode.
+TEST_F(HAConfigTest, partnerHotStandby) {
+    testInvalidConfig(
+        "["
+        "    {"
+        "        \"this-server-name\": \"server1\","
+        "        \"mode\": \"hot-standby\","
+        "        \"peers\": ["
+        "            {"
+        "                \"name\": \"server1\","
+        "                \"url\": \"http://127.0.0.1:8080/\","
+        "                \"role\": \"primary\","
+        "                \"partner\": \"server2\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server2\","
+        "                \"url\": \"http://127.0.0.1:8081/\","
+        "                \"role\": \"standby\","
+        "                \"partner\": \"server1\","
+        "                \"auto-failover\": true"
+        "            }"
+        "        ]"
+        "    }"
+        "]",
+        "'partner' is only supported in the load balancing configuration");
+}
+
+// The partner must be specified for all the active servers.
+TEST_F(HAConfigTest, partnerMissing) {
+    testInvalidConfig(
+        "["
+        "    {"
+        "        \"this-server-name\": \"server1\","
+        "        \"mode\": \"load-balancing\","
+        "        \"peers\": ["
+        "            {"
+        "                \"name\": \"server1\","
+        "                \"url\": \"http://127.0.0.1:8080/\","
+        "                \"role\": \"primary\","
+        "                \"partner\": \"server2\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server2\","
+        "                \"url\": \"http://127.0.0.1:8081/\","
+        "                \"role\": \"secondary\","
+        "                \"partner\": \"server1\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server3\","
+        "                \"url\": \"http://127.0.0.1:8082/\","
+        "                \"role\": \"primary\","
+        "                \"partner\": \"server4\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server4\","
+        "                \"url\": \"http://127.0.0.1:8083/\","
+        "                \"role\": \"secondary\","
+        "                \"auto-failover\": true"
+        "            }"
+        "        ]"
+        "    }"
+        "]",
+        "'partner' must be specified for the server server4 when it is specified for other servers");
+}
+
+// The partner must not be specified for a backup server.
+TEST_F(HAConfigTest, partnerBackup) {
+    testInvalidConfig(
+        "["
+        "    {"
+        "        \"this-server-name\": \"server1\","
+        "        \"mode\": \"load-balancing\","
+        "        \"peers\": ["
+        "            {"
+        "                \"name\": \"server1\","
+        "                \"url\": \"http://127.0.0.1:8080/\","
+        "                \"role\": \"primary\","
+        "                \"partner\": \"server2\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server2\","
+        "                \"url\": \"http://127.0.0.1:8081/\","
+        "                \"role\": \"secondary\","
+        "                \"partner\": \"server1\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server3\","
+        "                \"url\": \"http://127.0.0.1:8082/\","
+        "                \"role\": \"primary\","
+        "                \"partner\": \"server4\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server4\","
+        "                \"url\": \"http://127.0.0.1:8083/\","
+        "                \"role\": \"secondary\","
+        "                \"partner\": \"server3\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server5\","
+        "                \"url\": \"http://127.0.0.1:8084/\","
+        "                \"role\": \"backup\","
+        "                \"partner\": \"server1\","
+        "                \"auto-failover\": true"
+        "            }"
+        "        ]"
+        "    }"
+        "]",
+        "'partner' must not be specified for the backup server server5");
+}
+
+// The partner must be configured.
+TEST_F(HAConfigTest, partnerUnknown) {
+    testInvalidConfig(
+        "["
+        "    {"
+        "        \"this-server-name\": \"server1\","
+        "        \"mode\": \"load-balancing\","
+        "        \"peers\": ["
+        "            {"
+        "                \"name\": \"server1\","
+        "                \"url\": \"http://127.0.0.1:8080/\","
+        "                \"role\": \"primary\","
+        "                \"partner\": \"server2\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server2\","
+        "                \"url\": \"http://127.0.0.1:8081/\","
+        "                \"role\": \"secondary\","
+        "                \"partner\": \"server1\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server3\","
+        "                \"url\": \"http://127.0.0.1:8082/\","
+        "                \"role\": \"primary\","
+        "                \"partner\": \"server4\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server4\","
+        "                \"url\": \"http://127.0.0.1:8083/\","
+        "                \"role\": \"secondary\","
+        "                \"partner\": \"server6\","
+        "                \"auto-failover\": true"
+        "            }"
+        "        ]"
+        "    }"
+        "]",
+        "partner server6 of the server server4 is not configured");
+}
+
+// A primary server must be paired with a secondary server.
+TEST_F(HAConfigTest, partnerSameRole) {
+    testInvalidConfig(
+        "["
+        "    {"
+        "        \"this-server-name\": \"server1\","
+        "        \"mode\": \"load-balancing\","
+        "        \"peers\": ["
+        "            {"
+        "                \"name\": \"server1\","
+        "                \"url\": \"http://127.0.0.1:8080/\","
+        "                \"role\": \"primary\","
+        "                \"partner\": \"server3\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server2\","
+        "                \"url\": \"http://127.0.0.1:8081/\","
+        "                \"role\": \"secondary\","
+        "                \"partner\": \"server4\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server3\","
+        "                \"url\": \"http://127.0.0.1:8082/\","
+        "                \"role\": \"primary\","
+        "                \"partner\": \"server1\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server4\","
+        "                \"url\": \"http://127.0.0.1:8083/\","
+        "                \"role\": \"secondary\","
+        "                \"partner\": \"server2\","
+        "                \"auto-failover\": true"
+        "            }"
+        "        ]"
+        "    }"
+        "]",
+        "partner server3 of the server server1 must be a secondary server");
+}
+
+// The partners must be paired with each other.
+TEST_F(HAConfigTest, partnerNotSymmetric) {
+    testInvalidConfig(
+        "["
+        "    {"
+        "        \"this-server-name\": \"server1\","
+        "        \"mode\": \"load-balancing\","
+        "        \"peers\": ["
+        "            {"
+        "                \"name\": \"server1\","
+        "                \"url\": \"http://127.0.0.1:8080/\","
+        "                \"role\": \"primary\","
+        "                \"partner\": \"server2\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server2\","
+        "                \"url\": \"http://127.0.0.1:8081/\","
+        "                \"role\": \"secondary\","
+        "                \"partner\": \"server3\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server3\","
+        "                \"url\": \"http://127.0.0.1:8082/\","
+        "                \"role\": \"primary\","
+        "                \"partner\": \"server4\","
+        "                \"auto-failover\": true"
+        "            },"
+        "            {"
+        "                \"name\": \"server4\","
+        "                \"url\": \"http://127.0.0.1:8083/\","
+        "                \"role\": \"secondary\","
+        "                \"partner\": \"server3\","
+        "                \"auto-failover\": true"
+        "            }"
+        "        ]"
+        "    }"
+        "]",
+        "partner of the server server2 must be server1");
+}
+
+// The pools guarded by the classes of a single failover pair are accepted.
+TEST_F(HAConfigTest, partnerPools) {
+    addStagingClass("pair1", { "server1", "server2" });
+    addStagingClass("pair2", { "server3", "server4" });
+    addStagingClass("server3_only", { "server3" });
+    addStagingPools({ "pair1", "pair2", "HA_server4", "server3_only" });
+
+    HAImplPtr impl(new HAImpl());
+    EXPECT_NO_THROW(impl->configure(Element::fromJSON(getPartnersConfig())));
+}
+
+// A pool without HA class would be used by all the failover pairs.
+TEST_F(HAConfigTest, partnerPoolNotGuarded) {
+    addStagingClass("pair1", { "server1", "server2" });
+    addStagingPools({ "pair1", "" });
+
+    testInvalidConfig(getPartnersConfig(),
+        "the pool type=V4, 192.0.2.20-192.0.2.29 in the subnet 192.0.2.0/24"
+        " must be guarded by the HA classes of the servers of a single"
+        " failover pair when 'partner' is specified");
+}
+
+// A pool must not be shared by several failover pairs.
+TEST_F(HAConfigTest, partnerPoolShared) {
+    addStagingClass("pair1", { "server1", "server2" });
+    addStagingClass("mixed", { "server2", "server3" });
+    addStagingPools({ "pair1", "mixed" });
+
+    testInvalidConfig(getPartnersConfig(),
+        "the pool type=V4, 192.0.2.20-192.0.2.29 in the subnet 192.0.2.0/24"
+        " must be guarded by the HA classes of the servers of a single"
+        " failover pair when 'partner' is specified");
+}
+
 // state-machine parameter must be a map.
 TEST_F(HAConfigTest, invalidStateMachine) {
     testInvalidConfig(
@@ -1343,6 +1783,32 @@ TEST_F(HAConfigTest, passiveBackupDelayedUpdatesLimit) {
         "'delayed-updates-limit' must be set to 0 in the passive backup configuration");
 }
 
+// Test that delayed-updates-spill-file requires delayed-updates-limit.
+TEST_F(HAConfigTest, delayedUpdatesSpillFileNoLimit) {
+    testInvalidConfig(
+        "["
+        "    {"
+        "        \"this-server-name\": \"server1\","
+        "        \"mode\": \"load-balancing\","
+        "        \"delayed-updates-limit\": 0,"
+        "        \"delayed-updates-spill-file\": \"/tmp/ha-backlog\","
+        "        \"peers\": ["
+        "            {"
+        "                \"name\": \"server1\","
+        "                \"url\": \"http://127.0.0.1:8080/\","
+        "                \"role\": \"primary\""
+        "            },"
+        "            {"
+        "                \"name\": \"server2\","
+        "                \"url\": \"http://127.0.0.1:8080/\","
+        "                \"role\": \"secondary\""
+        "            }"
+        "        ]"
+        "    }"
+        "]",
+        "'delayed-updates-spill-file' requires 'delayed-updates-limit' greater than 0");
+}
+
 #if (defined(WITH_OPENSSL) || defined(WITH_BOTAN_BOOST))
 /// Test that TLS parameters are correctly inherited.
 TEST_F(HAConfigTest, tlsParameterInheritance) {
@@ -1854,4 +2320,150 @@ TEST_F(HAConfigTest, multiThreadingPermutations) {
     }
 }
 
+// Verifies that the binary lease updates configuration is parsed correctly.
+TEST_F(HAConfigTest, binaryLeaseUpdates) {
+    const std::string ha_config =
+        "["
+        "    {"
+        "        \"this-server-name\": \"server1\","
+        "        \"mode\": \"load-balancing\","
+        "        \"trust-anchor\": \"!CA!/kea-ca.crt\","
+        "        \"cert-file\": \"!CA!/kea-client.crt\","
+        "        \"key-file\": \"!CA!/kea-client.key\","
+        "        \"peers\": ["
+        "            {"
+        "                \"name\": \"server1\","
+        "                \"url\": \"https://127.0.0.1:8080/\","
+        "                \"replication-port\": 8090,"
+        "                \"role\": \"primary\""
+        "            },"
+        "            {"
+        "                \"name\": \"server2\","
+        "                \"url\": \"https://127.0.0.1:8081/\","
+        "                \"replication-port\": 8091,"
+        "                \"role\": \"secondary\""
+        "            }"
+        "        ],"
+        "        \"multi-threading\": {"
+        "            \"enable-multi-threading\": true,"
+        "            \"binary-lease-updates\": true"
+        "        }"
+        "    }"
+        "]";
+
+    const std::string& patched = replaceInConfig(ha_config, "!CA!",
+                                                 TEST_CA_DIR);
+    setDHCPMultiThreadingConfig(true, 4);
+
+    HAImplPtr impl(new HAImpl());
+    ASSERT_NO_THROW_LOG(impl->configure(Element::fromJSON(patched)));
+    EXPECT_TRUE(impl->getConfig()->getBinaryLeaseUpdates());
+    EXPECT_EQ(8090, impl->getConfig()->getPeerConfig("server1")->getReplicationPort());
+    EXPECT_EQ(8091, impl->getConfig()->getPeerConfig("server2")->getReplicationPort());
+
+    // The binary lease updates are disabled with the multi-threading.
+    setDHCPMultiThreadingConfig(false, 4);
+    impl.reset(new HAImpl());
+    ASSERT_NO_THROW_LOG(impl->configure(Element::fromJSON(patched)));
+    EXPECT_FALSE(impl->getConfig()->getEnableMultiThreading());
+    EXPECT_FALSE(impl->getConfig()->getBinaryLeaseUpdates());
+}
+
+// The replication port must be specified for all the servers when the
+// binary lease updates are enabled.
+TEST_F(HAConfigTest, binaryLeaseUpdatesNoReplicationPort) {
+    testInvalidConfig(replaceInConfig(
+        "["
+        "    {"
+        "        \"this-server-name\": \"server1\","
+        "        \"mode\": \"load-balancing\","
+        "        \"trust-anchor\": \"!CA!/kea-ca.crt\","
+        "        \"cert-file\": \"!CA!/kea-client.crt\","
+        "        \"key-file\": \"!CA!/kea-client.key\","
+        "        \"peers\": ["
+        "            {"
+        "                \"name\": \"server1\","
+        "                \"url\": \"https://127.0.0.1:8080/\","
+        "                \"replication-port\": 8090,"
+        "                \"role\": \"primary\""
+        "            },"
+        "            {"
+        "                \"name\": \"server2\","
+        "                \"url\": \"https://127.0.0.1:8081/\","
+        "                \"role\": \"secondary\""
+        "            }"
+        "        ],"
+        "        \"multi-threading\": {"
+        "            \"enable-multi-threading\": true,"
+        "            \"binary-lease-updates\": true"
+        "        }"
+        "    }"
+        "]", "!CA!", TEST_CA_DIR),
+        "'replication-port' must be specified for the server server2 when"
+        " 'binary-lease-updates' is enabled");
+}
+
+// The binary lease updates require the HA multi-threading.
+TEST_F(HAConfigTest, binaryLeaseUpdatesNoMultiThreading) {
+    testInvalidConfig(replaceInConfig(
+        "["
+        "    {"
+        "        \"this-server-name\": \"server1\","
+        "        \"mode\": \"load-balancing\","
+        "        \"trust-anchor\": \"!CA!/kea-ca.crt\","
+        "        \"cert-file\": \"!CA!/kea-client.crt\","
+        "        \"key-file\": \"!CA!/kea-client.key\","
+        "        \"peers\": ["
+        "            {"
+        "                \"name\": \"server1\","
+        "                \"url\": \"https://127.0.0.1:8080/\","
+        "                \"replication-port\": 8090,"
+        "                \"role\": \"primary\""
+        "            },"
+        "            {"
+        "                \"name\": \"server2\","
+        "                \"url\": \"https://127.0.0.1:8081/\","
+        "                \"replication-port\": 8091,"
+        "                \"role\": \"secondary\""
+        "            }"
+        "        ],"
+        "        \"multi-threading\": {"
+        "            \"binary-lease-updates\": true"
+        "        }"
+        "    }"
+        "]", "!CA!", TEST_CA_DIR),
+        "'binary-lease-updates' requires 'enable-multi-threading' to be set to true");
+}
+
+// The binary lease updates require TLS.
+TEST_F(HAConfigTest, binaryLeaseUpdatesNoTls) {
+    testInvalidConfig(
+        "["
+        "    {"
+        "        \"this-server-name\": \"server1\","
+        "        \"mode\": \"load-balancing\","
+        "        \"peers\": ["
+        "            {"
+        "                \"name\": \"server1\","
+        "                \"url\": \"http://127.0.0.1:8080/\","
+        "                \"replication-port\": 8090,"
+        "                \"role\": \"primary\""
+        "            },"
+        "            {"
+        "                \"name\": \"server2\","
+        "                \"url\": \"http://127.0.0.1:8081/\","
+        "                \"replication-port\": 8091,"
+        "                \"role\": \"secondary\""
+        "            }"
+        "        ],"
+        "        \"multi-threading\": {"
+        "            \"enable-multi-threading\": true,"
+        "            \"binary-lease-updates\": true"
+        "        }"
+        "    }"
+        "]",
+        "'binary-lease-updates' requires TLS: the trust-anchor, cert-file and"
+        " key-file parameters must be set for the server server1");
+}
+
 } // end of anonymous namespace
@@ -7,9 +7,13 @@
 #include <config.h>
 
 #include <asiolink/asio_wrapper.h>
+#include <asiolink/crypto_tls.h>
 #include <ha_test.h>
 #include <ha_config.h>
 #include <ha_service.h>
+#include <lease_replication_channel.h>
+#include <dhcpsrv/lease_mgr_factory.h>
+#include <hooks/parking_lots.h>
 #include <http/http_thread_pool.h>
 
 #include <util/multi_threading_mgr.h>
@@ -17,10 +21,13 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+
 using namespace isc::asiolink;
 using namespace isc::config;
 using namespace isc::data;
 using namespace isc::dhcp;
+using namespace isc::hooks;
 
 using namespace isc::ha;
 using namespace isc::ha::test;
@@ -112,6 +119,7 @@ public:
     using HAService::lease_update_backlog_;
     using HAService::client_;
     using HAService::listener_;
+    using HAService::replication_clients_;
 };
 
 /// @brief Pointer to the @c TestHAService.
@@ -434,4 +442,108 @@ TEST_F(HAMtServiceTest, multiThreadingConfigStartup) {
     }
 }
 
+// Verifies that the lease updates are sent over the binary lease
+// replication channel when the binary lease updates are enabled.
+TEST_F(HAMtServiceTest, binaryLeaseUpdates) {
+
+    // Build the HA JSON configuration. The lease updates are sent to the
+    // replication port of the backup server.
+    std::stringstream ss;
+    ss <<
+        "["
+        "    {"
+        "        \"this-server-name\": \"server1\","
+        "        \"mode\": \"passive-backup\","
+        "        \"wait-backup-ack\": true,"
+        "        \"trust-anchor\": \"" << TEST_CA_DIR << "/kea-ca.crt\","
+        "        \"cert-file\": \"" << TEST_CA_DIR << "/kea-client.crt\","
+        "        \"key-file\": \"" << TEST_CA_DIR << "/kea-client.key\","
+        "        \"peers\": ["
+        "            {"
+        "                \"name\": \"server1\","
+        "                \"url\": \"https://127.0.0.1:18123/\","
+        "                \"replication-port\": 18133,"
+        "                \"role\": \"primary\""
+        "            },"
+        "            {"
+        "                \"name\": \"server2\","
+        "                \"url\": \"https://127.0.0.1:18124/\","
+        "                \"replication-port\": 18134,"
+        "                \"role\": \"backup\""
+        "            }"
+        "        ],"
+        "        \"multi-threading\": {"
+        "            \"enable-multi-threading\": true,"
+        "            \"http-dedicated-listener\": true,"
+        "            \"http-listener-threads\": 2,"
+        "            \"http-client-threads\": 2,"
+        "            \"binary-lease-updates\": true"
+        "        }"
+        "    }"
+        "]";
+    ConstElementPtr config_json;
+    ASSERT_NO_THROW_LOG(config_json = Element::fromJSON(ss.str()));
+
+    setDHCPMultiThreadingConfig(true, 2);
+
+    HAConfigPtr ha_config(new HAConfig());
+    HAConfigParser parser;
+    ASSERT_NO_THROW_LOG(parser.parse(ha_config, config_json));
+    ASSERT_TRUE(ha_config->getBinaryLeaseUpdates());
+
+    // The backup server is emulated by a lease replication listener storing
+    // the received leases in the lease database.
+    ASSERT_NO_THROW(LeaseMgrFactory::create("universe=4 type=memfile persist=false"));
+    TlsContextPtr server_ctx;
+    ASSERT_NO_THROW_LOG(TlsContext::configure(server_ctx, TlsRole::SERVER,
+                                              TEST_CA_DIR "/kea-ca.crt",
+                                              TEST_CA_DIR "/kea-server.crt",
+                                              TEST_CA_DIR "/kea-server.key",
+                                              true));
+    LeaseReplicationListener backup(IOAddress("127.0.0.1"), 18134, server_ctx, 2);
+    ASSERT_NO_THROW_LOG(backup.start());
+
+    TestHAServicePtr service;
+    ASSERT_NO_THROW_LOG(service.reset(new TestHAService(io_service_, network_state_,
+                                                        ha_config)));
+    ASSERT_EQ(1, service->replication_clients_.count("server2"));
+    ASSERT_NO_THROW_LOG(service->startClientAndListener());
+    service->verboseTransition(HA_PASSIVE_BACKUP_ST);
+
+    // Create parking lot where query is going to be parked and unparked.
+    ParkingLotPtr parking_lot(new ParkingLot());
+    ParkingLotHandlePtr parking_lot_handle(new ParkingLotHandle(parking_lot));
+
+    Pkt4Ptr query(new Pkt4(DHCPREQUEST, 1234));
+    Lease4CollectionPtr leases4(new Lease4Collection());
+    HWAddrPtr hwaddr(new HWAddr(std::vector<uint8_t>(6, 1), HTYPE_ETHER));
+    leases4->push_back(Lease4Ptr(new Lease4(IOAddress("192.1.2.3"), hwaddr,
+                                            static_cast<const uint8_t*>(0), 0,
+                                            60, 0, 1)));
+    Lease4CollectionPtr deleted_leases4(new Lease4Collection());
+
+    std::atomic<bool> unpark_called(false);
+    ASSERT_NO_THROW(parking_lot->park(query, [&unpark_called] {
+        unpark_called = true;
+    }));
+    ASSERT_NO_THROW(parking_lot->reference(query));
+
+    EXPECT_EQ(1, service->asyncSendLeaseUpdates(query, leases4, deleted_leases4,
+                                                parking_lot_handle));
+
+    // The update is acknowledged by a thread of the HTTP client pool.
+    for (int i = 0; (i < 1000) && !unpark_called; ++i) {
+        runIOService(10);
+    }
+    EXPECT_TRUE(unpark_called);
+    EXPECT_EQ(0, service->pendingRequestSize());
+
+    // The lease was received over the lease replication channel.
+    EXPECT_TRUE(LeaseMgrFactory::instance().getLease4(IOAddress("192.1.2.3")));
+
+    ASSERT_NO_THROW_LOG(service->stopClientAndListener());
+    backup.stop();
+    LeaseMgrFactory::destroy();
+}
+
 } // end of anonymous namespace
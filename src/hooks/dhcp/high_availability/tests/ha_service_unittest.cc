@@ -46,6 +46,7 @@
 #include <gtest/gtest.h>
 
 #include <functional>
+#include <map>
 #include <sstream>
 #include <set>
 #include <string>
@@ -2127,6 +2128,142 @@ TEST_F(HAServiceTest, hotStandbyScopeSelectionThisStandby) {
     }
 }
 
+// This test verifies that with more than two active servers a server
+// takes over only the scope of its partner.
+TEST_F(HAServiceTest, partnerDownPartnerScope) {
+    // Create the configuration of two failover pairs: server1 and server2,
+    // server3 and server4.
+    HAConfigPtr config_storage = createPartnersConfiguration(2);
+    TestHAService service(io_service_, network_state_, config_storage);
+
+    // In the load-balancing state the server serves its own scope only.
+    ASSERT_NO_THROW(service.verboseTransition(HA_LOAD_BALANCING_ST));
+    ASSERT_NO_THROW(service.runModel(HAService::NOP_EVT));
+    EXPECT_TRUE(service.query_filter_.amServingScope("server1"));
+    EXPECT_FALSE(service.query_filter_.amServingScope("server2"));
+    EXPECT_FALSE(service.query_filter_.amServingScope("server3"));
+    EXPECT_FALSE(service.query_filter_.amServingScope("server4"));
+
+    // When the partner is down the server takes over the partner's scope.
+    ASSERT_NO_THROW(service.verboseTransition(HA_PARTNER_DOWN_ST));
+    ASSERT_NO_THROW(service.runModel(HAService::NOP_EVT));
+    EXPECT_TRUE(service.query_filter_.amServingScope("server1"));
+    EXPECT_TRUE(service.query_filter_.amServingScope("server2"));
+
+    // The scopes of the other pair are still served by that pair.
+    EXPECT_FALSE(service.query_filter_.amServingScope("server3"));
+    EXPECT_FALSE(service.query_filter_.amServingScope("server4"));
+}
+
+// This test verifies that with more than two active servers only the
+// queries hashed to the partner are used to detect the partner failure.
+TEST_F(HAServiceTest, inScopePartnerQueriesAnalyzed) {
+    HAConfigPtr config_storage = createPartnersConfiguration(2);
+
+    // Simulate the communication interrupted condition.
+    NakedCommunicationState4Ptr state(new NakedCommunicationState4(io_service_,
+                                                                   config_storage));
+    state->modifyPokeTime(-1000);
+    ASSERT_TRUE(state->isCommunicationInterrupted());
+
+    // Serve the scope of this server.
+    TestHAService service(io_service_, network_state_, config_storage);
+    ASSERT_NO_THROW(service.verboseTransition(HA_LOAD_BALANCING_ST));
+    ASSERT_NO_THROW(service.runModel(HAService::NOP_EVT));
+    service.communication_state_ = state;
+
+    std::map<std::string, size_t> queries;
+    const unsigned queries_num = 1000;
+    for (unsigned i = 0; i < queries_num; ++i) {
+        Pkt4Ptr query4 = createQuery4(randomKey(HWAddr::ETHERNET_HWADDR_LEN));
+        // Make sure the query is taken into account when analyzed.
+        query4->setSecs(0x00EF);
+        bool in_scope = service.inScope(query4);
+        for (auto server : { "server1", "server2", "server3", "server4" }) {
+            if (query4->inClass(ClientClass(std::string("HA_") + server))) {
+                ASSERT_EQ(in_scope, std::string(server) == "server1");
+                ++queries[server];
+            }
+        }
+    }
+
+    // The queries are distributed among the four servers.
+    ASSERT_EQ(4, queries.size());
+    EXPECT_EQ(queries_num, queries["server1"] + queries["server2"] +
+              queries["server3"] + queries["server4"]);
+
+    // Only the queries of the partner have been analyzed.
+    EXPECT_EQ(queries["server2"], state->getAnalyzedMessagesCount());
+}
+
+// This test verifies that with more than two active servers the lease
+// updates are sent to the partner and not to the other active servers.
+TEST_F(HAServiceTest, sendUpdatesPartnerOnly) {
+    // Start HTTP servers. The second one is the partner, the third one is
+    // server3, which is active in the other failover pair.
+    ASSERT_NO_THROW({
+            listener_->start();
+            listener2_->start();
+            listener3_->start();
+    });
+
+    HAConfigPtr config_storage = createPartnersConfiguration(2);
+
+    // Create parking lot where query is going to be parked and unparked.
+    ParkingLotPtr parking_lot(new ParkingLot());
+    ParkingLotHandlePtr parking_lot_handle(new ParkingLotHandle(parking_lot));
+
+    // Create query.
+    Pkt4Ptr query(new Pkt4(DHCPREQUEST, 1234));
+
+    // Create leases collection and put the lease there.
+    Lease4CollectionPtr leases4(new Lease4Collection());
+    HWAddrPtr hwaddr(new HWAddr(std::vector<uint8_t>(6, 1), HTYPE_ETHER));
+    Lease4Ptr lease4(new Lease4(IOAddress("192.1.2.3"), hwaddr,
+                                static_cast<const uint8_t*>(0), 0,
+                                60, 0, 1));
+    leases4->push_back(lease4);
+
+    // Create deleted leases collection and put the lease there too.
+    Lease4CollectionPtr deleted_leases4(new Lease4Collection());
+    Lease4Ptr deleted_lease4(new Lease4(IOAddress("192.2.3.4"), hwaddr,
+                                        static_cast<const uint8_t*>(0), 0,
+                                        60, 0, 1));
+    deleted_leases4->push_back(deleted_lease4);
+
+    createSTService(network_state_, config_storage);
+    service_->transition(HA_LOAD_BALANCING_ST, HAService::NOP_EVT);
+
+    // Only the partner acknowledges the updates: the backup server is not
+    // waited for.
+    EXPECT_EQ(1, service_->asyncSendLeaseUpdates(query, leases4, deleted_leases4,
+                                                 parking_lot_handle));
+    EXPECT_EQ(2, service_->getPendingRequest(query));
+
+    bool unpark_called = false;
+    ASSERT_NO_THROW(parking_lot->park(query, [&unpark_called] {
+        unpark_called = true;
+    }));
+    ASSERT_NO_THROW(parking_lot->reference(query));
+
+    // Actually perform the lease updates.
+    ASSERT_NO_THROW(runIOService(TEST_TIMEOUT, [this]() {
+        return (service_->pendingRequestSize() == 0);
+    }));
+    EXPECT_TRUE(unpark_called);
+
+    // The partner has received the updates.
+    EXPECT_EQ(2, factory2_->getResponseCreator()->getReceivedRequests().size());
+    EXPECT_TRUE(factory2_->getResponseCreator()->findRequest("lease4-update",
+                                                             "192.1.2.3"));
+    EXPECT_TRUE(factory2_->getResponseCreator()->findRequest("lease4-del",
+                                                             "192.2.3.4"));
+
+    // The other active server and this server have received nothing.
+    EXPECT_TRUE(factory3_->getResponseCreator()->getReceivedRequests().empty());
+    EXPECT_TRUE(factory_->getResponseCreator()->getReceivedRequests().empty());
+}
+
 // Test scenario when all lease updates are sent successfully.
 TEST_F(HAServiceTest, sendSuccessfulUpdates) {
     testSendSuccessfulUpdates();
@@ -234,6 +234,27 @@ HATest::createValidPassiveBackupConfiguration() const {
     return (config_storage);
 }
 
+HAConfigPtr
+HATest::createPartnersConfiguration(const unsigned pairs) const {
+    std::ostringstream config_text;
+    config_text << "[ { \"this-server-name\": \"server1\","
+                << " \"mode\": \"load-balancing\", \"peers\": [";
+    for (unsigned i = 0; i < 2 * pairs; ++i) {
+        bool primary = ((i % 2) == 0);
+        config_text << "{ \"name\": \"server" << i + 1 << "\","
+                    << " \"url\": \"http://127.0.0.1:" << 18123 + i << "/\","
+                    << " \"role\": \"" << (primary ? "primary" : "secondary") << "\","
+                    << " \"partner\": \"server" << (primary ? i + 2 : i) << "\" },";
+    }
+    config_text << "{ \"name\": \"backup\", \"url\": \"http://127.0.0.1:18100/\","
+                << " \"role\": \"backup\" } ] } ]";
+
+    HAConfigPtr config_storage(new HAConfig());
+    HAConfigParser parser;
+    parser.parse(config_storage, Element::fromJSON(config_text.str()));
+    return (config_storage);
+}
+
 void
 HATest::checkAnswer(const isc::data::ConstElementPtr& answer,
                     const int exp_status,
@@ -161,6 +161,15 @@ public:
     /// @return Pointer to the parsed configuration.
     HAConfigPtr createValidPassiveBackupConfiguration() const;
 
+    /// @brief Return load balancing configuration with failover pairs.
+    ///
+    /// The pairs are made of the server2i+1 primary and server2i+2
+    /// secondary servers. A backup server "backup" is appended.
+    ///
+    /// @param pairs Number of failover pairs.
+    /// @return Pointer to the parsed configuration of server1.
+    HAConfigPtr createPartnersConfiguration(const unsigned pairs) const;
+
     /// @brief Checks the status code and message against expected values.
     ///
     /// @param answer Element set containing an integer response and string
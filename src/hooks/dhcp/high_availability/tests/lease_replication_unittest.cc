@@ -0,0 +1,465 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <lease_replication.h>
+#include <lease_replication_channel.h>
+#include <asiolink/interval_timer.h>
+#include <asiolink/io_address.h>
+#include <asiolink/io_service.h>
+#include <asiolink/crypto_tls.h>
+#include <cc/data.h>
+#include <dhcp/duid.h>
+#include <dhcp/hwaddr.h>
+#include <dhcpsrv/lease_mgr_factory.h>
+#include <stats/stats_mgr.h>
+#include <util/multi_threading_mgr.h>
+
+#include <boost/make_shared.hpp>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+using namespace isc;
+using namespace isc::asiolink;
+using namespace isc::data;
+using namespace isc::dhcp;
+using namespace isc::ha;
+using namespace isc::stats;
+using namespace isc::util;
+
+namespace {
+
+/// @brief Port of the lease replication listener used in the tests.
+const uint16_t REPLICATION_PORT = 18126;
+
+/// @brief Test TLS context class exposing protected methods.
+class TestTlsContext : public TlsContext {
+public:
+    /// @brief Constructor.
+    ///
+    /// @param role The TLS role client or server.
+    explicit TestTlsContext(TlsRole role) : TlsContext(role) { }
+
+    /// @brief Make protected methods visible in tests.
+    using TlsContext::setCertRequired;
+    using TlsContext::loadCaFile;
+    using TlsContext::loadCertFile;
+    using TlsContext::loadKeyFile;
+};
+
+/// @brief Returns a TLS context using the test certificates.
+///
+/// The peer certificate is required.
+///
+/// @param role The TLS role client or server.
+/// @param ca Name of the trust anchor file.
+/// @param cert Name of the certificate file, empty for no certificate.
+/// @param key Name of the private key file.
+TlsContextPtr
+createTlsContext(TlsRole role, const std::string& ca,
+                 const std::string& cert = "", const std::string& key = "") {
+    const std::string dir(TEST_CA_DIR);
+    boost::shared_ptr<TestTlsContext> ctx(new TestTlsContext(role));
+    ctx->setCertRequired(true);
+    ctx->loadCaFile(dir + "/" + ca);
+    if (!cert.empty()) {
+        ctx->loadCertFile(dir + "/" + cert);
+        ctx->loadKeyFile(dir + "/" + key);
+    }
+    return (ctx);
+}
+
+/// @brief Returns a DHCPv4 lease for the tests.
+///
+/// @param address Leased address.
+Lease4Ptr
+createLease4(const std::string& address) {
+    HWAddrPtr hwaddr = boost::make_shared<HWAddr>(std::vector<uint8_t>(6, 0xA),
+                                                  HTYPE_ETHER);
+    ClientIdPtr client_id = boost::make_shared<ClientId>(std::vector<uint8_t>(8, 0xB));
+    Lease4Ptr lease = boost::make_shared<Lease4>(IOAddress(address), hwaddr,
+                                                 client_id, 60, 1000, 1);
+    lease->hostname_ = "host.example.org";
+    lease->fqdn_fwd_ = true;
+    lease->setContext(Element::fromJSON("{ \"foo\": \"bar\" }"));
+    return (lease);
+}
+
+/// @brief Returns a DHCPv6 lease for the tests.
+///
+/// @param address Leased prefix.
+Lease6Ptr
+createLease6(const std::string& address) {
+    DuidPtr duid = boost::make_shared<DUID>(std::vector<uint8_t>(10, 0xC));
+    Lease6Ptr lease = boost::make_shared<Lease6>(Lease::TYPE_PD, IOAddress(address),
+                                                 duid, 1234, 30, 60, 1,
+                                                 HWAddrPtr(), 56);
+    lease->fqdn_rev_ = true;
+    return (lease);
+}
+
+// This test verifies that the DHCPv4 lease messages can be encoded and
+// decoded.
+TEST(LeaseReplicationCodecTest, lease4) {
+    Lease4Ptr lease = createLease4("192.0.2.1");
+    OutputBuffer out(0);
+    ASSERT_NO_THROW(LeaseReplicationCodec::encodeLease4(out, LeaseReplicationCodec::LEASE4_UPDATE,
+                                                        7, *lease));
+
+    const uint8_t* data = static_cast<const uint8_t*>(out.getData());
+    ASSERT_EQ(out.getLength(), LeaseReplicationCodec::getMessageLength(data, out.getLength()));
+
+    InputBuffer in(data, out.getLength());
+    LeaseReplicationCodec::MessageType type;
+    uint32_t sequence = 0;
+    ASSERT_NO_THROW(LeaseReplicationCodec::decodeHeader(in, type, sequence));
+    EXPECT_EQ(LeaseReplicationCodec::LEASE4_UPDATE, type);
+    EXPECT_EQ(7, sequence);
+
+    Lease4Ptr decoded;
+    ASSERT_NO_THROW(decoded = LeaseReplicationCodec::decodeLease4(in));
+    ASSERT_TRUE(decoded);
+    EXPECT_TRUE(*decoded == *lease);
+    EXPECT_EQ(0, in.getLength() - in.getPosition());
+}
+
+// This test verifies that the DHCPv6 lease messages can be encoded and
+// decoded.
+TEST(LeaseReplicationCodecTest, lease6) {
+    Lease6Ptr lease = createLease6("2001:db8:1::");
+    OutputBuffer out(0);
+    ASSERT_NO_THROW(LeaseReplicationCodec::encodeLease6(out, LeaseReplicationCodec::LEASE6_DELETE,
+                                                        0xffffffff, *lease));
+
+    const uint8_t* data = static_cast<const uint8_t*>(out.getData());
+    InputBuffer in(data, out.getLength());
+    LeaseReplicationCodec::MessageType type;
+    uint32_t sequence = 0;
+    ASSERT_NO_THROW(LeaseReplicationCodec::decodeHeader(in, type, sequence));
+    EXPECT_EQ(LeaseReplicationCodec::LEASE6_DELETE, type);
+    EXPECT_EQ(0xffffffff, sequence);
+
+    Lease6Ptr decoded;
+    ASSERT_NO_THROW(decoded = LeaseReplicationCodec::decodeLease6(in));
+    ASSERT_TRUE(decoded);
+    EXPECT_TRUE(*decoded == *lease);
+}
+
+// This test verifies that the acknowledgments can be encoded and decoded
+// and that the message boundaries are found in the received data.
+TEST(LeaseReplicationCodecTest, ackAndLength) {
+    OutputBuffer out(0);
+    LeaseReplicationCodec::encodeAck(out, 1, LeaseReplicationCodec::STATUS_SUCCESS, "");
+    size_t first_length = out.getLength();
+    LeaseReplicationCodec::encodeAck(out, 2, LeaseReplicationCodec::STATUS_EMPTY,
+                                     "IPv4 lease not found.");
+    const uint8_t* data = static_cast<const uint8_t*>(out.getData());
+
+    // Incomplete messages.
+    EXPECT_EQ(0, LeaseReplicationCodec::getMessageLength(data, 3));
+    EXPECT_EQ(0, LeaseReplicationCodec::getMessageLength(data, first_length - 1));
+
+    // Two complete messages.
+    ASSERT_EQ(first_length, LeaseReplicationCodec::getMessageLength(data, out.getLength()));
+    size_t second_length = out.getLength() - first_length;
+    ASSERT_EQ(second_length, LeaseReplicationCodec::getMessageLength(data + first_length,
+                                                                     second_length));
+
+    InputBuffer in(data + first_length, second_length);
+    LeaseReplicationCodec::MessageType type;
+    uint32_t sequence = 0;
+    ASSERT_NO_THROW(LeaseReplicationCodec::decodeHeader(in, type, sequence));
+    EXPECT_EQ(LeaseReplicationCodec::ACK, type);
+    EXPECT_EQ(2, sequence);
+    std::string text;
+    EXPECT_EQ(LeaseReplicationCodec::STATUS_EMPTY, LeaseReplicationCodec::decodeAck(in, text));
+    EXPECT_EQ("IPv4 lease not found.", text);
+}
+
+// This test verifies that malformed messages are rejected.
+TEST(LeaseReplicationCodecTest, malformed) {
+    // Invalid length.
+    std::vector<uint8_t> data = { 0xff, 0xff, 0xff, 0xff, 1 };
+    EXPECT_THROW(LeaseReplicationCodec::getMessageLength(&data[0], data.size()),
+                 LeaseReplicationError);
+
+    // Invalid message type.
+    data = { 0, 0, 0, 5, 99, 0, 0, 0, 1 };
+    InputBuffer in(&data[0], data.size());
+    LeaseReplicationCodec::MessageType type;
+    uint32_t sequence = 0;
+    EXPECT_THROW(LeaseReplicationCodec::decodeHeader(in, type, sequence),
+                 LeaseReplicationError);
+
+    // Truncated lease.
+    Lease4Ptr lease = createLease4("192.0.2.1");
+    OutputBuffer out(0);
+    LeaseReplicationCodec::encodeLease4(out, LeaseReplicationCodec::LEASE4_UPDATE, 1, *lease);
+    InputBuffer truncated(out.getData(), out.getLength() - 4);
+    ASSERT_NO_THROW(LeaseReplicationCodec::decodeHeader(truncated, type, sequence));
+    EXPECT_THROW(LeaseReplicationCodec::decodeLease4(truncated), LeaseReplicationError);
+}
+
+/// @brief Test fixture class for the lease replication channel.
+class LeaseReplicationChannelTest : public ::testing::Test {
+public:
+
+    /// @brief Constructor.
+    LeaseReplicationChannelTest()
+        : io_service_(new IOService()), timer_(*io_service_) {
+        MultiThreadingMgr::instance().setMode(true);
+        StatsMgr::instance().removeAll();
+        LeaseMgrFactory::create("universe=4 type=memfile persist=false");
+    }
+
+    /// @brief Destructor.
+    virtual ~LeaseReplicationChannelTest() {
+        timer_.cancel();
+        io_service_->poll();
+        LeaseMgrFactory::destroy();
+        StatsMgr::instance().removeAll();
+        MultiThreadingMgr::instance().setMode(false);
+    }
+
+    /// @brief Applies an encoded DHCPv4 lease message.
+    ///
+    /// @param type Message type.
+    /// @param lease The lease.
+    /// @param [out] text Error text.
+    /// @return Status of the update.
+    LeaseReplicationCodec::Status
+    processLease4(const LeaseReplicationCodec::MessageType type,
+                  const Lease4& lease, std::string& text) {
+        OutputBuffer out(0);
+        LeaseReplicationCodec::encodeLease4(out, type, 1, lease);
+        InputBuffer in(out.getData(), out.getLength());
+        uint32_t sequence;
+        LeaseReplicationCodec::MessageType decoded_type;
+        LeaseReplicationCodec::decodeHeader(in, decoded_type, sequence);
+        return (LeaseReplicationListener::processUpdate(decoded_type, in, text));
+    }
+
+    /// @brief Returns the value of the assigned addresses statistic of the
+    /// subnet 1.
+    int64_t getAssigned() {
+        ObservationPtr stat = StatsMgr::instance().getObservation(
+            StatsMgr::generateName("subnet", 1, "assigned-addresses"));
+        return (stat ? stat->getInteger().first : 0);
+    }
+
+    /// @brief Runs the IO service until a condition is met or a timeout.
+    ///
+    /// @param cond Condition.
+    void runIOService(const std::function<bool()>& cond) {
+        bool timeout = false;
+        timer_.setup([&timeout]() { timeout = true; }, 5000, IntervalTimer::ONE_SHOT);
+        while (!timeout && !cond()) {
+            io_service_->run_one();
+        }
+        timer_.cancel();
+        ASSERT_FALSE(timeout) << "timeout while waiting for the lease replication";
+    }
+
+    /// @brief Sends a DHCPv4 lease update over TLS.
+    ///
+    /// @param server_ctx TLS context of the listener.
+    /// @param client_ctx TLS context of the client.
+    /// @param [out] error Error text, empty unless the update could not be
+    /// delivered.
+    /// @return Status of the update.
+    LeaseReplicationCodec::Status
+    sendTls(const TlsContextPtr& server_ctx, const TlsContextPtr& client_ctx,
+            std::string& error) {
+        LeaseReplicationListener listener(IOAddress("127.0.0.1"), REPLICATION_PORT,
+                                          server_ctx, 2);
+        EXPECT_NO_THROW(listener.start());
+
+        LeaseReplicationClientPtr client(new LeaseReplicationClient(*io_service_,
+                                                                    IOAddress("127.0.0.1"),
+                                                                    REPLICATION_PORT,
+                                                                    client_ctx,
+                                                                    2000));
+        bool done = false;
+        LeaseReplicationCodec::Status result = LeaseReplicationCodec::STATUS_ERROR;
+        Lease4Ptr lease = createLease4("192.0.2.1");
+        client->asyncSendLease(LeaseReplicationCodec::LEASE4_UPDATE, *lease,
+                               [&done, &result, &error](const std::string& err,
+                                                        const LeaseReplicationCodec::Status status,
+                                                        const std::string&) {
+            done = true;
+            result = status;
+            error = err;
+        });
+        runIOService([&done]() { return (done); });
+        client->close();
+        listener.stop();
+        return (result);
+    }
+
+    /// @brief IO service used by the client.
+    IOServicePtr io_service_;
+
+    /// @brief Timer limiting the duration of the test.
+    IntervalTimer timer_;
+};
+
+// This test verifies that the DHCPv4 lease updates and deletes are applied
+// to the lease database and to the statistics.
+TEST_F(LeaseReplicationChannelTest, processUpdate4) {
+    Lease4Ptr lease = createLease4("192.0.2.1");
+    std::string text;
+
+    // The lease is created.
+    EXPECT_EQ(LeaseReplicationCodec::STATUS_SUCCESS,
+              processLease4(LeaseReplicationCodec::LEASE4_UPDATE, *lease, text));
+    Lease4Ptr stored = LeaseMgrFactory::instance().getLease4(lease->addr_);
+    ASSERT_TRUE(stored);
+    EXPECT_EQ("host.example.org", stored->hostname_);
+    EXPECT_EQ(1, getAssigned());
+
+    // The lease is updated.
+    lease->hostname_ = "other.example.org";
+    lease->cltt_ += 10;
+    EXPECT_EQ(LeaseReplicationCodec::STATUS_SUCCESS,
+              processLease4(LeaseReplicationCodec::LEASE4_UPDATE, *lease, text));
+    stored = LeaseMgrFactory::instance().getLease4(lease->addr_);
+    ASSERT_TRUE(stored);
+    EXPECT_EQ("other.example.org", stored->hostname_);
+    EXPECT_EQ(1, getAssigned());
+
+    // The lease is deleted.
+    EXPECT_EQ(LeaseReplicationCodec::STATUS_SUCCESS,
+              processLease4(LeaseReplicationCodec::LEASE4_DELETE, *lease, text));
+    EXPECT_FALSE(LeaseMgrFactory::instance().getLease4(lease->addr_));
+    EXPECT_EQ(0, getAssigned());
+
+    // Deleting it again reports that it doesn't exist.
+    EXPECT_EQ(LeaseReplicationCodec::STATUS_EMPTY,
+              processLease4(LeaseReplicationCodec::LEASE4_DELETE, *lease, text));
+    EXPECT_EQ("IPv4 lease not found.", text);
+}
+
+// This test verifies that the lease updates sent by the client are applied
+// by the listener and acknowledged in order.
+TEST_F(LeaseReplicationChannelTest, loopback) {
+    LeaseReplicationListener listener(IOAddress("127.0.0.1"), REPLICATION_PORT,
+                                      TlsContextPtr(), 2);
+    ASSERT_NO_THROW(listener.start());
+
+    LeaseReplicationClientPtr client(new LeaseReplicationClient(*io_service_,
+                                                                IOAddress("127.0.0.1"),
+                                                                REPLICATION_PORT,
+                                                                TlsContextPtr(),
+                                                                5000));
+
+    // Send pipelined updates, the last one deletes a lease which doesn't
+    // exist.
+    std::vector<LeaseReplicationCodec::Status> statuses;
+    std::vector<std::string> errors;
+    auto handler = [&statuses, &errors](const std::string& error,
+                                        const LeaseReplicationCodec::Status status,
+                                        const std::string&) {
+        errors.push_back(error);
+        statuses.push_back(status);
+    };
+    for (auto i = 1; i <= 10; ++i) {
+        Lease4Ptr lease = createLease4("192.0.2." + std::to_string(i));
+        client->asyncSendLease(LeaseReplicationCodec::LEASE4_UPDATE, *lease, handler);
+    }
+    Lease4Ptr missing = createLease4("192.0.2.100");
+    client->asyncSendLease(LeaseReplicationCodec::LEASE4_DELETE, *missing, handler);
+
+    ASSERT_NO_FATAL_FAILURE(runIOService([&statuses]() { return (statuses.size() == 11); }));
+    EXPECT_EQ(0, client->getPendingCount());
+    for (auto i = 0; i < 10; ++i) {
+        EXPECT_TRUE(errors[i].empty());
+        EXPECT_EQ(LeaseReplicationCodec::STATUS_SUCCESS, statuses[i]);
+    }
+    EXPECT_EQ(LeaseReplicationCodec::STATUS_EMPTY, statuses[10]);
+
+    // The leases were stored by the listener.
+    EXPECT_TRUE(LeaseMgrFactory::instance().getLease4(IOAddress("192.0.2.10")));
+    EXPECT_EQ(10, getAssigned());
+
+    // Stop the listener: the next update fails.
+    client->close();
+    listener.stop();
+    statuses.clear();
+    errors.clear();
+    client->asyncSendLease(LeaseReplicationCodec::LEASE4_UPDATE, *missing, handler);
+    ASSERT_NO_FATAL_FAILURE(runIOService([&statuses]() { return (!statuses.empty()); }));
+    EXPECT_FALSE(errors[0].empty());
+    EXPECT_EQ(LeaseReplicationCodec::STATUS_ERROR, statuses[0]);
+    EXPECT_EQ(0, client->getPendingCount());
+}
+
+// This test verifies that the lease updates are delivered over TLS when
+// the listener requires the client certificates.
+TEST_F(LeaseReplicationChannelTest, tlsLoopback) {
+    TlsContextPtr server_ctx = createTlsContext(TlsRole::SERVER, "kea-ca.crt",
+                                                "kea-server.crt", "kea-server.key");
+    TlsContextPtr client_ctx = createTlsContext(TlsRole::CLIENT, "kea-ca.crt",
+                                                "kea-client.crt", "kea-client.key");
+    std::string error;
+    EXPECT_EQ(LeaseReplicationCodec::STATUS_SUCCESS,
+              sendTls(server_ctx, client_ctx, error));
+    EXPECT_TRUE(error.empty()) << error;
+
+    // The lease was stored by the listener.
+    EXPECT_TRUE(LeaseMgrFactory::instance().getLease4(IOAddress("192.0.2.1")));
+}
+
+// This test verifies that a client without certificate is refused.
+TEST_F(LeaseReplicationChannelTest, tlsNoClientCert) {
+    TlsContextPtr server_ctx = createTlsContext(TlsRole::SERVER, "kea-ca.crt",
+                                                "kea-server.crt", "kea-server.key");
+    TlsContextPtr client_ctx = createTlsContext(TlsRole::CLIENT, "kea-ca.crt");
+    std::string error;
+    EXPECT_EQ(LeaseReplicationCodec::STATUS_ERROR,
+              sendTls(server_ctx, client_ctx, error));
+    EXPECT_FALSE(error.empty());
+    EXPECT_FALSE(LeaseMgrFactory::instance().getLease4(IOAddress("192.0.2.1")));
+}
+
+// This test verifies that a client certificate signed by another CA is
+// refused.
+TEST_F(LeaseReplicationChannelTest, tlsClientOtherCa) {
+    TlsContextPtr server_ctx = createTlsContext(TlsRole::SERVER, "kea-ca.crt",
+                                                "kea-server.crt", "kea-server.key");
+    TlsContextPtr client_ctx = createTlsContext(TlsRole::CLIENT, "kea-ca.crt",
+                                                "kea-other.crt", "kea-other.key");
+    std::string error;
+    EXPECT_EQ(LeaseReplicationCodec::STATUS_ERROR,
+              sendTls(server_ctx, client_ctx, error));
+    EXPECT_FALSE(error.empty());
+    EXPECT_FALSE(LeaseMgrFactory::instance().getLease4(IOAddress("192.0.2.1")));
+}
+
+// This test verifies that the client refuses a listener whose certificate
+// is not signed by its trust anchor.
+TEST_F(LeaseReplicationChannelTest, tlsServerWrongCa) {
+    TlsContextPtr server_ctx = createTlsContext(TlsRole::SERVER, "kea-ca.crt",
+                                                "kea-server.crt", "kea-server.key");
+    TlsContextPtr client_ctx = createTlsContext(TlsRole::CLIENT, "kea-self.crt",
+                                                "kea-client.crt", "kea-client.key");
+    std::string error;
+    EXPECT_EQ(LeaseReplicationCodec::STATUS_ERROR,
+              sendTls(server_ctx, client_ctx, error));
+    EXPECT_FALSE(error.empty());
+    EXPECT_FALSE(LeaseMgrFactory::instance().getLease4(IOAddress("192.0.2.1")));
+}
+
+// This test verifies that the listener requires multi-threading.
+TEST_F(LeaseReplicationChannelTest, requiresMultiThreading) {
+    MultiThreadingMgr::instance().setMode(false);
+    LeaseReplicationListener listener(IOAddress("127.0.0.1"), REPLICATION_PORT,
+                                      TlsContextPtr());
+    EXPECT_THROW(listener.start(), InvalidOperation);
+}
+
+}
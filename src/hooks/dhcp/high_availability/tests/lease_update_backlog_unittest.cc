@@ -14,6 +14,8 @@
 #include <boost/make_shared.hpp>
 #include <boost/pointer_cast.hpp>
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
 
 using namespace isc::asiolink;
 using namespace isc::dhcp;
@@ -88,4 +90,192 @@ TEST(LeaseUpdateBacklogTest, clear) {
     EXPECT_EQ(0, backlog.size());
 }
 
+// This test verifies that only the last update of a DHCPv4 lease is
+// held in the queue.
+TEST(LeaseUpdateBacklogTest, coalesce4) {
+    LeaseUpdateBacklog backlog(2);
+
+    HWAddrPtr hwaddr = boost::make_shared<HWAddr>(std::vector<uint8_t>(6, 1), HTYPE_ETHER);
+    Lease4Ptr lease1 = boost::make_shared<Lease4>(IOAddress("192.0.2.1"), hwaddr,
+                                                  ClientIdPtr(), 60, 0, 1);
+    Lease4Ptr lease2 = boost::make_shared<Lease4>(IOAddress("192.0.2.2"), hwaddr,
+                                                  ClientIdPtr(), 60, 0, 1);
+    Lease4Ptr lease1_updated = boost::make_shared<Lease4>(*lease1);
+    lease1_updated->valid_lft_ = 120;
+
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, lease1));
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, lease2));
+
+    // The queue is full but the update replaces the first one.
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, lease1_updated));
+    EXPECT_FALSE(backlog.wasOverflown());
+    EXPECT_EQ(2, backlog.size());
+
+    // The replaced update has been moved to the end of the queue.
+    LeaseUpdateBacklog::OpType op_type;
+    EXPECT_EQ(lease2, backlog.pop(op_type));
+    EXPECT_EQ(LeaseUpdateBacklog::ADD, op_type);
+    EXPECT_EQ(lease1_updated, backlog.pop(op_type));
+    EXPECT_EQ(LeaseUpdateBacklog::ADD, op_type);
+    EXPECT_FALSE(backlog.pop(op_type));
+
+    // The lease deletion replaces the lease update too.
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, lease1));
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::DELETE, lease1));
+    EXPECT_EQ(1, backlog.size());
+    EXPECT_EQ(lease1, backlog.pop(op_type));
+    EXPECT_EQ(LeaseUpdateBacklog::DELETE, op_type);
+}
+
+// This test verifies that only the last update of a DHCPv6 lease is
+// held in the queue and that the leases of different types are distinct.
+TEST(LeaseUpdateBacklogTest, coalesce6) {
+    LeaseUpdateBacklog backlog(5);
+
+    DuidPtr duid = boost::make_shared<DUID>(std::vector<uint8_t>(8, 2));
+    Lease6Ptr lease_na = boost::make_shared<Lease6>(Lease::TYPE_NA, IOAddress("2001:db8:1::"),
+                                                    duid, 1234, 50, 60, 1);
+    Lease6Ptr lease_pd = boost::make_shared<Lease6>(Lease::TYPE_PD, IOAddress("2001:db8:1::"),
+                                                    duid, 1234, 50, 60, 1, HWAddrPtr(), 64);
+
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, lease_na));
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, lease_pd));
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::DELETE, lease_na));
+    EXPECT_EQ(2, backlog.size());
+
+    LeaseUpdateBacklog::OpType op_type;
+    EXPECT_EQ(lease_pd, backlog.pop(op_type));
+    EXPECT_EQ(LeaseUpdateBacklog::ADD, op_type);
+    EXPECT_EQ(lease_na, backlog.pop(op_type));
+    EXPECT_EQ(LeaseUpdateBacklog::DELETE, op_type);
+}
+
+// This test verifies that the lease updates are moved to the spill file
+// when the queue is full and that they are returned in order.
+TEST(LeaseUpdateBacklogTest, spill) {
+    std::string spill_file = "/tmp/ha-lease-update-backlog";
+    LeaseUpdateBacklog backlog(3, spill_file);
+
+    // Add 10 lease updates. This spills the queue three times.
+    for (auto i = 0; i < 10; ++i) {
+        IOAddress address(i + 1);
+        HWAddrPtr hwaddr = boost::make_shared<HWAddr>(std::vector<uint8_t>(6, static_cast<uint8_t>(i)),
+                                                      HTYPE_ETHER);
+        Lease4Ptr lease = boost::make_shared<Lease4>(address, hwaddr, ClientIdPtr(), 60, 0, 1);
+        ASSERT_TRUE(backlog.push(i % 2 ? LeaseUpdateBacklog::ADD : LeaseUpdateBacklog::DELETE, lease));
+    }
+    EXPECT_FALSE(backlog.wasOverflown());
+    EXPECT_EQ(10, backlog.size());
+    EXPECT_EQ(9, backlog.spilledSize());
+
+    // The lease updates are returned in the order they were added.
+    LeaseUpdateBacklog::OpType op_type;
+    for (auto i = 0; i < 10; ++i) {
+        Lease4Ptr lease = boost::dynamic_pointer_cast<Lease4>(backlog.pop(op_type));
+        ASSERT_TRUE(lease);
+        EXPECT_EQ(IOAddress(i + 1), lease->addr_);
+        EXPECT_EQ(std::vector<uint8_t>(6, static_cast<uint8_t>(i)), lease->hwaddr_->hwaddr_);
+        EXPECT_EQ(i % 2 ? LeaseUpdateBacklog::ADD : LeaseUpdateBacklog::DELETE, op_type);
+    }
+    EXPECT_FALSE(backlog.pop(op_type));
+    EXPECT_EQ(0, backlog.size());
+    EXPECT_EQ(0, backlog.spilledSize());
+    EXPECT_FALSE(backlog.wasOverflown());
+
+    // The spill file is reused after it has been emptied.
+    for (auto i = 0; i < 4; ++i) {
+        IOAddress address(i + 1);
+        HWAddrPtr hwaddr = boost::make_shared<HWAddr>(std::vector<uint8_t>(6, 1), HTYPE_ETHER);
+        Lease4Ptr lease = boost::make_shared<Lease4>(address, hwaddr, ClientIdPtr(), 60, 0, 1);
+        ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, lease));
+    }
+    EXPECT_EQ(3, backlog.spilledSize());
+
+    // Clearing the queue drops the spilled lease updates.
+    ASSERT_NO_THROW(backlog.clear());
+    EXPECT_EQ(0, backlog.size());
+    EXPECT_EQ(0, backlog.spilledSize());
+    EXPECT_FALSE(backlog.pop(op_type));
+}
+
+// This test verifies that the queue is overflown when the spilled lease
+// updates can't be read.
+TEST(LeaseUpdateBacklogTest, spillCorrupted) {
+    std::string spill_file = "/tmp/ha-lease-update-backlog";
+    LeaseUpdateBacklog backlog(1, spill_file);
+
+    DuidPtr duid = boost::make_shared<DUID>(std::vector<uint8_t>(8, 2));
+    Lease6Ptr lease1 = boost::make_shared<Lease6>(Lease::TYPE_NA, IOAddress("2001:db8:1::1"),
+                                                  duid, 1234, 50, 60, 1);
+    Lease6Ptr lease2 = boost::make_shared<Lease6>(Lease::TYPE_NA, IOAddress("2001:db8:1::2"),
+                                                  duid, 1234, 50, 60, 1);
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, lease1));
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, lease2));
+    ASSERT_EQ(1, backlog.spilledSize());
+
+    // Replace the spill file contents.
+    {
+        std::ofstream out(spill_file.c_str(), std::ios::trunc);
+        out << "garbage";
+    }
+
+    // The lease update in memory is still returned.
+    LeaseUpdateBacklog::OpType op_type;
+    EXPECT_EQ(lease2, backlog.pop(op_type));
+    EXPECT_TRUE(backlog.wasOverflown());
+    EXPECT_EQ(0, backlog.size());
+}
+
+// This test verifies that the queue is overflown when the spilled lease
+// updates would exceed the maximum size of the spill file.
+TEST(LeaseUpdateBacklogTest, spillMaxSize) {
+    std::string spill_file = "/tmp/ha-lease-update-backlog";
+    HWAddrPtr hwaddr = boost::make_shared<HWAddr>(std::vector<uint8_t>(6, 1), HTYPE_ETHER);
+    std::vector<Lease4Ptr> leases;
+    for (auto i = 0; i < 5; ++i) {
+        leases.push_back(boost::make_shared<Lease4>(IOAddress(i + 1), hwaddr,
+                                                    ClientIdPtr(), 60, 0, 1));
+    }
+
+    // Get the size of the two lease updates spilled at once.
+    std::streamoff spill_size = 0;
+    {
+        LeaseUpdateBacklog backlog(2, spill_file);
+        for (auto i = 0; i < 3; ++i) {
+            ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, leases[i]));
+        }
+        ASSERT_EQ(2, backlog.spilledSize());
+        std::ifstream in(spill_file.c_str(), std::ios::binary | std::ios::ate);
+        spill_size = in.tellg();
+    }
+    ASSERT_GT(spill_size, 0);
+
+    // The spill file can hold them only once.
+    LeaseUpdateBacklog backlog(2, spill_file, spill_size + 1);
+    for (auto i = 0; i < 4; ++i) {
+        ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, leases[i]));
+    }
+    EXPECT_FALSE(backlog.wasOverflown());
+    EXPECT_EQ(2, backlog.spilledSize());
+    EXPECT_FALSE(backlog.push(LeaseUpdateBacklog::ADD, leases[4]));
+    EXPECT_TRUE(backlog.wasOverflown());
+    EXPECT_EQ(4, backlog.size());
+}
+
+// This test verifies that the queue is overflown when the spill file
+// can't be created.
+TEST(LeaseUpdateBacklogTest, spillFailed) {
+    LeaseUpdateBacklog backlog(1, "/nonexistent-directory/ha-lease-update-backlog");
+
+    HWAddrPtr hwaddr = boost::make_shared<HWAddr>(std::vector<uint8_t>(6, 1), HTYPE_ETHER);
+    Lease4Ptr lease1 = boost::make_shared<Lease4>(IOAddress("192.0.2.1"), hwaddr,
+                                                  ClientIdPtr(), 60, 0, 1);
+    Lease4Ptr lease2 = boost::make_shared<Lease4>(IOAddress("192.0.2.2"), hwaddr,
+                                                  ClientIdPtr(), 60, 0, 1);
+    ASSERT_TRUE(backlog.push(LeaseUpdateBacklog::ADD, lease1));
+    EXPECT_FALSE(backlog.push(LeaseUpdateBacklog::ADD, lease2));
+    EXPECT_TRUE(backlog.wasOverflown());
+    EXPECT_EQ(1, backlog.size());
+}
+
 } // end of anonymous namespace
@@ -15,16 +15,20 @@
 #include <dhcp/dhcp4.h>
 #include <dhcp/dhcp6.h>
 #include <dhcp/hwaddr.h>
+#include <stats/stats_mgr.h>
 #include <util/multi_threading_mgr.h>
 
 #include <cstdint>
+#include <map>
 #include <string>
+#include <vector>
 
 using namespace isc;
 using namespace isc::data;
 using namespace isc::dhcp;
 using namespace isc::ha;
 using namespace isc::ha::test;
+using namespace isc::stats;
 using namespace util;
 
 namespace  {
@@ -101,6 +105,10 @@ public:
     /// @brief This test verifies that it is possible to explicitly enable and
     /// disable certain scopes.
     void explicitlyServeScopes();
+
+    /// @brief This test verifies the case when load balancing is enabled
+    /// with more than two active servers.
+    void loadBalancingPartners();
 };
 
 void
@@ -721,6 +729,85 @@ QueryFilterTest::explicitlyServeScopes() {
     EXPECT_THROW(filter.serveScopes({ "server1", "unsupported" }), BadValue);
 }
 
+void
+QueryFilterTest::loadBalancingPartners() {
+    StatsMgr::instance().removeAll();
+
+    HAConfigPtr config = createPartnersConfiguration(2);
+    QueryFilter filter(config);
+
+    // By default the server1 should serve its own scope only.
+    EXPECT_TRUE(filter.amServingScope("server1"));
+    EXPECT_FALSE(filter.amServingScope("server2"));
+    EXPECT_FALSE(filter.amServingScope("server3"));
+    EXPECT_FALSE(filter.amServingScope("server4"));
+
+    // Only the queries of the partner are used to detect its failure.
+    EXPECT_TRUE(filter.isPartnerScopeClass("HA_server2"));
+    EXPECT_FALSE(filter.isPartnerScopeClass("HA_server3"));
+    EXPECT_FALSE(filter.isPartnerScopeClass("HA_server4"));
+
+    // Record the owners of the queries.
+    const unsigned queries_num = 10000;
+    std::vector<Pkt4Ptr> queries;
+    std::vector<std::string> owners;
+    std::map<std::string, unsigned> owned;
+    unsigned in_scope = 0;
+    std::string scope_class;
+    for (unsigned i = 0; i < queries_num; ++i) {
+        Pkt4Ptr query4 = createQuery4(randomKey(HWAddr::ETHERNET_HWADDR_LEN));
+        if (filter.inScope(query4, scope_class)) {
+            ASSERT_EQ("HA_server1", scope_class);
+            ++in_scope;
+        }
+        queries.push_back(query4);
+        owners.push_back(scope_class);
+        ++owned[scope_class];
+    }
+
+    // Each of the four servers should get roughly a quarter of the queries.
+    ASSERT_EQ(4, owned.size());
+    for (auto const& o : owned) {
+        EXPECT_GT(o.second, queries_num / 8) << o.first;
+        EXPECT_LT(o.second, 3 * queries_num / 8) << o.first;
+    }
+    EXPECT_EQ(owned["HA_server1"], in_scope);
+
+    // The queries are counted per scope.
+    ObservationPtr stat = StatsMgr::instance().getObservation("ha-scope[server1].queries");
+    ASSERT_TRUE(stat);
+    EXPECT_EQ(owned["HA_server1"], stat->getInteger().first);
+    stat = StatsMgr::instance().getObservation("ha-scope[server4].queries");
+    ASSERT_TRUE(stat);
+    EXPECT_EQ(owned["HA_server4"], stat->getInteger().first);
+    EXPECT_FALSE(StatsMgr::instance().getObservation("ha-scope[backup].queries"));
+
+    // In the failover case the server1 serves the scope of its partner
+    // but not the scopes of the other pair.
+    filter.serveFailoverScopes();
+    EXPECT_TRUE(filter.amServingScope("server1"));
+    EXPECT_TRUE(filter.amServingScope("server2"));
+    EXPECT_FALSE(filter.amServingScope("server3"));
+    EXPECT_FALSE(filter.amServingScope("server4"));
+
+    // Adding a pair of servers only moves the queries to the new servers.
+    QueryFilter filter3(createPartnersConfiguration(3));
+    unsigned moved = 0;
+    for (unsigned i = 0; i < queries_num; ++i) {
+        filter3.inScope(queries[i], scope_class);
+        if (scope_class != owners[i]) {
+            ASSERT_TRUE((scope_class == "HA_server5") || (scope_class == "HA_server6"))
+                << scope_class;
+            ++moved;
+        }
+    }
+    // A third of the queries should have moved.
+    EXPECT_GT(moved, queries_num / 6);
+    EXPECT_LT(moved, queries_num / 2);
+
+    StatsMgr::instance().removeAll();
+}
+
 TEST_F(QueryFilterTest, loadBalancingClientIdThisPrimary) {
     loadBalancingClientIdThisPrimary();
 }
@@ -847,4 +934,13 @@ TEST_F(QueryFilterTest, explicitlyServeScopesMultiThreading) {
     explicitlyServeScopes();
 }
 
+TEST_F(QueryFilterTest, loadBalancingPartners) {
+    loadBalancingPartners();
+}
+
+TEST_F(QueryFilterTest, loadBalancingPartnersMultiThreading) {
+    MultiThreadingMgr::instance().setMode(true);
+    loadBalancingPartners();
+}
+
 }
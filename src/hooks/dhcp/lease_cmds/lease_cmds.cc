@@ -32,8 +32,12 @@
 
 #include <boost/scoped_ptr.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/shared_ptr.hpp>
+#include <list>
+#include <set>
 #include <string>
 #include <sstream>
+#include <utility>
 
 using namespace isc::dhcp;
 using namespace isc::data;
@@ -444,6 +448,41 @@ public:
     ///
     /// @return true if lease has been successfully added, false otherwise.
     static bool addOrUpdate6(Lease6Ptr lease, bool force_create);
+
+    /// @brief Deletes IPv6 leases in batches.
+    ///
+    /// The leases are deleted using @c LeaseMgr::deleteLeases, which
+    /// writes each batch within one database transaction.
+    ///
+    /// @param leases The leases to be deleted with the parameters they
+    /// were parsed from.
+    /// @param [out] success_count Incremented for each deleted lease.
+    ///
+    /// @return The list of leases which failed to delete or null if
+    /// all leases were deleted.
+    ElementPtr
+    bulkDelete6(const std::list<std::pair<Parameters, Lease6Ptr> >& leases,
+                size_t& success_count) const;
+
+    /// @brief Adds or updates IPv6 leases in batches.
+    ///
+    /// This is the batch counterpart of the @c addOrUpdate6 with the
+    /// @c force_create flag set. The leases are written using
+    /// @c LeaseMgr::addLeases and @c LeaseMgr::updateLeases, which
+    /// write each batch within one database transaction.
+    ///
+    /// @param leases The leases to be added or updated.
+    /// @param [out] success_count Incremented for each added or updated
+    /// lease.
+    ///
+    /// @return The list of leases which failed to add or update or null
+    /// if all leases were written.
+    ElementPtr bulkAddOrUpdate6(const std::list<Lease6Ptr>& leases,
+                                size_t& success_count) const;
+
+    /// @brief Maximum number of leases written to the database at once
+    /// by the bulk commands.
+    static const size_t BULK_BATCH_SIZE = 100;
 };
 
 void
@@ -704,6 +743,191 @@ LeaseCmdsImpl::addOrUpdate6(Lease6Ptr lease, bool force_create) {
     return (false);
 }
 
+ElementPtr
+LeaseCmdsImpl::bulkDelete6(const std::list<std::pair<Parameters, Lease6Ptr> >& leases,
+                           size_t& success_count) const {
+    ElementPtr failed_deleted_list;
+
+    auto lease_params_pair = leases.begin();
+    while (lease_params_pair != leases.end()) {
+        // Get the next batch of leases.
+        std::list<std::pair<Parameters, Lease6Ptr> > batch;
+        Lease6Collection batch_leases;
+        for (; (lease_params_pair != leases.end()) &&
+             (batch_leases.size() < BULK_BATCH_SIZE); ++lease_params_pair) {
+            if (lease_params_pair->second) {
+                batch.push_back(*lease_params_pair);
+                batch_leases.push_back(lease_params_pair->second);
+            }
+        }
+
+        try {
+            // This may throw if the leases couldn't be deleted for any
+            // reason, but we still want to proceed with other batches.
+            Lease6Collection not_deleted =
+                LeaseMgrFactory::instance().deleteLeases(batch_leases);
+            std::set<Lease6Ptr> not_found(not_deleted.begin(), not_deleted.end());
+
+            for (auto const& deleted : batch) {
+                if (not_found.count(deleted.second) == 0) {
+                    ++success_count;
+                    LeaseCmdsImpl::updateStatsOnDelete(deleted.second);
+                    continue;
+                }
+
+                // Lazy creation of the list of leases which failed to delete.
+                if (!failed_deleted_list) {
+                    failed_deleted_list = Element::createList();
+                }
+
+                // If the lease doesn't exist we also want to put it
+                // on the list of leases which failed to delete. That
+                // corresponds to the lease6-del command which returns
+                // an error when the lease doesn't exist.
+                const Parameters& p = deleted.first;
+                failed_deleted_list->add(createFailedLeaseMap(p.lease_type,
+                                                              p.addr, p.duid,
+                                                              CONTROL_RESULT_EMPTY,
+                                                              "lease not found"));
+            }
+
+        } catch (const std::exception& ex) {
+            // Lazy creation of the list of leases which failed to delete.
+            if (!failed_deleted_list) {
+                failed_deleted_list = Element::createList();
+            }
+            for (auto const& deleted : batch) {
+                const Parameters& p = deleted.first;
+                failed_deleted_list->add(createFailedLeaseMap(p.lease_type,
+                                                              p.addr, p.duid,
+                                                              CONTROL_RESULT_ERROR,
+                                                              ex.what()));
+            }
+        }
+    }
+
+    return (failed_deleted_list);
+}
+
+ElementPtr
+LeaseCmdsImpl::bulkAddOrUpdate6(const std::list<Lease6Ptr>& leases,
+                                size_t& success_count) const {
+    ElementPtr failed_leases_list;
+
+    auto add_failed = [this, &failed_leases_list](const Lease6Ptr& lease,
+                                                  const std::string& error) {
+        // Lazy creation of the list of leases which failed to add/update.
+        if (!failed_leases_list) {
+            failed_leases_list = Element::createList();
+        }
+        failed_leases_list->add(createFailedLeaseMap(lease->type_,
+                                                     lease->addr_,
+                                                     lease->duid_,
+                                                     CONTROL_RESULT_ERROR,
+                                                     error));
+    };
+
+    LeaseMgr& lease_mgr = LeaseMgrFactory::instance();
+    auto lease = leases.begin();
+    while (lease != leases.end()) {
+        // Leases of the batch to be added and to be updated with the
+        // existing leases they replace.
+        Lease6Collection added;
+        Lease6Collection updated;
+        std::list<std::pair<Lease6Ptr, Lease6Ptr> > updated_existing;
+
+        // Addresses of the batch and the locks held on them. They are
+        // released when the batch has been written.
+        std::set<std::pair<Lease::Type, IOAddress> > addresses;
+        std::list<boost::shared_ptr<ResourceHandler> > resource_handlers;
+
+        for (; (lease != leases.end()) &&
+             (added.size() + updated.size() < BULK_BATCH_SIZE); ++lease) {
+            // A lease given twice is written by the next batch, so as it
+            // updates the lease written by this one.
+            auto address = std::make_pair((*lease)->type_, (*lease)->addr_);
+            if (addresses.count(address) > 0) {
+                break;
+            }
+
+            try {
+                if (MultiThreadingMgr::instance().getMode()) {
+                    // Multi-threading, try to lock first to avoid a race.
+                    boost::shared_ptr<ResourceHandler>
+                        resource_handler(new ResourceHandler());
+                    if (!resource_handler->tryLock((*lease)->type_, (*lease)->addr_)) {
+                        isc_throw(ResourceBusy,
+                                  "ResourceBusy: IP address:" << (*lease)->addr_
+                                  << " could not be updated.");
+                    }
+                    resource_handlers.push_back(resource_handler);
+                }
+
+                Lease6Ptr existing = lease_mgr.getLease6((*lease)->type_,
+                                                         (*lease)->addr_);
+                if (!existing) {
+                    added.push_back(*lease);
+                } else {
+                    // Update lease current expiration time with value received
+                    // from the database. Some database backends reject
+                    // operations on the lease if the current expiration time
+                    // value does not match what is stored.
+                    Lease::syncCurrentExpirationTime(*existing, **lease);
+                    updated.push_back(*lease);
+                    updated_existing.push_back(std::make_pair(*lease, existing));
+                }
+                addresses.insert(address);
+
+            } catch (const std::exception& ex) {
+                add_failed(*lease, ex.what());
+            }
+        }
+
+        try {
+            Lease6Collection not_added = lease_mgr.addLeases(added);
+            std::set<Lease6Ptr> failed(not_added.begin(), not_added.end());
+            for (auto const& added_lease : added) {
+                if (failed.count(added_lease) > 0) {
+                    add_failed(added_lease, "lost race between calls to get and add");
+                } else {
+                    LeaseCmdsImpl::updateStatsOnAdd(added_lease);
+                    ++success_count;
+                }
+            }
+
+        } catch (const std::exception& ex) {
+            for (auto const& added_lease : added) {
+                add_failed(added_lease, ex.what());
+            }
+        }
+
+        try {
+            Lease6Collection not_updated = lease_mgr.updateLeases(updated);
+            std::set<Lease6Ptr> failed(not_updated.begin(), not_updated.end());
+            for (auto const& pair : updated_existing) {
+                if (failed.count(pair.first) > 0) {
+                    std::ostringstream error;
+                    error << "failed to update the lease with address "
+                          << pair.first->addr_ << " either because the lease "
+                          "has been deleted or it has changed in the database, "
+                          "in both cases a retry might succeed";
+                    add_failed(pair.first, error.str());
+                } else {
+                    LeaseCmdsImpl::updateStatsOnUpdate(pair.second, pair.first);
+                    ++success_count;
+                }
+            }
+
+        } catch (const std::exception& ex) {
+            for (auto const& updated_lease : updated) {
+                add_failed(updated_lease, ex.what());
+            }
+        }
+    }
+
+    return (failed_leases_list);
+}
+
 int
 LeaseCmdsImpl::leaseAddHandler(CalloutHandle& handle) {
     // Arbitrary defaulting to DHCPv4 or with other words extractCommand
@@ -1044,36 +1268,30 @@ LeaseCmdsImpl::leaseGetAllHandler(CalloutHandle& handle) {
                 }
 
                 if (v4) {
-                    Lease4Collection leases =
-                        LeaseMgrFactory::instance().getLeases4((*subnet_id)->intValue());
-                    for (auto lease : leases) {
-                        ElementPtr lease_json = lease->toElement();
-                        leases_json->add(lease_json);
-                    }
+                    LeaseMgrFactory::instance().walkLeases4((*subnet_id)->intValue(),
+                        [&leases_json](const Lease4& lease) {
+                            leases_json->add(lease.toElement());
+                        });
                 } else {
-                    Lease6Collection leases =
-                        LeaseMgrFactory::instance().getLeases6((*subnet_id)->intValue());
-                    for (auto lease : leases) {
-                        ElementPtr lease_json = lease->toElement();
-                        leases_json->add(lease_json);
-                    }
+                    LeaseMgrFactory::instance().walkLeases6((*subnet_id)->intValue(),
+                        [&leases_json](const Lease6& lease) {
+                            leases_json->add(lease.toElement());
+                        });
                 }
             }
 
         } else {
             // There is no 'subnets' argument so let's return all leases.
+            // The leases are converted into JSON as they are walked rather
+            // than collected first.
             if (v4) {
-                Lease4Collection leases = LeaseMgrFactory::instance().getLeases4();
-                for (auto lease : leases) {
-                    ElementPtr lease_json = lease->toElement();
-                    leases_json->add(lease_json);
-                }
+                LeaseMgrFactory::instance().walkLeases4([&leases_json](const Lease4& lease) {
+                    leases_json->add(lease.toElement());
+                });
             } else {
-                Lease6Collection leases = LeaseMgrFactory::instance().getLeases6();
-                for (auto lease : leases) {
-                    ElementPtr lease_json = lease->toElement();
-                    leases_json->add(lease_json);
-                }
+                LeaseMgrFactory::instance().walkLeases6([&leases_json](const Lease6& lease) {
+                    leases_json->add(lease.toElement());
+                });
             }
         }
 
@@ -1167,27 +1385,20 @@ LeaseCmdsImpl::leaseGetPageHandler(CalloutHandle& handle) {
         ElementPtr leases_json = Element::createList();
 
         if (v4) {
-            // Get page of IPv4 leases.
-            Lease4Collection leases =
-                LeaseMgrFactory::instance().getLeases4(*from_address,
-                                                       LeasePageSize(page_limit_value));
-
-            // Convert leases into JSON list.
-            for (auto lease : leases) {
-                ElementPtr lease_json = lease->toElement();
-                leases_json->add(lease_json);
-            }
+            // Convert the page of IPv4 leases into JSON list.
+            LeaseMgrFactory::instance().walkLeases4(*from_address,
+                                                    LeasePageSize(page_limit_value),
+                [&leases_json](const Lease4& lease) {
+                    leases_json->add(lease.toElement());
+                });
 
         } else {
-            // Get page of IPv6 leases.
-            Lease6Collection leases =
-                LeaseMgrFactory::instance().getLeases6(*from_address,
-                                                       LeasePageSize(page_limit_value));
-            // Convert leases into JSON list.
-            for (auto lease : leases) {
-                ElementPtr lease_json = lease->toElement();
-                leases_json->add(lease_json);
-            }
+            // Convert the page of IPv6 leases into JSON list.
+            LeaseMgrFactory::instance().walkLeases6(*from_address,
+                                                    LeasePageSize(page_limit_value),
+                [&leases_json](const Lease6& lease) {
+                    leases_json->add(lease.toElement());
+                });
         }
 
         // Prepare textual status.
@@ -1584,91 +1795,13 @@ LeaseCmdsImpl::lease6BulkApplyHandler(CalloutHandle& handle) {
 
         ElementPtr failed_deleted_list;
         if (!parsed_deleted_list.empty()) {
-
-            // Iterate over leases to be deleted.
-            for (auto lease_params_pair : parsed_deleted_list) {
-
-                // This part is outside of the try-catch because an exception
-                // indicates that the command is malformed.
-                Parameters p = lease_params_pair.first;
-                auto lease = lease_params_pair.second;
-
-                try {
-                    if (lease) {
-                        // This may throw if the lease couldn't be deleted for
-                        // any reason, but we still want to proceed with other
-                        // leases.
-                        if (LeaseMgrFactory::instance().deleteLease(lease)) {
-                            ++success_count;
-                            LeaseCmdsImpl::updateStatsOnDelete(lease);
-
-                        } else {
-                            // Lazy creation of the list of leases which failed to delete.
-                            if (!failed_deleted_list) {
-                                failed_deleted_list = Element::createList();
-                            }
-
-                            // If the lease doesn't exist we also want to put it
-                            // on the list of leases which failed to delete. That
-                            // corresponds to the lease6-del command which returns
-                            // an error when the lease doesn't exist.
-                            failed_deleted_list->add(createFailedLeaseMap(p.lease_type,
-                                                                          p.addr, p.duid,
-                                                                          CONTROL_RESULT_EMPTY,
-                                                                          "lease not found"));
-                        }
-                    }
-
-                } catch (const std::exception& ex) {
-                    // Lazy creation of the list of leases which failed to delete.
-                    if (!failed_deleted_list) {
-                         failed_deleted_list = Element::createList();
-                    }
-                    failed_deleted_list->add(createFailedLeaseMap(p.lease_type,
-                                                                  p.addr, p.duid,
-                                                                  CONTROL_RESULT_ERROR,
-                                                                  ex.what()));
-                }
-            }
+            failed_deleted_list = bulkDelete6(parsed_deleted_list, success_count);
         }
 
         // Process leases to be added or/and updated.
         ElementPtr failed_leases_list;
         if (!parsed_leases_list.empty()) {
-            ConstSrvConfigPtr config = CfgMgr::instance().getCurrentCfg();
-
-            // Iterate over all leases.
-            for (auto lease : parsed_leases_list) {
-
-                try {
-                    if (!MultiThreadingMgr::instance().getMode()) {
-                        // Not multi-threading.
-                        addOrUpdate6(lease, true);
-                    } else {
-                        // Multi-threading, try to lock first to avoid a race.
-                        ResourceHandler resource_handler;
-                        if (resource_handler.tryLock(lease->type_, lease->addr_)) {
-                            addOrUpdate6(lease, true);
-                        } else {
-                            isc_throw(ResourceBusy,
-                                      "ResourceBusy: IP address:" << lease->addr_
-                                      << " could not be updated.");
-                        }
-                    }
-
-                    ++success_count;
-                } catch (const std::exception& ex) {
-                    // Lazy creation of the list of leases which failed to add/update.
-                    if (!failed_leases_list) {
-                         failed_leases_list = Element::createList();
-                    }
-                    failed_leases_list->add(createFailedLeaseMap(lease->type_,
-                                                                 lease->addr_,
-                                                                 lease->duid_,
-                                                                 CONTROL_RESULT_ERROR,
-                                                                 ex.what()));
-                }
-            }
+            failed_leases_list = bulkAddOrUpdate6(parsed_leases_list, success_count);
         }
 
         // Start preparing the response.
@@ -1,4 +1,4 @@
-// Copyright (C) 2017-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2017-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -13,6 +13,7 @@
 #include <lease_cmds.h>
 #include <lease_cmds_log.h>
 #include <cc/command_interpreter.h>
+#include <config/command_mgr.h>
 #include <hooks/hooks.h>
 
 using namespace isc::config;
@@ -20,6 +21,20 @@ using namespace isc::data;
 using namespace isc::hooks;
 using namespace isc::lease_cmds;
 
+namespace {
+
+/// @brief Names of the commands which only read leases.
+///
+/// They can be processed by the command threads of the server.
+const char* READ_ONLY_COMMANDS[] = {
+    "lease4-get", "lease6-get", "lease4-get-all", "lease6-get-all",
+    "lease4-get-page", "lease6-get-page", "lease4-get-by-hw-address",
+    "lease4-get-by-client-id", "lease6-get-by-duid", "lease4-get-by-hostname",
+    "lease6-get-by-hostname"
+};
+
+} // end of anonymous namespace
+
 extern "C" {
 
 /// @brief This is a command callout for 'lease4-add' command.
@@ -296,6 +311,14 @@ int load(LibraryHandle& handle) {
     handle.registerCommandCallout("lease4-resend-ddns", lease4_resend_ddns);
     handle.registerCommandCallout("lease6-resend-ddns", lease6_resend_ddns);
 
+    // Only one lease4-get-all and one lease6-get-all are processed at a
+    // time as they can return the whole lease database.
+    for (auto name : READ_ONLY_COMMANDS) {
+        CommandMgr::instance().setThreadSafe(name);
+    }
+    CommandMgr::instance().setThreadSafe("lease4-get-all", 1);
+    CommandMgr::instance().setThreadSafe("lease6-get-all", 1);
+
     LOG_INFO(lease_cmds_logger, LEASE_CMDS_INIT_OK);
     return (0);
 }
@@ -304,6 +327,9 @@ int load(LibraryHandle& handle) {
 ///
 /// @return 0 if deregistration was successful, 1 otherwise
 int unload() {
+    for (auto name : READ_ONLY_COMMANDS) {
+        CommandMgr::instance().clearThreadSafe(name);
+    }
     LOG_INFO(lease_cmds_logger, LEASE_CMDS_DEINIT_OK);
     return (0);
 }
@@ -22,6 +22,9 @@
 #include <util/multi_threading_mgr.h>
 
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+#include <map>
 #include <string>
 
 using namespace isc::dhcp;
@@ -63,6 +66,9 @@ public:
         /// or subnet range
         LeaseStatsQuery::SelectMode select_mode_;
 
+        /// @brief Indicates whether the pool statistics are requested
+        bool pools_;
+
         /// @brief Generate a string version of the contents
         std::string toText() {
             std::stringstream os;
@@ -83,6 +89,12 @@ public:
         }
     };
 
+    /// @brief Key of the pool counts: subnet id, pool index, lease type
+    typedef boost::tuple<SubnetID, uint32_t, Lease::Type> PoolKey;
+
+    /// @brief Assigned and declined lease counts per pool
+    typedef std::map<PoolKey, std::pair<int64_t, int64_t> > PoolCounts;
+
 public:
 
     /// @brief Provides the implementation for stat-lease4-get,
@@ -122,6 +134,7 @@ public:
     /// first-subnet-id and last-subnet-id and their values
     /// must fulfill: 0 < first-subnet-id < last-subnet-id
     /// -# subnet-id and subnet-range are mutually exclusive
+    /// -# If pools is specified it must be a boolean
     Parameters getParameters(const ConstElementPtr& cmd_args);
 
     /// @brief Executes the lease4 query and constructs the outbound result set
@@ -138,6 +151,9 @@ public:
     /// query results.  For subnets with no query data (i.e. no leases),
     /// their rows have non-zero values for totals only.
     ///
+    /// When the pool statistics are requested, a pool-result-set with a row
+    /// per pool of the qualifying subnets is added too.
+    ///
     /// @param result Element to which the constructed result-set will be added.
     /// @param params Parsed stat-lease4-cmd parameters
     /// @throw NotFound if the selection criteria eliminates all known subnets
@@ -156,11 +172,32 @@ public:
     /// query results.  For subnets with no query data (i.e. no leases),
     /// their rows have non-zero values for totals only.
     ///
+    /// When the pool statistics are requested, a pool-result-set with a row
+    /// per NA pool and a pd-pool-result-set with a row per PD pool of the
+    /// qualifying subnets are added too.
+    ///
     /// @param result Element to which the constructed result-set will be added.
     /// @param params Parsed stat-lease6-cmd parameters
     /// @throw NotFound if the selection criteria eliminates all known subnets
     uint64_t makeResultSet6(const ElementPtr& result, const Parameters& params);
 
+    /// @brief Runs a pool lease stats query and accumulates its results
+    ///
+    /// The query is given all the pools of the configured subnets, so the
+    /// backend can keep their counters from one query to the next. The
+    /// counts are accumulated per subnet, pool index and lease type.
+    ///
+    /// @param subnets The configured subnets
+    /// @param types The lease types of the pools
+    /// @param v4 Flag indicating if the IPv4 query must be run
+    /// @return The counts of assigned and declined leases
+    /// @throw NotImplemented if the lease backend does not support the
+    /// pool lease stats queries
+    template<typename SubnetCollectionType>
+    PoolCounts getPoolCounts(const SubnetCollectionType& subnets,
+                             const std::vector<Lease::Type>& types,
+                             bool v4);
+
     /// @brief Instantiates a new "empty" result-set Element
     ///
     /// Constructs a ElementPtr tree of an empty result set
@@ -179,9 +216,11 @@ public:
     /// will be added.
     /// @param column_labels list of the column labels in the order the values
     /// for each column will appear in the result-set rows
+    /// @param name name of the result-set in the wrapper
     /// @return A reference to the writable list of rows of the result-set
     ElementPtr createResultSet(const ElementPtr& wrapper,
-                               const std::vector<std::string>& column_labels);
+                               const std::vector<std::string>& column_labels,
+                               const std::string& name = "result-set");
 
     /// @brief Adds a row of Lease4 stat values to a list of value rows
     ///
@@ -314,6 +353,7 @@ LeaseStatCmdsImpl::getParameters(const ConstElementPtr& cmd_args) {
     params.select_mode_ = LeaseStatsQuery::ALL_SUBNETS;
     params.first_subnet_id_ = 0;
     params.last_subnet_id_ = 0;
+    params.pools_ = false;
     if (!cmd_args ) {
         // No arguments defaults to ALL_SUBNETS.
         return (params);
@@ -378,6 +418,15 @@ LeaseStatCmdsImpl::getParameters(const ConstElementPtr& cmd_args) {
         params.select_mode_ = LeaseStatsQuery::SUBNET_RANGE;
     }
 
+    if (cmd_args->contains("pools")) {
+        ConstElementPtr value = cmd_args->get("pools");
+        if (value->getType() != Element::boolean) {
+            isc_throw(BadValue, "'pools' parameter is not a boolean");
+        }
+
+        params.pools_ = value->boolValue();
+    }
+
     return (params);
 }
 
@@ -486,6 +535,30 @@ LeaseStatCmdsImpl::makeResultSet4(const ElementPtr& result_wrapper,
         }
     }
 
+    if (params.pools_) {
+        PoolCounts counts = getPoolCounts(*subnets, { Lease::TYPE_V4 }, true);
+        std::vector<std::string> pool_labels = { "subnet-id", "pool-id",
+                                                 "total-addresses",
+                                                 "assigned-addresses",
+                                                 "declined-addresses" };
+        ElementPtr pool_rows = createResultSet(result_wrapper, pool_labels,
+                                               "pool-result-set");
+        for (auto cur_subnet = lower; cur_subnet != upper; ++cur_subnet) {
+            SubnetID cur_id = (*cur_subnet)->getID();
+            const PoolCollection& pools = (*cur_subnet)->getPools(Lease::TYPE_V4);
+            for (uint32_t i = 0; i < pools.size(); ++i) {
+                auto const& count = counts[PoolKey(cur_id, i, Lease::TYPE_V4)];
+                ElementPtr row = Element::createList();
+                row->add(Element::create(static_cast<int64_t>(cur_id)));
+                row->add(Element::create(static_cast<int64_t>(i)));
+                row->add(Element::create(static_cast<int64_t>(pools[i]->getCapacity())));
+                row->add(Element::create(count.first));
+                row->add(Element::create(count.second));
+                pool_rows->add(row);
+            }
+        }
+    }
+
     return (value_rows->size());
 }
 
@@ -604,15 +677,98 @@ LeaseStatCmdsImpl::makeResultSet6(const ElementPtr& result_wrapper,
         }
     }
 
+    if (params.pools_) {
+        PoolCounts counts = getPoolCounts(*subnets,
+                                          { Lease::TYPE_NA, Lease::TYPE_PD },
+                                          false);
+        std::vector<std::string> pool_labels = { "subnet-id", "pool-id",
+                                                 "total-nas", "assigned-nas",
+                                                 "declined-nas" };
+        ElementPtr pool_rows = createResultSet(result_wrapper, pool_labels,
+                                               "pool-result-set");
+        std::vector<std::string> pd_pool_labels = { "subnet-id", "pd-pool-id",
+                                                    "total-pds", "assigned-pds" };
+        ElementPtr pd_pool_rows = createResultSet(result_wrapper, pd_pool_labels,
+                                                  "pd-pool-result-set");
+        for (auto cur_subnet = lower; cur_subnet != upper; ++cur_subnet) {
+            SubnetID cur_id = (*cur_subnet)->getID();
+            const PoolCollection& pools = (*cur_subnet)->getPools(Lease::TYPE_NA);
+            for (uint32_t i = 0; i < pools.size(); ++i) {
+                auto const& count = counts[PoolKey(cur_id, i, Lease::TYPE_NA)];
+                ElementPtr row = Element::createList();
+                row->add(Element::create(static_cast<int64_t>(cur_id)));
+                row->add(Element::create(static_cast<int64_t>(i)));
+                row->add(Element::create(static_cast<int64_t>(pools[i]->getCapacity())));
+                row->add(Element::create(count.first));
+                row->add(Element::create(count.second));
+                pool_rows->add(row);
+            }
+            const PoolCollection& pd_pools = (*cur_subnet)->getPools(Lease::TYPE_PD);
+            for (uint32_t i = 0; i < pd_pools.size(); ++i) {
+                auto const& count = counts[PoolKey(cur_id, i, Lease::TYPE_PD)];
+                ElementPtr row = Element::createList();
+                row->add(Element::create(static_cast<int64_t>(cur_id)));
+                row->add(Element::create(static_cast<int64_t>(i)));
+                row->add(Element::create(static_cast<int64_t>(pd_pools[i]->getCapacity())));
+                row->add(Element::create(count.first));
+                pd_pool_rows->add(row);
+            }
+        }
+    }
+
     return (value_rows->size());
 }
 
+template<typename SubnetCollectionType>
+LeaseStatCmdsImpl::PoolCounts
+LeaseStatCmdsImpl::getPoolCounts(const SubnetCollectionType& subnets,
+                                 const std::vector<Lease::Type>& types,
+                                 bool v4) {
+    LeaseStatsPoolCollection stats_pools;
+    for (auto const& subnet : subnets) {
+        for (auto const& type : types) {
+            const PoolCollection& pools = subnet->getPools(type);
+            for (uint32_t i = 0; i < pools.size(); ++i) {
+                stats_pools.push_back(LeaseStatsPool(subnet->getID(), i, type,
+                                                     pools[i]->getFirstAddress(),
+                                                     pools[i]->getLastAddress()));
+            }
+        }
+    }
+
+    LeaseStatsQueryPtr query;
+    if (v4) {
+        query = LeaseMgrFactory::instance().startPoolLeaseStatsQuery4(stats_pools);
+    } else {
+        query = LeaseMgrFactory::instance().startPoolLeaseStatsQuery6(stats_pools);
+    }
+    if (!query) {
+        isc_throw(NotImplemented, "pool lease statistics are not supported"
+                  " by the lease database backend");
+    }
+
+    PoolCounts counts;
+    LeaseStatsRow row;
+    while (query->getNextRow(row)) {
+        // The IPv4 rows have the type of the subnet rows.
+        Lease::Type type = (v4 ? Lease::TYPE_V4 : row.lease_type_);
+        auto& count = counts[PoolKey(row.subnet_id_, row.pool_id_, type)];
+        if (row.lease_state_ == Lease::STATE_DEFAULT) {
+            count.first = row.state_count_;
+        } else if (row.lease_state_ == Lease::STATE_DECLINED) {
+            count.second = row.state_count_;
+        }
+    }
+    return (counts);
+}
+
 ElementPtr
 LeaseStatCmdsImpl::createResultSet(const ElementPtr &result_wrapper,
-                                   const std::vector<std::string>& column_labels) {
+                                   const std::vector<std::string>& column_labels,
+                                   const std::string& name) {
     // Create the result-set map and add it to the wrapper.
     ElementPtr result_set = Element::createMap();
-    result_wrapper->set("result-set", result_set);
+    result_wrapper->set(name, result_set);
 
     // Create the timestamp based on time now and add it to the result set.
     boost::posix_time::ptime now(boost::posix_time::microsec_clock::universal_time());
@@ -189,6 +189,49 @@ public:
                     << "Actual timestamp is wrong?" << actual->stringValue();
     }
 
+    /// @brief Sends a command and checks one of its result-sets.
+    ///
+    /// Only the columns and the rows of the result-set are checked.
+    ///
+    /// @param cmd_txt JSON command to be sent (must be valid JSON)
+    /// @param name name of the result-set to check
+    /// @param exp_result_set_json expected result-set (columns and rows)
+    void testResultSet(const string& cmd_txt, const string& name,
+                       const string& exp_result_set_json) {
+        loadLib();
+
+        ConstElementPtr cmd;
+        ASSERT_NO_THROW(cmd = Element::fromJSON(cmd_txt))
+                        << "command JSON invalid, test is broken";
+
+        ConstElementPtr rsp = CommandMgr::instance().processCommand(cmd);
+        checkAnswer(rsp, CONTROL_RESULT_SUCCESS);
+
+        ConstElementPtr exp_result_set;
+        ASSERT_NO_THROW(exp_result_set = Element::fromJSON(exp_result_set_json))
+            << "Expected result-set JSON is invalid, test is broken";
+
+        ConstElementPtr actual_args = rsp->get("arguments");
+        ASSERT_TRUE(actual_args && actual_args->getType() == Element::map)
+                << "'arguments' missing or not a map " << toJSON(rsp);
+
+        ConstElementPtr actual_result_set = actual_args->get(name);
+        ASSERT_TRUE(actual_result_set &&
+                    (actual_result_set->getType() == Element::map))
+            << "Actual '" << name << "' missing or not map\n"
+            << toJSON(actual_args);
+
+        for (auto const& key : { "columns", "rows" }) {
+            ConstElementPtr exp = exp_result_set->get(key);
+            ASSERT_TRUE(exp) << "Expected '" << key << "' is missing";
+            ConstElementPtr actual = actual_result_set->get(key);
+            ASSERT_TRUE(actual) << "Actual '" << key << "' is missing";
+            EXPECT_TRUE(*exp == *actual) << "Result set " << key << " are wrong\n"
+                << "Expected:\n" << toJSON(exp)
+                << "\nActual:\n" << toJSON(actual);
+        }
+    }
+
     /// @brief Compares the status in the given parse result to a given value.
     ///
     /// @param answer Element set containing an integer response and string
@@ -772,6 +815,16 @@ TEST_F(StatCmdsTest, StatLease4GetBadParams) {
         "    }\n"
         "}",
         "cannot specify both subnet-id and subnet-range"
+        },
+        {
+        "pools not a boolean",
+        "{\n"
+        "    \"command\": \"stat-lease4-get\",\n"
+        "    \"arguments\": {"
+        "       \"pools\": \"yes\"\n"
+        "    }\n"
+        "}",
+        "'pools' parameter is not a boolean"
         }
     };
 
@@ -982,6 +1035,46 @@ TEST_F(StatCmdsTest, statLease4GetValid) {
 
 }
 
+// Verifies the pool result-set of the v4 statistic commands.
+TEST_F(StatCmdsTest, statLease4GetPools) {
+    initLeaseMgr4();
+
+    testResultSet("{\n"
+                  "    \"command\": \"stat-lease4-get\",\n"
+                  "    \"arguments\": { \"pools\": true }\n"
+                  "}",
+                  "pool-result-set",
+                  "{\n"
+                  "   \"columns\": [\n"
+                  "        \"subnet-id\", \"pool-id\", \"total-addresses\",\n"
+                  "        \"assigned-addresses\", \"declined-addresses\"\n"
+                  "   ],\n"
+                  "   \"rows\": [\n"
+                  "       [ 10, 0, 256, 2, 3 ],\n"
+                  "       [ 20, 0, 16, 3, 0 ],\n"
+                  "       [ 30, 0, 256, 0, 0 ],\n"
+                  "       [ 40, 0, 16, 4, 0 ],\n"
+                  "       [ 50, 0, 256, 1, 1 ]\n"
+                  "   ]\n"
+                  "}\n");
+
+    // Only the pools of the selected subnets are returned.
+    testResultSet("{\n"
+                  "    \"command\": \"stat-lease4-get\",\n"
+                  "    \"arguments\": { \"subnet-id\": 20, \"pools\": true }\n"
+                  "}",
+                  "pool-result-set",
+                  "{\n"
+                  "   \"columns\": [\n"
+                  "        \"subnet-id\", \"pool-id\", \"total-addresses\",\n"
+                  "        \"assigned-addresses\", \"declined-addresses\"\n"
+                  "   ],\n"
+                  "   \"rows\": [\n"
+                  "       [ 20, 0, 16, 3, 0 ]\n"
+                  "   ]\n"
+                  "}\n");
+}
+
 // Verifies result content for valid v4 statistic commands that
 // result in no matching subnets.
 TEST_F(StatCmdsTest, statLease4GetSubnetsNotFound) {
@@ -1197,6 +1290,16 @@ TEST_F(StatCmdsTest, StatLease6GetBadParams) {
         "    }\n"
         "}",
         "cannot specify both subnet-id and subnet-range"
+        },
+        {
+        "pools not a boolean",
+        "{\n"
+        "    \"command\": \"stat-lease6-get\",\n"
+        "    \"arguments\": {"
+        "       \"pools\": \"yes\"\n"
+        "    }\n"
+        "}",
+        "'pools' parameter is not a boolean"
         }
     };
 
@@ -1414,6 +1517,43 @@ TEST_F(StatCmdsTest, statLease6GetValid) {
 
 }
 
+// Verifies the pool result-sets of the v6 statistic commands.
+TEST_F(StatCmdsTest, statLease6GetPools) {
+    initLeaseMgr6();
+
+    std::string cmd_txt =
+        "{\n"
+        "    \"command\": \"stat-lease6-get\",\n"
+        "    \"arguments\": { \"pools\": true }\n"
+        "}";
+
+    testResultSet(cmd_txt, "pool-result-set",
+                  "{\n"
+                  "   \"columns\": [\n"
+                  "        \"subnet-id\", \"pool-id\", \"total-nas\",\n"
+                  "        \"assigned-nas\", \"declined-nas\"\n"
+                  "   ],\n"
+                  "   \"rows\": [\n"
+                  "       [ 10, 0, 65536, 2, 3 ],\n"
+                  "       [ 20, 0, 16777216, 3, 0 ],\n"
+                  "       [ 30, 0, 16, 1, 1 ],\n"
+                  "       [ 40, 0, 16777216, 0, 0 ]\n"
+                  "   ]\n"
+                  "}\n");
+
+    testResultSet(cmd_txt, "pd-pool-result-set",
+                  "{\n"
+                  "   \"columns\": [\n"
+                  "        \"subnet-id\", \"pd-pool-id\", \"total-pds\",\n"
+                  "        \"assigned-pds\"\n"
+                  "   ],\n"
+                  "   \"rows\": [\n"
+                  "       [ 30, 0, 65536, 3 ],\n"
+                  "       [ 50, 0, 65536, 2 ]\n"
+                  "   ]\n"
+                  "}\n");
+}
+
 // Verifies result content for valid v6 statistic commands that
 // result in no matching subnets.
 TEST_F(StatCmdsTest, statLease6GetSubnetsNotFound) {
@@ -0,0 +1,142 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <benchmark/benchmark.h>
+#include <cc/data.h>
+
+#include <sstream>
+#include <string>
+
+using namespace isc::data;
+
+namespace {
+
+/// @brief Minimal number of subnets in the benchmarked configuration.
+constexpr size_t MIN_SUBNET_COUNT = 64;
+
+/// @brief Maximal number of subnets in the benchmarked configuration.
+constexpr size_t MAX_SUBNET_COUNT = 65536;
+
+/// @brief A fixture providing a DHCPv4 like configuration text.
+class JSONBenchmark : public ::benchmark::Fixture {
+public:
+
+    /// @brief Setup routine.
+    ///
+    /// Generates the configuration with the number of subnets given by
+    /// the benchmark range.
+    ///
+    /// @param state Benchmark state.
+    void SetUp(::benchmark::State const& state) override {
+        text_ = generateConfig(state.range(0));
+        element_ = Element::fromJSON(text_);
+    }
+
+    /// @brief Setup routine (non const state variant).
+    void SetUp(::benchmark::State& state) override {
+        ::benchmark::State const& cs = state;
+        SetUp(cs);
+    }
+
+    /// @brief Teardown routine.
+    void TearDown(::benchmark::State const&) override {
+        element_.reset();
+        text_.clear();
+    }
+
+    /// @brief Teardown routine (non const state variant).
+    void TearDown(::benchmark::State& state) override {
+        ::benchmark::State const& cs = state;
+        TearDown(cs);
+    }
+
+    /// @brief Generates a configuration text.
+    ///
+    /// @param subnet_count Number of subnets.
+    /// @return The configuration in JSON.
+    static std::string generateConfig(const size_t subnet_count) {
+        std::ostringstream s;
+        s << "{\n  \"Dhcp4\": {\n    \"valid-lifetime\": 4000,\n"
+          << "    \"subnet4\": [\n";
+        for (size_t i = 0; i < subnet_count; ++i) {
+            const size_t b = (i >> 8) & 0xff;
+            const size_t c = i & 0xff;
+            if (i > 0) {
+                s << ",\n";
+            }
+            s << "      {\n"
+              << "        \"id\": " << (i + 1) << ",\n"
+              << "        \"subnet\": \"10." << b << "." << c << ".0/24\",\n"
+              << "        \"pools\": [ { \"pool\": \"10." << b << "." << c
+              << ".10 - 10." << b << "." << c << ".200\" } ],\n"
+              << "        \"option-data\": [ { \"name\": \"routers\", "
+              << "\"data\": \"10." << b << "." << c << ".1\" } ],\n"
+              << "        \"reservations\": [ { \"hw-address\": "
+              << "\"aa:bb:cc:dd:" << std::hex << b << ":" << c << std::dec
+              << "\", \"ip-address\": \"10." << b << "." << c << ".5\" } ],\n"
+              << "        \"renew-timer\": 1000,\n"
+              << "        \"match-client-id\": true,\n"
+              << "        \"user-context\": { \"comment\": \"subnet \\\"" << i
+              << "\\\"\" }\n"
+              << "      }";
+        }
+        s << "\n    ]\n  }\n}\n";
+        return (s.str());
+    }
+
+    /// @brief The configuration text.
+    std::string text_;
+
+    /// @brief The parsed configuration.
+    ElementPtr element_;
+};
+
+// Defines a benchmark that measures parsing of a JSON string.
+BENCHMARK_DEFINE_F(JSONBenchmark, fromJSONString)(benchmark::State& state) {
+    for (auto _ : state) {
+        ElementPtr element = Element::fromJSON(text_);
+        benchmark::DoNotOptimize(element);
+    }
+    state.SetBytesProcessed(state.iterations() * text_.size());
+}
+
+// Defines a benchmark that measures parsing of a JSON input stream.
+BENCHMARK_DEFINE_F(JSONBenchmark, fromJSONStream)(benchmark::State& state) {
+    for (auto _ : state) {
+        std::istringstream in(text_);
+        ElementPtr element = Element::fromJSON(in);
+        benchmark::DoNotOptimize(element);
+    }
+    state.SetBytesProcessed(state.iterations() * text_.size());
+}
+
+// Defines a benchmark that measures conversion of elements to JSON.
+BENCHMARK_DEFINE_F(JSONBenchmark, toJSON)(benchmark::State& state) {
+    for (auto _ : state) {
+        std::ostringstream out;
+        element_->toJSON(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * text_.size());
+}
+
+/// The following macros define run parameters for the benchmarks.
+
+/// A benchmark that measures parsing of a JSON string.
+BENCHMARK_REGISTER_F(JSONBenchmark, fromJSONString)
+    ->Range(MIN_SUBNET_COUNT, MAX_SUBNET_COUNT)->Unit(benchmark::kMicrosecond);
+
+/// A benchmark that measures parsing of a JSON input stream.
+BENCHMARK_REGISTER_F(JSONBenchmark, fromJSONStream)
+    ->Range(MIN_SUBNET_COUNT, MAX_SUBNET_COUNT)->Unit(benchmark::kMicrosecond);
+
+/// A benchmark that measures conversion of elements to JSON.
+BENCHMARK_REGISTER_F(JSONBenchmark, toJSON)
+    ->Range(MIN_SUBNET_COUNT, MAX_SUBNET_COUNT)->Unit(benchmark::kMicrosecond);
+
+}  // namespace
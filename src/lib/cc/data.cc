@@ -20,8 +20,10 @@
 #include <sstream>
 #include <fstream>
 #include <cerrno>
+#include <iterator>
 
 #include <boost/lexical_cast.hpp>
+#include <boost/make_shared.hpp>
 
 #include <cmath>
 
@@ -239,12 +241,12 @@ operator<(Element const& a, Element const& b) {
 //
 ElementPtr
 Element::create(const Position& pos) {
-    return (ElementPtr(new NullElement(pos)));
+    return (boost::make_shared<NullElement>(pos));
 }
 
 ElementPtr
 Element::create(const long long int i, const Position& pos) {
-    return (ElementPtr(new IntElement(static_cast<int64_t>(i), pos)));
+    return (boost::make_shared<IntElement>(static_cast<int64_t>(i), pos));
 }
 
 ElementPtr
@@ -259,17 +261,17 @@ Element::create(const long int i, const Position& pos) {
 
 ElementPtr
 Element::create(const double d, const Position& pos) {
-    return (ElementPtr(new DoubleElement(d, pos)));
+    return (boost::make_shared<DoubleElement>(d, pos));
 }
 
 ElementPtr
 Element::create(const bool b, const Position& pos) {
-    return (ElementPtr(new BoolElement(b, pos)));
+    return (boost::make_shared<BoolElement>(b, pos));
 }
 
 ElementPtr
 Element::create(const std::string& s, const Position& pos) {
-    return (ElementPtr(new StringElement(s, pos)));
+    return (boost::make_shared<StringElement>(s, pos));
 }
 
 ElementPtr
@@ -279,12 +281,12 @@ Element::create(const char *s, const Position& pos) {
 
 ElementPtr
 Element::createList(const Position& pos) {
-    return (ElementPtr(new ListElement(pos)));
+    return (boost::make_shared<ListElement>(pos));
 }
 
 ElementPtr
 Element::createMap(const Position& pos) {
-    return (ElementPtr(new MapElement(pos)));
+    return (boost::make_shared<MapElement>(pos));
 }
 
 
@@ -610,6 +612,515 @@ fromStringstreamMap(std::istream& in, const std::string& file, int& line,
     }
     return (map);
 }
+
+// The functions above read the JSON text character by character from
+// a std::istream. The following parser implements the same (relaxed)
+// grammar, produces the same elements and reports errors with the same
+// messages and positions, but it walks a contiguous memory buffer. It
+// is used when the whole text is already in memory, i.e. for strings
+// and for files, which are read in one go. This avoids the per character
+// virtual calls of the stream and the accumulation of string values in
+// temporary stringstreams.
+
+/// @brief Checks if the character is a JSON whitespace (see WHITESPACE).
+inline bool
+isWhitespace(const int c) {
+    switch (c) {
+    case ' ':
+    case '\b':
+    case '\f':
+    case '\n':
+    case '\r':
+    case '\t':
+        return (true);
+    default:
+        return (false);
+    }
+}
+
+/// @brief Returns the first position holding a double quote or a backslash.
+///
+/// The buffer is scanned eight bytes at a time using the "has zero byte"
+/// bit trick, so long string values are skipped with few operations.
+///
+/// @param begin Beginning of the buffer to scan.
+/// @param end End of the buffer to scan.
+/// @return Pointer to the found character or end when none was found.
+const char*
+findStringDelimiter(const char* begin, const char* end) {
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highs = 0x8080808080808080ULL;
+    const uint64_t quotes = ones * static_cast<uint8_t>('"');
+    const uint64_t backslashes = ones * static_cast<uint8_t>('\\');
+    const char* p = begin;
+    while (end - p >= 8) {
+        uint64_t word;
+        std::memcpy(&word, p, sizeof(word));
+        const uint64_t q = word ^ quotes;
+        const uint64_t b = word ^ backslashes;
+        if ((((q - ones) & ~q) | ((b - ones) & ~b)) & highs) {
+            break;
+        }
+        p += 8;
+    }
+    while ((p < end) && (*p != '"') && (*p != '\\')) {
+        ++p;
+    }
+    return (p);
+}
+
+/// @brief JSON parser working on a contiguous buffer.
+class BufferParser {
+public:
+
+    /// @brief Constructor.
+    ///
+    /// @param data Pointer to the text to parse (it must not be modified
+    /// nor freed while the parser is used).
+    /// @param length Length of the text.
+    /// @param file File name used in positions and error messages.
+    /// @param line Initial line number.
+    /// @param pos Initial position within the line.
+    BufferParser(const char* data, const size_t length,
+                 const std::string& file, const int line, const int pos)
+        : cur_(data), end_(data + length), file_(file), line_(line),
+          pos_(pos) {
+    }
+
+    /// @brief Parses an element (counterpart of the stream based
+    /// @c Element::fromJSON).
+    ///
+    /// @return Parsed element.
+    /// @throw JSONError on a syntax error.
+    ElementPtr parseElement() {
+        skipWhitespace();
+        const int c = get();
+        ++pos_;
+        switch (c) {
+        case '1':
+        case '2':
+        case '3':
+        case '4':
+        case '5':
+        case '6':
+        case '7':
+        case '8':
+        case '9':
+        case '0':
+        case '-':
+        case '+':
+        case '.':
+            unget();
+            return (parseNumber());
+        case 't':
+        case 'f':
+            unget();
+            return (parseBool());
+        case 'n':
+            unget();
+            return (parseNull());
+        case '"':
+            unget();
+            return (parseString());
+        case '[':
+            return (parseList());
+        case '{':
+            return (parseMap());
+        case EOF:
+            break;
+        default:
+            throwJSONError(std::string("error: unexpected character ") +
+                           std::string(1, c), file_, line_, pos_);
+        }
+        isc_throw(JSONError, "nothing read");
+    }
+
+    /// @brief Checks that only whitespaces remain after the parsed element.
+    ///
+    /// @throw JSONError when some other data follows.
+    void checkEnd() {
+        skipWhitespace();
+        if (cur_ != end_) {
+            throwJSONError("Extra data", file_, line_, pos_);
+        }
+    }
+
+private:
+
+    /// @brief Returns the current character without consuming it.
+    int peek() const {
+        return (cur_ < end_ ? static_cast<unsigned char>(*cur_) : EOF);
+    }
+
+    /// @brief Returns the current character and consumes it.
+    int get() {
+        return (cur_ < end_ ? static_cast<unsigned char>(*cur_++) : EOF);
+    }
+
+    /// @brief Puts back the last consumed character.
+    void unget() {
+        --cur_;
+        --pos_;
+    }
+
+    /// @brief Skips whitespaces (counterpart of @c skipChars).
+    void skipWhitespace() {
+        while ((cur_ < end_) && isWhitespace(*cur_)) {
+            if (*cur_ == '\n') {
+                ++line_;
+                pos_ = 1;
+            } else {
+                ++pos_;
+            }
+            ++cur_;
+        }
+    }
+
+    /// @brief Skips whitespaces up to one of the specified characters
+    /// (counterpart of @c skipTo).
+    ///
+    /// @param chars Expected characters.
+    /// @return The found character.
+    int skipTo(const char* chars) {
+        int c = get();
+        ++pos_;
+        while (c != EOF) {
+            if (c == '\n') {
+                pos_ = 1;
+                ++line_;
+            }
+            if (isWhitespace(c)) {
+                c = get();
+                ++pos_;
+            } else if (charIn(c, chars)) {
+                skipWhitespace();
+                return (c);
+            } else {
+                throwJSONError(std::string("'") + std::string(1, c) +
+                               "' read, one of \"" + chars + "\" expected",
+                               file_, line_, pos_);
+            }
+        }
+        throwJSONError(std::string("EOF read, one of \"") + chars +
+                       "\" expected", file_, line_, pos_);
+        return (c);
+    }
+
+    /// @brief Parses a quoted string (counterpart of
+    /// @c strFromStringstream).
+    ///
+    /// @return The unescaped string value.
+    std::string parseStringValue() {
+        int c = get();
+        ++pos_;
+        if (c != '"') {
+            throwJSONError("String expected", file_, line_, pos_);
+        }
+        std::string value;
+        for (;;) {
+            const char* run_end = findStringDelimiter(cur_, end_);
+            value.append(cur_, run_end);
+            pos_ += run_end - cur_;
+            cur_ = run_end;
+            c = get();
+            ++pos_;
+            if (c == '"') {
+                return (value);
+            } else if (c == EOF) {
+                throwJSONError("Unterminated string", file_, line_, pos_);
+            }
+            // This is a backslash: see the spec for allowed escape characters.
+            int d;
+            switch (peek()) {
+            case '"':
+                c = '"';
+                break;
+            case '/':
+                c = '/';
+                break;
+            case '\\':
+                c = '\\';
+                break;
+            case 'b':
+                c = '\b';
+                break;
+            case 'f':
+                c = '\f';
+                break;
+            case 'n':
+                c = '\n';
+                break;
+            case 'r':
+                c = '\r';
+                break;
+            case 't':
+                c = '\t';
+                break;
+            case 'u':
+                // skip first 0
+                ++cur_;
+                ++pos_;
+                if (peek() != '0') {
+                    throwJSONError("Unsupported unicode escape", file_, line_,
+                                   pos_);
+                }
+                // skip second 0
+                ++cur_;
+                ++pos_;
+                if (peek() != '0') {
+                    throwJSONError("Unsupported unicode escape", file_, line_,
+                                   pos_ - 2);
+                }
+                // get first digit
+                ++cur_;
+                ++pos_;
+                d = hexDigit(peek());
+                if (d < 0) {
+                    throwJSONError("Not hexadecimal in unicode escape", file_,
+                                   line_, pos_ - 3);
+                }
+                c = d << 4;
+                // get second digit
+                ++cur_;
+                ++pos_;
+                d = hexDigit(peek());
+                if (d < 0) {
+                    throwJSONError("Not hexadecimal in unicode escape", file_,
+                                   line_, pos_ - 4);
+                }
+                c |= d;
+                break;
+            default:
+                throwJSONError("Bad escape", file_, line_, pos_);
+            }
+            // drop the escaped char
+            ++cur_;
+            ++pos_;
+            value.push_back(static_cast<char>(c));
+        }
+    }
+
+    /// @brief Returns the value of a hexadecimal digit or -1.
+    static int hexDigit(const int d) {
+        if ((d >= '0') && (d <= '9')) {
+            return (d - '0');
+        } else if ((d >= 'A') && (d <= 'F')) {
+            return (d - 'A' + 10);
+        } else if ((d >= 'a') && (d <= 'f')) {
+            return (d - 'a' + 10);
+        }
+        return (-1);
+    }
+
+    /// @brief Parses a string element.
+    ElementPtr parseString() {
+        const uint32_t start_pos = pos_;
+        std::string value = parseStringValue();
+        return (boost::make_shared<StringElement>(std::move(value),
+                                                  Element::Position(file_, line_,
+                                                                    start_pos)));
+    }
+
+    /// @brief Parses a number element (counterpart of
+    /// @c fromStringstreamNumber).
+    ElementPtr parseNumber() {
+        const uint32_t start_pos = pos_;
+        const char* begin = cur_;
+        bool is_double = false;
+        bool is_simple = true;
+        while (cur_ < end_) {
+            const char c = *cur_;
+            if ((c == '.') || (c == 'e') || (c == 'E')) {
+                is_double = true;
+            } else if ((c == '+') || ((c == '-') && (cur_ != begin))) {
+                is_simple = false;
+            } else if (!isdigit(static_cast<unsigned char>(c)) && (c != '-')) {
+                break;
+            }
+            ++cur_;
+        }
+        pos_ += cur_ - begin;
+
+        if (!is_double && is_simple) {
+            // Fast path for the common case of a short decimal integer
+            // which can't overflow: the value is computed in place.
+            const char* p = begin;
+            const bool negative = (*p == '-');
+            if (negative) {
+                ++p;
+            }
+            const size_t digits = cur_ - p;
+            if ((digits > 0) && (digits <= 18)) {
+                int64_t value = 0;
+                for (; p < cur_; ++p) {
+                    value = value * 10 + (*p - '0');
+                }
+                return (Element::create(static_cast<long long int>(negative ?
+                                                                   -value : value),
+                                        Element::Position(file_, line_,
+                                                          start_pos)));
+            }
+        }
+
+        const std::string number(begin, cur_);
+        if (is_double) {
+            try {
+                return (Element::create(boost::lexical_cast<double>(number),
+                                        Element::Position(file_, line_,
+                                                          start_pos)));
+            } catch (const boost::bad_lexical_cast&) {
+                throwJSONError(std::string("Number overflow: ") + number,
+                               file_, line_, start_pos);
+            }
+        } else {
+            try {
+                return (Element::create(boost::lexical_cast<int64_t>(number),
+                                        Element::Position(file_, line_,
+                                                          start_pos)));
+            } catch (const boost::bad_lexical_cast&) {
+                throwJSONError(std::string("Number overflow: ") + number,
+                               file_, line_, start_pos);
+            }
+        }
+        return (ElementPtr());
+    }
+
+    /// @brief Reads a word (counterpart of @c wordFromStringstream).
+    std::string parseWord() {
+        const char* begin = cur_;
+        while ((cur_ < end_) && isalpha(static_cast<unsigned char>(*cur_))) {
+            ++cur_;
+        }
+        pos_ += cur_ - begin;
+        return (std::string(begin, cur_));
+    }
+
+    /// @brief Parses a boolean element.
+    ElementPtr parseBool() {
+        const uint32_t start_pos = pos_;
+        const std::string word = parseWord();
+        if (word == "true") {
+            return (Element::create(true, Element::Position(file_, line_,
+                                                            start_pos)));
+        } else if (word == "false") {
+            return (Element::create(false, Element::Position(file_, line_,
+                                                             start_pos)));
+        }
+        throwJSONError(std::string("Bad boolean value: ") + word, file_,
+                       line_, start_pos);
+        return (ElementPtr());
+    }
+
+    /// @brief Parses a null element.
+    ElementPtr parseNull() {
+        const uint32_t start_pos = pos_;
+        const std::string word = parseWord();
+        if (word != "null") {
+            throwJSONError(std::string("Bad null value: ") + word, file_,
+                           line_, start_pos);
+        }
+        return (Element::create(Element::Position(file_, line_, start_pos)));
+    }
+
+    /// @brief Parses a list element (the opening bracket was consumed).
+    ElementPtr parseList() {
+        int c = 0;
+        ElementPtr list = Element::createList(Element::Position(file_, line_,
+                                                                pos_));
+        skipWhitespace();
+        while (c != EOF && c != ']') {
+            if (peek() != ']') {
+                list->add(parseElement());
+                c = skipTo(",]");
+            } else {
+                c = get();
+                ++pos_;
+            }
+        }
+        return (list);
+    }
+
+    /// @brief Parses a map element (the opening brace was consumed).
+    ElementPtr parseMap() {
+        ElementPtr map = Element::createMap(Element::Position(file_, line_,
+                                                              pos_));
+        skipWhitespace();
+        int c = peek();
+        if (c == EOF) {
+            throwJSONError(std::string("Unterminated map, <string> or } expected"),
+                           file_, line_, pos_);
+        } else if (c == '}') {
+            // empty map, skip closing curly
+            ++cur_;
+        } else {
+            while (c != EOF && c != '}') {
+                const std::string key = parseStringValue();
+                skipTo(":");
+                map->set(key, parseElement());
+                c = skipTo(",}");
+            }
+        }
+        return (map);
+    }
+
+    /// @brief Current parsing position.
+    const char* cur_;
+
+    /// @brief End of the buffer.
+    const char* end_;
+
+    /// @brief File name.
+    const std::string& file_;
+
+    /// @brief Current line.
+    int line_;
+
+    /// @brief Current position within the line.
+    int pos_;
+};
+
+/// @brief Parses the JSON text held in a string.
+///
+/// @param text The text to parse.
+/// @param file File name used in positions and error messages.
+/// @param line Initial line number.
+/// @param pos Initial position within the line.
+/// @param check_end When true the text must hold only one element.
+/// @return Parsed element.
+/// @throw JSONError
+ElementPtr
+fromJSONBuffer(const std::string& text, const std::string& file,
+               const int line, const int pos, const bool check_end) {
+    BufferParser parser(text.data(), text.size(), file, line, pos);
+    ElementPtr element = parser.parseElement();
+    if (check_end) {
+        parser.checkEnd();
+    }
+    return (element);
+}
+
+/// @brief Reads the whole content of the input stream.
+///
+/// @param in The input stream.
+/// @return The content.
+std::string
+readStream(std::istream& in) {
+    std::string content;
+    in.seekg(0, std::ios::end);
+    const std::streamoff size = in.tellg();
+    in.seekg(0, std::ios::beg);
+    if (in && (size > 0)) {
+        content.resize(static_cast<size_t>(size));
+        in.read(&content[0], size);
+        content.resize(static_cast<size_t>(in.gcount()));
+    } else {
+        // Not seekable (e.g. a pipe).
+        in.clear();
+        content.assign(std::istreambuf_iterator<char>(in),
+                       std::istreambuf_iterator<char>());
+    }
+    return (content);
+}
 } // end anonymous namespace
 
 std::string
@@ -757,21 +1268,17 @@ Element::fromJSON(std::istream& in, const std::string& file, int& line,
 
 ElementPtr
 Element::fromJSON(const std::string& in, bool preproc) {
-    std::stringstream ss;
-    ss << in;
-
-    int line = 1, pos = 1;
-    stringstream filtered;
+    static const std::string file("<string>");
     if (preproc) {
+        std::stringstream ss;
+        ss << in;
+        stringstream filtered;
         preprocess(ss, filtered);
+        // The whole input was consumed by the preprocessing so there is
+        // no extra data check.
+        return (fromJSONBuffer(filtered.str(), file, 1, 1, false));
     }
-    ElementPtr result(fromJSON(preproc ? filtered : ss, "<string>", line, pos));
-    skipChars(ss, WHITESPACE, line, pos);
-    // ss must now be at end
-    if (ss.peek() != EOF) {
-        throwJSONError("Extra data", "<string>", line, pos);
-    }
-    return result;
+    return (fromJSONBuffer(in, file, 1, 1, true));
 }
 
 ElementPtr
@@ -786,7 +1293,13 @@ Element::fromJSONFile(const std::string& file_name, bool preproc) {
                   << "': " << error);
     }
 
-    return (fromJSON(infile, file_name, preproc));
+    // Read the whole file at once and parse it from memory.
+    if (preproc) {
+        stringstream filtered;
+        preprocess(infile, filtered);
+        return (fromJSONBuffer(filtered.str(), file_name, 1, 1, false));
+    }
+    return (fromJSONBuffer(readStream(infile), file_name, 1, 1, false));
 }
 
 // to JSON format
@@ -829,48 +1342,58 @@ NullElement::toJSON(std::ostream& ss) const {
 void
 StringElement::toJSON(std::ostream& ss) const {
     ss << "\"";
-    const std::string& str = stringValue();
+    const std::string& str = s;
+    // Characters which need no escaping are written in runs rather than
+    // one by one.
+    size_t run_start = 0;
     for (size_t i = 0; i < str.size(); ++i) {
         const char c = str[i];
+        char esc[7] = { '\\', 0, 0, 0, 0, 0, 0 };
+        size_t esc_len = 2;
         // Escape characters as defined in JSON spec
         // Note that we do not escape forward slash; this
         // is allowed, but not mandatory.
         switch (c) {
         case '"':
-            ss << '\\' << c;
+            esc[1] = c;
             break;
         case '\\':
-            ss << '\\' << c;
+            esc[1] = c;
             break;
         case '\b':
-            ss << '\\' << 'b';
+            esc[1] = 'b';
             break;
         case '\f':
-            ss << '\\' << 'f';
+            esc[1] = 'f';
             break;
         case '\n':
-            ss << '\\' << 'n';
+            esc[1] = 'n';
             break;
         case '\r':
-            ss << '\\' << 'r';
+            esc[1] = 'r';
             break;
         case '\t':
-            ss << '\\' << 't';
+            esc[1] = 't';
             break;
         default:
             if (((c >= 0) && (c < 0x20)) || (c < 0) || (c >= 0x7f)) {
-                std::ostringstream esc;
-                esc << "\\u"
-                    << hex
-                    << setw(4)
-                    << setfill('0')
-                    << (static_cast<unsigned>(c) & 0xff);
-                ss << esc.str();
+                static const char hex_digits[] = "0123456789abcdef";
+                const unsigned value = static_cast<unsigned>(c) & 0xff;
+                esc[1] = 'u';
+                esc[2] = '0';
+                esc[3] = '0';
+                esc[4] = hex_digits[value >> 4];
+                esc[5] = hex_digits[value & 0xf];
+                esc_len = 6;
             } else {
-                ss << c;
+                continue;
             }
         }
+        ss.write(str.data() + run_start, i - run_start);
+        ss.write(esc, esc_len);
+        run_start = i + 1;
     }
+    ss.write(str.data() + run_start, str.size() - run_start);
     ss << "\"";
 }
 
@@ -933,10 +1456,8 @@ MapElement::find(const std::string& id) const {
 
 ElementPtr
 Element::fromWire(const std::string& s) {
-    std::stringstream ss;
-    ss << s;
-    int line = 0, pos = 0;
-    return (fromJSON(ss, "<wire>", line, pos));
+    static const std::string file("<wire>");
+    return (fromJSONBuffer(s, file, 0, 0, false));
 }
 
 ElementPtr
@@ -412,6 +412,10 @@ public:
 
     //@{
     /// Creates an Element from the given JSON string
+    ///
+    /// The string is parsed in place, which is faster than parsing
+    /// it from an input stream.
+    ///
     /// @param in The string to parse the element from
     /// @param preproc specified whether preprocessing (e.g. comment removal)
     ///                should be performed
@@ -463,6 +467,8 @@ public:
 
     /// Reads contents of specified file and interprets it as JSON.
     ///
+    /// The whole file is read in memory before it is parsed.
+    ///
     /// @param file_name name of the file to read
     /// @param preproc specified whether preprocessing (e.g. comment removal)
     ///                should be performed
@@ -642,7 +648,7 @@ class StringElement : public Element {
 
 public:
     StringElement(std::string v, const Position& pos = ZERO_POSITION())
-        : Element(string, pos), s(v) {};
+        : Element(string, pos), s(std::move(v)) {};
     std::string stringValue() const { return (s); }
     using Element::getValue;
     bool getValue(std::string& t) const { t = s; return (true); }
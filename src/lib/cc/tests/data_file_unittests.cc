@@ -1,4 +1,4 @@
-// Copyright (C) 2014-2018 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2014-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -88,6 +88,27 @@ TEST_F(DataFileTest, readFileComments) {
     EXPECT_TRUE(exp->equals(*Element::fromJSONFile(TEMP_FILE, true)));
 }
 
+// Test checks that positions and errors refer to the file.
+TEST_F(DataFileTest, readFilePositions) {
+    writeFile("{\n  \"abc\": [ 1,\n    \"def\" ]\n}\n");
+
+    ElementPtr el;
+    ASSERT_NO_THROW(el = Element::fromJSONFile(TEMP_FILE));
+    ASSERT_TRUE(el);
+    ConstElementPtr def = el->get("abc")->get(1);
+    ASSERT_TRUE(def);
+    EXPECT_EQ(std::string(TEMP_FILE) + ":3:5", def->getPosition().str());
+
+    writeFile("{\n  \"abc\": [ 1,\n    \"def\" }\n}\n");
+    try {
+        Element::fromJSONFile(TEMP_FILE);
+        ADD_FAILURE() << "expected JSONError";
+    } catch (const JSONError& ex) {
+        EXPECT_EQ(std::string("'}' read, one of \",]\" expected in ") +
+                  TEMP_FILE + ":3:12", ex.what());
+    }
+}
+
 // This test checks that missing file will generate an exception.
 TEST_F(DataFileTest, readFileError) {
 
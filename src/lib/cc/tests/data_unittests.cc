@@ -11,6 +11,7 @@
 #include <boost/pointer_cast.hpp>
 #include <boost/assign/std/vector.hpp>
 #include <climits>
+#include <cstring>
 
 #include <cc/data.h>
 #include <util/unittests/check_valgrind.h>
@@ -1526,4 +1527,103 @@ TEST(Element, removeEmptyContainersRecursively) {
 )"));
 }
 
+// Parses a string using the stream based parser and returns either the
+// parsed element in the textual form or the error message. This is used
+// to check that the string based parser behaves identically.
+std::string
+parseWithStream(const std::string& input, ElementPtr& element) {
+    std::istringstream iss(input);
+    int line = 1;
+    int pos = 1;
+    try {
+        element = Element::fromJSON(iss, "<string>", line, pos);
+        while (iss.peek() != EOF &&
+               std::strchr(" \b\f\n\r\t", iss.peek())) {
+            if (iss.get() == '\n') {
+                ++line;
+                pos = 1;
+            } else {
+                ++pos;
+            }
+        }
+        if (iss.peek() != EOF) {
+            std::ostringstream msg;
+            msg << "Extra data in <string>:" << line << ":" << pos;
+            return (msg.str());
+        }
+        return (element->str());
+    } catch (const std::exception& ex) {
+        return (ex.what());
+    }
+}
+
+// Checks that the string (buffer) parser and the stream parser agree on
+// the elements, on their positions and on the errors.
+TEST(Element, fromJSONBufferAndStream) {
+    std::vector<std::string> sv;
+    sv.push_back("{ \"a\": 1, \"b\": [ true, false, null ],\n"
+                 "  \"c\": { \"d\": -1.5e3, \"e\": \"x\\ty\\u00ff\" } }");
+    sv.push_back("[ 1, 2, ]");
+    sv.push_back("\n\n  [\n \"multi\nline\", \"a long string without any "
+                 "escapes which spans several words\" ]\n");
+    sv.push_back("-123456789012345678");
+    sv.push_back("9223372036854775807");
+    sv.push_back("+12");
+    sv.push_back("1-2");
+    sv.push_back("12345678901234567890");
+    sv.push_back("{ \"a\": 1, }");
+    sv.push_back("{ \"a\" 1 }");
+    sv.push_back("[ 1 2 ]");
+    sv.push_back("{ \n \"aaa\nbbb\"err:");
+    sv.push_back("\"\\u00ag\"");
+    sv.push_back("\"\\u0123\"");
+    sv.push_back("\"\\x\"");
+    sv.push_back("\"unterminated");
+    sv.push_back("[ tru ]");
+    sv.push_back("{");
+    sv.push_back("[");
+    sv.push_back("");
+    sv.push_back("[]hello");
+
+    for (auto const& s : sv) {
+        SCOPED_TRACE(s);
+        ElementPtr stream_el;
+        const std::string expected = parseWithStream(s, stream_el);
+        ElementPtr buffer_el;
+        std::string actual;
+        try {
+            buffer_el = Element::fromJSON(s);
+            actual = buffer_el->str();
+        } catch (const std::exception& ex) {
+            actual = ex.what();
+        }
+        EXPECT_EQ(expected, actual);
+        if (stream_el && buffer_el) {
+            EXPECT_EQ(stream_el->getPosition().str(),
+                      buffer_el->getPosition().str());
+        }
+    }
+
+    // Check the positions of nested elements.
+    ElementPtr el = Element::fromJSON(sv[0]);
+    ASSERT_TRUE(el);
+    EXPECT_EQ("<string>:1:8", el->get("a")->getPosition().str());
+    EXPECT_EQ("<string>:1:24", el->get("b")->get(1)->getPosition().str());
+    EXPECT_EQ("<string>:2:15", el->get("c")->get("d")->getPosition().str());
+    EXPECT_EQ("x\ty\xff", el->get("c")->get("e")->stringValue());
+}
+
+// Checks that strings with characters requiring escapes are written
+// and parsed back.
+TEST(Element, toJSONEscapes) {
+    std::string value("plain \"quoted\" back\\slash\n\t\b\f\r");
+    value.push_back('\x01');
+    value.push_back('\x7f');
+    value += " tail";
+    ElementPtr el = Element::create(value);
+    EXPECT_EQ("\"plain \\\"quoted\\\" back\\\\slash\\n\\t\\b\\f\\r"
+              "\\u0001\\u007f tail\"", el->str());
+    EXPECT_EQ(value, Element::fromJSON(el->str())->stringValue());
+}
+
 }  // namespace
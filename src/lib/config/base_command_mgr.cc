@@ -1,4 +1,4 @@
-// Copyright (C) 2017-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2017-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -97,6 +97,7 @@ BaseCommandMgr::deregisterCommand(const std::string& cmd) {
                   << "' not found.");
     }
     handlers_.erase(it);
+    clearThreadSafe(cmd);
 
     LOG_DEBUG(command_logger, DBG_COMMAND, COMMAND_DEREGISTERED).arg(cmd);
 }
@@ -109,6 +110,38 @@ BaseCommandMgr::deregisterAll() {
     handlers_.clear();
     registerCommand("list-commands",
         std::bind(&BaseCommandMgr::listCommandsHandler, this, ph::_1, ph::_2));
+
+    std::lock_guard<std::mutex> lock(thread_safe_mutex_);
+    thread_safe_commands_.clear();
+}
+
+void
+BaseCommandMgr::setThreadSafe(const std::string& cmd, const size_t concurrency) {
+    std::lock_guard<std::mutex> lock(thread_safe_mutex_);
+    thread_safe_commands_[cmd] = concurrency;
+}
+
+void
+BaseCommandMgr::clearThreadSafe(const std::string& cmd) {
+    std::lock_guard<std::mutex> lock(thread_safe_mutex_);
+    thread_safe_commands_.erase(cmd);
+}
+
+bool
+BaseCommandMgr::isThreadSafe(const std::string& cmd, size_t& concurrency) const {
+    std::lock_guard<std::mutex> lock(thread_safe_mutex_);
+    auto it = thread_safe_commands_.find(cmd);
+    if (it == thread_safe_commands_.end()) {
+        return (false);
+    }
+    concurrency = it->second;
+    return (true);
+}
+
+bool
+BaseCommandMgr::isThreadSafe(const std::string& cmd) const {
+    size_t concurrency = 0;
+    return (isThreadSafe(cmd, concurrency));
 }
 
 isc::data::ConstElementPtr
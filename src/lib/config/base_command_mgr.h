@@ -1,4 +1,4 @@
-// Copyright (C) 2017-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2017-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -11,6 +11,7 @@
 #include <exceptions/exceptions.h>
 #include <functional>
 #include <map>
+#include <mutex>
 #include <string>
 
 namespace isc {
@@ -150,9 +151,40 @@ public:
     /// @brief Auxiliary method that removes all installed commands.
     ///
     /// The only unwipeable method is list-commands, which is internally
-    /// handled at all times.
+    /// handled at all times. It also clears all thread safe marks.
     void deregisterAll();
 
+    /// @brief Marks a command as thread safe.
+    ///
+    /// The handlers of the thread safe commands may be invoked by worker
+    /// threads, concurrently with each other and with the server's main
+    /// thread. The command may be handled by the local Command Manager or
+    /// by a hook library.
+    ///
+    /// @param cmd Name of the command.
+    /// @param concurrency Maximum number of concurrent invocations of
+    /// the command. The value of 0 means that there is no limit.
+    void setThreadSafe(const std::string& cmd, const size_t concurrency = 0);
+
+    /// @brief Removes the thread safe mark of a command.
+    ///
+    /// @param cmd Name of the command.
+    void clearThreadSafe(const std::string& cmd);
+
+    /// @brief Checks if a command is thread safe.
+    ///
+    /// @param cmd Name of the command.
+    /// @param [out] concurrency Maximum number of concurrent invocations of
+    /// the command, 0 when there is no limit.
+    /// @return true if the command was marked as thread safe.
+    bool isThreadSafe(const std::string& cmd, size_t& concurrency) const;
+
+    /// @brief Checks if a command is thread safe.
+    ///
+    /// @param cmd Name of the command.
+    /// @return true if the command was marked as thread safe.
+    bool isThreadSafe(const std::string& cmd) const;
+
 protected:
 
     /// @brief Handles the command having a given name and arguments.
@@ -188,6 +220,13 @@ protected:
 
 private:
 
+    /// @brief Maximum number of concurrent invocations of the thread safe
+    /// commands.
+    std::map<std::string, size_t> thread_safe_commands_;
+
+    /// @brief Mutex protecting the thread safe marks.
+    mutable std::mutex thread_safe_mutex_;
+
     /// @brief 'list-commands' command handler.
     ///
     /// This method implements command 'list-commands'. It returns a list of all
@@ -19,10 +19,17 @@
 #include <dhcp/iface_mgr.h>
 #include <config/config_log.h>
 #include <config/timeouts.h>
+#include <util/multi_threading_mgr.h>
+#include <util/thread_pool.h>
 #include <util/watch_socket.h>
 #include <boost/enable_shared_from_this.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/noncopyable.hpp>
 #include <array>
+#include <deque>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <unistd.h>
 #include <sys/file.h>
 
@@ -30,6 +37,7 @@ using namespace isc;
 using namespace isc::asiolink;
 using namespace isc::config;
 using namespace isc::data;
+using namespace isc::util;
 namespace ph = std::placeholders;
 
 namespace {
@@ -37,6 +45,172 @@ namespace {
 /// @brief Maximum size of the data chunk sent/received over the socket.
 const size_t BUF_SIZE = 32768;
 
+/// @brief Name of the critical section callbacks of the command workers.
+const std::string CS_CALLBACKS_NAME = "COMMAND_MGR";
+
+/// @brief Indicates if the current thread is a command worker thread.
+thread_local bool command_worker = false;
+
+/// @brief Processes the thread safe commands on a pool of worker threads.
+///
+/// The number of concurrent invocations of a command is limited by the
+/// concurrency given when the command was marked as thread safe. The
+/// invocations above this limit wait for a running one to complete.
+class CommandDispatcher : public boost::noncopyable {
+public:
+
+    /// @brief Type of the callback receiving the response to a command.
+    ///
+    /// It is invoked by the worker thread which processed the command.
+    typedef std::function<void(const ConstElementPtr&)> Callback;
+
+    /// @brief Constructor.
+    CommandDispatcher()
+        : pool_(), pool_size_(0), mutex_(), commands_() {
+    }
+
+    /// @brief Destructor.
+    ///
+    /// Waits for the commands in progress and stops the worker threads.
+    ~CommandDispatcher() {
+        stop();
+    }
+
+    /// @brief Sets the number of worker threads.
+    ///
+    /// The worker threads are started unless the server is in a critical
+    /// section.
+    ///
+    /// @param pool_size Number of worker threads, 0 disables them.
+    void configure(const size_t pool_size) {
+        stop();
+        pool_size_ = pool_size;
+        if (!MultiThreadingMgr::instance().isInCriticalSection()) {
+            start();
+        }
+    }
+
+    /// @brief Returns the number of worker threads.
+    size_t getPoolSize() const {
+        return (pool_size_);
+    }
+
+    /// @brief Starts the worker threads if they are configured.
+    void start() {
+        if ((pool_size_ == 0) || (pool_.size() > 0)) {
+            return;
+        }
+        pool_.start(pool_size_);
+    }
+
+    /// @brief Waits for the commands in progress and stops the worker
+    /// threads.
+    void stop() {
+        if (pool_.size() == 0) {
+            return;
+        }
+        pool_.wait();
+        pool_.stop();
+    }
+
+    /// @brief Processes a command on a worker thread if it is thread safe.
+    ///
+    /// @param cmd Pointer to the command.
+    /// @param callback Callback receiving the response.
+    /// @return true if the command is processed by a worker thread, false
+    /// if it must be processed by the caller.
+    bool dispatch(const ConstElementPtr& cmd, const Callback& callback) {
+        if (pool_.size() == 0) {
+            return (false);
+        }
+        std::string name;
+        try {
+            ConstElementPtr arg;
+            name = parseCommand(arg, cmd);
+        } catch (const std::exception&) {
+            // The error response is generated by the caller.
+            return (false);
+        }
+        size_t concurrency = 0;
+        if (!CommandMgr::instance().isThreadSafe(name, concurrency)) {
+            return (false);
+        }
+
+        auto task = boost::make_shared<CommandTask>(std::bind(&CommandDispatcher::run,
+                                                              this, name, cmd,
+                                                              callback));
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& state = commands_[name];
+        if ((concurrency == 0) || (state.running_ < concurrency)) {
+            ++state.running_;
+            pool_.add(task);
+        } else {
+            state.pending_.push_back(task);
+        }
+        return (true);
+    }
+
+private:
+
+    /// @brief Type of the tasks run by the worker threads.
+    typedef std::function<void()> CommandTask;
+
+    /// @brief Pointer to a task.
+    typedef boost::shared_ptr<CommandTask> CommandTaskPtr;
+
+    /// @brief Invocations of a command.
+    struct CommandState {
+        /// @brief Constructor.
+        CommandState() : running_(0), pending_() {
+        }
+
+        /// @brief Number of invocations in progress.
+        size_t running_;
+
+        /// @brief Invocations waiting for a running one to complete.
+        std::deque<CommandTaskPtr> pending_;
+    };
+
+    /// @brief Processes a command and schedules the next waiting invocation.
+    ///
+    /// @param name Name of the command.
+    /// @param cmd Pointer to the command.
+    /// @param callback Callback receiving the response.
+    void run(const std::string& name, const ConstElementPtr& cmd,
+             const Callback& callback) {
+        command_worker = true;
+        ConstElementPtr rsp;
+        try {
+            rsp = CommandMgr::instance().processCommand(cmd);
+        } catch (const std::exception& ex) {
+            LOG_WARN(command_logger, COMMAND_PROCESS_ERROR1).arg(ex.what());
+            rsp = createAnswer(CONTROL_RESULT_ERROR, std::string(ex.what()));
+        }
+        callback(rsp);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& state = commands_[name];
+        if (state.pending_.empty()) {
+            --state.running_;
+        } else {
+            pool_.add(state.pending_.front());
+            state.pending_.pop_front();
+        }
+    }
+
+    /// @brief Pool of worker threads.
+    ThreadPool<CommandTask> pool_;
+
+    /// @brief Number of worker threads.
+    size_t pool_size_;
+
+    /// @brief Mutex protecting the invocations.
+    std::mutex mutex_;
+
+    /// @brief Invocations of the commands.
+    std::map<std::string, CommandState> commands_;
+};
+
 class ConnectionPool;
 
 /// @brief Represents a single connection over control socket.
@@ -62,14 +236,19 @@ public:
     /// for data transmission.
     /// @param connection_pool Reference to the connection pool to which this
     /// connection belongs.
+    /// @param dispatcher Reference to the dispatcher of the thread safe
+    /// commands.
     /// @param timeout Connection timeout (in seconds).
     Connection(const IOServicePtr& io_service,
                const boost::shared_ptr<UnixDomainSocket>& socket,
                ConnectionPool& connection_pool,
+               CommandDispatcher& dispatcher,
                const long timeout)
-        : socket_(socket), timeout_timer_(*io_service), timeout_(timeout),
-          buf_(), response_(), connection_pool_(connection_pool), feed_(),
-          response_in_progress_(false), watch_socket_(new util::WatchSocket()) {
+        : io_service_(io_service), socket_(socket),
+          timeout_timer_(*io_service), timeout_(timeout),
+          buf_(), response_(), connection_pool_(connection_pool),
+          dispatcher_(dispatcher), feed_(), response_in_progress_(false),
+          watch_socket_(new util::WatchSocket()) {
 
         LOG_DEBUG(command_logger, DBG_COMMAND, COMMAND_SOCKET_CONNECTION_OPENED)
             .arg(socket_->getNative());
@@ -182,6 +361,24 @@ public:
                         size_t bytes_transferred);
 
 
+    /// @brief Sends the response to a command to the controlling client.
+    ///
+    /// @param cmd Pointer to the command or null if it couldn't be parsed.
+    /// @param rsp Pointer to the response or null if no response was
+    /// generated. In the latter case the connection is closed.
+    void respond(const ConstElementPtr& cmd, ConstElementPtr rsp);
+
+    /// @brief Handler invoked by a worker thread when a thread safe command
+    /// has been processed.
+    ///
+    /// It schedules sending the response in the IO service and marks the
+    /// watch socket ready to break the synchronous select().
+    ///
+    /// @param cmd Pointer to the command.
+    /// @param rsp Pointer to the response.
+    void asyncResponseHandler(const ConstElementPtr& cmd,
+                              const ConstElementPtr& rsp);
+
     /// @brief Handler invoked when the data is sent over the control socket.
     ///
     /// If there are still data to be sent, another asynchronous send is
@@ -201,6 +398,9 @@ public:
 
 private:
 
+    /// @brief Pointer to the IO service used to send the responses.
+    IOServicePtr io_service_;
+
     /// @brief Pointer to the socket used for transmission.
     boost::shared_ptr<UnixDomainSocket> socket_;
 
@@ -219,6 +419,9 @@ private:
     /// @brief Reference to the pool of connections.
     ConnectionPool& connection_pool_;
 
+    /// @brief Reference to the dispatcher of the thread safe commands.
+    CommandDispatcher& dispatcher_;
+
     /// @brief State model used to receive data over the connection and detect
     /// when the command ends.
     JSONFeed feed_;
@@ -348,6 +551,13 @@ Connection::receiveHandler(const boost::system::error_code& ec,
             // processing doesn't cause the timeout.
             timeout_timer_.cancel();
 
+            // The thread safe commands are processed by the worker threads.
+            if (dispatcher_.dispatch(cmd, std::bind(&Connection::asyncResponseHandler,
+                                                    shared_from_this(), cmd,
+                                                    ph::_1))) {
+                return;
+            }
+
             // If successful, then process it as a command.
             rsp = CommandMgr::instance().processCommand(cmd);
 
@@ -365,6 +575,29 @@ Connection::receiveHandler(const boost::system::error_code& ec,
         rsp = createAnswer(CONTROL_RESULT_ERROR, std::string(ex.what()));
     }
 
+    respond(cmd, rsp);
+}
+
+void
+Connection::asyncResponseHandler(const ConstElementPtr& cmd,
+                                 const ConstElementPtr& rsp) {
+    auto connection = shared_from_this();
+    io_service_->post([connection, cmd, rsp]() {
+        connection->response_in_progress_ = false;
+        connection->respond(cmd, rsp);
+    });
+
+    try {
+        watch_socket_->markReady();
+
+    } catch (const std::exception& ex) {
+        LOG_ERROR(command_logger, COMMAND_WATCH_SOCKET_MARK_READY_ERROR)
+            .arg(ex.what());
+    }
+}
+
+void
+Connection::respond(const ConstElementPtr& cmd, ConstElementPtr rsp) {
     // No response generated. Connection will be closed.
     if (!rsp) {
         LOG_WARN(command_logger, COMMAND_RESPONSE_ERROR)
@@ -478,7 +711,8 @@ public:
     /// @brief Constructor.
     CommandMgrImpl()
         : io_service_(), acceptor_(), socket_(), socket_name_(),
-          connection_pool_(), timeout_(TIMEOUT_DHCP_SERVER_RECEIVE_COMMAND) {
+          connection_pool_(), dispatcher_(),
+          timeout_(TIMEOUT_DHCP_SERVER_RECEIVE_COMMAND) {
     }
 
     /// @brief Opens acceptor service allowing the control clients to connect.
@@ -514,6 +748,9 @@ public:
     /// @brief Pool of connections.
     ConnectionPool connection_pool_;
 
+    /// @brief Dispatcher of the thread safe commands.
+    CommandDispatcher dispatcher_;
+
     /// @brief Connection timeout
     long timeout_;
 };
@@ -601,6 +838,7 @@ CommandMgrImpl::doAccept() {
             // New connection is arriving. Start asynchronous transmission.
             ConnectionPtr connection(new Connection(io_service_, socket_,
                                                     connection_pool_,
+                                                    dispatcher_,
                                                     timeout_));
             connection_pool_.start(connection);
 
@@ -663,6 +901,31 @@ CommandMgr::setConnectionTimeout(const long timeout) {
     impl_->timeout_ = timeout;
 }
 
+void
+CommandMgr::setThreadPoolSize(const size_t size) {
+    if (size > 0) {
+        // The worker threads are stopped during the critical sections.
+        MultiThreadingMgr::instance().removeCriticalSectionCallbacks(CS_CALLBACKS_NAME);
+        MultiThreadingMgr::instance().addCriticalSectionCallbacks(CS_CALLBACKS_NAME,
+            []() {
+                if (command_worker) {
+                    isc_throw(MultiThreadingInvalidOperation,
+                              "critical section entered by a command worker thread");
+                }
+            },
+            std::bind(&CommandDispatcher::stop, &impl_->dispatcher_),
+            std::bind(&CommandDispatcher::start, &impl_->dispatcher_));
+    } else {
+        MultiThreadingMgr::instance().removeCriticalSectionCallbacks(CS_CALLBACKS_NAME);
+    }
+    impl_->dispatcher_.configure(size);
+}
+
+size_t
+CommandMgr::getThreadPoolSize() const {
+    return (impl_->dispatcher_.getPoolSize());
+}
+
 
 }; // end of isc::config
 }; // end of isc
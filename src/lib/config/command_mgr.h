@@ -1,4 +1,4 @@
-// Copyright (C) 2015-2018 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2015-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -59,6 +59,23 @@ public:
     /// @param timeout New connection timeout in milliseconds.
     void setConnectionTimeout(const long timeout);
 
+    /// @brief Sets the number of threads processing the thread safe commands.
+    ///
+    /// The commands received over the control socket are processed in the
+    /// IO service by default. When the number of threads is greater than 0,
+    /// the commands marked as thread safe with @c setThreadSafe are processed
+    /// by a pool of worker threads, so they don't block the other commands.
+    /// The worker threads are stopped during the critical sections.
+    ///
+    /// @param size Number of worker threads, 0 disables them.
+    void setThreadPoolSize(const size_t size);
+
+    /// @brief Returns the number of threads processing the thread safe
+    /// commands.
+    ///
+    /// @return Number of worker threads, 0 if they are disabled.
+    size_t getThreadPoolSize() const;
+
     /// @brief Opens control socket with parameters specified in socket_info
     ///
     /// Currently supported types are:
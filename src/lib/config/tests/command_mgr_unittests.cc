@@ -1,4 +1,4 @@
-// Copyright (C) 2015-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2015-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -17,13 +17,20 @@
 #include <hooks/hooks_manager.h>
 #include <hooks/callout_handle.h>
 #include <hooks/library_handle.h>
+#include <util/multi_threading_mgr.h>
+#include <cstring>
 #include <string>
+#include <thread>
 #include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 using namespace isc::asiolink;
 using namespace isc::config;
 using namespace isc::data;
 using namespace isc::hooks;
+using namespace isc::util;
 using namespace std;
 
 // Test class for Command Manager
@@ -40,6 +47,7 @@ public:
         handler_name_ = "";
         handler_params_ = ElementPtr();
         handler_called_ = false;
+        handler_thread_ = std::thread::id();
         callout_name_ = "";
         callout_argument_names_.clear();
         std::string processed_log_ = "";
@@ -52,6 +60,7 @@ public:
 
     /// Default destructor
     virtual ~CommandMgrTest() {
+        CommandMgr::instance().setThreadPoolSize(0);
         CommandMgr::instance().deregisterAll();
         CommandMgr::instance().closeCommandSocket();
         resetCalloutIndicators();
@@ -70,6 +79,49 @@ public:
         return (socket_path);
     }
 
+    /// @brief Sends a command over the control socket and returns the
+    /// response.
+    ///
+    /// The IO service is polled until the response is received.
+    ///
+    /// @param command Text of the command.
+    /// @return Text of the response, empty on failure.
+    std::string sendCommand(const std::string& command) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            ADD_FAILURE() << "unable to create client socket";
+            return ("");
+        }
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, getSocketPath().c_str(), sizeof(addr.sun_path) - 1);
+        if ((connect(fd, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0) ||
+            (send(fd, command.c_str(), command.size(), 0) < 0)) {
+            ADD_FAILURE() << "unable to send the command";
+            close(fd);
+            return ("");
+        }
+
+        std::string response;
+        char buf[1024];
+        for (int i = 0; i < 5000; ++i) {
+            io_service_->poll();
+            ssize_t len = recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+            if (len > 0) {
+                response.append(buf, len);
+                if (response[response.size() - 1] == '}') {
+                    break;
+                }
+            } else if (len == 0) {
+                break;
+            }
+            usleep(1000);
+        }
+        close(fd);
+        return (response);
+    }
+
     /// @brief Resets indicators related to callout invocation.
     ///
     /// It also removes any registered callouts.
@@ -92,6 +144,7 @@ public:
         handler_name_ = name;
         handler_params_ = params;
         handler_called_ = true;
+        handler_thread_ = std::this_thread::get_id();
 
         return (createAnswer(123, "test error message"));
     }
@@ -162,6 +215,9 @@ public:
     /// @brief Indicates whether my_handler was called
     static bool handler_called_;
 
+    /// @brief Thread which called my_handler
+    static std::thread::id handler_thread_;
+
     /// @brief Holds invoked callout name.
     static std::string callout_name_;
 
@@ -181,6 +237,9 @@ ConstElementPtr CommandMgrTest::handler_params_;
 /// Indicates whether my_handler was called
 bool CommandMgrTest::handler_called_(false);
 
+/// Thread which called my_handler
+std::thread::id CommandMgrTest::handler_thread_;
+
 /// Holds invoked callout name.
 std::string CommandMgrTest::callout_name_("");
 
@@ -568,3 +627,90 @@ TEST_F(CommandMgrTest, exclusiveOpen) {
     // Now let's close it.
     EXPECT_NO_THROW(CommandMgr::instance().closeCommandSocket());
 }
+
+// Test checks that commands can be marked as thread safe and that the
+// mark is removed with the command.
+TEST_F(CommandMgrTest, threadSafe) {
+    EXPECT_NO_THROW(CommandMgr::instance().registerCommand("my-command1",
+                                                           my_handler));
+    EXPECT_NO_THROW(CommandMgr::instance().registerCommand("my-command2",
+                                                           my_handler));
+    EXPECT_FALSE(CommandMgr::instance().isThreadSafe("my-command1"));
+
+    CommandMgr::instance().setThreadSafe("my-command1");
+    CommandMgr::instance().setThreadSafe("my-command2", 1);
+
+    size_t concurrency = 10;
+    EXPECT_TRUE(CommandMgr::instance().isThreadSafe("my-command1", concurrency));
+    EXPECT_EQ(0, concurrency);
+    EXPECT_TRUE(CommandMgr::instance().isThreadSafe("my-command2", concurrency));
+    EXPECT_EQ(1, concurrency);
+    EXPECT_FALSE(CommandMgr::instance().isThreadSafe("my-command3"));
+
+    CommandMgr::instance().clearThreadSafe("my-command1");
+    EXPECT_FALSE(CommandMgr::instance().isThreadSafe("my-command1"));
+
+    // Removing a command removes its mark.
+    EXPECT_NO_THROW(CommandMgr::instance().deregisterCommand("my-command2"));
+    EXPECT_FALSE(CommandMgr::instance().isThreadSafe("my-command2"));
+
+    CommandMgr::instance().setThreadSafe("my-command1");
+    EXPECT_NO_THROW(CommandMgr::instance().deregisterAll());
+    EXPECT_FALSE(CommandMgr::instance().isThreadSafe("my-command1"));
+}
+
+// Test checks that the thread safe commands received over the control
+// socket are processed by the worker threads.
+TEST_F(CommandMgrTest, threadPool) {
+    MultiThreadingMgr::instance().setMode(true);
+
+    EXPECT_EQ(0, CommandMgr::instance().getThreadPoolSize());
+    EXPECT_NO_THROW(CommandMgr::instance().setThreadPoolSize(2));
+    EXPECT_EQ(2, CommandMgr::instance().getThreadPoolSize());
+
+    EXPECT_NO_THROW(CommandMgr::instance().registerCommand("my-command1",
+                                                           my_handler));
+    EXPECT_NO_THROW(CommandMgr::instance().registerCommand("my-command2",
+                                                           my_handler));
+    CommandMgr::instance().setThreadSafe("my-command2", 1);
+
+    ElementPtr socket_info = Element::createMap();
+    socket_info->set("socket-type", Element::create("unix"));
+    socket_info->set("socket-name", Element::create(getSocketPath()));
+    ASSERT_NO_THROW(CommandMgr::instance().openCommandSocket(socket_info));
+
+    // The command which is not thread safe is processed by this thread.
+    std::string response = sendCommand("{ \"command\": \"my-command1\" }");
+    EXPECT_EQ("{ \"result\": 123, \"text\": \"test error message\" }", response);
+    EXPECT_TRUE(handler_called_);
+    EXPECT_EQ("my-command1", handler_name_);
+    EXPECT_EQ(std::this_thread::get_id(), handler_thread_);
+
+    // The thread safe command is processed by a worker thread.
+    handler_called_ = false;
+    response = sendCommand("{ \"command\": \"my-command2\" }");
+    EXPECT_EQ("{ \"result\": 123, \"text\": \"test error message\" }", response);
+    EXPECT_TRUE(handler_called_);
+    EXPECT_EQ("my-command2", handler_name_);
+    EXPECT_NE(std::this_thread::get_id(), handler_thread_);
+
+    // Again within a critical section.
+    {
+        MultiThreadingCriticalSection cs;
+        handler_called_ = false;
+        response = sendCommand("{ \"command\": \"my-command2\" }");
+        EXPECT_EQ("{ \"result\": 123, \"text\": \"test error message\" }", response);
+        EXPECT_TRUE(handler_called_);
+        EXPECT_EQ(std::this_thread::get_id(), handler_thread_);
+    }
+
+    // Disabling the worker threads.
+    EXPECT_NO_THROW(CommandMgr::instance().setThreadPoolSize(0));
+    EXPECT_EQ(0, CommandMgr::instance().getThreadPoolSize());
+    handler_called_ = false;
+    response = sendCommand("{ \"command\": \"my-command2\" }");
+    EXPECT_TRUE(handler_called_);
+    EXPECT_EQ(std::this_thread::get_id(), handler_thread_);
+
+    MultiThreadingMgr::instance().setMode(false);
+}
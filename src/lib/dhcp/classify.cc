@@ -1,4 +1,4 @@
-// Copyright (C) 2014-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2014-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -10,14 +10,104 @@
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/constants.hpp>
 #include <boost/algorithm/string/split.hpp>
+#include <algorithm>
 #include <sstream>
 #include <vector>
 
 namespace isc {
 namespace dhcp {
 
+ClientClassRegistry::ClientClassRegistry()
+    : mutex_(), staging_(), snapshot_(), pending_(false), snapshots_() {
+    snapshots_.push_back(std::unique_ptr<const Names>(new Names()));
+    snapshot_.store(snapshots_.back().get());
+}
+
+ClientClassRegistry&
+ClientClassRegistry::instance() {
+    static ClientClassRegistry registry;
+    return (registry);
+}
+
+ClientClassId
+ClientClassRegistry::intern(const ClientClass& class_name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = staging_.ids_.find(class_name);
+    if (it != staging_.ids_.end()) {
+        return (it->second);
+    }
+    ClientClassId id = static_cast<ClientClassId>(staging_.names_.size());
+    staging_.ids_.insert(std::make_pair(class_name, id));
+    staging_.names_.push_back(class_name);
+    pending_.store(true);
+    return (id);
+}
+
+void
+ClientClassRegistry::commit() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!pending_.load()) {
+        return;
+    }
+    snapshots_.push_back(std::unique_ptr<const Names>(new Names(staging_)));
+    snapshot_.store(snapshots_.back().get());
+    pending_.store(false);
+}
+
+bool
+ClientClassRegistry::find(const ClientClass& class_name,
+                          ClientClassId& id) const {
+    // The flag is read first: when it is clear the snapshot loaded after
+    // holds all the names interned so far.
+    bool pending = pending_.load();
+    const Names* snapshot = snapshot_.load();
+    auto it = snapshot->ids_.find(class_name);
+    if (it != snapshot->ids_.end()) {
+        id = it->second;
+        return (true);
+    }
+    if (pending) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        it = staging_.ids_.find(class_name);
+        if (it != staging_.ids_.end()) {
+            id = it->second;
+            return (true);
+        }
+        id = static_cast<ClientClassId>(staging_.names_.size());
+        return (false);
+    }
+    id = static_cast<ClientClassId>(snapshot->names_.size());
+    return (false);
+}
+
+ClientClass
+ClientClassRegistry::getName(const ClientClassId id) const {
+    bool pending = pending_.load();
+    const Names* snapshot = snapshot_.load();
+    if (id < snapshot->names_.size()) {
+        return (snapshot->names_[id]);
+    }
+    if (pending) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (id < staging_.names_.size()) {
+            return (staging_.names_[id]);
+        }
+    }
+    return (ClientClass());
+}
+
+size_t
+ClientClassRegistry::size() const {
+    if (pending_.load()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return (staging_.names_.size());
+    }
+    return (snapshot_.load()->names_.size());
+}
+
 ClientClasses::ClientClasses(const std::string& class_names)
-    : list_(), set_() {
+    : list_(), bits_(), unregistered_(),
+      unregistered_min_id_(NO_UNREGISTERED) {
     std::vector<std::string> split_text;
     boost::split(split_text, class_names, boost::is_any_of(","),
                  boost::algorithm::token_compress_off);
@@ -30,10 +120,47 @@ ClientClasses::ClientClasses(const std::string& class_names)
     }
 }
 
+void
+ClientClasses::insert(const ClientClass& class_name) {
+    list_.push_back(class_name);
+    ClientClassId id;
+    if (ClientClassRegistry::instance().find(class_name, id)) {
+        if (id >= bits_.size()) {
+            bits_.resize(id + 1);
+        }
+        bits_.set(id);
+    } else {
+        unregistered_.insert(class_name);
+        unregistered_min_id_ = std::min(unregistered_min_id_, id);
+    }
+}
+
 void
 ClientClasses::erase(const ClientClass& class_name) {
     list_.remove(class_name);
-    static_cast<void>(set_.erase(class_name));
+    ClientClassId id;
+    if (ClientClassRegistry::instance().find(class_name, id) &&
+        (id < bits_.size())) {
+        bits_.reset(id);
+    }
+    static_cast<void>(unregistered_.erase(class_name));
+}
+
+bool
+ClientClasses::contains(const ClientClass& x) const {
+    ClientClassId id;
+    if (ClientClassRegistry::instance().find(x, id)) {
+        return (contains(id));
+    }
+    return (unregistered_.count(x) != 0);
+}
+
+bool
+ClientClasses::containsUnregistered(const ClientClassId id) const {
+    if (unregistered_.empty()) {
+        return (false);
+    }
+    return (unregistered_.count(ClientClassRegistry::instance().getName(id)) != 0);
 }
 
 std::string
@@ -7,10 +7,19 @@
 #ifndef CLASSIFY_H
 #define CLASSIFY_H
 
+#include <boost/dynamic_bitset.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <stdint.h>
+#include <atomic>
 #include <string>
 #include <iterator>
 #include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 /// @file   classify.h
 ///
@@ -36,10 +45,107 @@ namespace dhcp {
     /// @brief Defines a single class name.
     typedef std::string ClientClass;
 
+    /// @brief Defines the identifier of an interned class name.
+    typedef uint32_t ClientClassId;
+
+    /// @brief Registry of interned client class names.
+    ///
+    /// The names of the configured classes, and of the classes used by
+    /// the configuration, e.g. in the pool and subnet guards or in the
+    /// member() expressions, are interned at configuration time: each
+    /// name is given a small integer identifier which is used as a bit
+    /// index by @ref ClientClasses. A name is never removed from the
+    /// registry so the identifiers are stable, the registry only grows
+    /// with the names which appeared in the configurations.
+    ///
+    /// The names are interned in a staging table protected by a mutex,
+    /// which is published as an immutable snapshot by @ref commit when
+    /// the configuration is committed. The lookups of the packet
+    /// processing use the published snapshot without locking. They only
+    /// fall back to the staging table, under the mutex, while some names
+    /// are not yet published.
+    ///
+    /// The registry is thread safe.
+    class ClientClassRegistry : public boost::noncopyable {
+    public:
+
+        /// @brief Returns the sole instance of the registry.
+        static ClientClassRegistry& instance();
+
+        /// @brief Interns a class name.
+        ///
+        /// @param class_name The name of the class.
+        /// @return The identifier of the class name, which is allocated
+        /// when the name is not yet interned.
+        ClientClassId intern(const ClientClass& class_name);
+
+        /// @brief Publishes the names interned since the last commit.
+        ///
+        /// The snapshots are never freed as a lookup may still use
+        /// a previous one. A snapshot is only created when new names
+        /// were interned.
+        void commit();
+
+        /// @brief Looks up the identifier of a class name.
+        ///
+        /// @param class_name The name of the class.
+        /// @param [out] id The identifier of the class name when it is
+        /// interned, the number of interned names otherwise: the name
+        /// would get at least this identifier if it is interned later.
+        /// @return true if the class name is interned.
+        bool find(const ClientClass& class_name, ClientClassId& id) const;
+
+        /// @brief Returns the name of an interned class.
+        ///
+        /// @param id The identifier of the class name.
+        /// @return The class name or an empty string when the identifier
+        /// is unknown.
+        ClientClass getName(const ClientClassId id) const;
+
+        /// @brief Returns the number of interned names.
+        size_t size() const;
+
+    private:
+
+        /// @brief Interned names.
+        struct Names {
+            /// @brief Identifiers by class name.
+            std::unordered_map<ClientClass, ClientClassId> ids_;
+
+            /// @brief Class names by identifier.
+            std::vector<ClientClass> names_;
+        };
+
+        /// @brief Constructor.
+        ClientClassRegistry();
+
+        /// @brief Protects the staging names and the commits.
+        mutable std::mutex mutex_;
+
+        /// @brief All the interned names.
+        Names staging_;
+
+        /// @brief Published snapshot of the interned names.
+        std::atomic<const Names*> snapshot_;
+
+        /// @brief Flag set when names were interned since the last commit.
+        std::atomic<bool> pending_;
+
+        /// @brief The snapshots, kept for the lookups still using them.
+        std::vector<std::unique_ptr<const Names> > snapshots_;
+    };
+
     /// @brief Container for storing client class names
     ///
-    /// Both a list to iterate on it in insert order and unordered
-    /// set of names for existence.
+    /// A list to iterate on it in insert order and a bitset indexed by
+    /// the identifiers of the interned class names (see
+    /// @ref ClientClassRegistry) for existence. The names which are not
+    /// interned, e.g. the classes built from the packet contents which
+    /// are not used by the configuration, are kept in an unordered set.
+    ///
+    /// Checking an identifier is a single bit test, which is what the
+    /// pool and subnet guards and the member() expressions do: they
+    /// intern their class name when they are configured.
     class ClientClasses {
     public:
 
@@ -47,7 +153,8 @@ namespace dhcp {
         typedef std::list<ClientClass>::const_iterator const_iterator;
 
         /// @brief Default constructor.
-        ClientClasses() : list_(), set_() {
+        ClientClasses() : list_(), bits_(), unregistered_(),
+                          unregistered_min_id_(NO_UNREGISTERED) {
         }
 
         /// @brief Constructor from comma separated values.
@@ -59,10 +166,7 @@ namespace dhcp {
         /// @brief Insert an element.
         ///
         /// @param class_name The name of the class to insert
-        void insert(const ClientClass& class_name) {
-            list_.push_back(class_name);
-            set_.insert(class_name);
-        }
+        void insert(const ClientClass& class_name);
 
         /// @brief Erase element by name.
         ///
@@ -96,14 +200,29 @@ namespace dhcp {
         ///
         /// @param x client class to be checked
         /// @return true if x belongs to the classes
-        bool contains(const ClientClass& x) const {
-            return (set_.count(x) != 0);
+        bool contains(const ClientClass& x) const;
+
+        /// @brief returns if an interned class belongs to the defined classes
+        ///
+        /// @param id identifier of the interned class name to be checked
+        /// @return true if the class belongs to the classes
+        bool contains(const ClientClassId id) const {
+            if ((id < bits_.size()) && bits_.test(id)) {
+                return (true);
+            }
+            // The name may have been inserted before it was interned.
+            if (id >= unregistered_min_id_) {
+                return (containsUnregistered(id));
+            }
+            return (false);
         }
 
         /// @brief Clears containers.
         void clear() {
             list_.clear();
-            set_.clear();
+            bits_.clear();
+            unregistered_.clear();
+            unregistered_min_id_ = NO_UNREGISTERED;
         }
 
         /// @brief Returns all class names as text
@@ -114,11 +233,33 @@ namespace dhcp {
         std::string toText(const std::string& separator = ", ") const;
 
     private:
+        /// @brief Value of @c unregistered_min_id_ when all the names
+        /// are interned.
+        static const ClientClassId NO_UNREGISTERED = 0xffffffff;
+
+        /// @brief Checks if an interned class was inserted before it
+        /// was interned.
+        ///
+        /// @param id identifier of the interned class name to be checked
+        /// @return true if the name of the class is in the unregistered
+        /// names.
+        bool containsUnregistered(const ClientClassId id) const;
+
         /// @brief List/ordered part
         std::list<ClientClass> list_;
 
-        /// @brief Set/unordered part
-        std::unordered_set<ClientClass> set_;
+        /// @brief Bitset of the interned names.
+        boost::dynamic_bitset<> bits_;
+
+        /// @brief Names which were not interned when inserted.
+        std::unordered_set<ClientClass> unregistered_;
+
+        /// @brief Lowest identifier an unregistered name can get.
+        ///
+        /// The names interned before the first unregistered name was
+        /// inserted have lower identifiers and can't be unregistered
+        /// names, so they are checked with the bitset only.
+        ClientClassId unregistered_min_id_;
     };
 
 };
@@ -290,6 +290,14 @@ void IfaceMgr::closeSockets() {
     // Stops the receiver thread if there is one.
     stopDHCPReceiver();
 
+    // Stops the interface receivers if there are some.
+    stopIfaceReceivers();
+
+    // Sends the batched packets before closing their sockets.
+    if (send_batcher_) {
+        send_batcher_->flush();
+    }
+
     for (IfacePtr iface : ifaces_) {
         iface->closeSockets();
     }
@@ -406,6 +414,7 @@ IfaceMgr::setPacketFilter(const PktFilterPtr& packet_filter) {
     }
     // Everything is fine, so replace packet filter.
     packet_filter_ = packet_filter;
+    packet_filter_->setSendBatcher(send_batcher_);
 }
 
 void
@@ -424,6 +433,21 @@ IfaceMgr::setPacketFilter(const PktFilter6Ptr& packet_filter) {
     }
 
     packet_filter6_ = packet_filter;
+    packet_filter6_->setSendBatcher(send_batcher_);
+}
+
+void
+IfaceMgr::configureSendBatcher(size_t batch_size, uint32_t max_delay) {
+    PktSendBatcherPtr batcher;
+    if (batch_size > 1) {
+        batcher.reset(new PktSendBatcher(batch_size, max_delay));
+    }
+    if (send_batcher_) {
+        send_batcher_->flush();
+    }
+    send_batcher_ = batcher;
+    packet_filter_->setSendBatcher(send_batcher_);
+    packet_filter6_->setSendBatcher(send_batcher_);
 }
 
 bool
@@ -641,6 +665,11 @@ IfaceMgr::openSockets4(const uint16_t port, const bool use_bcast,
 
         // Starts the receiver thread (if queueing is enabled).
         startDHCPReceiver(AF_INET);
+
+        // Otherwise starts the interface receivers (if a callback is set).
+        if (!isDHCPReceiverRunning()) {
+            startIfaceReceivers(AF_INET);
+        }
     }
 
     return (count > 0);
@@ -730,6 +759,11 @@ IfaceMgr::openSockets6(const uint16_t port,
     if (count > 0) {
         // starts the receiver thread (if queueing is enabled).
         startDHCPReceiver(AF_INET6);
+
+        // Otherwise starts the interface receivers (if a callback is set).
+        if (!isDHCPReceiverRunning()) {
+            startIfaceReceivers(AF_INET6);
+        }
     }
     return (count > 0);
 }
@@ -767,6 +801,79 @@ IfaceMgr::startDHCPReceiver(const uint16_t family) {
     }
 }
 
+void
+IfaceMgr::setPacketReceiverCallback4(const PacketReceiverCallback4& callback) {
+    if (areIfaceReceiversRunning()) {
+        isc_throw(InvalidOperation, "interface receivers are running");
+    }
+    receiver_callback4_ = callback;
+}
+
+void
+IfaceMgr::setPacketReceiverCallback6(const PacketReceiverCallback6& callback) {
+    if (areIfaceReceiversRunning()) {
+        isc_throw(InvalidOperation, "interface receivers are running");
+    }
+    receiver_callback6_ = callback;
+}
+
+void
+IfaceMgr::startIfaceReceivers(const uint16_t family) {
+    if (areIfaceReceiversRunning()) {
+        isc_throw(InvalidOperation, "interface receivers already exist");
+    }
+
+    switch (family) {
+    case AF_INET:
+        // If there is no callback, the packets are received by the
+        // main thread.
+        if (!receiver_callback4_) {
+            return;
+        }
+        break;
+    case AF_INET6:
+        // If there is no callback, the packets are received by the
+        // main thread.
+        if (!receiver_callback6_) {
+            return;
+        }
+        break;
+    default:
+        isc_throw (BadValue, "startIfaceReceivers: invalid family: " << family);
+        break;
+    }
+
+    try {
+        for (IfacePtr iface : ifaces_) {
+            bool has_sockets = false;
+            for (SocketInfo s : iface->getSockets()) {
+                if ((family == AF_INET) ? s.addr_.isV4() : s.addr_.isV6()) {
+                    has_sockets = true;
+                    break;
+                }
+            }
+            if (!has_sockets) {
+                continue;
+            }
+            WatchedThreadPtr receiver(new WatchedThread());
+            receiver->start(std::bind(&IfaceMgr::receiveIfacePackets, this,
+                                      receiver.get(), iface, family));
+            iface_receivers_.push_back(receiver);
+        }
+    } catch (...) {
+        stopIfaceReceivers();
+        throw;
+    }
+}
+
+void
+IfaceMgr::stopIfaceReceivers() {
+    for (auto const& receiver : iface_receivers_) {
+        receiver->stop();
+    }
+    iface_receivers_.clear();
+}
+
 void
 IfaceMgr::addInterface(const IfacePtr& iface) {
     for (const IfacePtr& existing : ifaces_) {
@@ -1128,6 +1235,12 @@ Pkt4Ptr IfaceMgr::receive4(uint32_t timeout_sec, uint32_t timeout_usec /* = 0 */
         return (receive4Indirect(timeout_sec, timeout_usec));
     }
 
+    if (areIfaceReceiversRunning()) {
+        // The packets are handed to the receiver callback.
+        receiveExternal(timeout_sec, timeout_usec);
+        return (Pkt4Ptr());
+    }
+
     return (receive4Direct(timeout_sec, timeout_usec));
 }
 
@@ -1383,6 +1496,12 @@ IfaceMgr::receive6(uint32_t timeout_sec, uint32_t timeout_usec /* = 0 */) {
         return (receive6Indirect(timeout_sec, timeout_usec));
     }
 
+    if (areIfaceReceiversRunning()) {
+        // The packets are handed to the receiver callback.
+        receiveExternal(timeout_sec, timeout_usec);
+        return (Pkt6Ptr());
+    }
+
     return (receive6Direct(timeout_sec, timeout_usec));
 }
 
@@ -1643,6 +1762,174 @@ IfaceMgr::receive6Indirect(uint32_t timeout_sec, uint32_t timeout_usec /* = 0 */
     return (pkt);
 }
 
+void
+IfaceMgr::receiveExternal(uint32_t timeout_sec, uint32_t timeout_usec) {
+    // Sanity check for microsecond timeout.
+    if (timeout_usec >= 1000000) {
+        isc_throw(BadValue, "fractional timeout must be shorter than"
+                  " one million microseconds");
+    }
+
+    fd_set sockets;
+    int maxfd = 0;
+
+    FD_ZERO(&sockets);
+
+    // if there are any callbacks for external sockets registered...
+    {
+        std::lock_guard<std::mutex> lock(callbacks_mutex_);
+        for (SocketCallbackInfo s : callbacks_) {
+            // Add this socket to listening set
+            addFDtoSet(s.socket_, maxfd, &sockets);
+        }
+    }
+
+    // Add interface receivers error watch sockets.
+    for (auto const& receiver : iface_receivers_) {
+        addFDtoSet(receiver->getWatchFd(WatchedThread::ERROR), maxfd, &sockets);
+    }
+
+    struct timeval select_timeout;
+    select_timeout.tv_sec = timeout_sec;
+    select_timeout.tv_usec = timeout_usec;
+
+    // zero out the errno to be safe
+    errno = 0;
+
+    int result = select(maxfd + 1, &sockets, 0, 0, &select_timeout);
+
+    if (result == 0) {
+        // nothing received and timeout has been reached
+        return;
+    } else if (result < 0) {
+        // See receive4Indirect.
+        if (errno == EINTR) {
+            isc_throw(SignalInterruptOnSelect, strerror(errno));
+        } else if (errno == EBADF) {
+            int cnt = purgeBadSockets();
+            isc_throw(SocketReadError,
+                      "SELECT interrupted by one invalid sockets, purged "
+                       << cnt << " socket descriptors");
+        } else {
+            isc_throw(SocketReadError, strerror(errno));
+        }
+    }
+
+    // Check for interface receivers read errors.
+    for (auto const& receiver : iface_receivers_) {
+        if (receiver->isReady(WatchedThread::ERROR)) {
+            string msg = receiver->getLastError();
+            receiver->clearReady(WatchedThread::ERROR);
+            isc_throw(SocketReadError, msg);
+        }
+    }
+
+    // Let's find out which external socket has the data
+    SocketCallbackInfo ex_sock;
+    {
+        std::lock_guard<std::mutex> lock(callbacks_mutex_);
+        for (SocketCallbackInfo s : callbacks_) {
+            if (FD_ISSET(s.socket_, &sockets) && s.callback_) {
+                // Note the external socket to call its callback without
+                // the lock taken so it can be deleted.
+                ex_sock = s;
+                break;
+            }
+        }
+    }
+
+    if (ex_sock.callback_) {
+        // Calling the external socket's callback provides its service
+        // layer access without integrating any specific features
+        // in IfaceMgr
+        ex_sock.callback_(ex_sock.socket_);
+    }
+}
+
+void
+IfaceMgr::receiveIfacePackets(WatchedThread* receiver, IfacePtr iface,
+                              const uint16_t family) {
+    fd_set sockets;
+    int maxfd = 0;
+
+    FD_ZERO(&sockets);
+
+    // Add terminate watch socket.
+    addFDtoSet(receiver->getWatchFd(WatchedThread::TERMINATE), maxfd, &sockets);
+
+    // Add the interface sockets of the family. The sockets do not change
+    // while the receiver is running as they are closed after the receivers
+    // are stopped.
+    Iface::SocketCollection iface_sockets;
+    for (SocketInfo s : iface->getSockets()) {
+        if ((family == AF_INET) ? s.addr_.isV4() : s.addr_.isV6()) {
+            addFDtoSet(s.sockfd_, maxfd, &sockets);
+            iface_sockets.push_back(s);
+        }
+    }
+
+    for (;;) {
+        // Check the watch socket.
+        if (receiver->shouldTerminate()) {
+            return;
+        }
+
+        fd_set rd_set;
+        FD_COPY(&sockets, &rd_set);
+
+        // zero out the errno to be safe.
+        errno = 0;
+
+        // Select with null timeouts to wait indefinitely an event
+        int result = select(maxfd + 1, &rd_set, 0, 0, 0);
+
+        // Re-check the watch socket.
+        if (receiver->shouldTerminate()) {
+            return;
+        }
+
+        if (result == 0) {
+            // nothing received?
+            continue;
+
+        } else if (result < 0) {
+            // This thread should not get signals?
+            if (errno != EINTR) {
+                // Signal the error to the main thread.
+                receiver->setError(strerror(errno));
+                // We need to sleep in case of the error condition to
+                // prevent the thread from tight looping when result
+                // gets negative.
+                sleep(1);
+            }
+            continue;
+        }
+
+        for (SocketInfo s : iface_sockets) {
+            if (!FD_ISSET(s.sockfd_, &rd_set)) {
+                continue;
+            }
+            try {
+                if (family == AF_INET) {
+                    Pkt4Ptr pkt = packet_filter_->receive(*iface, s);
+                    if (pkt) {
+                        receiver_callback4_(pkt);
+                    }
+                } else {
+                    Pkt6Ptr pkt = packet_filter6_->receive(s);
+                    if (pkt) {
+                        receiver_callback6_(pkt);
+                    }
+                }
+            } catch (const std::exception& ex) {
+                receiver->setError(ex.what());
+            } catch (...) {
+                receiver->setError("packet filter receive() failed");
+            }
+        }
+    }
+}
+
 void
 IfaceMgr::receiveDHCP4Packets() {
     fd_set sockets;
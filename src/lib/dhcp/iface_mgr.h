@@ -647,6 +647,14 @@ public:
     /// Defines storage container for callbacks for external sockets
     typedef std::list<SocketCallbackInfo> SocketCallbackInfoContainer;
 
+    /// Defines callback invoked by the interface receivers for each
+    /// received DHCPv4 packet.
+    typedef std::function<void (const Pkt4Ptr& pkt)> PacketReceiverCallback4;
+
+    /// Defines callback invoked by the interface receivers for each
+    /// received DHCPv6 packet.
+    typedef std::function<void (const Pkt6Ptr& pkt)> PacketReceiverCallback6;
+
     /// @brief Packet reception buffer size
     ///
     /// RFC 8415 states that server responses may be
@@ -845,7 +853,9 @@ public:
     ///
     /// Wrapper around calls to either @c receive4Direct or @c
     /// receive4Indirect.  The former is called when packet queuing is
-    /// disabled, the latter when it is enabled.
+    /// disabled, the latter when it is enabled. When the interface
+    /// receivers are running only the external sockets are handled and
+    /// no packet is returned.
     ///
     /// @param timeout_sec specifies integral part of the timeout (in seconds)
     /// @param timeout_usec specifies fractional part of the timeout
@@ -858,7 +868,9 @@ public:
     ///
     /// Wrapper around calls to either @c receive4Direct or @c
     /// receive4Indirect.  The former is called when packet queuing is
-    /// disabled, the latter when it is enabled.
+    /// disabled, the latter when it is enabled. When the interface
+    /// receivers are running only the external sockets are handled and
+    /// no packet is returned.
     ///
     /// @param timeout_sec specifies integral part of the timeout (in seconds)
     /// @param timeout_usec specifies fractional part of the timeout
@@ -1252,6 +1264,69 @@ public:
         return (dhcp_receiver_ != 0 && dhcp_receiver_->isRunning());
     }
 
+    /// @brief Sets the callback receiving the DHCPv4 packets read by the
+    /// interface receivers.
+    ///
+    /// When the callback is set, @c openSockets4 starts one receiver thread
+    /// per interface with open IPv4 sockets unless packet queueing is
+    /// enabled. The receivers hand each packet to the callback so the
+    /// reception scales with the number of interfaces and the main thread
+    /// only handles the external sockets and the timers.
+    ///
+    /// @param callback callback invoked in the receiver threads, or null
+    /// to disable the interface receivers.
+    /// @throw InvalidOperation if the interface receivers are running.
+    void setPacketReceiverCallback4(const PacketReceiverCallback4& callback);
+
+    /// @brief Sets the callback receiving the DHCPv6 packets read by the
+    /// interface receivers.
+    ///
+    /// See @c setPacketReceiverCallback4 for details.
+    ///
+    /// @param callback callback invoked in the receiver threads, or null
+    /// to disable the interface receivers.
+    /// @throw InvalidOperation if the interface receivers are running.
+    void setPacketReceiverCallback6(const PacketReceiverCallback6& callback);
+
+    /// @brief Starts the interface receivers.
+    ///
+    /// Starts one receiver thread for each interface having open sockets
+    /// of the given family if a packet receiver callback is set for this
+    /// family, otherwise it simply returns.
+    ///
+    /// @param family indicates which receivers to start,
+    /// (AF_INET or AF_INET6)
+    ///
+    /// @throw InvalidOperation if the receivers are already running.
+    void startIfaceReceivers(const uint16_t family);
+
+    /// @brief Stops the interface receivers.
+    void stopIfaceReceivers();
+
+    /// @brief Configures the batching of the sent packets.
+    ///
+    /// When enabled, the packet filters hand the sent messages to a
+    /// @c PktSendBatcher which sends them with one system call per batch.
+    /// Must not be called while other threads send packets.
+    ///
+    /// @param batch_size Number of messages of a batch, 0 or 1 disable the
+    /// batching.
+    /// @param max_delay Maximum time in microseconds a message waits in a
+    /// batch.
+    /// @throw BadValue if the batch size or the delay are out of range.
+    void configureSendBatcher(size_t batch_size, uint32_t max_delay);
+
+    /// @brief Returns the batcher of the sent packets (null when the
+    /// batching is disabled).
+    PktSendBatcherPtr getSendBatcher() const {
+        return (send_batcher_);
+    }
+
+    /// @brief Returns true if the interface receivers are running.
+    bool areIfaceReceiversRunning() const {
+        return (!iface_receivers_.empty());
+    }
+
     /// @brief Configures DHCP packet queue
     ///
     /// If the given configuration enables packet queueing, then the
@@ -1520,6 +1595,33 @@ private:
     /// @param socket_info structure holding socket information
     void receiveDHCP6Packet(const SocketInfo& socket_info);
 
+    /// @brief Interface receiver method.
+    ///
+    /// Loops reading DHCPv4 or DHCPv6 packets from the sockets of an
+    /// interface and passes them to the packet receiver callback until
+    /// the "terminate" watch socket of the receiver is marked ready.
+    /// Errors are reported by marking the "error" watch socket as ready.
+    ///
+    /// @param receiver receiver thread running this method
+    /// @param iface interface
+    /// @param family indicates which sockets to read (AF_INET or AF_INET6)
+    void receiveIfacePackets(isc::util::WatchedThread* receiver,
+                             IfacePtr iface, const uint16_t family);
+
+    /// @brief Waits for events on the external sockets when the packets
+    /// are read by the interface receivers.
+    ///
+    /// @param timeout_sec specifies integral part of the timeout (in seconds)
+    /// @param timeout_usec specifies fractional part of the timeout
+    /// (in microseconds)
+    ///
+    /// @throw isc::BadValue if timeout_usec is greater than one million
+    /// @throw isc::dhcp::SocketReadError if an error occurred in a receiver
+    /// or if select() failed.
+    /// @throw isc::dhcp::SignalInterruptOnSelect when a call to select() is
+    /// interrupted by a signal.
+    void receiveExternal(uint32_t timeout_sec, uint32_t timeout_usec);
+
     /// @brief Deletes external socket with the callbacks_mutex_ taken
     ///
     /// @param socketfd socket descriptor
@@ -1561,6 +1663,20 @@ private:
 
     /// DHCP packet receiver.
     isc::util::WatchedThreadPtr dhcp_receiver_;
+
+    /// @brief Callback receiving the DHCPv4 packets read by the interface
+    /// receivers.
+    PacketReceiverCallback4 receiver_callback4_;
+
+    /// @brief Callback receiving the DHCPv6 packets read by the interface
+    /// receivers.
+    PacketReceiverCallback6 receiver_callback6_;
+
+    /// @brief Interface receivers.
+    std::vector<isc::util::WatchedThreadPtr> iface_receivers_;
+
+    /// @brief Batcher of the sent packets (may be null).
+    PktSendBatcherPtr send_batcher_;
 };
 
 }; // namespace isc::dhcp
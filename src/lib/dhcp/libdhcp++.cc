@@ -72,6 +72,9 @@ OptionDefContainers LibDHCP::option_defs_;
 // Static container with option definitions created in runtime.
 StagedValue<OptionDefSpaceContainer> LibDHCP::runtime_option_defs_;
 
+// Thread setting the uncommitted runtime option definitions.
+std::atomic<std::thread::id> LibDHCP::runtime_option_defs_thread_;
+
 // Null container.
 const OptionDefContainerPtr null_option_def_container_(new OptionDefContainer());
 
@@ -183,7 +186,7 @@ LibDHCP::getVendorOptionDef(const Option::Universe u, const uint32_t vendor_id,
 
 OptionDefinitionPtr
 LibDHCP::getRuntimeOptionDef(const std::string& space, const uint16_t code) {
-    OptionDefContainerPtr container = runtime_option_defs_.getValue().getItems(space);
+    OptionDefContainerPtr container = getRuntimeOptionDefsValue().getItems(space);
     const OptionDefContainerTypeIndex& index = container->get<1>();
     const OptionDefContainerTypeRange& range = index.equal_range(code);
     if (range.first != range.second) {
@@ -195,7 +198,7 @@ LibDHCP::getRuntimeOptionDef(const std::string& space, const uint16_t code) {
 
 OptionDefinitionPtr
 LibDHCP::getRuntimeOptionDef(const std::string& space, const std::string& name) {
-    OptionDefContainerPtr container = runtime_option_defs_.getValue().getItems(space);
+    OptionDefContainerPtr container = getRuntimeOptionDefsValue().getItems(space);
     const OptionDefContainerNameIndex& index = container->get<2>();
     const OptionDefContainerNameRange& range = index.equal_range(name);
     if (range.first != range.second) {
@@ -207,7 +210,7 @@ LibDHCP::getRuntimeOptionDef(const std::string& space, const std::string& name)
 
 OptionDefContainerPtr
 LibDHCP::getRuntimeOptionDefs(const std::string& space) {
-    return (runtime_option_defs_.getValue().getItems(space));
+    return (getRuntimeOptionDefsValue().getItems(space));
 }
 
 void
@@ -241,6 +244,22 @@ LibDHCP::commitRuntimeOptionDefs() {
     runtime_option_defs_.commit();
 }
 
+void
+LibDHCP::setRuntimeOptionDefsThread(const std::thread::id& thread_id) {
+    runtime_option_defs_thread_ = thread_id;
+}
+
+const OptionDefSpaceContainer&
+LibDHCP::getRuntimeOptionDefsValue() {
+    std::thread::id thread_id = runtime_option_defs_thread_;
+    if ((thread_id == std::thread::id()) ||
+        (thread_id == std::this_thread::get_id())) {
+        return (runtime_option_defs_.getValue());
+    }
+    // Another thread sets the runtime option definitions.
+    return (runtime_option_defs_.getCurrentValue());
+}
+
 OptionDefinitionPtr
 LibDHCP::getLastResortOptionDef(const std::string& space, const uint16_t code) {
     OptionDefContainerPtr container = getLastResortOptionDefs(space);
@@ -15,9 +15,11 @@
 #include <util/buffer.h>
 #include <util/staged_value.h>
 
+#include <atomic>
 #include <iostream>
 #include <stdint.h>
 #include <string>
+#include <thread>
 
 namespace isc {
 namespace dhcp {
@@ -351,6 +353,20 @@ public:
     /// @brief Commits runtime option definitions.
     static void commitRuntimeOptionDefs();
 
+    /// @brief Restricts the uncommitted runtime option definitions to a
+    /// thread.
+    ///
+    /// When the configuration is parsed by a background thread while the
+    /// other threads process packets with the current configuration, the
+    /// runtime option definitions set by the parser must be seen by the
+    /// parser only: the other threads keep getting the committed ones.
+    ///
+    /// @param thread_id Identifier of the thread setting the runtime option
+    /// definitions. The default identifier makes the uncommitted definitions
+    /// visible to all threads again: this must be done when no other thread
+    /// gets runtime option definitions, e.g. in a critical section.
+    static void setRuntimeOptionDefsThread(const std::thread::id& thread_id);
+
     /// @brief Converts option space name to vendor id.
     ///
     /// If the option space name is specified in the following format:
@@ -391,6 +407,13 @@ private:
 
     /// Container for additional option definitions created in runtime.
     static util::StagedValue<OptionDefSpaceContainer> runtime_option_defs_;
+
+    /// @brief Returns the runtime option definitions seen by the calling
+    /// thread.
+    static const OptionDefSpaceContainer& getRuntimeOptionDefsValue();
+
+    /// Thread setting the uncommitted runtime option definitions.
+    static std::atomic<std::thread::id> runtime_option_defs_thread_;
 };
 
 }
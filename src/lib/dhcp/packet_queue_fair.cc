@@ -0,0 +1,257 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+#include <dhcp/dhcp4.h>
+#include <dhcp/dhcp6.h>
+#include <dhcp/packet_queue_fair.h>
+#include <util/io_utilities.h>
+
+using namespace isc::asiolink;
+using namespace isc::dhcp;
+using namespace isc::util;
+
+namespace {
+
+/// @brief Offset of the hardware address length in a DHCPv4 packet.
+const size_t HLEN_OFFSET = 2;
+
+/// @brief Offset of the relay agent address in a DHCPv4 packet.
+const size_t GIADDR_OFFSET = 24;
+
+/// @brief Offset of the client hardware address in a DHCPv4 packet.
+const size_t CHADDR_OFFSET = 28;
+
+/// @brief Offset of the first option in a DHCPv4 packet.
+const size_t OPTIONS4_OFFSET = isc::dhcp::Pkt4::DHCPV4_PKT_HDR_LEN + 4;
+
+/// @brief Length of the header of a DHCPv6 client message.
+const size_t CLIENT6_HDR_LEN = 4;
+
+/// @brief Length of the header of a DHCPv6 relay message.
+const size_t RELAY6_HDR_LEN = 34;
+
+/// @brief Offset of the peer address in a DHCPv6 relay message.
+const size_t PEER_ADDR_OFFSET = 18;
+
+/// @brief Computes the FNV-1a hash of a buffer.
+///
+/// @param data pointer to the buffer
+/// @param len length of the buffer
+/// @param hash initial value of the hash
+/// @return hash of the buffer
+uint32_t
+hashBytes(const uint8_t* data, size_t len, uint32_t hash = 2166136261U) {
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= data[i];
+        hash *= 16777619U;
+    }
+    return (hash);
+}
+
+/// @brief Computes the hash of an address.
+///
+/// @param address address
+/// @return hash of the address
+uint32_t
+hashAddress(const IOAddress& address) {
+    std::vector<uint8_t> bytes = address.toBytes();
+    return (hashBytes(&bytes[0], bytes.size()));
+}
+
+/// @brief Looks for a DHCPv4 option in the raw data of a packet.
+///
+/// @param data raw packet data
+/// @param code option code
+/// @param [out] len length of the option data
+/// @return offset of the option data or 0 when the option is not found
+size_t
+findOption4(const isc::dhcp::OptionBuffer& data, uint8_t code, size_t& len) {
+    if ((data.size() < OPTIONS4_OFFSET) ||
+        (readUint32(&data[OPTIONS4_OFFSET - 4], 4) != DHCP_OPTIONS_COOKIE)) {
+        return (0);
+    }
+    size_t offset = OPTIONS4_OFFSET;
+    while (offset < data.size()) {
+        uint8_t opt_code = data[offset];
+        if (opt_code == DHO_PAD) {
+            ++offset;
+            continue;
+        }
+        if ((opt_code == DHO_END) || (offset + 1 >= data.size())) {
+            break;
+        }
+        size_t opt_len = data[offset + 1];
+        if (offset + 2 + opt_len > data.size()) {
+            break;
+        }
+        if (opt_code == code) {
+            len = opt_len;
+            return (offset + 2);
+        }
+        offset += 2 + opt_len;
+    }
+    return (0);
+}
+
+/// @brief Looks for a DHCPv6 option in the raw data of a packet.
+///
+/// @param data raw packet data
+/// @param offset offset of the first option
+/// @param end offset of the end of the options
+/// @param code option code
+/// @param [out] len length of the option data
+/// @return offset of the option data or 0 when the option is not found
+size_t
+findOption6(const isc::dhcp::OptionBuffer& data, size_t offset, size_t end,
+            uint16_t code, size_t& len) {
+    while (offset + 4 <= end) {
+        uint16_t opt_code = readUint16(&data[offset], 2);
+        size_t opt_len = readUint16(&data[offset + 2], 2);
+        if (offset + 4 + opt_len > end) {
+            break;
+        }
+        if (opt_code == code) {
+            len = opt_len;
+            return (offset + 4);
+        }
+        offset += 4 + opt_len;
+    }
+    return (0);
+}
+
+/// @brief Location of the client message in a DHCPv6 packet.
+struct ClientMessage6 {
+    /// @brief Flag set when the client message was found.
+    bool found_;
+
+    /// @brief Offset of the client message.
+    size_t offset_;
+
+    /// @brief Offset of the end of the client message.
+    size_t end_;
+
+    /// @brief Flag set when the packet is relayed.
+    bool relayed_;
+
+    /// @brief Offset of the innermost relay message.
+    size_t relay_;
+};
+
+/// @brief Finds the client message in a possibly relayed DHCPv6 packet.
+///
+/// @param data raw packet data
+/// @return location of the client message
+ClientMessage6
+findClientMessage6(const isc::dhcp::OptionBuffer& data) {
+    ClientMessage6 msg = { false, 0, data.size(), false, 0 };
+    size_t offset = 0;
+    for (int hops = 0; hops <= HOP_COUNT_LIMIT; ++hops) {
+        if (offset + CLIENT6_HDR_LEN > msg.end_) {
+            return (msg);
+        }
+        if (data[offset] != DHCPV6_RELAY_FORW) {
+            msg.found_ = true;
+            msg.offset_ = offset;
+            return (msg);
+        }
+        if (offset + RELAY6_HDR_LEN > msg.end_) {
+            return (msg);
+        }
+        msg.relayed_ = true;
+        msg.relay_ = offset;
+        size_t len = 0;
+        size_t relayed = findOption6(data, offset + RELAY6_HDR_LEN, msg.end_,
+                                     D6O_RELAY_MSG, len);
+        if (relayed == 0) {
+            return (msg);
+        }
+        offset = relayed;
+        msg.end_ = relayed + len;
+    }
+    return (msg);
+}
+
+} // end of anonymous namespace
+
+namespace isc {
+namespace dhcp {
+
+PacketQueueFair4::PriorityClass
+PacketQueueFair4::getPriorityClass(const Pkt4Ptr& packet) const {
+    size_t len = 0;
+    size_t offset = findOption4(packet->data_, DHO_DHCP_MESSAGE_TYPE, len);
+    if ((offset == 0) || (len < 1)) {
+        return (CLASS_LOW);
+    }
+    switch (packet->data_[offset]) {
+    case DHCPREQUEST:
+    case DHCPDECLINE:
+    case DHCPRELEASE:
+    case DHCPINFORM:
+        return (CLASS_HIGH);
+    default:
+        return (CLASS_LOW);
+    }
+}
+
+uint32_t
+PacketQueueFair4::getFlowHash(const Pkt4Ptr& packet) const {
+    const OptionBuffer& data = packet->data_;
+    if (data.size() >= Pkt4::DHCPV4_PKT_HDR_LEN) {
+        size_t hlen = std::min(static_cast<size_t>(data[HLEN_OFFSET]),
+                               Pkt4::MAX_CHADDR_LEN);
+        if (hlen > 0) {
+            return (hashBytes(&data[CHADDR_OFFSET], hlen));
+        }
+        if (readUint32(&data[GIADDR_OFFSET], 4) != 0) {
+            return (hashBytes(&data[GIADDR_OFFSET], 4));
+        }
+    }
+    return (hashAddress(packet->getRemoteAddr()));
+}
+
+PacketQueueFair6::PriorityClass
+PacketQueueFair6::getPriorityClass(const Pkt6Ptr& packet) const {
+    ClientMessage6 msg = findClientMessage6(packet->data_);
+    if (!msg.found_) {
+        return (CLASS_LOW);
+    }
+    switch (packet->data_[msg.offset_]) {
+    case DHCPV6_REQUEST:
+    case DHCPV6_CONFIRM:
+    case DHCPV6_RENEW:
+    case DHCPV6_REBIND:
+    case DHCPV6_RELEASE:
+    case DHCPV6_DECLINE:
+    case DHCPV6_INFORMATION_REQUEST:
+        return (CLASS_HIGH);
+    default:
+        return (CLASS_LOW);
+    }
+}
+
+uint32_t
+PacketQueueFair6::getFlowHash(const Pkt6Ptr& packet) const {
+    const OptionBuffer& data = packet->data_;
+    ClientMessage6 msg = findClientMessage6(data);
+    if (msg.found_) {
+        size_t len = 0;
+        size_t duid = findOption6(data, msg.offset_ + CLIENT6_HDR_LEN,
+                                  msg.end_, D6O_CLIENTID, len);
+        if ((duid != 0) && (len > 0)) {
+            return (hashBytes(&data[duid], len));
+        }
+    }
+    if (msg.relayed_) {
+        return (hashBytes(&data[msg.relay_ + PEER_ADDR_OFFSET],
+                          isc::asiolink::V6ADDRESS_LEN));
+    }
+    return (hashAddress(packet->getRemoteAddr()));
+}
+
+} // end of isc::dhcp namespace
+} // end of isc namespace
@@ -0,0 +1,482 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PACKET_QUEUE_FAIR_H
+#define PACKET_QUEUE_FAIR_H
+
+#include <dhcp/packet_queue.h>
+
+#include <boost/scoped_ptr.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace isc {
+
+namespace dhcp {
+
+/// @brief Provides a packet queue sharing its capacity fairly between
+/// the clients and favoring the packets of the clients holding leases.
+///
+/// The packets are sorted in two priority classes: the high priority
+/// class holds the packets of the clients which have or are about to get
+/// a lease, e.g. DHCPREQUEST or RENEW, the low priority class holds the
+/// other packets, e.g. DHCPDISCOVER or SOLICIT. In each class the packets
+/// are hashed by their client identification into a fixed number of
+/// sub-queues, so the packets of a client always go to the same
+/// sub-queue.
+///
+/// The packets of the high priority class are always dequeued first.
+/// In a class the sub-queues are served with deficit round-robin: each
+/// sub-queue holding packets receives in turn a quantum of bytes and
+/// the packets are dequeued while their size fits in the accumulated
+/// deficit, so a client flooding the server with packets does not get
+/// more than its share of the processing.
+///
+/// When the queue is full the oldest packet of the longest sub-queue of
+/// the lowest non-empty priority class is dropped to make room for the
+/// new packet, unless the new packet has a lower priority than all the
+/// queued packets, in which case the new packet is dropped. The number
+/// of dropped packets is counted per priority class.
+///
+/// Bear in mind that the packets have NOT been unpacked when they are
+/// queued: the derivations extract the message type and the client
+/// identification from the raw packet data.
+///
+/// @tparam PacketTypePtr Type of packet the queue contains.
+/// This expected to be either isc::dhcp::Pkt4Ptr or isc::dhcp::Pkt6Ptr
+template<typename PacketTypePtr>
+class PacketQueueFair : public PacketQueue<PacketTypePtr> {
+public:
+    /// @brief Minimum queue capacity permitted.
+    static const size_t MIN_FAIR_CAPACITY = 5;
+
+    /// @brief Default number of sub-queues per priority class.
+    static const size_t DEFAULT_SUB_QUEUES = 64;
+
+    /// @brief Default quantum in bytes given to a sub-queue at each turn.
+    static const size_t DEFAULT_QUANTUM = 1500;
+
+    /// @brief Priority classes, from the highest to the lowest.
+    enum PriorityClass {
+        CLASS_HIGH,   ///< packets of the clients holding leases
+        CLASS_LOW,    ///< other packets
+        CLASS_COUNT   ///< number of priority classes
+    };
+
+    /// @brief Constructor
+    ///
+    /// @param queue_type logical name of the queue implementation
+    /// @param capacity maximum number of packets the queue can hold
+    /// @param sub_queues number of sub-queues per priority class
+    /// @param quantum number of bytes a sub-queue may dequeue at each turn
+    ///
+    /// @throw BadValue if a parameter is invalid.
+    PacketQueueFair(const std::string& queue_type, size_t capacity,
+                    size_t sub_queues = DEFAULT_SUB_QUEUES,
+                    size_t quantum = DEFAULT_QUANTUM)
+        : PacketQueue<PacketTypePtr>(queue_type), capacity_(0), size_(0),
+          quantum_(quantum), mutex_(new std::mutex) {
+        setCapacity(capacity);
+        if (sub_queues == 0) {
+            isc_throw(BadValue, "The number of sub-queues must be greater than 0");
+        }
+        if (quantum == 0) {
+            isc_throw(BadValue, "The quantum must be greater than 0");
+        }
+        for (int cls = 0; cls < CLASS_COUNT; ++cls) {
+            classes_[cls].sub_queues_.resize(sub_queues);
+            classes_[cls].size_ = 0;
+            classes_[cls].drops_ = 0;
+        }
+    }
+
+    /// @brief virtual Destructor
+    virtual ~PacketQueueFair(){};
+
+    /// @brief Returns the priority class of a packet.
+    ///
+    /// @param packet packet not yet unpacked
+    /// @return priority class of the packet
+    virtual PriorityClass getPriorityClass(const PacketTypePtr& packet) const = 0;
+
+    /// @brief Returns the hash of the identification of the client which
+    /// sent a packet.
+    ///
+    /// @param packet packet not yet unpacked
+    /// @return hash of the client identification
+    virtual uint32_t getFlowHash(const PacketTypePtr& packet) const = 0;
+
+    /// @brief Adds a packet to the queue
+    ///
+    /// Calls @c shouldDropPacket to determine if the packet should be queued
+    /// or dropped. If it should be queued it is added to the end of the
+    /// sub-queue of its client in its priority class, dropping a packet
+    /// when the queue is full.
+    ///
+    /// @param packet packet to enqueue
+    /// @param source socket the packet came from
+    virtual void enqueuePacket(PacketTypePtr packet, const SocketInfo& source) {
+        if (shouldDropPacket(packet, source)) {
+            return;
+        }
+
+        PriorityClass cls = getPriorityClass(packet);
+        uint32_t hash = getFlowHash(packet);
+
+        std::lock_guard<std::mutex> lock(*mutex_);
+        if ((size_ >= capacity_) && !dropPacket(cls)) {
+            ++classes_[cls].drops_;
+            return;
+        }
+
+        PriorityQueue& pq = classes_[cls];
+        size_t index = hash % pq.sub_queues_.size();
+        SubQueue& sub = pq.sub_queues_[index];
+        if (sub.packets_.empty()) {
+            // The sub-queue gets its quantum when it becomes active.
+            sub.deficit_ = quantum_;
+            pq.active_.push_back(index);
+        }
+        sub.packets_.push_back(packet);
+        ++pq.size_;
+        ++size_;
+    }
+
+    /// @brief Dequeues the next packet from the queue
+    ///
+    /// Takes the packets of the high priority class first and serves the
+    /// sub-queues of the class with deficit round-robin.
+    ///
+    /// @return A pointer to dequeued packet, or an empty pointer
+    /// if the queue is empty.
+    virtual PacketTypePtr dequeuePacket() {
+        std::lock_guard<std::mutex> lock(*mutex_);
+        for (int cls = 0; cls < CLASS_COUNT; ++cls) {
+            PriorityQueue& pq = classes_[cls];
+            while (!pq.active_.empty()) {
+                size_t index = pq.active_.front();
+                SubQueue& sub = pq.sub_queues_[index];
+                size_t cost = getCost(sub.packets_.front());
+                if (sub.deficit_ < cost) {
+                    // End of the turn of the sub-queue: move it to the
+                    // back with a new quantum.
+                    sub.deficit_ += quantum_;
+                    pq.active_.pop_front();
+                    pq.active_.push_back(index);
+                    continue;
+                }
+                sub.deficit_ -= cost;
+                PacketTypePtr packet = sub.packets_.front();
+                sub.packets_.pop_front();
+                if (sub.packets_.empty()) {
+                    sub.deficit_ = 0;
+                    pq.active_.pop_front();
+                }
+                --pq.size_;
+                --size_;
+                return (packet);
+            }
+        }
+        return (PacketTypePtr());
+    }
+
+    /// @brief Determines if a packet should be discarded.
+    ///
+    /// This function is called in @c enqueuePacket for each packet
+    /// before it is classified. Derivations are expected to provide
+    /// implementations based on their own requirements. The default
+    /// implementation simply returns false (i.e. keep the packet).
+    ///
+    /// @return true if the packet should be dropped, false if it should be
+    /// kept.
+    virtual bool shouldDropPacket(PacketTypePtr /* packet */,
+                                  const SocketInfo& /* source */) {
+        return (false);
+    }
+
+    /// @brief Returns True if the queue is empty.
+    virtual bool empty() const {
+        std::lock_guard<std::mutex> lock(*mutex_);
+        return (size_ == 0);
+    }
+
+    /// @brief Returns the maximum number of packets allowed in the queue.
+    virtual size_t getCapacity() const {
+        std::lock_guard<std::mutex> lock(*mutex_);
+        return (capacity_);
+    }
+
+    /// @brief Sets the maximum number of packets allowed in the queue.
+    ///
+    /// The packets already queued are kept, the queue drops packets
+    /// until it is back under its capacity.
+    ///
+    /// @throw BadValue if capacity is too low.
+    virtual void setCapacity(size_t capacity) {
+        if (capacity < MIN_FAIR_CAPACITY) {
+            isc_throw(BadValue, "Queue capacity of " << capacity
+                      << " is invalid.  It must be at least "
+                      << MIN_FAIR_CAPACITY);
+        }
+
+        std::lock_guard<std::mutex> lock(*mutex_);
+        capacity_ = capacity;
+    }
+
+    /// @brief Returns the current number of packets in the queue.
+    virtual size_t getSize() const {
+        std::lock_guard<std::mutex> lock(*mutex_);
+        return (size_);
+    }
+
+    /// @brief Returns the number of sub-queues per priority class.
+    size_t getSubQueues() const {
+        return (classes_[0].sub_queues_.size());
+    }
+
+    /// @brief Returns the quantum in bytes.
+    size_t getQuantum() const {
+        return (quantum_);
+    }
+
+    /// @brief Returns the number of packets of a priority class dropped
+    /// because the queue was full.
+    ///
+    /// @param cls priority class
+    uint64_t getDrops(PriorityClass cls) const {
+        std::lock_guard<std::mutex> lock(*mutex_);
+        return (classes_[cls].drops_);
+    }
+
+    /// @brief Discards all packets currently in the queue.
+    ///
+    /// The drop counters are kept.
+    virtual void clear() {
+        std::lock_guard<std::mutex> lock(*mutex_);
+        for (int cls = 0; cls < CLASS_COUNT; ++cls) {
+            PriorityQueue& pq = classes_[cls];
+            for (auto& sub : pq.sub_queues_) {
+                sub.packets_.clear();
+                sub.deficit_ = 0;
+            }
+            pq.active_.clear();
+            pq.size_ = 0;
+        }
+        size_ = 0;
+    }
+
+    /// @brief Fetches pertinent information
+    ///
+    /// In addition to the capacity and the size, returns the size and
+    /// the number of dropped packets of each priority class.
+    virtual data::ElementPtr getInfo() const {
+        data::ElementPtr info = PacketQueue<PacketTypePtr>::getInfo();
+        info->set("capacity", data::Element::create(static_cast<int64_t>(getCapacity())));
+        info->set("sub-queues", data::Element::create(static_cast<int64_t>(getSubQueues())));
+        info->set("quantum", data::Element::create(static_cast<int64_t>(getQuantum())));
+        std::lock_guard<std::mutex> lock(*mutex_);
+        info->set("size", data::Element::create(static_cast<int64_t>(size_)));
+        data::ElementPtr classes = data::Element::createMap();
+        for (int cls = 0; cls < CLASS_COUNT; ++cls) {
+            data::ElementPtr class_info = data::Element::createMap();
+            class_info->set("size", data::Element::create(static_cast<int64_t>(classes_[cls].size_)));
+            class_info->set("drops", data::Element::create(static_cast<int64_t>(classes_[cls].drops_)));
+            classes->set(cls == CLASS_HIGH ? "high" : "low", class_info);
+        }
+        info->set("classes", classes);
+        return (info);
+    }
+
+private:
+
+    /// @brief Sub-queue holding the packets of some clients.
+    struct SubQueue {
+        /// @brief Constructor.
+        SubQueue() : packets_(), deficit_(0) {
+        }
+
+        /// @brief Packets in arrival order.
+        std::deque<PacketTypePtr> packets_;
+
+        /// @brief Number of bytes the sub-queue may still dequeue.
+        size_t deficit_;
+    };
+
+    /// @brief Sub-queues of a priority class.
+    struct PriorityQueue {
+        /// @brief Sub-queues indexed by the flow hash.
+        std::vector<SubQueue> sub_queues_;
+
+        /// @brief Indexes of the sub-queues holding packets in round-robin
+        /// order.
+        std::deque<size_t> active_;
+
+        /// @brief Number of packets in the class.
+        size_t size_;
+
+        /// @brief Number of packets of the class dropped because the queue
+        /// was full.
+        uint64_t drops_;
+    };
+
+    /// @brief Returns the cost of a packet for the deficit round-robin.
+    ///
+    /// @param packet packet
+    /// @return size of the packet data, at least 1
+    static size_t getCost(const PacketTypePtr& packet) {
+        return (std::max(packet->data_.size(), static_cast<size_t>(1)));
+    }
+
+    /// @brief Makes room for a new packet in the full queue.
+    ///
+    /// Drops the oldest packet of the longest sub-queue in the lowest
+    /// non-empty priority class, unless this class has a higher priority
+    /// than the class of the new packet. Must be called with the mutex
+    /// locked.
+    ///
+    /// @param cls priority class of the new packet
+    /// @return true if a packet was dropped, false if the new packet must
+    /// be dropped instead.
+    bool dropPacket(PriorityClass cls) {
+        for (int victim = CLASS_COUNT - 1; victim >= cls; --victim) {
+            PriorityQueue& pq = classes_[victim];
+            if (pq.active_.empty()) {
+                continue;
+            }
+            auto longest = pq.active_.begin();
+            for (auto it = pq.active_.begin(); it != pq.active_.end(); ++it) {
+                if (pq.sub_queues_[*it].packets_.size() >
+                    pq.sub_queues_[*longest].packets_.size()) {
+                    longest = it;
+                }
+            }
+            SubQueue& sub = pq.sub_queues_[*longest];
+            sub.packets_.pop_front();
+            if (sub.packets_.empty()) {
+                sub.deficit_ = 0;
+                pq.active_.erase(longest);
+            }
+            --pq.size_;
+            ++pq.drops_;
+            --size_;
+            // The queue may still be over its capacity after a decrease.
+            if (size_ >= capacity_) {
+                return (dropPacket(cls));
+            }
+            return (true);
+        }
+        return (false);
+    }
+
+    /// @brief Maximum number of packets in the queue.
+    size_t capacity_;
+
+    /// @brief Number of packets in the queue.
+    size_t size_;
+
+    /// @brief Number of bytes given to a sub-queue at each turn.
+    size_t quantum_;
+
+    /// @brief Priority classes.
+    PriorityQueue classes_[CLASS_COUNT];
+
+    /// @brief Mutex for protecting queue accesses.
+    boost::scoped_ptr<std::mutex> mutex_;
+};
+
+template<typename PacketTypePtr>
+const size_t PacketQueueFair<PacketTypePtr>::MIN_FAIR_CAPACITY;
+
+template<typename PacketTypePtr>
+const size_t PacketQueueFair<PacketTypePtr>::DEFAULT_SUB_QUEUES;
+
+template<typename PacketTypePtr>
+const size_t PacketQueueFair<PacketTypePtr>::DEFAULT_QUANTUM;
+
+/// @brief DHCPv4 fair packet queue implementation
+///
+/// The DHCPREQUEST, DHCPDECLINE, DHCPRELEASE and DHCPINFORM messages are
+/// in the high priority class, the other messages, e.g. DHCPDISCOVER or
+/// BOOTP requests, are in the low priority class. The clients are
+/// identified by their hardware address, or by the relay agent or the
+/// source address when the hardware address is empty.
+class PacketQueueFair4 : public PacketQueueFair<Pkt4Ptr> {
+public:
+    /// @brief Constructor
+    ///
+    /// @param queue_type logical name of the queue implementation
+    /// @param capacity maximum number of packets the queue can hold
+    /// @param sub_queues number of sub-queues per priority class
+    /// @param quantum number of bytes a sub-queue may dequeue at each turn
+    PacketQueueFair4(const std::string& queue_type, size_t capacity,
+                     size_t sub_queues = DEFAULT_SUB_QUEUES,
+                     size_t quantum = DEFAULT_QUANTUM)
+        : PacketQueueFair(queue_type, capacity, sub_queues, quantum) {
+    };
+
+    /// @brief virtual Destructor
+    virtual ~PacketQueueFair4(){}
+
+    /// @brief Returns the priority class of a DHCPv4 packet.
+    ///
+    /// @param packet packet not yet unpacked
+    /// @return priority class of the packet
+    virtual PriorityClass getPriorityClass(const Pkt4Ptr& packet) const;
+
+    /// @brief Returns the hash of the client identification of a DHCPv4
+    /// packet.
+    ///
+    /// @param packet packet not yet unpacked
+    /// @return hash of the client identification
+    virtual uint32_t getFlowHash(const Pkt4Ptr& packet) const;
+};
+
+/// @brief DHCPv6 fair packet queue implementation
+///
+/// The REQUEST, CONFIRM, RENEW, REBIND, RELEASE, DECLINE and
+/// INFORMATION-REQUEST messages are in the high priority class, the other
+/// messages, e.g. SOLICIT, are in the low priority class. The relayed
+/// messages are classified by the message of the client. The clients are
+/// identified by their DUID, or by the relay agent or the source address
+/// when the client identifier option is missing.
+class PacketQueueFair6 : public PacketQueueFair<Pkt6Ptr> {
+public:
+    /// @brief Constructor
+    ///
+    /// @param queue_type logical name of the queue implementation
+    /// @param capacity maximum number of packets the queue can hold
+    /// @param sub_queues number of sub-queues per priority class
+    /// @param quantum number of bytes a sub-queue may dequeue at each turn
+    PacketQueueFair6(const std::string& queue_type, size_t capacity,
+                     size_t sub_queues = DEFAULT_SUB_QUEUES,
+                     size_t quantum = DEFAULT_QUANTUM)
+        : PacketQueueFair(queue_type, capacity, sub_queues, quantum) {
+    };
+
+    /// @brief virtual Destructor
+    virtual ~PacketQueueFair6(){}
+
+    /// @brief Returns the priority class of a DHCPv6 packet.
+    ///
+    /// @param packet packet not yet unpacked
+    /// @return priority class of the packet
+    virtual PriorityClass getPriorityClass(const Pkt6Ptr& packet) const;
+
+    /// @brief Returns the hash of the client identification of a DHCPv6
+    /// packet.
+    ///
+    /// @param packet packet not yet unpacked
+    /// @return hash of the client identification
+    virtual uint32_t getFlowHash(const Pkt6Ptr& packet) const;
+};
+
+}; // namespace isc::dhcp
+}; // namespace isc
+
+#endif // PACKET_QUEUE_FAIR_H
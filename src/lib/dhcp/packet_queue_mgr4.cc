@@ -1,10 +1,11 @@
-// Copyright (C) 2018 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2018-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <config.h>
+#include <dhcp/packet_queue_fair.h>
 #include <dhcp/packet_queue_ring.h>
 #include <dhcp/packet_queue_mgr4.h>
 
@@ -14,6 +15,7 @@ namespace isc {
 namespace dhcp {
 
 const std::string PacketQueueMgr4::DEFAULT_QUEUE_TYPE4 = "kea-ring4";
+const std::string PacketQueueMgr4::FAIR_QUEUE_TYPE4 = "kea-fair4";
 
 PacketQueueMgr4::PacketQueueMgr4() {
     // Register default queue factory
@@ -30,6 +32,32 @@ PacketQueueMgr4::PacketQueueMgr4() {
             PacketQueue4Ptr queue(new PacketQueueRing4(DEFAULT_QUEUE_TYPE4, capacity));
             return (queue);
         });
+
+    // Register fair queue factory
+    registerPacketQueueFactory(FAIR_QUEUE_TYPE4, [](data::ConstElementPtr parameters)
+                                          -> PacketQueue4Ptr {
+            size_t capacity;
+            size_t sub_queues = PacketQueueFair4::DEFAULT_SUB_QUEUES;
+            size_t quantum = PacketQueueFair4::DEFAULT_QUANTUM;
+            try {
+                capacity = data::SimpleParser::getInteger(parameters, "capacity");
+                if (parameters->contains("sub-queues")) {
+                    sub_queues = data::SimpleParser::getInteger(parameters, "sub-queues",
+                                                                1, 65536);
+                }
+                if (parameters->contains("quantum")) {
+                    quantum = data::SimpleParser::getInteger(parameters, "quantum",
+                                                             1, 65536);
+                }
+            } catch (const std::exception& ex) {
+                isc_throw(InvalidQueueParameter, FAIR_QUEUE_TYPE4 << " factory:"
+                          " parameters are missing/invalid: " << ex.what());
+            }
+
+            PacketQueue4Ptr queue(new PacketQueueFair4(FAIR_QUEUE_TYPE4, capacity,
+                                                       sub_queues, quantum));
+            return (queue);
+        });
 }
 
 } // end of isc::dhcp namespace
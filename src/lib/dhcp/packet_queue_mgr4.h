@@ -1,4 +1,4 @@
-// Copyright (C) 2018 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2018-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -25,7 +25,10 @@ public:
     /// @brief Logical name of the pre-registered, default queue implementation
     static const std::string DEFAULT_QUEUE_TYPE4;
 
-    /// It registers a default factory for DHCPv4 queues. 
+    /// @brief Logical name of the pre-registered fair queue implementation
+    static const std::string FAIR_QUEUE_TYPE4;
+
+    /// It registers the default and the fair factories for DHCPv4 queues.
     PacketQueueMgr4();
 
     /// @brief virtual Destructor
@@ -1,4 +1,4 @@
-// Copyright (C) 2018 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2018-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -25,9 +25,12 @@ public:
     /// @brief Logical name of the pre-registered, default queue implementation
     static const std::string DEFAULT_QUEUE_TYPE6;
 
+    /// @brief Logical name of the pre-registered fair queue implementation
+    static const std::string FAIR_QUEUE_TYPE6;
+
     /// @brief constructor.
     ///
-    /// It registers a default factory for DHCPv6 queues.
+    /// It registers the default and the fair factories for DHCPv6 queues.
     PacketQueueMgr6();
 
     /// @brief virtual Destructor
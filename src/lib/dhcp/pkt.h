@@ -271,6 +271,14 @@ public:
     /// @return true if belongs
     bool inClass(const isc::dhcp::ClientClass& client_class);
 
+    /// @brief Checks whether a client belongs to a given interned class.
+    ///
+    /// @param client_class_id identifier of the interned class name
+    /// @return true if belongs
+    bool inClass(const isc::dhcp::ClientClassId client_class_id) {
+        return (classes_.contains(client_class_id));
+    }
+
     /// @brief Adds packet to a specified class.
     ///
     /// A packet can be added to the same class repeatedly. Any additional
@@ -1,4 +1,4 @@
-// Copyright (C) 2013-2017 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2013-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,7 @@
 #define PKT_FILTER_H
 
 #include <dhcp/pkt4.h>
+#include <dhcp/pkt_send_batcher.h>
 #include <asiolink/io_address.h>
 #include <boost/shared_ptr.hpp>
 
@@ -103,8 +104,27 @@ public:
     virtual int send(const Iface& iface, uint16_t sockfd,
                      const Pkt4Ptr& pkt) = 0;
 
+    /// @brief Sets the batcher of the sent packets.
+    ///
+    /// When a batcher is set, the packet filters supporting batching hand
+    /// the messages to the batcher instead of sending them.
+    ///
+    /// @param batcher Pointer to the batcher, null to send the packets
+    /// one by one.
+    void setSendBatcher(const PktSendBatcherPtr& batcher) {
+        send_batcher_ = batcher;
+    }
+
+    /// @brief Returns the batcher of the sent packets.
+    PktSendBatcherPtr getSendBatcher() const {
+        return (send_batcher_);
+    }
+
 protected:
 
+    /// @brief Batcher of the sent packets (may be null).
+    PktSendBatcherPtr send_batcher_;
+
     /// @brief Default implementation to open a fallback socket.
     ///
     /// This method provides a means to open a fallback socket and bind it
@@ -9,6 +9,7 @@
 
 #include <asiolink/io_address.h>
 #include <dhcp/pkt6.h>
+#include <dhcp/pkt_send_batcher.h>
 
 namespace isc {
 namespace dhcp {
@@ -115,6 +116,22 @@ public:
     virtual int send(const Iface& iface, uint16_t sockfd,
                      const Pkt6Ptr& pkt) = 0;
 
+    /// @brief Sets the batcher of the sent packets.
+    ///
+    /// When a batcher is set, the packet filters supporting batching hand
+    /// the messages to the batcher instead of sending them.
+    ///
+    /// @param batcher Pointer to the batcher, null to send the packets
+    /// one by one.
+    void setSendBatcher(const PktSendBatcherPtr& batcher) {
+        send_batcher_ = batcher;
+    }
+
+    /// @brief Returns the batcher of the sent packets.
+    PktSendBatcherPtr getSendBatcher() const {
+        return (send_batcher_);
+    }
+
     /// @brief Joins IPv6 multicast group on a socket.
     ///
     /// This function joins the socket to the specified multicast group.
@@ -129,6 +146,10 @@ public:
     static bool joinMulticast(int sock, const std::string& ifname,
                               const std::string & mcast);
 
+protected:
+
+    /// @brief Batcher of the sent packets (may be null).
+    PktSendBatcherPtr send_batcher_;
 };
 
 
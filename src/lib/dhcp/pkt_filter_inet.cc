@@ -1,4 +1,4 @@
-// Copyright (C) 2013-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2013-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -272,6 +272,12 @@ PktFilterInet::send(const Iface&, uint16_t sockfd, const Pkt4Ptr& pkt) {
 
     pkt->updateTimestamp();
 
+    // The batcher copies the message and sends it later.
+    if (send_batcher_) {
+        send_batcher_->send(sockfd, m);
+        return (0);
+    }
+
     int result = sendmsg(sockfd, &m, 0);
     if (result < 0) {
         isc_throw(SocketWriteError, "pkt4 send failed: sendmsg() returned "
@@ -323,6 +323,22 @@ PktFilterLPF::send(const Iface& iface, uint16_t sockfd, const Pkt4Ptr& pkt) {
     sa.sll_protocol = htons(ETH_P_IP);
     sa.sll_halen = 6;
 
+    // The batcher copies the frame and sends it later.
+    if (send_batcher_) {
+        struct iovec v;
+        memset(&v, 0, sizeof(v));
+        v.iov_base = const_cast<void *>(buf.getData());
+        v.iov_len = buf.getLength();
+        struct msghdr m;
+        memset(&m, 0, sizeof(m));
+        m.msg_name = &sa;
+        m.msg_namelen = sizeof(sockaddr_ll);
+        m.msg_iov = &v;
+        m.msg_iovlen = 1;
+        send_batcher_->send(sockfd, m);
+        return (0);
+    }
+
     int result = sendto(sockfd, buf.getData(), buf.getLength(), 0,
                         reinterpret_cast<const struct sockaddr*>(&sa),
                         sizeof(sockaddr_ll));
@@ -0,0 +1,257 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+#include <dhcp/pkt_send_batcher.h>
+#include <exceptions/exceptions.h>
+
+#include <cerrno>
+#include <cstring>
+
+#include <signal.h>
+
+using namespace std;
+
+namespace isc {
+namespace dhcp {
+
+const size_t PktSendBatcher::DEFAULT_BATCH_SIZE;
+const size_t PktSendBatcher::MAX_BATCH_SIZE;
+const uint32_t PktSendBatcher::DEFAULT_MAX_DELAY;
+const uint32_t PktSendBatcher::MAX_MAX_DELAY;
+
+PktSendBatcher::PktSendBatcher(size_t batch_size, uint32_t max_delay)
+    : batch_size_(batch_size), max_delay_(max_delay), stopping_(false),
+      last_error_("no error"), sent_(0), errors_(0), syscalls_(0) {
+    if ((batch_size < 2) || (batch_size > MAX_BATCH_SIZE)) {
+        isc_throw(BadValue, "send batch size " << batch_size
+                  << " is out of range [2.." << MAX_BATCH_SIZE << "]");
+    }
+    if (max_delay > MAX_MAX_DELAY) {
+        isc_throw(BadValue, "send batch delay " << max_delay
+                  << " is greater than " << MAX_MAX_DELAY);
+    }
+
+    // Protect the flusher thread against signals.
+    sigset_t sset;
+    sigset_t osset;
+    sigemptyset(&sset);
+    sigaddset(&sset, SIGCHLD);
+    sigaddset(&sset, SIGINT);
+    sigaddset(&sset, SIGHUP);
+    sigaddset(&sset, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &sset, &osset);
+    try {
+        thread_ = std::thread(&PktSendBatcher::run, this);
+    } catch (...) {
+        pthread_sigmask(SIG_SETMASK, &osset, 0);
+        throw;
+    }
+    pthread_sigmask(SIG_SETMASK, &osset, 0);
+}
+
+PktSendBatcher::~PktSendBatcher() {
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+    flush();
+}
+
+void
+PktSendBatcher::send(int sockfd, const struct msghdr& msg) {
+    Message message;
+    if (msg.msg_name && (msg.msg_namelen > 0) &&
+        (msg.msg_namelen <= sizeof(message.name_))) {
+        memcpy(&message.name_, msg.msg_name, msg.msg_namelen);
+        message.namelen_ = msg.msg_namelen;
+    } else {
+        message.namelen_ = 0;
+    }
+    size_t len = 0;
+    for (size_t i = 0; i < msg.msg_iovlen; ++i) {
+        len += msg.msg_iov[i].iov_len;
+    }
+    message.data_.reserve(len);
+    for (size_t i = 0; i < msg.msg_iovlen; ++i) {
+        const uint8_t* base = static_cast<const uint8_t*>(msg.msg_iov[i].iov_base);
+        message.data_.insert(message.data_.end(), base,
+                             base + msg.msg_iov[i].iov_len);
+    }
+    if (msg.msg_control && (msg.msg_controllen > 0)) {
+        const uint8_t* control = static_cast<const uint8_t*>(msg.msg_control);
+        message.control_.assign(control, control + msg.msg_controllen);
+    }
+
+    vector<Message> messages;
+    {
+        lock_guard<mutex> lock(mutex_);
+        Batch& batch = batches_[sockfd];
+        if (batch.messages_.empty()) {
+            batch.deadline_ = chrono::steady_clock::now() +
+                chrono::microseconds(max_delay_);
+            // The flusher thread may have to wake up earlier.
+            cv_.notify_one();
+        }
+        batch.messages_.push_back(std::move(message));
+        if (batch.messages_.size() < batch_size_) {
+            return;
+        }
+        messages.swap(batch.messages_);
+    }
+    sendMessages(sockfd, messages);
+}
+
+void
+PktSendBatcher::flush() {
+    map<int, vector<Message> > pending;
+    {
+        lock_guard<mutex> lock(mutex_);
+        for (auto& batch : batches_) {
+            if (!batch.second.messages_.empty()) {
+                pending[batch.first].swap(batch.second.messages_);
+            }
+        }
+    }
+    for (auto& messages : pending) {
+        sendMessages(messages.first, messages.second);
+    }
+}
+
+string
+PktSendBatcher::getLastError() {
+    lock_guard<mutex> lock(mutex_);
+    return (last_error_);
+}
+
+void
+PktSendBatcher::setErrorHandler(const ErrorHandler& handler) {
+    lock_guard<mutex> lock(mutex_);
+    error_handler_ = handler;
+}
+
+void
+PktSendBatcher::reportErrors(uint64_t failures, const string& error) {
+    errors_ += failures;
+    ErrorHandler handler;
+    {
+        lock_guard<mutex> lock(mutex_);
+        last_error_ = error;
+        handler = error_handler_;
+    }
+    if (handler) {
+        handler(failures, error);
+    }
+}
+
+void
+PktSendBatcher::sendMessages(int sockfd, vector<Message>& messages) {
+    size_t count = messages.size();
+    vector<struct iovec> iovs(count);
+#if defined (OS_LINUX)
+    vector<struct mmsghdr> headers(count);
+    memset(&headers[0], 0, count * sizeof(struct mmsghdr));
+#else
+    vector<struct msghdr> headers(count);
+    memset(&headers[0], 0, count * sizeof(struct msghdr));
+#endif
+    for (size_t i = 0; i < count; ++i) {
+        Message& message = messages[i];
+#if defined (OS_LINUX)
+        struct msghdr& m = headers[i].msg_hdr;
+#else
+        struct msghdr& m = headers[i];
+#endif
+        iovs[i].iov_base = message.data_.empty() ? 0 : &message.data_[0];
+        iovs[i].iov_len = message.data_.size();
+        m.msg_iov = &iovs[i];
+        m.msg_iovlen = 1;
+        if (message.namelen_ > 0) {
+            m.msg_name = &message.name_;
+            m.msg_namelen = message.namelen_;
+        }
+        if (!message.control_.empty()) {
+            m.msg_control = &message.control_[0];
+            m.msg_controllen = message.control_.size();
+        }
+    }
+
+    size_t done = 0;
+    uint64_t failures = 0;
+    string error;
+    while (done < count) {
+        ++syscalls_;
+#if defined (OS_LINUX)
+        int result = sendmmsg(sockfd, &headers[done], count - done, 0);
+#else
+        int result = sendmsg(sockfd, &headers[done], 0);
+        if (result >= 0) {
+            result = 1;
+        }
+#endif
+        if (result > 0) {
+            sent_ += result;
+            done += result;
+        } else if ((result < 0) && (errno == EINTR)) {
+            continue;
+        } else {
+            // The first message of the remaining ones failed: skip it.
+            error = (result < 0 ? strerror(errno) : "no message sent");
+            ++failures;
+            ++done;
+        }
+    }
+    if (failures > 0) {
+        reportErrors(failures, error);
+    }
+}
+
+void
+PktSendBatcher::run() {
+    unique_lock<mutex> lock(mutex_);
+    while (!stopping_) {
+        // Find the earliest deadline.
+        bool pending = false;
+        chrono::steady_clock::time_point deadline;
+        for (auto const& batch : batches_) {
+            if (batch.second.messages_.empty()) {
+                continue;
+            }
+            if (!pending || (batch.second.deadline_ < deadline)) {
+                deadline = batch.second.deadline_;
+                pending = true;
+            }
+        }
+        if (!pending) {
+            cv_.wait(lock);
+            continue;
+        }
+        if (chrono::steady_clock::now() < deadline) {
+            cv_.wait_until(lock, deadline);
+            continue;
+        }
+
+        // Take the batches which reached their deadline.
+        map<int, vector<Message> > expired;
+        auto now = chrono::steady_clock::now();
+        for (auto& batch : batches_) {
+            if (!batch.second.messages_.empty() &&
+                (batch.second.deadline_ <= now)) {
+                expired[batch.first].swap(batch.second.messages_);
+            }
+        }
+        lock.unlock();
+        for (auto& messages : expired) {
+            sendMessages(messages.first, messages.second);
+        }
+        lock.lock();
+    }
+}
+
+} // namespace isc::dhcp
+} // namespace isc
@@ -0,0 +1,217 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PKT_SEND_BATCHER_H
+#define PKT_SEND_BATCHER_H
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+
+namespace isc {
+namespace dhcp {
+
+/// @brief Batches the packets sent over the sockets.
+///
+/// The packet filters hand the messages they would pass to @c sendmsg to
+/// the batcher, which copies them in a batch per socket and returns
+/// immediately. A batch is flushed with a single @c sendmmsg call when it
+/// holds "batch size" messages, or by the flusher thread of the batcher
+/// when its oldest message waited for "max delay" microseconds, so the
+/// latency added to a response is bounded. Systems without @c sendmmsg
+/// send the messages of a batch one by one.
+///
+/// As the messages are sent after the filter returned, send errors are
+/// not reported to the caller: they are counted, the last error is kept
+/// by the batcher and they are passed to the error handler, if any.
+///
+/// The batcher is thread safe: the worker threads may send at the same
+/// time.
+class PktSendBatcher : public boost::noncopyable {
+public:
+    /// @brief Default number of messages of a batch.
+    static const size_t DEFAULT_BATCH_SIZE = 32;
+
+    /// @brief Maximum number of messages of a batch.
+    static const size_t MAX_BATCH_SIZE = 1024;
+
+    /// @brief Default maximum delay of a message in microseconds.
+    static const uint32_t DEFAULT_MAX_DELAY = 100;
+
+    /// @brief Maximum value of the maximum delay in microseconds.
+    static const uint32_t MAX_MAX_DELAY = 1000000;
+
+    /// @brief Type of the send error handler.
+    ///
+    /// The handler is called by the thread sending a batch when some of
+    /// its messages could not be sent, with the number of failed messages
+    /// and the last error. It is called without the batcher mutex taken.
+    typedef std::function<void(uint64_t failures,
+                               const std::string& error)> ErrorHandler;
+
+    /// @brief Constructor.
+    ///
+    /// Starts the flusher thread.
+    ///
+    /// @param batch_size Number of messages triggering the flush of a batch.
+    /// @param max_delay Maximum time in microseconds a message waits in a
+    /// batch.
+    /// @throw BadValue if the batch size is not between 2 and
+    /// @c MAX_BATCH_SIZE or the maximum delay is greater than
+    /// @c MAX_MAX_DELAY.
+    PktSendBatcher(size_t batch_size = DEFAULT_BATCH_SIZE,
+                   uint32_t max_delay = DEFAULT_MAX_DELAY);
+
+    /// @brief Destructor.
+    ///
+    /// Stops the flusher thread and sends the pending messages.
+    ~PktSendBatcher();
+
+    /// @brief Adds a message to the batch of a socket.
+    ///
+    /// The name, the data and the control data of the message are copied.
+    /// The batch is sent by the calling thread when it is full.
+    ///
+    /// @param sockfd Socket descriptor.
+    /// @param msg Message as it would be passed to @c sendmsg.
+    void send(int sockfd, const struct msghdr& msg);
+
+    /// @brief Sends the pending messages of all sockets.
+    ///
+    /// Must be called before closing the sockets.
+    void flush();
+
+    /// @brief Returns the number of messages of a batch.
+    size_t getBatchSize() const {
+        return (batch_size_);
+    }
+
+    /// @brief Returns the maximum delay of a message in microseconds.
+    uint32_t getMaxDelay() const {
+        return (max_delay_);
+    }
+
+    /// @brief Returns the number of messages sent.
+    uint64_t getSentCount() const {
+        return (sent_);
+    }
+
+    /// @brief Returns the number of messages which could not be sent.
+    uint64_t getErrorCount() const {
+        return (errors_);
+    }
+
+    /// @brief Returns the number of system calls used to send the messages.
+    uint64_t getSyscallCount() const {
+        return (syscalls_);
+    }
+
+    /// @brief Returns the last send error.
+    std::string getLastError();
+
+    /// @brief Sets the send error handler.
+    ///
+    /// @param handler Handler called when messages could not be sent
+    /// (an empty handler removes the current one).
+    void setErrorHandler(const ErrorHandler& handler);
+
+private:
+    /// @brief Copy of a message.
+    struct Message {
+        /// @brief Destination address.
+        struct sockaddr_storage name_;
+
+        /// @brief Length of the destination address (0 if not set).
+        socklen_t namelen_;
+
+        /// @brief Data.
+        std::vector<uint8_t> data_;
+
+        /// @brief Control data.
+        std::vector<uint8_t> control_;
+    };
+
+    /// @brief Pending messages of a socket.
+    struct Batch {
+        /// @brief Messages.
+        std::vector<Message> messages_;
+
+        /// @brief Time at which the batch must be sent.
+        std::chrono::steady_clock::time_point deadline_;
+    };
+
+    /// @brief Sends messages over a socket.
+    ///
+    /// Called without the mutex taken.
+    ///
+    /// @param sockfd Socket descriptor.
+    /// @param messages Messages to send.
+    void sendMessages(int sockfd, std::vector<Message>& messages);
+
+    /// @brief Records send errors and calls the error handler.
+    ///
+    /// @param failures Number of messages which could not be sent.
+    /// @param error Last error text.
+    void reportErrors(uint64_t failures, const std::string& error);
+
+    /// @brief Flusher thread function.
+    void run();
+
+    /// @brief Number of messages of a batch.
+    size_t batch_size_;
+
+    /// @brief Maximum delay of a message in microseconds.
+    uint32_t max_delay_;
+
+    /// @brief Protects the members below.
+    std::mutex mutex_;
+
+    /// @brief Wakes up the flusher thread.
+    std::condition_variable cv_;
+
+    /// @brief Pending messages per socket.
+    std::map<int, Batch> batches_;
+
+    /// @brief Flag set to stop the flusher thread.
+    bool stopping_;
+
+    /// @brief Last send error.
+    std::string last_error_;
+
+    /// @brief Send error handler.
+    ErrorHandler error_handler_;
+
+    /// @brief Number of messages sent.
+    std::atomic<uint64_t> sent_;
+
+    /// @brief Number of messages which could not be sent.
+    std::atomic<uint64_t> errors_;
+
+    /// @brief Number of system calls.
+    std::atomic<uint64_t> syscalls_;
+
+    /// @brief Flusher thread.
+    std::thread thread_;
+};
+
+/// @brief Pointer to a packet send batcher.
+typedef boost::shared_ptr<PktSendBatcher> PktSendBatcherPtr;
+
+} // namespace isc::dhcp
+} // namespace isc
+
+#endif // PKT_SEND_BATCHER_H
@@ -1,4 +1,4 @@
-// Copyright (C) 2011-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2011-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,11 @@
 #include <dhcp/classify.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 using namespace isc::dhcp;
 
 // Trivial test for now as ClientClass is a std::string.
@@ -149,3 +154,158 @@ TEST(ClassifyTest, Erase) {
     EXPECT_FALSE(classes.contains("alpha"));
     EXPECT_FALSE(classes.contains("beta"));
 }
+
+// Check that the registry interns class names.
+TEST(ClassifyTest, Registry) {
+    ClientClassRegistry& registry = ClientClassRegistry::instance();
+    size_t size = registry.size();
+
+    // The name is not yet interned: find returns the next identifier.
+    ClientClassId id = 0;
+    EXPECT_FALSE(registry.find("registry-alpha", id));
+    EXPECT_EQ(size, id);
+
+    // Intern it.
+    ClientClassId alpha = registry.intern("registry-alpha");
+    EXPECT_EQ(size, alpha);
+    EXPECT_EQ(size + 1, registry.size());
+    EXPECT_TRUE(registry.find("registry-alpha", id));
+    EXPECT_EQ(alpha, id);
+    EXPECT_EQ("registry-alpha", registry.getName(alpha));
+
+    // Interning again returns the same identifier.
+    EXPECT_EQ(alpha, registry.intern("registry-alpha"));
+    EXPECT_EQ(size + 1, registry.size());
+
+    // Another name gets another identifier.
+    ClientClassId beta = registry.intern("registry-beta");
+    EXPECT_NE(alpha, beta);
+    EXPECT_EQ("registry-beta", registry.getName(beta));
+
+    // Unknown identifiers have no name.
+    EXPECT_TRUE(registry.getName(registry.size()).empty());
+}
+
+// Check that the names interned before and after a commit are found.
+TEST(ClassifyTest, RegistryCommit) {
+    ClientClassRegistry& registry = ClientClassRegistry::instance();
+    registry.commit();
+    size_t size = registry.size();
+
+    // The name is found before it is published.
+    ClientClassId alpha = registry.intern("commit-alpha");
+    ClientClassId id = 0;
+    EXPECT_TRUE(registry.find("commit-alpha", id));
+    EXPECT_EQ(alpha, id);
+    EXPECT_EQ("commit-alpha", registry.getName(alpha));
+    EXPECT_EQ(size + 1, registry.size());
+
+    // And after.
+    registry.commit();
+    EXPECT_TRUE(registry.find("commit-alpha", id));
+    EXPECT_EQ(alpha, id);
+    EXPECT_EQ("commit-alpha", registry.getName(alpha));
+    EXPECT_EQ(size + 1, registry.size());
+    EXPECT_FALSE(registry.find("commit-beta", id));
+
+    // A name interned after the commit is not yet published.
+    ClientClassId beta = registry.intern("commit-beta");
+    EXPECT_EQ(size + 1, beta);
+    ClientClasses classes;
+    classes.insert("commit-beta");
+    EXPECT_TRUE(classes.contains(beta));
+    registry.commit();
+    EXPECT_TRUE(classes.contains(beta));
+    EXPECT_FALSE(classes.contains(alpha));
+}
+
+// Check that the names can be looked up while others are interned and
+// published.
+TEST(ClassifyTest, RegistryConcurrentLookups) {
+    ClientClassRegistry& registry = ClientClassRegistry::instance();
+    ClientClassId alpha = registry.intern("concurrent-alpha");
+    registry.commit();
+
+    std::atomic<bool> done(false);
+    std::atomic<size_t> failures(0);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; ++i) {
+        threads.push_back(std::thread([&]() {
+            ClientClasses classes;
+            classes.insert("concurrent-alpha");
+            while (!done) {
+                if (!classes.contains(alpha) ||
+                    !classes.contains("concurrent-alpha") ||
+                    classes.contains("concurrent-other")) {
+                    ++failures;
+                }
+            }
+        }));
+    }
+
+    for (int i = 0; i < 100; ++i) {
+        std::ostringstream name;
+        name << "concurrent-" << i;
+        registry.intern(name.str());
+        registry.commit();
+    }
+    done = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(0, failures);
+}
+
+// Check that the membership of interned classes can be checked using
+// their identifiers.
+TEST(ClassifyTest, ContainsId) {
+    ClientClassRegistry& registry = ClientClassRegistry::instance();
+    ClientClassId alpha = registry.intern("contains-alpha");
+    ClientClassId beta = registry.intern("contains-beta");
+
+    ClientClasses classes;
+    EXPECT_FALSE(classes.contains(alpha));
+    EXPECT_FALSE(classes.contains(beta));
+
+    classes.insert("contains-alpha");
+    EXPECT_TRUE(classes.contains(alpha));
+    EXPECT_FALSE(classes.contains(beta));
+    EXPECT_TRUE(classes.contains("contains-alpha"));
+
+    classes.insert("contains-beta");
+    EXPECT_TRUE(classes.contains(alpha));
+    EXPECT_TRUE(classes.contains(beta));
+
+    classes.erase("contains-alpha");
+    EXPECT_FALSE(classes.contains(alpha));
+    EXPECT_TRUE(classes.contains(beta));
+
+    classes.clear();
+    EXPECT_FALSE(classes.contains(alpha));
+    EXPECT_FALSE(classes.contains(beta));
+    EXPECT_TRUE(classes.empty());
+}
+
+// Check that a class inserted before its name was interned is found
+// using the identifier the name got later.
+TEST(ClassifyTest, ContainsIdInternedLater) {
+    ClientClasses classes;
+    classes.insert("later-alpha");
+    EXPECT_TRUE(classes.contains("later-alpha"));
+
+    ClientClassRegistry& registry = ClientClassRegistry::instance();
+    ClientClassId beta = registry.intern("later-beta");
+    ClientClassId alpha = registry.intern("later-alpha");
+    EXPECT_TRUE(classes.contains(alpha));
+    EXPECT_FALSE(classes.contains(beta));
+    EXPECT_TRUE(classes.contains("later-alpha"));
+    EXPECT_FALSE(classes.contains("later-beta"));
+
+    // Classes inserted after the name was interned use the bitset.
+    classes.insert("later-beta");
+    EXPECT_TRUE(classes.contains(beta));
+
+    classes.erase("later-alpha");
+    EXPECT_FALSE(classes.contains(alpha));
+    EXPECT_FALSE(classes.contains("later-alpha"));
+}
@@ -21,10 +21,13 @@
 #include <boost/scoped_ptr.hpp>
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <condition_variable>
 #include <fcntl.h>
 #include <fstream>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 
 #include <arpa/inet.h>
@@ -1566,6 +1569,79 @@ TEST_F(IfaceMgrTest, sendReceive4) {
     sendReceive4Test(queue_control, true);
 }
 
+// Verifies that DHCPv4 packets are received by the interface receivers
+// and handed to the packet receiver callback.
+TEST_F(IfaceMgrTest, ifaceReceivers4) {
+    scoped_ptr<NakedIfaceMgr> ifacemgr(new NakedIfaceMgr());
+
+    // Without callback no receiver is started.
+    ASSERT_NO_THROW(ifacemgr->startIfaceReceivers(AF_INET));
+    EXPECT_FALSE(ifacemgr->areIfaceReceiversRunning());
+
+    // Only AF_INET and AF_INET6 are valid families.
+    EXPECT_THROW(ifacemgr->startIfaceReceivers(AF_UNIX), BadValue);
+
+    IOAddress lo_addr("127.0.0.1");
+    int socket1 = -1;
+    EXPECT_NO_THROW(
+        socket1 = ifacemgr->openSocket(LOOPBACK_NAME, lo_addr,
+                                       DHCP4_SERVER_PORT + 10000);
+    );
+    ASSERT_GE(socket1, 0);
+
+    // The callback records the received packets.
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<Pkt4Ptr> received;
+    ifacemgr->setPacketReceiverCallback4([&](const Pkt4Ptr& pkt) {
+        std::lock_guard<std::mutex> lk(mutex);
+        received.push_back(pkt);
+        cv.notify_all();
+    });
+
+    // A receiver is started for the loopback interface.
+    ASSERT_NO_THROW(ifacemgr->startIfaceReceivers(AF_INET));
+    ASSERT_TRUE(ifacemgr->areIfaceReceiversRunning());
+    EXPECT_THROW(ifacemgr->startIfaceReceivers(AF_INET), InvalidOperation);
+    EXPECT_THROW(ifacemgr->setPacketReceiverCallback4(IfaceMgr::PacketReceiverCallback4()),
+                 InvalidOperation);
+
+    // Send a packet to ourselves.
+    Pkt4Ptr sendPkt(new Pkt4(DHCPDISCOVER, 1234));
+    sendPkt->setLocalAddr(IOAddress("127.0.0.1"));
+    sendPkt->setLocalPort(DHCP4_SERVER_PORT + 10000 + 1);
+    sendPkt->setRemotePort(DHCP4_SERVER_PORT + 10000);
+    sendPkt->setRemoteAddr(IOAddress("127.0.0.1"));
+    sendPkt->setIndex(LOOPBACK_INDEX);
+    sendPkt->setIface(string(LOOPBACK_NAME));
+    ASSERT_NO_THROW(sendPkt->pack());
+    EXPECT_TRUE(ifacemgr->send(sendPkt));
+
+    // The packet is not returned by receive4.
+    Pkt4Ptr rcvPkt;
+    ASSERT_NO_THROW(rcvPkt = ifacemgr->receive4(0, 10000));
+    EXPECT_FALSE(rcvPkt);
+
+    // The packet is handed to the callback.
+    {
+        std::unique_lock<std::mutex> lk(mutex);
+        ASSERT_TRUE(cv.wait_for(lk, std::chrono::seconds(10),
+                                [&]() { return (!received.empty()); }));
+        ASSERT_EQ(1, received.size());
+        rcvPkt = received[0];
+    }
+    ASSERT_NO_THROW(rcvPkt->unpack());
+    EXPECT_EQ(sendPkt->getTransid(), rcvPkt->getTransid());
+    EXPECT_EQ(DHCPDISCOVER, rcvPkt->getType());
+
+    // Closing the sockets stops the receivers.
+    ASSERT_NO_THROW(ifacemgr->closeSockets());
+    EXPECT_FALSE(ifacemgr->areIfaceReceiversRunning());
+
+    // The callback can be cleared once the receivers are stopped.
+    EXPECT_NO_THROW(ifacemgr->setPacketReceiverCallback4(IfaceMgr::PacketReceiverCallback4()));
+}
+
 // Verifies that it is possible to set custom packet filter object
 // to handle sockets opening and send/receive operation.
 TEST_F(IfaceMgrTest, setPacketFilter) {
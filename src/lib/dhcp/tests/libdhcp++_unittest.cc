@@ -36,6 +36,7 @@
 
 #include <iostream>
 #include <sstream>
+#include <thread>
 #include <typeinfo>
 
 #include <arpa/inet.h>
@@ -2314,6 +2315,43 @@ TEST_F(LibDhcpTest, setRuntimeOptionDefs) {
     testRuntimeOptionDefs(5, 100, false);
 }
 
+// This test verifies that the uncommitted runtime option definitions can
+// be restricted to the thread setting them.
+TEST_F(LibDhcpTest, setRuntimeOptionDefsThread) {
+    OptionDefSpaceContainer defs;
+    createRuntimeOptionDefs(5, 100, defs);
+
+    // Set the definitions on another thread restricted to this thread.
+    bool seen = false;
+    std::thread parser([&defs, &seen]() {
+        LibDHCP::setRuntimeOptionDefsThread(std::this_thread::get_id());
+        LibDHCP::setRuntimeOptionDefs(defs);
+        seen = static_cast<bool>(LibDHCP::getRuntimeOptionDef("option-space-0", 99));
+    });
+    parser.join();
+    EXPECT_TRUE(seen);
+
+    // The definitions are not committed so they are not seen here.
+    testRuntimeOptionDefs(5, 100, false);
+
+    // They are seen when the restriction is removed.
+    LibDHCP::setRuntimeOptionDefsThread(std::thread::id());
+    testRuntimeOptionDefs(5, 100, true);
+
+    // Committed definitions are seen by all threads.
+    LibDHCP::setRuntimeOptionDefsThread(std::this_thread::get_id());
+    LibDHCP::commitRuntimeOptionDefs();
+    seen = false;
+    std::thread reader([&seen]() {
+        seen = static_cast<bool>(LibDHCP::getRuntimeOptionDef("option-space-0", 99));
+    });
+    reader.join();
+    EXPECT_TRUE(seen);
+
+    LibDHCP::setRuntimeOptionDefsThread(std::thread::id());
+    LibDHCP::clearRuntimeOptionDefs();
+}
+
 // This test verifies the processing of option 43
 TEST_F(LibDhcpTest, option43) {
     // Check shouldDeferOptionUnpack()
@@ -0,0 +1,274 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <dhcp/dhcp4.h>
+#include <dhcp/dhcp6.h>
+#include <dhcp/option.h>
+#include <dhcp/packet_queue_fair.h>
+#include <dhcp/tests/packet_queue_testutils.h>
+
+#include <boost/shared_ptr.hpp>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace std;
+using namespace isc;
+using namespace isc::asiolink;
+using namespace isc::dhcp;
+using namespace isc::dhcp::test;
+
+namespace {
+
+/// @brief Creates a received DHCPv4 packet, i.e. not yet unpacked.
+///
+/// @param msg_type message type
+/// @param mac last byte of the client hardware address
+/// @param transid transaction id
+/// @return packet holding only its raw data
+Pkt4Ptr
+makeRaw4(uint8_t msg_type, uint8_t mac, uint32_t transid) {
+    Pkt4Ptr pkt(new Pkt4(msg_type, transid));
+    vector<uint8_t> hwaddr = { 0, 1, 2, 3, 4, mac };
+    pkt->setHWAddr(HTYPE_ETHER, hwaddr.size(), hwaddr);
+    pkt->pack();
+    const util::OutputBuffer& buf = pkt->getBuffer();
+    Pkt4Ptr raw(new Pkt4(static_cast<const uint8_t*>(buf.getData()),
+                         buf.getLength()));
+    raw->setRemoteAddr(IOAddress("192.0.2.1"));
+    return (raw);
+}
+
+/// @brief Creates a received DHCPv6 packet, i.e. not yet unpacked.
+///
+/// @param msg_type message type
+/// @param duid last byte of the client DUID
+/// @param transid transaction id
+/// @param relayed true if the packet is sent through a relay
+/// @return packet holding only its raw data
+Pkt6Ptr
+makeRaw6(uint8_t msg_type, uint8_t duid, uint32_t transid, bool relayed = false) {
+    Pkt6Ptr pkt(new Pkt6(msg_type, transid));
+    OptionBuffer client_id = { 0, 3, 0, 1, 0, 1, 2, 3, 4, duid };
+    pkt->addOption(OptionPtr(new Option(Option::V6, D6O_CLIENTID, client_id)));
+    if (relayed) {
+        Pkt6::RelayInfo relay;
+        relay.msg_type_ = DHCPV6_RELAY_FORW;
+        relay.linkaddr_ = IOAddress("2001:db8:1::1");
+        relay.peeraddr_ = IOAddress("fe80::1");
+        pkt->addRelayInfo(relay);
+    }
+    pkt->pack();
+    const util::OutputBuffer& buf = pkt->getBuffer();
+    Pkt6Ptr raw(new Pkt6(static_cast<const uint8_t*>(buf.getData()),
+                         buf.getLength()));
+    raw->setRemoteAddr(IOAddress("fe80::1"));
+    return (raw);
+}
+
+/// @brief Socket used as the source of the packets.
+const SocketInfo SOCKET4(IOAddress("127.0.0.1"), 67, 10);
+
+/// @brief Socket used as the source of the DHCPv6 packets.
+const SocketInfo SOCKET6(IOAddress("::1"), 547, 11);
+
+// Verifies the basics of the DHCPv4 fair queue.
+TEST(PacketQueueFair4, interfaceBasics) {
+    PacketQueue4Ptr q(new PacketQueueFair4("kea-fair4", 100, 8, 500));
+    ASSERT_TRUE(q);
+    EXPECT_TRUE(q->empty());
+    EXPECT_EQ("kea-fair4", q->getQueueType());
+    checkInfo(q, "{ \"capacity\": 100, \"queue-type\": \"kea-fair4\","
+              " \"size\": 0, \"sub-queues\": 8, \"quantum\": 500,"
+              " \"classes\": { \"high\": { \"size\": 0, \"drops\": 0 },"
+              " \"low\": { \"size\": 0, \"drops\": 0 } } }");
+
+    // Dequeuing an empty queue fails safely.
+    Pkt4Ptr pkt;
+    ASSERT_NO_THROW(pkt = q->dequeuePacket());
+    EXPECT_FALSE(pkt);
+
+    // Invalid parameters are rejected.
+    EXPECT_THROW(PacketQueueFair4("kea-fair4", 4), BadValue);
+    EXPECT_THROW(PacketQueueFair4("kea-fair4", 100, 0), BadValue);
+    EXPECT_THROW(PacketQueueFair4("kea-fair4", 100, 8, 0), BadValue);
+}
+
+// Verifies the classification of the DHCPv4 packets.
+TEST(PacketQueueFair4, classification) {
+    PacketQueueFair4 q("kea-fair4", 100);
+
+    EXPECT_EQ(PacketQueueFair4::CLASS_LOW,
+              q.getPriorityClass(makeRaw4(DHCPDISCOVER, 1, 1)));
+    EXPECT_EQ(PacketQueueFair4::CLASS_HIGH,
+              q.getPriorityClass(makeRaw4(DHCPREQUEST, 1, 2)));
+    EXPECT_EQ(PacketQueueFair4::CLASS_HIGH,
+              q.getPriorityClass(makeRaw4(DHCPRELEASE, 1, 3)));
+    EXPECT_EQ(PacketQueueFair4::CLASS_HIGH,
+              q.getPriorityClass(makeRaw4(DHCPINFORM, 1, 4)));
+
+    // A packet without options nor hardware address is in the low
+    // priority class.
+    vector<uint8_t> header(Pkt4::DHCPV4_PKT_HDR_LEN, 0);
+    Pkt4Ptr short_pkt(new Pkt4(&header[0], header.size()));
+    EXPECT_EQ(PacketQueueFair4::CLASS_LOW, q.getPriorityClass(short_pkt));
+    EXPECT_NO_THROW(q.getFlowHash(short_pkt));
+
+    // The packets of a client share the same hash.
+    EXPECT_EQ(q.getFlowHash(makeRaw4(DHCPDISCOVER, 1, 1)),
+              q.getFlowHash(makeRaw4(DHCPREQUEST, 1, 2)));
+    EXPECT_NE(q.getFlowHash(makeRaw4(DHCPDISCOVER, 1, 1)),
+              q.getFlowHash(makeRaw4(DHCPDISCOVER, 2, 1)));
+}
+
+// Verifies that the clients are served in turn.
+TEST(PacketQueueFair4, fairness) {
+    Pkt4Ptr pkt = makeRaw4(DHCPDISCOVER, 1, 0);
+    size_t quantum = pkt->data_.size();
+
+    // Use as many sub-queues as needed to keep the clients apart.
+    PacketQueueFair4 q("kea-fair4", 100, 1024, quantum);
+    ASSERT_NE(q.getFlowHash(makeRaw4(DHCPDISCOVER, 1, 0)) % 1024,
+              q.getFlowHash(makeRaw4(DHCPDISCOVER, 2, 0)) % 1024);
+
+    // Client 1 floods the queue before client 2 sends two packets.
+    for (uint32_t i = 0; i < 10; ++i) {
+        q.enqueuePacket(makeRaw4(DHCPDISCOVER, 1, 100 + i), SOCKET4);
+    }
+    q.enqueuePacket(makeRaw4(DHCPDISCOVER, 2, 200), SOCKET4);
+    q.enqueuePacket(makeRaw4(DHCPDISCOVER, 2, 201), SOCKET4);
+    EXPECT_EQ(12, q.getSize());
+
+    // The packets of client 2 do not wait behind the flood.
+    vector<uint32_t> expected = { 100, 200, 101, 201, 102, 103 };
+    for (auto const& transid : expected) {
+        ASSERT_TRUE(pkt = q.dequeuePacket());
+        pkt->unpack();
+        EXPECT_EQ(transid, pkt->getTransid());
+    }
+    EXPECT_EQ(6, q.getSize());
+}
+
+// Verifies that the high priority packets are dequeued first.
+TEST(PacketQueueFair4, priority) {
+    PacketQueueFair4 q("kea-fair4", 100);
+    for (uint32_t i = 0; i < 3; ++i) {
+        q.enqueuePacket(makeRaw4(DHCPDISCOVER, i, 100 + i), SOCKET4);
+    }
+    q.enqueuePacket(makeRaw4(DHCPREQUEST, 10, 200), SOCKET4);
+
+    Pkt4Ptr pkt;
+    ASSERT_TRUE(pkt = q.dequeuePacket());
+    pkt->unpack();
+    EXPECT_EQ(DHCPREQUEST, pkt->getType());
+    for (uint32_t i = 0; i < 3; ++i) {
+        ASSERT_TRUE(pkt = q.dequeuePacket());
+        pkt->unpack();
+        EXPECT_EQ(DHCPDISCOVER, pkt->getType());
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+// Verifies the packets dropped when the queue is full.
+TEST(PacketQueueFair4, drops) {
+    PacketQueue4Ptr q(new PacketQueueFair4("kea-fair4", 5, 1024));
+
+    // Client 1 fills the queue.
+    for (uint32_t i = 0; i < 5; ++i) {
+        q->enqueuePacket(makeRaw4(DHCPDISCOVER, 1, 100 + i), SOCKET4);
+    }
+
+    // A DHCPDISCOVER of client 2 replaces the oldest packet of client 1.
+    q->enqueuePacket(makeRaw4(DHCPDISCOVER, 2, 200), SOCKET4);
+    checkInfo(q, "{ \"capacity\": 5, \"queue-type\": \"kea-fair4\","
+              " \"size\": 5, \"sub-queues\": 1024, \"quantum\": 1500,"
+              " \"classes\": { \"high\": { \"size\": 0, \"drops\": 0 },"
+              " \"low\": { \"size\": 5, \"drops\": 1 } } }");
+
+    // Requests replace the low priority packets.
+    for (uint32_t i = 0; i < 5; ++i) {
+        q->enqueuePacket(makeRaw4(DHCPREQUEST, 10 + i, 300 + i), SOCKET4);
+    }
+    checkInfo(q, "{ \"capacity\": 5, \"queue-type\": \"kea-fair4\","
+              " \"size\": 5, \"sub-queues\": 1024, \"quantum\": 1500,"
+              " \"classes\": { \"high\": { \"size\": 5, \"drops\": 0 },"
+              " \"low\": { \"size\": 0, \"drops\": 6 } } }");
+
+    // A DHCPDISCOVER is dropped when the queue is full of requests.
+    q->enqueuePacket(makeRaw4(DHCPDISCOVER, 3, 400), SOCKET4);
+    // A request replaces another request.
+    q->enqueuePacket(makeRaw4(DHCPREQUEST, 20, 500), SOCKET4);
+    checkInfo(q, "{ \"capacity\": 5, \"queue-type\": \"kea-fair4\","
+              " \"size\": 5, \"sub-queues\": 1024, \"quantum\": 1500,"
+              " \"classes\": { \"high\": { \"size\": 5, \"drops\": 1 },"
+              " \"low\": { \"size\": 0, \"drops\": 7 } } }");
+
+    // Clearing the queue keeps the drop counters.
+    q->clear();
+    EXPECT_TRUE(q->empty());
+    checkIntStat(q, "size", 0);
+    EXPECT_EQ(7, boost::dynamic_pointer_cast<PacketQueueFair4>(q)->
+              getDrops(PacketQueueFair4::CLASS_LOW));
+}
+
+// Verifies the classification of the DHCPv6 packets.
+TEST(PacketQueueFair6, classification) {
+    PacketQueueFair6 q("kea-fair6", 100);
+
+    EXPECT_EQ(PacketQueueFair6::CLASS_LOW,
+              q.getPriorityClass(makeRaw6(DHCPV6_SOLICIT, 1, 1)));
+    EXPECT_EQ(PacketQueueFair6::CLASS_HIGH,
+              q.getPriorityClass(makeRaw6(DHCPV6_REQUEST, 1, 2)));
+    EXPECT_EQ(PacketQueueFair6::CLASS_HIGH,
+              q.getPriorityClass(makeRaw6(DHCPV6_RENEW, 1, 3)));
+    EXPECT_EQ(PacketQueueFair6::CLASS_HIGH,
+              q.getPriorityClass(makeRaw6(DHCPV6_REBIND, 1, 4)));
+
+    // The relayed packets are classified by the client message.
+    EXPECT_EQ(PacketQueueFair6::CLASS_LOW,
+              q.getPriorityClass(makeRaw6(DHCPV6_SOLICIT, 1, 5, true)));
+    EXPECT_EQ(PacketQueueFair6::CLASS_HIGH,
+              q.getPriorityClass(makeRaw6(DHCPV6_RENEW, 1, 6, true)));
+
+    // A truncated packet is in the low priority class.
+    uint8_t garbage[] = { DHCPV6_RELAY_FORW, 2, 3 };
+    Pkt6Ptr short_pkt(new Pkt6(garbage, sizeof(garbage)));
+    EXPECT_EQ(PacketQueueFair6::CLASS_LOW, q.getPriorityClass(short_pkt));
+    EXPECT_NO_THROW(q.getFlowHash(short_pkt));
+
+    // The packets of a client share the same hash, relayed or not.
+    uint32_t hash = q.getFlowHash(makeRaw6(DHCPV6_SOLICIT, 1, 1));
+    EXPECT_EQ(hash, q.getFlowHash(makeRaw6(DHCPV6_RENEW, 1, 2)));
+    EXPECT_EQ(hash, q.getFlowHash(makeRaw6(DHCPV6_RENEW, 1, 3, true)));
+    EXPECT_NE(hash, q.getFlowHash(makeRaw6(DHCPV6_SOLICIT, 2, 1)));
+}
+
+// Verifies the DHCPv6 queue favors the renewals and serves the clients
+// in turn.
+TEST(PacketQueueFair6, enqueueDequeue) {
+    Pkt6Ptr pkt = makeRaw6(DHCPV6_SOLICIT, 1, 0);
+    PacketQueueFair6 q("kea-fair6", 100, 1024, pkt->data_.size());
+    ASSERT_NE(q.getFlowHash(makeRaw6(DHCPV6_SOLICIT, 1, 0)) % 1024,
+              q.getFlowHash(makeRaw6(DHCPV6_SOLICIT, 2, 0)) % 1024);
+
+    for (uint32_t i = 0; i < 4; ++i) {
+        q.enqueuePacket(makeRaw6(DHCPV6_SOLICIT, 1, 100 + i), SOCKET6);
+    }
+    q.enqueuePacket(makeRaw6(DHCPV6_SOLICIT, 2, 200), SOCKET6);
+    q.enqueuePacket(makeRaw6(DHCPV6_RENEW, 3, 300, true), SOCKET6);
+
+    vector<uint32_t> expected = { 300, 100, 200, 101, 102, 103 };
+    for (auto const& transid : expected) {
+        ASSERT_TRUE(pkt = q.dequeuePacket());
+        pkt->unpack();
+        EXPECT_EQ(transid, pkt->getTransid());
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+} // end of anonymous namespace
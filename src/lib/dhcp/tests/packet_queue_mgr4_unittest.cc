@@ -141,4 +141,30 @@ TEST_F(PacketQueueMgr4Test, customQueueType) {
                       << default_queue_type_ << "\", \"size\": 0 }");
 }
 
+// Verifies that DHCPv4 PQM provides a fair queue factory
+TEST_F(PacketQueueMgr4Test, fairQueue) {
+    // Verify that we can create a fair queue with the default parameters.
+    data::ElementPtr config = makeQueueConfig(PacketQueueMgr4::FAIR_QUEUE_TYPE4, 500);
+    ASSERT_NO_THROW(mgr().createPacketQueue(config));
+    CHECK_QUEUE_INFO (mgr().getPacketQueue(), "{ \"capacity\": 500, \"queue-type\": \""
+                      << PacketQueueMgr4::FAIR_QUEUE_TYPE4 << "\", \"size\": 0,"
+                      << " \"sub-queues\": 64, \"quantum\": 1500, \"classes\": {"
+                      << " \"high\": { \"size\": 0, \"drops\": 0 },"
+                      << " \"low\": { \"size\": 0, \"drops\": 0 } } }");
+
+    // Verify that the optional parameters are taken into account.
+    config->set("sub-queues", data::Element::create(16));
+    config->set("quantum", data::Element::create(600));
+    ASSERT_NO_THROW(mgr().createPacketQueue(config));
+    checkIntStat(mgr().getPacketQueue(), "sub-queues", 16);
+    checkIntStat(mgr().getPacketQueue(), "quantum", 600);
+
+    // Invalid parameters are rejected.
+    config->set("sub-queues", data::Element::create(0));
+    ASSERT_THROW(mgr().createPacketQueue(config), InvalidQueueParameter);
+    config->set("sub-queues", data::Element::create(16));
+    config->remove("capacity");
+    ASSERT_THROW(mgr().createPacketQueue(config), InvalidQueueParameter);
+}
+
 } // end of anonymous namespace
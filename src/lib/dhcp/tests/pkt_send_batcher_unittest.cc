@@ -0,0 +1,222 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+#include <dhcp/pkt_send_batcher.h>
+#include <exceptions/exceptions.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace isc;
+using namespace isc::dhcp;
+
+namespace {
+
+/// @brief Test fixture class for @c PktSendBatcher.
+///
+/// Opens a receiving UDP socket bound to an ephemeral port of the loopback
+/// address and a sending UDP socket.
+class PktSendBatcherTest : public ::testing::Test {
+public:
+    /// @brief Constructor.
+    PktSendBatcherTest() : recv_fd_(-1), send_fd_(-1) {
+        memset(&dest_, 0, sizeof(dest_));
+        dest_.sin_family = AF_INET;
+        dest_.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        recv_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+        send_fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+        socklen_t len = sizeof(dest_);
+        if ((recv_fd_ < 0) || (send_fd_ < 0) ||
+            (bind(recv_fd_, reinterpret_cast<struct sockaddr*>(&dest_), len) < 0) ||
+            (getsockname(recv_fd_, reinterpret_cast<struct sockaddr*>(&dest_), &len) < 0)) {
+            ADD_FAILURE() << "unable to open the test sockets";
+        }
+    }
+
+    /// @brief Destructor.
+    ~PktSendBatcherTest() {
+        if (recv_fd_ >= 0) {
+            close(recv_fd_);
+        }
+        if (send_fd_ >= 0) {
+            close(send_fd_);
+        }
+    }
+
+    /// @brief Hands a message to the batcher.
+    ///
+    /// @param batcher Batcher.
+    /// @param text Content of the message.
+    void send(PktSendBatcher& batcher, const std::string& text) {
+        struct iovec v;
+        v.iov_base = const_cast<char*>(text.c_str());
+        v.iov_len = text.size();
+        struct msghdr m;
+        memset(&m, 0, sizeof(m));
+        m.msg_name = &dest_;
+        m.msg_namelen = sizeof(dest_);
+        m.msg_iov = &v;
+        m.msg_iovlen = 1;
+        batcher.send(send_fd_, m);
+    }
+
+    /// @brief Receives a message.
+    ///
+    /// @param timeout_ms Time to wait for the message in milliseconds.
+    /// @return Content of the message or an empty string.
+    std::string receive(int timeout_ms) {
+        fd_set readfds;
+        FD_ZERO(&readfds);
+        FD_SET(recv_fd_, &readfds);
+        struct timeval timeout;
+        timeout.tv_sec = timeout_ms / 1000;
+        timeout.tv_usec = (timeout_ms % 1000) * 1000;
+        if (select(recv_fd_ + 1, &readfds, 0, 0, &timeout) <= 0) {
+            return ("");
+        }
+        char buf[256];
+        ssize_t len = recv(recv_fd_, buf, sizeof(buf), 0);
+        if (len <= 0) {
+            return ("");
+        }
+        return (std::string(buf, len));
+    }
+
+    /// @brief Receiving socket.
+    int recv_fd_;
+
+    /// @brief Sending socket.
+    int send_fd_;
+
+    /// @brief Address of the receiving socket.
+    struct sockaddr_in dest_;
+};
+
+// Verifies that the constructor checks its parameters.
+TEST_F(PktSendBatcherTest, constructor) {
+    EXPECT_THROW(PktSendBatcher(0, 100), BadValue);
+    EXPECT_THROW(PktSendBatcher(1, 100), BadValue);
+    EXPECT_THROW(PktSendBatcher(PktSendBatcher::MAX_BATCH_SIZE + 1, 100),
+                 BadValue);
+    EXPECT_THROW(PktSendBatcher(8, PktSendBatcher::MAX_MAX_DELAY + 1),
+                 BadValue);
+
+    PktSendBatcher batcher(8, 200);
+    EXPECT_EQ(8, batcher.getBatchSize());
+    EXPECT_EQ(200, batcher.getMaxDelay());
+    EXPECT_EQ(0, batcher.getSentCount());
+    EXPECT_EQ(0, batcher.getErrorCount());
+    EXPECT_EQ(0, batcher.getSyscallCount());
+}
+
+// Verifies that a full batch is sent at once.
+TEST_F(PktSendBatcherTest, fullBatch) {
+    // Use a long delay so only the batch size triggers the send.
+    PktSendBatcher batcher(4, PktSendBatcher::MAX_MAX_DELAY);
+    send(batcher, "one");
+    send(batcher, "two");
+    send(batcher, "three");
+    EXPECT_EQ("", receive(10));
+    EXPECT_EQ(0, batcher.getSentCount());
+
+    send(batcher, "four");
+    EXPECT_EQ("one", receive(1000));
+    EXPECT_EQ("two", receive(1000));
+    EXPECT_EQ("three", receive(1000));
+    EXPECT_EQ("four", receive(1000));
+    EXPECT_EQ(4, batcher.getSentCount());
+    EXPECT_EQ(0, batcher.getErrorCount());
+#if defined (OS_LINUX)
+    EXPECT_EQ(1, batcher.getSyscallCount());
+#endif
+}
+
+// Verifies that a batch is sent when its oldest message reaches the
+// maximum delay.
+TEST_F(PktSendBatcherTest, maxDelay) {
+    PktSendBatcher batcher(64, 1000);
+    send(batcher, "one");
+    send(batcher, "two");
+    EXPECT_EQ("one", receive(5000));
+    EXPECT_EQ("two", receive(5000));
+    EXPECT_EQ(2, batcher.getSentCount());
+}
+
+// Verifies that flush and the destructor send the pending messages.
+TEST_F(PktSendBatcherTest, flush) {
+    {
+        PktSendBatcher batcher(64, PktSendBatcher::MAX_MAX_DELAY);
+        send(batcher, "one");
+        batcher.flush();
+        EXPECT_EQ("one", receive(1000));
+        EXPECT_EQ(1, batcher.getSentCount());
+
+        send(batcher, "two");
+    }
+    EXPECT_EQ("two", receive(1000));
+}
+
+// Verifies that the send errors are counted.
+TEST_F(PktSendBatcherTest, error) {
+    PktSendBatcher batcher(64, PktSendBatcher::MAX_MAX_DELAY);
+    send(batcher, "one");
+    send(batcher, "two");
+
+    // Close the sending socket so the messages can't be sent.
+    close(send_fd_);
+    batcher.flush();
+    send_fd_ = -1;
+    EXPECT_EQ(0, batcher.getSentCount());
+    EXPECT_EQ(2, batcher.getErrorCount());
+    EXPECT_NE("no error", batcher.getLastError());
+}
+
+// Verifies that the send errors are passed to the error handler.
+TEST_F(PktSendBatcherTest, errorHandler) {
+    PktSendBatcher batcher(64, PktSendBatcher::MAX_MAX_DELAY);
+    uint64_t failures = 0;
+    size_t calls = 0;
+    std::string error;
+    batcher.setErrorHandler([&](uint64_t count, const std::string& text) {
+        failures += count;
+        ++calls;
+        error = text;
+    });
+
+    // Successful sends do not call the handler.
+    send(batcher, "one");
+    batcher.flush();
+    EXPECT_EQ("one", receive(1000));
+    EXPECT_EQ(0, calls);
+
+    // The failures of a batch are reported at once.
+    send(batcher, "two");
+    send(batcher, "three");
+    close(send_fd_);
+    batcher.flush();
+    send_fd_ = -1;
+    EXPECT_EQ(1, calls);
+    EXPECT_EQ(2, failures);
+    EXPECT_EQ(batcher.getLastError(), error);
+
+    // The handler can be removed.
+    batcher.setErrorHandler(PktSendBatcher::ErrorHandler());
+    send(batcher, "four");
+    batcher.flush();
+    EXPECT_EQ(1, calls);
+    EXPECT_EQ(3, batcher.getErrorCount());
+}
+
+} // end of anonymous namespace
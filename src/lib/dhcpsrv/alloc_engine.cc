@@ -14,12 +14,14 @@
 #include <dhcpsrv/alloc_engine.h>
 #include <dhcpsrv/alloc_engine_log.h>
 #include <dhcpsrv/cfgmgr.h>
+#include <dhcpsrv/dhcpsrv_exceptions.h>
 #include <dhcpsrv/dhcpsrv_log.h>
 #include <dhcpsrv/host_mgr.h>
 #include <dhcpsrv/host.h>
 #include <dhcpsrv/lease_mgr_factory.h>
 #include <dhcpsrv/ncr_generator.h>
 #include <dhcpsrv/network.h>
+#include <dhcpsrv/packet_profiler.h>
 #include <dhcpsrv/resource_handler.h>
 #include <dhcpsrv/shared_network.h>
 #include <hooks/callout_handle.h>
@@ -36,6 +38,7 @@
 #include <algorithm>
 #include <cstring>
 #include <limits>
+#include <set>
 #include <sstream>
 #include <stdint.h>
 #include <string.h>
@@ -85,6 +88,100 @@ struct AllocEngineHooks {
 // module is called.
 AllocEngineHooks Hooks;
 
+/// @brief Maximum number of reclaimed leases written to the lease database
+/// in one batch.
+const size_t RECLAIM_BATCH_SIZE = 100;
+
+/// @brief Clears the DNS information of a reclaimed lease and sets its
+/// state to expired-reclaimed.
+///
+/// @param lease Reclaimed lease.
+void
+setLeaseReclaimed(Lease& lease) {
+    // Clear FQDN information as we have already sent the
+    // name change request to remove the DNS record.
+    lease.reuseable_valid_lft_ = 0;
+    lease.hostname_.clear();
+    lease.fqdn_fwd_ = false;
+    lease.fqdn_rev_ = false;
+    lease.state_ = Lease::STATE_EXPIRED_RECLAIMED;
+}
+
+/// @brief Logs the failure to reclaim a DHCPv4 lease.
+///
+/// @param lease Lease which could not be reclaimed.
+/// @param reason Reason of the failure.
+void
+logReclamationFailed(const Lease4Ptr& lease, const std::string& reason) {
+    LOG_ERROR(alloc_engine_logger, ALLOC_ENGINE_V4_LEASE_RECLAMATION_FAILED)
+        .arg(lease->addr_.toText())
+        .arg(reason);
+}
+
+/// @brief Logs the failure to reclaim a DHCPv6 lease.
+///
+/// @param lease Lease which could not be reclaimed.
+/// @param reason Reason of the failure.
+void
+logReclamationFailed(const Lease6Ptr& lease, const std::string& reason) {
+    LOG_ERROR(alloc_engine_logger, ALLOC_ENGINE_V6_LEASE_RECLAMATION_FAILED)
+        .arg(lease->addr_.toText())
+        .arg(reason);
+}
+
+/// @brief Returns the type of a DHCPv4 lease.
+///
+/// @return Always @c Lease::TYPE_V4.
+Lease::Type
+getLeaseType(const Lease4Ptr&) {
+    return (Lease::TYPE_V4);
+}
+
+/// @brief Returns the type of a DHCPv6 lease.
+///
+/// @param lease Lease.
+/// @return The type of the lease.
+Lease::Type
+getLeaseType(const Lease6Ptr& lease) {
+    return (lease->type_);
+}
+
+/// @brief Fetches a DHCPv4 lease from the lease database.
+///
+/// @param lease Lease.
+/// @return The lease in the database or null.
+Lease4Ptr
+getCurrentLease(const Lease4Ptr& lease) {
+    return (LeaseMgrFactory::instance().getLease4(lease->addr_));
+}
+
+/// @brief Fetches a DHCPv6 lease from the lease database.
+///
+/// @param lease Lease.
+/// @return The lease in the database or null.
+Lease6Ptr
+getCurrentLease(const Lease6Ptr& lease) {
+    return (LeaseMgrFactory::instance().getLease6(lease->type_, lease->addr_));
+}
+
+/// @brief Updates a DHCPv4 lease in the lease database.
+///
+/// @param lease_mgr Lease manager.
+/// @param lease Lease.
+void
+updateLeaseInDatabase(LeaseMgr& lease_mgr, const Lease4Ptr& lease) {
+    lease_mgr.updateLease4(lease);
+}
+
+/// @brief Updates a DHCPv6 lease in the lease database.
+///
+/// @param lease_mgr Lease manager.
+/// @param lease Lease.
+void
+updateLeaseInDatabase(LeaseMgr& lease_mgr, const Lease6Ptr& lease) {
+    lease_mgr.updateLease6(lease);
+}
+
 }  // namespace
 
 namespace isc {
@@ -315,7 +412,7 @@ AllocEngine::RandomAllocator::pickAddressInternal(const SubnetPtr&,
 AllocEngine::AllocEngine(AllocType engine_type, uint64_t attempts,
                          bool ipv6)
     : attempts_(attempts), incomplete_v4_reclamations_(0),
-      incomplete_v6_reclamations_(0) {
+      incomplete_v6_reclamations_(0), background_reclamation_(false) {
 
     // Choose the basic (normal address) lease type
     Lease::Type basic_type = ipv6 ? Lease::TYPE_NA : Lease::TYPE_V4;
@@ -2291,7 +2388,7 @@ AllocEngine::extendLease6(ClientContext6& ctx, Lease6Ptr lease) {
     // Get the callouts specific for the processed message and execute them.
     int hook_point = ctx.query_->getType() == DHCPV6_RENEW ?
         Hooks.hook_index_lease6_renew_ : Hooks.hook_index_lease6_rebind_;
-    if (HooksManager::calloutsPresent(hook_point)) {
+    if (ctx.callout_handle_ && HooksManager::calloutsPresent(hook_point)) {
         CalloutHandlePtr callout_handle = ctx.callout_handle_;
 
         // Use the RAII wrapper to make sure that the callout handle state is
@@ -2479,6 +2576,9 @@ AllocEngine::reclaimExpiredLeases6(const size_t max_leases, const uint16_t timeo
     // taken by the routine.
     util::Stopwatch stopwatch;
 
+    // The background reclamation must not run at the same time.
+    std::lock_guard<std::mutex> reclaim_lock(reclaim_mutex_);
+
     LeaseMgr& lease_mgr = LeaseMgrFactory::instance();
 
     // This value indicates if we have been able to deal with all expired
@@ -2515,46 +2615,77 @@ AllocEngine::reclaimExpiredLeases6(const size_t max_leases, const uint16_t timeo
         callout_handle = HooksManager::createCalloutHandle();
     }
 
+    const DbReclaimMode reclaim_mode = (remove_lease ? DB_RECLAIM_REMOVE :
+                                        DB_RECLAIM_UPDATE);
     size_t leases_processed = 0;
-    BOOST_FOREACH(Lease6Ptr lease, leases) {
+    bool timed_out = false;
+    auto lease = leases.begin();
+
+    // Reclaim a batch of leases and write them to the lease database
+    // at once.
+    auto reclaim_batch = [&]() {
+        Lease6Collection removed;
+        Lease6Collection updated;
+        while ((lease != leases.end()) &&
+               (removed.size() + updated.size() < RECLAIM_BATCH_SIZE)) {
+            try {
+                switch (prepareLeaseReclamation(*lease, reclaim_mode,
+                                                callout_handle)) {
+                case DB_RECLAIM_REMOVE:
+                    removed.push_back(*lease);
+                    break;
+                case DB_RECLAIM_UPDATE:
+                    updated.push_back(*lease);
+                    break;
+                default:
+                    // The callouts took responsibility for the lease.
+                    updateReclaimedLeaseStats(*lease);
+                    ++leases_processed;
+                }
 
-        try {
-            // Reclaim the lease.
-            if (MultiThreadingMgr::instance().getMode()) {
-                // The reclamation is exclusive of packet processing.
-                WriteLockGuard exclusive(rw_mutex_);
+            } catch (const std::exception& ex) {
+                LOG_ERROR(alloc_engine_logger, ALLOC_ENGINE_V6_LEASE_RECLAMATION_FAILED)
+                    .arg((*lease)->addr_.toText())
+                    .arg(ex.what());
+            }
+            ++lease;
 
-                reclaimExpiredLease(lease, remove_lease, callout_handle);
-                ++leases_processed;
-            } else {
-                reclaimExpiredLease(lease, remove_lease, callout_handle);
-                ++leases_processed;
+            // Check if we have hit the timeout for running reclamation
+            // routine and return if we have. We're checking it here, because
+            // we always want to allow reclaiming at least one lease.
+            if ((timeout > 0) && (stopwatch.getTotalMilliseconds() >= timeout)) {
+                timed_out = true;
+                break;
             }
+        }
+        leases_processed += reclaimLeasesInDatabase(LeaseMgrFactory::instance(),
+                                                    removed, updated);
+    };
 
-        } catch (const std::exception& ex) {
-            LOG_ERROR(alloc_engine_logger, ALLOC_ENGINE_V6_LEASE_RECLAMATION_FAILED)
-                .arg(lease->addr_.toText())
-                .arg(ex.what());
+    while ((lease != leases.end()) && !timed_out) {
+        if (MultiThreadingMgr::instance().getMode()) {
+            // The reclamation is exclusive of packet processing.
+            WriteLockGuard exclusive(rw_mutex_);
+
+            reclaim_batch();
+        } else {
+            reclaim_batch();
         }
+    }
 
-        // Check if we have hit the timeout for running reclamation routine and
-        // return if we have. We're checking it here, because we always want to
-        // allow reclaiming at least one lease.
-        if ((timeout > 0) && (stopwatch.getTotalMilliseconds() >= timeout)) {
-            // Timeout. This will likely mean that we haven't been able to process
-            // all leases we wanted to process. The reclamation pass will be
-            // probably marked as incomplete.
-            if (!incomplete_reclamation) {
-                if (leases_processed < leases.size()) {
-                    incomplete_reclamation = true;
-                }
+    if (timed_out) {
+        // Timeout. This will likely mean that we haven't been able to process
+        // all leases we wanted to process. The reclamation pass will be
+        // probably marked as incomplete.
+        if (!incomplete_reclamation) {
+            if (leases_processed < leases.size()) {
+                incomplete_reclamation = true;
             }
-
-            LOG_DEBUG(alloc_engine_logger, ALLOC_ENGINE_DBG_TRACE,
-                      ALLOC_ENGINE_V6_LEASES_RECLAMATION_TIMEOUT)
-                .arg(timeout);
-            break;
         }
+
+        LOG_DEBUG(alloc_engine_logger, ALLOC_ENGINE_DBG_TRACE,
+                  ALLOC_ENGINE_V6_LEASES_RECLAMATION_TIMEOUT)
+            .arg(timeout);
     }
 
     // Stop measuring the time.
@@ -2625,6 +2756,9 @@ AllocEngine::reclaimExpiredLeases4(const size_t max_leases, const uint16_t timeo
     // taken by the routine.
     util::Stopwatch stopwatch;
 
+    // The background reclamation must not run at the same time.
+    std::lock_guard<std::mutex> reclaim_lock(reclaim_mutex_);
+
     LeaseMgr& lease_mgr = LeaseMgrFactory::instance();
 
     // This value indicates if we have been able to deal with all expired
@@ -2661,46 +2795,77 @@ AllocEngine::reclaimExpiredLeases4(const size_t max_leases, const uint16_t timeo
         callout_handle = HooksManager::createCalloutHandle();
     }
 
+    const DbReclaimMode reclaim_mode = (remove_lease ? DB_RECLAIM_REMOVE :
+                                        DB_RECLAIM_UPDATE);
     size_t leases_processed = 0;
-    BOOST_FOREACH(Lease4Ptr lease, leases) {
+    bool timed_out = false;
+    auto lease = leases.begin();
+
+    // Reclaim a batch of leases and write them to the lease database
+    // at once.
+    auto reclaim_batch = [&]() {
+        Lease4Collection removed;
+        Lease4Collection updated;
+        while ((lease != leases.end()) &&
+               (removed.size() + updated.size() < RECLAIM_BATCH_SIZE)) {
+            try {
+                switch (prepareLeaseReclamation(*lease, reclaim_mode,
+                                                callout_handle)) {
+                case DB_RECLAIM_REMOVE:
+                    removed.push_back(*lease);
+                    break;
+                case DB_RECLAIM_UPDATE:
+                    updated.push_back(*lease);
+                    break;
+                default:
+                    // The callouts took responsibility for the lease.
+                    updateReclaimedLeaseStats(*lease);
+                    ++leases_processed;
+                }
 
-        try {
-            // Reclaim the lease.
-            if (MultiThreadingMgr::instance().getMode()) {
-                // The reclamation is exclusive of packet processing.
-                WriteLockGuard exclusive(rw_mutex_);
+            } catch (const std::exception& ex) {
+                LOG_ERROR(alloc_engine_logger, ALLOC_ENGINE_V4_LEASE_RECLAMATION_FAILED)
+                    .arg((*lease)->addr_.toText())
+                    .arg(ex.what());
+            }
+            ++lease;
 
-                reclaimExpiredLease(lease, remove_lease, callout_handle);
-                ++leases_processed;
-            } else {
-                reclaimExpiredLease(lease, remove_lease, callout_handle);
-                ++leases_processed;
+            // Check if we have hit the timeout for running reclamation
+            // routine and return if we have. We're checking it here, because
+            // we always want to allow reclaiming at least one lease.
+            if ((timeout > 0) && (stopwatch.getTotalMilliseconds() >= timeout)) {
+                timed_out = true;
+                break;
             }
+        }
+        leases_processed += reclaimLeasesInDatabase(LeaseMgrFactory::instance(),
+                                                    removed, updated);
+    };
 
-        } catch (const std::exception& ex) {
-            LOG_ERROR(alloc_engine_logger, ALLOC_ENGINE_V4_LEASE_RECLAMATION_FAILED)
-                .arg(lease->addr_.toText())
-                .arg(ex.what());
+    while ((lease != leases.end()) && !timed_out) {
+        if (MultiThreadingMgr::instance().getMode()) {
+            // The reclamation is exclusive of packet processing.
+            WriteLockGuard exclusive(rw_mutex_);
+
+            reclaim_batch();
+        } else {
+            reclaim_batch();
         }
+    }
 
-        // Check if we have hit the timeout for running reclamation routine and
-        // return if we have. We're checking it here, because we always want to
-        // allow reclaiming at least one lease.
-        if ((timeout > 0) && (stopwatch.getTotalMilliseconds() >= timeout)) {
-            // Timeout. This will likely mean that we haven't been able to process
-            // all leases we wanted to process. The reclamation pass will be
-            // probably marked as incomplete.
-            if (!incomplete_reclamation) {
-                if (leases_processed < leases.size()) {
-                    incomplete_reclamation = true;
-                }
+    if (timed_out) {
+        // Timeout. This will likely mean that we haven't been able to process
+        // all leases we wanted to process. The reclamation pass will be
+        // probably marked as incomplete.
+        if (!incomplete_reclamation) {
+            if (leases_processed < leases.size()) {
+                incomplete_reclamation = true;
             }
-
-            LOG_DEBUG(alloc_engine_logger, ALLOC_ENGINE_DBG_TRACE,
-                      ALLOC_ENGINE_V4_LEASES_RECLAMATION_TIMEOUT)
-                .arg(timeout);
-            break;
         }
+
+        LOG_DEBUG(alloc_engine_logger, ALLOC_ENGINE_DBG_TRACE,
+                  ALLOC_ENGINE_V4_LEASES_RECLAMATION_TIMEOUT)
+            .arg(timeout);
     }
 
     // Stop measuring the time.
@@ -2751,14 +2916,321 @@ AllocEngine::reclaimExpiredLease(const LeasePtrType& lease,
     // renews leases. It may be the case that the lease has already been
     // reclaimed, so there is nothing to do.
     if (!lease->stateExpiredReclaimed()) {
-        reclaimExpiredLease(lease, DB_RECLAIM_LEAVE_UNCHANGED, callout_handle);
+        if (background_reclamation_) {
+            reclaimExpiredLeaseConcurrently(lease, callout_handle);
+        } else {
+            reclaimExpiredLease(lease, DB_RECLAIM_LEAVE_UNCHANGED, callout_handle);
+        }
+    }
+}
+
+/// @brief RAII object locking a lease against its concurrent reclamation.
+class AllocEngine::LeaseClaim : public boost::noncopyable {
+public:
+    /// @brief Constructor.
+    ///
+    /// Waits until the lease can be locked.
+    ///
+    /// @param engine Allocation engine.
+    /// @param type Lease type.
+    /// @param addr Address or prefix of the lease.
+    LeaseClaim(AllocEngine& engine, const Lease::Type type,
+               const IOAddress& addr)
+        : engine_(engine), type_(type), addr_(addr) {
+        engine_.claimLease(type_, addr_);
+    }
+
+    /// @brief Destructor.
+    ///
+    /// Unlocks the lease.
+    ~LeaseClaim() {
+        engine_.releaseLease(type_, addr_);
+    }
+
+private:
+    /// @brief Allocation engine.
+    AllocEngine& engine_;
+
+    /// @brief Lease type.
+    Lease::Type type_;
+
+    /// @brief Address or prefix of the lease.
+    IOAddress addr_;
+};
+
+bool
+AllocEngine::tryClaimLease(const Lease::Type type, const IOAddress& addr) {
+    std::lock_guard<std::mutex> lock(claims_mutex_);
+    return (claims_.insert(std::make_pair(type, addr)).second);
+}
+
+void
+AllocEngine::claimLease(const Lease::Type type, const IOAddress& addr) {
+    std::unique_lock<std::mutex> lock(claims_mutex_);
+    auto claim = std::make_pair(type, addr);
+    claims_cv_.wait(lock, [&]() { return (claims_.count(claim) == 0); });
+    claims_.insert(claim);
+}
+
+void
+AllocEngine::releaseLease(const Lease::Type type, const IOAddress& addr) {
+    {
+        std::lock_guard<std::mutex> lock(claims_mutex_);
+        claims_.erase(std::make_pair(type, addr));
+    }
+    claims_cv_.notify_all();
+}
+
+void
+AllocEngine::reclaimExpiredLeaseConcurrently(const Lease6Ptr& lease,
+                                             const CalloutHandlePtr& callout_handle) {
+    LeaseClaim claim(*this, lease->type_, lease->addr_);
+    LeaseMgr& lease_mgr = LeaseMgrFactory::instance();
+    Lease6Ptr current = lease_mgr.getLease6(lease->type_, lease->addr_);
+    if (!current) {
+        // The background thread reclaimed and removed the lease: add it
+        // back so the caller can update it.
+        lease_mgr.addLease(lease);
+        return;
+    }
+    if (current->stateExpiredReclaimed() || !current->expired()) {
+        // Already reclaimed by the background thread.
+        return;
+    }
+
+    reclaimExpiredLease(lease, DB_RECLAIM_LEAVE_UNCHANGED, callout_handle);
+
+    // Until the caller updates the lease the background thread must see
+    // it as reclaimed.
+    setLeaseReclaimed(*current);
+    lease_mgr.updateLease6(current);
+}
+
+void
+AllocEngine::reclaimExpiredLeaseConcurrently(const Lease4Ptr& lease,
+                                             const CalloutHandlePtr& callout_handle) {
+    LeaseClaim claim(*this, Lease::TYPE_V4, lease->addr_);
+    LeaseMgr& lease_mgr = LeaseMgrFactory::instance();
+    Lease4Ptr current = lease_mgr.getLease4(lease->addr_);
+    if (!current) {
+        // The background thread reclaimed and removed the lease: add it
+        // back so the caller can update it.
+        lease_mgr.addLease(lease);
+        return;
+    }
+    if (current->stateExpiredReclaimed() || !current->expired()) {
+        // Already reclaimed by the background thread.
+        return;
+    }
+
+    reclaimExpiredLease(lease, DB_RECLAIM_LEAVE_UNCHANGED, callout_handle);
+
+    // Until the caller updates the lease the background thread must see
+    // it as reclaimed.
+    setLeaseReclaimed(*current);
+    lease_mgr.updateLease4(current);
+}
+
+template<typename LeaseCollectionType>
+void
+AllocEngine::reclaimLeasesConcurrently(const LeaseCollectionType& leases,
+                                       const DbReclaimMode& reclaim_mode,
+                                       const CalloutHandlePtr& callout_handle,
+                                       ReclaimPass& pass) {
+    typedef typename LeaseCollectionType::value_type LeasePtrType;
+    typedef std::pair<Lease::Type, IOAddress> Claim;
+
+    // Leases locked against the allocation and the reclamation by the
+    // packet processing threads. They are unlocked once written to the
+    // lease database.
+    ResourceHandler resource_handler;
+    std::vector<Claim> claimed;
+
+    // Unlock the leases on exit, including by an exception.
+    struct Claims {
+        ~Claims() {
+            for (auto const& claim : claimed_) {
+                engine_.releaseLease(claim.first, claim.second);
+            }
+        }
+        AllocEngine& engine_;
+        std::vector<Claim>& claimed_;
+    } claims = { *this, claimed };
+
+    auto release = [&](const Claim& claim) {
+        releaseLease(claim.first, claim.second);
+        resource_handler.unLock(claim.first, claim.second);
+    };
+
+    LeaseCollectionType removed;
+    LeaseCollectionType updated;
+    auto flush = [&]() {
+        pass.reclaimed_ += reclaimLeasesInDatabase(LeaseMgrFactory::instance(),
+                                                   removed, updated);
+        removed.clear();
+        updated.clear();
+        for (auto const& claim : claimed) {
+            release(claim);
+        }
+        claimed.clear();
+    };
+
+    for (auto const& lease : leases) {
+        Claim claim(getLeaseType(lease), lease->addr_);
+        if (!resource_handler.tryLock(claim.first, claim.second)) {
+            // A packet processing thread is allocating the lease.
+            ++pass.deferred_;
+            continue;
+        }
+        if (!tryClaimLease(claim.first, claim.second)) {
+            // A packet processing thread is reclaiming the lease.
+            resource_handler.unLock(claim.first, claim.second);
+            ++pass.deferred_;
+            continue;
+        }
+
+        // The lease may have been renewed or reclaimed since it was fetched.
+        LeasePtrType current;
+        try {
+            current = getCurrentLease(lease);
+        } catch (const std::exception& ex) {
+            logReclamationFailed(lease, ex.what());
+            release(claim);
+            continue;
+        }
+        if (!current || current->stateExpiredReclaimed() ||
+            !current->expired()) {
+            release(claim);
+            continue;
+        }
+
+        try {
+            switch (prepareLeaseReclamation(current, reclaim_mode,
+                                            callout_handle)) {
+            case DB_RECLAIM_REMOVE:
+                removed.push_back(current);
+                claimed.push_back(claim);
+                break;
+            case DB_RECLAIM_UPDATE:
+                updated.push_back(current);
+                claimed.push_back(claim);
+                break;
+            default:
+                // The callouts took responsibility for the lease.
+                updateReclaimedLeaseStats(current);
+                ++pass.reclaimed_;
+                release(claim);
+            }
+
+        } catch (const std::exception& ex) {
+            logReclamationFailed(current, ex.what());
+            release(claim);
+        }
+
+        if (removed.size() + updated.size() >= RECLAIM_BATCH_SIZE) {
+            flush();
+        }
+    }
+    flush();
+}
+
+AllocEngine::ReclaimPass
+AllocEngine::reclaimExpiredLeasesConcurrently6(const size_t max_leases,
+                                               const bool remove_lease) {
+    ReclaimPass pass;
+
+    // The timer or command driven reclamation must not run at the same time.
+    std::lock_guard<std::mutex> reclaim_lock(reclaim_mutex_);
+
+    Lease6Collection leases;
+    LeaseMgrFactory::instance().getExpiredLeases6(leases, max_leases);
+    pass.found_ = leases.size();
+    if (leases.empty()) {
+        return (pass);
     }
+    for (auto const& lease : leases) {
+        time_t expire = static_cast<time_t>(lease->getExpirationTime());
+        if ((pass.oldest_expire_ == 0) || (expire < pass.oldest_expire_)) {
+            pass.oldest_expire_ = expire;
+        }
+    }
+
+    CalloutHandlePtr callout_handle;
+    if (HooksManager::calloutsPresent(Hooks.hook_index_lease6_expire_)) {
+        callout_handle = HooksManager::createCalloutHandle();
+    }
+
+    reclaimLeasesConcurrently(leases, remove_lease ? DB_RECLAIM_REMOVE :
+                              DB_RECLAIM_UPDATE, callout_handle, pass);
+
+    LOG_DEBUG(alloc_engine_logger, ALLOC_ENGINE_DBG_TRACE,
+              ALLOC_ENGINE_V6_LEASES_BACKGROUND_RECLAMATION_COMPLETE)
+        .arg(pass.reclaimed_)
+        .arg(pass.deferred_);
+
+    return (pass);
 }
 
+AllocEngine::ReclaimPass
+AllocEngine::reclaimExpiredLeasesConcurrently4(const size_t max_leases,
+                                               const bool remove_lease) {
+    ReclaimPass pass;
+
+    // The timer or command driven reclamation must not run at the same time.
+    std::lock_guard<std::mutex> reclaim_lock(reclaim_mutex_);
+
+    Lease4Collection leases;
+    LeaseMgrFactory::instance().getExpiredLeases4(leases, max_leases);
+    pass.found_ = leases.size();
+    if (leases.empty()) {
+        return (pass);
+    }
+    for (auto const& lease : leases) {
+        time_t expire = static_cast<time_t>(lease->getExpirationTime());
+        if ((pass.oldest_expire_ == 0) || (expire < pass.oldest_expire_)) {
+            pass.oldest_expire_ = expire;
+        }
+    }
+
+    CalloutHandlePtr callout_handle;
+    if (HooksManager::calloutsPresent(Hooks.hook_index_lease4_expire_)) {
+        callout_handle = HooksManager::createCalloutHandle();
+    }
+
+    reclaimLeasesConcurrently(leases, remove_lease ? DB_RECLAIM_REMOVE :
+                              DB_RECLAIM_UPDATE, callout_handle, pass);
+
+    LOG_DEBUG(alloc_engine_logger, ALLOC_ENGINE_DBG_TRACE,
+              ALLOC_ENGINE_V4_LEASES_BACKGROUND_RECLAMATION_COMPLETE)
+        .arg(pass.reclaimed_)
+        .arg(pass.deferred_);
+
+    return (pass);
+}
+
+
 void
 AllocEngine::reclaimExpiredLease(const Lease6Ptr& lease,
                                  const DbReclaimMode& reclaim_mode,
                                  const CalloutHandlePtr& callout_handle) {
+    DbReclaimMode db_mode = prepareLeaseReclamation(lease, reclaim_mode,
+                                                    callout_handle);
+    if (db_mode != DB_RECLAIM_LEAVE_UNCHANGED) {
+        // Reclaim the lease - depending on the configuration, set the
+        // expired-reclaimed state or simply remove it.
+        LeaseMgr& lease_mgr = LeaseMgrFactory::instance();
+        reclaimLeaseInDatabase<Lease6Ptr>(lease, db_mode == DB_RECLAIM_REMOVE,
+                                          std::bind(&LeaseMgr::updateLease6,
+                                                    &lease_mgr, ph::_1));
+    }
+
+    updateReclaimedLeaseStats(lease);
+}
+
+AllocEngine::DbReclaimMode
+AllocEngine::prepareLeaseReclamation(const Lease6Ptr& lease,
+                                     const DbReclaimMode& reclaim_mode,
+                                     const CalloutHandlePtr& callout_handle) {
 
     LOG_DEBUG(alloc_engine_logger, ALLOC_ENGINE_DBG_TRACE,
               ALLOC_ENGINE_V6_LEASE_RECLAIM)
@@ -2815,15 +3287,15 @@ AllocEngine::reclaimExpiredLease(const Lease6Ptr& lease,
         }
 
         if (reclaim_mode != DB_RECLAIM_LEAVE_UNCHANGED) {
-            // Reclaim the lease - depending on the configuration, set the
-            // expired-reclaimed state or simply remove it.
-            LeaseMgr& lease_mgr = LeaseMgrFactory::instance();
-            reclaimLeaseInDatabase<Lease6Ptr>(lease, remove_lease,
-                                              std::bind(&LeaseMgr::updateLease6,
-                                                        &lease_mgr, ph::_1));
+            return (remove_lease ? DB_RECLAIM_REMOVE : DB_RECLAIM_UPDATE);
         }
     }
 
+    return (DB_RECLAIM_LEAVE_UNCHANGED);
+}
+
+void
+AllocEngine::updateReclaimedLeaseStats(const Lease6Ptr& lease) const {
     // Update statistics.
 
     // Decrease number of assigned leases.
@@ -2857,6 +3329,24 @@ void
 AllocEngine::reclaimExpiredLease(const Lease4Ptr& lease,
                                  const DbReclaimMode& reclaim_mode,
                                  const CalloutHandlePtr& callout_handle) {
+    DbReclaimMode db_mode = prepareLeaseReclamation(lease, reclaim_mode,
+                                                    callout_handle);
+    if (db_mode != DB_RECLAIM_LEAVE_UNCHANGED) {
+        // Reclaim the lease - depending on the configuration, set the
+        // expired-reclaimed state or simply remove it.
+        LeaseMgr& lease_mgr = LeaseMgrFactory::instance();
+        reclaimLeaseInDatabase<Lease4Ptr>(lease, db_mode == DB_RECLAIM_REMOVE,
+                                          std::bind(&LeaseMgr::updateLease4,
+                                                    &lease_mgr, ph::_1));
+    }
+
+    updateReclaimedLeaseStats(lease);
+}
+
+AllocEngine::DbReclaimMode
+AllocEngine::prepareLeaseReclamation(const Lease4Ptr& lease,
+                                     const DbReclaimMode& reclaim_mode,
+                                     const CalloutHandlePtr& callout_handle) {
 
     LOG_DEBUG(alloc_engine_logger, ALLOC_ENGINE_DBG_TRACE,
               ALLOC_ENGINE_V4_LEASE_RECLAIM)
@@ -2915,15 +3405,15 @@ AllocEngine::reclaimExpiredLease(const Lease4Ptr& lease,
         }
 
         if (reclaim_mode != DB_RECLAIM_LEAVE_UNCHANGED) {
-            // Reclaim the lease - depending on the configuration, set the
-            // expired-reclaimed state or simply remove it.
-            LeaseMgr& lease_mgr = LeaseMgrFactory::instance();
-            reclaimLeaseInDatabase<Lease4Ptr>(lease, remove_lease,
-                                              std::bind(&LeaseMgr::updateLease4,
-                                                        &lease_mgr, ph::_1));
+            return (remove_lease ? DB_RECLAIM_REMOVE : DB_RECLAIM_UPDATE);
         }
     }
 
+    return (DB_RECLAIM_LEAVE_UNCHANGED);
+}
+
+void
+AllocEngine::updateReclaimedLeaseStats(const Lease4Ptr& lease) const {
     // Update statistics.
 
     // Decrease number of assigned addresses.
@@ -3086,13 +3576,7 @@ void AllocEngine::reclaimLeaseInDatabase(const LeasePtrType& lease,
     if (remove_lease) {
         lease_mgr.deleteLease(lease);
     } else if (lease_update_fun) {
-        // Clear FQDN information as we have already sent the
-        // name change request to remove the DNS record.
-        lease->reuseable_valid_lft_ = 0;
-        lease->hostname_.clear();
-        lease->fqdn_fwd_ = false;
-        lease->fqdn_rev_ = false;
-        lease->state_ = Lease::STATE_EXPIRED_RECLAIMED;
+        setLeaseReclaimed(*lease);
         lease_update_fun(lease);
 
     } else {
@@ -3105,6 +3589,96 @@ void AllocEngine::reclaimLeaseInDatabase(const LeasePtrType& lease,
         .arg(lease->addr_.toText());
 }
 
+template<typename LeaseCollectionType>
+size_t
+AllocEngine::reclaimLeasesInDatabase(LeaseMgr& lease_mgr,
+                                     const LeaseCollectionType& removed,
+                                     const LeaseCollectionType& updated) const {
+    size_t reclaimed = 0;
+    auto reclaim = [this, &reclaimed](const typename LeaseCollectionType::value_type& lease) {
+        LOG_DEBUG(alloc_engine_logger, ALLOC_ENGINE_DBG_TRACE,
+                  ALLOC_ENGINE_LEASE_RECLAIMED)
+            .arg(lease->addr_.toText());
+        updateReclaimedLeaseStats(lease);
+        ++reclaimed;
+    };
+
+    if (!removed.empty()) {
+        try {
+            // A lease which is already gone needs no removal, so the
+            // leases not deleted are reclaimed too.
+            lease_mgr.deleteLeases(removed);
+            for (auto const& lease : removed) {
+                reclaim(lease);
+            }
+
+        } catch (const std::exception& ex) {
+            // Retry lease by lease so one faulty lease does not prevent
+            // the reclamation of the others.
+            LOG_WARN(alloc_engine_logger, ALLOC_ENGINE_RECLAIM_BATCH_FAILED)
+                .arg(removed.size())
+                .arg(ex.what());
+            for (auto const& lease : removed) {
+                try {
+                    lease_mgr.deleteLease(lease);
+                } catch (const std::exception& ex) {
+                    logReclamationFailed(lease, ex.what());
+                    continue;
+                }
+                reclaim(lease);
+            }
+        }
+    }
+
+    if (!updated.empty()) {
+        for (auto const& lease : updated) {
+            setLeaseReclaimed(*lease);
+        }
+
+        try {
+            LeaseCollectionType not_updated = lease_mgr.updateLeases(updated);
+            std::set<typename LeaseCollectionType::value_type>
+                failed(not_updated.begin(), not_updated.end());
+            for (auto const& lease : updated) {
+                if (failed.count(lease) > 0) {
+                    logReclamationFailed(lease, "the lease does not exist");
+                    continue;
+                }
+                reclaim(lease);
+            }
+
+        } catch (const std::exception& ex) {
+            // Retry lease by lease so one faulty lease does not prevent
+            // the reclamation of the others.
+            LOG_WARN(alloc_engine_logger, ALLOC_ENGINE_RECLAIM_BATCH_FAILED)
+                .arg(updated.size())
+                .arg(ex.what());
+            for (auto const& lease : updated) {
+                try {
+                    updateLeaseInDatabase(lease_mgr, lease);
+                } catch (const NoSuchLease&) {
+                    logReclamationFailed(lease, "the lease does not exist");
+                    continue;
+                } catch (const std::exception& ex) {
+                    logReclamationFailed(lease, ex.what());
+                    continue;
+                }
+                reclaim(lease);
+            }
+        }
+    }
+
+    return (reclaimed);
+}
+
+template size_t
+AllocEngine::reclaimLeasesInDatabase(LeaseMgr&, const Lease4Collection&,
+                                     const Lease4Collection&) const;
+
+template size_t
+AllocEngine::reclaimLeasesInDatabase(LeaseMgr&, const Lease6Collection&,
+                                     const Lease6Collection&) const;
+
 }  // namespace dhcp
 }  // namespace isc
 
@@ -3492,6 +4066,7 @@ AllocEngine::allocateLease4(ClientContext4& ctx) {
 
 void
 AllocEngine::findReservation(ClientContext4& ctx) {
+    PacketProfiler::StageTimer timer(PacketProfiler::STAGE_HOST_LOOKUP);
     ctx.hosts_.clear();
 
     // If there is no subnet, there is nothing to do.
@@ -3878,7 +4453,12 @@ AllocEngine::requestLease4(AllocEngine::ClientContext4& ctx) {
             .arg(ctx.query_->getLabel())
             .arg(client_lease->addr_.toText());
 
-        if (LeaseMgrFactory::instance().deleteLease(client_lease)) {
+        bool deleted = false;
+        {
+            PacketProfiler::StageTimer timer(PacketProfiler::STAGE_LEASE_WRITE);
+            deleted = LeaseMgrFactory::instance().deleteLease(client_lease);
+        }
+        if (deleted) {
             // Need to decrease statistic for assigned addresses.
             StatsMgr::instance().addValue(
                 StatsMgr::generateName("subnet", client_lease->subnet_id_,
@@ -4026,7 +4606,11 @@ AllocEngine::createLease4(const ClientContext4& ctx, const IOAddress& addr,
 
     if (!ctx.fake_allocation_) {
         // That is a real (REQUEST) allocation
-        bool status = LeaseMgrFactory::instance().addLease(lease);
+        bool status = false;
+        {
+            PacketProfiler::StageTimer timer(PacketProfiler::STAGE_LEASE_WRITE);
+            status = LeaseMgrFactory::instance().addLease(lease);
+        }
         if (status) {
 
             // The lease insertion succeeded, let's bump up the statistic.
@@ -4092,7 +4676,8 @@ AllocEngine::renewLease4(const Lease4Ptr& lease,
 
     bool skip = false;
     // Execute all callouts registered for lease4_renew.
-    if (HooksManager::calloutsPresent(Hooks.hook_index_lease4_renew_)) {
+    if (ctx.callout_handle_ &&
+        HooksManager::calloutsPresent(Hooks.hook_index_lease4_renew_)) {
 
         // Use the RAII wrapper to make sure that the callout handle state is
         // reset when this object goes out of scope. All hook points must do
@@ -4141,7 +4726,10 @@ AllocEngine::renewLease4(const Lease4Ptr& lease,
 
     if (!ctx.fake_allocation_ && !skip && (lease->reuseable_valid_lft_ == 0)) {
         // for REQUEST we do update the lease
-        LeaseMgrFactory::instance().updateLease4(lease);
+        {
+            PacketProfiler::StageTimer timer(PacketProfiler::STAGE_LEASE_WRITE);
+            LeaseMgrFactory::instance().updateLease4(lease);
+        }
 
         // We need to account for the re-assignment of The lease.
         if (ctx.old_lease_->expired() || ctx.old_lease_->state_ == Lease::STATE_EXPIRED_RECLAIMED) {
@@ -4247,7 +4835,10 @@ AllocEngine::reuseExpiredLease4(Lease4Ptr& expired,
 
     if (!ctx.fake_allocation_) {
         // for REQUEST we do update the lease
-        LeaseMgrFactory::instance().updateLease4(expired);
+        {
+            PacketProfiler::StageTimer timer(PacketProfiler::STAGE_LEASE_WRITE);
+            LeaseMgrFactory::instance().updateLease4(expired);
+        }
 
         // We need to account for the re-assignment of The lease.
         StatsMgr::instance().addValue(
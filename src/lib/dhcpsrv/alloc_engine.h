@@ -28,6 +28,8 @@
 #include <boost/shared_ptr.hpp>
 #include <boost/noncopyable.hpp>
 
+#include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <list>
 #include <map>
@@ -955,6 +957,83 @@ public:
     /// deleted.
     void deleteExpiredReclaimedLeases4(const uint32_t secs);
 
+    /// @brief Outcome of a pass of the background leases reclamation.
+    struct ReclaimPass {
+        /// @brief Constructor.
+        ReclaimPass()
+            : found_(0), reclaimed_(0), deferred_(0), oldest_expire_(0) {
+        }
+
+        /// @brief Number of expired leases fetched from the lease database.
+        size_t found_;
+
+        /// @brief Number of reclaimed leases.
+        size_t reclaimed_;
+
+        /// @brief Number of leases left to a next pass because they were
+        /// used by a packet processing thread.
+        size_t deferred_;
+
+        /// @brief Expiration time of the oldest fetched lease (0 when no
+        /// lease was fetched).
+        time_t oldest_expire_;
+    };
+
+    /// @brief Reclaims expired IPv6 leases concurrently with the packet
+    /// processing.
+    ///
+    /// This method is called by the background leases reclamation thread.
+    /// It performs the same reclamation steps as @c reclaimExpiredLeases6
+    /// but it does not make the reclamation exclusive of the packet
+    /// processing: the leases are locked one by one. A lease being
+    /// allocated by a packet processing thread is left to a next pass.
+    /// Each lease is fetched again after it was locked so a lease renewed
+    /// or reclaimed by a packet processing thread in the meantime is not
+    /// reclaimed.
+    ///
+    /// @param max_leases Maximum number of leases to be reclaimed (0 means
+    /// all expired leases).
+    /// @param remove_lease A boolean value indicating if the lease should
+    /// be removed when it is reclaimed (if true) or it should be left in the
+    /// database in the "expired-reclaimed" state (if false).
+    ///
+    /// @return The outcome of the pass.
+    ReclaimPass reclaimExpiredLeasesConcurrently6(const size_t max_leases,
+                                                  const bool remove_lease);
+
+    /// @brief Reclaims expired IPv4 leases concurrently with the packet
+    /// processing.
+    ///
+    /// See @c reclaimExpiredLeasesConcurrently6 for details.
+    ///
+    /// @param max_leases Maximum number of leases to be reclaimed (0 means
+    /// all expired leases).
+    /// @param remove_lease A boolean value indicating if the lease should
+    /// be removed when it is reclaimed (if true) or it should be left in the
+    /// database in the "expired-reclaimed" state (if false).
+    ///
+    /// @return The outcome of the pass.
+    ReclaimPass reclaimExpiredLeasesConcurrently4(const size_t max_leases,
+                                                  const bool remove_lease);
+
+    /// @brief Sets the background reclamation flag.
+    ///
+    /// When the flag is set the packet processing threads reclaiming an
+    /// expired lease they are about to reuse or renew lock it against the
+    /// background reclamation thread. Must be set before the background
+    /// reclamation thread is started.
+    ///
+    /// @param enabled true when the leases are reclaimed by a background
+    /// thread.
+    void setBackgroundReclamation(const bool enabled) {
+        background_reclamation_ = enabled;
+    }
+
+    /// @brief Returns the background reclamation flag.
+    bool getBackgroundReclamation() const {
+        return (background_reclamation_);
+    }
+
     /// @anchor findReservationDecl
     /// @brief Attempts to find appropriate host reservation.
     ///
@@ -1273,6 +1352,74 @@ private:
     void reclaimExpiredLease(const LeasePtrType& lease,
                              const hooks::CalloutHandlePtr& callout_handle);
 
+    /// @brief RAII object locking a lease against its concurrent reclamation.
+    class LeaseClaim;
+
+    /// @brief Reclaim DHCPv6 lease being reused or renewed while the leases
+    /// are reclaimed by a background thread.
+    ///
+    /// The lease is locked against the background reclamation thread and
+    /// fetched again. Nothing is done when the background thread already
+    /// reclaimed it. Otherwise the lease is reclaimed and marked as
+    /// reclaimed in the lease database until the caller updates it. A lease
+    /// removed by the background thread is added back for the caller to
+    /// update it.
+    ///
+    /// @param lease Pointer to the DHCPv6 lease.
+    /// @param callout_handle Pointer to the callout handle.
+    void reclaimExpiredLeaseConcurrently(const Lease6Ptr& lease,
+                                         const hooks::CalloutHandlePtr& callout_handle);
+
+    /// @brief Reclaim DHCPv4 lease being reused or renewed while the leases
+    /// are reclaimed by a background thread.
+    ///
+    /// See @c reclaimExpiredLeaseConcurrently(const Lease6Ptr&,
+    /// const hooks::CalloutHandlePtr&) for details.
+    ///
+    /// @param lease Pointer to the DHCPv4 lease.
+    /// @param callout_handle Pointer to the callout handle.
+    void reclaimExpiredLeaseConcurrently(const Lease4Ptr& lease,
+                                         const hooks::CalloutHandlePtr& callout_handle);
+
+    /// @brief Reclaims a collection of expired leases concurrently with the
+    /// packet processing.
+    ///
+    /// @param leases Expired leases fetched from the lease database.
+    /// @param reclaim_mode Indicates what should be done with the reclaimed
+    /// leases in the lease database.
+    /// @param callout_handle Pointer to the callout handle.
+    /// @param [out] pass Outcome of the pass updated with the number of
+    /// reclaimed and deferred leases.
+    ///
+    /// @tparam LeaseCollectionType One of the @c Lease4Collection or
+    /// @c Lease6Collection.
+    template<typename LeaseCollectionType>
+    void reclaimLeasesConcurrently(const LeaseCollectionType& leases,
+                                   const DbReclaimMode& reclaim_mode,
+                                   const hooks::CalloutHandlePtr& callout_handle,
+                                   ReclaimPass& pass);
+
+    /// @brief Tries to lock a lease against its concurrent reclamation.
+    ///
+    /// @param type Lease type.
+    /// @param addr Address or prefix of the lease.
+    /// @return true if the lease was locked, false if it is locked by
+    /// another thread.
+    bool tryClaimLease(const Lease::Type type, const asiolink::IOAddress& addr);
+
+    /// @brief Locks a lease against its concurrent reclamation, waiting
+    /// until it is unlocked by another thread.
+    ///
+    /// @param type Lease type.
+    /// @param addr Address or prefix of the lease.
+    void claimLease(const Lease::Type type, const asiolink::IOAddress& addr);
+
+    /// @brief Unlocks a lease.
+    ///
+    /// @param type Lease type.
+    /// @param addr Address or prefix of the lease.
+    void releaseLease(const Lease::Type type, const asiolink::IOAddress& addr);
+
     /// @brief Reclaim DHCPv6 lease.
     ///
     /// This method variant accepts the @c reclaim_mode parameter which
@@ -1301,6 +1448,50 @@ private:
                              const DbReclaimMode& reclaim_mode,
                              const hooks::CalloutHandlePtr& callout_handle);
 
+    /// @brief Reclaim DHCPv6 lease without touching the lease database.
+    ///
+    /// This method runs the lease6_expire callouts, queues the DNS removal
+    /// and handles declined leases. It leaves the database update and the
+    /// statistics to the caller, so as the leases reclaimed by the
+    /// reclamation routine can be written to the database in batches.
+    ///
+    /// @param lease Pointer to the DHCPv6 lease.
+    /// @param reclaim_mode Indicates what should be done with the reclaimed
+    /// lease in the lease database.
+    /// @param callout_handle Pointer to the callout handle.
+    ///
+    /// @return The update of the lease database to be done: remove the
+    /// lease, update it or leave it unchanged when the callouts have
+    /// taken responsibility for the lease.
+    DbReclaimMode prepareLeaseReclamation(const Lease6Ptr& lease,
+                                          const DbReclaimMode& reclaim_mode,
+                                          const hooks::CalloutHandlePtr& callout_handle);
+
+    /// @brief Reclaim DHCPv4 lease without touching the lease database.
+    ///
+    /// See @c prepareLeaseReclamation(const Lease6Ptr&, const DbReclaimMode&,
+    /// const hooks::CalloutHandlePtr&) for details.
+    ///
+    /// @param lease Pointer to the DHCPv4 lease.
+    /// @param reclaim_mode Indicates what should be done with the reclaimed
+    /// lease in the lease database.
+    /// @param callout_handle Pointer to the callout handle.
+    ///
+    /// @return The update of the lease database to be done.
+    DbReclaimMode prepareLeaseReclamation(const Lease4Ptr& lease,
+                                          const DbReclaimMode& reclaim_mode,
+                                          const hooks::CalloutHandlePtr& callout_handle);
+
+    /// @brief Updates the statistics upon DHCPv6 lease reclamation.
+    ///
+    /// @param lease Pointer to the reclaimed DHCPv6 lease.
+    void updateReclaimedLeaseStats(const Lease6Ptr& lease) const;
+
+    /// @brief Updates the statistics upon DHCPv4 lease reclamation.
+    ///
+    /// @param lease Pointer to the reclaimed DHCPv4 lease.
+    void updateReclaimedLeaseStats(const Lease4Ptr& lease) const;
+
     /// @brief Marks lease as reclaimed in the database.
     ///
     /// This method is called internally by the leases reclamation routines.
@@ -1908,6 +2099,30 @@ protected:
     bool updateLease6ExtendedInfo(const Lease6Ptr& lease,
                                   const ClientContext6& ctx) const;
 
+    /// @brief Marks a batch of leases as reclaimed in the database.
+    ///
+    /// This method is called by the leases reclamation routines. It removes
+    /// and updates the leases using the batch operations of the lease
+    /// manager and updates the statistics of the leases which were written
+    /// to the database. A lease which could not be updated is logged as
+    /// not reclaimed. When a batch operation fails the leases of the batch
+    /// are written again one by one, and only the leases which fail again
+    /// are logged as not reclaimed.
+    /// (Note it is protected to facilitate unit testing).
+    ///
+    /// @param lease_mgr Lease manager holding the leases.
+    /// @param removed Leases to be removed from the database.
+    /// @param updated Leases to be set to the "expired-reclaimed" state.
+    ///
+    /// @return Number of reclaimed leases.
+    ///
+    /// @tparam LeaseCollectionType One of the @c Lease4Collection or
+    /// @c Lease6Collection.
+    template<typename LeaseCollectionType>
+    size_t reclaimLeasesInDatabase(LeaseMgr& lease_mgr,
+                                   const LeaseCollectionType& removed,
+                                   const LeaseCollectionType& updated) const;
+
 private:
 
     /// @brief Try to reuse an already allocated lease.
@@ -1954,6 +2169,21 @@ private:
     /// which there are still expired leases in the database.
     uint16_t incomplete_v6_reclamations_;
 
+    /// @brief Flag set when the leases are reclaimed by a background thread.
+    std::atomic<bool> background_reclamation_;
+
+    /// @brief Mutex serializing the leases reclamation routines.
+    std::mutex reclaim_mutex_;
+
+    /// @brief Mutex protecting the locked leases.
+    std::mutex claims_mutex_;
+
+    /// @brief Condition variable signaled when a lease is unlocked.
+    std::condition_variable claims_cv_;
+
+    /// @brief Leases locked against their concurrent reclamation.
+    std::set<std::pair<Lease::Type, asiolink::IOAddress> > claims_;
+
 public:
 
     /// @brief Get the read-write mutex.
@@ -0,0 +1,136 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <dhcpsrv/benchmarks/generic_host_data_source_benchmark.h>
+#include <dhcpsrv/benchmarks/parameters.h>
+#include <dhcpsrv/cfg_hosts.h>
+
+using namespace isc::dhcp;
+using namespace isc::dhcp::bench;
+
+namespace {
+
+/// @brief This is a fixture class used for benchmarking the host
+/// reservations specified in the configuration.
+class CfgHostsBenchmark : public GenericHostDataSourceBenchmark {
+public:
+    /// @brief Setup routine.
+    ///
+    /// Creates a new empty host reservations configuration.
+    /// The state parameter is ignored.
+    void SetUp(::benchmark::State const&) override {
+        hdsptr_.reset(new CfgHosts());
+    }
+
+    void SetUp(::benchmark::State& s) override {
+        ::benchmark::State const& cs = s;
+        SetUp(cs);
+    }
+
+    /// @brief Cleans up after the test.
+    void TearDown(::benchmark::State const&) override {
+        hdsptr_.reset();
+    }
+
+    void TearDown(::benchmark::State& s) override {
+        ::benchmark::State const& cs = s;
+        TearDown(cs);
+    }
+};
+
+/// Defines steps necessary for conducting a benchmark that measures
+/// hosts insertion.
+BENCHMARK_DEFINE_F(CfgHostsBenchmark, insertHosts)(benchmark::State& state) {
+    const size_t host_count = state.range(0);
+    while (state.KeepRunning()) {
+        setUp(state, host_count);
+        insertHosts();
+    }
+}
+
+/// Defines steps necessary for conducting a benchmark that measures
+/// hosts retrieval by getAll(identifier-type, identifier) call.
+BENCHMARK_DEFINE_F(CfgHostsBenchmark, getAll)(benchmark::State& state) {
+    const size_t host_count = state.range(0);
+    while (state.KeepRunning()) {
+        setUpWithInserts(state, host_count);
+        benchGetAll();
+    }
+}
+
+/// Defines steps necessary for conducting a benchmark that measures
+/// hosts retrieval by getAllbyHostname(hostname) call.
+BENCHMARK_DEFINE_F(CfgHostsBenchmark, getAllbyHostname)(benchmark::State& state) {
+    const size_t host_count = state.range(0);
+    while (state.KeepRunning()) {
+        setUpWithInserts(state, host_count);
+        benchGetAllbyHostname();
+    }
+}
+
+/// Defines steps necessary for conducting a benchmark that measures
+/// hosts retrieval by get4(identifier-type, identifier, subnet-id) call.
+BENCHMARK_DEFINE_F(CfgHostsBenchmark, get4IdentifierSubnetId)(benchmark::State& state) {
+    const size_t host_count = state.range(0);
+    while (state.KeepRunning()) {
+        setUpWithInserts(state, host_count);
+        benchGet4IdentifierSubnetId();
+    }
+}
+
+/// Defines steps necessary for conducting a benchmark that measures
+/// hosts retrieval by get6(subnet-id, identifier-type, identifier) call.
+BENCHMARK_DEFINE_F(CfgHostsBenchmark, get6IdentifierSubnetId)(benchmark::State& state) {
+    const size_t host_count = state.range(0);
+    while (state.KeepRunning()) {
+        setUpWithInserts(state, host_count);
+        benchGet6IdentifierSubnetId();
+    }
+}
+
+/// Defines steps necessary for conducting a benchmark that measures
+/// hosts retrieval by get6(subnet-id, ip-address) call.
+BENCHMARK_DEFINE_F(CfgHostsBenchmark, get6SubnetIdAddr)(benchmark::State& state) {
+    const size_t host_count = state.range(0);
+    while (state.KeepRunning()) {
+        setUpWithInserts(state, host_count);
+        benchGet6SubnetIdAddr();
+    }
+}
+
+/// Defines parameters necessary for running a benchmark that measures
+/// hosts insertion.
+BENCHMARK_REGISTER_F(CfgHostsBenchmark, insertHosts)
+    ->Range(MIN_HOST_COUNT, MAX_HOST_COUNT)->Unit(UNIT);
+
+/// Defines parameters necessary for running a benchmark that measures
+/// hosts retrieval by getAll(identifier-type, identifier) call.
+BENCHMARK_REGISTER_F(CfgHostsBenchmark, getAll)
+    ->Range(MIN_HOST_COUNT, MAX_HOST_COUNT)->Unit(UNIT);
+
+/// Defines parameters necessary for running a benchmark that measures
+/// hosts retrieval by getAllbyHostname(hostname) call.
+BENCHMARK_REGISTER_F(CfgHostsBenchmark, getAllbyHostname)
+    ->Range(MIN_HOST_COUNT, MAX_HOST_COUNT)->Unit(UNIT);
+
+/// Defines parameters necessary for running a benchmark that measures
+/// hosts retrieval by get4(identifier-type, identifier, subnet-id) call.
+BENCHMARK_REGISTER_F(CfgHostsBenchmark, get4IdentifierSubnetId)
+    ->Range(MIN_HOST_COUNT, MAX_HOST_COUNT)->Unit(UNIT);
+
+/// Defines parameters necessary for running a benchmark that measures
+/// hosts retrieval by get6(subnet-id, identifier-type, identifier) call.
+BENCHMARK_REGISTER_F(CfgHostsBenchmark, get6IdentifierSubnetId)
+    ->Range(MIN_HOST_COUNT, MAX_HOST_COUNT)->Unit(UNIT);
+
+/// Defines parameters necessary for running a benchmark that measures
+/// hosts retrieval by get6(subnet-id, ip-address) call.
+BENCHMARK_REGISTER_F(CfgHostsBenchmark, get6SubnetIdAddr)
+    ->Range(MIN_HOST_COUNT, MAX_HOST_COUNT)->Unit(UNIT);
+
+}  // namespace
@@ -176,6 +176,7 @@ GenericHostDataSourceBenchmark::prepareHosts(size_t const& host_count) {
 
         const std::string prefix = std::string("2001:db8::") + n_host;
         HostPtr host = HostDataSourceUtils::initializeHost6(prefix, Host::IDENT_HWADDR, false);
+        host->setHostname("Host-" + n_host + ".example.org");
         addTestOptions(host, false, DHCP4_AND_DHCP6);
         hosts_.push_back(host);
     }
@@ -196,6 +197,13 @@ GenericHostDataSourceBenchmark::benchGetAll() {
     }
 }
 
+void
+GenericHostDataSourceBenchmark::benchGetAllbyHostname() {
+    for (HostPtr host : hosts_) {
+        hdsptr_->getAllbyHostname(host->getLowerHostname());
+    }
+}
+
 void
 GenericHostDataSourceBenchmark::getAllv4Resv() {
     for (HostPtr host : hosts_) {
@@ -1,4 +1,4 @@
-// Copyright (C) 2018-2019 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2018-2021 Internet Systems Consortium, Inc. ("ISC")
 // Copyright (C) 2017 Deutsche Telekom AG.
 //
 // Authors: Andrei Pavel <andrei.pavel@qualitance.com>
@@ -186,6 +186,10 @@ public:
     ///        getAll(identifier-type, identifier) call.
     void benchGetAll();
 
+    /// @brief Essential steps required to benchmark the
+    ///        getAllbyHostname(hostname) call.
+    void benchGetAllbyHostname();
+
     /// @brief Essential steps required to benchmark host reservation retrieval
     ///        using getAll(ipv4-reservation) call.
     void getAllv4Resv();
@@ -1,4 +1,4 @@
-// Copyright (C) 2018-2019 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2018-2021 Internet Systems Consortium, Inc. ("ISC")
 // Copyright (C) 2017 Deutsche Telekom AG.
 //
 // Authors: Andrei Pavel <andrei.pavel@qualitance.com>
@@ -149,6 +149,29 @@ GenericLeaseMgrBenchmark::benchGetExpiredLeases4() {
     lmptr_->getExpiredLeases4(expired_leases, leases4_.size());
 }
 
+void
+GenericLeaseMgrBenchmark::benchGetLeases4_paged(size_t const& page_size) {
+    IOAddress lower_bound = IOAddress::IPV4_ZERO_ADDRESS();
+    for (;;) {
+        Lease4Collection page = lmptr_->getLeases4(lower_bound,
+                                                   LeasePageSize(page_size));
+        if (page.size() < page_size) {
+            break;
+        }
+        lower_bound = page.back()->addr_;
+    }
+}
+
+void
+GenericLeaseMgrBenchmark::benchUpdateLeases4_batch() {
+    lmptr_->updateLeases(leases4_);
+}
+
+void
+GenericLeaseMgrBenchmark::benchDeleteLeases4_batch() {
+    lmptr_->deleteLeases(leases4_);
+}
+
 void
 GenericLeaseMgrBenchmark::prepareLeases6(size_t const& lease_count) {
     if (lease_count > 0xfffdu) {
@@ -222,6 +245,16 @@ GenericLeaseMgrBenchmark::benchGetExpiredLeases6() {
     lmptr_->getExpiredLeases6(expired_leases, leases6_.size());
 }
 
+void
+GenericLeaseMgrBenchmark::benchUpdateLeases6_batch() {
+    lmptr_->updateLeases(leases6_);
+}
+
+void
+GenericLeaseMgrBenchmark::benchDeleteLeases6_batch() {
+    lmptr_->deleteLeases(leases6_);
+}
+
 /// @todo: Calls that aren't measured:
 /// - deleteLease(const Lease4Ptr& lease);
 /// - deleteLease(const Lease6Ptr& lease);
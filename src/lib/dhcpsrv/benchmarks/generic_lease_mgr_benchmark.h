@@ -1,4 +1,4 @@
-// Copyright (C) 2018-2019 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2018-2021 Internet Systems Consortium, Inc. ("ISC")
 // Copyright (C) 2017 Deutsche Telekom AG.
 //
 // Authors: Andrei Pavel <andrei.pavel@qualitance.com>
@@ -94,6 +94,19 @@ public:
     /// @brief This step retrieves all expired IPv4 leases.
     void benchGetExpiredLeases4();
 
+    /// @brief This step retrieves all IPv4 leases by pages.
+    ///
+    /// @param page_size maximum number of leases in a page.
+    void benchGetLeases4_paged(size_t const& page_size);
+
+    /// @brief This step updates all IPv4 leases stored in lease4_ in a
+    /// single batch.
+    void benchUpdateLeases4_batch();
+
+    /// @brief This step deletes all IPv4 leases stored in lease4_ in a
+    /// single batch.
+    void benchDeleteLeases4_batch();
+
     /// @brief Prepares specified number of IPv6 leases
     ///
     /// The leases are stored in leases6_ container.
@@ -118,6 +131,14 @@ public:
     /// @brief This step retrieves all expired IPv6 leases.
     void benchGetExpiredLeases6();
 
+    /// @brief This step updates all IPv6 leases stored in lease6_ in a
+    /// single batch.
+    void benchUpdateLeases6_batch();
+
+    /// @brief This step deletes all IPv6 leases stored in lease6_ in a
+    /// single batch.
+    void benchDeleteLeases6_batch();
+
     /// Pointer to the lease manager being under evaluation.
     LeaseMgr* lmptr_;
 
@@ -0,0 +1,145 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <dhcp/dhcp4.h>
+#include <dhcp/pkt4.h>
+#include <dhcpsrv/callout_handle_store.h>
+#include <hooks/callout_handle.h>
+#include <hooks/hooks_manager.h>
+#include <hooks/server_hooks.h>
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace isc::dhcp;
+using namespace isc::hooks;
+
+namespace {
+
+/// @brief Hook points called for each DHCPv4 packet.
+const char* PACKET_HOOKS[] = {
+    "buffer4_receive",
+    "pkt4_receive",
+    "subnet4_select",
+    "lease4_select",
+    "leases4_committed",
+    "pkt4_send",
+    "buffer4_send"
+};
+
+/// @brief Hook points on which the simulated libraries register callouts.
+///
+/// A typical library registers callouts on a few hook points only.
+const char* LIBRARY_HOOKS[] = {
+    "pkt4_receive",
+    "pkt4_send"
+};
+
+/// @brief Callout doing nothing.
+///
+/// @param handle Callout handle (unused).
+/// @return Always 0.
+int
+emptyCallout(CalloutHandle&) {
+    return (0);
+}
+
+/// @brief Fixture class for benchmarking the per packet hooks overhead.
+///
+/// The benchmark follows the steps of the DHCPv4 server for each packet:
+/// the callout handle is obtained only when callouts are present and the
+/// arguments are set and the callouts are called on each hook point which
+/// has callouts. Hook libraries can't be loaded here, so each simulated
+/// library registers its callouts using the pre-callouts library handle.
+/// The number of libraries is given by the benchmark argument.
+class HooksBenchmark : public ::benchmark::Fixture {
+public:
+    /// @brief Setup routine.
+    ///
+    /// Registers the hook points and the callouts of the simulated
+    /// libraries.
+    ///
+    /// @param state Benchmark state holding the number of libraries.
+    void SetUp(::benchmark::State const& state) override {
+        indexes_.clear();
+        ServerHooks& hooks = ServerHooks::getServerHooks();
+        for (auto const& name : PACKET_HOOKS) {
+            int index = hooks.findIndex(name);
+            if (index < 0) {
+                index = hooks.registerHook(name);
+            }
+            indexes_.push_back(index);
+        }
+
+        // Recreate the callout manager to take the new hook points into
+        // account.
+        HooksManager::loadLibraries(HookLibsCollection());
+
+        for (int64_t i = 0; i < state.range(0); ++i) {
+            for (auto const& name : LIBRARY_HOOKS) {
+                HooksManager::preCalloutsLibraryHandle().
+                    registerCallout(name, emptyCallout);
+            }
+        }
+    }
+
+    void SetUp(::benchmark::State& s) override {
+        ::benchmark::State const& cs = s;
+        SetUp(cs);
+    }
+
+    /// @brief Cleans up after the test.
+    ///
+    /// Deregisters the callouts.
+    void TearDown(::benchmark::State const&) override {
+        for (auto const& name : LIBRARY_HOOKS) {
+            HooksManager::preCalloutsLibraryHandle().deregisterAllCallouts(name);
+        }
+    }
+
+    void TearDown(::benchmark::State& s) override {
+        ::benchmark::State const& cs = s;
+        TearDown(cs);
+    }
+
+    /// @brief Processes packets until the benchmark ends.
+    ///
+    /// @param state Benchmark state.
+    void processPackets(::benchmark::State& state) {
+        for (auto _ : state) {
+            Pkt4Ptr query(new Pkt4(DHCPDISCOVER, 1234));
+            CalloutHandlePtr callout_handle = getCalloutHandleIfPresent(query);
+            for (auto const& index : indexes_) {
+                if (HooksManager::calloutsPresent(index)) {
+                    ScopedCalloutHandleState callout_handle_state(callout_handle);
+                    callout_handle->setArgument("query4", query);
+                    HooksManager::callCallouts(index, *callout_handle);
+                }
+            }
+            benchmark::DoNotOptimize(callout_handle);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+private:
+    /// @brief Indexes of the hook points called for each packet.
+    std::vector<int> indexes_;
+};
+
+/// Defines steps necessary for conducting a benchmark that measures
+/// the hooks overhead of the packet processing.
+BENCHMARK_DEFINE_F(HooksBenchmark, processPacket)(benchmark::State& state) {
+    processPackets(state);
+}
+
+/// Run with 0, 1 and 5 libraries.
+BENCHMARK_REGISTER_F(HooksBenchmark, processPacket)->Arg(0)->Arg(1)->Arg(5);
+
+} // end of anonymous namespace
@@ -1,4 +1,4 @@
-// Copyright (C) 2018-2019 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2018-2021 Internet Systems Consortium, Inc. ("ISC")
 // Copyright (C) 2017 Deutsche Telekom AG.
 //
 // Authors: Andrei Pavel <andrei.pavel@qualitance.com>
@@ -148,6 +148,43 @@ BENCHMARK_DEFINE_F(PgSqlLeaseMgrBenchmark, getExpiredLeases4)(benchmark::State&
     }
 }
 
+/// @brief Number of leases in a page of the paged retrieval benchmarks.
+const size_t PAGE_SIZE = 1000;
+
+// Defines a benchmark that measures retrieval of all IPv4 leases by pages.
+// The rate of retrieved leases is reported as items per second.
+BENCHMARK_DEFINE_F(PgSqlLeaseMgrBenchmark, getLeases4_paged)(benchmark::State& state) {
+    const size_t lease_count = state.range(0);
+    while (state.KeepRunning()) {
+        setUpWithInserts4(state, lease_count);
+        benchGetLeases4_paged(PAGE_SIZE);
+    }
+    state.SetItemsProcessed(state.iterations() * lease_count);
+}
+
+// Defines a benchmark that measures IPv4 leases update in a single batch.
+// The rate of updated leases is reported as items per second.
+BENCHMARK_DEFINE_F(PgSqlLeaseMgrBenchmark, updateLeases4_batch)(benchmark::State& state) {
+    const size_t lease_count = state.range(0);
+    while (state.KeepRunning()) {
+        setUpWithInserts4(state, lease_count);
+        benchUpdateLeases4_batch();
+    }
+    state.SetItemsProcessed(state.iterations() * lease_count);
+}
+
+// Defines a benchmark that measures IPv4 leases deletion in a single batch,
+// e.g. by the reclamation of expired leases.
+// The rate of deleted leases is reported as items per second.
+BENCHMARK_DEFINE_F(PgSqlLeaseMgrBenchmark, deleteLeases4_batch)(benchmark::State& state) {
+    const size_t lease_count = state.range(0);
+    while (state.KeepRunning()) {
+        setUpWithInserts4(state, lease_count);
+        benchDeleteLeases4_batch();
+    }
+    state.SetItemsProcessed(state.iterations() * lease_count);
+}
+
 // Defines a benchmark that measures IPv6 leases insertion.
 BENCHMARK_DEFINE_F(PgSqlLeaseMgrBenchmark, insertLeases6)(benchmark::State& state) {
     const size_t lease_count = state.range(0);
@@ -204,6 +241,28 @@ BENCHMARK_DEFINE_F(PgSqlLeaseMgrBenchmark, getExpiredLeases6)(benchmark::State&
     }
 }
 
+// Defines a benchmark that measures IPv6 leases update in a single batch.
+// The rate of updated leases is reported as items per second.
+BENCHMARK_DEFINE_F(PgSqlLeaseMgrBenchmark, updateLeases6_batch)(benchmark::State& state) {
+    const size_t lease_count = state.range(0);
+    while (state.KeepRunning()) {
+        setUpWithInserts6(state, lease_count);
+        benchUpdateLeases6_batch();
+    }
+    state.SetItemsProcessed(state.iterations() * lease_count);
+}
+
+// Defines a benchmark that measures IPv6 leases deletion in a single batch.
+// The rate of deleted leases is reported as items per second.
+BENCHMARK_DEFINE_F(PgSqlLeaseMgrBenchmark, deleteLeases6_batch)(benchmark::State& state) {
+    const size_t lease_count = state.range(0);
+    while (state.KeepRunning()) {
+        setUpWithInserts6(state, lease_count);
+        benchDeleteLeases6_batch();
+    }
+    state.SetItemsProcessed(state.iterations() * lease_count);
+}
+
 /// The following macros define run parameters for previously defined
 /// PostgreSQL benchmarks.
 
@@ -240,6 +299,18 @@ BENCHMARK_REGISTER_F(PgSqlLeaseMgrBenchmark, getLease4_clientid_subnetid)
 BENCHMARK_REGISTER_F(PgSqlLeaseMgrBenchmark, getExpiredLeases4)
     ->Range(MIN_LEASE_COUNT, MAX_LEASE_COUNT)->Unit(UNIT);
 
+/// A benchmark that measures IPv4 leases retrieval by pages.
+BENCHMARK_REGISTER_F(PgSqlLeaseMgrBenchmark, getLeases4_paged)
+    ->Range(MIN_LEASE_COUNT, MAX_LEASE_COUNT)->Unit(UNIT);
+
+/// A benchmark that measures IPv4 leases update in a single batch.
+BENCHMARK_REGISTER_F(PgSqlLeaseMgrBenchmark, updateLeases4_batch)
+    ->Range(MIN_LEASE_COUNT, MAX_LEASE_COUNT)->Unit(UNIT);
+
+/// A benchmark that measures IPv4 leases deletion in a single batch.
+BENCHMARK_REGISTER_F(PgSqlLeaseMgrBenchmark, deleteLeases4_batch)
+    ->Range(MIN_LEASE_COUNT, MAX_LEASE_COUNT)->Unit(UNIT);
+
 /// A benchmark that measures IPv6 leases insertion.
 BENCHMARK_REGISTER_F(PgSqlLeaseMgrBenchmark, insertLeases6)
     ->Range(MIN_LEASE_COUNT, MAX_LEASE_COUNT)->Unit(UNIT);
@@ -265,4 +336,12 @@ BENCHMARK_REGISTER_F(PgSqlLeaseMgrBenchmark, getLease6_type_duid_iaid_subnetid)
 BENCHMARK_REGISTER_F(PgSqlLeaseMgrBenchmark, getExpiredLeases6)
     ->Range(MIN_LEASE_COUNT, MAX_LEASE_COUNT)->Unit(UNIT);
 
+/// A benchmark that measures IPv6 leases update in a single batch.
+BENCHMARK_REGISTER_F(PgSqlLeaseMgrBenchmark, updateLeases6_batch)
+    ->Range(MIN_LEASE_COUNT, MAX_LEASE_COUNT)->Unit(UNIT);
+
+/// A benchmark that measures IPv6 leases deletion in a single batch.
+BENCHMARK_REGISTER_F(PgSqlLeaseMgrBenchmark, deleteLeases6_batch)
+    ->Range(MIN_LEASE_COUNT, MAX_LEASE_COUNT)->Unit(UNIT);
+
 }  // namespace
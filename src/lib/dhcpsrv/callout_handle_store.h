@@ -54,6 +54,30 @@ isc::hooks::CalloutHandlePtr getCalloutHandle(const T& pktptr) {
     return (isc::hooks::CalloutHandlePtr());
 }
 
+/// @brief Returns the callout handle of a packet if callouts are present
+///
+/// Obtaining the callout handle of a packet creates it, so the packet
+/// processing calls this function where the handle is only used by the
+/// hook points, e.g. when it is passed down to the allocation engine or
+/// to the packet sending routines. When no hook library has registered
+/// a callout, whatever the hook point, an empty pointer is returned and
+/// the per packet hooks setup is skipped. The hook points check the
+/// presence of their callouts before using the handle.
+///
+/// @tparam T Pkt4Ptr or Pkt6Ptr object.
+/// @param pktptr Pointer to the packet being processed.
+///
+/// @return Shared pointer to the CalloutHandle of the packet or an empty
+///         pointer if no callouts are present.
+template <typename T>
+isc::hooks::CalloutHandlePtr getCalloutHandleIfPresent(const T& pktptr) {
+    if (!isc::hooks::HooksManager::anyCalloutsPresent()) {
+        return (isc::hooks::CalloutHandlePtr());
+    }
+
+    return (getCalloutHandle(pktptr));
+}
+
 } // namespace dhcp
 } // namespace isc
 
@@ -1,4 +1,4 @@
-// Copyright (C) 2019 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2019-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -10,6 +10,9 @@
 #include <cc/stamped_value.h>
 #include <process/cb_ctl_base.h>
 #include <dhcpsrv/srv_config.h>
+#include <stats/stats_mgr.h>
+
+#include <chrono>
 
 namespace isc {
 namespace dhcp {
@@ -27,13 +30,73 @@ template<typename ConfigBackendMgrType>
 class CBControlDHCP : public process::CBControlBase<ConfigBackendMgrType> {
 public:
 
+    /// @brief Type of the fetch mode.
+    typedef typename process::CBControlBase<ConfigBackendMgrType>::FetchMode
+        FetchModeType;
+
     /// @brief Constructor.
     CBControlDHCP()
-        : process::CBControlBase<ConfigBackendMgrType>() {
+        : process::CBControlBase<ConfigBackendMgrType>(),
+          fetched_audit_entries_(0), fetched_objects_(0),
+          recounted_subnets_(0) {
+    }
+
+    /// @brief Fetches the entire or partial configuration from the database.
+    ///
+    /// When fetching the configuration updates, the cost of the poll is
+    /// published in the following statistics:
+    /// - cb-update-polls: the number of polls,
+    /// - cb-update-poll-time: the duration of the last poll,
+    /// - cb-update-audit-entries: the number of audit entries fetched by
+    ///   the last poll,
+    /// - cb-update-fetched-objects: the number of configuration elements
+    ///   fetched by the last poll,
+    /// - cb-update-recounted-subnets: the number of subnets whose lease
+    ///   statistics were recounted by the last poll.
+    ///
+    /// @param srv_cfg pointer to the configuration to fetch into.
+    /// @param fetch_mode value indicating if the method is called upon the
+    /// server start up or it is called to fetch configuration updates.
+    virtual void databaseConfigFetch(const process::ConfigPtr& srv_cfg,
+                                     const FetchModeType& fetch_mode = FetchModeType::FETCH_ALL) {
+        if (fetch_mode != FetchModeType::FETCH_UPDATE) {
+            process::CBControlBase<ConfigBackendMgrType>::databaseConfigFetch(srv_cfg,
+                                                                              fetch_mode);
+            return;
+        }
+
+        fetched_audit_entries_ = 0;
+        fetched_objects_ = 0;
+        recounted_subnets_ = 0;
+        auto start = std::chrono::steady_clock::now();
+        try {
+            process::CBControlBase<ConfigBackendMgrType>::databaseConfigFetch(srv_cfg,
+                                                                              fetch_mode);
+        } catch (...) {
+            updatePollStatistics(std::chrono::steady_clock::now() - start);
+            throw;
+        }
+        updatePollStatistics(std::chrono::steady_clock::now() - start);
     }
 
 protected:
 
+    /// @brief Publishes the cost of a configuration update poll.
+    ///
+    /// @param duration Duration of the poll.
+    void updatePollStatistics(const std::chrono::steady_clock::duration& duration) const {
+        stats::StatsMgr& stats_mgr = stats::StatsMgr::instance();
+        stats_mgr.addValue("cb-update-polls", static_cast<int64_t>(1));
+        stats_mgr.setValue("cb-update-poll-time",
+                           std::chrono::duration_cast<stats::StatsDuration>(duration));
+        stats_mgr.setValue("cb-update-audit-entries",
+                           static_cast<int64_t>(fetched_audit_entries_));
+        stats_mgr.setValue("cb-update-fetched-objects",
+                           static_cast<int64_t>(fetched_objects_));
+        stats_mgr.setValue("cb-update-recounted-subnets",
+                           static_cast<int64_t>(recounted_subnets_));
+    }
+
     /// @brief Adds globals fetched from config backend(s) to a SrvConfig instance
     ///
     /// Iterates over the given collection of global parameters and adds them to the
@@ -55,6 +118,17 @@ protected:
                                               (*cb_global)->getElementValue());
         }
     }
+
+    /// @brief Number of audit entries fetched by the last update poll.
+    size_t fetched_audit_entries_;
+
+    /// @brief Number of configuration elements fetched by the last update
+    /// poll.
+    size_t fetched_objects_;
+
+    /// @brief Number of subnets whose lease statistics were recounted by
+    /// the last update poll.
+    size_t recounted_subnets_;
 };
 
 } // end of namespace isc::dhcp
@@ -13,6 +13,8 @@
 #include <hooks/callout_handle.h>
 #include <hooks/hooks_manager.h>
 
+#include <algorithm>
+
 using namespace isc::db;
 using namespace isc::data;
 using namespace isc::process;
@@ -48,6 +50,11 @@ CBControlDHCPv6::databaseConfigApply(const db::BackendSelector& backend_selector
                                      const db::AuditEntryCollection& audit_entries) {
     bool globals_fetched = false;
 
+    // Snapshot of the subnets before the update. The lease statistics of
+    // the subnets which are not deleted nor replaced by the update are kept
+    // as they are, only the other subnets are recounted.
+    SrvConfig previous;
+
     // Let's first delete all the configuration elements for which DELETE audit
     // entries are found. Although, this may break chronology of the audit in
     // some cases it should not affect the end result of the data fetch. If the
@@ -59,6 +66,8 @@ CBControlDHCPv6::databaseConfigApply(const db::BackendSelector& backend_selector
 
         auto cfg = CfgMgr::instance().getCurrentCfg();
         auto external_cfg = CfgMgr::instance().createExternalCfg();
+        *previous.getCfgSubnets6() = *cfg->getCfgSubnets6();
+        fetched_audit_entries_ = audit_entries.size();
 
         // Get audit entries for deleted global parameters.
         const auto& index = audit_entries.get<AuditEntryObjectTypeTag>();
@@ -73,6 +82,7 @@ CBControlDHCPv6::databaseConfigApply(const db::BackendSelector& backend_selector
             // database query and the number of global parameters is small.
             data::StampedValueCollection globals;
             globals = getMgr().getPool()->getAllGlobalParameters6(backend_selector, server_selector);
+            fetched_objects_ += globals.size();
             addGlobalsToConfig(external_cfg, globals);
 
             // Add defaults.
@@ -85,7 +95,9 @@ CBControlDHCPv6::databaseConfigApply(const db::BackendSelector& backend_selector
             // Now that we successfully fetched the new global parameters, let's
             // remove existing ones and merge them into the current configuration.
             cfg->clearConfiguredGlobals();
-            CfgMgr::instance().mergeIntoCurrentCfg(external_cfg->getSequence());
+            recounted_subnets_ +=
+                CfgMgr::instance().mergeIntoCurrentCfg(external_cfg->getSequence(),
+                                                       previous);
             globals_fetched = true;
         }
 
@@ -159,6 +171,7 @@ CBControlDHCPv6::databaseConfigApply(const db::BackendSelector& backend_selector
         data::StampedValueCollection globals;
         globals = getMgr().getPool()->getModifiedGlobalParameters6(backend_selector, server_selector,
                                                                    lb_modification_time);
+        fetched_objects_ += globals.size();
         addGlobalsToConfig(external_cfg, globals);
         globals_fetched = true;
     }
@@ -171,6 +184,7 @@ CBControlDHCPv6::databaseConfigApply(const db::BackendSelector& backend_selector
         OptionDefContainer option_defs =
             getMgr().getPool()->getModifiedOptionDefs6(backend_selector, server_selector,
                                                        lb_modification_time);
+        fetched_objects_ += option_defs.size();
         for (auto option_def = option_defs.begin(); option_def != option_defs.end(); ++option_def) {
             if (!audit_entries.empty() && !hasObjectId(updated_entries, (*option_def)->getId())) {
                 continue;
@@ -187,6 +201,7 @@ CBControlDHCPv6::databaseConfigApply(const db::BackendSelector& backend_selector
         OptionContainer options = getMgr().getPool()->getModifiedOptions6(backend_selector,
                                                                           server_selector,
                                                                           lb_modification_time);
+        fetched_objects_ += options.size();
         for (auto option = options.begin(); option != options.end(); ++option) {
             if (!audit_entries.empty() && !hasObjectId(updated_entries, (*option).getId())) {
                 continue;
@@ -202,6 +217,7 @@ CBControlDHCPv6::databaseConfigApply(const db::BackendSelector& backend_selector
     if (audit_entries.empty() || !updated_entries.empty()) {
         ClientClassDictionary client_classes = getMgr().getPool()->getAllClientClasses6(backend_selector,
                                                                                         server_selector);
+        fetched_objects_ += client_classes.getClasses()->size();
         // Match expressions are not initialized for classes returned from the config backend.
         // We have to ensure to initialize them before they can be used by the server.
         client_classes.initMatchExpr(AF_INET6);
@@ -216,6 +232,7 @@ CBControlDHCPv6::databaseConfigApply(const db::BackendSelector& backend_selector
         SharedNetwork6Collection networks =
             getMgr().getPool()->getModifiedSharedNetworks6(backend_selector, server_selector,
                                                            lb_modification_time);
+        fetched_objects_ += networks.size();
         for (auto network = networks.begin(); network != networks.end(); ++network) {
             if (!audit_entries.empty() && !hasObjectId(updated_entries, (*network)->getId())) {
                 continue;
@@ -235,9 +252,25 @@ CBControlDHCPv6::databaseConfigApply(const db::BackendSelector& backend_selector
         updated_entries = fetchConfigElement(audit_entries, "dhcp6_subnet");
     }
     if (audit_entries.empty() || !updated_entries.empty()) {
-        Subnet6Collection subnets = getMgr().getPool()->getModifiedSubnets6(backend_selector,
-                                                                            server_selector,
-                                                                            lb_modification_time);
+        Subnet6Collection subnets;
+        if (audit_entries.empty()) {
+            subnets = getMgr().getPool()->getModifiedSubnets6(backend_selector,
+                                                              server_selector,
+                                                              lb_modification_time);
+        } else {
+            // Only fetch the subnets modified by the revisions starting
+            // with the oldest revision of the updated subnets rather than
+            // all the subnets modified since the last fetch time. The
+            // revisions can't be older than the last fetch time.
+            const auto& time_index = updated_entries.get<AuditEntryModificationTimeIdTag>();
+            auto first = time_index.begin();
+            subnets = getMgr().getPool()->getRecentSubnets6(backend_selector,
+                                                            server_selector,
+                                                            std::max(lb_modification_time,
+                                                                     (*first)->getModificationTime()),
+                                                            (*first)->getRevisionId());
+        }
+        fetched_objects_ += subnets.size();
         for (auto subnet = subnets.begin(); subnet != subnets.end(); ++subnet) {
             if (!audit_entries.empty() && !hasObjectId(updated_entries, (*subnet)->getID())) {
                 continue;
@@ -281,7 +314,9 @@ CBControlDHCPv6::databaseConfigApply(const db::BackendSelector& backend_selector
         auto const& cfg = CfgMgr::instance().getCurrentCfg();
         external_cfg->sanityChecksLifetime(*cfg, "preferred-lifetime");
         external_cfg->sanityChecksLifetime(*cfg, "valid-lifetime");
-        CfgMgr::instance().mergeIntoCurrentCfg(external_cfg->getSequence());
+        recounted_subnets_ +=
+            CfgMgr::instance().mergeIntoCurrentCfg(external_cfg->getSequence(),
+                                                   previous);
     }
     LOG_INFO(dhcpsrv_logger, DHCPSRV_CFGMGR_CONFIG6_MERGED);
 
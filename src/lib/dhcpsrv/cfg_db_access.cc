@@ -1,10 +1,11 @@
-// Copyright (C) 2016-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2016-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
 // file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 #include <config.h>
+#include <database/database_connection.h>
 #include <dhcpsrv/cfg_db_access.h>
 #include <dhcpsrv/db_type.h>
 #include <dhcpsrv/host_data_source_factory.h>
@@ -17,6 +18,7 @@
 #include <vector>
 
 using namespace isc::data;
+using namespace isc::db;
 
 namespace isc {
 namespace dhcp {
@@ -89,6 +91,30 @@ CfgDbAccess::createManagers() const {
     }
 }
 
+bool
+CfgDbAccess::sameLeases(const CfgDbAccess& other) const {
+    std::string lease_db_access = getLeaseDbAccessString();
+    if (lease_db_access != other.getLeaseDbAccessString()) {
+        return (false);
+    }
+
+    // The leases of a non persistent memfile database are lost when the
+    // lease manager is recreated.
+    DatabaseConnection::ParameterMap parameters;
+    try {
+        parameters = DatabaseConnection::parse(lease_db_access);
+    } catch (const std::exception&) {
+        return (false);
+    }
+    auto type = parameters.find("type");
+    auto persist = parameters.find("persist");
+    if ((type != parameters.end()) && (type->second == "memfile") &&
+        (persist != parameters.end()) && (persist->second == "false")) {
+        return (false);
+    }
+    return (true);
+}
+
 std::string
 CfgDbAccess::getAccessString(const std::string& access_string) const {
     std::ostringstream s;
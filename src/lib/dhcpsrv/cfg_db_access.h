@@ -1,4 +1,4 @@
-// Copyright (C) 2016-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2016-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -104,6 +104,16 @@ public:
     /// according to the configuration specified.
     void createManagers() const;
 
+    /// @brief Checks if another configuration uses the same leases.
+    ///
+    /// The leases are the same when the lease database access strings
+    /// are equal, unless the leases are held by a non persistent memfile
+    /// database which loses them when the lease manager is recreated.
+    ///
+    /// @param other The other configuration.
+    /// @return true if the leases of both configurations are the same.
+    bool sameLeases(const CfgDbAccess& other) const;
+
 protected:
 
     /// @brief Returns lease or host database access string.
@@ -1,4 +1,4 @@
-// Copyright (C) 2015,2017 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2015-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -50,6 +50,7 @@ CfgExpiration::CfgExpiration(const bool test_mode)
       max_reclaim_leases_(DEFAULT_MAX_RECLAIM_LEASES),
       max_reclaim_time_(DEFAULT_MAX_RECLAIM_TIME),
       unwarned_reclaim_cycles_(DEFAULT_UNWARNED_RECLAIM_CYCLES),
+      background_reclamation_(false),
       timer_mgr_(TimerMgr::instance()),
       test_mode_(test_mode) {
 }
@@ -134,6 +135,9 @@ CfgExpiration::toElement() const {
     result->set("unwarned-reclaim-cycles",
                 Element::create(static_cast<long long>
                                 (unwarned_reclaim_cycles_)));
+    // Set background-reclamation
+    result->set("background-reclamation",
+                Element::create(background_reclamation_));
     return (result);
 }
 
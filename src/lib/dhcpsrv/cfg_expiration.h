@@ -1,4 +1,4 @@
-// Copyright (C) 2015-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2015-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -55,6 +55,10 @@ namespace dhcp {
 ///   there are still expired leases in the database. If this value is 0,
 ///   the warning is never issued.
 ///
+/// - background-reclamation - indicates if the expired leases are reclaimed
+///   by a background thread instead of the reclamation timer. It is used
+///   only in multi-threading mode.
+///
 /// The @c CfgExpiration class provides a collection of accessors and
 /// modifiers to manage the data. Each accessor checks if the given value
 /// is in range allowed for this value.
@@ -188,6 +192,18 @@ public:
     /// @param unwarned_reclaim_cycles New value.
     void setUnwarnedReclaimCycles(const int64_t unwarned_reclaim_cycles);
 
+    /// @brief Returns background-reclamation.
+    bool getBackgroundReclamation() const {
+        return (background_reclamation_);
+    }
+
+    /// @brief Sets background-reclamation.
+    ///
+    /// @param background_reclamation New value.
+    void setBackgroundReclamation(const bool background_reclamation) {
+        background_reclamation_ = background_reclamation;
+    }
+
     /// @brief Setup timers for the reclamation of expired leases according
     /// to the configuration parameters.
     ///
@@ -216,13 +232,17 @@ public:
     /// the pointer to the @c AllocEngine. In case of unit tests it
     /// will be a pointer to some test class which provides stub
     /// implementation of the leases reclamation routines.
+    /// @param reclaim_timer false when the expired leases are reclaimed by
+    /// a background thread so only the timer removing the expired-reclaimed
+    /// leases is set up.
     /// @tparam Instance Instance of the object in which both functions
     /// are implemented.
     template<typename Instance>
     void setupTimers(void (Instance::*reclaim_fun)(const size_t, const uint16_t,
                                                    const bool, const uint16_t),
                      void (Instance::*delete_fun)(const uint32_t),
-                     Instance* instance_ptr) const;
+                     Instance* instance_ptr,
+                     const bool reclaim_timer = true) const;
 
     /// @brief Unparse a configuration object
     ///
@@ -262,6 +282,9 @@ private:
     /// @brief unwarned-reclaim-cycles.
     uint16_t unwarned_reclaim_cycles_;
 
+    /// @brief background-reclamation.
+    bool background_reclamation_;
+
     /// @brief Pointer to the instance of the Timer Manager.
     TimerMgrPtr timer_mgr_;
 
@@ -286,7 +309,8 @@ CfgExpiration::setupTimers(void (Instance::*reclaim_fun)(const size_t,
                                                          const bool,
                                                          const uint16_t),
                            void (Instance::*delete_fun)(const uint32_t),
-                           Instance* instance_ptr) const {
+                           Instance* instance_ptr,
+                           const bool reclaim_timer) const {
     // One of the parameters passed to the leases' reclamation routine
     // is a boolean value which indicates if reclaimed leases should
     // be removed by the leases' reclamation routine. This is the case
@@ -296,7 +320,7 @@ CfgExpiration::setupTimers(void (Instance::*reclaim_fun)(const size_t,
 
     // If the timer interval for the leases reclamation is non-zero
     // the timer will be scheduled.
-    if (getReclaimTimerWaitTime() > 0) {
+    if (reclaim_timer && (getReclaimTimerWaitTime() > 0)) {
         // In the test mode the interval is expressed in milliseconds.
         // If this is not the test mode, the interval is in seconds.
         const long reclaim_interval = test_mode_ ? getReclaimTimerWaitTime() :
@@ -1,4 +1,4 @@
-// Copyright (C) 2014-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2014-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -296,23 +296,27 @@ CfgHosts::getAllInternal(const Host::IdentifierType& identifier_type,
                          Storage& storage) const {
 
     // Convert host identifier into textual format for logging purposes.
-    // This conversion is exception free.
-    std::string identifier_text = Host::getIdentifierAsText(identifier_type,
-                                                            identifier,
-                                                            identifier_len);
+    // This conversion is exception free. It is skipped when the debug
+    // logging is disabled because this is a hot path.
+    std::string identifier_text;
+    if (hosts_logger.isDebugEnabled(HOSTS_DBG_TRACE)) {
+        identifier_text = Host::getIdentifierAsText(identifier_type,
+                                                    identifier,
+                                                    identifier_len);
+    }
     LOG_DEBUG(hosts_logger, HOSTS_DBG_TRACE, HOSTS_CFG_GET_ALL_IDENTIFIER)
         .arg(identifier_text);
 
-    // Use the identifier and identifier type as a composite key.
+    // Use the identifier and identifier type as a composite key. The
+    // identifier is not copied.
     const HostContainerIndex0& idx = hosts_.get<0>();
-    boost::tuple<const std::vector<uint8_t>, const Host::IdentifierType> t =
-        boost::make_tuple(std::vector<uint8_t>(identifier,
-                                               identifier + identifier_len),
-                                               identifier_type);
+    HostContainerIndex0Range r =
+        idx.equal_range(boost::make_tuple(HostIdentifierSpan(identifier,
+                                                             identifier_len),
+                                          identifier_type));
 
     // Append each Host object to the storage.
-    for (HostContainerIndex0::iterator host = idx.lower_bound(t);
-         host != idx.upper_bound(t);
+    for (HostContainerIndex0::iterator host = r.first; host != r.second;
          ++host) {
         LOG_DEBUG(hosts_logger, HOSTS_DBG_TRACE_DETAIL_DATA,
                   HOSTS_CFG_GET_ALL_IDENTIFIER_HOST)
@@ -890,45 +894,45 @@ CfgHosts::getHostInternal(const SubnetID& subnet_id, const bool subnet6,
         .arg(subnet_id)
         .arg(Host::getIdentifierAsText(identifier_type, identifier, identifier_len));
 
-    // Get all hosts for a specified identifier. This may return multiple hosts
-    // for different subnets, but the number of hosts returned should be low
-    // because one host presumably doesn't show up in many subnets.
-    HostCollection hosts;
-    getAllInternal<HostCollection>(identifier_type, identifier, identifier_len,
-                                   hosts);
-
+    // Search the hosts by identifier, identifier type and subnet id using
+    // the hashed index for the subnet family. The identifier is not copied.
     HostPtr host;
-    // Iterate over the returned hosts and select those for which the
-    // subnet id matches.
-    for (HostCollection::const_iterator host_it = hosts.begin();
-         host_it != hosts.end(); ++host_it) {
-        // Check if this is IPv4 subnet or IPv6 subnet.
-        SubnetID host_subnet_id = subnet6 ? (*host_it)->getIPv6SubnetID() :
-            (*host_it)->getIPv4SubnetID();
-
-        if (subnet_id == host_subnet_id) {
-            // If this is the first occurrence of the host for this subnet,
-            // remember it. But, if we find that this is second @c Host object
-            // for the same client, it is a misconfiguration. Most likely,
-            // the administrator has specified one reservation for a HW
-            // address and another one for the DUID, which gives an ambiguous
-            // result, and we don't know which reservation we should choose.
-            // Therefore, throw an exception.
-            if (!host) {
-                host = *host_it;
-
-            } else {
-                isc_throw(DuplicateHost,  "more than one reservation found"
-                          " for the host belonging to the subnet with id '"
-                          << subnet_id << "' and using the identifier '"
-                          << Host::getIdentifierAsText(identifier_type,
-                                                       identifier,
-                                                       identifier_len)
-                          << "'");
-            }
+    size_t count = 0;
+    auto const key = boost::make_tuple(HostIdentifierSpan(identifier,
+                                                          identifier_len),
+                                       identifier_type, subnet_id);
+    if (subnet6) {
+        const HostContainerIndex7& idx = hosts_.get<7>();
+        HostContainerIndex7Range r = idx.equal_range(key);
+        for (HostContainerIndex7::iterator it = r.first; it != r.second;
+             ++it, ++count) {
+            host = *it;
+        }
+
+    } else {
+        const HostContainerIndex6& idx = hosts_.get<6>();
+        HostContainerIndex6Range r = idx.equal_range(key);
+        for (HostContainerIndex6::iterator it = r.first; it != r.second;
+             ++it, ++count) {
+            host = *it;
         }
     }
 
+    // If we find more than one @c Host object for the same client, it is a
+    // misconfiguration. Most likely, the administrator has specified one
+    // reservation for a HW address and another one for the DUID, which gives
+    // an ambiguous result, and we don't know which reservation we should
+    // choose. Therefore, throw an exception.
+    if (count > 1) {
+        isc_throw(DuplicateHost,  "more than one reservation found"
+                  " for the host belonging to the subnet with id '"
+                  << subnet_id << "' and using the identifier '"
+                  << Host::getIdentifierAsText(identifier_type,
+                                               identifier,
+                                               identifier_len)
+                  << "'");
+    }
+
     if (host) {
         LOG_DEBUG(hosts_logger, HOSTS_DBG_RESULTS,
                   HOSTS_CFG_GET_ONE_SUBNET_ID_IDENTIFIER_HOST)
@@ -1,4 +1,4 @@
-// Copyright (C) 2014-2018 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2014-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -302,6 +302,11 @@ public:
         re_detect_ = re_detect;
     }
 
+    /// @brief Returns the re-detect flag
+    bool getReDetect() const {
+        return (re_detect_);
+    }
+
 private:
 
     /// @brief Checks if multiple IPv4 addresses has been activated on any
@@ -9,6 +9,7 @@
 #include <cc/data.h>
 #include <cc/simple_parser.h>
 #include <cfg_multi_threading.h>
+#include <dhcp/pkt_send_batcher.h>
 #include <util/multi_threading_mgr.h>
 
 using namespace isc::data;
@@ -47,5 +48,65 @@ CfgMultiThreading::extract(ConstElementPtr value, bool& enabled,
     }
 }
 
+bool
+CfgMultiThreading::receiverThreads(ConstElementPtr value) {
+    bool enabled = false;
+    uint32_t thread_count = 0;
+    uint32_t queue_size = 0;
+    CfgMultiThreading::extract(value, enabled, thread_count, queue_size);
+    if (!enabled || !value->get("receiver-threads")) {
+        return (false);
+    }
+    return (SimpleParser::getBoolean(value, "receiver-threads"));
+}
+
+uint32_t
+CfgMultiThreading::sendBatchSize(ConstElementPtr value) {
+    bool enabled = false;
+    uint32_t thread_count = 0;
+    uint32_t queue_size = 0;
+    CfgMultiThreading::extract(value, enabled, thread_count, queue_size);
+    if (!enabled || !value->get("send-batch-size")) {
+        return (0);
+    }
+    return (SimpleParser::getInteger(value, "send-batch-size"));
+}
+
+uint32_t
+CfgMultiThreading::sendBatchDelay(ConstElementPtr value) {
+    bool enabled = false;
+    uint32_t thread_count = 0;
+    uint32_t queue_size = 0;
+    CfgMultiThreading::extract(value, enabled, thread_count, queue_size);
+    if (!enabled || !value->get("send-batch-delay")) {
+        return (PktSendBatcher::DEFAULT_MAX_DELAY);
+    }
+    return (SimpleParser::getInteger(value, "send-batch-delay"));
+}
+
+bool
+CfgMultiThreading::backgroundConfigParsing(ConstElementPtr value) {
+    bool enabled = false;
+    uint32_t thread_count = 0;
+    uint32_t queue_size = 0;
+    CfgMultiThreading::extract(value, enabled, thread_count, queue_size);
+    if (!enabled || !value->get("background-config-parsing")) {
+        return (false);
+    }
+    return (SimpleParser::getBoolean(value, "background-config-parsing"));
+}
+
+uint32_t
+CfgMultiThreading::commandThreads(ConstElementPtr value) {
+    bool enabled = false;
+    uint32_t thread_count = 0;
+    uint32_t queue_size = 0;
+    CfgMultiThreading::extract(value, enabled, thread_count, queue_size);
+    if (!enabled || !value->get("command-threads")) {
+        return (0);
+    }
+    return (SimpleParser::getInteger(value, "command-threads"));
+}
+
 }  // namespace dhcp
 }  // namespace isc
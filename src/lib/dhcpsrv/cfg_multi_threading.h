@@ -1,4 +1,4 @@
-// Copyright (C) 2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2020-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -29,6 +29,53 @@ public:
     /// @param[out] queue_size The queue size
     static void extract(data::ConstElementPtr value, bool& enabled,
                         uint32_t& thread_count, uint32_t& queue_size);
+
+    /// @brief check if the packets are read by interface receiver threads
+    ///
+    /// The interface receiver threads feeding per thread queues are used
+    /// when multi-threading is enabled and its "receiver-threads" parameter
+    /// is true.
+    ///
+    /// @param value The multi-threading configuration
+    /// @return true if the interface receiver threads are used
+    static bool receiverThreads(data::ConstElementPtr value);
+
+    /// @brief get the number of sent packets of a batch
+    ///
+    /// The sent packets are batched when multi-threading is enabled and
+    /// its "send-batch-size" parameter is greater than 1.
+    ///
+    /// @param value The multi-threading configuration
+    /// @return the batch size, 0 when the packets are not batched
+    static uint32_t sendBatchSize(data::ConstElementPtr value);
+
+    /// @brief get the maximum delay of a sent packet in a batch
+    ///
+    /// @param value The multi-threading configuration
+    /// @return the "send-batch-delay" parameter in microseconds or its
+    /// default when multi-threading is disabled or it is not set
+    static uint32_t sendBatchDelay(data::ConstElementPtr value);
+
+    /// @brief check if the configuration is parsed by a background thread
+    ///
+    /// The new configuration is parsed by a background thread while the
+    /// packets are processed with the current configuration when
+    /// multi-threading is enabled and its "background-config-parsing"
+    /// parameter is true.
+    ///
+    /// @param value The multi-threading configuration
+    /// @return true if the configuration is parsed by a background thread
+    static bool backgroundConfigParsing(data::ConstElementPtr value);
+
+    /// @brief get the number of threads processing the thread safe commands
+    ///
+    /// The thread safe commands received over the control channel are
+    /// processed by a pool of threads when multi-threading is enabled and
+    /// its "command-threads" parameter is greater than 0.
+    ///
+    /// @param value The multi-threading configuration
+    /// @return the number of command threads, 0 when they are not used
+    static uint32_t commandThreads(data::ConstElementPtr value);
 };
 
 }  // namespace dhcp
@@ -15,10 +15,61 @@
 #include <asiolink/io_address.h>
 #include <asiolink/addr_utilities.h>
 #include <stats/stats_mgr.h>
+#include <set>
 #include <sstream>
 
 using namespace isc::asiolink;
 using namespace isc::data;
+using namespace isc::stats;
+
+namespace {
+
+/// @brief Removes the statistics of an IPv4 subnet.
+///
+/// @param subnet_id Identifier of the subnet.
+void
+removeSubnetStatistics(const isc::dhcp::SubnetID& subnet_id) {
+    StatsMgr& stats_mgr = StatsMgr::instance();
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
+                                         "total-addresses"));
+
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
+                                         "assigned-addresses"));
+
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
+                                         "cumulative-assigned-addresses"));
+
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
+                                         "declined-addresses"));
+
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
+                                         "reclaimed-declined-addresses"));
+
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
+                                         "reclaimed-leases"));
+}
+
+/// @brief Updates the configuration dependent statistics of an IPv4 subnet.
+///
+/// @param subnet The subnet.
+void
+updateSubnetStatistics(const isc::dhcp::Subnet4& subnet) {
+    StatsMgr& stats_mgr = StatsMgr::instance();
+    isc::dhcp::SubnetID subnet_id = subnet.getID();
+
+    stats_mgr.setValue(StatsMgr::
+                       generateName("subnet", subnet_id, "total-addresses"),
+                                    static_cast<int64_t>
+                                    (subnet.getPoolCapacity(isc::dhcp::Lease::
+                                                            TYPE_V4)));
+    const std::string& name =
+        StatsMgr::generateName("subnet", subnet_id, "cumulative-assigned-addresses");
+    if (!stats_mgr.getObservation(name)) {
+        stats_mgr.setValue(name, static_cast<int64_t>(0));
+    }
+}
+
+} // end of anonymous namespace
 
 namespace isc {
 namespace dhcp {
@@ -472,52 +523,29 @@ CfgSubnets4::selectSubnet(const IOAddress& address,
 
 void
 CfgSubnets4::removeStatistics() {
-    using namespace isc::stats;
-
     // For each v4 subnet currently configured, remove the statistic.
-    StatsMgr& stats_mgr = StatsMgr::instance();
     for (Subnet4Collection::const_iterator subnet4 = subnets_.begin();
          subnet4 != subnets_.end(); ++subnet4) {
-        SubnetID subnet_id = (*subnet4)->getID();
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
-                                             "total-addresses"));
-
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
-                                             "assigned-addresses"));
-
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
-                                             "cumulative-assigned-addresses"));
-
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
-                                             "declined-addresses"));
-
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
-                                             "reclaimed-declined-addresses"));
+        removeSubnetStatistics((*subnet4)->getID());
+    }
+}
 
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
-                                             "reclaimed-leases"));
+void
+CfgSubnets4::removeStatistics(const CfgSubnets4& next) {
+    // Keep the statistics of the subnets taken over by the next
+    // configuration.
+    for (auto const& subnet : subnets_) {
+        if (next.getBySubnetId(subnet->getID()) != subnet) {
+            removeSubnetStatistics(subnet->getID());
+        }
     }
 }
 
 void
 CfgSubnets4::updateStatistics() {
-    using namespace isc::stats;
-
-    StatsMgr& stats_mgr = StatsMgr::instance();
     for (Subnet4Collection::const_iterator subnet4 = subnets_.begin();
          subnet4 != subnets_.end(); ++subnet4) {
-        SubnetID subnet_id = (*subnet4)->getID();
-
-        stats_mgr.setValue(StatsMgr::
-                           generateName("subnet", subnet_id, "total-addresses"),
-                                        static_cast<int64_t>
-                                        ((*subnet4)->getPoolCapacity(Lease::
-                                                                     TYPE_V4)));
-        const std::string& name =
-            StatsMgr::generateName("subnet", subnet_id, "cumulative-assigned-addresses");
-        if (!stats_mgr.getObservation(name)) {
-            stats_mgr.setValue(name, static_cast<int64_t>(0));
-        }
+        updateSubnetStatistics(**subnet4);
     }
 
     // Only recount the stats if we have subnets.
@@ -526,6 +554,52 @@ CfgSubnets4::updateStatistics() {
     }
 }
 
+size_t
+CfgSubnets4::updateStatistics(const CfgSubnets4& previous) {
+    std::set<SubnetID> recount;
+    for (auto const& subnet : subnets_) {
+        updateSubnetStatistics(*subnet);
+        if (previous.getBySubnetId(subnet->getID()) != subnet) {
+            recount.insert(subnet->getID());
+        }
+    }
+
+    // Only recount the stats if we have subnets.
+    if (subnets_.begin() != subnets_.end()) {
+        LeaseMgrFactory::instance().recountLeaseStats4(recount);
+    }
+    return (recount.size());
+}
+
+void
+CfgSubnets4::setSubnetElement(const Subnet4Ptr& subnet,
+                              const ConstElementPtr& element) {
+    elements_[subnet->getID()] = std::make_pair(element, subnet);
+}
+
+Subnet4Ptr
+CfgSubnets4::getUnchangedSubnet(const SubnetID& subnet_id,
+                                const ConstElementPtr& element) const {
+    auto it = elements_.find(subnet_id);
+    if ((it == elements_.end()) || !element ||
+        !it->second.first->equals(*element)) {
+        return (Subnet4Ptr());
+    }
+
+    // The subnet may have been replaced or moved to a shared network
+    // since it was parsed.
+    Subnet4Ptr subnet = it->second.second;
+    if (getBySubnetId(subnet_id) != subnet) {
+        return (Subnet4Ptr());
+    }
+    SharedNetwork4Ptr network;
+    subnet->getSharedNetwork(network);
+    if (network) {
+        return (Subnet4Ptr());
+    }
+    return (subnet);
+}
+
 ElementPtr
 CfgSubnets4::toElement() const {
     ElementPtr result = Element::createList();
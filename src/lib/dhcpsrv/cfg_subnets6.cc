@@ -1,4 +1,4 @@
-// Copyright (C) 2014-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2014-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -11,14 +11,84 @@
 #include <dhcpsrv/cfg_subnets6.h>
 #include <dhcpsrv/dhcpsrv_log.h>
 #include <dhcpsrv/lease_mgr_factory.h>
+#include <dhcpsrv/shared_network.h>
 #include <dhcpsrv/subnet_id.h>
 #include <stats/stats_mgr.h>
 #include <boost/foreach.hpp>
 #include <string.h>
+#include <set>
 #include <sstream>
 
 using namespace isc::asiolink;
 using namespace isc::data;
+using namespace isc::stats;
+
+namespace {
+
+/// @brief Removes the statistics of an IPv6 subnet.
+///
+/// @param subnet_id Identifier of the subnet.
+void
+removeSubnetStatistics(const isc::dhcp::SubnetID& subnet_id) {
+    StatsMgr& stats_mgr = StatsMgr::instance();
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id, "total-nas"));
+
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
+                                         "assigned-nas"));
+
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
+                                         "cumulative-assigned-nas"));
+
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id, "total-pds"));
+
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
+                                         "assigned-pds"));
+
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
+                                         "cumulative-assigned-pds"));
+
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
+                                         "declined-addresses"));
+
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
+                                         "reclaimed-declined-addresses"));
+
+    stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
+                                         "reclaimed-leases"));
+}
+
+/// @brief Updates the configuration dependent statistics of an IPv6 subnet.
+///
+/// @param subnet The subnet.
+void
+updateSubnetStatistics(const isc::dhcp::Subnet6& subnet) {
+    StatsMgr& stats_mgr = StatsMgr::instance();
+    isc::dhcp::SubnetID subnet_id = subnet.getID();
+
+    stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
+                                              "total-nas"),
+                       static_cast<int64_t>
+                       (subnet.getPoolCapacity(isc::dhcp::Lease::TYPE_NA)));
+
+    stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
+                                              "total-pds"),
+                        static_cast<int64_t>
+                        (subnet.getPoolCapacity(isc::dhcp::Lease::TYPE_PD)));
+
+    const std::string& name_nas =
+        StatsMgr::generateName("subnet", subnet_id, "cumulative-assigned-nas");
+    if (!stats_mgr.getObservation(name_nas)) {
+        stats_mgr.setValue(name_nas, static_cast<int64_t>(0));
+    }
+
+    const std::string& name_pds =
+        StatsMgr::generateName("subnet", subnet_id, "cumulative-assigned-pds");
+    if (!stats_mgr.getObservation(name_pds)) {
+        stats_mgr.setValue(name_pds, static_cast<int64_t>(0));
+    }
+}
+
+} // end of anonymous namespace
 
 namespace isc {
 namespace dhcp {
@@ -383,77 +453,82 @@ CfgSubnets6::getSubnet(const SubnetID id) const {
 
 void
 CfgSubnets6::removeStatistics() {
-    using namespace isc::stats;
-
-    StatsMgr& stats_mgr = StatsMgr::instance();
     // For each v6 subnet currently configured, remove the statistics.
     for (Subnet6Collection::const_iterator subnet6 = subnets_.begin();
          subnet6 != subnets_.end(); ++subnet6) {
-        SubnetID subnet_id = (*subnet6)->getID();
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id, "total-nas"));
-
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
-                                             "assigned-nas"));
-
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
-                                             "cumulative-assigned-nas"));
-
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id, "total-pds"));
-
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
-                                             "assigned-pds"));
-
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
-                                             "cumulative-assigned-pds"));
-
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
-                                             "declined-addresses"));
-
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
-                                             "reclaimed-declined-addresses"));
+        removeSubnetStatistics((*subnet6)->getID());
+    }
+}
 
-        stats_mgr.del(StatsMgr::generateName("subnet", subnet_id,
-                                             "reclaimed-leases"));
+void
+CfgSubnets6::removeStatistics(const CfgSubnets6& next) {
+    // Keep the statistics of the subnets taken over by the next
+    // configuration.
+    for (auto const& subnet : subnets_) {
+        if (next.getBySubnetId(subnet->getID()) != subnet) {
+            removeSubnetStatistics(subnet->getID());
+        }
     }
 }
 
 void
 CfgSubnets6::updateStatistics() {
-    using namespace isc::stats;
-
-    StatsMgr& stats_mgr = StatsMgr::instance();
     // For each v6 subnet currently configured, calculate totals
     for (Subnet6Collection::const_iterator subnet6 = subnets_.begin();
          subnet6 != subnets_.end(); ++subnet6) {
-        SubnetID subnet_id = (*subnet6)->getID();
-
-        stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
-                                                  "total-nas"),
-                           static_cast<int64_t>
-                           ((*subnet6)->getPoolCapacity(Lease::TYPE_NA)));
-
-        stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
-                                                  "total-pds"),
-                            static_cast<int64_t>
-                            ((*subnet6)->getPoolCapacity(Lease::TYPE_PD)));
-
-        const std::string& name_nas =
-            StatsMgr::generateName("subnet", subnet_id, "cumulative-assigned-nas");
-        if (!stats_mgr.getObservation(name_nas)) {
-            stats_mgr.setValue(name_nas, static_cast<int64_t>(0));
-        }
+        updateSubnetStatistics(**subnet6);
+    }
 
-        const std::string& name_pds =
-            StatsMgr::generateName("subnet", subnet_id, "cumulative-assigned-pds");
-        if (!stats_mgr.getObservation(name_pds)) {
-            stats_mgr.setValue(name_pds, static_cast<int64_t>(0));
+    // Only recount the stats if we have subnets.
+    if (subnets_.begin() != subnets_.end()) {
+        LeaseMgrFactory::instance().recountLeaseStats6();
+    }
+}
+
+size_t
+CfgSubnets6::updateStatistics(const CfgSubnets6& previous) {
+    std::set<SubnetID> recount;
+    for (auto const& subnet : subnets_) {
+        updateSubnetStatistics(*subnet);
+        if (previous.getBySubnetId(subnet->getID()) != subnet) {
+            recount.insert(subnet->getID());
         }
     }
 
     // Only recount the stats if we have subnets.
     if (subnets_.begin() != subnets_.end()) {
-        LeaseMgrFactory::instance().recountLeaseStats6();
+        LeaseMgrFactory::instance().recountLeaseStats6(recount);
     }
+    return (recount.size());
+}
+
+void
+CfgSubnets6::setSubnetElement(const Subnet6Ptr& subnet,
+                              const ConstElementPtr& element) {
+    elements_[subnet->getID()] = std::make_pair(element, subnet);
+}
+
+Subnet6Ptr
+CfgSubnets6::getUnchangedSubnet(const SubnetID& subnet_id,
+                                const ConstElementPtr& element) const {
+    auto it = elements_.find(subnet_id);
+    if ((it == elements_.end()) || !element ||
+        !it->second.first->equals(*element)) {
+        return (Subnet6Ptr());
+    }
+
+    // The subnet may have been replaced or moved to a shared network
+    // since it was parsed.
+    Subnet6Ptr subnet = it->second.second;
+    if (getBySubnetId(subnet_id) != subnet) {
+        return (Subnet6Ptr());
+    }
+    SharedNetwork6Ptr network;
+    subnet->getSharedNetwork(network);
+    if (network) {
+        return (Subnet6Ptr());
+    }
+    return (subnet);
 }
 
 ElementPtr
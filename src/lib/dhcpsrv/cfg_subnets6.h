@@ -1,4 +1,4 @@
-// Copyright (C) 2014-2019 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2014-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -17,7 +17,9 @@
 #include <dhcpsrv/subnet_selector.h>
 #include <util/optional.h>
 #include <boost/shared_ptr.hpp>
+#include <map>
 #include <string>
+#include <utility>
 
 namespace isc {
 namespace dhcp {
@@ -256,6 +258,18 @@ public:
     /// they are not expected to change until the next reconfiguration event.
     void updateStatistics();
 
+    /// @brief Updates statistics after a reconfiguration.
+    ///
+    /// This method updates the statistics like @ref updateStatistics but
+    /// the lease statistics are recounted only for the subnets which were
+    /// not taken over from the previous configuration, i.e. the subnets
+    /// which are not the same objects in both configurations. The lease
+    /// statistics of the other subnets are kept.
+    ///
+    /// @param previous The previous configuration.
+    /// @return The number of subnets whose lease statistics were recounted.
+    size_t updateStatistics(const CfgSubnets6& previous);
+
     /// @brief Removes statistics.
     ///
     /// During commitment of a new configuration, we need to get rid of the old
@@ -264,6 +278,36 @@ public:
     /// configuration and also subnet-ids may change.
     void removeStatistics();
 
+    /// @brief Removes statistics before a reconfiguration.
+    ///
+    /// This method removes the statistics like @ref removeStatistics but
+    /// only for the subnets which are not taken over by the next
+    /// configuration.
+    ///
+    /// @param next The next configuration.
+    void removeStatistics(const CfgSubnets6& next);
+
+    /// @brief Records the configuration element a subnet was parsed from.
+    ///
+    /// The next configuration takes over the subnet when it is parsed from
+    /// an equal element (see @ref getUnchangedSubnet).
+    ///
+    /// @param subnet Pointer to the subnet.
+    /// @param element The configuration element of the subnet.
+    void setSubnetElement(const Subnet6Ptr& subnet,
+                          const isc::data::ConstElementPtr& element);
+
+    /// @brief Returns a subnet which was parsed from an equal element.
+    ///
+    /// @param subnet_id Identifier of the subnet.
+    /// @param element The configuration element of the subnet.
+    /// @return Pointer to the subnet with this identifier if it is still in
+    /// this configuration, does not belong to a shared network and was
+    /// parsed from an element equal to the given one, null pointer
+    /// otherwise.
+    Subnet6Ptr getUnchangedSubnet(const SubnetID& subnet_id,
+                                  const isc::data::ConstElementPtr& element) const;
+
     /// @brief Unparse a configuration object
     ///
     /// @return a pointer to unparsed configuration
@@ -322,6 +366,9 @@ private:
     /// @brief A container for IPv6 subnets.
     Subnet6Collection subnets_;
 
+    /// @brief Configuration elements of the subnets by subnet identifier.
+    std::map<SubnetID, std::pair<isc::data::ConstElementPtr, Subnet6Ptr> > elements_;
+
 };
 
 /// @name Pointer to the @c CfgSubnets6 objects.
@@ -6,10 +6,12 @@
 
 #include <config.h>
 #include <asiolink/io_address.h>
+#include <dhcp/classify.h>
 #include <dhcp/iface_mgr.h>
 #include <dhcp/libdhcp++.h>
 #include <dhcpsrv/cfgmgr.h>
 #include <dhcpsrv/dhcpsrv_log.h>
+#include <util/stopwatch.h>
 #include <sstream>
 #include <string>
 
@@ -69,7 +71,10 @@ CfgMgr::getD2ClientMgr() {
 
 void
 CfgMgr::ensureCurrentAllocated() {
-    if (!configuration_ || configs_.empty()) {
+    // Only the current configuration is checked so the packet processing
+    // threads getting it do not race with a background configuration
+    // parsing adding the staging configuration to the list.
+    if (!configuration_) {
         configuration_.reset(new SrvConfig());
         configs_.push_back(configuration_);
     }
@@ -79,6 +84,7 @@ void
 CfgMgr::clear() {
     if (configuration_) {
         configuration_->removeStatistics();
+        configuration_.reset();
     }
     configs_.clear();
     external_configs_.clear();
@@ -90,10 +96,22 @@ void
 CfgMgr::commit() {
     ensureCurrentAllocated();
 
+    // The new configuration takes over the subnets which did not change
+    // from the current one. Their statistics are kept, unless the leases
+    // the statistics were counted from change too.
+    SrvConfigPtr previous = configuration_;
+    bool keep_statistics = !configs_.back()->sequenceEquals(*configuration_) &&
+        configs_.back()->getCfgDbAccess()->sameLeases(*configuration_->getCfgDbAccess());
+    Stopwatch stopwatch;
+
     // First we need to remove statistics. The new configuration can have fewer
     // subnets. Also, it may change subnet-ids. So we need to remove them all
     // and add it back.
-    configuration_->removeStatistics();
+    if (keep_statistics) {
+        configuration_->removeStatistics(*configs_.back());
+    } else {
+        configuration_->removeStatistics();
+    }
 
     if (!configs_.back()->sequenceEquals(*configuration_)) {
         configuration_ = configs_.back();
@@ -111,9 +129,23 @@ CfgMgr::commit() {
     configuration_->setLastCommitTime(now);
 
     // Now we need to set the statistics back.
-    configuration_->updateStatistics();
+    if (keep_statistics) {
+        size_t recounted = configuration_->updateStatistics(*previous);
+        size_t subnets = configuration_->getCfgSubnets4()->getAll()->size() +
+            configuration_->getCfgSubnets6()->getAll()->size();
+        stopwatch.stop();
+        LOG_INFO(dhcpsrv_logger, DHCPSRV_CFGMGR_STATISTICS_KEPT)
+            .arg(subnets - recounted)
+            .arg(recounted)
+            .arg(stopwatch.logFormatLastDuration());
+    } else {
+        configuration_->updateStatistics();
+    }
 
     configuration_->configureLowerLevelLibraries();
+
+    // Publish the client class names interned by the new configuration.
+    ClientClassRegistry::instance().commit();
 }
 
 void
@@ -122,6 +154,10 @@ CfgMgr::rollback() {
     if (!configuration_->sequenceEquals(*configs_.back())) {
         configs_.pop_back();
     }
+
+    // The client class names interned by the discarded configuration are
+    // published too so the lookups no longer need the staging names.
+    ClientClassRegistry::instance().commit();
 }
 
 void
@@ -206,6 +242,21 @@ CfgMgr::mergeIntoCurrentCfg(const uint32_t seq) {
     getCurrentCfg()->updateStatistics();
 }
 
+size_t
+CfgMgr::mergeIntoCurrentCfg(const uint32_t seq, SrvConfig& previous) {
+    try {
+        mergeIntoCfg(getCurrentCfg(), seq);
+
+    } catch (...) {
+        // Make sure the statistics is updated even if the merge failed.
+        previous.removeStatistics(*getCurrentCfg());
+        getCurrentCfg()->updateStatistics(previous);
+        throw;
+    }
+    previous.removeStatistics(*getCurrentCfg());
+    return (getCurrentCfg()->updateStatistics(previous));
+}
+
 void
 CfgMgr::mergeIntoCfg(const SrvConfigPtr& target_config, const uint32_t seq) {
     auto source_config = external_configs_.find(seq);
@@ -269,6 +269,23 @@ public:
     /// number doesn't exist.
     void mergeIntoCurrentCfg(const uint32_t seq);
 
+    /// @brief Merges external configuration with the given sequence number
+    /// into the current configuration keeping the unchanged statistics.
+    ///
+    /// Used by the configuration backend updates. Unlike the other variant
+    /// which removes and recounts the statistics of all the subnets, only
+    /// the statistics of the subnets which were added, replaced or deleted
+    /// since the given previous configuration are removed and recounted.
+    ///
+    /// @param seq Source configuration sequence number.
+    /// @param previous Configuration holding the subnets of the current
+    /// configuration before the update.
+    /// @return The number of subnets whose lease statistics were recounted.
+    ///
+    /// @throw BadValue if the external configuration with the given sequence
+    /// number doesn't exist.
+    size_t mergeIntoCurrentCfg(const uint32_t seq, SrvConfig& previous);
+
     //@}
 
     /// @brief Sets address family (AF_INET or AF_INET6)
@@ -34,6 +34,9 @@ ClientClassDef::ClientClassDef(const std::string& name,
         isc_throw(BadValue, "Client Class name cannot be blank");
     }
 
+    // Intern the name so the membership of the class is a bit test.
+    static_cast<void>(ClientClassRegistry::instance().intern(name_));
+
     // We permit an empty expression for now.  This will likely be useful
     // for automatic classes such as vendor class.
     // For classes without options, make sure we have an empty collection
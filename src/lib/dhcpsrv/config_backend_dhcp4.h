@@ -147,6 +147,32 @@ public:
     getModifiedSubnets4(const db::ServerSelector& server_selector,
                         const boost::posix_time::ptime& modification_time) const = 0;
 
+    /// @brief Retrieves subnets modified by recent audit revisions.
+    ///
+    /// Unlike @c getModifiedSubnets4, which compares the modification
+    /// time of the subnets, this selects the subnets for which an audit
+    /// entry was recorded by the audit revisions starting at the given
+    /// revision, i.e. only the subnets the configuration updates changed.
+    ///
+    /// Allowed server selectors: UNASSIGNED, ALL, ONE, MULTIPLE.
+    /// Not allowed server selector: ANY.
+    ///
+    /// The default implementation, used by the backends in this tree,
+    /// returns the subnets modified at or after the time of the first
+    /// revision, see @c getModifiedSubnets4.
+    ///
+    /// @param server_selector Server selector.
+    /// @param modification_time Modification time of the first audit
+    /// revision.
+    /// @param modification_id Identifier of the first audit revision.
+    /// @return Collection of subnets or empty collection if no subnet found.
+    virtual Subnet4Collection
+    getRecentSubnets4(const db::ServerSelector& server_selector,
+                      const boost::posix_time::ptime& modification_time,
+                      const uint64_t& /* modification_id */) const {
+        return (getModifiedSubnets4(server_selector, modification_time));
+    }
+
     /// @brief Retrieves shared network by name.
     ///
     /// Allowed server selectors: ANY, UNASSIGNED, ALL, ONE.
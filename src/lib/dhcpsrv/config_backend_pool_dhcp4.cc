@@ -57,6 +57,19 @@ ConfigBackendPoolDHCPv4::getModifiedSubnets4(const BackendSelector& backend_sele
     return (subnets);
 }
 
+Subnet4Collection
+ConfigBackendPoolDHCPv4::getRecentSubnets4(const BackendSelector& backend_selector,
+                                           const ServerSelector& server_selector,
+                                           const boost::posix_time::ptime& modification_time,
+                                           const uint64_t& modification_id) const {
+    Subnet4Collection subnets;
+    getMultiplePropertiesConst<Subnet4Collection, const boost::posix_time::ptime&,
+                               const uint64_t&>
+        (&ConfigBackendDHCPv4::getRecentSubnets4, backend_selector, server_selector,
+         subnets, modification_time, modification_id);
+    return (subnets);
+}
+
 Subnet4Collection
 ConfigBackendPoolDHCPv4::getSharedNetworkSubnets4(const db::BackendSelector& backend_selector,
                                                   const db::ServerSelector& server_selector,
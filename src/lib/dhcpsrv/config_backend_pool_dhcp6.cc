@@ -57,6 +57,19 @@ ConfigBackendPoolDHCPv6::getModifiedSubnets6(const BackendSelector& backend_sele
     return (subnets);
 }
 
+Subnet6Collection
+ConfigBackendPoolDHCPv6::getRecentSubnets6(const BackendSelector& backend_selector,
+                                           const ServerSelector& server_selector,
+                                           const boost::posix_time::ptime& modification_time,
+                                           const uint64_t& modification_id) const {
+    Subnet6Collection subnets;
+    getMultiplePropertiesConst<Subnet6Collection, const boost::posix_time::ptime&,
+                               const uint64_t&>
+        (&ConfigBackendDHCPv6::getRecentSubnets6, backend_selector, server_selector,
+         subnets, modification_time, modification_id);
+    return (subnets);
+}
+
 Subnet6Collection
 ConfigBackendPoolDHCPv6::getSharedNetworkSubnets6(const db::BackendSelector& backend_selector,
                                                   const db::ServerSelector& server_selector,
@@ -74,6 +74,20 @@ public:
                         const db::ServerSelector& server_selector,
                         const boost::posix_time::ptime& modification_time) const;
 
+    /// @brief Retrieves subnets modified by recent audit revisions.
+    ///
+    /// @param backend_selector Backend selector.
+    /// @param server_selector Server selector.
+    /// @param modification_time Modification time of the first audit
+    /// revision.
+    /// @param modification_id Identifier of the first audit revision.
+    /// @return Collection of subnets or empty collection if no subnet found.
+    virtual Subnet6Collection
+    getRecentSubnets6(const db::BackendSelector& backend_selector,
+                      const db::ServerSelector& server_selector,
+                      const boost::posix_time::ptime& modification_time,
+                      const uint64_t& modification_id) const;
+
     /// @brief Retrieves all subnets belonging to a specified shared network.
     ///
     /// @param backend_selector Backend selector.
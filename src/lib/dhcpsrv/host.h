@@ -563,6 +563,7 @@ public:
     /// @param hostname New hostname.
     void setHostname(const std::string& hostname) {
         hostname_ = hostname;
+        lower_hostname_ = boost::algorithm::to_lower_copy(hostname);
     }
 
     /// @brief Returns reserved hostname.
@@ -571,8 +572,12 @@ public:
     }
 
     /// @brief Returns reserved hostname in lower case.
-    std::string getLowerHostname() const {
-        return (boost::algorithm::to_lower_copy(hostname_));
+    ///
+    /// The lower case hostname is computed when the hostname is set, so
+    /// it can be used as a key in the host containers without converting
+    /// the hostname at each comparison.
+    const std::string& getLowerHostname() const {
+        return (lower_hostname_);
     }
 
     /// @brief Adds new client class for DHCPv4.
@@ -745,6 +750,8 @@ private:
     IPv6ResrvCollection ipv6_reservations_;
     /// @brief Name reserved for the host.
     std::string hostname_;
+    /// @brief Name reserved for the host in lower case.
+    std::string lower_hostname_;
     /// @brief Collection of classes associated with a DHCPv4 client.
     ClientClasses dhcp4_client_classes_;
     /// @brief Collection of classes associated with a DHCPv6 client.
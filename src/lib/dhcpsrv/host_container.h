@@ -15,10 +15,130 @@
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index/hashed_index.hpp>
+#include <boost/functional/hash.hpp>
+#include <algorithm>
+#include <functional>
+#include <vector>
 
 namespace isc {
 namespace dhcp {
 
+/// @brief Host identifier given as a pointer to its binary value and a length.
+///
+/// It is used to search the @c HostContainer for hosts using an identifier
+/// received in a packet without copying it into a vector.
+struct HostIdentifierSpan {
+
+    /// @brief Constructor.
+    ///
+    /// @param data Pointer to the binary identifier value.
+    /// @param len Identifier length.
+    HostIdentifierSpan(const uint8_t* data, const size_t len)
+        : data_(data), len_(len) {
+    }
+
+    /// @brief Returns pointer to the first byte of the identifier.
+    const uint8_t* begin() const {
+        return (data_);
+    }
+
+    /// @brief Returns pointer past the last byte of the identifier.
+    const uint8_t* end() const {
+        return (data_ + len_);
+    }
+
+    /// @brief Pointer to the binary identifier value.
+    const uint8_t* data_;
+
+    /// @brief Identifier length.
+    size_t len_;
+};
+
+/// @brief Compares host identifiers stored in hosts with identifiers given
+/// as vectors or spans.
+struct HostIdentifierLess {
+
+    /// @brief Compares two identifiers lexicographically.
+    ///
+    /// @param a First identifier.
+    /// @param b Second identifier.
+    /// @tparam A Type of the first identifier (vector or span).
+    /// @tparam B Type of the second identifier (vector or span).
+    ///
+    /// @return true if the first identifier is lower than the second one.
+    template<typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+        return (std::lexicographical_compare(a.begin(), a.end(),
+                                             b.begin(), b.end()));
+    }
+};
+
+/// @brief Checks equality of host identifiers given as vectors or spans.
+struct HostIdentifierEqual {
+
+    /// @brief Checks if two identifiers are equal.
+    ///
+    /// @param a First identifier.
+    /// @param b Second identifier.
+    /// @tparam A Type of the first identifier (vector or span).
+    /// @tparam B Type of the second identifier (vector or span).
+    ///
+    /// @return true if the identifiers are equal.
+    template<typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+        return ((std::distance(a.begin(), a.end()) ==
+                 std::distance(b.begin(), b.end())) &&
+                std::equal(a.begin(), a.end(), b.begin()));
+    }
+};
+
+/// @brief Hashes host identifiers given as vectors or spans.
+///
+/// The same identifier gets the same hash whether it is given as a vector
+/// or as a span.
+struct HostIdentifierHash {
+
+    /// @brief Computes the hash of an identifier.
+    ///
+    /// @param id Identifier.
+    /// @tparam Identifier Type of the identifier (vector or span).
+    ///
+    /// @return Hash value of the identifier.
+    template<typename Identifier>
+    size_t operator()(const Identifier& id) const {
+        return (boost::hash_range(id.begin(), id.end()));
+    }
+};
+
+/// @brief Composite key extracting the identifier, the identifier type and
+/// the given subnet identifier from a host.
+///
+/// @tparam SubnetIdGetter Host method returning the IPv4 or IPv6 subnet id.
+template<SubnetID (Host::*SubnetIdGetter)() const>
+struct HostIdentifierSubnetKey : public boost::multi_index::composite_key<
+    Host,
+    boost::multi_index::const_mem_fun<Host, const std::vector<uint8_t>&,
+                                      &Host::getIdentifier>,
+    boost::multi_index::const_mem_fun<Host, Host::IdentifierType,
+                                      &Host::getIdentifierType>,
+    boost::multi_index::const_mem_fun<Host, SubnetID, SubnetIdGetter>
+> {
+};
+
+/// @brief Hash of the @c HostIdentifierSubnetKey.
+typedef boost::multi_index::composite_key_hash<
+    HostIdentifierHash,
+    boost::hash<Host::IdentifierType>,
+    boost::hash<SubnetID>
+> HostIdentifierSubnetHash;
+
+/// @brief Equality predicate of the @c HostIdentifierSubnetKey.
+typedef boost::multi_index::composite_key_equal_to<
+    HostIdentifierEqual,
+    std::equal_to<Host::IdentifierType>,
+    std::equal_to<SubnetID>
+> HostIdentifierSubnetEqual;
+
 /// @brief Multi-index container holding host reservations.
 ///
 /// This container holds a collection of @c Host objects which can be retrieved
@@ -58,6 +178,12 @@ typedef boost::multi_index_container<
                     Host, Host::IdentifierType,
                     &Host::getIdentifierType
                 >
+            >,
+            // The identifier comparison accepts a @c HostIdentifierSpan
+            // so as the lookups don't have to copy the identifier.
+            boost::multi_index::composite_key_compare<
+                HostIdentifierLess,
+                std::less<Host::IdentifierType>
             >
         >,
 
@@ -94,8 +220,25 @@ typedef boost::multi_index_container<
         // (case-sensitive compare so the key is in lower case).
         boost::multi_index::ordered_non_unique<
             // Index using values returned by the @c Host::getLowerHostname
-            boost::multi_index::const_mem_fun<Host, std::string,
+            boost::multi_index::const_mem_fun<Host, const std::string&,
                                               &Host::getLowerHostname>
+        >,
+
+        // Seventh index is used to search for the host using the identifier,
+        // identifier type and IPv4 subnet id. It is hashed because this
+        // is the lookup made for each DHCPv4 query.
+        boost::multi_index::hashed_non_unique<
+            HostIdentifierSubnetKey<&Host::getIPv4SubnetID>,
+            HostIdentifierSubnetHash,
+            HostIdentifierSubnetEqual
+        >,
+
+        // Eighth index is used to search for the host using the identifier,
+        // identifier type and IPv6 subnet id.
+        boost::multi_index::hashed_non_unique<
+            HostIdentifierSubnetKey<&Host::getIPv6SubnetID>,
+            HostIdentifierSubnetHash,
+            HostIdentifierSubnetEqual
         >
     >
 > HostContainer;
@@ -154,6 +297,30 @@ typedef std::pair<HostContainerIndex4::iterator,
 /// This index allows for searching for @c Host objects using a hostname.
 typedef HostContainer::nth_index<5>::type HostContainerIndex5;
 
+/// @brief Results range returned using the @c HostContainerIndex5.
+typedef std::pair<HostContainerIndex5::iterator,
+                  HostContainerIndex5::iterator> HostContainerIndex5Range;
+
+/// @brief Seventh index type in the @c HostContainer.
+///
+/// This index allows for searching for @c Host objects using an
+/// identifier + identifier type + IPv4 subnet id tuple.
+typedef HostContainer::nth_index<6>::type HostContainerIndex6;
+
+/// @brief Results range returned using the @c HostContainerIndex6.
+typedef std::pair<HostContainerIndex6::iterator,
+                  HostContainerIndex6::iterator> HostContainerIndex6Range;
+
+/// @brief Eighth index type in the @c HostContainer.
+///
+/// This index allows for searching for @c Host objects using an
+/// identifier + identifier type + IPv6 subnet id tuple.
+typedef HostContainer::nth_index<7>::type HostContainerIndex7;
+
+/// @brief Results range returned using the @c HostContainerIndex7.
+typedef std::pair<HostContainerIndex7::iterator,
+                  HostContainerIndex7::iterator> HostContainerIndex7Range;
+
 /// @brief Defines one entry for the Host Container for v6 hosts
 ///
 /// It's essentially a pair of (IPv6 reservation, Host pointer).
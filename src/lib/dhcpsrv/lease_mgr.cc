@@ -1,4 +1,4 @@
-// Copyright (C) 2012-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2012-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -7,6 +7,7 @@
 #include <config.h>
 
 #include <dhcpsrv/cfgmgr.h>
+#include <dhcpsrv/dhcpsrv_exceptions.h>
 #include <dhcpsrv/dhcpsrv_log.h>
 #include <dhcpsrv/lease_mgr.h>
 #include <exceptions/exceptions.h>
@@ -19,6 +20,7 @@
 #include <iostream>
 #include <iterator>
 #include <map>
+#include <set>
 #include <sstream>
 #include <string>
 
@@ -63,6 +65,122 @@ LeaseMgr::getLease6(Lease::Type type, const DUID& duid,
     return (*col.begin());
 }
 
+Lease4Collection
+LeaseMgr::addLeases(const Lease4Collection& leases) {
+    Lease4Collection not_added;
+    for (auto lease : leases) {
+        if (!addLease(lease)) {
+            not_added.push_back(lease);
+        }
+    }
+    return (not_added);
+}
+
+Lease6Collection
+LeaseMgr::addLeases(const Lease6Collection& leases) {
+    Lease6Collection not_added;
+    for (auto lease : leases) {
+        if (!addLease(lease)) {
+            not_added.push_back(lease);
+        }
+    }
+    return (not_added);
+}
+
+Lease4Collection
+LeaseMgr::updateLeases(const Lease4Collection& leases) {
+    Lease4Collection not_updated;
+    for (auto lease : leases) {
+        try {
+            updateLease4(lease);
+        } catch (const NoSuchLease&) {
+            not_updated.push_back(lease);
+        }
+    }
+    return (not_updated);
+}
+
+Lease6Collection
+LeaseMgr::updateLeases(const Lease6Collection& leases) {
+    Lease6Collection not_updated;
+    for (auto lease : leases) {
+        try {
+            updateLease6(lease);
+        } catch (const NoSuchLease&) {
+            not_updated.push_back(lease);
+        }
+    }
+    return (not_updated);
+}
+
+Lease4Collection
+LeaseMgr::deleteLeases(const Lease4Collection& leases) {
+    Lease4Collection not_deleted;
+    for (auto lease : leases) {
+        if (!deleteLease(lease)) {
+            not_deleted.push_back(lease);
+        }
+    }
+    return (not_deleted);
+}
+
+Lease6Collection
+LeaseMgr::deleteLeases(const Lease6Collection& leases) {
+    Lease6Collection not_deleted;
+    for (auto lease : leases) {
+        if (!deleteLease(lease)) {
+            not_deleted.push_back(lease);
+        }
+    }
+    return (not_deleted);
+}
+
+void
+LeaseMgr::walkLeases4(const Lease4Callback& callback) const {
+    for (auto const& lease : getLeases4()) {
+        callback(*lease);
+    }
+}
+
+void
+LeaseMgr::walkLeases4(SubnetID subnet_id, const Lease4Callback& callback) const {
+    for (auto const& lease : getLeases4(subnet_id)) {
+        callback(*lease);
+    }
+}
+
+void
+LeaseMgr::walkLeases4(const asiolink::IOAddress& lower_bound_address,
+                      const LeasePageSize& page_size,
+                      const Lease4Callback& callback) const {
+    for (auto const& lease : getLeases4(lower_bound_address, page_size)) {
+        callback(*lease);
+    }
+}
+
+void
+LeaseMgr::walkLeases6(const Lease6Callback& callback) const {
+    for (auto const& lease : getLeases6()) {
+        callback(*lease);
+    }
+}
+
+void
+LeaseMgr::walkLeases6(SubnetID subnet_id, const Lease6Callback& callback) const {
+    for (auto const& lease : getLeases6(subnet_id)) {
+        callback(*lease);
+    }
+}
+
+void
+LeaseMgr::walkLeases6(const asiolink::IOAddress& lower_bound_address,
+                      const LeasePageSize& page_size,
+                      const Lease6Callback& callback) const {
+    for (auto const& lease : getLeases6(lower_bound_address, page_size)) {
+        callback(*lease);
+    }
+}
+
 void
 LeaseMgr::recountLeaseStats4() {
     using namespace stats;
@@ -80,6 +198,86 @@ LeaseMgr::recountLeaseStats4() {
     // "cumulative-assigned-addresses") never get zeroed.
     int64_t zero = 0;
     stats_mgr.setValue("declined-addresses", zero);
+    initGlobalLeaseStats4();
+
+    // Clear subnet level stats.  This ensures we don't end up with corner
+    // cases that leave stale values in place.
+    const Subnet4Collection* subnets =
+        CfgMgr::instance().getCurrentCfg()->getCfgSubnets4()->getAll();
+
+    for (Subnet4Collection::const_iterator subnet = subnets->begin();
+         subnet != subnets->end(); ++subnet) {
+        clearSubnetLeaseStats4((*subnet)->getID());
+    }
+
+    // Get counts per state per subnet. Iterate over the result set
+    // updating the subnet and global values.
+    LeaseStatsRow row;
+    while (query->getNextRow(row)) {
+        addSubnetLeaseStats4(row);
+        if (row.lease_state_ == Lease::STATE_DECLINED) {
+            // Add to the global value.
+            stats_mgr.addValue("declined-addresses", row.state_count_);
+        }
+    }
+}
+
+void
+LeaseMgr::recountLeaseStats4(const std::set<SubnetID>& subnet_ids) {
+    using namespace stats;
+
+    StatsMgr& stats_mgr = StatsMgr::instance();
+
+    if (!subnet_ids.empty()) {
+        // Query the range of the subnets to recount.
+        LeaseStatsQueryPtr query;
+        if (subnet_ids.size() == 1) {
+            query = startSubnetLeaseStatsQuery4(*subnet_ids.begin());
+        } else {
+            query = startSubnetRangeLeaseStatsQuery4(*subnet_ids.begin(),
+                                                     *subnet_ids.rbegin());
+        }
+        if (!query) {
+            // The backend does not support subnet queries.
+            recountLeaseStats4();
+            return;
+        }
+
+        initGlobalLeaseStats4();
+        for (auto const& subnet_id : subnet_ids) {
+            clearSubnetLeaseStats4(subnet_id);
+        }
+
+        LeaseStatsRow row;
+        while (query->getNextRow(row)) {
+            if (subnet_ids.count(row.subnet_id_)) {
+                addSubnetLeaseStats4(row);
+            }
+        }
+    }
+
+    // The global declined addresses are the sum of the subnet ones.
+    int64_t declined = 0;
+    const Subnet4Collection* subnets =
+        CfgMgr::instance().getCurrentCfg()->getCfgSubnets4()->getAll();
+    for (auto const& subnet : *subnets) {
+        ObservationPtr declined_obs =
+            stats_mgr.getObservation(StatsMgr::generateName("subnet",
+                                                            subnet->getID(),
+                                                            "declined-addresses"));
+        if (declined_obs) {
+            declined += declined_obs->getInteger().first;
+        }
+    }
+    stats_mgr.setValue("declined-addresses", declined);
+}
+
+void
+LeaseMgr::initGlobalLeaseStats4() {
+    using namespace stats;
+
+    StatsMgr& stats_mgr = StatsMgr::instance();
+    int64_t zero = 0;
 
     // Create if it does not exit reclaimed declined leases global stats.
     if (!stats_mgr.getObservation("reclaimed-declined-addresses")) {
@@ -95,66 +293,64 @@ LeaseMgr::recountLeaseStats4() {
     if (!stats_mgr.getObservation("cumulative-assigned-addresses")) {
         stats_mgr.setValue("cumulative-assigned-addresses", zero);
     }
+}
 
-    // Clear subnet level stats.  This ensures we don't end up with corner
-    // cases that leave stale values in place.
-    const Subnet4Collection* subnets =
-        CfgMgr::instance().getCurrentCfg()->getCfgSubnets4()->getAll();
+void
+LeaseMgr::clearSubnetLeaseStats4(const SubnetID& subnet_id) {
+    using namespace stats;
 
-    for (Subnet4Collection::const_iterator subnet = subnets->begin();
-         subnet != subnets->end(); ++subnet) {
-        SubnetID subnet_id = (*subnet)->getID();
-        stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
-                                                  "assigned-addresses"),
-                           zero);
+    StatsMgr& stats_mgr = StatsMgr::instance();
+    int64_t zero = 0;
 
-        stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
-                                                  "declined-addresses"),
-                           zero);
-
-        if (!stats_mgr.getObservation(
-                StatsMgr::generateName("subnet", subnet_id,
-                                       "reclaimed-declined-addresses"))) {
-            stats_mgr.setValue(
-                StatsMgr::generateName("subnet", subnet_id,
-                                       "reclaimed-declined-addresses"),
-                zero);
-        }
+    stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
+                                              "assigned-addresses"),
+                       zero);
+
+    stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
+                                              "declined-addresses"),
+                       zero);
+
+    if (!stats_mgr.getObservation(
+            StatsMgr::generateName("subnet", subnet_id,
+                                   "reclaimed-declined-addresses"))) {
+        stats_mgr.setValue(
+            StatsMgr::generateName("subnet", subnet_id,
+                                   "reclaimed-declined-addresses"),
+            zero);
+    }
 
-        if (!stats_mgr.getObservation(
-                StatsMgr::generateName("subnet", subnet_id,
-                                       "reclaimed-leases"))) {
-            stats_mgr.setValue(
-                StatsMgr::generateName("subnet", subnet_id,
-                                       "reclaimed-leases"),
-                zero);
-        }
+    if (!stats_mgr.getObservation(
+            StatsMgr::generateName("subnet", subnet_id,
+                                   "reclaimed-leases"))) {
+        stats_mgr.setValue(
+            StatsMgr::generateName("subnet", subnet_id,
+                                   "reclaimed-leases"),
+            zero);
     }
+}
 
-    // Get counts per state per subnet. Iterate over the result set
-    // updating the subnet and global values.
-    LeaseStatsRow row;
-    while (query->getNextRow(row)) {
-        if (row.lease_state_ == Lease::STATE_DEFAULT) {
-            // Add to subnet level value.
-            stats_mgr.addValue(StatsMgr::generateName("subnet", row.subnet_id_,
-                                                      "assigned-addresses"),
-                               row.state_count_);
-        } else if (row.lease_state_ == Lease::STATE_DECLINED) {
-            // Set subnet level value.
-            stats_mgr.setValue(StatsMgr::generateName("subnet", row.subnet_id_,
-                                                      "declined-addresses"),
-                               row.state_count_);
+void
+LeaseMgr::addSubnetLeaseStats4(const LeaseStatsRow& row) {
+    using namespace stats;
 
-            // Add to the global value.
-            stats_mgr.addValue("declined-addresses", row.state_count_);
+    StatsMgr& stats_mgr = StatsMgr::instance();
 
-            // Add to subnet level value.
-            // Declined leases also count as assigned.
-            stats_mgr.addValue(StatsMgr::generateName("subnet", row.subnet_id_,
-                                                      "assigned-addresses"),
-                               row.state_count_);
-        }
+    if (row.lease_state_ == Lease::STATE_DEFAULT) {
+        // Add to subnet level value.
+        stats_mgr.addValue(StatsMgr::generateName("subnet", row.subnet_id_,
+                                                  "assigned-addresses"),
+                           row.state_count_);
+    } else if (row.lease_state_ == Lease::STATE_DECLINED) {
+        // Set subnet level value.
+        stats_mgr.setValue(StatsMgr::generateName("subnet", row.subnet_id_,
+                                                  "declined-addresses"),
+                           row.state_count_);
+
+        // Add to subnet level value.
+        // Declined leases also count as assigned.
+        stats_mgr.addValue(StatsMgr::generateName("subnet", row.subnet_id_,
+                                                  "assigned-addresses"),
+                           row.state_count_);
     }
 }
 
@@ -206,6 +402,11 @@ LeaseMgr::startSubnetRangeLeaseStatsQuery4(const SubnetID& /* first_subnet_id */
     return(LeaseStatsQueryPtr());
 }
 
+LeaseStatsQueryPtr
+LeaseMgr::startPoolLeaseStatsQuery4(const LeaseStatsPoolCollection& /* pools */) {
+    return(LeaseStatsQueryPtr());
+}
+
 bool
 LeaseStatsQuery::getNextRow(LeaseStatsRow& /*row*/) {
     return (false);
@@ -228,6 +429,87 @@ LeaseMgr::recountLeaseStats6() {
     // "cumulative-assigned-nas", "cumulative-assigned-pds") never get zeroed.
     int64_t zero = 0;
     stats_mgr.setValue("declined-addresses", zero);
+    initGlobalLeaseStats6();
+
+    // Clear subnet level stats.  This ensures we don't end up with corner
+    // cases that leave stale values in place.
+    const Subnet6Collection* subnets =
+        CfgMgr::instance().getCurrentCfg()->getCfgSubnets6()->getAll();
+
+    for (Subnet6Collection::const_iterator subnet = subnets->begin();
+         subnet != subnets->end(); ++subnet) {
+        clearSubnetLeaseStats6((*subnet)->getID());
+    }
+
+    // Get counts per state per subnet. Iterate over the result set
+    // updating the subnet and global values.
+    LeaseStatsRow row;
+    while (query->getNextRow(row)) {
+        addSubnetLeaseStats6(row);
+        if ((row.lease_type_ == Lease::TYPE_NA) &&
+            (row.lease_state_ == Lease::STATE_DECLINED)) {
+            // Add to the global value.
+            stats_mgr.addValue("declined-addresses", row.state_count_);
+        }
+    }
+}
+
+void
+LeaseMgr::recountLeaseStats6(const std::set<SubnetID>& subnet_ids) {
+    using namespace stats;
+
+    StatsMgr& stats_mgr = StatsMgr::instance();
+
+    if (!subnet_ids.empty()) {
+        // Query the range of the subnets to recount.
+        LeaseStatsQueryPtr query;
+        if (subnet_ids.size() == 1) {
+            query = startSubnetLeaseStatsQuery6(*subnet_ids.begin());
+        } else {
+            query = startSubnetRangeLeaseStatsQuery6(*subnet_ids.begin(),
+                                                     *subnet_ids.rbegin());
+        }
+        if (!query) {
+            // The backend does not support subnet queries.
+            recountLeaseStats6();
+            return;
+        }
+
+        initGlobalLeaseStats6();
+        for (auto const& subnet_id : subnet_ids) {
+            clearSubnetLeaseStats6(subnet_id);
+        }
+
+        LeaseStatsRow row;
+        while (query->getNextRow(row)) {
+            if (subnet_ids.count(row.subnet_id_)) {
+                addSubnetLeaseStats6(row);
+            }
+        }
+    }
+
+    // The global declined addresses are the sum of the subnet ones.
+    int64_t declined = 0;
+    const Subnet6Collection* subnets =
+        CfgMgr::instance().getCurrentCfg()->getCfgSubnets6()->getAll();
+    for (auto const& subnet : *subnets) {
+        ObservationPtr declined_obs =
+            stats_mgr.getObservation(StatsMgr::generateName("subnet",
+                                                            subnet->getID(),
+                                                            "declined-addresses"));
+        if (declined_obs) {
+            declined += declined_obs->getInteger().first;
+        }
+    }
+    stats_mgr.setValue("declined-addresses", declined);
+}
+
+void
+LeaseMgr::initGlobalLeaseStats6() {
+    using namespace stats;
+
+    StatsMgr& stats_mgr = StatsMgr::instance();
+    int64_t zero = 0;
 
     if (!stats_mgr.getObservation("reclaimed-declined-addresses")) {
         stats_mgr.setValue("reclaimed-declined-addresses", zero);
@@ -246,91 +528,89 @@ LeaseMgr::recountLeaseStats6() {
     if (!stats_mgr.getObservation("cumulative-assigned-pds")) {
         stats_mgr.setValue("cumulative-assigned-pds", zero);
     }
+}
 
-    // Clear subnet level stats.  This ensures we don't end up with corner
-    // cases that leave stale values in place.
-    const Subnet6Collection* subnets =
-        CfgMgr::instance().getCurrentCfg()->getCfgSubnets6()->getAll();
+void
+LeaseMgr::clearSubnetLeaseStats6(const SubnetID& subnet_id) {
+    using namespace stats;
 
-    for (Subnet6Collection::const_iterator subnet = subnets->begin();
-         subnet != subnets->end(); ++subnet) {
-        SubnetID subnet_id = (*subnet)->getID();
-        stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
-                                                  "assigned-nas"),
-                           zero);
+    StatsMgr& stats_mgr = StatsMgr::instance();
+    int64_t zero = 0;
 
-        stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
-                                                  "declined-addresses"),
-                           zero);
-
-        if (!stats_mgr.getObservation(
-                StatsMgr::generateName("subnet", subnet_id,
-                                       "reclaimed-declined-addresses"))) {
-            stats_mgr.setValue(
-                StatsMgr::generateName("subnet", subnet_id,
-                                       "reclaimed-declined-addresses"),
-                zero);
-        }
+    stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
+                                              "assigned-nas"),
+                       zero);
+
+    stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
+                                              "declined-addresses"),
+                       zero);
+
+    if (!stats_mgr.getObservation(
+            StatsMgr::generateName("subnet", subnet_id,
+                                   "reclaimed-declined-addresses"))) {
+        stats_mgr.setValue(
+            StatsMgr::generateName("subnet", subnet_id,
+                                   "reclaimed-declined-addresses"),
+            zero);
+    }
 
-        stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
-                                                  "assigned-pds"),
-                           zero);
-
-        if (!stats_mgr.getObservation(
-                StatsMgr::generateName("subnet", subnet_id,
-                                       "reclaimed-leases"))) {
-            stats_mgr.setValue(
-                StatsMgr::generateName("subnet", subnet_id,
-                                       "reclaimed-leases"),
-                zero);
-        }
+    stats_mgr.setValue(StatsMgr::generateName("subnet", subnet_id,
+                                              "assigned-pds"),
+                       zero);
+
+    if (!stats_mgr.getObservation(
+            StatsMgr::generateName("subnet", subnet_id,
+                                   "reclaimed-leases"))) {
+        stats_mgr.setValue(
+            StatsMgr::generateName("subnet", subnet_id,
+                                   "reclaimed-leases"),
+            zero);
     }
+}
 
-    // Get counts per state per subnet. Iterate over the result set
-    // updating the subnet and global values.
-    LeaseStatsRow row;
-    while (query->getNextRow(row)) {
-        switch(row.lease_type_) {
-            case Lease::TYPE_NA:
-                if (row.lease_state_ == Lease::STATE_DEFAULT) {
-                    // Add to subnet level value.
-                    stats_mgr.addValue(StatsMgr::
-                                       generateName("subnet", row.subnet_id_,
-                                                    "assigned-nas"),
-                                       row.state_count_);
-                } else if (row.lease_state_ == Lease::STATE_DECLINED) {
-                    // Set subnet level value.
-                    stats_mgr.setValue(StatsMgr::
-                                       generateName("subnet", row.subnet_id_,
-                                                    "declined-addresses"),
-                                       row.state_count_);
-
-                    // Add to the global value.
-                    stats_mgr.addValue("declined-addresses", row.state_count_);
-
-                    // Add to subnet level value.
-                    // Declined leases also count as assigned.
-                    stats_mgr.addValue(StatsMgr::
-                                       generateName("subnet", row.subnet_id_,
-                                                    "assigned-nas"),
-                                       row.state_count_);
-                }
-                break;
-
-            case Lease::TYPE_PD:
-                if (row.lease_state_ == Lease::STATE_DEFAULT) {
-                    // Set subnet level value.
-                    stats_mgr.setValue(StatsMgr::
-                                       generateName("subnet", row.subnet_id_,
-                                                    "assigned-pds"),
-                                       row.state_count_);
-                }
-                break;
-
-            default:
-                // We dont' support TYPE_TAs yet
-                break;
-        }
+void
+LeaseMgr::addSubnetLeaseStats6(const LeaseStatsRow& row) {
+    using namespace stats;
+
+    StatsMgr& stats_mgr = StatsMgr::instance();
+
+    switch(row.lease_type_) {
+        case Lease::TYPE_NA:
+            if (row.lease_state_ == Lease::STATE_DEFAULT) {
+                // Add to subnet level value.
+                stats_mgr.addValue(StatsMgr::
+                                   generateName("subnet", row.subnet_id_,
+                                                "assigned-nas"),
+                                   row.state_count_);
+            } else if (row.lease_state_ == Lease::STATE_DECLINED) {
+                // Set subnet level value.
+                stats_mgr.setValue(StatsMgr::
+                                   generateName("subnet", row.subnet_id_,
+                                                "declined-addresses"),
+                                   row.state_count_);
+
+                // Add to subnet level value.
+                // Declined leases also count as assigned.
+                stats_mgr.addValue(StatsMgr::
+                                   generateName("subnet", row.subnet_id_,
+                                                "assigned-nas"),
+                                   row.state_count_);
+            }
+            break;
+
+        case Lease::TYPE_PD:
+            if (row.lease_state_ == Lease::STATE_DEFAULT) {
+                // Set subnet level value.
+                stats_mgr.setValue(StatsMgr::
+                                   generateName("subnet", row.subnet_id_,
+                                                "assigned-pds"),
+                                   row.state_count_);
+            }
+            break;
+
+        default:
+            // We dont' support TYPE_TAs yet
+            break;
     }
 }
 
@@ -350,6 +630,11 @@ LeaseMgr::startSubnetRangeLeaseStatsQuery6(const SubnetID& /* first_subnet_id */
     return(LeaseStatsQueryPtr());
 }
 
+LeaseStatsQueryPtr
+LeaseMgr::startPoolLeaseStatsQuery6(const LeaseStatsPoolCollection& /* pools */) {
+    return(LeaseStatsQueryPtr());
+}
+
 std::string
 LeaseMgr::getDBVersion() {
     isc_throw(NotImplemented, "LeaseMgr::getDBVersion() called");
@@ -20,8 +20,10 @@
 #include <boost/shared_ptr.hpp>
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <map>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -53,15 +55,28 @@ public:
     const size_t page_size_; ///< Holds page size.
 };
 
+/// @brief Callback receiving the IPv4 leases of a walk.
+///
+/// The lease is only valid during the invocation of the callback, so it
+/// must be copied to be kept. The callback must not use the lease manager.
+typedef std::function<void(const Lease4&)> Lease4Callback;
+
+/// @brief Callback receiving the IPv6 leases of a walk.
+///
+/// The lease is only valid during the invocation of the callback, so it
+/// must be copied to be kept. The callback must not use the lease manager.
+typedef std::function<void(const Lease6&)> Lease6Callback;
+
 /// @brief Contains a single row of lease statistical data
 ///
 /// The contents of the row consist of a subnet ID, a lease
 /// type, a lease state, and the number of leases in that state
-/// for that type for that subnet ID.
+/// for that type for that subnet ID. The rows of the pool statistics
+/// queries also carry the index of the pool in the subnet.
 struct LeaseStatsRow {
     /// @brief Default constructor
     LeaseStatsRow() :
-        subnet_id_(0), lease_type_(Lease::TYPE_NA),
+        subnet_id_(0), pool_id_(0), lease_type_(Lease::TYPE_NA),
         lease_state_(Lease::STATE_DEFAULT), state_count_(0) {
     }
 
@@ -74,7 +89,7 @@ struct LeaseStatsRow {
     /// @param state_count The count of leases in the lease state
     LeaseStatsRow(const SubnetID& subnet_id, const uint32_t lease_state,
                   const int64_t state_count)
-        : subnet_id_(subnet_id), lease_type_(Lease::TYPE_NA),
+        : subnet_id_(subnet_id), pool_id_(0), lease_type_(Lease::TYPE_NA),
           lease_state_(lease_state), state_count_(state_count) {
     }
 
@@ -86,7 +101,22 @@ struct LeaseStatsRow {
     /// @param state_count The count of leases in the lease state
     LeaseStatsRow(const SubnetID& subnet_id, const Lease::Type& lease_type,
                   const uint32_t lease_state, const int64_t state_count)
-        : subnet_id_(subnet_id), lease_type_(lease_type),
+        : subnet_id_(subnet_id), pool_id_(0), lease_type_(lease_type),
+          lease_state_(lease_state), state_count_(state_count) {
+    }
+
+    /// @brief Constructor for the pool statistics
+    ///
+    /// @param subnet_id The subnet id to which this data applies
+    /// @param pool_id The index of the pool in the pools of the lease
+    /// type in the subnet
+    /// @param lease_type The lease type for this state count
+    /// @param lease_state The lease state counted
+    /// @param state_count The count of leases in the lease state
+    LeaseStatsRow(const SubnetID& subnet_id, const uint32_t pool_id,
+                  const Lease::Type& lease_type, const uint32_t lease_state,
+                  const int64_t state_count)
+        : subnet_id_(subnet_id), pool_id_(pool_id), lease_type_(lease_type),
           lease_state_(lease_state), state_count_(state_count) {
     }
 
@@ -97,11 +127,18 @@ struct LeaseStatsRow {
         }
 
         if (subnet_id_ == rhs.subnet_id_ &&
+            pool_id_ < rhs.pool_id_) {
+                return (true);
+        }
+
+        if (subnet_id_ == rhs.subnet_id_ &&
+            pool_id_ == rhs.pool_id_ &&
             lease_type_ < rhs.lease_type_) {
                 return (true);
         }
 
         if (subnet_id_ == rhs.subnet_id_ &&
+            pool_id_ == rhs.pool_id_ &&
             lease_type_ == rhs.lease_type_ &&
             lease_state_ < rhs.lease_state_) {
                 return (true);
@@ -112,6 +149,9 @@ struct LeaseStatsRow {
 
     /// @brief The subnet ID to which this data applies
     SubnetID subnet_id_;
+    /// @brief The index of the pool to which this data applies (pool
+    /// statistics only)
+    uint32_t pool_id_;
     /// @brief The lease_type to which the count applies
     Lease::Type lease_type_;
     /// @brief The lease_state to which the count applies
@@ -120,6 +160,39 @@ struct LeaseStatsRow {
     int64_t state_count_;
 };
 
+/// @brief Address range of a pool given to the pool lease statistics
+/// queries.
+struct LeaseStatsPool {
+    /// @brief Constructor
+    ///
+    /// @param subnet_id The subnet id of the pool
+    /// @param pool_id The index of the pool in the pools of the lease
+    /// type in the subnet
+    /// @param type The lease type of the pool
+    /// @param first The first address or prefix of the pool
+    /// @param last The last address or prefix of the pool
+    LeaseStatsPool(const SubnetID& subnet_id, const uint32_t pool_id,
+                   const Lease::Type type, const asiolink::IOAddress& first,
+                   const asiolink::IOAddress& last)
+        : subnet_id_(subnet_id), pool_id_(pool_id), type_(type),
+          first_(first), last_(last) {
+    }
+
+    /// @brief The subnet id of the pool
+    SubnetID subnet_id_;
+    /// @brief The index of the pool in the pools of its type in the subnet
+    uint32_t pool_id_;
+    /// @brief The lease type of the pool
+    Lease::Type type_;
+    /// @brief The first address or prefix of the pool
+    asiolink::IOAddress first_;
+    /// @brief The last address or prefix of the pool
+    asiolink::IOAddress last_;
+};
+
+/// @brief A collection of pools given to the pool lease statistics queries
+typedef std::vector<LeaseStatsPool> LeaseStatsPoolCollection;
+
 /// @brief Base class for fulfilling a statistical lease data query
 ///
 /// LeaseMgr derivations implement this class such that it provides
@@ -370,6 +443,36 @@ public:
     getLeases4(const asiolink::IOAddress& lower_bound_address,
                const LeasePageSize& page_size) const = 0;
 
+    /// @brief Passes all IPv4 leases to a callback.
+    ///
+    /// Unlike @c getLeases4 the leases are not held in a collection. The
+    /// default implementation walks the collection returned by
+    /// @c getLeases4: the backends override it to pass the leases to the
+    /// callback as they are read from the database.
+    ///
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases4(const Lease4Callback& callback) const;
+
+    /// @brief Passes all IPv4 leases for the particular subnet identifier
+    /// to a callback.
+    ///
+    /// @param subnet_id subnet identifier.
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases4(SubnetID subnet_id,
+                             const Lease4Callback& callback) const;
+
+    /// @brief Passes a page of IPv4 leases to a callback.
+    ///
+    /// The page is the range returned by the paged @c getLeases4.
+    ///
+    /// @param lower_bound_address IPv4 address used as lower bound for the
+    /// range.
+    /// @param page_size maximum size of the page.
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases4(const asiolink::IOAddress& lower_bound_address,
+                             const LeasePageSize& page_size,
+                             const Lease4Callback& callback) const;
+
     /// @brief Returns existing IPv6 lease for a given IPv6 address.
     ///
     /// For a given address, we assume that there will be only one lease.
@@ -491,6 +594,36 @@ public:
     getLeases6(const asiolink::IOAddress& lower_bound_address,
                const LeasePageSize& page_size) const = 0;
 
+    /// @brief Passes all IPv6 leases to a callback.
+    ///
+    /// Unlike @c getLeases6 the leases are not held in a collection. The
+    /// default implementation walks the collection returned by
+    /// @c getLeases6: the backends override it to pass the leases to the
+    /// callback as they are read from the database.
+    ///
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases6(const Lease6Callback& callback) const;
+
+    /// @brief Passes all IPv6 leases for the particular subnet identifier
+    /// to a callback.
+    ///
+    /// @param subnet_id subnet identifier.
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases6(SubnetID subnet_id,
+                             const Lease6Callback& callback) const;
+
+    /// @brief Passes a page of IPv6 leases to a callback.
+    ///
+    /// The page is the range returned by the paged @c getLeases6.
+    ///
+    /// @param lower_bound_address IPv6 address used as lower bound for the
+    /// range.
+    /// @param page_size maximum size of the page.
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases6(const asiolink::IOAddress& lower_bound_address,
+                             const LeasePageSize& page_size,
+                             const Lease6Callback& callback) const;
+
     /// @brief Returns a collection of expired DHCPv4 leases.
     ///
     /// This method returns at most @c max_leases expired leases. The leases
@@ -549,6 +682,93 @@ public:
     ///        failed.
     virtual bool deleteLease(const Lease6Ptr& lease) = 0;
 
+    /// @brief Adds a collection of IPv4 leases.
+    ///
+    /// The default implementation adds the leases one by one using
+    /// @c addLease. The PostgreSQL backend overrides it to add all
+    /// leases using a single database connection within one transaction,
+    /// which saves a commit per lease.
+    ///
+    /// @param leases leases to be added.
+    ///
+    /// @return leases which were not added because a lease with the same
+    ///         address was already there or failed sanity checks.
+    ///
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed. The PostgreSQL backend adds none of the leases in this
+    ///        case.
+    virtual Lease4Collection addLeases(const Lease4Collection& leases);
+
+    /// @brief Adds a collection of IPv6 leases.
+    ///
+    /// See @c addLeases(const Lease4Collection&) for details.
+    ///
+    /// @param leases leases to be added.
+    ///
+    /// @return leases which were not added because a lease with the same
+    ///         address was already there or failed sanity checks.
+    ///
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed. The PostgreSQL backend adds none of the leases in this
+    ///        case.
+    virtual Lease6Collection addLeases(const Lease6Collection& leases);
+
+    /// @brief Updates a collection of IPv4 leases.
+    ///
+    /// The default implementation updates the leases one by one using
+    /// @c updateLease4. The PostgreSQL backend overrides it to update all
+    /// leases within one transaction.
+    ///
+    /// @param leases leases to be updated.
+    ///
+    /// @return leases which were not updated because they do not exist.
+    ///
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed. The PostgreSQL backend updates none of the leases in this
+    ///        case.
+    virtual Lease4Collection updateLeases(const Lease4Collection& leases);
+
+    /// @brief Updates a collection of IPv6 leases.
+    ///
+    /// See @c updateLeases(const Lease4Collection&) for details.
+    ///
+    /// @param leases leases to be updated.
+    ///
+    /// @return leases which were not updated because they do not exist.
+    ///
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed. The PostgreSQL backend updates none of the leases in this
+    ///        case.
+    virtual Lease6Collection updateLeases(const Lease6Collection& leases);
+
+    /// @brief Deletes a collection of IPv4 leases.
+    ///
+    /// The default implementation deletes the leases one by one using
+    /// @c deleteLease. The PostgreSQL backend overrides it to delete all
+    /// leases within one transaction.
+    ///
+    /// @param leases leases to be deleted.
+    ///
+    /// @return leases which were not deleted because they do not exist.
+    ///
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed. The PostgreSQL backend deletes none of the leases in this
+    ///        case.
+    virtual Lease4Collection deleteLeases(const Lease4Collection& leases);
+
+    /// @brief Deletes a collection of IPv6 leases.
+    ///
+    /// See @c deleteLeases(const Lease4Collection&) for details.
+    ///
+    /// @param leases leases to be deleted.
+    ///
+    /// @return leases which were not deleted because they do not exist.
+    ///
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed. The PostgreSQL backend deletes none of the leases in this
+    ///        case.
+    virtual Lease6Collection deleteLeases(const Lease6Collection& leases);
+
     /// @brief Deletes all expired and reclaimed DHCPv4 leases.
     ///
     /// @param secs Number of seconds since expiration of leases before
@@ -586,6 +806,20 @@ public:
     /// adding to the appropriate global statistic.
     void recountLeaseStats4();
 
+    /// @brief Recalculates per-subnet stats for some IPv4 subnets
+    ///
+    /// This method recalculates the per-subnet statistics recalculated
+    /// by @ref recountLeaseStats4 but only for the given subnets, using
+    /// a single subnet or a subnet range query. The statistics of the
+    /// other subnets are left unchanged. The global declined-addresses
+    /// statistic is set to the sum of the subnet ones.
+    ///
+    /// All the subnets are recounted when the backend does not support
+    /// the subnet queries.
+    ///
+    /// @param subnet_ids Identifiers of the subnets to recount.
+    void recountLeaseStats4(const std::set<SubnetID>& subnet_ids);
+
     /// @brief Creates and runs the IPv4 lease stats query for all subnets
     ///
     /// LeaseMgr derivations implement this method such that it creates and
@@ -622,6 +856,22 @@ public:
     virtual LeaseStatsQueryPtr startSubnetRangeLeaseStatsQuery4(const SubnetID& first_subnet_id,
                                                                 const SubnetID& last_subnet_id);
 
+    /// @brief Creates and runs the IPv4 lease stats query for pools
+    ///
+    /// LeaseMgr derivations implement this method such that it creates and
+    /// returns an instance of an LeaseStatsQuery whose result set has been
+    /// populated with up to date IPv4 lease statistical data for the given
+    /// pools. Each row of the result set is an LeaseStatRow carrying the
+    /// index of the pool in the subnet, ordered ascending by subnet ID and
+    /// pool index. A lease is counted in the pool its address belongs to.
+    ///
+    /// The default implementation returns null: the pool statistics are
+    /// not supported by the backend.
+    ///
+    /// @param pools The pools for which the statistics are desired
+    /// @return A populated LeaseStatsQuery or null
+    virtual LeaseStatsQueryPtr startPoolLeaseStatsQuery4(const LeaseStatsPoolCollection& pools);
+
     /// @brief Recalculates per-subnet and global stats for IPv6 leases
     ///
     /// This method recalculates the following statistics:
@@ -643,6 +893,20 @@ public:
     /// per subnet and adding to the appropriate global statistic.
     void recountLeaseStats6();
 
+    /// @brief Recalculates per-subnet stats for some IPv6 subnets
+    ///
+    /// This method recalculates the per-subnet statistics recalculated
+    /// by @ref recountLeaseStats6 but only for the given subnets, using
+    /// a single subnet or a subnet range query. The statistics of the
+    /// other subnets are left unchanged. The global declined-addresses
+    /// statistic is set to the sum of the subnet ones.
+    ///
+    /// All the subnets are recounted when the backend does not support
+    /// the subnet queries.
+    ///
+    /// @param subnet_ids Identifiers of the subnets to recount.
+    void recountLeaseStats6(const std::set<SubnetID>& subnet_ids);
+
     /// @brief Creates and runs the IPv6 lease stats query for all subnets
     ///
     /// LeaseMgr derivations implement this method such that it creates and
@@ -679,6 +943,22 @@ public:
     virtual LeaseStatsQueryPtr startSubnetRangeLeaseStatsQuery6(const SubnetID& first_subnet_id,
                                                                 const SubnetID& last_subnet_id);
 
+    /// @brief Creates and runs the IPv6 lease stats query for pools
+    ///
+    /// LeaseMgr derivations implement this method such that it creates and
+    /// returns an instance of an LeaseStatsQuery whose result set has been
+    /// populated with up to date IPv6 lease statistical data for the given
+    /// address and prefix pools. Each row of the result set is an
+    /// LeaseStatRow carrying the index of the pool in the subnet, ordered
+    /// ascending by subnet ID and pool index.
+    ///
+    /// The default implementation returns null: the pool statistics are
+    /// not supported by the backend.
+    ///
+    /// @param pools The pools for which the statistics are desired
+    /// @return A populated LeaseStatsQuery or null
+    virtual LeaseStatsQueryPtr startPoolLeaseStatsQuery6(const LeaseStatsPoolCollection& pools);
+
     /// @brief Virtual method which removes specified leases.
     ///
     /// This rather dangerous method is able to remove all leases from specified
@@ -760,6 +1040,32 @@ public:
     }
 
 private:
+    /// @brief Creates the cumulative global IPv4 lease statistics.
+    static void initGlobalLeaseStats4();
+
+    /// @brief Zeroes the IPv4 lease statistics of a subnet.
+    ///
+    /// @param subnet_id Identifier of the subnet.
+    static void clearSubnetLeaseStats4(const SubnetID& subnet_id);
+
+    /// @brief Adds a row of an IPv4 lease stats query to its subnet stats.
+    ///
+    /// @param row The row of the query.
+    static void addSubnetLeaseStats4(const LeaseStatsRow& row);
+
+    /// @brief Creates the cumulative global IPv6 lease statistics.
+    static void initGlobalLeaseStats6();
+
+    /// @brief Zeroes the IPv6 lease statistics of a subnet.
+    ///
+    /// @param subnet_id Identifier of the subnet.
+    static void clearSubnetLeaseStats6(const SubnetID& subnet_id);
+
+    /// @brief Adds a row of an IPv6 lease stats query to its subnet stats.
+    ///
+    /// @param row The row of the query.
+    static void addSubnetLeaseStats6(const LeaseStatsRow& row);
+
     /// The IOService object, used for all ASIO operations.
     static isc::asiolink::IOServicePtr io_service_;
 };
@@ -0,0 +1,197 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <dhcpsrv/dhcpsrv_log.h>
+#include <dhcpsrv/lease_reclaimer.h>
+#include <exceptions/exceptions.h>
+#include <stats/stats_mgr.h>
+#include <util/multi_threading_mgr.h>
+
+#include <signal.h>
+#include <sys/socket.h>
+
+using namespace isc::stats;
+using namespace isc::util;
+using namespace std;
+
+namespace isc {
+namespace dhcp {
+
+LeaseReclaimer::LeaseReclaimer(const AllocEnginePtr& engine,
+                               const uint16_t family,
+                               const bool test_mode)
+    : engine_(engine), family_(family), test_mode_(test_mode),
+      enabled_(false), max_leases_(0), wait_time_(0), remove_lease_(false),
+      backlog_reclaimed_(0), window_reclaimed_(0), stopping_(false) {
+    if (!engine_) {
+        isc_throw(BadValue, "allocation engine of the leases reclaimer must not be null");
+    }
+    if ((family_ != AF_INET) && (family_ != AF_INET6)) {
+        isc_throw(BadValue, "invalid family " << family_
+                  << " of the leases reclaimer");
+    }
+    cs_callbacks_name_ = (family_ == AF_INET ? "LEASE_RECLAIMER4" :
+                          "LEASE_RECLAIMER6");
+
+    // The thread is stopped during the critical sections.
+    MultiThreadingMgr::instance().addCriticalSectionCallbacks(cs_callbacks_name_,
+        [this]() {
+            if (thread_.joinable() &&
+                (this_thread::get_id() == thread_.get_id())) {
+                isc_throw(MultiThreadingInvalidOperation,
+                          "critical section entered by the leases reclaimer thread");
+            }
+        },
+        std::bind(&LeaseReclaimer::stop, this),
+        std::bind(&LeaseReclaimer::start, this));
+}
+
+LeaseReclaimer::~LeaseReclaimer() {
+    MultiThreadingMgr::instance().removeCriticalSectionCallbacks(cs_callbacks_name_);
+    stop();
+    engine_->setBackgroundReclamation(false);
+}
+
+void
+LeaseReclaimer::configure(const bool enabled, const CfgExpiration& cfg) {
+    stop();
+    enabled_ = enabled && (cfg.getReclaimTimerWaitTime() > 0);
+    max_leases_ = cfg.getMaxReclaimLeases();
+    // In the test mode the wait time is expressed in milliseconds.
+    wait_time_ = chrono::milliseconds(test_mode_ ? cfg.getReclaimTimerWaitTime() :
+                                      1000 * cfg.getReclaimTimerWaitTime());
+    // The reclaimed leases are removed when they are not flushed by
+    // the timer.
+    remove_lease_ = (cfg.getFlushReclaimedTimerWaitTime() == 0);
+    engine_->setBackgroundReclamation(enabled_);
+}
+
+void
+LeaseReclaimer::start() {
+    if (!enabled_ || thread_.joinable()) {
+        return;
+    }
+    stopping_ = false;
+    backlog_reclaimed_ = 0;
+    window_reclaimed_ = 0;
+    window_start_ = chrono::steady_clock::now();
+
+    // Protect the thread against signals.
+    sigset_t sset;
+    sigset_t osset;
+    sigemptyset(&sset);
+    sigaddset(&sset, SIGCHLD);
+    sigaddset(&sset, SIGINT);
+    sigaddset(&sset, SIGHUP);
+    sigaddset(&sset, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &sset, &osset);
+    try {
+        thread_ = std::thread(&LeaseReclaimer::run, this);
+    } catch (...) {
+        pthread_sigmask(SIG_SETMASK, &osset, 0);
+        throw;
+    }
+    pthread_sigmask(SIG_SETMASK, &osset, 0);
+
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE, DHCPSRV_LEASE_RECLAIMER_STARTED);
+}
+
+void
+LeaseReclaimer::stop() {
+    if (!thread_.joinable()) {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    thread_.join();
+    thread_ = std::thread();
+
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE, DHCPSRV_LEASE_RECLAIMER_STOPPED);
+}
+
+bool
+LeaseReclaimer::isRunning() {
+    return (thread_.joinable());
+}
+
+void
+LeaseReclaimer::run() {
+    for (;;) {
+        {
+            lock_guard<mutex> lock(mutex_);
+            if (stopping_) {
+                return;
+            }
+        }
+        if (!runPass()) {
+            continue;
+        }
+        unique_lock<mutex> lock(mutex_);
+        cv_.wait_for(lock, wait_time_, [this]() { return (stopping_); });
+    }
+}
+
+bool
+LeaseReclaimer::runPass() {
+    AllocEngine::ReclaimPass pass;
+    try {
+        if (family_ == AF_INET) {
+            pass = engine_->reclaimExpiredLeasesConcurrently4(max_leases_,
+                                                              remove_lease_);
+        } else {
+            pass = engine_->reclaimExpiredLeasesConcurrently6(max_leases_,
+                                                              remove_lease_);
+        }
+    } catch (const std::exception& ex) {
+        LOG_ERROR(dhcpsrv_logger, DHCPSRV_LEASE_RECLAIMER_FAILED)
+            .arg(ex.what());
+        backlog_reclaimed_ = 0;
+        return (true);
+    }
+
+    // The passes are bounded by max-reclaim-leases so the backlog is
+    // accumulated over the passes until it is drained.
+    StatsMgr& stats_mgr = StatsMgr::instance();
+    stats_mgr.setValue("reclaim-backlog",
+                       static_cast<int64_t>(backlog_reclaimed_ + pass.found_));
+    int64_t age = 0;
+    if (pass.oldest_expire_ > 0) {
+        age = static_cast<int64_t>(time(0) - pass.oldest_expire_);
+        if (age < 0) {
+            age = 0;
+        }
+    }
+    stats_mgr.setValue("reclaim-backlog-age", age);
+
+    // The rate is computed over windows of at least one second.
+    window_reclaimed_ += pass.reclaimed_;
+    auto now = chrono::steady_clock::now();
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(now - window_start_);
+    if (elapsed.count() >= 1000) {
+        stats_mgr.setValue("reclaim-rate",
+                           static_cast<int64_t>(window_reclaimed_ * 1000 /
+                                                elapsed.count()));
+        window_reclaimed_ = 0;
+        window_start_ = now;
+    }
+
+    // Wait when the backlog is drained or no progress can be made.
+    if ((max_leases_ == 0) || (pass.found_ < max_leases_) ||
+        (pass.reclaimed_ == 0)) {
+        backlog_reclaimed_ = 0;
+        return (true);
+    }
+    backlog_reclaimed_ += pass.reclaimed_;
+    return (false);
+}
+
+} // namespace isc::dhcp
+} // namespace isc
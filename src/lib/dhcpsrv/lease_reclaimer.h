@@ -0,0 +1,158 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef LEASE_RECLAIMER_H
+#define LEASE_RECLAIMER_H
+
+#include <dhcpsrv/alloc_engine.h>
+#include <dhcpsrv/cfg_expiration.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace isc {
+namespace dhcp {
+
+/// @brief Reclaims the expired leases in a background thread.
+///
+/// In multi-threading mode the leases reclamation run by the timer is
+/// exclusive of the packet processing: the packet processing threads are
+/// blocked while a batch of leases is reclaimed. The background reclaimer
+/// runs the reclamation in its own thread, concurrently with the packet
+/// processing, using the @c AllocEngine::reclaimExpiredLeasesConcurrently4
+/// and @c AllocEngine::reclaimExpiredLeasesConcurrently6 routines which
+/// lock the leases one by one.
+///
+/// The thread runs passes of at most "max-reclaim-leases" leases back to
+/// back while each pass finds that many expired leases, and waits for the
+/// "reclaim-timer-wait-time" otherwise. The timer flushing the
+/// expired-reclaimed leases is unchanged.
+///
+/// After each pass the following statistics are set:
+/// - reclaim-backlog: the number of expired leases waiting for the
+///   reclamation when the backlog was last found empty, i.e. the leases
+///   reclaimed by the previous passes since then plus the expired leases
+///   found by the last pass. It is not bounded by "max-reclaim-leases".
+/// - reclaim-backlog-age: the age in seconds of the oldest expired lease
+///   found by the last pass, i.e. the lag of the reclamation.
+/// - reclaim-rate: the number of leases reclaimed per second.
+///
+/// The thread is stopped when a critical section is entered, e.g. during a
+/// reconfiguration, and restarted when it is exited.
+class LeaseReclaimer : public boost::noncopyable {
+public:
+    /// @brief Constructor.
+    ///
+    /// Registers the critical section callbacks. The thread is not started.
+    ///
+    /// @param engine Allocation engine reclaiming the leases.
+    /// @param family Protocol family (AF_INET or AF_INET6).
+    /// @param test_mode Indicates if the wait time is expressed in
+    /// milliseconds (if true) or seconds (if false).
+    /// @throw BadValue if the allocation engine is null or the family is
+    /// invalid.
+    LeaseReclaimer(const AllocEnginePtr& engine, const uint16_t family,
+                   const bool test_mode = false);
+
+    /// @brief Destructor.
+    ///
+    /// Stops the thread and unregisters the critical section callbacks.
+    ~LeaseReclaimer();
+
+    /// @brief Configures the reclaimer.
+    ///
+    /// Stops the thread and sets the background reclamation flag of the
+    /// allocation engine. The thread must be started again using
+    /// @c start.
+    ///
+    /// @param enabled Indicates if the background reclamation is enabled.
+    /// It is disabled when the "reclaim-timer-wait-time" is 0.
+    /// @param cfg Expiration configuration.
+    void configure(const bool enabled, const CfgExpiration& cfg);
+
+    /// @brief Starts the thread if the background reclamation is enabled.
+    void start();
+
+    /// @brief Stops the thread.
+    void stop();
+
+    /// @brief Checks if the background reclamation is enabled.
+    bool isEnabled() const {
+        return (enabled_);
+    }
+
+    /// @brief Checks if the thread is running.
+    bool isRunning();
+
+private:
+    /// @brief Thread function.
+    void run();
+
+    /// @brief Runs a pass and sets the statistics.
+    ///
+    /// @return true if the thread should wait before the next pass.
+    bool runPass();
+
+    /// @brief Allocation engine.
+    AllocEnginePtr engine_;
+
+    /// @brief Protocol family.
+    uint16_t family_;
+
+    /// @brief Test mode flag.
+    bool test_mode_;
+
+    /// @brief Name of the critical section callbacks.
+    std::string cs_callbacks_name_;
+
+    /// @brief Enabled flag.
+    bool enabled_;
+
+    /// @brief Maximum number of leases reclaimed in a pass (0 means all).
+    size_t max_leases_;
+
+    /// @brief Wait time between the passes when the backlog is empty.
+    std::chrono::milliseconds wait_time_;
+
+    /// @brief Indicates if the reclaimed leases are removed.
+    bool remove_lease_;
+
+    /// @brief Number of leases reclaimed since the backlog was last found
+    /// empty.
+    size_t backlog_reclaimed_;
+
+    /// @brief Number of leases reclaimed since the rate was last computed.
+    size_t window_reclaimed_;
+
+    /// @brief Time when the rate was last computed.
+    std::chrono::steady_clock::time_point window_start_;
+
+    /// @brief Protects the stopping flag.
+    std::mutex mutex_;
+
+    /// @brief Wakes up the thread when it is stopped.
+    std::condition_variable cv_;
+
+    /// @brief Flag set to stop the thread.
+    bool stopping_;
+
+    /// @brief Thread.
+    std::thread thread_;
+};
+
+/// @brief Pointer to a background leases reclaimer.
+typedef boost::shared_ptr<LeaseReclaimer> LeaseReclaimerPtr;
+
+} // namespace isc::dhcp
+} // namespace isc
+
+#endif // LEASE_RECLAIMER_H
@@ -0,0 +1,139 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <dhcpsrv/lease_stats_counters.h>
+
+#include <algorithm>
+
+using namespace isc::asiolink;
+using namespace std;
+
+namespace isc {
+namespace dhcp {
+
+LeaseStatsCounters::LeaseStatsCounters() : subnets_(), pools_() {
+}
+
+void
+LeaseStatsCounters::addLease(const Lease& lease, const Lease::Type type) {
+    count(lease, type, 1);
+}
+
+void
+LeaseStatsCounters::deleteLease(const Lease& lease, const Lease::Type type) {
+    count(lease, type, -1);
+}
+
+void
+LeaseStatsCounters::updateLease(const Lease& old_lease, const Lease& new_lease,
+                                const Lease::Type type) {
+    if ((old_lease.subnet_id_ == new_lease.subnet_id_) &&
+        (old_lease.state_ == new_lease.state_)) {
+        return;
+    }
+    count(old_lease, type, -1);
+    count(new_lease, type, 1);
+}
+
+void
+LeaseStatsCounters::clear() {
+    subnets_.clear();
+    pools_.clear();
+}
+
+void
+LeaseStatsCounters::count(const Lease& lease, const Lease::Type type,
+                          const int64_t value) {
+    SubnetKey key(lease.subnet_id_, type, lease.state_);
+    auto it = subnets_.find(key);
+    if (it == subnets_.end()) {
+        subnets_.insert(make_pair(key, value));
+    } else {
+        it->second += value;
+        if (it->second == 0) {
+            subnets_.erase(it);
+        }
+    }
+
+    PoolCounters* pool = findPool(type, lease.addr_);
+    if (pool) {
+        pool->counts_[lease.state_] += value;
+    }
+}
+
+LeaseStatsCounters::PoolCounters*
+LeaseStatsCounters::findPool(const Lease::Type type, const IOAddress& addr) {
+    if (pools_.empty()) {
+        return (0);
+    }
+    // Find the last pool starting at or before the address.
+    auto it = pools_.upper_bound(make_pair(type, addr));
+    if (it == pools_.begin()) {
+        return (0);
+    }
+    --it;
+    if ((it->first.first != type) || (it->second.range_.last_ < addr)) {
+        return (0);
+    }
+    return (&it->second);
+}
+
+void
+LeaseStatsCounters::getSubnetRows(const SubnetID& first_subnet_id,
+                                  const SubnetID& last_subnet_id,
+                                  vector<LeaseStatsRow>& rows) const {
+    auto lower = subnets_.lower_bound(SubnetKey(first_subnet_id, Lease::TYPE_NA, 0));
+    for (auto it = lower; it != subnets_.end(); ++it) {
+        const SubnetID& subnet_id = it->first.get<0>();
+        if (subnet_id > last_subnet_id) {
+            break;
+        }
+        if (it->second != 0) {
+            rows.push_back(LeaseStatsRow(subnet_id, it->first.get<1>(),
+                                         it->first.get<2>(), it->second));
+        }
+    }
+}
+
+void
+LeaseStatsCounters::setPools(const LeaseStatsPoolCollection& pools,
+                             const RangeCountFun& count_fun) {
+    map<PoolKey, PoolCounters> new_pools;
+    for (auto const& range : pools) {
+        PoolKey key(range.type_, range.first_);
+        auto old = pools_.find(key);
+        auto it = new_pools.insert(make_pair(key, PoolCounters(range))).first;
+        if ((old != pools_.end()) && (old->second.range_.last_ == range.last_)) {
+            // Known range: keep the counters.
+            it->second.counts_ = old->second.counts_;
+        } else {
+            count_fun(range.type_, range.first_, range.last_, it->second.counts_);
+        }
+    }
+    pools_.swap(new_pools);
+}
+
+void
+LeaseStatsCounters::getPoolRows(vector<LeaseStatsRow>& rows) const {
+    size_t first = rows.size();
+    for (auto const& pool : pools_) {
+        const LeaseStatsPool& range = pool.second.range_;
+        for (auto const& count : pool.second.counts_) {
+            if (count.second == 0) {
+                continue;
+            }
+            rows.push_back(LeaseStatsRow(range.subnet_id_, range.pool_id_,
+                                         range.type_, count.first,
+                                         count.second));
+        }
+    }
+    sort(rows.begin() + first, rows.end());
+}
+
+} // namespace isc::dhcp
+} // namespace isc
@@ -0,0 +1,161 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef LEASE_STATS_COUNTERS_H
+#define LEASE_STATS_COUNTERS_H
+
+#include <asiolink/io_address.h>
+#include <dhcpsrv/lease.h>
+#include <dhcpsrv/lease_mgr.h>
+#include <dhcpsrv/subnet_id.h>
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace isc {
+namespace dhcp {
+
+/// @brief Lease counters per subnet, pool, lease type and lease state.
+///
+/// The counters are maintained incrementally by a lease backend as the
+/// leases are added, updated and deleted, so the lease statistics can be
+/// recounted without walking the leases, e.g. after a reconfiguration.
+///
+/// The subnet counters are keyed by the subnet id of the leases. The pool
+/// counters are keyed by the address ranges of the configured pools: they
+/// count the leases whose address (or delegated prefix) falls in a pool,
+/// whatever their subnet id. The pool ranges are given by @c setPools and
+/// only the ranges which were not already known are counted by walking the
+/// leases they contain.
+///
+/// This class is not thread safe: the backend must serialize the calls.
+class LeaseStatsCounters {
+public:
+    /// @brief Counts of leases per lease state.
+    typedef std::map<uint32_t, int64_t> StateCounts;
+
+    /// @brief Function counting the leases of a range.
+    ///
+    /// Used when a new pool range is set. The arguments are the lease type,
+    /// the first and the last address of the range and the counts to
+    /// increment.
+    typedef std::function<void(const Lease::Type, const asiolink::IOAddress&,
+                               const asiolink::IOAddress&,
+                               StateCounts&)> RangeCountFun;
+
+    /// @brief Constructor.
+    LeaseStatsCounters();
+
+    /// @brief Counts a lease added to the backend.
+    ///
+    /// @param lease The added lease.
+    /// @param type The type of the lease.
+    void addLease(const Lease& lease, const Lease::Type type);
+
+    /// @brief Uncounts a lease deleted from the backend.
+    ///
+    /// @param lease The deleted lease.
+    /// @param type The type of the lease.
+    void deleteLease(const Lease& lease, const Lease::Type type);
+
+    /// @brief Updates the counters for a lease update.
+    ///
+    /// Nothing is done when the subnet and the state of the lease did not
+    /// change, which is the case of most updates.
+    ///
+    /// @param old_lease The lease before the update.
+    /// @param new_lease The lease after the update.
+    /// @param type The type of the lease.
+    void updateLease(const Lease& old_lease, const Lease& new_lease,
+                     const Lease::Type type);
+
+    /// @brief Resets all the counters.
+    ///
+    /// The pool ranges are forgotten too.
+    void clear();
+
+    /// @brief Returns the subnet counters of a range of subnets.
+    ///
+    /// The rows are ordered by subnet id, lease type and lease state. Only
+    /// the non zero counters are returned.
+    ///
+    /// @param first_subnet_id First subnet of the range.
+    /// @param last_subnet_id Last subnet of the range.
+    /// @param [out] rows Rows the counters are appended to.
+    void getSubnetRows(const SubnetID& first_subnet_id,
+                       const SubnetID& last_subnet_id,
+                       std::vector<LeaseStatsRow>& rows) const;
+
+    /// @brief Sets the pool ranges.
+    ///
+    /// The counters of the ranges already known are kept. The leases of
+    /// the new ranges are counted using the given function.
+    ///
+    /// @param pools The new pool ranges.
+    /// @param count_fun Function counting the leases of a range.
+    void setPools(const LeaseStatsPoolCollection& pools,
+                  const RangeCountFun& count_fun);
+
+    /// @brief Returns the pool counters.
+    ///
+    /// The rows are ordered by subnet id, pool id, lease type and lease
+    /// state. Only the non zero counters are returned.
+    ///
+    /// @param [out] rows Rows the counters are appended to.
+    void getPoolRows(std::vector<LeaseStatsRow>& rows) const;
+
+private:
+    /// @brief Key of a subnet counter: subnet id, lease type, lease state.
+    typedef boost::tuple<SubnetID, Lease::Type, uint32_t> SubnetKey;
+
+    /// @brief Key of a pool range: lease type, first address.
+    typedef std::pair<Lease::Type, asiolink::IOAddress> PoolKey;
+
+    /// @brief Counters of a pool.
+    struct PoolCounters {
+        /// @brief Constructor.
+        ///
+        /// @param range Address range of the pool.
+        PoolCounters(const LeaseStatsPool& range) : range_(range) {
+        }
+
+        /// @brief Address range of the pool.
+        LeaseStatsPool range_;
+
+        /// @brief Counts of leases per state.
+        StateCounts counts_;
+    };
+
+    /// @brief Adds a value to the counters of a lease.
+    ///
+    /// @param lease The lease.
+    /// @param type The type of the lease.
+    /// @param value The value to add (1 or -1).
+    void count(const Lease& lease, const Lease::Type type, const int64_t value);
+
+    /// @brief Finds the pool of an address.
+    ///
+    /// @param type The lease type.
+    /// @param addr The address or prefix.
+    /// @return Pointer to the counters of the pool or null.
+    PoolCounters* findPool(const Lease::Type type,
+                           const asiolink::IOAddress& addr);
+
+    /// @brief Subnet counters.
+    std::map<SubnetKey, int64_t> subnets_;
+
+    /// @brief Pool counters.
+    std::map<PoolKey, PoolCounters> pools_;
+};
+
+} // namespace isc::dhcp
+} // namespace isc
+
+#endif // LEASE_STATS_COUNTERS_H
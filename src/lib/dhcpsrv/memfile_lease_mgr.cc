@@ -16,6 +16,7 @@
 #include <exceptions/exceptions.h>
 #include <util/multi_threading_mgr.h>
 #include <util/pid_file.h>
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <errno.h>
@@ -34,6 +35,22 @@ namespace {
 /// Kea installation directory.
 const char* KEA_LFC_EXECUTABLE_ENV_NAME = "KEA_LFC_EXECUTABLE";
 
+/// @brief Maximum number of leases passed to a walk callback for each
+/// lock of the lease storage.
+const size_t WALK_CHUNK_SIZE = 1024;
+
+/// @brief Returns the type of an IPv4 lease in the lease statistics counters.
+isc::dhcp::Lease::Type
+statsLeaseType(const isc::dhcp::Lease4&) {
+    return (isc::dhcp::Lease::TYPE_V4);
+}
+
+/// @brief Returns the type of an IPv6 lease in the lease statistics counters.
+isc::dhcp::Lease::Type
+statsLeaseType(const isc::dhcp::Lease6& lease) {
+    return (lease.type_);
+}
+
 }  // namespace
 
 using namespace isc::asiolink;
@@ -308,6 +325,46 @@ public:
     }
 
 protected:
+    /// @brief Gets the subnet counters selected by the query
+    ///
+    /// @param stats The lease statistics counters
+    /// @param [out] counters Rows the counters are appended to
+    void getSubnetCounters(const LeaseStatsCounters& stats,
+                           std::vector<LeaseStatsRow>& counters) const {
+        switch (getSelectMode()) {
+        case ALL_SUBNETS:
+            stats.getSubnetRows(1, std::numeric_limits<SubnetID>::max(),
+                                counters);
+            break;
+
+        case SINGLE_SUBNET:
+            stats.getSubnetRows(getFirstSubnetID(), getFirstSubnetID(),
+                                counters);
+            break;
+
+        case SUBNET_RANGE:
+            stats.getSubnetRows(getFirstSubnetID(), getLastSubnetID(),
+                                counters);
+            break;
+        }
+    }
+
+    /// @brief Checks if an IPv6 counter is reported
+    ///
+    /// The assigned and declined addresses and the assigned prefixes are
+    /// reported.
+    ///
+    /// @param counter The counter
+    /// @return true if the counter is reported
+    static bool isCounted6(const LeaseStatsRow& counter) {
+        if (counter.lease_type_ == Lease::TYPE_NA) {
+            return ((counter.lease_state_ == Lease::STATE_DEFAULT) ||
+                    (counter.lease_state_ == Lease::STATE_DECLINED));
+        }
+        return ((counter.lease_type_ == Lease::TYPE_PD) &&
+                (counter.lease_state_ == Lease::STATE_DEFAULT));
+    }
+
     /// @brief A vector containing the "result set"
     std::vector<LeaseStatsRow> rows_;
 
@@ -318,37 +375,38 @@ protected:
 /// @brief Memfile derivation of the IPv4 statistical lease data query
 ///
 /// This class is used to recalculate IPv4 lease statistics for Memfile
-/// lease storage.  It does so by iterating over the given storage,
-/// accumulating counts of leases in each of the monitored lease states
-/// for each subnet and storing these counts in an internal collection.
-/// The populated result set will contain one entry per monitored state
-/// per subnet.
+/// lease storage.  It does so by reading the lease statistics counters
+/// maintained by the backend as the leases are added, updated and
+/// deleted, so the leases are not walked.  The populated result set will
+/// contain one entry per monitored state per subnet.
 ///
 class MemfileLeaseStatsQuery4 : public MemfileLeaseStatsQuery {
 public:
     /// @brief Constructor for an all subnets query
     ///
-    /// @param storage4 A pointer to the v4 lease storage to be counted
-    MemfileLeaseStatsQuery4(Lease4Storage& storage4)
-        : MemfileLeaseStatsQuery(), storage4_(storage4) {
+    /// @param stats4 The v4 lease statistics counters
+    MemfileLeaseStatsQuery4(const LeaseStatsCounters& stats4)
+        : MemfileLeaseStatsQuery(), stats4_(stats4) {
     };
 
     /// @brief Constructor for a single subnet query
     ///
-    /// @param storage4 A pointer to the v4 lease storage to be counted
+    /// @param stats4 The v4 lease statistics counters
     /// @param subnet_id ID of the desired subnet
-    MemfileLeaseStatsQuery4(Lease4Storage& storage4, const SubnetID& subnet_id)
-        : MemfileLeaseStatsQuery(subnet_id), storage4_(storage4) {
+    MemfileLeaseStatsQuery4(const LeaseStatsCounters& stats4,
+                            const SubnetID& subnet_id)
+        : MemfileLeaseStatsQuery(subnet_id), stats4_(stats4) {
     };
 
     /// @brief Constructor for a subnet range query
     ///
-    /// @param storage4 A pointer to the v4 lease storage to be counted
+    /// @param stats4 The v4 lease statistics counters
     /// @param first_subnet_id ID of the first subnet in the desired range
     /// @param last_subnet_id ID of the last subnet in the desired range
-    MemfileLeaseStatsQuery4(Lease4Storage& storage4, const SubnetID& first_subnet_id,
+    MemfileLeaseStatsQuery4(const LeaseStatsCounters& stats4,
+                            const SubnetID& first_subnet_id,
                             const SubnetID& last_subnet_id)
-        : MemfileLeaseStatsQuery(first_subnet_id, last_subnet_id), storage4_(storage4) {
+        : MemfileLeaseStatsQuery(first_subnet_id, last_subnet_id), stats4_(stats4) {
     };
 
     /// @brief Destructor
@@ -356,141 +414,71 @@ public:
 
     /// @brief Creates the IPv4 lease statistical data result set
     ///
-    /// The result set is populated by iterating over the IPv4 leases in
-    /// storage, in ascending order by address, accumulating the lease state
-    /// counts per subnet.
-    /// At the completion of all entries for a given subnet, the counts are
-    /// used to create LeaseStatsRow instances which are appended to an
-    /// internal vector.  The process results in a vector containing one entry
-    /// per state per subnet.
+    /// The result set is populated from the counters of the subnets
+    /// selected by the query, in ascending order by subnet id. The process
+    /// results in a vector containing one entry per state per subnet.
     ///
     /// Currently the states counted are:
     ///
     /// - Lease::STATE_DEFAULT (i.e. assigned)
     /// - Lease::STATE_DECLINED
     void start() {
-        const Lease4StorageSubnetIdIndex& idx
-            = storage4_.get<SubnetIdIndexTag>();
-
-        // Set lower and upper bounds based on select mode
-        Lease4StorageSubnetIdIndex::const_iterator lower;
-        Lease4StorageSubnetIdIndex::const_iterator upper;
-        switch (getSelectMode()) {
-        case ALL_SUBNETS:
-            lower = idx.begin();
-            upper = idx.end();
-            break;
-
-        case SINGLE_SUBNET:
-            lower = idx.lower_bound(getFirstSubnetID());
-            upper = idx.upper_bound(getFirstSubnetID());
-            break;
-
-        case SUBNET_RANGE:
-            lower = idx.lower_bound(getFirstSubnetID());
-            upper = idx.upper_bound(getLastSubnetID());
-            break;
-        }
-
-        // Return an empty set if there are no rows.
-        if (lower == upper) {
-            return;
-        }
-
-        // Iterate over the leases in order by subnet, accumulating per
-        // subnet counts for each state of interest.  As we finish each
-        // subnet, add the appropriate rows to our result set.
-        SubnetID cur_id = 0;
-        int64_t assigned = 0;
-        int64_t declined = 0;
-        for (Lease4StorageSubnetIdIndex::const_iterator lease = lower;
-             lease != upper; ++lease) {
-            // If we've hit the next subnet, add rows for the current subnet
-            // and wipe the accumulators
-            if ((*lease)->subnet_id_ != cur_id) {
-                if (cur_id > 0) {
-                    if (assigned > 0) {
-                        rows_.push_back(LeaseStatsRow(cur_id,
-                                                      Lease::STATE_DEFAULT,
-                                                      assigned));
-                        assigned = 0;
-                    }
-
-                    if (declined > 0) {
-                        rows_.push_back(LeaseStatsRow(cur_id,
-                                                      Lease::STATE_DECLINED,
-                                                      declined));
-                        declined = 0;
-                    }
-                }
-
-                // Update current subnet id
-                cur_id = (*lease)->subnet_id_;
-            }
-
-            // Bump the appropriate accumulator
-            if ((*lease)->state_ == Lease::STATE_DEFAULT) {
-                ++assigned;
-            } else if ((*lease)->state_ == Lease::STATE_DECLINED) {
-                ++declined;
+        std::vector<LeaseStatsRow> counters;
+        getSubnetCounters(stats4_, counters);
+        for (auto const& counter : counters) {
+            if ((counter.lease_state_ == Lease::STATE_DEFAULT) ||
+                (counter.lease_state_ == Lease::STATE_DECLINED)) {
+                rows_.push_back(LeaseStatsRow(counter.subnet_id_,
+                                              counter.lease_state_,
+                                              counter.state_count_));
             }
         }
 
-        // Make the rows for last subnet
-        if (assigned > 0) {
-            rows_.push_back(LeaseStatsRow(cur_id, Lease::STATE_DEFAULT,
-                                          assigned));
-        }
-
-        if (declined > 0) {
-            rows_.push_back(LeaseStatsRow(cur_id, Lease::STATE_DECLINED,
-                                          declined));
-        }
-
         // Reset the next row position back to the beginning of the rows.
         next_pos_ = rows_.begin();
     }
 
 private:
-    /// @brief The Memfile storage containing the IPv4 leases to analyze
-    Lease4Storage& storage4_;
+    /// @brief The lease statistics counters of the IPv4 leases
+    const LeaseStatsCounters& stats4_;
 };
 
 
 /// @brief Memfile derivation of the IPv6 statistical lease data query
 ///
 /// This class is used to recalculate IPv6 lease statistics for Memfile
-/// lease storage.  It does so by iterating over the given storage,
-/// accumulating counts of leases in each of the monitored lease states
-/// for each subnet and storing these counts in an internal collection.
-/// The populated result set will contain one entry per monitored state
-/// per subnet.
+/// lease storage.  It does so by reading the lease statistics counters
+/// maintained by the backend as the leases are added, updated and
+/// deleted, so the leases are not walked.  The populated result set will
+/// contain one entry per monitored state per lease type per subnet.
 ///
 class MemfileLeaseStatsQuery6 : public MemfileLeaseStatsQuery {
 public:
     /// @brief Constructor
     ///
-    /// @param storage6 A pointer to the v6 lease storage to be counted
-    MemfileLeaseStatsQuery6(Lease6Storage& storage6)
-        : MemfileLeaseStatsQuery(), storage6_(storage6) {
+    /// @param stats6 The v6 lease statistics counters
+    MemfileLeaseStatsQuery6(const LeaseStatsCounters& stats6)
+        : MemfileLeaseStatsQuery(), stats6_(stats6) {
     };
 
     /// @brief Constructor for a single subnet query
     ///
-    /// @param storage6 A pointer to the v6 lease storage to be counted
+    /// @param stats6 The v6 lease statistics counters
     /// @param subnet_id ID of the desired subnet
-    MemfileLeaseStatsQuery6(Lease6Storage& storage6, const SubnetID& subnet_id)
-        : MemfileLeaseStatsQuery(subnet_id), storage6_(storage6) {
+    MemfileLeaseStatsQuery6(const LeaseStatsCounters& stats6,
+                            const SubnetID& subnet_id)
+        : MemfileLeaseStatsQuery(subnet_id), stats6_(stats6) {
     };
 
     /// @brief Constructor for a subnet range query
     ///
-    /// @param storage6 A pointer to the v6 lease storage to be counted
+    /// @param stats6 The v6 lease statistics counters
     /// @param first_subnet_id ID of the first subnet in the desired range
     /// @param last_subnet_id ID of the last subnet in the desired range
-    MemfileLeaseStatsQuery6(Lease6Storage& storage6, const SubnetID& first_subnet_id,
+    MemfileLeaseStatsQuery6(const LeaseStatsCounters& stats6,
+                            const SubnetID& first_subnet_id,
                             const SubnetID& last_subnet_id)
-        : MemfileLeaseStatsQuery(first_subnet_id, last_subnet_id), storage6_(storage6) {
+        : MemfileLeaseStatsQuery(first_subnet_id, last_subnet_id), stats6_(stats6) {
     };
 
     /// @brief Destructor
@@ -498,129 +486,83 @@ public:
 
     /// @brief Creates the IPv6 lease statistical data result set
     ///
-    /// The result set is populated by iterating over the IPv6 leases in
-    /// storage, in ascending order by subnet id, accumulating the lease state
-    /// counts per subnet. At the completion of all entries for a given subnet,
-    /// the counts are used to create LeaseStatsRow instances which are appended
-    /// to an internal vector.  The process results in a vector containing one
-    /// entry per state per lease type per subnet.
+    /// The result set is populated from the counters of the subnets
+    /// selected by the query, in ascending order by subnet id. The process
+    /// results in a vector containing one entry per state per lease type
+    /// per subnet.
     ///
     /// Currently the states counted are:
     ///
     /// - Lease::STATE_DEFAULT (i.e. assigned)
     /// - Lease::STATE_DECLINED
     virtual void start() {
-        // Get the subnet_id index
-        const Lease6StorageSubnetIdIndex& idx
-            = storage6_.get<SubnetIdIndexTag>();
-
-        // Set lower and upper bounds based on select mode
-        Lease6StorageSubnetIdIndex::const_iterator lower;
-        Lease6StorageSubnetIdIndex::const_iterator upper;
-        switch (getSelectMode()) {
-        case ALL_SUBNETS:
-            lower = idx.begin();
-            upper = idx.end();
-            break;
-
-        case SINGLE_SUBNET:
-            lower = idx.lower_bound(getFirstSubnetID());
-            upper = idx.upper_bound(getFirstSubnetID());
-            break;
-
-        case SUBNET_RANGE:
-            lower = idx.lower_bound(getFirstSubnetID());
-            upper = idx.upper_bound(getLastSubnetID());
-            break;
+        std::vector<LeaseStatsRow> counters;
+        getSubnetCounters(stats6_, counters);
+        for (auto const& counter : counters) {
+            if (isCounted6(counter)) {
+                rows_.push_back(counter);
+            }
         }
 
-        // Return an empty set if there are no rows.
-        if (lower == upper) {
-            return;
-        }
+        // Set the next row position to the beginning of the rows.
+        next_pos_ = rows_.begin();
+    }
 
-        // Iterate over the leases in order by subnet, accumulating per
-        // subnet counts for each state of interest.  As we finish each
-        // subnet, add the appropriate rows to our result set.
-        SubnetID cur_id = 0;
-        int64_t assigned = 0;
-        int64_t declined = 0;
-        int64_t assigned_pds = 0;
-        for (Lease6StorageSubnetIdIndex::const_iterator lease = lower;
-             lease != upper; ++lease) {
-            // If we've hit the next subnet, add rows for the current subnet
-            // and wipe the accumulators
-            if ((*lease)->subnet_id_ != cur_id) {
-                if (cur_id > 0) {
-                    if (assigned > 0) {
-                        rows_.push_back(LeaseStatsRow(cur_id, Lease::TYPE_NA,
-                                                      Lease::STATE_DEFAULT,
-                                                      assigned));
-                        assigned = 0;
-                    }
-
-                    if (declined > 0) {
-                        rows_.push_back(LeaseStatsRow(cur_id, Lease::TYPE_NA,
-                                                      Lease::STATE_DECLINED,
-                                                      declined));
-                        declined = 0;
-                    }
-
-                    if (assigned_pds > 0) {
-                        rows_.push_back(LeaseStatsRow(cur_id, Lease::TYPE_PD,
-                                                      Lease::STATE_DEFAULT,
-                                                      assigned_pds));
-                        assigned_pds = 0;
-                    }
-                }
+private:
+    /// @brief The lease statistics counters of the IPv6 leases
+    const LeaseStatsCounters& stats6_;
+};
 
-                // Update current subnet id
-                cur_id = (*lease)->subnet_id_;
-            }
+/// @brief Memfile derivation of the pool statistical lease data query
+///
+/// This class returns the pool counters of the lease statistics counters.
+/// The pools must have been set in the counters before the query is
+/// started.
+class MemfilePoolLeaseStatsQuery : public MemfileLeaseStatsQuery {
+public:
+    /// @brief Constructor
+    ///
+    /// @param stats The lease statistics counters
+    /// @param v4 Flag indicating if the counters are the IPv4 ones
+    MemfilePoolLeaseStatsQuery(const LeaseStatsCounters& stats, const bool v4)
+        : MemfileLeaseStatsQuery(), stats_(stats), v4_(v4) {
+    };
 
-            // Bump the appropriate accumulator
-            if ((*lease)->state_ == Lease::STATE_DEFAULT) {
-                switch((*lease)->type_) {
-                case Lease::TYPE_NA:
-                    ++assigned;
-                    break;
-                case Lease::TYPE_PD:
-                    ++assigned_pds;
-                    break;
-                default:
-                    break;
-                }
-            } else if ((*lease)->state_ == Lease::STATE_DECLINED) {
-                // In theory only NAs can be declined
-                if (((*lease)->type_) == Lease::TYPE_NA) {
-                    ++declined;
+    /// @brief Destructor
+    virtual ~MemfilePoolLeaseStatsQuery() {};
+
+    /// @brief Creates the pool lease statistical data result set
+    ///
+    /// The states counted are the same as for the subnet queries. The IPv4
+    /// rows use the Lease::TYPE_NA type as the subnet rows.
+    virtual void start() {
+        std::vector<LeaseStatsRow> counters;
+        stats_.getPoolRows(counters);
+        for (auto const& counter : counters) {
+            if (v4_) {
+                if ((counter.lease_state_ == Lease::STATE_DEFAULT) ||
+                    (counter.lease_state_ == Lease::STATE_DECLINED)) {
+                    rows_.push_back(LeaseStatsRow(counter.subnet_id_,
+                                                  counter.pool_id_,
+                                                  Lease::TYPE_NA,
+                                                  counter.lease_state_,
+                                                  counter.state_count_));
                 }
+            } else if (isCounted6(counter)) {
+                rows_.push_back(counter);
             }
         }
 
-        // Make the rows for last subnet, unless there were no rows
-        if (assigned > 0) {
-            rows_.push_back(LeaseStatsRow(cur_id, Lease::TYPE_NA,
-                                          Lease::STATE_DEFAULT, assigned));
-        }
-
-        if (declined > 0) {
-            rows_.push_back(LeaseStatsRow(cur_id, Lease::TYPE_NA,
-                                          Lease::STATE_DECLINED, declined));
-        }
-
-        if (assigned_pds > 0) {
-            rows_.push_back(LeaseStatsRow(cur_id, Lease::TYPE_PD,
-                                          Lease::STATE_DEFAULT, assigned_pds));
-        }
-
         // Set the next row position to the beginning of the rows.
         next_pos_ = rows_.begin();
     }
 
 private:
-    /// @brief The Memfile storage containing the IPv6 leases to analyze
-    Lease6Storage& storage6_;
+    /// @brief The lease statistics counters
+    const LeaseStatsCounters& stats_;
+
+    /// @brief IPv4 flag
+    bool v4_;
 };
 
 // Explicit definition of class static constants.  Values are given in the
@@ -642,6 +584,11 @@ Memfile_LeaseMgr::Memfile_LeaseMgr(const DatabaseConnection::ParameterMap& param
                                                                 lease_file4_,
                                                                 storage4_);
         }
+        // This is the only time the leases are walked to count them: the
+        // counters are then maintained on each lease change.
+        for (auto const& lease : storage4_) {
+            lease_stats4_.addLease(*lease, Lease::TYPE_V4);
+        }
     } else {
         std::string file6 = initLeaseFilePath(V6);
         if (!file6.empty()) {
@@ -650,6 +597,9 @@ Memfile_LeaseMgr::Memfile_LeaseMgr(const DatabaseConnection::ParameterMap& param
                                                                 lease_file6_,
                                                                 storage6_);
         }
+        for (auto const& lease : storage6_) {
+            lease_stats6_.addLease(*lease, lease->type_);
+        }
     }
 
     // If lease persistence have been disabled for both v4 and v6,
@@ -700,12 +650,15 @@ Memfile_LeaseMgr::addLeaseInternal(const Lease4Ptr& lease) {
         lease_file4_->append(*lease);
     }
 
-    storage4_.insert(lease);
-
     // Update lease current expiration time (allows update between the creation
     // of the Lease up to the point of insertion in the database).
     lease->updateCurrentExpirationTime();
 
+    // Insert a copy of the lease: a change of the lease by the caller must
+    // not affect the indexes of the storage and the lease statistics.
+    storage4_.insert(Lease4Ptr(new Lease4(*lease)));
+    lease_stats4_.addLease(*lease, Lease::TYPE_V4);
+
     return (true);
 }
 
@@ -736,12 +689,15 @@ Memfile_LeaseMgr::addLeaseInternal(const Lease6Ptr& lease) {
         lease_file6_->append(*lease);
     }
 
-    storage6_.insert(lease);
-
     // Update lease current expiration time (allows update between the creation
     // of the Lease up to the point of insertion in the database).
     lease->updateCurrentExpirationTime();
 
+    // Insert a copy of the lease: a change of the lease by the caller must
+    // not affect the indexes of the storage and the lease statistics.
+    storage6_.insert(Lease6Ptr(new Lease6(*lease)));
+    lease_stats6_.addLease(*lease, lease->type_);
+
     return (true);
 }
 
@@ -1036,6 +992,124 @@ Memfile_LeaseMgr::getLeases4(const asiolink::IOAddress& lower_bound_address,
     return (collection);
 }
 
+void
+Memfile_LeaseMgr::getStoredLeases4Internal(const asiolink::IOAddress& lower_bound_address,
+                                          const bool include_lower_bound,
+                                          const size_t max_count,
+                                          Lease4Collection& collection) const {
+    const Lease4StorageAddressIndex& idx = storage4_.get<AddressIndexTag>();
+    Lease4StorageAddressIndex::const_iterator lb = idx.lower_bound(lower_bound_address);
+
+    // Exclude the lower bound address unless requested.
+    if (!include_lower_bound && (lb != idx.end()) &&
+        ((*lb)->addr_ == lower_bound_address)) {
+        ++lb;
+    }
+
+    // The stored leases are replaced rather than modified by the updates,
+    // so they can be used after the lock is released without copying them.
+    for (auto lease = lb;
+         (lease != idx.end()) && (collection.size() < max_count);
+         ++lease) {
+        collection.push_back(*lease);
+    }
+}
+
+void
+Memfile_LeaseMgr::walkLeases4Chunks(const asiolink::IOAddress& lower_bound_address,
+                                   const bool include_lower_bound,
+                                   const size_t max_count,
+                                   const Lease4Callback& callback) const {
+    asiolink::IOAddress lower_bound(lower_bound_address);
+    bool include_lower = include_lower_bound;
+    size_t remaining = max_count;
+    Lease4Collection chunk;
+    while (remaining > 0) {
+        // Collect the next chunk under the lock and call the callback
+        // outside of it, so the walk does not block the packet processing.
+        size_t chunk_size = std::min(remaining, WALK_CHUNK_SIZE);
+        chunk.clear();
+        if (MultiThreadingMgr::instance().getMode()) {
+            std::lock_guard<std::mutex> lock(*mutex_);
+            getStoredLeases4Internal(lower_bound, include_lower, chunk_size, chunk);
+        } else {
+            getStoredLeases4Internal(lower_bound, include_lower, chunk_size, chunk);
+        }
+
+        for (auto const& lease : chunk) {
+            callback(*lease);
+        }
+
+        if (chunk.size() < chunk_size) {
+            break;
+        }
+
+        remaining -= chunk.size();
+        lower_bound = chunk.back()->addr_;
+        include_lower = false;
+    }
+}
+
+void
+Memfile_LeaseMgr::walkLeases4(const Lease4Callback& callback) const {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_MEMFILE_GET4);
+
+    walkLeases4Chunks(asiolink::IOAddress::IPV4_ZERO_ADDRESS(), true,
+                      std::numeric_limits<size_t>::max(), callback);
+}
+
+void
+Memfile_LeaseMgr::getStoredLeases4Internal(SubnetID subnet_id,
+                                          Lease4Collection& collection) const {
+    const Lease4StorageSubnetIdIndex& idx = storage4_.get<SubnetIdIndexTag>();
+    std::pair<Lease4StorageSubnetIdIndex::const_iterator,
+              Lease4StorageSubnetIdIndex::const_iterator> l =
+        idx.equal_range(subnet_id);
+
+    collection.insert(collection.end(), l.first, l.second);
+}
+
+void
+Memfile_LeaseMgr::walkLeases4(SubnetID subnet_id,
+                             const Lease4Callback& callback) const {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_MEMFILE_GET_SUBID4)
+        .arg(subnet_id);
+
+    // The subnet index is not unique so the walk can't be resumed from
+    // a lease: the leases are collected at once and the callback is
+    // called after the lock is released.
+    Lease4Collection collection;
+    if (MultiThreadingMgr::instance().getMode()) {
+        std::lock_guard<std::mutex> lock(*mutex_);
+        getStoredLeases4Internal(subnet_id, collection);
+    } else {
+        getStoredLeases4Internal(subnet_id, collection);
+    }
+
+    for (auto const& lease : collection) {
+        callback(*lease);
+    }
+}
+
+void
+Memfile_LeaseMgr::walkLeases4(const asiolink::IOAddress& lower_bound_address,
+                             const LeasePageSize& page_size,
+                             const Lease4Callback& callback) const {
+    // Expecting IPv4 address.
+    if (!lower_bound_address.isV4()) {
+        isc_throw(InvalidAddressFamily, "expected IPv4 address while "
+                  "retrieving leases from the lease database, got "
+                  << lower_bound_address);
+    }
+
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_MEMFILE_GET_PAGE4)
+        .arg(page_size.page_size_)
+        .arg(lower_bound_address.toText());
+
+    walkLeases4Chunks(lower_bound_address, false, page_size.page_size_,
+                      callback);
+}
+
 Lease6Ptr
 Memfile_LeaseMgr::getLease6Internal(Lease::Type type,
                                     const isc::asiolink::IOAddress& addr) const {
@@ -1301,6 +1375,124 @@ Memfile_LeaseMgr::getLeases6(const asiolink::IOAddress& lower_bound_address,
     return (collection);
 }
 
+void
+Memfile_LeaseMgr::getStoredLeases6Internal(const asiolink::IOAddress& lower_bound_address,
+                                          const bool include_lower_bound,
+                                          const size_t max_count,
+                                          Lease6Collection& collection) const {
+    const Lease6StorageAddressIndex& idx = storage6_.get<AddressIndexTag>();
+    Lease6StorageAddressIndex::const_iterator lb = idx.lower_bound(lower_bound_address);
+
+    // Exclude the lower bound address unless requested.
+    if (!include_lower_bound && (lb != idx.end()) &&
+        ((*lb)->addr_ == lower_bound_address)) {
+        ++lb;
+    }
+
+    // The stored leases are replaced rather than modified by the updates,
+    // so they can be used after the lock is released without copying them.
+    for (auto lease = lb;
+         (lease != idx.end()) && (collection.size() < max_count);
+         ++lease) {
+        collection.push_back(*lease);
+    }
+}
+
+void
+Memfile_LeaseMgr::walkLeases6Chunks(const asiolink::IOAddress& lower_bound_address,
+                                   const bool include_lower_bound,
+                                   const size_t max_count,
+                                   const Lease6Callback& callback) const {
+    asiolink::IOAddress lower_bound(lower_bound_address);
+    bool include_lower = include_lower_bound;
+    size_t remaining = max_count;
+    Lease6Collection chunk;
+    while (remaining > 0) {
+        // Collect the next chunk under the lock and call the callback
+        // outside of it, so the walk does not block the packet processing.
+        size_t chunk_size = std::min(remaining, WALK_CHUNK_SIZE);
+        chunk.clear();
+        if (MultiThreadingMgr::instance().getMode()) {
+            std::lock_guard<std::mutex> lock(*mutex_);
+            getStoredLeases6Internal(lower_bound, include_lower, chunk_size, chunk);
+        } else {
+            getStoredLeases6Internal(lower_bound, include_lower, chunk_size, chunk);
+        }
+
+        for (auto const& lease : chunk) {
+            callback(*lease);
+        }
+
+        if (chunk.size() < chunk_size) {
+            break;
+        }
+
+        remaining -= chunk.size();
+        lower_bound = chunk.back()->addr_;
+        include_lower = false;
+    }
+}
+
+void
+Memfile_LeaseMgr::walkLeases6(const Lease6Callback& callback) const {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_MEMFILE_GET6);
+
+    walkLeases6Chunks(asiolink::IOAddress::IPV6_ZERO_ADDRESS(), true,
+                      std::numeric_limits<size_t>::max(), callback);
+}
+
+void
+Memfile_LeaseMgr::getStoredLeases6Internal(SubnetID subnet_id,
+                                          Lease6Collection& collection) const {
+    const Lease6StorageSubnetIdIndex& idx = storage6_.get<SubnetIdIndexTag>();
+    std::pair<Lease6StorageSubnetIdIndex::const_iterator,
+              Lease6StorageSubnetIdIndex::const_iterator> l =
+        idx.equal_range(subnet_id);
+
+    collection.insert(collection.end(), l.first, l.second);
+}
+
+void
+Memfile_LeaseMgr::walkLeases6(SubnetID subnet_id,
+                             const Lease6Callback& callback) const {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_MEMFILE_GET_SUBID6)
+        .arg(subnet_id);
+
+    // The subnet index is not unique so the walk can't be resumed from
+    // a lease: the leases are collected at once and the callback is
+    // called after the lock is released.
+    Lease6Collection collection;
+    if (MultiThreadingMgr::instance().getMode()) {
+        std::lock_guard<std::mutex> lock(*mutex_);
+        getStoredLeases6Internal(subnet_id, collection);
+    } else {
+        getStoredLeases6Internal(subnet_id, collection);
+    }
+
+    for (auto const& lease : collection) {
+        callback(*lease);
+    }
+}
+
+void
+Memfile_LeaseMgr::walkLeases6(const asiolink::IOAddress& lower_bound_address,
+                             const LeasePageSize& page_size,
+                             const Lease6Callback& callback) const {
+    // Expecting IPv6 address.
+    if (!lower_bound_address.isV6()) {
+        isc_throw(InvalidAddressFamily, "expected IPv6 address while "
+                  "retrieving leases from the lease database, got "
+                  << lower_bound_address);
+    }
+
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_MEMFILE_GET_PAGE6)
+        .arg(page_size.page_size_)
+        .arg(lower_bound_address.toText());
+
+    walkLeases6Chunks(lower_bound_address, false, page_size.page_size_,
+                      callback);
+}
+
 void
 Memfile_LeaseMgr::getExpiredLeases4Internal(Lease4Collection& expired_leases,
                                             const size_t max_leases) const {
@@ -1403,6 +1595,8 @@ Memfile_LeaseMgr::updateLease4Internal(const Lease4Ptr& lease) {
     // Update lease current expiration time.
     lease->updateCurrentExpirationTime();
 
+    lease_stats4_.updateLease(**lease_it, *lease, Lease::TYPE_V4);
+
     // Use replace() to re-index leases.
     index.replace(lease_it, Lease4Ptr(new Lease4(*lease)));
 }
@@ -1450,6 +1644,8 @@ Memfile_LeaseMgr::updateLease6Internal(const Lease6Ptr& lease) {
     // Update lease current expiration time.
     lease->updateCurrentExpirationTime();
 
+    lease_stats6_.updateLease(**lease_it, *lease, lease->type_);
+
     // Use replace() to re-index leases.
     index.replace(lease_it, Lease6Ptr(new Lease6(*lease)));
 }
@@ -1491,6 +1687,7 @@ Memfile_LeaseMgr::deleteLeaseInternal(const Lease4Ptr& lease) {
                 return false;
             }
         }
+        lease_stats4_.deleteLease(**l, Lease::TYPE_V4);
         storage4_.erase(l);
         return (true);
     }
@@ -1533,6 +1730,7 @@ Memfile_LeaseMgr::deleteLeaseInternal(const Lease6Ptr& lease) {
                 return false;
             }
         }
+        lease_stats6_.deleteLease(**l, (*l)->type_);
         storage6_.erase(l);
         return (true);
     }
@@ -1561,11 +1759,11 @@ Memfile_LeaseMgr::deleteExpiredReclaimedLeases4(const uint32_t secs) {
         std::lock_guard<std::mutex> lock(*mutex_);
         return (deleteExpiredReclaimedLeases<
                 Lease4StorageExpirationIndex, Lease4
-                >(secs, V4, storage4_, lease_file4_));
+                >(secs, V4, storage4_, lease_file4_, lease_stats4_));
     } else {
         return (deleteExpiredReclaimedLeases<
                 Lease4StorageExpirationIndex, Lease4
-                >(secs, V4, storage4_, lease_file4_));
+                >(secs, V4, storage4_, lease_file4_, lease_stats4_));
     }
 }
 
@@ -1579,11 +1777,11 @@ Memfile_LeaseMgr::deleteExpiredReclaimedLeases6(const uint32_t secs) {
         std::lock_guard<std::mutex> lock(*mutex_);
         return (deleteExpiredReclaimedLeases<
                 Lease6StorageExpirationIndex, Lease6
-                >(secs, V6, storage6_, lease_file6_));
+                >(secs, V6, storage6_, lease_file6_, lease_stats6_));
     } else {
         return (deleteExpiredReclaimedLeases<
                 Lease6StorageExpirationIndex, Lease6
-                >(secs, V6, storage6_, lease_file6_));
+                >(secs, V6, storage6_, lease_file6_, lease_stats6_));
     }
 }
 
@@ -1593,7 +1791,8 @@ uint64_t
 Memfile_LeaseMgr::deleteExpiredReclaimedLeases(const uint32_t secs,
                                                const Universe& universe,
                                                StorageType& storage,
-                                               LeaseFileType& lease_file) const {
+                                               LeaseFileType& lease_file,
+                                               LeaseStatsCounters& stats) const {
     // Obtain the index which segragates leases by state and time.
     IndexType& index = storage.template get<ExpirationIndexTag>();
 
@@ -1642,6 +1841,11 @@ Memfile_LeaseMgr::deleteExpiredReclaimedLeases(const uint32_t secs,
             }
         }
 
+        for (typename IndexType::const_iterator lease = lower_limit;
+             lease != upper_limit; ++lease) {
+            stats.deleteLease(**lease, statsLeaseType(**lease));
+        }
+
         // Erase leases from memory.
         index.erase(lower_limit, upper_limit);
     }
@@ -1937,47 +2141,115 @@ Memfile_LeaseMgr::lfcExecute(boost::shared_ptr<LeaseFileType>& lease_file) {
 
 LeaseStatsQueryPtr
 Memfile_LeaseMgr::startLeaseStatsQuery4() {
-    LeaseStatsQueryPtr query(new MemfileLeaseStatsQuery4(storage4_));
-    query->start();
+    LeaseStatsQueryPtr query(new MemfileLeaseStatsQuery4(lease_stats4_));
+    startLeaseStatsQuery(query);
     return(query);
 }
 
 LeaseStatsQueryPtr
 Memfile_LeaseMgr::startSubnetLeaseStatsQuery4(const SubnetID& subnet_id) {
-    LeaseStatsQueryPtr query(new MemfileLeaseStatsQuery4(storage4_, subnet_id));
-    query->start();
+    LeaseStatsQueryPtr query(new MemfileLeaseStatsQuery4(lease_stats4_, subnet_id));
+    startLeaseStatsQuery(query);
     return(query);
 }
 
 LeaseStatsQueryPtr
 Memfile_LeaseMgr::startSubnetRangeLeaseStatsQuery4(const SubnetID& first_subnet_id,
                                                    const SubnetID& last_subnet_id) {
-    LeaseStatsQueryPtr query(new MemfileLeaseStatsQuery4(storage4_, first_subnet_id,
+    LeaseStatsQueryPtr query(new MemfileLeaseStatsQuery4(lease_stats4_, first_subnet_id,
                                                          last_subnet_id));
-    query->start();
+    startLeaseStatsQuery(query);
     return(query);
 }
 
 LeaseStatsQueryPtr
 Memfile_LeaseMgr::startLeaseStatsQuery6() {
-    LeaseStatsQueryPtr query(new MemfileLeaseStatsQuery6(storage6_));
-    query->start();
+    LeaseStatsQueryPtr query(new MemfileLeaseStatsQuery6(lease_stats6_));
+    startLeaseStatsQuery(query);
     return(query);
 }
 
 LeaseStatsQueryPtr
 Memfile_LeaseMgr::startSubnetLeaseStatsQuery6(const SubnetID& subnet_id) {
-    LeaseStatsQueryPtr query(new MemfileLeaseStatsQuery6(storage6_, subnet_id));
-    query->start();
+    LeaseStatsQueryPtr query(new MemfileLeaseStatsQuery6(lease_stats6_, subnet_id));
+    startLeaseStatsQuery(query);
     return(query);
 }
 
 LeaseStatsQueryPtr
 Memfile_LeaseMgr::startSubnetRangeLeaseStatsQuery6(const SubnetID& first_subnet_id,
                                                    const SubnetID& last_subnet_id) {
-    LeaseStatsQueryPtr query(new MemfileLeaseStatsQuery6(storage6_, first_subnet_id,
+    LeaseStatsQueryPtr query(new MemfileLeaseStatsQuery6(lease_stats6_, first_subnet_id,
                                                          last_subnet_id));
-    query->start();
+    startLeaseStatsQuery(query);
+    return(query);
+}
+
+void
+Memfile_LeaseMgr::startLeaseStatsQuery(const LeaseStatsQueryPtr& query) {
+    if (MultiThreadingMgr::instance().getMode()) {
+        std::lock_guard<std::mutex> lock(*mutex_);
+        query->start();
+    } else {
+        query->start();
+    }
+}
+
+void
+Memfile_LeaseMgr::setStatsPools4Internal(const LeaseStatsPoolCollection& pools) {
+    // Only the leases of the new pools are counted, using the address index.
+    const Lease4StorageAddressIndex& idx = storage4_.get<AddressIndexTag>();
+    lease_stats4_.setPools(pools,
+        [&idx](const Lease::Type, const IOAddress& first, const IOAddress& last,
+               LeaseStatsCounters::StateCounts& counts) {
+            auto upper = idx.upper_bound(last);
+            for (auto lease = idx.lower_bound(first); lease != upper; ++lease) {
+                ++counts[(*lease)->state_];
+            }
+        });
+}
+
+void
+Memfile_LeaseMgr::setStatsPools6Internal(const LeaseStatsPoolCollection& pools) {
+    // Only the leases of the new pools are counted, using the address index.
+    const Lease6StorageAddressIndex& idx = storage6_.get<AddressIndexTag>();
+    lease_stats6_.setPools(pools,
+        [&idx](const Lease::Type type, const IOAddress& first, const IOAddress& last,
+               LeaseStatsCounters::StateCounts& counts) {
+            auto upper = idx.upper_bound(last);
+            for (auto lease = idx.lower_bound(first); lease != upper; ++lease) {
+                if ((*lease)->type_ == type) {
+                    ++counts[(*lease)->state_];
+                }
+            }
+        });
+}
+
+LeaseStatsQueryPtr
+Memfile_LeaseMgr::startPoolLeaseStatsQuery4(const LeaseStatsPoolCollection& pools) {
+    LeaseStatsQueryPtr query(new MemfilePoolLeaseStatsQuery(lease_stats4_, true));
+    if (MultiThreadingMgr::instance().getMode()) {
+        std::lock_guard<std::mutex> lock(*mutex_);
+        setStatsPools4Internal(pools);
+        query->start();
+    } else {
+        setStatsPools4Internal(pools);
+        query->start();
+    }
+    return(query);
+}
+
+LeaseStatsQueryPtr
+Memfile_LeaseMgr::startPoolLeaseStatsQuery6(const LeaseStatsPoolCollection& pools) {
+    LeaseStatsQueryPtr query(new MemfilePoolLeaseStatsQuery(lease_stats6_, false));
+    if (MultiThreadingMgr::instance().getMode()) {
+        std::lock_guard<std::mutex> lock(*mutex_);
+        setStatsPools6Internal(pools);
+        query->start();
+    } else {
+        setStatsPools6Internal(pools);
+        query->start();
+    }
     return(query);
 }
 
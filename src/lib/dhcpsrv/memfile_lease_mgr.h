@@ -15,6 +15,7 @@
 #include <dhcpsrv/csv_lease_file6.h>
 #include <dhcpsrv/memfile_lease_storage.h>
 #include <dhcpsrv/lease_mgr.h>
+#include <dhcpsrv/lease_stats_counters.h>
 
 #include <boost/scoped_ptr.hpp>
 #include <boost/shared_ptr.hpp>
@@ -262,6 +263,36 @@ public:
     getLeases4(const asiolink::IOAddress& lower_bound_address,
                const LeasePageSize& page_size) const;
 
+    /// @brief Passes all IPv4 leases to a callback.
+    ///
+    /// The leases are collected in chunks while the lease storage is
+    /// locked and passed to the callback after it is unlocked, so the
+    /// callback does not block the packet processing. The stored leases
+    /// are replaced rather than modified by the updates, so they are passed
+    /// without copying them. The leases added or deleted during the walk
+    /// may or may not be passed.
+    ///
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases4(const Lease4Callback& callback) const;
+
+    /// @brief Passes all IPv4 leases for the particular subnet identifier
+    /// to a callback.
+    ///
+    /// @param subnet_id subnet identifier.
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases4(SubnetID subnet_id,
+                             const Lease4Callback& callback) const;
+
+    /// @brief Passes a page of IPv4 leases to a callback.
+    ///
+    /// @param lower_bound_address IPv4 address used as lower bound for the
+    /// range.
+    /// @param page_size maximum size of the page.
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases4(const asiolink::IOAddress& lower_bound_address,
+                             const LeasePageSize& page_size,
+                             const Lease4Callback& callback) const;
+
     /// @brief Returns existing IPv6 lease for a given IPv6 address.
     ///
     /// This function returns a copy of the lease. The modification in the
@@ -355,6 +386,36 @@ public:
     getLeases6(const asiolink::IOAddress& lower_bound_address,
                const LeasePageSize& page_size) const;
 
+    /// @brief Passes all IPv6 leases to a callback.
+    ///
+    /// The leases are collected in chunks while the lease storage is
+    /// locked and passed to the callback after it is unlocked, so the
+    /// callback does not block the packet processing. The stored leases
+    /// are replaced rather than modified by the updates, so they are passed
+    /// without copying them. The leases added or deleted during the walk
+    /// may or may not be passed.
+    ///
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases6(const Lease6Callback& callback) const;
+
+    /// @brief Passes all IPv6 leases for the particular subnet identifier
+    /// to a callback.
+    ///
+    /// @param subnet_id subnet identifier.
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases6(SubnetID subnet_id,
+                             const Lease6Callback& callback) const;
+
+    /// @brief Passes a page of IPv6 leases to a callback.
+    ///
+    /// @param lower_bound_address IPv6 address used as lower bound for the
+    /// range.
+    /// @param page_size maximum size of the page.
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases6(const asiolink::IOAddress& lower_bound_address,
+                             const LeasePageSize& page_size,
+                             const Lease6Callback& callback) const;
+
     /// @brief Returns a collection of expired DHCPv4 leases.
     ///
     /// This method returns at most @c max_leases expired leases. The leases
@@ -589,6 +650,46 @@ private:
                             const LeasePageSize& page_size,
                             Lease4Collection& collection) const;
 
+    /// @brief Collects the stored IPv4 leases following an address.
+    ///
+    /// The leases are not copied.
+    ///
+    /// @param lower_bound_address IPv4 address used as lower bound for the
+    /// range.
+    /// @param include_lower_bound include the lease of the lower bound
+    /// address.
+    /// @param max_count maximum number of leases to collect.
+    /// @param [out] collection collection to which the leases are added.
+    void getStoredLeases4Internal(const asiolink::IOAddress& lower_bound_address,
+                                 const bool include_lower_bound,
+                                 const size_t max_count,
+                                 Lease4Collection& collection) const;
+
+    /// @brief Collects the stored IPv4 leases of a subnet.
+    ///
+    /// The leases are not copied.
+    ///
+    /// @param subnet_id subnet identifier.
+    /// @param [out] collection collection to which the leases are added.
+    void getStoredLeases4Internal(SubnetID subnet_id,
+                                 Lease4Collection& collection) const;
+
+    /// @brief Passes the IPv4 leases following an address to a callback.
+    ///
+    /// The leases are collected by chunks under the lock, which is released
+    /// before the callback is invoked for the leases of the chunk.
+    ///
+    /// @param lower_bound_address IPv4 address used as lower bound for the
+    /// range.
+    /// @param include_lower_bound include the lease of the lower bound
+    /// address.
+    /// @param max_count maximum number of leases to pass.
+    /// @param callback callback invoked for each lease.
+    void walkLeases4Chunks(const asiolink::IOAddress& lower_bound_address,
+                          const bool include_lower_bound,
+                          const size_t max_count,
+                          const Lease4Callback& callback) const;
+
     /// @brief Returns existing IPv6 lease for a given IPv6 address.
     ///
     /// @param type specifies lease type: (NA, TA or PD)
@@ -660,6 +761,46 @@ private:
                             const LeasePageSize& page_size,
                             Lease6Collection& collection) const;
 
+    /// @brief Collects the stored IPv6 leases following an address.
+    ///
+    /// The leases are not copied.
+    ///
+    /// @param lower_bound_address IPv6 address used as lower bound for the
+    /// range.
+    /// @param include_lower_bound include the lease of the lower bound
+    /// address.
+    /// @param max_count maximum number of leases to collect.
+    /// @param [out] collection collection to which the leases are added.
+    void getStoredLeases6Internal(const asiolink::IOAddress& lower_bound_address,
+                                 const bool include_lower_bound,
+                                 const size_t max_count,
+                                 Lease6Collection& collection) const;
+
+    /// @brief Collects the stored IPv6 leases of a subnet.
+    ///
+    /// The leases are not copied.
+    ///
+    /// @param subnet_id subnet identifier.
+    /// @param [out] collection collection to which the leases are added.
+    void getStoredLeases6Internal(SubnetID subnet_id,
+                                 Lease6Collection& collection) const;
+
+    /// @brief Passes the IPv6 leases following an address to a callback.
+    ///
+    /// The leases are collected by chunks under the lock, which is released
+    /// before the callback is invoked for the leases of the chunk.
+    ///
+    /// @param lower_bound_address IPv6 address used as lower bound for the
+    /// range.
+    /// @param include_lower_bound include the lease of the lower bound
+    /// address.
+    /// @param max_count maximum number of leases to pass.
+    /// @param callback callback invoked for each lease.
+    void walkLeases6Chunks(const asiolink::IOAddress& lower_bound_address,
+                          const bool include_lower_bound,
+                          const size_t max_count,
+                          const Lease6Callback& callback) const;
+
     /// @brief Returns a collection of expired DHCPv4 leases.
     ///
     /// @param [out] expired_leases A container to which expired leases returned
@@ -772,6 +913,7 @@ private:
     /// Some expired-reclaimed leases will be removed from this container.
     /// @param lease_file Reference to a DHCPv4 or DHCPv6 lease file
     /// instance where leases should be marked as deleted.
+    /// @param stats Reference to the lease statistics counters to update.
     ///
     /// @return Number of leases deleted.
     ///
@@ -788,7 +930,8 @@ private:
     uint64_t deleteExpiredReclaimedLeases(const uint32_t secs,
                                           const Universe& universe,
                                           StorageType& storage,
-                                          LeaseFileType& lease_file) const;
+                                          LeaseFileType& lease_file,
+                                          LeaseStatsCounters& stats) const;
 
 public:
 
@@ -998,6 +1141,15 @@ private:
     /// @brief stores IPv6 leases
     Lease6Storage storage6_;
 
+    /// @brief IPv4 lease statistics counters
+    ///
+    /// Maintained on each lease addition, update and deletion so the lease
+    /// statistics queries do not walk the leases.
+    LeaseStatsCounters lease_stats4_;
+
+    /// @brief IPv6 lease statistics counters
+    LeaseStatsCounters lease_stats6_;
+
     /// @brief Holds the pointer to the DHCPv4 lease file IO.
     boost::shared_ptr<CSVLeaseFile4> lease_file4_;
 
@@ -1084,6 +1236,50 @@ public:
     virtual LeaseStatsQueryPtr startSubnetRangeLeaseStatsQuery6(const SubnetID& first_subnet_id,
                                                                 const SubnetID& last_subnet_id);
 
+    /// @brief Creates and runs the IPv4 lease stats query for pools
+    ///
+    /// The pools are given to the lease statistics counters: only the
+    /// leases of the pools which were not already known are counted. The
+    /// query then returns the pool counters.
+    ///
+    /// @param pools The pools for which the statistics are desired
+    /// @return A populated LeaseStatsQuery
+    virtual LeaseStatsQueryPtr startPoolLeaseStatsQuery4(const LeaseStatsPoolCollection& pools);
+
+    /// @brief Creates and runs the IPv6 lease stats query for pools
+    ///
+    /// The address and prefix pools are given to the lease statistics
+    /// counters: only the leases of the pools which were not already known
+    /// are counted. The query then returns the pool counters.
+    ///
+    /// @param pools The pools for which the statistics are desired
+    /// @return A populated LeaseStatsQuery
+    virtual LeaseStatsQueryPtr startPoolLeaseStatsQuery6(const LeaseStatsPoolCollection& pools);
+
+private:
+
+    /// @brief Starts a lease stats query holding the mutex.
+    ///
+    /// @param query The query to start.
+    void startLeaseStatsQuery(const LeaseStatsQueryPtr& query);
+
+    /// @brief Gives the IPv4 pools to the lease statistics counters.
+    ///
+    /// Must be called holding the mutex.
+    ///
+    /// @param pools The pools.
+    void setStatsPools4Internal(const LeaseStatsPoolCollection& pools);
+
+    /// @brief Gives the IPv6 address and prefix pools to the lease
+    /// statistics counters.
+    ///
+    /// Must be called holding the mutex.
+    ///
+    /// @param pools The pools.
+    void setStatsPools6Internal(const LeaseStatsPoolCollection& pools);
+
+public:
+
     /// @name Protected methods used for %Lease File Cleanup.
     /// The following methods are protected so as they can be accessed and
     /// tested by unit tests.
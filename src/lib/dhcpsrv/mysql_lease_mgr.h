@@ -88,6 +88,11 @@ typedef boost::shared_ptr<MySqlLeaseContextPool> MySqlLeaseContextPoolPtr;
 /// This class provides the \ref isc::dhcp::LeaseMgr interface to the MySQL
 /// database.  Use of this backend presupposes that a MySQL database is
 /// available and that the Kea schema has been created within it.
+///
+/// @todo The batch operations (addLeases, updateLeases and deleteLeases)
+/// are inherited from @ref LeaseMgr, which processes the leases one by
+/// one. They should be overridden with multi-row statements run within a
+/// @ref isc::db::MySqlTransaction.
 
 class MySqlLeaseMgr : public LeaseMgr {
 public:
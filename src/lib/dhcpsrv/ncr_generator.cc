@@ -1,4 +1,4 @@
-// Copyright (C) 2015-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2015-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -11,6 +11,7 @@
 #include <dhcpsrv/dhcpsrv_log.h>
 #include <dhcpsrv/d2_client_mgr.h>
 #include <dhcpsrv/ncr_generator.h>
+#include <dhcpsrv/packet_profiler.h>
 #include <stdint.h>
 #include <vector>
 
@@ -90,6 +91,7 @@ namespace isc {
 namespace dhcp {
 
 void queueNCR(const NameChangeType& chg_type, const Lease4Ptr& lease) {
+    PacketProfiler::StageTimer timer(PacketProfiler::STAGE_DDNS);
     if (lease) {
         // Figure out from the lease's subnet if we should use conflict resolution.
         // If there's no subnet, something hinky is going on so we'll set it true.
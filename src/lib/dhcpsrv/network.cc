@@ -1,4 +1,4 @@
-// Copyright (C) 2017-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2017-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -79,12 +79,13 @@ Network::clientSupported(const isc::dhcp::ClientClasses& classes) const {
         return (true);
     }
 
-    return (classes.contains(client_class_));
+    return (classes.contains(client_class_id_));
 }
 
 void
 Network::allowClientClass(const isc::dhcp::ClientClass& class_name) {
     client_class_ = class_name;
+    client_class_id_ = ClientClassRegistry::instance().intern(class_name);
 }
 
 void
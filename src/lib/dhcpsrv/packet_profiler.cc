@@ -0,0 +1,477 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <cc/command_interpreter.h>
+#include <dhcpsrv/packet_profiler.h>
+#include <exceptions/exceptions.h>
+#include <stats/stats_mgr.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+using namespace isc::config;
+using namespace isc::data;
+using namespace isc::stats;
+using namespace std;
+using namespace std::chrono;
+
+namespace {
+
+/// @brief Number of buckets in each range of values above SUB_BUCKETS.
+const uint64_t HALF_SUB_BUCKETS = isc::dhcp::StageHistogram::SUB_BUCKETS / 2;
+
+/// @brief Minimum interval between two statistics publications.
+const nanoseconds PUBLISH_INTERVAL = seconds(1);
+
+/// @brief Flag set when the packet processed by the thread is profiled.
+thread_local bool sampling = false;
+
+/// @brief Innermost running stage timer of the thread.
+thread_local isc::dhcp::PacketProfiler::StageTimer* current_timer = 0;
+
+} // end of anonymous namespace
+
+namespace isc {
+namespace dhcp {
+
+const unsigned int StageHistogram::SUB_BUCKET_BITS;
+const uint64_t StageHistogram::SUB_BUCKETS;
+const unsigned int StageHistogram::VALUE_BITS;
+const uint64_t StageHistogram::MAX_VALUE;
+const size_t StageHistogram::BUCKETS;
+
+StageHistogram::StageHistogram() : count_(0), sum_(0), max_(0) {
+    for (auto& counter : counts_) {
+        counter.store(0, memory_order_relaxed);
+    }
+}
+
+size_t
+StageHistogram::getBucketIndex(uint64_t value) {
+    if (value < SUB_BUCKETS) {
+        return (value);
+    }
+    value = min(value, MAX_VALUE);
+    unsigned int msb = 0;
+    for (uint64_t v = value; v > 1; v >>= 1) {
+        ++msb;
+    }
+    // Shift which brings the value to the [SUB_BUCKETS/2, SUB_BUCKETS)
+    // range. It is at least 1 here.
+    unsigned int shift = msb - SUB_BUCKET_BITS + 1;
+    return (SUB_BUCKETS + (shift - 1) * HALF_SUB_BUCKETS +
+            ((value >> shift) - HALF_SUB_BUCKETS));
+}
+
+uint64_t
+StageHistogram::getBucketHighest(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return (index);
+    }
+    uint64_t range = index - SUB_BUCKETS;
+    unsigned int shift = range / HALF_SUB_BUCKETS + 1;
+    uint64_t sub = range % HALF_SUB_BUCKETS + HALF_SUB_BUCKETS;
+    return ((sub << shift) + (static_cast<uint64_t>(1) << shift) - 1);
+}
+
+void
+StageHistogram::record(uint64_t nsec) {
+    add(counts_[getBucketIndex(nsec)], 1);
+    add(count_, 1);
+    add(sum_, nsec);
+    if (nsec > max_.load(memory_order_relaxed)) {
+        max_.store(nsec, memory_order_relaxed);
+    }
+}
+
+void
+StageHistogram::merge(const StageHistogram& other) {
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        add(counts_[i], other.counts_[i].load(memory_order_relaxed));
+    }
+    add(count_, other.getCount());
+    add(sum_, other.getSum());
+    max_.store(max(getMax(), other.getMax()), memory_order_relaxed);
+}
+
+void
+StageHistogram::reset() {
+    for (auto& counter : counts_) {
+        counter.store(0, memory_order_relaxed);
+    }
+    count_.store(0, memory_order_relaxed);
+    sum_.store(0, memory_order_relaxed);
+    max_.store(0, memory_order_relaxed);
+}
+
+uint64_t
+StageHistogram::getPercentile(double percentile) const {
+    if ((percentile < 0.) || (percentile > 100.)) {
+        isc_throw(BadValue, "percentile " << percentile
+                  << " is out of range 0..100");
+    }
+    uint64_t count = getCount();
+    if (count == 0) {
+        return (0);
+    }
+    // Rank of the value at the percentile, counted from 1.
+    uint64_t rank = static_cast<uint64_t>(ceil(percentile / 100. * count));
+    rank = max(rank, static_cast<uint64_t>(1));
+    uint64_t cumulated = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        cumulated += counts_[i].load(memory_order_relaxed);
+        if (cumulated >= rank) {
+            return (min(getMax(), getBucketHighest(i)));
+        }
+    }
+    return (getMax());
+}
+
+/// @brief Per thread profiling state.
+struct PacketProfiler::ThreadProfile {
+    /// @brief Constructor.
+    ThreadProfile() : generation_(0), packets_(0), start_() {
+    }
+
+    /// @brief Histograms of the stages.
+    StageHistogram histograms_[STAGE_COUNT];
+
+    /// @brief Generation of the profiler the histograms belong to.
+    std::atomic<uint64_t> generation_;
+
+    /// @brief Number of packets processed by the thread.
+    uint64_t packets_;
+
+    /// @brief Start of the processing of the profiled packet.
+    steady_clock::time_point start_;
+};
+
+/// @brief Holder of the state of a thread.
+///
+/// The state is unregistered when the thread exits.
+struct PacketProfiler::ThreadProfileHolder {
+    /// @brief Destructor.
+    ~ThreadProfileHolder() {
+        if (profile_) {
+            PacketProfiler::instance().removeThreadProfile(profile_);
+        }
+    }
+
+    /// @brief State of the thread.
+    ThreadProfilePtr profile_;
+};
+
+PacketProfiler::StageTimer::StageTimer(Stage stage)
+    : stage_(stage), active_(sampling), outer_(0), start_(), elapsed_(0) {
+    if (active_) {
+        start_ = steady_clock::now();
+        outer_ = current_timer;
+        if (outer_) {
+            outer_->elapsed_ += start_ - outer_->start_;
+        }
+        current_timer = this;
+    }
+}
+
+PacketProfiler::StageTimer::~StageTimer() {
+    if (active_) {
+        steady_clock::time_point now = steady_clock::now();
+        elapsed_ += now - start_;
+        PacketProfiler::instance().record(stage_,
+            duration_cast<nanoseconds>(elapsed_).count());
+        current_timer = outer_;
+        if (outer_) {
+            outer_->start_ = now;
+        }
+    }
+}
+
+PacketProfiler::PacketScope::PacketScope(const boost::posix_time::ptime& timestamp)
+    : sampled_(false) {
+    if (sampling) {
+        // Nested scope.
+        return;
+    }
+    PacketProfiler& profiler = PacketProfiler::instance();
+    sampled_ = profiler.startPacket();
+    if (sampled_ && !timestamp.is_special()) {
+        boost::posix_time::time_duration wait =
+            boost::posix_time::microsec_clock::universal_time() - timestamp;
+        if (!wait.is_negative()) {
+            profiler.record(STAGE_RECEIVE, wait.total_nanoseconds());
+        }
+    }
+}
+
+PacketProfiler::PacketScope::~PacketScope() {
+    if (sampled_) {
+        PacketProfiler::instance().endPacket();
+    }
+}
+
+PacketProfiler&
+PacketProfiler::instance() {
+    static PacketProfiler profiler;
+    return (profiler);
+}
+
+PacketProfiler::PacketProfiler()
+    : sample_rate_(0), generation_(0), last_publish_(0), mutex_(),
+      threads_(), retired_() {
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        retired_.push_back(boost::shared_ptr<StageHistogram>(new StageHistogram()));
+    }
+}
+
+void
+PacketProfiler::setSampleRate(uint32_t sample_rate) {
+    reset();
+    sample_rate_ = sample_rate;
+}
+
+bool
+PacketProfiler::isSampling() {
+    return (sampling);
+}
+
+PacketProfiler::ThreadProfile&
+PacketProfiler::getThreadProfile() {
+    static thread_local ThreadProfileHolder holder;
+    if (!holder.profile_) {
+        holder.profile_.reset(new ThreadProfile());
+        holder.profile_->generation_ = instance().generation_.load();
+        instance().addThreadProfile(holder.profile_);
+    }
+    return (*holder.profile_);
+}
+
+void
+PacketProfiler::addThreadProfile(const ThreadProfilePtr& profile) {
+    lock_guard<mutex> lk(mutex_);
+    threads_.push_back(profile);
+}
+
+void
+PacketProfiler::removeThreadProfile(const ThreadProfilePtr& profile) {
+    lock_guard<mutex> lk(mutex_);
+    auto it = find(threads_.begin(), threads_.end(), profile);
+    if (it != threads_.end()) {
+        threads_.erase(it);
+    }
+    if (profile->generation_ == generation_) {
+        for (int i = 0; i < STAGE_COUNT; ++i) {
+            retired_[i]->merge(profile->histograms_[i]);
+        }
+    }
+}
+
+bool
+PacketProfiler::startPacket() {
+    uint32_t sample_rate = sample_rate_.load(memory_order_relaxed);
+    if (sample_rate == 0) {
+        return (false);
+    }
+    ThreadProfile& profile = getThreadProfile();
+    if (++profile.packets_ % sample_rate != 0) {
+        return (false);
+    }
+    // Drop the values recorded before the last reset.
+    uint64_t generation = generation_;
+    if (profile.generation_.load(memory_order_relaxed) != generation) {
+        for (auto& histogram : profile.histograms_) {
+            histogram.reset();
+        }
+        profile.generation_.store(generation);
+    }
+    sampling = true;
+    profile.start_ = steady_clock::now();
+    return (true);
+}
+
+void
+PacketProfiler::endPacket() {
+    ThreadProfile& profile = getThreadProfile();
+    steady_clock::time_point now = steady_clock::now();
+    record(STAGE_TOTAL, duration_cast<nanoseconds>(now - profile.start_).count());
+    sampling = false;
+
+    int64_t now_ns = duration_cast<nanoseconds>(now.time_since_epoch()).count();
+    int64_t last = last_publish_;
+    if ((now_ns - last >= PUBLISH_INTERVAL.count()) &&
+        last_publish_.compare_exchange_strong(last, now_ns)) {
+        try {
+            publishStatistics();
+        } catch (...) {
+            // The packet processing must not fail because of the profiler.
+        }
+    }
+}
+
+void
+PacketProfiler::record(Stage stage, uint64_t nsec) {
+    if (!sampling || (stage < 0) || (stage >= STAGE_COUNT)) {
+        return;
+    }
+    getThreadProfile().histograms_[stage].record(nsec);
+}
+
+void
+PacketProfiler::reset() {
+    lock_guard<mutex> lk(mutex_);
+    for (auto const& histogram : retired_) {
+        histogram->reset();
+    }
+    // The threads reset their histograms at their next profiled packet.
+    ++generation_;
+}
+
+void
+PacketProfiler::getHistograms(vector<boost::shared_ptr<StageHistogram> >& histograms) {
+    histograms.clear();
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        histograms.push_back(boost::shared_ptr<StageHistogram>(new StageHistogram()));
+    }
+    lock_guard<mutex> lk(mutex_);
+    uint64_t generation = generation_;
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        histograms[i]->merge(*retired_[i]);
+    }
+    for (auto const& profile : threads_) {
+        if (profile->generation_.load() != generation) {
+            continue;
+        }
+        for (int i = 0; i < STAGE_COUNT; ++i) {
+            histograms[i]->merge(profile->histograms_[i]);
+        }
+    }
+}
+
+ElementPtr
+PacketProfiler::toElement() {
+    vector<boost::shared_ptr<StageHistogram> > histograms;
+    getHistograms(histograms);
+    ElementPtr result = Element::createMap();
+    result->set("sample-rate",
+                Element::create(static_cast<int64_t>(getSampleRate())));
+    ElementPtr stages = Element::createMap();
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        const StageHistogram& histogram = *histograms[i];
+        ElementPtr stage = Element::createMap();
+        uint64_t count = histogram.getCount();
+        stage->set("count", Element::create(static_cast<int64_t>(count)));
+        stage->set("mean", Element::create(static_cast<int64_t>(
+            count ? histogram.getSum() / count : 0)));
+        stage->set("p50", Element::create(static_cast<int64_t>(
+            histogram.getPercentile(50.))));
+        stage->set("p90", Element::create(static_cast<int64_t>(
+            histogram.getPercentile(90.))));
+        stage->set("p99", Element::create(static_cast<int64_t>(
+            histogram.getPercentile(99.))));
+        stage->set("max", Element::create(static_cast<int64_t>(
+            histogram.getMax())));
+        stages->set(stageToText(static_cast<Stage>(i)), stage);
+    }
+    result->set("stages", stages);
+    return (result);
+}
+
+void
+PacketProfiler::publishStatistics() {
+    vector<boost::shared_ptr<StageHistogram> > histograms;
+    getHistograms(histograms);
+    StatsMgr& stats_mgr = StatsMgr::instance();
+    for (int i = 0; i < STAGE_COUNT; ++i) {
+        const StageHistogram& histogram = *histograms[i];
+        if (histogram.getCount() == 0) {
+            continue;
+        }
+        string prefix = "pkt-stage-" + stageToText(static_cast<Stage>(i));
+        stats_mgr.setValue(prefix + "-p50", duration_cast<StatsDuration>(
+            nanoseconds(histogram.getPercentile(50.))));
+        stats_mgr.setValue(prefix + "-p99", duration_cast<StatsDuration>(
+            nanoseconds(histogram.getPercentile(99.))));
+        stats_mgr.setValue(prefix + "-max", duration_cast<StatsDuration>(
+            nanoseconds(histogram.getMax())));
+    }
+}
+
+string
+PacketProfiler::stageToText(Stage stage) {
+    switch (stage) {
+    case STAGE_RECEIVE:
+        return ("receive");
+    case STAGE_UNPACK:
+        return ("unpack");
+    case STAGE_CLASSIFY:
+        return ("classify");
+    case STAGE_SUBNET_SELECT:
+        return ("subnet-select");
+    case STAGE_HOST_LOOKUP:
+        return ("host-lookup");
+    case STAGE_ALLOCATION:
+        return ("allocation");
+    case STAGE_LEASE_WRITE:
+        return ("lease-write");
+    case STAGE_DDNS:
+        return ("ddns");
+    case STAGE_HOOKS:
+        return ("hooks");
+    case STAGE_PACK_SEND:
+        return ("pack-send");
+    case STAGE_TOTAL:
+        return ("total");
+    default:
+        break;
+    }
+    std::ostringstream s;
+    s << "unknown-" << static_cast<int>(stage);
+    return (s.str());
+}
+
+ConstElementPtr
+PacketProfiler::profileGetHandler(const string& /*name*/,
+                                  const ConstElementPtr& /*params*/) {
+    return (createAnswer(CONTROL_RESULT_SUCCESS, "Packet profile returned.",
+                         PacketProfiler::instance().toElement()));
+}
+
+ConstElementPtr
+PacketProfiler::profileSetHandler(const string& /*name*/,
+                                  const ConstElementPtr& params) {
+    if (!params || (params->getType() != Element::map)) {
+        return (createAnswer(CONTROL_RESULT_ERROR,
+                             "Missing mandatory 'sample-rate' parameter."));
+    }
+    ConstElementPtr sample_rate = params->get("sample-rate");
+    if (!sample_rate) {
+        return (createAnswer(CONTROL_RESULT_ERROR,
+                             "Missing mandatory 'sample-rate' parameter."));
+    }
+    if (sample_rate->getType() != Element::integer) {
+        return (createAnswer(CONTROL_RESULT_ERROR,
+                             "'sample-rate' parameter expected to be an integer."));
+    }
+    int64_t value = sample_rate->intValue();
+    if ((value < 0) || (value > numeric_limits<uint32_t>::max())) {
+        return (createAnswer(CONTROL_RESULT_ERROR,
+                             "'sample-rate' parameter is out of range."));
+    }
+    PacketProfiler::instance().setSampleRate(static_cast<uint32_t>(value));
+    std::ostringstream s;
+    if (value == 0) {
+        s << "Packet profiling disabled.";
+    } else {
+        s << "Packet profiling enabled for one packet out of " << value << ".";
+    }
+    return (createAnswer(CONTROL_RESULT_SUCCESS, s.str()));
+}
+
+} // namespace dhcp
+} // namespace isc
@@ -0,0 +1,371 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef PACKET_PROFILER_H
+#define PACKET_PROFILER_H
+
+#include <cc/data.h>
+
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace isc {
+namespace dhcp {
+
+/// @brief Histogram of the durations of a packet processing stage.
+///
+/// The durations are recorded in nanoseconds in a fixed memory log-linear
+/// histogram. The first @c SUB_BUCKETS buckets hold the values from 0 to
+/// @c SUB_BUCKETS - 1 exactly. The following buckets are grouped in ranges
+/// covering the values from 2^n to 2^(n+1) - 1, each range being divided
+/// into @c SUB_BUCKETS / 2 buckets of the same width, so the value reported
+/// for a bucket differs from the recorded values by less than 7%. Values
+/// greater than @c MAX_VALUE are counted in the last bucket.
+///
+/// A histogram is written by a single thread and can be read by other
+/// threads at the same time: the counters are atomic but they are updated
+/// with plain loads and stores, which cost as much as non atomic updates.
+class StageHistogram : public boost::noncopyable {
+public:
+    /// @brief Number of bits of the sub-bucket index.
+    static const unsigned int SUB_BUCKET_BITS = 5;
+
+    /// @brief Number of buckets holding exact values.
+    static const uint64_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+    /// @brief Number of bits of the greatest value distinguished.
+    static const unsigned int VALUE_BITS = 36;
+
+    /// @brief Greatest value distinguished by the histogram (68 seconds).
+    static const uint64_t MAX_VALUE = (static_cast<uint64_t>(1) << VALUE_BITS) - 1;
+
+    /// @brief Number of buckets.
+    static const size_t BUCKETS =
+        SUB_BUCKETS + (VALUE_BITS - SUB_BUCKET_BITS) * SUB_BUCKETS / 2;
+
+    /// @brief Constructor.
+    StageHistogram();
+
+    /// @brief Records a duration.
+    ///
+    /// Must only be called by the thread owning the histogram.
+    ///
+    /// @param nsec Duration in nanoseconds.
+    void record(uint64_t nsec);
+
+    /// @brief Adds the values recorded by another histogram.
+    ///
+    /// @param other Histogram to be merged.
+    void merge(const StageHistogram& other);
+
+    /// @brief Removes all recorded values.
+    ///
+    /// Must only be called by the thread owning the histogram.
+    void reset();
+
+    /// @brief Returns the number of recorded values.
+    uint64_t getCount() const {
+        return (count_.load(std::memory_order_relaxed));
+    }
+
+    /// @brief Returns the sum of the recorded values in nanoseconds.
+    uint64_t getSum() const {
+        return (sum_.load(std::memory_order_relaxed));
+    }
+
+    /// @brief Returns the greatest recorded value in nanoseconds.
+    uint64_t getMax() const {
+        return (max_.load(std::memory_order_relaxed));
+    }
+
+    /// @brief Returns the value at the given percentile in nanoseconds.
+    ///
+    /// The returned value is the greatest value falling into the same
+    /// bucket as the value at the percentile, limited to the greatest
+    /// recorded value.
+    ///
+    /// @param percentile Percentile between 0 and 100.
+    /// @return Value at the percentile or 0 if no value was recorded.
+    /// @throw isc::BadValue if the percentile is out of range.
+    uint64_t getPercentile(double percentile) const;
+
+    /// @brief Returns the index of the bucket for a value.
+    ///
+    /// @param value Value in nanoseconds.
+    /// @return Index of the bucket.
+    static size_t getBucketIndex(uint64_t value);
+
+    /// @brief Returns the greatest value falling into a bucket.
+    ///
+    /// @param index Index of the bucket.
+    /// @return Greatest value of the bucket.
+    static uint64_t getBucketHighest(size_t index);
+
+private:
+    /// @brief Adds a value to a counter owned by the calling thread.
+    ///
+    /// @param counter Counter to be updated.
+    /// @param value Value to add.
+    static void add(std::atomic<uint64_t>& counter, uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value,
+                      std::memory_order_relaxed);
+    }
+
+    /// @brief Counts of the values in the buckets.
+    std::atomic<uint64_t> counts_[BUCKETS];
+
+    /// @brief Number of recorded values.
+    std::atomic<uint64_t> count_;
+
+    /// @brief Sum of the recorded values.
+    std::atomic<uint64_t> sum_;
+
+    /// @brief Greatest recorded value.
+    std::atomic<uint64_t> max_;
+};
+
+/// @brief Profiler of the packet processing stages.
+///
+/// When enabled, one packet every "sample rate" packets is profiled by
+/// each processing thread: the time spent in each stage of the processing
+/// of the packet is measured with the steady clock and recorded in the
+/// histograms of the thread, so the threads never wait for each other.
+/// The other packets only pay for a counter increment and for checking
+/// a thread local flag at each stage.
+///
+/// The stage timers are exclusive: when a stage starts while another one
+/// is measured, e.g. the lease backend writes during the allocation or the
+/// callouts called during the subnet selection, the outer stage is paused
+/// until the inner stage ends, so each duration is counted in one stage
+/// only. The total stage is the whole processing of the packet and the
+/// receive stage is the time the packet waited between its reception and
+/// the start of its processing.
+///
+/// The percentiles of the stages are returned by the packet-profile-get
+/// command and are published at most once per second as duration
+/// statistics named "pkt-stage-<stage>-p50", "pkt-stage-<stage>-p99" and
+/// "pkt-stage-<stage>-max".
+class PacketProfiler : public boost::noncopyable {
+public:
+    /// @brief Packet processing stages.
+    enum Stage {
+        STAGE_RECEIVE,       ///< wait between reception and processing
+        STAGE_UNPACK,        ///< parsing of the packet
+        STAGE_CLASSIFY,      ///< client classification
+        STAGE_SUBNET_SELECT, ///< subnet selection
+        STAGE_HOST_LOOKUP,   ///< host reservation lookup
+        STAGE_ALLOCATION,    ///< lease allocation
+        STAGE_LEASE_WRITE,   ///< lease backend write
+        STAGE_DDNS,          ///< name change requests generation
+        STAGE_HOOKS,         ///< callouts
+        STAGE_PACK_SEND,     ///< packing and sending of the response
+        STAGE_TOTAL,         ///< whole packet processing
+        STAGE_COUNT          ///< number of stages
+    };
+
+    /// @brief Measures the duration of a stage.
+    ///
+    /// Records the time elapsed between the construction and the
+    /// destruction of the object when the packet processed by the thread
+    /// is profiled, less the time spent in the stages measured by timers
+    /// created in the meantime.
+    class StageTimer : public boost::noncopyable {
+    public:
+        /// @brief Constructor.
+        ///
+        /// Pauses the timer of the enclosing stage.
+        ///
+        /// @param stage Measured stage.
+        explicit StageTimer(Stage stage);
+
+        /// @brief Destructor.
+        ///
+        /// Records the duration of the stage and resumes the timer of
+        /// the enclosing stage.
+        ~StageTimer();
+
+    private:
+        /// @brief Measured stage.
+        Stage stage_;
+
+        /// @brief Flag set when the duration is measured.
+        bool active_;
+
+        /// @brief Timer of the enclosing stage, null if none.
+        StageTimer* outer_;
+
+        /// @brief Start of the last running period of the stage.
+        std::chrono::steady_clock::time_point start_;
+
+        /// @brief Duration of the previous running periods.
+        std::chrono::steady_clock::duration elapsed_;
+    };
+
+    /// @brief Delimits the processing of a packet.
+    ///
+    /// Decides if the packet is profiled, records the time it waited
+    /// since its reception and records the total duration when the
+    /// object is destroyed. Nested scopes are ignored.
+    class PacketScope : public boost::noncopyable {
+    public:
+        /// @brief Constructor.
+        ///
+        /// @param timestamp Reception time of the packet, ignored when
+        /// it is not set.
+        explicit PacketScope(const boost::posix_time::ptime& timestamp);
+
+        /// @brief Destructor.
+        ///
+        /// Ends the profiling of the packet.
+        ~PacketScope();
+
+    private:
+        /// @brief Flag set when the packet is profiled.
+        bool sampled_;
+    };
+
+    /// @brief Returns the profiler instance.
+    static PacketProfiler& instance();
+
+    /// @brief Sets the sample rate.
+    ///
+    /// Setting the sample rate removes the recorded values.
+    ///
+    /// @param sample_rate One packet out of sample_rate packets is
+    /// profiled by each thread, 0 disables the profiling.
+    void setSampleRate(uint32_t sample_rate);
+
+    /// @brief Returns the sample rate.
+    uint32_t getSampleRate() const {
+        return (sample_rate_.load(std::memory_order_relaxed));
+    }
+
+    /// @brief Checks if the packet processed by the thread is profiled.
+    static bool isSampling();
+
+    /// @brief Records the duration of a stage of the profiled packet.
+    ///
+    /// @param stage Stage.
+    /// @param nsec Duration in nanoseconds.
+    void record(Stage stage, uint64_t nsec);
+
+    /// @brief Removes the recorded values.
+    void reset();
+
+    /// @brief Merges the histograms of all threads.
+    ///
+    /// @param histograms Vector of @c STAGE_COUNT histograms receiving
+    /// the recorded values.
+    void getHistograms(std::vector<boost::shared_ptr<StageHistogram> >& histograms);
+
+    /// @brief Returns the sample rate and the percentiles of the stages.
+    ///
+    /// @return Map with the sample rate and a map of the stages, each stage
+    /// giving its count and its mean, p50, p90, p99 and max durations in
+    /// nanoseconds.
+    isc::data::ElementPtr toElement();
+
+    /// @brief Publishes the percentiles of the stages as statistics.
+    void publishStatistics();
+
+    /// @brief Returns the name of a stage.
+    ///
+    /// @param stage Stage.
+    /// @return Name of the stage.
+    static std::string stageToText(Stage stage);
+
+    /// @brief Handles packet-profile-get command.
+    ///
+    /// @param name Name of the command (ignored).
+    /// @param params Command parameters (ignored).
+    /// @return Answer with the profile returned by @ref toElement.
+    static isc::data::ConstElementPtr
+    profileGetHandler(const std::string& name,
+                      const isc::data::ConstElementPtr& params);
+
+    /// @brief Handles packet-profile-set command.
+    ///
+    /// Expects the "sample-rate" integer parameter, 0 disabling the
+    /// profiling. The recorded values are removed.
+    ///
+    /// @param name Name of the command (ignored).
+    /// @param params Command parameters.
+    /// @return Answer confirming the new sample rate.
+    static isc::data::ConstElementPtr
+    profileSetHandler(const std::string& name,
+                      const isc::data::ConstElementPtr& params);
+
+private:
+    /// @brief Per thread profiling state.
+    struct ThreadProfile;
+
+    /// @brief Pointer to a per thread profiling state.
+    typedef boost::shared_ptr<ThreadProfile> ThreadProfilePtr;
+
+    /// @brief Holder of the state of a thread.
+    struct ThreadProfileHolder;
+
+    /// @brief Constructor.
+    PacketProfiler();
+
+    /// @brief Returns the state of the calling thread.
+    ///
+    /// The state is created and registered on first use.
+    static ThreadProfile& getThreadProfile();
+
+    /// @brief Registers the state of a thread.
+    ///
+    /// @param profile State of the thread.
+    void addThreadProfile(const ThreadProfilePtr& profile);
+
+    /// @brief Unregisters the state of a thread when the thread exits.
+    ///
+    /// The values recorded by the thread are kept.
+    ///
+    /// @param profile State of the thread.
+    void removeThreadProfile(const ThreadProfilePtr& profile);
+
+    /// @brief Decides if the packet processed by the thread is profiled.
+    ///
+    /// @return true if the packet is profiled.
+    bool startPacket();
+
+    /// @brief Ends the profiling of the packet processed by the thread.
+    void endPacket();
+
+    /// @brief Sample rate, 0 when the profiling is disabled.
+    std::atomic<uint32_t> sample_rate_;
+
+    /// @brief Incremented when the recorded values are removed.
+    std::atomic<uint64_t> generation_;
+
+    /// @brief Time of the last statistics publication in nanoseconds
+    /// since the steady clock epoch.
+    std::atomic<int64_t> last_publish_;
+
+    /// @brief Protects the members below.
+    std::mutex mutex_;
+
+    /// @brief States of the running threads.
+    std::vector<ThreadProfilePtr> threads_;
+
+    /// @brief Values recorded by the threads which have exited.
+    std::vector<boost::shared_ptr<StageHistogram> > retired_;
+};
+
+} // namespace dhcp
+} // namespace isc
+
+#endif // PACKET_PROFILER_H
@@ -706,18 +706,24 @@ Subnet4ConfigParser::parse(ConstElementPtr subnet) {
     }
 
     // Parse Host Reservations for this subnet if any.
-    ConstElementPtr reservations = subnet->get("reservations");
+    parseReservations(sn4ptr, subnet);
+
+    return (sn4ptr);
+}
+
+void
+Subnet4ConfigParser::parseReservations(const Subnet4Ptr& subnet,
+                                       ConstElementPtr subnet_json) {
+    ConstElementPtr reservations = subnet_json->get("reservations");
     if (reservations) {
         HostCollection hosts;
         HostReservationsListParser<HostReservationParser4> parser;
-        parser.parse(subnet_->getID(), reservations, hosts);
+        parser.parse(subnet->getID(), reservations, hosts);
         for (auto h = hosts.begin(); h != hosts.end(); ++h) {
-            validateResv(sn4ptr, *h);
+            validateResv(subnet, *h);
             CfgMgr::instance().getStagingCfg()->getCfgHosts()->add(*h);
         }
     }
-
-    return (sn4ptr);
 }
 
 void
@@ -961,17 +967,32 @@ Subnet4ConfigParser::createPoolsListParser() const {
 //**************************** Subnets4ListConfigParser **********************
 
 Subnets4ListConfigParser::Subnets4ListConfigParser(bool check_iface)
-    : check_iface_(check_iface) {
+    : check_iface_(check_iface), current_subnets_(), reused_(0) {
 }
 
 size_t
 Subnets4ListConfigParser::parse(SrvConfigPtr cfg,
                                 ConstElementPtr subnets_list) {
     size_t cnt = 0;
+    reused_ = 0;
     BOOST_FOREACH(ConstElementPtr subnet_json, subnets_list->listValue()) {
 
         auto parser = createSubnetConfigParser();
-        Subnet4Ptr subnet = parser->parse(subnet_json);
+        Subnet4Ptr subnet;
+        ConstElementPtr id = subnet_json->get("id");
+        if (current_subnets_ && id && (id->getType() == Element::integer) &&
+            (id->intValue() > 0)) {
+            subnet = current_subnets_->
+                getUnchangedSubnet(static_cast<SubnetID>(id->intValue()),
+                                   subnet_json);
+        }
+        if (subnet) {
+            // Take over the unchanged subnet with its allocation state.
+            parser->parseReservations(subnet, subnet_json);
+            ++reused_;
+        } else {
+            subnet = parser->parse(subnet_json);
+        }
         if (subnet) {
 
             // Adding a subnet to the Configuration Manager may fail if the
@@ -979,6 +1000,7 @@ Subnets4ListConfigParser::parse(SrvConfigPtr cfg,
             // here to append a position in the configuration string.
             try {
                 cfg->getCfgSubnets4()->add(subnet);
+                cfg->getCfgSubnets4()->setSubnetElement(subnet, subnet_json);
                 cnt++;
             } catch (const std::exception& ex) {
                 isc_throw(DhcpConfigError, ex.what() << " ("
@@ -1211,18 +1233,24 @@ Subnet6ConfigParser::parse(ConstElementPtr subnet) {
     }
 
     // Parse Host Reservations for this subnet if any.
-    ConstElementPtr reservations = subnet->get("reservations");
+    parseReservations(sn6ptr, subnet);
+
+    return (sn6ptr);
+}
+
+void
+Subnet6ConfigParser::parseReservations(const Subnet6Ptr& subnet,
+                                       ConstElementPtr subnet_json) {
+    ConstElementPtr reservations = subnet_json->get("reservations");
     if (reservations) {
         HostCollection hosts;
         HostReservationsListParser<HostReservationParser6> parser;
-        parser.parse(subnet_->getID(), reservations, hosts);
+        parser.parse(subnet->getID(), reservations, hosts);
         for (auto h = hosts.begin(); h != hosts.end(); ++h) {
-            validateResvs(sn6ptr, *h);
+            validateResvs(subnet, *h);
             CfgMgr::instance().getStagingCfg()->getCfgHosts()->add(*h);
         }
     }
-
-    return (sn6ptr);
 }
 
 // Unused?
@@ -1427,23 +1455,39 @@ Subnet6ConfigParser::createPdPoolsListParser() const {
 //**************************** Subnet6ListConfigParser ********************
 
 Subnets6ListConfigParser::Subnets6ListConfigParser(bool check_iface)
-    : check_iface_(check_iface) {
+    : check_iface_(check_iface), current_subnets_(), reused_(0) {
 }
 
 size_t
 Subnets6ListConfigParser::parse(SrvConfigPtr cfg,
                                 ConstElementPtr subnets_list) {
     size_t cnt = 0;
+    reused_ = 0;
     BOOST_FOREACH(ConstElementPtr subnet_json, subnets_list->listValue()) {
 
         auto parser = createSubnetConfigParser();
-        Subnet6Ptr subnet = parser->parse(subnet_json);
+        Subnet6Ptr subnet;
+        ConstElementPtr id = subnet_json->get("id");
+        if (current_subnets_ && id && (id->getType() == Element::integer) &&
+            (id->intValue() > 0)) {
+            subnet = current_subnets_->
+                getUnchangedSubnet(static_cast<SubnetID>(id->intValue()),
+                                   subnet_json);
+        }
+        if (subnet) {
+            // Take over the unchanged subnet with its allocation state.
+            parser->parseReservations(subnet, subnet_json);
+            ++reused_;
+        } else {
+            subnet = parser->parse(subnet_json);
+        }
 
         // Adding a subnet to the Configuration Manager may fail if the
         // subnet id is invalid (duplicate). Thus, we catch exceptions
         // here to append a position in the configuration string.
         try {
             cfg->getCfgSubnets6()->add(subnet);
+            cfg->getCfgSubnets6()->setSubnetElement(subnet, subnet_json);
             cnt++;
         } catch (const std::exception& ex) {
             isc_throw(DhcpConfigError, ex.what() << " ("
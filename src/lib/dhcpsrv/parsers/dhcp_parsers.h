@@ -604,6 +604,17 @@ public:
     /// @return a pointer to created Subnet4 object
     Subnet4Ptr parse(data::ConstElementPtr subnet);
 
+    /// @brief Parses the host reservations of an IPv4 subnet.
+    ///
+    /// The reservations are added to the staging configuration. This is
+    /// done by @ref parse and for the subnets taken over from the current
+    /// configuration as the reservations belong to the configuration.
+    ///
+    /// @param subnet The subnet.
+    /// @param subnet_json The configuration of the subnet.
+    void parseReservations(const Subnet4Ptr& subnet,
+                           data::ConstElementPtr subnet_json);
+
 protected:
 
     /// @brief Instantiates the IPv4 Subnet based on a given IPv4 address
@@ -670,6 +681,30 @@ public:
     size_t parse(Subnet4Collection& subnets,
                  data::ConstElementPtr subnets_list);
 
+    /// @brief Sets the subnets of the current configuration.
+    ///
+    /// The subnets of the current configuration which were parsed from
+    /// elements equal to the new ones are taken over by the configuration
+    /// instead of being parsed again: this keeps their allocation state
+    /// and their lease statistics and speeds up the reconfiguration of the
+    /// servers with many subnets. Only their host reservations are parsed
+    /// again. This applies to the subnets with an explicit identifier which
+    /// do not belong to a shared network.
+    ///
+    /// The caller must ensure that the other parts of the configuration
+    /// the subnets depend on, e.g. the option definitions, did not change.
+    ///
+    /// @param subnets The subnets of the current configuration.
+    void setCurrentSubnets(const CfgSubnets4Ptr& subnets) {
+        current_subnets_ = subnets;
+    }
+
+    /// @brief Returns the number of subnets taken over from the current
+    /// configuration.
+    size_t getReusedCount() const {
+        return (reused_);
+    }
+
 protected:
 
     /// @brief Returns an instance of the @c Subnet4ConfigParser to be
@@ -683,6 +718,12 @@ protected:
 
     /// Check if the specified interface exists in the system.
     bool check_iface_;
+
+    /// Subnets of the current configuration.
+    CfgSubnets4Ptr current_subnets_;
+
+    /// Number of subnets taken over from the current configuration.
+    size_t reused_;
 };
 
 /// @brief Parser for IPv6 pool definitions.
@@ -872,6 +913,17 @@ public:
     /// @return a pointer to created Subnet6 object
     Subnet6Ptr parse(data::ConstElementPtr subnet);
 
+    /// @brief Parses the host reservations of an IPv6 subnet.
+    ///
+    /// The reservations are added to the staging configuration. This is
+    /// done by @ref parse and for the subnets taken over from the current
+    /// configuration as the reservations belong to the configuration.
+    ///
+    /// @param subnet The subnet.
+    /// @param subnet_json The configuration of the subnet.
+    void parseReservations(const Subnet6Ptr& subnet,
+                           data::ConstElementPtr subnet_json);
+
 protected:
     /// @brief Issues a DHCP6 server specific warning regarding duplicate subnet
     /// options.
@@ -958,6 +1010,30 @@ public:
     size_t parse(Subnet6Collection& subnets,
                  data::ConstElementPtr subnets_list);
 
+    /// @brief Sets the subnets of the current configuration.
+    ///
+    /// The subnets of the current configuration which were parsed from
+    /// elements equal to the new ones are taken over by the configuration
+    /// instead of being parsed again: this keeps their allocation state
+    /// and their lease statistics and speeds up the reconfiguration of the
+    /// servers with many subnets. Only their host reservations are parsed
+    /// again. This applies to the subnets with an explicit identifier which
+    /// do not belong to a shared network.
+    ///
+    /// The caller must ensure that the other parts of the configuration
+    /// the subnets depend on, e.g. the option definitions, did not change.
+    ///
+    /// @param subnets The subnets of the current configuration.
+    void setCurrentSubnets(const CfgSubnets6Ptr& subnets) {
+        current_subnets_ = subnets;
+    }
+
+    /// @brief Returns the number of subnets taken over from the current
+    /// configuration.
+    size_t getReusedCount() const {
+        return (reused_);
+    }
+
 protected:
 
     /// @brief Returns an instance of the @c Subnet6ConfigParser to be
@@ -971,6 +1047,12 @@ protected:
 
     /// Check if the specified interface exists in the system.
     bool check_iface_;
+
+    /// Subnets of the current configuration.
+    CfgSubnets6Ptr current_subnets_;
+
+    /// Number of subnets taken over from the current configuration.
+    size_t reused_;
 };
 
 /// @brief Parser for  D2ClientConfig
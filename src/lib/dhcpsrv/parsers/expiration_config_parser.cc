@@ -1,4 +1,4 @@
-// Copyright (C) 2015-2019 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2015-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -56,6 +56,12 @@ ExpirationConfigParser::parse(ConstElementPtr expiration_config) {
             cfg->setUnwarnedReclaimCycles(
                 getInteger(expiration_config, param));
         }
+
+        param = "background-reclamation";
+        if (expiration_config->contains(param)) {
+            cfg->setBackgroundReclamation(getBoolean(expiration_config,
+                                                     param));
+        }
     } catch (const DhcpConfigError&) {
         throw;
     } catch (const std::exception& ex) {
@@ -1,4 +1,4 @@
-// Copyright (C) 2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2020-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -7,6 +7,7 @@
 #include <config.h>
 
 #include <cc/data.h>
+#include <dhcp/pkt_send_batcher.h>
 #include <dhcpsrv/srv_config.h>
 #include <dhcpsrv/parsers/multi_threading_config_parser.h>
 #include <util/multi_threading_mgr.h>
@@ -64,6 +65,67 @@ MultiThreadingConfigParser::parse(SrvConfig& srv_cfg,
         }
     }
 
+    // receiver-threads is not mandatory
+    if (value->get("receiver-threads")) {
+        getBoolean(value, "receiver-threads");
+    }
+
+    // send-batch-size is not mandatory: 0 or 1 disables the send batching
+    if (value->get("send-batch-size")) {
+        auto send_batch_size = getInteger(value, "send-batch-size");
+        uint32_t max_size = PktSendBatcher::MAX_BATCH_SIZE;
+        if (send_batch_size < 0) {
+            isc_throw(DhcpConfigError,
+                      "send batch size must not be negative ("
+                      << getPosition("send-batch-size", value) << ")");
+        }
+        if (send_batch_size > max_size) {
+            isc_throw(DhcpConfigError, "invalid send batch size '"
+                      << send_batch_size << "', it must not be greater than '"
+                      << max_size << "' ("
+                      << getPosition("send-batch-size", value) << ")");
+        }
+    }
+
+    // send-batch-delay is not mandatory
+    if (value->get("send-batch-delay")) {
+        auto send_batch_delay = getInteger(value, "send-batch-delay");
+        uint32_t max_delay = PktSendBatcher::MAX_MAX_DELAY;
+        if (send_batch_delay < 0) {
+            isc_throw(DhcpConfigError,
+                      "send batch delay must not be negative ("
+                      << getPosition("send-batch-delay", value) << ")");
+        }
+        if (send_batch_delay > max_delay) {
+            isc_throw(DhcpConfigError, "invalid send batch delay '"
+                      << send_batch_delay << "', it must not be greater than '"
+                      << max_delay << "' ("
+                      << getPosition("send-batch-delay", value) << ")");
+        }
+    }
+
+    // background-config-parsing is not mandatory
+    if (value->get("background-config-parsing")) {
+        getBoolean(value, "background-config-parsing");
+    }
+
+    // command-threads is not mandatory: 0 disables the command threads
+    if (value->get("command-threads")) {
+        auto command_threads = getInteger(value, "command-threads");
+        uint32_t max_size = std::numeric_limits<uint16_t>::max();
+        if (command_threads < 0) {
+            isc_throw(DhcpConfigError,
+                      "command threads must not be negative ("
+                      << getPosition("command-threads", value) << ")");
+        }
+        if (command_threads > max_size) {
+            isc_throw(DhcpConfigError, "invalid command threads '"
+                      << command_threads << "', it must not be greater than '"
+                      << max_size << "' ("
+                      << getPosition("command-threads", value) << ")");
+        }
+    }
+
     srv_cfg.setDHCPMultiThreading(value);
     MultiThreadingMgr::instance().setMode(enabled);
 }
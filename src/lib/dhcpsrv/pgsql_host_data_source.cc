@@ -2493,11 +2493,12 @@ PgSqlHostDataSourceImpl::getHostCollection(PgSqlHostContextPtr& ctx,
                                            bool single) const {
 
     exchange->clear();
+    // The result set is fetched in binary format.
     PgSqlResult r(PQexecPrepared(ctx->conn_, tagged_statements[stindex].name,
                                  tagged_statements[stindex].nbparams,
                                  &bind_array->values_[0],
                                  &bind_array->lengths_[0],
-                                 &bind_array->formats_[0], 0));
+                                 &bind_array->formats_[0], 1));
 
     ctx->conn_.checkStatementError(r, tagged_statements[stindex]);
 
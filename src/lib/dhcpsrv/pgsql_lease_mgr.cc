@@ -279,6 +279,16 @@ PgSqlTaggedStatement tagged_statements[] = {
         "state, user_context) "
       "VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10, $11)"},
 
+    // INSERT_LEASE4_NO_DUP
+    { 11, { OID_INT8, OID_BYTEA, OID_BYTEA, OID_INT8, OID_TIMESTAMP, OID_INT8,
+            OID_BOOL, OID_BOOL, OID_VARCHAR, OID_INT8, OID_TEXT },
+      "insert_lease4_no_dup",
+      "INSERT INTO lease4(address, hwaddr, client_id, "
+        "valid_lifetime, expire, subnet_id, fqdn_fwd, fqdn_rev, hostname, "
+        "state, user_context) "
+      "VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10, $11) "
+      "ON CONFLICT DO NOTHING"},
+
     // INSERT_LEASE6
     { 17, { OID_VARCHAR, OID_BYTEA, OID_INT8, OID_TIMESTAMP, OID_INT8,
             OID_INT8, OID_INT2, OID_INT8, OID_INT2, OID_BOOL, OID_BOOL,
@@ -291,6 +301,19 @@ PgSqlTaggedStatement tagged_statements[] = {
         "state, user_context) "
       "VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10, $11, $12, $13, $14, $15, $16, $17)"},
 
+    // INSERT_LEASE6_NO_DUP
+    { 17, { OID_VARCHAR, OID_BYTEA, OID_INT8, OID_TIMESTAMP, OID_INT8,
+            OID_INT8, OID_INT2, OID_INT8, OID_INT2, OID_BOOL, OID_BOOL,
+            OID_VARCHAR, OID_BYTEA, OID_INT2, OID_INT2, OID_INT8, OID_TEXT },
+      "insert_lease6_no_dup",
+      "INSERT INTO lease6(address, duid, valid_lifetime, "
+        "expire, subnet_id, pref_lifetime, "
+        "lease_type, iaid, prefix_len, fqdn_fwd, fqdn_rev, hostname, "
+        "hwaddr, hwtype, hwaddr_source, "
+        "state, user_context) "
+      "VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10, $11, $12, $13, $14, $15, $16, $17) "
+      "ON CONFLICT DO NOTHING"},
+
     // UPDATE_LEASE4
     { 13, { OID_INT8, OID_BYTEA, OID_BYTEA, OID_INT8, OID_TIMESTAMP, OID_INT8,
             OID_BOOL, OID_BOOL, OID_VARCHAR, OID_INT8, OID_TEXT, OID_INT8, OID_TIMESTAMP },
@@ -362,6 +385,34 @@ PgSqlTaggedStatement tagged_statements[] = {
     { 0,  { 0 }, NULL, NULL}
 };
 
+/// @brief Discards the remaining results of a query sent asynchronously.
+///
+/// The connection can't run another query before all the results of
+/// the query were read, e.g. when the callback of a lease walk throws.
+class PgSqlResultDrain {
+public:
+
+    /// @brief Constructor.
+    ///
+    /// @param conn connection the query was sent on.
+    PgSqlResultDrain(PGconn* conn) : conn_(conn) {
+    }
+
+    /// @brief Destructor.
+    ///
+    /// Reads and discards the results until the end of the query.
+    ~PgSqlResultDrain() {
+        while (PGresult* r = PQgetResult(conn_)) {
+            PQclear(r);
+        }
+    }
+
+private:
+
+    /// @brief Connection the query was sent on.
+    PGconn* conn_;
+};
+
 }  // namespace
 
 namespace isc {
@@ -557,8 +608,7 @@ public:
 
             getColumnValue(r, row, VALID_LIFETIME_COL, valid_lifetime_);
 
-            expire_ = convertFromDatabaseTime(getRawColumnValue(r, row,
-                                                                EXPIRE_COL));
+            getColumnValue(r, row, EXPIRE_COL, expire_);
 
             getColumnValue(r, row , SUBNET_ID_COL, subnet_id_);
 
@@ -852,8 +902,7 @@ public:
 
             getColumnValue(r, row, VALID_LIFETIME_COL, valid_lifetime_);
 
-            expire_ = convertFromDatabaseTime(getRawColumnValue(r, row,
-                                                                EXPIRE_COL));
+            getColumnValue(r, row, EXPIRE_COL, expire_);
 
             // Recover from overflow
             if (valid_lifetime_ == Lease::INFINITY_LFT) {
@@ -1058,7 +1107,7 @@ public:
         if (getSelectMode() == ALL_SUBNETS) {
             // Run the query with no where clause parameters.
             result_set_.reset(new PgSqlResult(PQexecPrepared(conn_, statement_.name,
-                                                             0, 0, 0, 0, 0)));
+                                                             0, 0, 0, 0, 1)));
         } else {
             // Set up the WHERE clause values
             PsqlBindArray parms;
@@ -1077,7 +1126,7 @@ public:
             // Run the query with where clause parameters.
             result_set_.reset(new PgSqlResult(PQexecPrepared(conn_, statement_.name,
                                               parms.size(), &parms.values_[0],
-                                              &parms.lengths_[0], &parms.formats_[0], 0)));
+                                              &parms.lengths_[0], &parms.formats_[0], 1)));
         }
 
         conn_.checkStatementError(*result_set_, statement_);
@@ -1363,6 +1412,13 @@ PgSqlLeaseMgr::addLeaseCommon(PgSqlLeaseContextPtr& ctx,
                                  &bind_array.lengths_[0],
                                  &bind_array.formats_[0], 0));
 
+    return (checkAddLeaseResult(ctx, stindex, r));
+}
+
+bool
+PgSqlLeaseMgr::checkAddLeaseResult(PgSqlLeaseContextPtr& ctx,
+                                   StatementIndex stindex,
+                                   const PgSqlResult& r) {
     int s = PQresultStatus(r);
 
     if (s != PGRES_COMMAND_OK) {
@@ -1375,7 +1431,40 @@ PgSqlLeaseMgr::addLeaseCommon(PgSqlLeaseContextPtr& ctx,
         ctx->conn_.checkStatementError(r, tagged_statements[stindex]);
     }
 
-    return (true);
+    // An insert ignoring duplicates affects no row when the lease exists.
+    return (boost::lexical_cast<int>(PQcmdTuples(r)) > 0);
+}
+
+void
+PgSqlLeaseMgr::createBindForAdd(PgSqlLeaseContextPtr& ctx,
+                                const Lease4Ptr& lease,
+                                PsqlBindArray& bind_array) {
+    ctx->exchange4_->createBindForSend(lease, bind_array);
+}
+
+void
+PgSqlLeaseMgr::createBindForAdd(PgSqlLeaseContextPtr& ctx,
+                                const Lease6Ptr& lease,
+                                PsqlBindArray& bind_array) {
+    ctx->exchange6_->createBindForSend(lease, bind_array);
+}
+
+bool
+PgSqlLeaseMgr::addLeaseInternal(PgSqlLeaseContextPtr& ctx,
+                                StatementIndex stindex,
+                                const Lease4Ptr& lease) {
+    PsqlBindArray bind_array;
+    createBindForAdd(ctx, lease, bind_array);
+    return (addLeaseCommon(ctx, stindex, bind_array));
+}
+
+bool
+PgSqlLeaseMgr::addLeaseInternal(PgSqlLeaseContextPtr& ctx,
+                                StatementIndex stindex,
+                                const Lease6Ptr& lease) {
+    PsqlBindArray bind_array;
+    createBindForAdd(ctx, lease, bind_array);
+    return (addLeaseCommon(ctx, stindex, bind_array));
 }
 
 bool
@@ -1387,9 +1476,7 @@ PgSqlLeaseMgr::addLease(const Lease4Ptr& lease) {
     PgSqlLeaseContextAlloc get_context(*this);
     PgSqlLeaseContextPtr ctx = get_context.ctx_;
 
-    PsqlBindArray bind_array;
-    ctx->exchange4_->createBindForSend(lease, bind_array);
-    auto result = addLeaseCommon(ctx, INSERT_LEASE4, bind_array);
+    auto result = addLeaseInternal(ctx, INSERT_LEASE4, lease);
 
     // Update lease current expiration time (allows update between the creation
     // of the Lease up to the point of insertion in the database).
@@ -1408,10 +1495,7 @@ PgSqlLeaseMgr::addLease(const Lease6Ptr& lease) {
     PgSqlLeaseContextAlloc get_context(*this);
     PgSqlLeaseContextPtr ctx = get_context.ctx_;
 
-    PsqlBindArray bind_array;
-    ctx->exchange6_->createBindForSend(lease, bind_array);
-
-    auto result = addLeaseCommon(ctx, INSERT_LEASE6, bind_array);
+    auto result = addLeaseInternal(ctx, INSERT_LEASE6, lease);
 
     // Update lease current expiration time (allows update between the creation
     // of the Lease up to the point of insertion in the database).
@@ -1420,6 +1504,66 @@ PgSqlLeaseMgr::addLease(const Lease6Ptr& lease) {
     return (result);
 }
 
+template <typename LeaseCollection>
+LeaseCollection
+PgSqlLeaseMgr::addLeasesCommon(StatementIndex stindex,
+                               const LeaseCollection& leases) {
+    LeaseCollection added;
+    LeaseCollection not_added;
+
+    if (leases.empty()) {
+        return (not_added);
+    }
+
+    // Get a context
+    PgSqlLeaseContextAlloc get_context(*this);
+    PgSqlLeaseContextPtr ctx = get_context.ctx_;
+
+    // Any error rolls back the whole batch.
+    PgSqlTransaction transaction(ctx->conn_);
+    {
+        // Send all the insertions before reading their results.
+        PgSqlPipeline pipeline(ctx->conn_);
+        for (auto const& lease : leases) {
+            PsqlBindArray bind_array;
+            createBindForAdd(ctx, lease, bind_array);
+            pipeline.send(tagged_statements[stindex], bind_array);
+        }
+        for (auto const& lease : leases) {
+            PgSqlResultPtr r = pipeline.getResult();
+            if (checkAddLeaseResult(ctx, stindex, *r)) {
+                added.push_back(lease);
+            } else {
+                not_added.push_back(lease);
+            }
+        }
+    }
+    transaction.commit();
+
+    // Update lease current expiration times once the leases are stored.
+    for (auto const& lease : added) {
+        lease->updateCurrentExpirationTime();
+    }
+
+    return (not_added);
+}
+
+Lease4Collection
+PgSqlLeaseMgr::addLeases(const Lease4Collection& leases) {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_ADD_LEASES4)
+        .arg(leases.size());
+
+    return (addLeasesCommon(INSERT_LEASE4_NO_DUP, leases));
+}
+
+Lease6Collection
+PgSqlLeaseMgr::addLeases(const Lease6Collection& leases) {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_ADD_LEASES6)
+        .arg(leases.size());
+
+    return (addLeasesCommon(INSERT_LEASE6_NO_DUP, leases));
+}
+
 template <typename Exchange, typename LeaseCollection>
 void
 PgSqlLeaseMgr::getLeaseCollection(PgSqlLeaseContextPtr& ctx,
@@ -1429,11 +1573,13 @@ PgSqlLeaseMgr::getLeaseCollection(PgSqlLeaseContextPtr& ctx,
                                   LeaseCollection& result,
                                   bool single) const {
     const int n = tagged_statements[stindex].nbparams;
+    // The result set is fetched in binary format which saves the text
+    // conversion of the integers and the escaping of the byte arrays.
     PgSqlResult r(PQexecPrepared(ctx->conn_,
                                  tagged_statements[stindex].name, n,
                                  n > 0 ? &bind_array.values_[0] : NULL,
                                  n > 0 ? &bind_array.lengths_[0] : NULL,
-                                 n > 0 ? &bind_array.formats_[0] : NULL, 0));
+                                 n > 0 ? &bind_array.formats_[0] : NULL, 1));
 
     ctx->conn_.checkStatementError(r, tagged_statements[stindex]);
 
@@ -1449,6 +1595,39 @@ PgSqlLeaseMgr::getLeaseCollection(PgSqlLeaseContextPtr& ctx,
     }
 }
 
+template <typename Exchange, typename Callback>
+void
+PgSqlLeaseMgr::walkLeaseCollection(PgSqlLeaseContextPtr& ctx,
+                                   StatementIndex stindex,
+                                   PsqlBindArray& bind_array,
+                                   Exchange& exchange,
+                                   const Callback& callback) const {
+    const int n = tagged_statements[stindex].nbparams;
+    if (PQsendQueryPrepared(ctx->conn_,
+                            tagged_statements[stindex].name, n,
+                            n > 0 ? &bind_array.values_[0] : NULL,
+                            n > 0 ? &bind_array.lengths_[0] : NULL,
+                            n > 0 ? &bind_array.formats_[0] : NULL, 1) != 1) {
+        // The null result is reported as a fatal error.
+        PgSqlResult r(NULL);
+        ctx->conn_.checkStatementError(r, tagged_statements[stindex]);
+    }
+
+    // Receive the rows one at a time rather than the whole result set.
+    PgSqlResultDrain drain(ctx->conn_);
+    PQsetSingleRowMode(ctx->conn_);
+    for (;;) {
+        PgSqlResult r(PQgetResult(ctx->conn_));
+        if (PQresultStatus(r) != PGRES_SINGLE_TUPLE) {
+            // The last result has no row: it ends the query or reports
+            // an error.
+            ctx->conn_.checkStatementError(r, tagged_statements[stindex]);
+            break;
+        }
+        callback(*exchange->convertFromDatabase(r, 0));
+    }
+}
+
 void
 PgSqlLeaseMgr::getLease(PgSqlLeaseContextPtr& ctx,
                         StatementIndex stindex, PsqlBindArray& bind_array,
@@ -1727,6 +1906,73 @@ PgSqlLeaseMgr::getLeases4(const IOAddress& lower_bound_address,
     return (result);
 }
 
+void
+PgSqlLeaseMgr::walkLeases4(SubnetID subnet_id, const Lease4Callback& callback) const {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_GET_SUBID4)
+        .arg(subnet_id);
+
+    // Set up the WHERE clause value
+    PsqlBindArray bind_array;
+
+    // SUBNET_ID
+    std::string subnet_id_str = boost::lexical_cast<std::string>(subnet_id);
+    bind_array.add(subnet_id_str);
+
+    // Get a context
+    PgSqlLeaseContextAlloc get_context(*this);
+    PgSqlLeaseContextPtr ctx = get_context.ctx_;
+
+    walkLeaseCollection(ctx, GET_LEASE4_SUBID, bind_array, ctx->exchange4_, callback);
+}
+
+void
+PgSqlLeaseMgr::walkLeases4(const Lease4Callback& callback) const {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_GET4);
+
+    // Provide empty binding array because our query has no parameters in
+    // WHERE clause.
+    PsqlBindArray bind_array;
+
+    // Get a context
+    PgSqlLeaseContextAlloc get_context(*this);
+    PgSqlLeaseContextPtr ctx = get_context.ctx_;
+
+    walkLeaseCollection(ctx, GET_LEASE4, bind_array, ctx->exchange4_, callback);
+}
+
+void
+PgSqlLeaseMgr::walkLeases4(const IOAddress& lower_bound_address,
+                           const LeasePageSize& page_size,
+                           const Lease4Callback& callback) const {
+    // Expecting IPv4 address.
+    if (!lower_bound_address.isV4()) {
+        isc_throw(InvalidAddressFamily, "expected IPv4 address while "
+                  "retrieving leases from the lease database, got "
+                  << lower_bound_address);
+    }
+
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_GET_PAGE4)
+        .arg(page_size.page_size_)
+        .arg(lower_bound_address.toText());
+
+    // Prepare WHERE clause
+    PsqlBindArray bind_array;
+
+    // Bind lower bound address
+    std::string lb_address_data = boost::lexical_cast<std::string>(lower_bound_address.toUint32());
+    bind_array.add(lb_address_data);
+
+    // Bind page size value
+    std::string page_size_data = boost::lexical_cast<std::string>(page_size.page_size_);
+    bind_array.add(page_size_data);
+
+    // Get a context
+    PgSqlLeaseContextAlloc get_context(*this);
+    PgSqlLeaseContextPtr ctx = get_context.ctx_;
+
+    walkLeaseCollection(ctx, GET_LEASE4_PAGE, bind_array, ctx->exchange4_, callback);
+}
+
 Lease6Ptr
 PgSqlLeaseMgr::getLease6(Lease::Type lease_type,
                          const IOAddress& addr) const {
@@ -1961,6 +2207,80 @@ PgSqlLeaseMgr::getLeases6(const IOAddress& lower_bound_address,
     return (result);
 }
 
+void
+PgSqlLeaseMgr::walkLeases6(SubnetID subnet_id, const Lease6Callback& callback) const {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_GET_SUBID6)
+        .arg(subnet_id);
+
+    // Set up the WHERE clause value
+    PsqlBindArray bind_array;
+
+    // SUBNET_ID
+    std::string subnet_id_str = boost::lexical_cast<std::string>(subnet_id);
+    bind_array.add(subnet_id_str);
+
+    // Get a context
+    PgSqlLeaseContextAlloc get_context(*this);
+    PgSqlLeaseContextPtr ctx = get_context.ctx_;
+
+    walkLeaseCollection(ctx, GET_LEASE6_SUBID, bind_array, ctx->exchange6_, callback);
+}
+
+void
+PgSqlLeaseMgr::walkLeases6(const Lease6Callback& callback) const {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_GET6);
+
+    // Provide empty binding array because our query has no parameters in
+    // WHERE clause.
+    PsqlBindArray bind_array;
+
+    // Get a context
+    PgSqlLeaseContextAlloc get_context(*this);
+    PgSqlLeaseContextPtr ctx = get_context.ctx_;
+
+    walkLeaseCollection(ctx, GET_LEASE6, bind_array, ctx->exchange6_, callback);
+}
+
+void
+PgSqlLeaseMgr::walkLeases6(const IOAddress& lower_bound_address,
+                           const LeasePageSize& page_size,
+                           const Lease6Callback& callback) const {
+    // Expecting IPv6 address.
+    if (!lower_bound_address.isV6()) {
+        isc_throw(InvalidAddressFamily, "expected IPv6 address while "
+                  "retrieving leases from the lease database, got "
+                  << lower_bound_address);
+    }
+
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_GET_PAGE6)
+        .arg(page_size.page_size_)
+        .arg(lower_bound_address.toText());
+
+    // Prepare WHERE clause
+    PsqlBindArray bind_array;
+
+    // In IPv6 we compare addresses represented as strings. The IPv6 zero address
+    // is ::, so it is greater than any other address. In this special case, we
+    // just use 0 for comparison which should be lower than any real IPv6 address.
+    std::string lb_address_data = "0";
+    if (!lower_bound_address.isV6Zero()) {
+        lb_address_data = lower_bound_address.toText();
+    }
+
+    // Bind lower bound address
+    bind_array.add(lb_address_data);
+
+    // Bind page size value
+    std::string page_size_data = boost::lexical_cast<std::string>(page_size.page_size_);
+    bind_array.add(page_size_data);
+
+    // Get a context
+    PgSqlLeaseContextAlloc get_context(*this);
+    PgSqlLeaseContextPtr ctx = get_context.ctx_;
+
+    walkLeaseCollection(ctx, GET_LEASE6_PAGE, bind_array, ctx->exchange6_, callback);
+}
+
 void
 PgSqlLeaseMgr::getExpiredLeases4(Lease4Collection& expired_leases,
                                  const size_t max_leases) const {
@@ -2021,8 +2341,12 @@ PgSqlLeaseMgr::updateLeaseCommon(PgSqlLeaseContextPtr& ctx,
 
     ctx->conn_.checkStatementError(r, tagged_statements[stindex]);
 
-    int affected_rows = boost::lexical_cast<int>(PQcmdTuples(r));
+    checkUpdateLeaseResult(boost::lexical_cast<int>(PQcmdTuples(r)), *lease);
+}
 
+void
+PgSqlLeaseMgr::checkUpdateLeaseResult(const int affected_rows,
+                                      const Lease& lease) {
     // Check success case first as it is the most likely outcome.
     if (affected_rows == 1) {
         return;
@@ -2031,40 +2355,77 @@ PgSqlLeaseMgr::updateLeaseCommon(PgSqlLeaseContextPtr& ctx,
     // If no rows affected, lease doesn't exist.
     if (affected_rows == 0) {
         isc_throw(NoSuchLease, "unable to update lease for address " <<
-                  lease->addr_.toText() << " as it does not exist");
+                  lease.addr_.toText() << " as it does not exist");
     }
 
     // Should not happen - primary key constraint should only have selected
     // one row.
     isc_throw(DbOperationError, "apparently updated more than one lease "
-              "that had the address " << lease->addr_.toText());
+              "that had the address " << lease.addr_.toText());
 }
 
-void
-PgSqlLeaseMgr::updateLease4(const Lease4Ptr& lease) {
-    const StatementIndex stindex = UPDATE_LEASE4;
+PgSqlLeaseMgr::StatementIndex
+PgSqlLeaseMgr::createBindForUpdate(PgSqlLeaseContextPtr& ctx,
+                                   const Lease4Ptr& lease,
+                                   PsqlBindArray& bind_array) {
+    // Create the BIND array for the data being updated
+    ctx->exchange4_->createBindForSend(lease, bind_array);
 
-    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_UPDATE_ADDR4)
-        .arg(lease->addr_.toText());
+    // Set up the WHERE clause and append it to the SQL_BIND array
+    bind_array.add(lease->addr_.toUint32());
 
-    // Get a context
-    PgSqlLeaseContextAlloc get_context(*this);
-    PgSqlLeaseContextPtr ctx = get_context.ctx_;
+    bind_array.addTempString(PgSqlLeaseExchange::convertToDatabaseTime(lease->current_cltt_,
+                                                                       lease->current_valid_lft_));
 
+    return (UPDATE_LEASE4);
+}
+
+PgSqlLeaseMgr::StatementIndex
+PgSqlLeaseMgr::createBindForUpdate(PgSqlLeaseContextPtr& ctx,
+                                   const Lease6Ptr& lease,
+                                   PsqlBindArray& bind_array) {
     // Create the BIND array for the data being updated
+    ctx->exchange6_->createBindForSend(lease, bind_array);
+
+    // Set up the WHERE clause and append it to the BIND array
+    bind_array.addTempString(lease->addr_.toText());
+
+    bind_array.addTempString(PgSqlLeaseExchange::convertToDatabaseTime(lease->current_cltt_,
+                                                                       lease->current_valid_lft_));
+
+    return (UPDATE_LEASE6);
+}
+
+void
+PgSqlLeaseMgr::updateLeaseInternal(PgSqlLeaseContextPtr& ctx,
+                                   const Lease4Ptr& lease) {
     PsqlBindArray bind_array;
-    ctx->exchange4_->createBindForSend(lease, bind_array);
+    StatementIndex stindex = createBindForUpdate(ctx, lease, bind_array);
 
-    // Set up the WHERE clause and append it to the SQL_BIND array
-    std::string addr4_str = boost::lexical_cast<std::string>(lease->addr_.toUint32());
-    bind_array.add(addr4_str);
+    // Drop to common update code
+    updateLeaseCommon(ctx, stindex, bind_array, lease);
+}
 
-    std::string expire_str = PgSqlLeaseExchange::convertToDatabaseTime(lease->current_cltt_,
-                                                                       lease->current_valid_lft_);
-    bind_array.add(expire_str);
+void
+PgSqlLeaseMgr::updateLeaseInternal(PgSqlLeaseContextPtr& ctx,
+                                   const Lease6Ptr& lease) {
+    PsqlBindArray bind_array;
+    StatementIndex stindex = createBindForUpdate(ctx, lease, bind_array);
 
     // Drop to common update code
     updateLeaseCommon(ctx, stindex, bind_array, lease);
+}
+
+void
+PgSqlLeaseMgr::updateLease4(const Lease4Ptr& lease) {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_UPDATE_ADDR4)
+        .arg(lease->addr_.toText());
+
+    // Get a context
+    PgSqlLeaseContextAlloc get_context(*this);
+    PgSqlLeaseContextPtr ctx = get_context.ctx_;
+
+    updateLeaseInternal(ctx, lease);
 
     // Update lease current expiration time.
     lease->updateCurrentExpirationTime();
@@ -2072,8 +2433,6 @@ PgSqlLeaseMgr::updateLease4(const Lease4Ptr& lease) {
 
 void
 PgSqlLeaseMgr::updateLease6(const Lease6Ptr& lease) {
-    const StatementIndex stindex = UPDATE_LEASE6;
-
     LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_UPDATE_ADDR6)
         .arg(lease->addr_.toText())
         .arg(lease->type_);
@@ -2082,32 +2441,80 @@ PgSqlLeaseMgr::updateLease6(const Lease6Ptr& lease) {
     PgSqlLeaseContextAlloc get_context(*this);
     PgSqlLeaseContextPtr ctx = get_context.ctx_;
 
-    // Create the BIND array for the data being updated
-    PsqlBindArray bind_array;
-    ctx->exchange6_->createBindForSend(lease, bind_array);
-
-    // Set up the WHERE clause and append it to the BIND array
-    std::string addr_str = lease->addr_.toText();
-    bind_array.add(addr_str);
-
-    std::string expire_str = PgSqlLeaseExchange::convertToDatabaseTime(lease->current_cltt_,
-                                                                       lease->current_valid_lft_);
-    bind_array.add(expire_str);
-
-    // Drop to common update code
-    updateLeaseCommon(ctx, stindex, bind_array, lease);
+    updateLeaseInternal(ctx, lease);
 
     // Update lease current expiration time.
     lease->updateCurrentExpirationTime();
 }
 
-uint64_t
-PgSqlLeaseMgr::deleteLeaseCommon(StatementIndex stindex,
-                                 PsqlBindArray& bind_array) {
+template <typename LeaseCollection>
+LeaseCollection
+PgSqlLeaseMgr::updateLeasesCommon(const LeaseCollection& leases) {
+    LeaseCollection updated;
+    LeaseCollection not_updated;
+
+    if (leases.empty()) {
+        return (not_updated);
+    }
+
     // Get a context
     PgSqlLeaseContextAlloc get_context(*this);
     PgSqlLeaseContextPtr ctx = get_context.ctx_;
 
+    // Any error other than a missing lease rolls back the whole batch.
+    PgSqlTransaction transaction(ctx->conn_);
+    {
+        // Send all the updates before reading their results. All the
+        // leases of the collection use the same statement.
+        PgSqlPipeline pipeline(ctx->conn_);
+        StatementIndex stindex = UPDATE_LEASE4;
+        for (auto const& lease : leases) {
+            PsqlBindArray bind_array;
+            stindex = createBindForUpdate(ctx, lease, bind_array);
+            pipeline.send(tagged_statements[stindex], bind_array);
+        }
+        for (auto const& lease : leases) {
+            PgSqlResultPtr r = pipeline.getResult();
+            ctx->conn_.checkStatementError(*r, tagged_statements[stindex]);
+            try {
+                checkUpdateLeaseResult(boost::lexical_cast<int>(PQcmdTuples(*r)),
+                                       *lease);
+                updated.push_back(lease);
+            } catch (const NoSuchLease&) {
+                not_updated.push_back(lease);
+            }
+        }
+    }
+    transaction.commit();
+
+    // Update lease current expiration times once the leases are stored.
+    for (auto const& lease : updated) {
+        lease->updateCurrentExpirationTime();
+    }
+
+    return (not_updated);
+}
+
+Lease4Collection
+PgSqlLeaseMgr::updateLeases(const Lease4Collection& leases) {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_UPDATE_LEASES4)
+        .arg(leases.size());
+
+    return (updateLeasesCommon(leases));
+}
+
+Lease6Collection
+PgSqlLeaseMgr::updateLeases(const Lease6Collection& leases) {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_UPDATE_LEASES6)
+        .arg(leases.size());
+
+    return (updateLeasesCommon(leases));
+}
+
+uint64_t
+PgSqlLeaseMgr::deleteLeaseCommon(PgSqlLeaseContextPtr& ctx,
+                                 StatementIndex stindex,
+                                 PsqlBindArray& bind_array) {
     PgSqlResult r(PQexecPrepared(ctx->conn_, tagged_statements[stindex].name,
                                  tagged_statements[stindex].nbparams,
                                  &bind_array.values_[0],
@@ -2121,23 +2528,8 @@ PgSqlLeaseMgr::deleteLeaseCommon(StatementIndex stindex,
 }
 
 bool
-PgSqlLeaseMgr::deleteLease(const Lease4Ptr& lease) {
-    const IOAddress& addr = lease->addr_;
-    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_DELETE_ADDR)
-        .arg(addr.toText());
-
-    // Set up the WHERE clause value
-    PsqlBindArray bind_array;
-
-    std::string addr4_str = boost::lexical_cast<std::string>(addr.toUint32());
-    bind_array.add(addr4_str);
-
-    std::string expire_str = PgSqlLeaseExchange::convertToDatabaseTime(lease->current_cltt_,
-                                                                       lease->current_valid_lft_);
-    bind_array.add(expire_str);
-
-    auto affected_rows = deleteLeaseCommon(DELETE_LEASE4, bind_array);
-
+PgSqlLeaseMgr::checkDeleteLeaseResult(const uint64_t affected_rows,
+                                      const Lease& lease) {
     // Check success case first as it is the most likely outcome.
     if (affected_rows == 1) {
         return (true);
@@ -2151,42 +2543,133 @@ PgSqlLeaseMgr::deleteLease(const Lease4Ptr& lease) {
     // Should not happen - primary key constraint should only have selected
     // one row.
     isc_throw(DbOperationError, "apparently deleted more than one lease "
-              "that had the address " << lease->addr_.toText());
+              "that had the address " << lease.addr_.toText());
+}
+
+PgSqlLeaseMgr::StatementIndex
+PgSqlLeaseMgr::createBindForDelete(const Lease4Ptr& lease,
+                                   PsqlBindArray& bind_array) {
+    // Set up the WHERE clause value
+    bind_array.add(lease->addr_.toUint32());
+
+    bind_array.addTempString(PgSqlLeaseExchange::convertToDatabaseTime(lease->current_cltt_,
+                                                                       lease->current_valid_lft_));
+
+    return (DELETE_LEASE4);
+}
+
+PgSqlLeaseMgr::StatementIndex
+PgSqlLeaseMgr::createBindForDelete(const Lease6Ptr& lease,
+                                   PsqlBindArray& bind_array) {
+    // Set up the WHERE clause value
+    bind_array.addTempString(lease->addr_.toText());
+
+    bind_array.addTempString(PgSqlLeaseExchange::convertToDatabaseTime(lease->current_cltt_,
+                                                                       lease->current_valid_lft_));
+
+    return (DELETE_LEASE6);
+}
+
+bool
+PgSqlLeaseMgr::deleteLeaseInternal(PgSqlLeaseContextPtr& ctx,
+                                   const Lease4Ptr& lease) {
+    PsqlBindArray bind_array;
+    StatementIndex stindex = createBindForDelete(lease, bind_array);
+
+    auto affected_rows = deleteLeaseCommon(ctx, stindex, bind_array);
+
+    return (checkDeleteLeaseResult(affected_rows, *lease));
+}
+
+bool
+PgSqlLeaseMgr::deleteLeaseInternal(PgSqlLeaseContextPtr& ctx,
+                                   const Lease6Ptr& lease) {
+    PsqlBindArray bind_array;
+    StatementIndex stindex = createBindForDelete(lease, bind_array);
+
+    auto affected_rows = deleteLeaseCommon(ctx, stindex, bind_array);
+
+    return (checkDeleteLeaseResult(affected_rows, *lease));
+}
+
+bool
+PgSqlLeaseMgr::deleteLease(const Lease4Ptr& lease) {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_DELETE_ADDR)
+        .arg(lease->addr_.toText());
+
+    // Get a context
+    PgSqlLeaseContextAlloc get_context(*this);
+    PgSqlLeaseContextPtr ctx = get_context.ctx_;
+
+    return (deleteLeaseInternal(ctx, lease));
 }
 
 bool
 PgSqlLeaseMgr::deleteLease(const Lease6Ptr& lease) {
-    const IOAddress& addr = lease->addr_;
     LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL,
               DHCPSRV_PGSQL_DELETE_ADDR)
-        .arg(addr.toText());
-
-    // Set up the WHERE clause value
-    PsqlBindArray bind_array;
+        .arg(lease->addr_.toText());
 
-    std::string addr6_str = addr.toText();
-    bind_array.add(addr6_str);
+    // Get a context
+    PgSqlLeaseContextAlloc get_context(*this);
+    PgSqlLeaseContextPtr ctx = get_context.ctx_;
 
-    std::string expire_str = PgSqlLeaseExchange::convertToDatabaseTime(lease->current_cltt_,
-                                                                       lease->current_valid_lft_);
-    bind_array.add(expire_str);
+    return (deleteLeaseInternal(ctx, lease));
+}
 
-    auto affected_rows = deleteLeaseCommon(DELETE_LEASE6, bind_array);
+template <typename LeaseCollection>
+LeaseCollection
+PgSqlLeaseMgr::deleteLeasesCommon(const LeaseCollection& leases) {
+    LeaseCollection not_deleted;
 
-    // Check success case first as it is the most likely outcome.
-    if (affected_rows == 1) {
-        return (true);
+    if (leases.empty()) {
+        return (not_deleted);
     }
 
-    // If no rows affected, lease doesn't exist.
-    if (affected_rows == 0) {
-        return (false);
+    // Get a context
+    PgSqlLeaseContextAlloc get_context(*this);
+    PgSqlLeaseContextPtr ctx = get_context.ctx_;
+
+    // Any error rolls back the whole batch.
+    PgSqlTransaction transaction(ctx->conn_);
+    {
+        // Send all the deletions before reading their results. All the
+        // leases of the collection use the same statement.
+        PgSqlPipeline pipeline(ctx->conn_);
+        StatementIndex stindex = DELETE_LEASE4;
+        for (auto const& lease : leases) {
+            PsqlBindArray bind_array;
+            stindex = createBindForDelete(lease, bind_array);
+            pipeline.send(tagged_statements[stindex], bind_array);
+        }
+        for (auto const& lease : leases) {
+            PgSqlResultPtr r = pipeline.getResult();
+            ctx->conn_.checkStatementError(*r, tagged_statements[stindex]);
+            if (!checkDeleteLeaseResult(boost::lexical_cast<uint64_t>(PQcmdTuples(*r)),
+                                        *lease)) {
+                not_deleted.push_back(lease);
+            }
+        }
     }
+    transaction.commit();
 
-    // Should not happen - primary key constraint should only have selected
-    // one row.
-    isc_throw(DbOperationError, "apparently deleted more than one lease "
-              "that had the address " << lease->addr_.toText());
+    return (not_deleted);
+}
+
+Lease4Collection
+PgSqlLeaseMgr::deleteLeases(const Lease4Collection& leases) {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_DELETE_LEASES)
+        .arg(leases.size());
+
+    return (deleteLeasesCommon(leases));
+}
+
+Lease6Collection
+PgSqlLeaseMgr::deleteLeases(const Lease6Collection& leases) {
+    LOG_DEBUG(dhcpsrv_logger, DHCPSRV_DBG_TRACE_DETAIL, DHCPSRV_PGSQL_DELETE_LEASES)
+        .arg(leases.size());
+
+    return (deleteLeasesCommon(leases));
 }
 
 uint64_t
@@ -2217,8 +2700,12 @@ PgSqlLeaseMgr::deleteExpiredReclaimedLeasesCommon(const uint32_t secs,
         static_cast<time_t>(secs));
     bind_array.add(expiration_str);
 
+    // Get a context
+    PgSqlLeaseContextAlloc get_context(*this);
+    PgSqlLeaseContextPtr ctx = get_context.ctx_;
+
     // Delete leases.
-    return (deleteLeaseCommon(statement_index, bind_array));
+    return (deleteLeaseCommon(ctx, statement_index, bind_array));
 }
 
 LeaseStatsQueryPtr
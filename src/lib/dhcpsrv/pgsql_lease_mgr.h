@@ -299,6 +299,32 @@ public:
     getLeases4(const asiolink::IOAddress& lower_bound_address,
                const LeasePageSize& page_size) const;
 
+    /// @brief Passes all IPv4 leases to a callback.
+    ///
+    /// The rows are received from the server one at a time rather than
+    /// as a whole result set.
+    ///
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases4(const Lease4Callback& callback) const;
+
+    /// @brief Passes all IPv4 leases for the particular subnet identifier
+    /// to a callback.
+    ///
+    /// @param subnet_id subnet identifier.
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases4(SubnetID subnet_id,
+                             const Lease4Callback& callback) const;
+
+    /// @brief Passes a page of IPv4 leases to a callback.
+    ///
+    /// @param lower_bound_address IPv4 address used as lower bound for the
+    /// range.
+    /// @param page_size maximum size of the page.
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases4(const asiolink::IOAddress& lower_bound_address,
+                             const LeasePageSize& page_size,
+                             const Lease4Callback& callback) const;
+
     /// @brief Returns existing IPv6 lease for a given IPv6 address.
     ///
     /// For a given address, we assume that there will be only one lease.
@@ -407,6 +433,32 @@ public:
     getLeases6(const asiolink::IOAddress& lower_bound_address,
                const LeasePageSize& page_size) const;
 
+    /// @brief Passes all IPv6 leases to a callback.
+    ///
+    /// The rows are received from the server one at a time rather than
+    /// as a whole result set.
+    ///
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases6(const Lease6Callback& callback) const;
+
+    /// @brief Passes all IPv6 leases for the particular subnet identifier
+    /// to a callback.
+    ///
+    /// @param subnet_id subnet identifier.
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases6(SubnetID subnet_id,
+                             const Lease6Callback& callback) const;
+
+    /// @brief Passes a page of IPv6 leases to a callback.
+    ///
+    /// @param lower_bound_address IPv6 address used as lower bound for the
+    /// range.
+    /// @param page_size maximum size of the page.
+    /// @param callback callback invoked for each lease.
+    virtual void walkLeases6(const asiolink::IOAddress& lower_bound_address,
+                             const LeasePageSize& page_size,
+                             const Lease6Callback& callback) const;
+
     /// @brief Returns a collection of expired DHCPv4 leases.
     ///
     /// This method returns at most @c max_leases expired leases. The leases
@@ -509,6 +561,85 @@ public:
     /// different expiration time.
     virtual bool deleteLease(const Lease6Ptr& lease);
 
+    /// @brief Adds a collection of IPv4 leases.
+    ///
+    /// The leases are added using one connection within a single
+    /// transaction. Leases which already exist are skipped using an
+    /// INSERT ... ON CONFLICT DO NOTHING statement, so as they don't
+    /// abort the transaction.
+    ///
+    /// @param leases leases to be added.
+    ///
+    /// @return leases which were not added because they already exist.
+    ///
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed. None of the leases is added in this case.
+    virtual Lease4Collection addLeases(const Lease4Collection& leases);
+
+    /// @brief Adds a collection of IPv6 leases.
+    ///
+    /// See @c addLeases(const Lease4Collection&) for details.
+    ///
+    /// @param leases leases to be added.
+    ///
+    /// @return leases which were not added because they already exist.
+    ///
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed. None of the leases is added in this case.
+    virtual Lease6Collection addLeases(const Lease6Collection& leases);
+
+    /// @brief Updates a collection of IPv4 leases.
+    ///
+    /// The leases are updated using one connection within a single
+    /// transaction. The same conditions as for @c updateLease4 apply to
+    /// each lease.
+    ///
+    /// @param leases leases to be updated.
+    ///
+    /// @return leases which were not updated because they do not exist.
+    ///
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed. None of the leases is updated in this case.
+    virtual Lease4Collection updateLeases(const Lease4Collection& leases);
+
+    /// @brief Updates a collection of IPv6 leases.
+    ///
+    /// See @c updateLeases(const Lease4Collection&) for details.
+    ///
+    /// @param leases leases to be updated.
+    ///
+    /// @return leases which were not updated because they do not exist.
+    ///
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed. None of the leases is updated in this case.
+    virtual Lease6Collection updateLeases(const Lease6Collection& leases);
+
+    /// @brief Deletes a collection of IPv4 leases.
+    ///
+    /// The leases are deleted using one connection within a single
+    /// transaction. The same conditions as for @c deleteLease apply to
+    /// each lease.
+    ///
+    /// @param leases leases to be deleted.
+    ///
+    /// @return leases which were not deleted because they do not exist.
+    ///
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed. None of the leases is deleted in this case.
+    virtual Lease4Collection deleteLeases(const Lease4Collection& leases);
+
+    /// @brief Deletes a collection of IPv6 leases.
+    ///
+    /// See @c deleteLeases(const Lease4Collection&) for details.
+    ///
+    /// @param leases leases to be deleted.
+    ///
+    /// @return leases which were not deleted because they do not exist.
+    ///
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed. None of the leases is deleted in this case.
+    virtual Lease6Collection deleteLeases(const Lease6Collection& leases);
+
     /// @brief Deletes all expired-reclaimed DHCPv4 leases.
     ///
     /// @param secs Number of seconds since expiration of leases before
@@ -690,7 +821,9 @@ public:
         GET_LEASE6_HOSTNAME,         // Get IPv6 leases by hostname
         GET_LEASE6_EXPIRE,           // Get lease6 by expiration.
         INSERT_LEASE4,               // Add entry to lease4 table
+        INSERT_LEASE4_NO_DUP,        // Add entry to lease4 table unless it exists
         INSERT_LEASE6,               // Add entry to lease6 table
+        INSERT_LEASE6_NO_DUP,        // Add entry to lease6 table unless it exists
         UPDATE_LEASE4,               // Update a Lease4 entry
         UPDATE_LEASE6,               // Update a Lease6 entry
         ALL_LEASE4_STATS,            // Fetches IPv4 lease statistics
@@ -724,6 +857,21 @@ private:
                         StatementIndex stindex,
                         db::PsqlBindArray& bind_array);
 
+    /// @brief Checks the result of a lease insertion.
+    ///
+    /// @param ctx Context
+    /// @param stindex Index of the statement which was executed
+    /// @param r Result of the statement.
+    ///
+    /// @return true if the lease was added, false if it was not added because
+    ///         a lease with that address already exists in the database.
+    ///
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed.
+    bool checkAddLeaseResult(PgSqlLeaseContextPtr& ctx,
+                             StatementIndex stindex,
+                             const db::PgSqlResult& r);
+
     /// @brief Get Lease Collection Common Code
     ///
     /// This method performs the common actions for obtaining multiple leases
@@ -799,6 +947,29 @@ private:
         getLeaseCollection(ctx, stindex, bind_array, ctx->exchange6_, result);
     }
 
+    /// @brief Passes leases to a callback.
+    ///
+    /// This method performs the common actions of the walkLeases4() and
+    /// walkLeases6() methods. The query is run in the single-row mode of
+    /// libpq so the rows are passed to the callback as they are received
+    /// and the memory used does not depend on the number of leases.
+    ///
+    /// @param ctx Context
+    /// @param stindex Index of statement being executed
+    /// @param bind_array array of input parameters
+    /// @param exchange Exchange object to use
+    /// @param callback Callback invoked for each lease.
+    ///
+    /// @throw isc::dhcp::BadValue Data retrieved from the database was invalid.
+    /// @throw isc::db::DbOperationError An operation on the open database has
+    ///        failed.
+    template <typename Exchange, typename Callback>
+    void walkLeaseCollection(PgSqlLeaseContextPtr& ctx,
+                             StatementIndex stindex,
+                             db::PsqlBindArray& bind_array,
+                             Exchange& exchange,
+                             const Callback& callback) const;
+
     /// @brief Get Lease4 Common Code
     ///
     /// This method performs the common actions for the various getLease4()
@@ -870,12 +1041,24 @@ private:
                            db::PsqlBindArray& bind_array,
                            const LeasePtr& lease);
 
+    /// @brief Checks the number of leases affected by a lease update.
+    ///
+    /// @param affected_rows Number of updated rows.
+    /// @param lease The lease which was updated.
+    ///
+    /// @throw NoSuchLease Could not update a lease because no lease matches
+    ///        the address given.
+    /// @throw isc::db::DbOperationError More than one lease was updated.
+    static void checkUpdateLeaseResult(const int affected_rows,
+                                       const Lease& lease);
+
     /// @brief Delete lease common code
     ///
     /// Holds the common code for deleting a lease.  It binds the parameters
     /// to the prepared statement, executes the statement and checks to
     /// see how many rows were deleted.
     ///
+    /// @param ctx Context
     /// @param stindex Index of prepared statement to be executed
     /// @param bind_array Array containing lease values and where clause
     /// parameters for the delete
@@ -884,9 +1067,172 @@ private:
     ///
     /// @throw isc::db::DbOperationError An operation on the open database has
     ///        failed.
-    uint64_t deleteLeaseCommon(StatementIndex stindex,
+    uint64_t deleteLeaseCommon(PgSqlLeaseContextPtr& ctx,
+                               StatementIndex stindex,
                                db::PsqlBindArray& bind_array);
 
+    /// @brief Checks the number of leases affected by a lease deletion.
+    ///
+    /// @param affected_rows Number of deleted rows.
+    /// @param lease The lease which was deleted.
+    ///
+    /// @return true if the lease was deleted, false if it does not exist.
+    /// @throw isc::db::DbOperationError More than one lease was deleted.
+    static bool checkDeleteLeaseResult(const uint64_t affected_rows,
+                                       const Lease& lease);
+
+    /// @brief Creates the bind array to add an IPv4 lease.
+    ///
+    /// @param ctx Context
+    /// @param lease Pointer to the lease being added.
+    /// @param [out] bind_array Array receiving the lease values.
+    void createBindForAdd(PgSqlLeaseContextPtr& ctx, const Lease4Ptr& lease,
+                          db::PsqlBindArray& bind_array);
+
+    /// @brief Creates the bind array to add an IPv6 lease.
+    ///
+    /// @param ctx Context
+    /// @param lease Pointer to the lease being added.
+    /// @param [out] bind_array Array receiving the lease values.
+    void createBindForAdd(PgSqlLeaseContextPtr& ctx, const Lease6Ptr& lease,
+                          db::PsqlBindArray& bind_array);
+
+    /// @brief Creates the bind array to update an IPv4 lease.
+    ///
+    /// @param ctx Context
+    /// @param lease Pointer to the lease being updated.
+    /// @param [out] bind_array Array receiving the lease values and the
+    ///        where clause parameters.
+    ///
+    /// @return The index of the update statement.
+    StatementIndex createBindForUpdate(PgSqlLeaseContextPtr& ctx,
+                                       const Lease4Ptr& lease,
+                                       db::PsqlBindArray& bind_array);
+
+    /// @brief Creates the bind array to update an IPv6 lease.
+    ///
+    /// @param ctx Context
+    /// @param lease Pointer to the lease being updated.
+    /// @param [out] bind_array Array receiving the lease values and the
+    ///        where clause parameters.
+    ///
+    /// @return The index of the update statement.
+    StatementIndex createBindForUpdate(PgSqlLeaseContextPtr& ctx,
+                                       const Lease6Ptr& lease,
+                                       db::PsqlBindArray& bind_array);
+
+    /// @brief Creates the bind array to delete an IPv4 lease.
+    ///
+    /// @param lease Pointer to the lease being deleted.
+    /// @param [out] bind_array Array receiving the where clause parameters.
+    ///
+    /// @return The index of the delete statement.
+    static StatementIndex createBindForDelete(const Lease4Ptr& lease,
+                                              db::PsqlBindArray& bind_array);
+
+    /// @brief Creates the bind array to delete an IPv6 lease.
+    ///
+    /// @param lease Pointer to the lease being deleted.
+    /// @param [out] bind_array Array receiving the where clause parameters.
+    ///
+    /// @return The index of the delete statement.
+    static StatementIndex createBindForDelete(const Lease6Ptr& lease,
+                                              db::PsqlBindArray& bind_array);
+
+    /// @brief Adds an IPv4 lease using a given context.
+    ///
+    /// @param ctx Context
+    /// @param stindex One of the @c INSERT_LEASE4 or @c INSERT_LEASE4_NO_DUP.
+    /// @param lease Pointer to the lease being added.
+    ///
+    /// @return true if the lease was added, false if it already exists.
+    bool addLeaseInternal(PgSqlLeaseContextPtr& ctx, StatementIndex stindex,
+                          const Lease4Ptr& lease);
+
+    /// @brief Adds an IPv6 lease using a given context.
+    ///
+    /// @param ctx Context
+    /// @param stindex One of the @c INSERT_LEASE6 or @c INSERT_LEASE6_NO_DUP.
+    /// @param lease Pointer to the lease being added.
+    ///
+    /// @return true if the lease was added, false if it already exists.
+    bool addLeaseInternal(PgSqlLeaseContextPtr& ctx, StatementIndex stindex,
+                          const Lease6Ptr& lease);
+
+    /// @brief Updates an IPv4 lease using a given context.
+    ///
+    /// It does not update the current expiration time of the lease.
+    ///
+    /// @param ctx Context
+    /// @param lease Pointer to the lease being updated.
+    ///
+    /// @throw NoSuchLease Could not update a lease because no lease matches
+    ///        the address and the expiration time given.
+    void updateLeaseInternal(PgSqlLeaseContextPtr& ctx, const Lease4Ptr& lease);
+
+    /// @brief Updates an IPv6 lease using a given context.
+    ///
+    /// It does not update the current expiration time of the lease.
+    ///
+    /// @param ctx Context
+    /// @param lease Pointer to the lease being updated.
+    ///
+    /// @throw NoSuchLease Could not update a lease because no lease matches
+    ///        the address and the expiration time given.
+    void updateLeaseInternal(PgSqlLeaseContextPtr& ctx, const Lease6Ptr& lease);
+
+    /// @brief Deletes an IPv4 lease using a given context.
+    ///
+    /// @param ctx Context
+    /// @param lease Pointer to the lease being deleted.
+    ///
+    /// @return true if the lease was deleted, false if it does not exist.
+    bool deleteLeaseInternal(PgSqlLeaseContextPtr& ctx, const Lease4Ptr& lease);
+
+    /// @brief Deletes an IPv6 lease using a given context.
+    ///
+    /// @param ctx Context
+    /// @param lease Pointer to the lease being deleted.
+    ///
+    /// @return true if the lease was deleted, false if it does not exist.
+    bool deleteLeaseInternal(PgSqlLeaseContextPtr& ctx, const Lease6Ptr& lease);
+
+    /// @brief Add leases common code
+    ///
+    /// Adds the leases within a single transaction. The statements are
+    /// sent in a pipeline when the client library supports it.
+    ///
+    /// @param stindex One of the @c INSERT_LEASE4_NO_DUP or
+    ///        @c INSERT_LEASE6_NO_DUP.
+    /// @param leases Leases to be added.
+    ///
+    /// @return Leases which were not added.
+    template <typename LeaseCollection>
+    LeaseCollection addLeasesCommon(StatementIndex stindex,
+                                    const LeaseCollection& leases);
+
+    /// @brief Update leases common code
+    ///
+    /// Updates the leases within a single transaction. The statements are
+    /// sent in a pipeline when the client library supports it.
+    ///
+    /// @param leases Leases to be updated.
+    ///
+    /// @return Leases which were not updated.
+    template <typename LeaseCollection>
+    LeaseCollection updateLeasesCommon(const LeaseCollection& leases);
+
+    /// @brief Delete leases common code
+    ///
+    /// Deletes the leases within a single transaction. The statements are
+    /// sent in a pipeline when the client library supports it.
+    ///
+    /// @param leases Leases to be deleted.
+    ///
+    /// @return Leases which were not deleted.
+    template <typename LeaseCollection>
+    LeaseCollection deleteLeasesCommon(const LeaseCollection& leases);
+
     /// @brief Delete expired-reclaimed leases.
     ///
     /// @param secs Number of seconds since expiration of leases before
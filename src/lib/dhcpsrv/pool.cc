@@ -1,4 +1,4 @@
-// Copyright (C) 2012-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2012-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -22,7 +22,7 @@ Pool::Pool(Lease::Type type, const isc::asiolink::IOAddress& first,
            const isc::asiolink::IOAddress& last)
     :id_(getNextID()), first_(first), last_(last), type_(type),
      capacity_(0), cfg_option_(new CfgOption()), client_class_(""),
-     last_allocated_(first), last_allocated_valid_(false),
+     client_class_id_(0), last_allocated_(first), last_allocated_valid_(false),
      permutation_() {
 }
 
@@ -31,11 +31,12 @@ bool Pool::inRange(const isc::asiolink::IOAddress& addr) const {
 }
 
 bool Pool::clientSupported(const ClientClasses& classes) const {
-    return (client_class_.empty() || classes.contains(client_class_));
+    return (client_class_.empty() || classes.contains(client_class_id_));
 }
 
 void Pool::allowClientClass(const ClientClass& class_name) {
     client_class_ = class_name;
+    client_class_id_ = ClientClassRegistry::instance().intern(class_name);
 }
 
 std::string
@@ -1,4 +1,4 @@
-// Copyright (C) 2012-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2012-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -227,6 +227,11 @@ protected:
     /// @ref Network::client_class_
     ClientClass client_class_;
 
+    /// @brief Identifier of the interned @ref client_class_ name.
+    ///
+    /// The client classes are checked using this identifier.
+    ClientClassId client_class_id_;
+
     /// @brief Required classes
     ///
     /// @ref isc::dhcp::Network::required_classes_
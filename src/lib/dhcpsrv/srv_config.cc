@@ -284,8 +284,45 @@ SrvConfig::removeStatistics() {
     getCfgSubnets6()->removeStatistics();
 }
 
+void
+SrvConfig::removeStatistics(const SrvConfig& next) {
+    getCfgSubnets4()->removeStatistics(*next.getCfgSubnets4());
+
+    getCfgSubnets6()->removeStatistics(*next.getCfgSubnets6());
+}
+
 void
 SrvConfig::updateStatistics() {
+    updateSampleLimits();
+
+    // Updating subnet statistics involves updating lease statistics, which
+    // is done by the LeaseMgr.  Since servers with subnets, must have a
+    // LeaseMgr, we do not bother updating subnet stats for servers without
+    // a lease manager, such as D2. @todo We should probably examine why
+    // "SrvConfig" is being used by D2.
+    if (LeaseMgrFactory::haveInstance()) {
+        // Updates  statistics for v4 and v6 subnets
+        getCfgSubnets4()->updateStatistics();
+
+        getCfgSubnets6()->updateStatistics();
+    }
+}
+
+size_t
+SrvConfig::updateStatistics(const SrvConfig& previous) {
+    updateSampleLimits();
+
+    size_t recounted = 0;
+    if (LeaseMgrFactory::haveInstance()) {
+        recounted += getCfgSubnets4()->updateStatistics(*previous.getCfgSubnets4());
+
+        recounted += getCfgSubnets6()->updateStatistics(*previous.getCfgSubnets6());
+    }
+    return (recounted);
+}
+
+void
+SrvConfig::updateSampleLimits() {
     // Update default sample limits.
     stats::StatsMgr& stats_mgr = stats::StatsMgr::instance();
     ConstElementPtr samples =
@@ -308,18 +345,6 @@ SrvConfig::updateStatistics() {
             stats_mgr.setMaxSampleAgeAll(max_age);
         }
     }
-
-    // Updating subnet statistics involves updating lease statistics, which
-    // is done by the LeaseMgr.  Since servers with subnets, must have a
-    // LeaseMgr, we do not bother updating subnet stats for servers without
-    // a lease manager, such as D2. @todo We should probably examine why
-    // "SrvConfig" is being used by D2.
-    if (LeaseMgrFactory::haveInstance()) {
-        // Updates  statistics for v4 and v6 subnets
-        getCfgSubnets4()->updateStatistics();
-
-        getCfgSubnets6()->updateStatistics();
-    }
 }
 
 isc::data::ConstElementPtr
@@ -701,6 +701,27 @@ public:
     /// @ref CfgSubnets6::removeStatistics for details.
     void removeStatistics();
 
+    /// @brief Updates statistics after a reconfiguration.
+    ///
+    /// This method updates the statistics like @ref updateStatistics but
+    /// the lease statistics of the subnets taken over from the previous
+    /// configuration are kept. See @ref CfgSubnets4::updateStatistics and
+    /// @ref CfgSubnets6::updateStatistics for details.
+    ///
+    /// @param previous The previous configuration.
+    /// @return The number of subnets whose lease statistics were recounted.
+    size_t updateStatistics(const SrvConfig& previous);
+
+    /// @brief Removes statistics before a reconfiguration.
+    ///
+    /// This method removes the statistics like @ref removeStatistics but
+    /// the statistics of the subnets taken over by the next configuration
+    /// are kept. See @ref CfgSubnets4::removeStatistics and
+    /// @ref CfgSubnets6::removeStatistics for details.
+    ///
+    /// @param next The next configuration.
+    void removeStatistics(const SrvConfig& next);
+
     /// @brief Sets decline probation-period
     ///
     /// Probation-period is the timer, expressed, in seconds, that specifies how
@@ -881,6 +902,9 @@ public:
 
 private:
 
+    /// @brief Updates the default sample limits of the statistics.
+    void updateSampleLimits();
+
     /// @brief Merges the DHCPv4 configuration specified as a parameter into
     /// this configuration.
     ///
@@ -1,4 +1,4 @@
-// Copyright (C) 2015-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2015-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,9 @@
 #include <dhcp/duid.h>
 #include <dhcp/option_data_types.h>
 #include <dhcp_ddns/ncr_msg.h>
+#include <database/db_exceptions.h>
+#include <dhcpsrv/memfile_lease_mgr.h>
+#include <dhcpsrv/resource_handler.h>
 #include <dhcpsrv/tests/alloc_engine_utils.h>
 #include <dhcpsrv/testutils/test_utils.h>
 #include <hooks/hooks_manager.h>
@@ -24,6 +27,7 @@
 using namespace std;
 using namespace isc;
 using namespace isc::asiolink;
+using namespace isc::db;
 using namespace isc::dhcp;
 using namespace isc::dhcp::test;
 using namespace isc::dhcp_ddns;
@@ -2320,4 +2324,262 @@ TEST_F(ExpirationAllocEngine4Test, reclaimDeclinedHook2) {
     testReclaimDeclinedHook(true); // true = use skip callout
 }
 
+// This test verifies that the expired leases are reclaimed concurrently
+// with the packet processing.
+TEST_F(ExpirationAllocEngine4Test, reclaimExpiredLeasesConcurrently) {
+    for (unsigned int i = 0; i < TEST_LEASES_NUM; ++i) {
+        // Mark leases with even indexes as expired.
+        if (evenLeaseIndex(i)) {
+            // The higher the index, the more expired the lease.
+            expire(i, 10 + i);
+        }
+    }
+
+    AllocEngine::ReclaimPass pass;
+    ASSERT_NO_THROW(pass = engine_->reclaimExpiredLeasesConcurrently4(0, false));
+    EXPECT_EQ(TEST_LEASES_NUM / 2, pass.found_);
+    EXPECT_EQ(TEST_LEASES_NUM / 2, pass.reclaimed_);
+    EXPECT_EQ(0, pass.deferred_);
+    // The most expired lease has the highest even index.
+    EXPECT_EQ(getLease(TEST_LEASES_NUM - 2)->getExpirationTime(),
+              pass.oldest_expire_);
+
+    // Leases with even indexes should be marked as reclaimed.
+    EXPECT_TRUE(testLeases(&leaseReclaimed, &evenLeaseIndex));
+    // Leases with odd indexes shouldn't be marked as reclaimed.
+    EXPECT_TRUE(testLeases(&leaseNotReclaimed, &oddLeaseIndex));
+    EXPECT_TRUE(testStatistics("reclaimed-leases", TEST_LEASES_NUM / 2));
+
+    // A second pass finds nothing to reclaim.
+    ASSERT_NO_THROW(pass = engine_->reclaimExpiredLeasesConcurrently4(0, false));
+    EXPECT_EQ(0, pass.found_);
+    EXPECT_EQ(0, pass.oldest_expire_);
+}
+
+// This test verifies that the expired leases may be removed when they
+// are reclaimed concurrently with the packet processing.
+TEST_F(ExpirationAllocEngine4Test, reclaimExpiredLeasesConcurrentlyDelete) {
+    for (unsigned int i = 0; i < TEST_LEASES_NUM; ++i) {
+        // Mark leases with even indexes as expired.
+        if (evenLeaseIndex(i)) {
+            expire(i, 10 + i);
+        }
+    }
+
+    AllocEngine::ReclaimPass pass;
+    ASSERT_NO_THROW(pass = engine_->reclaimExpiredLeasesConcurrently4(0, true));
+    EXPECT_EQ(TEST_LEASES_NUM / 2, pass.reclaimed_);
+
+    // Leases with odd indexes should be retained.
+    EXPECT_TRUE(testLeases(&leaseNotReclaimed, &oddLeaseIndex));
+    // Leases with even indexes should have been removed.
+    EXPECT_TRUE(testLeases(&leaseDoesntExist, &evenLeaseIndex));
+}
+
+// This test verifies that a lease locked by a packet processing thread
+// is left to a next pass of the concurrent reclamation.
+TEST_F(ExpirationAllocEngine4Test, reclaimExpiredLeasesConcurrentlyDeferred) {
+    for (unsigned int i = 0; i < TEST_LEASES_NUM; ++i) {
+        expire(i, 1000 - i);
+    }
+
+    AllocEngine::ReclaimPass pass;
+    {
+        // Lock the first lease as a packet processing thread would do.
+        ResourceHandler4 resource_handler;
+        ASSERT_TRUE(resource_handler.tryLock4(leases_[0]->addr_));
+
+        ASSERT_NO_THROW(pass = engine_->reclaimExpiredLeasesConcurrently4(0, false));
+        EXPECT_EQ(TEST_LEASES_NUM, pass.found_);
+        EXPECT_EQ(TEST_LEASES_NUM - 1, pass.reclaimed_);
+        EXPECT_EQ(1, pass.deferred_);
+        EXPECT_TRUE(leaseNotReclaimed(getLease(0)));
+        EXPECT_TRUE(testLeases(&leaseReclaimed, &allLeaseIndexes,
+                               LowerBound(1), UpperBound(TEST_LEASES_NUM)));
+    }
+
+    // The lease is reclaimed by the next pass.
+    ASSERT_NO_THROW(pass = engine_->reclaimExpiredLeasesConcurrently4(0, false));
+    EXPECT_EQ(1, pass.found_);
+    EXPECT_EQ(1, pass.reclaimed_);
+    EXPECT_EQ(0, pass.deferred_);
+    EXPECT_TRUE(testLeases(&leaseReclaimed, &allLeaseIndexes));
+}
+
+// This test verifies that the lease is reclaimed before it is reused
+// when the leases are reclaimed by a background thread.
+TEST_F(ExpirationAllocEngine4Test, reclaimReusedLeasesBackground) {
+    engine_->setBackgroundReclamation(true);
+    testReclaimReusedLeases(DHCPREQUEST, false, false);
+}
+
+// This test verifies that the lease is not reclaimed again when it is
+// reused after it was reclaimed by a background thread.
+TEST_F(ExpirationAllocEngine4Test, reclaimReusedLeasesBackgroundAlreadyReclaimed) {
+    engine_->setBackgroundReclamation(true);
+    testReclaimReusedLeases(DHCPREQUEST, false, true);
+}
+
+/// @brief Memfile lease manager whose batch operations always fail and
+/// whose single lease operations fail for one address.
+class FailingBatchLeaseMgr : public Memfile_LeaseMgr {
+public:
+
+    /// @brief Constructor.
+    ///
+    /// @param parameters Memfile parameters.
+    /// @param failing_address Address of the lease which can't be written.
+    FailingBatchLeaseMgr(const DatabaseConnection::ParameterMap& parameters,
+                         const IOAddress& failing_address)
+        : Memfile_LeaseMgr(parameters), failing_address_(failing_address) {
+    }
+
+    using Memfile_LeaseMgr::deleteLease;
+
+    /// @brief Always fails.
+    virtual Lease4Collection updateLeases(const Lease4Collection&) {
+        isc_throw(DbOperationError, "batch update failed");
+    }
+
+    /// @brief Always fails.
+    virtual Lease6Collection updateLeases(const Lease6Collection&) {
+        isc_throw(DbOperationError, "batch update failed");
+    }
+
+    /// @brief Always fails.
+    virtual Lease4Collection deleteLeases(const Lease4Collection&) {
+        isc_throw(DbOperationError, "batch delete failed");
+    }
+
+    /// @brief Always fails.
+    virtual Lease6Collection deleteLeases(const Lease6Collection&) {
+        isc_throw(DbOperationError, "batch delete failed");
+    }
+
+    /// @brief Fails for the failing address.
+    virtual void updateLease4(const Lease4Ptr& lease) {
+        checkAddress(lease);
+        Memfile_LeaseMgr::updateLease4(lease);
+    }
+
+    /// @brief Fails for the failing address.
+    virtual void updateLease6(const Lease6Ptr& lease) {
+        checkAddress(lease);
+        Memfile_LeaseMgr::updateLease6(lease);
+    }
+
+    /// @brief Fails for the failing address.
+    virtual bool deleteLease(const Lease4Ptr& lease) {
+        checkAddress(lease);
+        return (Memfile_LeaseMgr::deleteLease(lease));
+    }
+
+    /// @brief Fails for the failing address.
+    virtual bool deleteLease(const Lease6Ptr& lease) {
+        checkAddress(lease);
+        return (Memfile_LeaseMgr::deleteLease(lease));
+    }
+
+private:
+
+    /// @brief Throws if the lease has the failing address.
+    ///
+    /// @param lease Lease to be written.
+    void checkAddress(const LeasePtr& lease) const {
+        if (lease->addr_ == failing_address_) {
+            isc_throw(DbOperationError, "lease write failed");
+        }
+    }
+
+    /// @brief Address of the lease which can't be written.
+    IOAddress failing_address_;
+};
+
+// This test verifies that the DHCPv4 leases of a batch which failed are
+// reclaimed one by one, except the lease which fails again.
+TEST(ReclaimLeasesInDatabaseTest, batchFailure4) {
+    DatabaseConnection::ParameterMap pmap;
+    pmap["universe"] = "4";
+    pmap["persist"] = "false";
+    FailingBatchLeaseMgr lease_mgr(pmap, IOAddress("10.0.0.3"));
+
+    Lease4Collection leases;
+    for (uint8_t i = 1; i <= 5; ++i) {
+        HWAddrPtr hwaddr(new HWAddr(std::vector<uint8_t>(6, i), HTYPE_ETHER));
+        Lease4Ptr lease(new Lease4(IOAddress("10.0.0." + std::to_string(i)),
+                                   hwaddr, ClientIdPtr(), 60, time(NULL) - 100,
+                                   SubnetID(1)));
+        ASSERT_TRUE(lease_mgr.addLease(Lease4Ptr(new Lease4(*lease))));
+        leases.push_back(lease);
+    }
+
+    NakedAllocEngine engine(AllocEngine::ALLOC_ITERATIVE, 0, false);
+
+    // Update the first three leases: the third fails.
+    Lease4Collection updated(leases.begin(), leases.begin() + 3);
+    EXPECT_EQ(2, engine.reclaimLeasesInDatabase(lease_mgr, Lease4Collection(),
+                                                updated));
+    Lease4Ptr lease = lease_mgr.getLease4(IOAddress("10.0.0.1"));
+    ASSERT_TRUE(lease);
+    EXPECT_TRUE(lease->stateExpiredReclaimed());
+    lease = lease_mgr.getLease4(IOAddress("10.0.0.2"));
+    ASSERT_TRUE(lease);
+    EXPECT_TRUE(lease->stateExpiredReclaimed());
+    lease = lease_mgr.getLease4(IOAddress("10.0.0.3"));
+    ASSERT_TRUE(lease);
+    EXPECT_FALSE(lease->stateExpiredReclaimed());
+
+    // Remove the last three leases: the third fails.
+    Lease4Collection removed(leases.begin() + 2, leases.end());
+    EXPECT_EQ(2, engine.reclaimLeasesInDatabase(lease_mgr, removed,
+                                                Lease4Collection()));
+    EXPECT_TRUE(lease_mgr.getLease4(IOAddress("10.0.0.3")));
+    EXPECT_FALSE(lease_mgr.getLease4(IOAddress("10.0.0.4")));
+    EXPECT_FALSE(lease_mgr.getLease4(IOAddress("10.0.0.5")));
+}
+
+// This test verifies that the DHCPv6 leases of a batch which failed are
+// reclaimed one by one, except the lease which fails again.
+TEST(ReclaimLeasesInDatabaseTest, batchFailure6) {
+    DatabaseConnection::ParameterMap pmap;
+    pmap["universe"] = "6";
+    pmap["persist"] = "false";
+    FailingBatchLeaseMgr lease_mgr(pmap, IOAddress("2001:db8:1::3"));
+
+    Lease6Collection leases;
+    for (uint8_t i = 1; i <= 5; ++i) {
+        DuidPtr duid(new DUID(std::vector<uint8_t>(8, i)));
+        Lease6Ptr lease(new Lease6(Lease::TYPE_NA,
+                                   IOAddress("2001:db8:1::" + std::to_string(i)),
+                                   duid, 1, 50, 60, SubnetID(1)));
+        ASSERT_TRUE(lease_mgr.addLease(Lease6Ptr(new Lease6(*lease))));
+        leases.push_back(lease);
+    }
+
+    NakedAllocEngine engine(AllocEngine::ALLOC_ITERATIVE, 0);
+
+    // Update the first three leases: the third fails.
+    Lease6Collection updated(leases.begin(), leases.begin() + 3);
+    EXPECT_EQ(2, engine.reclaimLeasesInDatabase(lease_mgr, Lease6Collection(),
+                                                updated));
+    Lease6Ptr lease = lease_mgr.getLease6(Lease::TYPE_NA,
+                                          IOAddress("2001:db8:1::1"));
+    ASSERT_TRUE(lease);
+    EXPECT_TRUE(lease->stateExpiredReclaimed());
+    lease = lease_mgr.getLease6(Lease::TYPE_NA, IOAddress("2001:db8:1::2"));
+    ASSERT_TRUE(lease);
+    EXPECT_TRUE(lease->stateExpiredReclaimed());
+    lease = lease_mgr.getLease6(Lease::TYPE_NA, IOAddress("2001:db8:1::3"));
+    ASSERT_TRUE(lease);
+    EXPECT_FALSE(lease->stateExpiredReclaimed());
+
+    // Remove the last three leases: the third fails.
+    Lease6Collection removed(leases.begin() + 2, leases.end());
+    EXPECT_EQ(2, engine.reclaimLeasesInDatabase(lease_mgr, removed,
+                                                Lease6Collection()));
+    EXPECT_TRUE(lease_mgr.getLease6(Lease::TYPE_NA, IOAddress("2001:db8:1::3")));
+    EXPECT_FALSE(lease_mgr.getLease6(Lease::TYPE_NA, IOAddress("2001:db8:1::4")));
+    EXPECT_FALSE(lease_mgr.getLease6(Lease::TYPE_NA, IOAddress("2001:db8:1::5")));
+}
+
 }; // end of anonymous namespace
@@ -75,6 +75,7 @@ public:
     using AllocEngine::IterativeAllocator;
     using AllocEngine::getAllocator;
     using AllocEngine::updateLease4ExtendedInfo;
+    using AllocEngine::reclaimLeasesInDatabase;
 
     /// @brief IterativeAllocator with internal methods exposed
     class NakedIterativeAllocator: public AllocEngine::IterativeAllocator {
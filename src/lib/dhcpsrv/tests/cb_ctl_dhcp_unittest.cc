@@ -14,6 +14,7 @@
 #include <dhcpsrv/cfgmgr.h>
 #include <dhcpsrv/client_class_def.h>
 #include <dhcpsrv/host_mgr.h>
+#include <dhcpsrv/lease_mgr_factory.h>
 #include <dhcpsrv/testutils/memory_host_data_source.h>
 #include <dhcpsrv/testutils/generic_backend_unittest.h>
 #include <dhcpsrv/testutils/test_config_backend_dhcp4.h>
@@ -21,6 +22,7 @@
 #include <hooks/server_hooks.h>
 #include <hooks/callout_manager.h>
 #include <hooks/hooks_manager.h>
+#include <stats/stats_mgr.h>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/make_shared.hpp>
 #include <gtest/gtest.h>
@@ -35,6 +37,7 @@ using namespace isc::dhcp;
 using namespace isc::dhcp::test;
 using namespace isc::process;
 using namespace isc::hooks;
+using namespace isc::stats;
 
 namespace {
 
@@ -90,6 +93,7 @@ public:
     /// @brief Creates new CREATE audit entry.
     ///
     /// The audit entry is added to the @c audit_entries_ collection.
+    /// Its modification time is the timestamp of the object type.
     ///
     /// @param object_type Object type to be associated with the audit
     /// entry.
@@ -99,6 +103,7 @@ public:
                              const uint64_t object_id) {
         AuditEntryPtr entry(new AuditEntry(object_type, object_id,
                                            AuditEntry::ModificationType::CREATE,
+                                           getTimestamp(object_type),
                                            ++modification_id_,
                                            "some log message"));
         audit_entries_.insert(entry);
@@ -107,6 +112,7 @@ public:
     /// @brief Creates new DELETE audit entry.
     ///
     /// The audit entry is added to the @c audit_entries_ collection.
+    /// Its modification time is the timestamp of the object type.
     ///
     /// @param object_type Object type to be associated with the audit
     /// entry.
@@ -116,6 +122,7 @@ public:
                              const uint64_t object_id) {
         AuditEntryPtr entry(new AuditEntry(object_type, object_id,
                                            AuditEntry::ModificationType::DELETE,
+                                           getTimestamp(object_type),
                                            ++modification_id_,
                                            "some log message"));
         audit_entries_.insert(entry);
@@ -259,6 +266,9 @@ public:
 
     using CBControlDHCPv4::getInitialAuditRevisionTime;
     using CBControlDHCPv4::databaseConfigApply;
+    using CBControlDHCPv4::fetched_audit_entries_;
+    using CBControlDHCPv4::fetched_objects_;
+    using CBControlDHCPv4::recounted_subnets_;
 };
 
 /// @brief Test fixture class for @c CBControlDHCPv4 unit tests.
@@ -973,6 +983,84 @@ TEST_F(CBControlDHCPv4Test, databaseConfigApplyHook) {
     EXPECT_TRUE(audit_entries_ == *callback_audit_entries_);
 }
 
+// This test verifies that the statistics of the configuration update
+// polls are published.
+TEST_F(CBControlDHCPv4Test, databaseConfigFetchUpdateStatistics) {
+    StatsMgr::instance().removeAll();
+
+    // The statistics are not published when the whole configuration is
+    // fetched.
+    ASSERT_NO_THROW(ctl_.databaseConfigFetch(CfgMgr::instance().getCurrentCfg(),
+                                             CBControlDHCPv4::FetchModeType::FETCH_ALL));
+    EXPECT_FALSE(StatsMgr::instance().getObservation("cb-update-polls"));
+
+    // The test backend returns no audit entries so the polls fetch nothing.
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_NO_THROW(ctl_.databaseConfigFetch(CfgMgr::instance().getCurrentCfg(),
+                                                 CBControlDHCPv4::FetchModeType::FETCH_UPDATE));
+    }
+
+    ObservationPtr polls = StatsMgr::instance().getObservation("cb-update-polls");
+    ASSERT_TRUE(polls);
+    EXPECT_EQ(2, polls->getInteger().first);
+    ObservationPtr audit = StatsMgr::instance().getObservation("cb-update-audit-entries");
+    ASSERT_TRUE(audit);
+    EXPECT_EQ(0, audit->getInteger().first);
+    ObservationPtr fetched = StatsMgr::instance().getObservation("cb-update-fetched-objects");
+    ASSERT_TRUE(fetched);
+    EXPECT_EQ(0, fetched->getInteger().first);
+    ObservationPtr recounted = StatsMgr::instance().getObservation("cb-update-recounted-subnets");
+    ASSERT_TRUE(recounted);
+    EXPECT_EQ(0, recounted->getInteger().first);
+    EXPECT_TRUE(StatsMgr::instance().getObservation("cb-update-poll-time"));
+
+    StatsMgr::instance().removeAll();
+}
+
+// This test verifies that only the updated subnets are replaced and
+// recounted when the configuration updates are applied.
+TEST_F(CBControlDHCPv4Test, databaseConfigApplySubnetStatistics) {
+    LeaseMgrFactory::create("type=memfile universe=4 persist=false");
+
+    // Fetch the whole configuration and commit it.
+    remoteStoreTestConfiguration();
+    ASSERT_NO_THROW(ctl_.databaseConfigApply(BackendSelector::UNSPEC(), ServerSelector::ALL(),
+                                             ctl_.getInitialAuditRevisionTime(),
+                                             AuditEntryCollection()));
+    CfgMgr::instance().commit();
+
+    auto subnets = CfgMgr::instance().getCurrentCfg()->getCfgSubnets4();
+    ConstSubnet4Ptr subnet1 = subnets->getBySubnetId(SubnetID(1));
+    ASSERT_TRUE(subnet1);
+    ConstSubnet4Ptr subnet2 = subnets->getBySubnetId(SubnetID(2));
+    ASSERT_TRUE(subnet2);
+
+    // Update the second subnet in the database.
+    Subnet4Ptr subnet(new Subnet4(IOAddress("192.0.4.0"), 26, 1, 2, 3, SubnetID(2)));
+    subnet->setModificationTime(getTimestamp("dhcp4_subnet"));
+    ConfigBackendDHCPv4Mgr::instance().getPool()->createUpdateSubnet4(BackendSelector::UNSPEC(),
+                                                                      ServerSelector::ALL(),
+                                                                      subnet);
+    addCreateAuditEntry("dhcp4_subnet", 2);
+
+    // The counters are reset by the poll which is bypassed here.
+    ctl_.fetched_audit_entries_ = 0;
+    ctl_.fetched_objects_ = 0;
+    ctl_.recounted_subnets_ = 0;
+    ASSERT_NO_THROW(ctl_.databaseConfigApply(BackendSelector::UNSPEC(), ServerSelector::ALL(),
+                                             getTimestamp(-5), audit_entries_));
+
+    // Only the second subnet was replaced and recounted.
+    subnets = CfgMgr::instance().getCurrentCfg()->getCfgSubnets4();
+    EXPECT_TRUE(subnets->getBySubnetId(SubnetID(1)) == subnet1);
+    EXPECT_TRUE(subnets->getBySubnetId(SubnetID(2)) == subnet);
+    EXPECT_EQ(1, ctl_.fetched_audit_entries_);
+    EXPECT_EQ(2, ctl_.fetched_objects_);
+    EXPECT_EQ(1, ctl_.recounted_subnets_);
+
+    LeaseMgrFactory::destroy();
+}
+
 // This test verifies that it is possible to set ip-reservations-unique
 // parameter via configuration backend and that it is successful when
 // host database backend accepts the new setting.
@@ -1055,6 +1143,9 @@ public:
 
     using CBControlDHCPv6::getInitialAuditRevisionTime;
     using CBControlDHCPv6::databaseConfigApply;
+    using CBControlDHCPv6::fetched_audit_entries_;
+    using CBControlDHCPv6::fetched_objects_;
+    using CBControlDHCPv6::recounted_subnets_;
 };
 
 /// @brief Test fixture class for @c CBControlDHCPv6 unit tests.
@@ -1753,6 +1844,84 @@ TEST_F(CBControlDHCPv6Test, databaseConfigApplyHook) {
     EXPECT_TRUE(audit_entries_ == *callback_audit_entries_);
 }
 
+// This test verifies that the statistics of the configuration update
+// polls are published.
+TEST_F(CBControlDHCPv6Test, databaseConfigFetchUpdateStatistics) {
+    StatsMgr::instance().removeAll();
+
+    // The statistics are not published when the whole configuration is
+    // fetched.
+    ASSERT_NO_THROW(ctl_.databaseConfigFetch(CfgMgr::instance().getCurrentCfg(),
+                                             CBControlDHCPv6::FetchModeType::FETCH_ALL));
+    EXPECT_FALSE(StatsMgr::instance().getObservation("cb-update-polls"));
+
+    // The test backend returns no audit entries so the polls fetch nothing.
+    for (int i = 0; i < 2; ++i) {
+        ASSERT_NO_THROW(ctl_.databaseConfigFetch(CfgMgr::instance().getCurrentCfg(),
+                                                 CBControlDHCPv6::FetchModeType::FETCH_UPDATE));
+    }
+
+    ObservationPtr polls = StatsMgr::instance().getObservation("cb-update-polls");
+    ASSERT_TRUE(polls);
+    EXPECT_EQ(2, polls->getInteger().first);
+    ObservationPtr audit = StatsMgr::instance().getObservation("cb-update-audit-entries");
+    ASSERT_TRUE(audit);
+    EXPECT_EQ(0, audit->getInteger().first);
+    ObservationPtr fetched = StatsMgr::instance().getObservation("cb-update-fetched-objects");
+    ASSERT_TRUE(fetched);
+    EXPECT_EQ(0, fetched->getInteger().first);
+    ObservationPtr recounted = StatsMgr::instance().getObservation("cb-update-recounted-subnets");
+    ASSERT_TRUE(recounted);
+    EXPECT_EQ(0, recounted->getInteger().first);
+    EXPECT_TRUE(StatsMgr::instance().getObservation("cb-update-poll-time"));
+
+    StatsMgr::instance().removeAll();
+}
+
+// This test verifies that only the updated subnets are replaced and
+// recounted when the configuration updates are applied.
+TEST_F(CBControlDHCPv6Test, databaseConfigApplySubnetStatistics) {
+    LeaseMgrFactory::create("type=memfile universe=6 persist=false");
+
+    // Fetch the whole configuration and commit it.
+    remoteStoreTestConfiguration();
+    ASSERT_NO_THROW(ctl_.databaseConfigApply(BackendSelector::UNSPEC(), ServerSelector::ALL(),
+                                             ctl_.getInitialAuditRevisionTime(),
+                                             AuditEntryCollection()));
+    CfgMgr::instance().commit();
+
+    auto subnets = CfgMgr::instance().getCurrentCfg()->getCfgSubnets6();
+    ConstSubnet6Ptr subnet1 = subnets->getBySubnetId(SubnetID(1));
+    ASSERT_TRUE(subnet1);
+    ConstSubnet6Ptr subnet2 = subnets->getBySubnetId(SubnetID(2));
+    ASSERT_TRUE(subnet2);
+
+    // Update the second subnet in the database.
+    Subnet6Ptr subnet(new Subnet6(IOAddress("2001:db8:2::"), 64, 1, 2, 3, 4, SubnetID(2)));
+    subnet->setModificationTime(getTimestamp("dhcp6_subnet"));
+    ConfigBackendDHCPv6Mgr::instance().getPool()->createUpdateSubnet6(BackendSelector::UNSPEC(),
+                                                                      ServerSelector::ALL(),
+                                                                      subnet);
+    addCreateAuditEntry("dhcp6_subnet", 2);
+
+    // The counters are reset by the poll which is bypassed here.
+    ctl_.fetched_audit_entries_ = 0;
+    ctl_.fetched_objects_ = 0;
+    ctl_.recounted_subnets_ = 0;
+    ASSERT_NO_THROW(ctl_.databaseConfigApply(BackendSelector::UNSPEC(), ServerSelector::ALL(),
+                                             getTimestamp(-5), audit_entries_));
+
+    // Only the second subnet was replaced and recounted.
+    subnets = CfgMgr::instance().getCurrentCfg()->getCfgSubnets6();
+    EXPECT_TRUE(subnets->getBySubnetId(SubnetID(1)) == subnet1);
+    EXPECT_TRUE(subnets->getBySubnetId(SubnetID(2)) == subnet);
+    EXPECT_EQ(1, ctl_.fetched_audit_entries_);
+    EXPECT_EQ(2, ctl_.fetched_objects_);
+    EXPECT_EQ(1, ctl_.recounted_subnets_);
+
+    LeaseMgrFactory::destroy();
+}
+
 // This test verifies that it is possible to set ip-reservations-unique
 // parameter via configuration backend and that it is successful when
 // host database backend accepts the new setting.
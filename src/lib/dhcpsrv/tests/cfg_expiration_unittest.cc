@@ -112,6 +112,7 @@ TEST(CfgExpirationTest, defaults) {
               cfg.getMaxReclaimTime());
     EXPECT_EQ(CfgExpiration::DEFAULT_UNWARNED_RECLAIM_CYCLES,
               cfg.getUnwarnedReclaimCycles());
+    EXPECT_FALSE(cfg.getBackgroundReclamation());
 }
 
 /// @brief Tests that unparse returns an expected value
@@ -123,7 +124,8 @@ TEST(CfgExpirationTest, unparse) {
         "\"hold-reclaimed-time\": 3600,\n"
         "\"max-reclaim-leases\": 100,\n"
         "\"max-reclaim-time\": 250,\n"
-        "\"unwarned-reclaim-cycles\": 5 }";
+        "\"unwarned-reclaim-cycles\": 5,\n"
+        "\"background-reclamation\": false }";
     isc::test::runToElementTest<CfgExpiration>(defaults, cfg);
 }
 
@@ -169,6 +171,15 @@ TEST(CfgExpirationTest, getUnwarnedReclaimCycles) {
                            &CfgExpiration::getUnwarnedReclaimCycles);
 }
 
+// Test the {get,set}BackgroundReclamation.
+TEST(CfgExpirationTest, getBackgroundReclamation) {
+    CfgExpiration cfg;
+    cfg.setBackgroundReclamation(true);
+    EXPECT_TRUE(cfg.getBackgroundReclamation());
+    cfg.setBackgroundReclamation(false);
+    EXPECT_FALSE(cfg.getBackgroundReclamation());
+}
+
 /// @brief Implements test routines for leases reclamation.
 ///
 /// This class implements two routines called by the @c CfgExpiration object
@@ -335,10 +346,11 @@ public:
     /// for the specified amount of time.
     ///
     /// @param timeout_ms Timeout in milliseconds.
-    void setupAndRun(const long timeout_ms) {
+    /// @param reclaim_timer Whether the leases reclamation timer is set up.
+    void setupAndRun(const long timeout_ms, const bool reclaim_timer = true) {
         cfg_.setupTimers(&LeaseReclamationStub::reclaimExpiredLeases,
                          &LeaseReclamationStub::deleteReclaimedLeases,
-                         stub_.get());
+                         stub_.get(), reclaim_timer);
         // Run timers.
         ASSERT_NO_THROW({
             runTimersWithTimeout(timeout_ms);
@@ -430,4 +442,16 @@ TEST_F(CfgExpirationTimersTest, noLeaseReclamation) {
     EXPECT_EQ(0, stub_->delete_calls_count_);
 }
 
+// This test verifies that only the timer flushing expired-reclaimed leases
+// is set up when the leases are reclaimed by a background thread.
+TEST_F(CfgExpirationTimersTest, backgroundReclamation) {
+    // Run timers for 500ms.
+    ASSERT_NO_FATAL_FAILURE(setupAndRun(500, false));
+
+    // The leases' reclamation routine is run by the background thread.
+    EXPECT_EQ(0, stub_->reclaim_calls_count_);
+    // The routine flushing reclaimed leases is still run by the timer.
+    EXPECT_GT(stub_->delete_calls_count_, 1);
+}
+
 } // end of anonymous namespace
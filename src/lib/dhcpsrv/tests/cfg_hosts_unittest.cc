@@ -1,4 +1,4 @@
-// Copyright (C) 2014-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2014-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -539,6 +539,49 @@ TEST_F(CfgHostsTest, get4) {
     }
 }
 
+// This test checks that the lookups by identifier and subnet id only
+// return hosts with the same identifier, not hosts with an identifier
+// starting with the same bytes, and that the identifier type matters.
+TEST_F(CfgHostsTest, get4IdentifierPrefix) {
+    CfgHosts cfg;
+    cfg.add(HostPtr(new Host("01:02:03", "duid", SubnetID(1), SubnetID(2),
+                             IOAddress("192.0.2.5"))));
+    cfg.add(HostPtr(new Host("01:02:03:04", "duid", SubnetID(1), SubnetID(2),
+                             IOAddress("192.0.2.6"))));
+    cfg.add(HostPtr(new Host("01:02:03", "hw-address", SubnetID(1), SubnetID(2),
+                             IOAddress("192.0.2.7"))));
+
+    const std::vector<uint8_t> id = { 1, 2, 3, 4 };
+
+    HostPtr host = cfg.get4(SubnetID(1), Host::IDENT_DUID, &id[0], 3);
+    ASSERT_TRUE(host);
+    EXPECT_EQ("192.0.2.5", host->getIPv4Reservation().toText());
+
+    host = cfg.get4(SubnetID(1), Host::IDENT_DUID, &id[0], 4);
+    ASSERT_TRUE(host);
+    EXPECT_EQ("192.0.2.6", host->getIPv4Reservation().toText());
+
+    host = cfg.get4(SubnetID(1), Host::IDENT_HWADDR, &id[0], 3);
+    ASSERT_TRUE(host);
+    EXPECT_EQ("192.0.2.7", host->getIPv4Reservation().toText());
+
+    EXPECT_FALSE(cfg.get4(SubnetID(1), Host::IDENT_DUID, &id[0], 2));
+    EXPECT_FALSE(cfg.get4(SubnetID(1), Host::IDENT_HWADDR, &id[0], 4));
+    EXPECT_FALSE(cfg.get4(SubnetID(2), Host::IDENT_DUID, &id[0], 3));
+
+    // The same lookups in the IPv6 subnet.
+    host = cfg.get6(SubnetID(2), Host::IDENT_DUID, &id[0], 4);
+    ASSERT_TRUE(host);
+    EXPECT_EQ("192.0.2.6", host->getIPv4Reservation().toText());
+    EXPECT_FALSE(cfg.get6(SubnetID(1), Host::IDENT_DUID, &id[0], 4));
+
+    // Only the hosts with the exact identifier are returned by getAll.
+    EXPECT_EQ(1, cfg.getAll(Host::IDENT_DUID, &id[0], 3).size());
+    EXPECT_EQ(1, cfg.getAll(Host::IDENT_DUID, &id[0], 4).size());
+    EXPECT_EQ(1, cfg.getAll(Host::IDENT_HWADDR, &id[0], 3).size());
+    EXPECT_TRUE(cfg.getAll(Host::IDENT_HWADDR, &id[0], 2).empty());
+}
+
 // This test checks that the DHCPv4 reservations can be unparsed
 TEST_F(CfgHostsTest, unparsed4) {
     CfgMgr::instance().setFamily(AF_INET);
@@ -7,6 +7,7 @@
 #include <config.h>
 
 #include <cc/data.h>
+#include <dhcp/pkt_send_batcher.h>
 #include <dhcpsrv/cfg_multi_threading.h>
 #include <util/multi_threading_mgr.h>
 
@@ -92,6 +93,88 @@ TEST_F(CfgMultiThreadingTest, extract) {
     EXPECT_EQ(queue_size, 0);
 }
 
+/// @brief Verifies when the interface receiver threads are used
+TEST_F(CfgMultiThreadingTest, receiverThreads) {
+    ConstElementPtr enabled = Element::fromJSON("{ \"enable-multi-threading\": true,"
+                                                " \"receiver-threads\": true }");
+    ConstElementPtr disabled = Element::fromJSON("{ \"enable-multi-threading\": true,"
+                                                 " \"receiver-threads\": false }");
+    ConstElementPtr missing = Element::fromJSON("{ \"enable-multi-threading\": true }");
+    ConstElementPtr mt_disabled = Element::fromJSON("{ \"enable-multi-threading\": false,"
+                                                    " \"receiver-threads\": true }");
+
+    EXPECT_TRUE(CfgMultiThreading::receiverThreads(enabled));
+    EXPECT_FALSE(CfgMultiThreading::receiverThreads(disabled));
+    EXPECT_FALSE(CfgMultiThreading::receiverThreads(missing));
+    EXPECT_FALSE(CfgMultiThreading::receiverThreads(mt_disabled));
+    EXPECT_FALSE(CfgMultiThreading::receiverThreads(ConstElementPtr()));
+}
+
+/// @brief Verifies the number of sent packets of a batch
+TEST_F(CfgMultiThreadingTest, sendBatchSize) {
+    ConstElementPtr enabled = Element::fromJSON("{ \"enable-multi-threading\": true,"
+                                                " \"send-batch-size\": 32 }");
+    ConstElementPtr missing = Element::fromJSON("{ \"enable-multi-threading\": true }");
+    ConstElementPtr mt_disabled = Element::fromJSON("{ \"enable-multi-threading\": false,"
+                                                    " \"send-batch-size\": 32 }");
+
+    EXPECT_EQ(32, CfgMultiThreading::sendBatchSize(enabled));
+    EXPECT_EQ(0, CfgMultiThreading::sendBatchSize(missing));
+    EXPECT_EQ(0, CfgMultiThreading::sendBatchSize(mt_disabled));
+    EXPECT_EQ(0, CfgMultiThreading::sendBatchSize(ConstElementPtr()));
+}
+
+/// @brief Verifies the maximum delay of a sent packet in a batch
+TEST_F(CfgMultiThreadingTest, sendBatchDelay) {
+    ConstElementPtr enabled = Element::fromJSON("{ \"enable-multi-threading\": true,"
+                                                " \"send-batch-delay\": 200 }");
+    ConstElementPtr missing = Element::fromJSON("{ \"enable-multi-threading\": true }");
+    ConstElementPtr mt_disabled = Element::fromJSON("{ \"enable-multi-threading\": false,"
+                                                    " \"send-batch-delay\": 200 }");
+
+    EXPECT_EQ(200, CfgMultiThreading::sendBatchDelay(enabled));
+    EXPECT_EQ(PktSendBatcher::DEFAULT_MAX_DELAY,
+              CfgMultiThreading::sendBatchDelay(missing));
+    EXPECT_EQ(PktSendBatcher::DEFAULT_MAX_DELAY,
+              CfgMultiThreading::sendBatchDelay(mt_disabled));
+    EXPECT_EQ(PktSendBatcher::DEFAULT_MAX_DELAY,
+              CfgMultiThreading::sendBatchDelay(ConstElementPtr()));
+}
+
+/// @brief Verifies when the configuration is parsed by a background thread
+TEST_F(CfgMultiThreadingTest, backgroundConfigParsing) {
+    ConstElementPtr enabled = Element::fromJSON("{ \"enable-multi-threading\": true,"
+                                                " \"background-config-parsing\": true }");
+    ConstElementPtr disabled = Element::fromJSON("{ \"enable-multi-threading\": true,"
+                                                 " \"background-config-parsing\": false }");
+    ConstElementPtr missing = Element::fromJSON("{ \"enable-multi-threading\": true }");
+    ConstElementPtr mt_disabled = Element::fromJSON("{ \"enable-multi-threading\": false,"
+                                                    " \"background-config-parsing\": true }");
+
+    EXPECT_TRUE(CfgMultiThreading::backgroundConfigParsing(enabled));
+    EXPECT_FALSE(CfgMultiThreading::backgroundConfigParsing(disabled));
+    EXPECT_FALSE(CfgMultiThreading::backgroundConfigParsing(missing));
+    EXPECT_FALSE(CfgMultiThreading::backgroundConfigParsing(mt_disabled));
+    EXPECT_FALSE(CfgMultiThreading::backgroundConfigParsing(ConstElementPtr()));
+}
+
+/// @brief Verifies the number of threads processing the thread safe commands
+TEST_F(CfgMultiThreadingTest, commandThreads) {
+    ConstElementPtr enabled = Element::fromJSON("{ \"enable-multi-threading\": true,"
+                                                " \"command-threads\": 4 }");
+    ConstElementPtr disabled = Element::fromJSON("{ \"enable-multi-threading\": true,"
+                                                 " \"command-threads\": 0 }");
+    ConstElementPtr missing = Element::fromJSON("{ \"enable-multi-threading\": true }");
+    ConstElementPtr mt_disabled = Element::fromJSON("{ \"enable-multi-threading\": false,"
+                                                    " \"command-threads\": 4 }");
+
+    EXPECT_EQ(4, CfgMultiThreading::commandThreads(enabled));
+    EXPECT_EQ(0, CfgMultiThreading::commandThreads(disabled));
+    EXPECT_EQ(0, CfgMultiThreading::commandThreads(missing));
+    EXPECT_EQ(0, CfgMultiThreading::commandThreads(mt_disabled));
+    EXPECT_EQ(0, CfgMultiThreading::commandThreads(ConstElementPtr()));
+}
+
 /// @brief Verifies that applying multi threading settings works
 TEST_F(CfgMultiThreadingTest, apply) {
     EXPECT_FALSE(MultiThreadingMgr::instance().getMode());
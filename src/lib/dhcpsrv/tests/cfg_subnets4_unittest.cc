@@ -2003,6 +2003,80 @@ TEST(CfgSubnets4Test, removeStatistics) {
     ASSERT_FALSE(observation);
 }
 
+// This test verifies that the statistics of the subnets taken over by
+// the next configuration are kept and the others are recounted.
+TEST(CfgSubnets4Test, updateStatisticsTakenOver) {
+    CfgMgr::instance().clear();
+    LeaseMgrFactory::create("type=memfile universe=4 persist=false");
+    StatsMgr::instance().removeAll();
+
+    Subnet4Ptr subnet1(new Subnet4(IOAddress("192.0.2.0"), 26, 1, 2, 3, 1));
+    Subnet4Ptr subnet2(new Subnet4(IOAddress("192.0.3.0"), 26, 1, 2, 3, 2));
+    CfgSubnets4 previous;
+    ASSERT_NO_THROW(previous.add(subnet1));
+    ASSERT_NO_THROW(previous.add(subnet2));
+    previous.updateStatistics();
+
+    // Pretend some leases were assigned.
+    std::string assigned1 =
+        StatsMgr::generateName("subnet", 1, "assigned-addresses");
+    std::string assigned2 =
+        StatsMgr::generateName("subnet", 2, "assigned-addresses");
+    StatsMgr::instance().setValue(assigned1, static_cast<int64_t>(5));
+    StatsMgr::instance().setValue(assigned2, static_cast<int64_t>(7));
+
+    // The next configuration takes over the first subnet and replaces
+    // the second one.
+    Subnet4Ptr subnet2bis(new Subnet4(IOAddress("192.0.3.0"), 26, 1, 2, 3, 2));
+    CfgSubnets4 next;
+    ASSERT_NO_THROW(next.add(subnet1));
+    ASSERT_NO_THROW(next.add(subnet2bis));
+
+    previous.removeStatistics(next);
+    ObservationPtr observation =
+        StatsMgr::instance().getObservation(assigned1);
+    ASSERT_TRUE(observation);
+    EXPECT_EQ(5, observation->getInteger().first);
+    EXPECT_FALSE(StatsMgr::instance().getObservation(assigned2));
+
+    // Only the replaced subnet is recounted.
+    EXPECT_EQ(1, next.updateStatistics(previous));
+    observation = StatsMgr::instance().getObservation(assigned1);
+    ASSERT_TRUE(observation);
+    EXPECT_EQ(5, observation->getInteger().first);
+    observation = StatsMgr::instance().getObservation(assigned2);
+    ASSERT_TRUE(observation);
+    EXPECT_EQ(0, observation->getInteger().first);
+}
+
+// This test verifies that a subnet is taken over only when it is parsed
+// from an equal configuration element.
+TEST(CfgSubnets4Test, getUnchangedSubnet) {
+    Subnet4Ptr subnet(new Subnet4(IOAddress("192.0.2.0"), 26, 1, 2, 3, 1));
+    data::ConstElementPtr element =
+        data::Element::fromJSON("{ \"subnet\": \"192.0.2.0/26\", \"id\": 1 }");
+    CfgSubnets4 cfg;
+    ASSERT_NO_THROW(cfg.add(subnet));
+
+    // No element was recorded.
+    EXPECT_FALSE(cfg.getUnchangedSubnet(1, element));
+
+    cfg.setSubnetElement(subnet, element);
+    data::ConstElementPtr same =
+        data::Element::fromJSON("{ \"id\": 1, \"subnet\": \"192.0.2.0/26\" }");
+    EXPECT_EQ(subnet, cfg.getUnchangedSubnet(1, same));
+
+    data::ConstElementPtr changed =
+        data::Element::fromJSON("{ \"subnet\": \"192.0.2.0/24\", \"id\": 1 }");
+    EXPECT_FALSE(cfg.getUnchangedSubnet(1, changed));
+    EXPECT_FALSE(cfg.getUnchangedSubnet(2, same));
+
+    // Subnets of shared networks are not taken over.
+    SharedNetwork4Ptr network(new SharedNetwork4("frog"));
+    network->add(subnet);
+    EXPECT_FALSE(cfg.getUnchangedSubnet(1, same));
+}
+
 // This test verifies that in range host reservation works as expected.
 TEST(CfgSubnets4Test, host) {
     // Create a configuration.
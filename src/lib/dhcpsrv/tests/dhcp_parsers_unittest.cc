@@ -1,4 +1,4 @@
-// Copyright (C) 2012-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2012-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -3069,6 +3069,101 @@ TEST_F(ParseConfigTest, defaultSharedNetwork6) {
     EXPECT_FALSE(network->getDdnsUseConflictResolution().get());
 }
 
+// This test verifies that the subnets list parser takes over the unchanged
+// subnets of the current configuration and parses the changed ones.
+TEST_F(ParseConfigTest, reuseUnchangedSubnets4) {
+    std::string config =
+        "["
+        "    {"
+        "        \"subnet\": \"192.0.2.0/24\","
+        "        \"id\": 1,"
+        "        \"pools\": [ { \"pool\": \"192.0.2.10 - 192.0.2.100\" } ]"
+        "    },"
+        "    {"
+        "        \"subnet\": \"192.0.3.0/24\","
+        "        \"id\": 2"
+        "    },"
+        "    {"
+        "        \"subnet\": \"192.0.4.0/24\","
+        "        \"id\": 0"
+        "    }"
+        "]";
+    ElementPtr json;
+    ASSERT_NO_THROW(json = Element::fromJSON(config));
+
+    SrvConfigPtr current(new SrvConfig());
+    Subnets4ListConfigParser parser;
+    ASSERT_EQ(3, parser.parse(current, json));
+    EXPECT_EQ(0, parser.getReusedCount());
+
+    // Change the second subnet.
+    ElementPtr json2;
+    ASSERT_NO_THROW(json2 = Element::fromJSON(config));
+    json2->getNonConst(1)->set("valid-lifetime", Element::create(1000));
+
+    SrvConfigPtr next(new SrvConfig());
+    Subnets4ListConfigParser parser2;
+    parser2.setCurrentSubnets(current->getCfgSubnets4());
+    ASSERT_EQ(3, parser2.parse(next, json2));
+
+    // Only the first subnet is taken over: the second subnet changed and
+    // the last subnet has no explicit identifier (0 means auto-assigned).
+    EXPECT_EQ(1, parser2.getReusedCount());
+    EXPECT_EQ(current->getCfgSubnets4()->getBySubnetId(1),
+              next->getCfgSubnets4()->getBySubnetId(1));
+    ConstSubnet4Ptr subnet = next->getCfgSubnets4()->getBySubnetId(2);
+    ASSERT_TRUE(subnet);
+    EXPECT_NE(current->getCfgSubnets4()->getBySubnetId(2), subnet);
+    EXPECT_EQ(1000, subnet->getValid().get());
+
+    // The taken over subnet is taken over again by the next configuration.
+    SrvConfigPtr last(new SrvConfig());
+    Subnets4ListConfigParser parser3;
+    parser3.setCurrentSubnets(next->getCfgSubnets4());
+    ASSERT_EQ(3, parser3.parse(last, json2));
+    EXPECT_EQ(2, parser3.getReusedCount());
+    EXPECT_EQ(current->getCfgSubnets4()->getBySubnetId(1),
+              last->getCfgSubnets4()->getBySubnetId(1));
+}
+
+// This test verifies that the subnets list parser takes over the unchanged
+// IPv6 subnets of the current configuration and parses the changed ones.
+TEST_F(ParseConfigTest, reuseUnchangedSubnets6) {
+    std::string config =
+        "["
+        "    {"
+        "        \"subnet\": \"2001:db8:1::/64\","
+        "        \"id\": 1,"
+        "        \"pools\": [ { \"pool\": \"2001:db8:1::/80\" } ]"
+        "    },"
+        "    {"
+        "        \"subnet\": \"2001:db8:2::/64\","
+        "        \"id\": 2"
+        "    }"
+        "]";
+    ElementPtr json;
+    ASSERT_NO_THROW(json = Element::fromJSON(config));
+
+    SrvConfigPtr current(new SrvConfig());
+    Subnets6ListConfigParser parser;
+    ASSERT_EQ(2, parser.parse(current, json));
+
+    // Change the first subnet.
+    ElementPtr json2;
+    ASSERT_NO_THROW(json2 = Element::fromJSON(config));
+    json2->getNonConst(0)->set("preferred-lifetime", Element::create(1000));
+
+    SrvConfigPtr next(new SrvConfig());
+    Subnets6ListConfigParser parser2;
+    parser2.setCurrentSubnets(current->getCfgSubnets6());
+    ASSERT_EQ(2, parser2.parse(next, json2));
+    EXPECT_EQ(1, parser2.getReusedCount());
+    EXPECT_NE(current->getCfgSubnets6()->getBySubnetId(1),
+              next->getCfgSubnets6()->getBySubnetId(1));
+    EXPECT_EQ(current->getCfgSubnets6()->getBySubnetId(2),
+              next->getCfgSubnets6()->getBySubnetId(2));
+}
+
 // There's no test for ControlSocketParser, as it is tested in the DHCPv4 code
 // (see CtrlDhcpv4SrvTest.commandSocketBasic in
 // src/bin/dhcp4/tests/ctrl_dhcp4_srv_unittest.cc).
@@ -1,4 +1,4 @@
-// Copyright (C) 2015,2017 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2015-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -249,4 +249,24 @@ TEST_F(ExpirationConfigParserTest, notNumberValue) {
     EXPECT_THROW(parser.parse(config_element), DhcpConfigError);
 }
 
+// This test verifies that the background-reclamation parameter may be
+// configured and must be a boolean.
+TEST_F(ExpirationConfigParserTest, backgroundReclamation) {
+    CfgExpirationPtr cfg;
+    ASSERT_NO_THROW(cfg = renderConfig());
+    EXPECT_FALSE(cfg->getBackgroundReclamation());
+
+    std::string config = "{ \"background-reclamation\": true }";
+    ElementPtr config_element = Element::fromJSON(config);
+    ExpirationConfigParser parser;
+    ASSERT_NO_THROW(parser.parse(config_element));
+    cfg = CfgMgr::instance().getStagingCfg()->getCfgExpiration();
+    EXPECT_TRUE(cfg->getBackgroundReclamation());
+
+    // The value must be a boolean.
+    config = "{ \"background-reclamation\": 1 }";
+    config_element = Element::fromJSON(config);
+    EXPECT_THROW(parser.parse(config_element), DhcpConfigError);
+}
+
 } // end of anonymous namespace
@@ -1364,6 +1364,73 @@ GenericLeaseMgrTest::testGetLeases4Paged() {
                  InvalidAddressFamily);
 }
 
+void
+GenericLeaseMgrTest::testWalkLeases4() {
+    // Get the leases to be used for the test and add to the database.
+    vector<Lease4Ptr> leases = createLeases4();
+    for (size_t i = 0; i < leases.size(); ++i) {
+        EXPECT_TRUE(lmptr_->addLease(leases[i]));
+    }
+
+    std::vector<std::string> expected;
+    std::vector<std::string> walked;
+    auto collect = [&walked](const Lease4& lease) {
+        walked.push_back(lease.addr_.toText());
+    };
+
+    // All leases should be walked in the order they are returned.
+    for (auto const& lease : lmptr_->getLeases4()) {
+        expected.push_back(lease->addr_.toText());
+    }
+    lmptr_->walkLeases4(collect);
+    EXPECT_EQ(leases.size(), walked.size());
+    EXPECT_TRUE(expected == walked);
+
+    // Same for the leases of a subnet.
+    expected.clear();
+    walked.clear();
+    for (auto const& lease : lmptr_->getLeases4(leases[1]->subnet_id_)) {
+        expected.push_back(lease->addr_.toText());
+    }
+    lmptr_->walkLeases4(leases[1]->subnet_id_, collect);
+    EXPECT_EQ(2, walked.size());
+    EXPECT_TRUE(expected == walked);
+
+    // And for the pages.
+    IOAddress last_address = IOAddress("0.0.0.0");
+    size_t total = 0;
+    for (auto i = 0; i < 4; ++i) {
+        expected.clear();
+        walked.clear();
+        Lease4Collection page = lmptr_->getLeases4(last_address, LeasePageSize(3));
+        for (auto const& lease : page) {
+            expected.push_back(lease->addr_.toText());
+        }
+        lmptr_->walkLeases4(last_address, LeasePageSize(3), collect);
+        EXPECT_TRUE(expected == walked);
+        if (page.empty()) {
+            break;
+        }
+        total += page.size();
+        last_address = page[page.size() - 1]->addr_;
+    }
+    EXPECT_EQ(leases.size(), total);
+
+    // Only IPv4 address can be used.
+    EXPECT_THROW(lmptr_->walkLeases4(IOAddress("2001:db8::1"), LeasePageSize(3), collect),
+                 InvalidAddressFamily);
+
+    // An exception thrown by the callback stops the walk and the lease
+    // manager remains usable.
+    walked.clear();
+    EXPECT_THROW(lmptr_->walkLeases4([&walked](const Lease4& lease) {
+                     walked.push_back(lease.addr_.toText());
+                     isc_throw(Unexpected, "stop");
+                 }), Unexpected);
+    EXPECT_EQ(1, walked.size());
+    EXPECT_EQ(leases.size(), lmptr_->getLeases4().size());
+}
+
 void
 GenericLeaseMgrTest::testGetLeases6SubnetId() {
     // Get the leases to be used for the test and add to the database.
@@ -1472,6 +1539,73 @@ GenericLeaseMgrTest::testGetLeases6Paged() {
                  InvalidAddressFamily);
 }
 
+void
+GenericLeaseMgrTest::testWalkLeases6() {
+    // Get the leases to be used for the test and add to the database.
+    vector<Lease6Ptr> leases = createLeases6();
+    for (size_t i = 0; i < leases.size(); ++i) {
+        EXPECT_TRUE(lmptr_->addLease(leases[i]));
+    }
+
+    std::vector<std::string> expected;
+    std::vector<std::string> walked;
+    auto collect = [&walked](const Lease6& lease) {
+        walked.push_back(lease.addr_.toText());
+    };
+
+    // All leases should be walked in the order they are returned.
+    for (auto const& lease : lmptr_->getLeases6()) {
+        expected.push_back(lease->addr_.toText());
+    }
+    lmptr_->walkLeases6(collect);
+    EXPECT_EQ(leases.size(), walked.size());
+    EXPECT_TRUE(expected == walked);
+
+    // Same for the leases of a subnet.
+    expected.clear();
+    walked.clear();
+    for (auto const& lease : lmptr_->getLeases6(leases[1]->subnet_id_)) {
+        expected.push_back(lease->addr_.toText());
+    }
+    lmptr_->walkLeases6(leases[1]->subnet_id_, collect);
+    EXPECT_EQ(2, walked.size());
+    EXPECT_TRUE(expected == walked);
+
+    // And for the pages.
+    IOAddress last_address = IOAddress::IPV6_ZERO_ADDRESS();
+    size_t total = 0;
+    for (auto i = 0; i < 4; ++i) {
+        expected.clear();
+        walked.clear();
+        Lease6Collection page = lmptr_->getLeases6(last_address, LeasePageSize(3));
+        for (auto const& lease : page) {
+            expected.push_back(lease->addr_.toText());
+        }
+        lmptr_->walkLeases6(last_address, LeasePageSize(3), collect);
+        EXPECT_TRUE(expected == walked);
+        if (page.empty()) {
+            break;
+        }
+        total += page.size();
+        last_address = page[page.size() - 1]->addr_;
+    }
+    EXPECT_EQ(leases.size(), total);
+
+    // Only IPv6 address can be used.
+    EXPECT_THROW(lmptr_->walkLeases6(IOAddress("192.0.2.0"), LeasePageSize(3), collect),
+                 InvalidAddressFamily);
+
+    // An exception thrown by the callback stops the walk and the lease
+    // manager remains usable.
+    walked.clear();
+    EXPECT_THROW(lmptr_->walkLeases6([&walked](const Lease6& lease) {
+                     walked.push_back(lease.addr_.toText());
+                     isc_throw(Unexpected, "stop");
+                 }), Unexpected);
+    EXPECT_EQ(1, walked.size());
+    EXPECT_EQ(leases.size(), lmptr_->getLeases6().size());
+}
+
 void
 GenericLeaseMgrTest::testGetLeases6DuidIaid() {
     // Get the leases to be used for the test.
@@ -1975,6 +2109,116 @@ GenericLeaseMgrTest::testConcurrentUpdateLease6() {
     EXPECT_THROW(lmptr_->updateLease6(initialLease), isc::dhcp::NoSuchLease);
 }
 
+void
+GenericLeaseMgrTest::testBatchLeases4() {
+    // Get the leases to be used for the test.
+    vector<Lease4Ptr> leases = createLeases4();
+    ASSERT_LE(5, leases.size());    // Expect to access leases 0 through 4
+
+    // Add leases 0 to 2 at once.
+    Lease4Collection failed;
+    ASSERT_NO_THROW(failed = lmptr_->addLeases({ leases[0], leases[1], leases[2] }));
+    EXPECT_TRUE(failed.empty());
+    for (size_t i = 0; i < 3; ++i) {
+        Lease4Ptr l_returned = lmptr_->getLease4(ioaddress4_[i]);
+        ASSERT_TRUE(l_returned);
+        detailCompareLease(leases[i], l_returned);
+    }
+
+    // Lease 2 already exists so only lease 3 should be added.
+    ASSERT_NO_THROW(failed = lmptr_->addLeases({ leases[2], leases[3] }));
+    ASSERT_EQ(1, failed.size());
+    EXPECT_TRUE(failed[0] == leases[2]);
+    EXPECT_TRUE(lmptr_->getLease4(ioaddress4_[3]));
+
+    // Modify leases 1 and 3 and update them along with lease 4 which is
+    // not in the database.
+    leases[1]->valid_lft_ *= 2;
+    leases[1]->hostname_ = "modified.hostname.";
+    leases[3]->cltt_ += 6;
+    leases[3]->setContext(Element::fromJSON("{ \"foobar\": 1234 }"));
+    ASSERT_NO_THROW(failed = lmptr_->updateLeases({ leases[1], leases[3], leases[4] }));
+    ASSERT_EQ(1, failed.size());
+    EXPECT_TRUE(failed[0] == leases[4]);
+    EXPECT_FALSE(lmptr_->getLease4(ioaddress4_[4]));
+
+    Lease4Ptr l_returned = lmptr_->getLease4(ioaddress4_[1]);
+    ASSERT_TRUE(l_returned);
+    detailCompareLease(leases[1], l_returned);
+    l_returned = lmptr_->getLease4(ioaddress4_[3]);
+    ASSERT_TRUE(l_returned);
+    detailCompareLease(leases[3], l_returned);
+
+    // The updated leases can be deleted. Lease 4 is not there.
+    ASSERT_NO_THROW(failed = lmptr_->deleteLeases({ leases[0], leases[1], leases[4] }));
+    ASSERT_EQ(1, failed.size());
+    EXPECT_TRUE(failed[0] == leases[4]);
+    EXPECT_FALSE(lmptr_->getLease4(ioaddress4_[0]));
+    EXPECT_FALSE(lmptr_->getLease4(ioaddress4_[1]));
+    EXPECT_TRUE(lmptr_->getLease4(ioaddress4_[2]));
+    EXPECT_TRUE(lmptr_->getLease4(ioaddress4_[3]));
+
+    // Empty collections are accepted.
+    EXPECT_TRUE(lmptr_->addLeases(Lease4Collection()).empty());
+    EXPECT_TRUE(lmptr_->updateLeases(Lease4Collection()).empty());
+    EXPECT_TRUE(lmptr_->deleteLeases(Lease4Collection()).empty());
+}
+
+void
+GenericLeaseMgrTest::testBatchLeases6() {
+    // Get the leases to be used for the test.
+    vector<Lease6Ptr> leases = createLeases6();
+    ASSERT_LE(5, leases.size());    // Expect to access leases 0 through 4
+
+    // Add leases 0 to 2 at once.
+    Lease6Collection failed;
+    ASSERT_NO_THROW(failed = lmptr_->addLeases({ leases[0], leases[1], leases[2] }));
+    EXPECT_TRUE(failed.empty());
+    for (size_t i = 0; i < 3; ++i) {
+        Lease6Ptr l_returned = lmptr_->getLease6(leasetype6_[i], ioaddress6_[i]);
+        ASSERT_TRUE(l_returned);
+        detailCompareLease(leases[i], l_returned);
+    }
+
+    // Lease 2 already exists so only lease 3 should be added.
+    ASSERT_NO_THROW(failed = lmptr_->addLeases({ leases[2], leases[3] }));
+    ASSERT_EQ(1, failed.size());
+    EXPECT_TRUE(failed[0] == leases[2]);
+    EXPECT_TRUE(lmptr_->getLease6(leasetype6_[3], ioaddress6_[3]));
+
+    // Modify leases 1 and 3 and update them along with lease 4 which is
+    // not in the database.
+    leases[1]->valid_lft_ *= 2;
+    leases[1]->hostname_ = "modified.hostname.v6.";
+    leases[3]->cltt_ += 6;
+    leases[3]->setContext(Element::fromJSON("{ \"foobar\": 1234 }"));
+    ASSERT_NO_THROW(failed = lmptr_->updateLeases({ leases[1], leases[3], leases[4] }));
+    ASSERT_EQ(1, failed.size());
+    EXPECT_TRUE(failed[0] == leases[4]);
+    EXPECT_FALSE(lmptr_->getLease6(leasetype6_[4], ioaddress6_[4]));
+
+    Lease6Ptr l_returned = lmptr_->getLease6(leasetype6_[1], ioaddress6_[1]);
+    ASSERT_TRUE(l_returned);
+    detailCompareLease(leases[1], l_returned);
+    l_returned = lmptr_->getLease6(leasetype6_[3], ioaddress6_[3]);
+    ASSERT_TRUE(l_returned);
+    detailCompareLease(leases[3], l_returned);
+
+    // The updated leases can be deleted. Lease 4 is not there.
+    ASSERT_NO_THROW(failed = lmptr_->deleteLeases({ leases[0], leases[1], leases[4] }));
+    ASSERT_EQ(1, failed.size());
+    EXPECT_TRUE(failed[0] == leases[4]);
+    EXPECT_FALSE(lmptr_->getLease6(leasetype6_[0], ioaddress6_[0]));
+    EXPECT_FALSE(lmptr_->getLease6(leasetype6_[1], ioaddress6_[1]));
+    EXPECT_TRUE(lmptr_->getLease6(leasetype6_[2], ioaddress6_[2]));
+    EXPECT_TRUE(lmptr_->getLease6(leasetype6_[3], ioaddress6_[3]));
+
+    // Empty collections are accepted.
+    EXPECT_TRUE(lmptr_->addLeases(Lease6Collection()).empty());
+    EXPECT_TRUE(lmptr_->updateLeases(Lease6Collection()).empty());
+    EXPECT_TRUE(lmptr_->deleteLeases(Lease6Collection()).empty());
+}
+
 void
 GenericLeaseMgrTest::testRecreateLease4() {
     // Create a lease.
@@ -221,6 +221,9 @@ public:
     /// @brief Test method which returns range of IPv4 leases with paging.
     void testGetLeases4Paged();
 
+    /// @brief Test method which passes IPv4 leases to a callback.
+    void testWalkLeases4();
+
     /// @brief Test method which returns all IPv6 leases for Subnet ID.
     void testGetLeases6SubnetId();
 
@@ -236,6 +239,9 @@ public:
     /// @brief Test method which returns range of IPv6 leases with paging.
     void testGetLeases6Paged();
 
+    /// @brief Test method which passes IPv6 leases to a callback.
+    void testWalkLeases6();
+
     /// @brief Basic Lease4 Checks
     ///
     /// Checks that the addLease, getLease4(by address), getLease4(hwaddr,subnet_id),
@@ -339,6 +345,20 @@ public:
     /// the database.
     void testConcurrentUpdateLease6();
 
+    /// @brief Lease4 batch operations test
+    ///
+    /// Checks that the code is able to add, update and delete a collection
+    /// of IPv4 leases and that it returns the leases for which the operation
+    /// could not be performed.
+    void testBatchLeases4();
+
+    /// @brief Lease6 batch operations test
+    ///
+    /// Checks that the code is able to add, update and delete a collection
+    /// of IPv6 leases and that it returns the leases for which the operation
+    /// could not be performed.
+    void testBatchLeases6();
+
     /// @brief Check that the IPv6 lease can be added, removed and recreated.
     ///
     /// This test creates a lease, removes it and then recreates it with some
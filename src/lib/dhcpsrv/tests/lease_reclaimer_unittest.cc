@@ -0,0 +1,195 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+#include <asiolink/io_address.h>
+#include <dhcpsrv/alloc_engine.h>
+#include <dhcpsrv/cfg_expiration.h>
+#include <dhcpsrv/cfgmgr.h>
+#include <dhcpsrv/lease_mgr_factory.h>
+#include <dhcpsrv/lease_reclaimer.h>
+#include <exceptions/exceptions.h>
+#include <stats/stats_mgr.h>
+#include <util/multi_threading_mgr.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <sys/socket.h>
+
+using namespace isc;
+using namespace isc::asiolink;
+using namespace isc::dhcp;
+using namespace isc::stats;
+using namespace isc::util;
+
+namespace {
+
+/// @brief Number of leases used by the tests.
+const unsigned int TEST_LEASES_NUM = 50;
+
+/// @brief Test fixture class for @c LeaseReclaimer.
+///
+/// Creates a memfile lease database with @c TEST_LEASES_NUM expired
+/// leases and an allocation engine.
+class LeaseReclaimerTest : public ::testing::Test {
+public:
+    /// @brief Constructor.
+    LeaseReclaimerTest() : cfg_(true) {
+        MultiThreadingMgr::instance().setMode(true);
+        CfgMgr::instance().clear();
+        StatsMgr::instance().resetAll();
+        LeaseMgrFactory::create("type=memfile universe=4 persist=false");
+        engine_.reset(new AllocEngine(AllocEngine::ALLOC_ITERATIVE, 100,
+                                      false));
+        for (unsigned int i = 0; i < TEST_LEASES_NUM; ++i) {
+            IOAddress address(IOAddress("10.0.0.1").toUint32() + i);
+            uint8_t hwaddr_data[] = { 0, 0, 0, 0, 0, static_cast<uint8_t>(i) };
+            HWAddrPtr hwaddr(new HWAddr(hwaddr_data, sizeof(hwaddr_data),
+                                        HTYPE_ETHER));
+            Lease4Ptr lease(new Lease4(address, hwaddr, 0, 0, 60,
+                                       time(0) - 100 - i, 1));
+            LeaseMgrFactory::instance().addLease(lease);
+        }
+        // Reclaim the leases in passes of 10 leases.
+        cfg_.setMaxReclaimLeases(10);
+        // Wait 10ms (test mode) when there is nothing to reclaim.
+        cfg_.setReclaimTimerWaitTime(10);
+    }
+
+    /// @brief Destructor.
+    ~LeaseReclaimerTest() {
+        reclaimer_.reset();
+        engine_.reset();
+        LeaseMgrFactory::destroy();
+        StatsMgr::instance().resetAll();
+        CfgMgr::instance().clear();
+        MultiThreadingMgr::instance().setMode(false);
+    }
+
+    /// @brief Returns the number of reclaimed leases.
+    size_t countReclaimed() const {
+        size_t count = 0;
+        Lease4Collection leases = LeaseMgrFactory::instance().getLeases4();
+        for (auto const& lease : leases) {
+            if (lease->stateExpiredReclaimed()) {
+                ++count;
+            }
+        }
+        return (count);
+    }
+
+    /// @brief Waits until all leases are reclaimed.
+    ///
+    /// @return true if all the leases were reclaimed within 5 seconds.
+    bool waitReclaimed() const {
+        for (unsigned int i = 0; i < 500; ++i) {
+            if (countReclaimed() == TEST_LEASES_NUM) {
+                return (true);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return (false);
+    }
+
+    /// @brief Expiration configuration.
+    CfgExpiration cfg_;
+
+    /// @brief Allocation engine.
+    AllocEnginePtr engine_;
+
+    /// @brief Leases reclaimer.
+    LeaseReclaimerPtr reclaimer_;
+};
+
+// Verifies that the constructor checks its parameters.
+TEST_F(LeaseReclaimerTest, constructor) {
+    EXPECT_THROW(LeaseReclaimer(AllocEnginePtr(), AF_INET, true), BadValue);
+    EXPECT_THROW(LeaseReclaimer(engine_, AF_UNIX, true), BadValue);
+    EXPECT_NO_THROW(reclaimer_.reset(new LeaseReclaimer(engine_, AF_INET, true)));
+    EXPECT_FALSE(reclaimer_->isEnabled());
+    EXPECT_FALSE(reclaimer_->isRunning());
+}
+
+// Verifies that the thread is not started when the background reclamation
+// is disabled.
+TEST_F(LeaseReclaimerTest, disabled) {
+    reclaimer_.reset(new LeaseReclaimer(engine_, AF_INET, true));
+    reclaimer_->configure(false, cfg_);
+    EXPECT_FALSE(reclaimer_->isEnabled());
+    EXPECT_FALSE(engine_->getBackgroundReclamation());
+    reclaimer_->start();
+    EXPECT_FALSE(reclaimer_->isRunning());
+
+    // A reclaim-timer-wait-time of 0 disables the reclamation.
+    cfg_.setReclaimTimerWaitTime(0);
+    reclaimer_->configure(true, cfg_);
+    EXPECT_FALSE(reclaimer_->isEnabled());
+    reclaimer_->start();
+    EXPECT_FALSE(reclaimer_->isRunning());
+    EXPECT_EQ(0, countReclaimed());
+}
+
+// Verifies that the expired leases are reclaimed by the thread and the
+// statistics are set.
+TEST_F(LeaseReclaimerTest, reclaim) {
+    // Wait 10s (test mode) after the backlog is drained so the statistics
+    // set by the last pass are kept.
+    cfg_.setReclaimTimerWaitTime(10000);
+    reclaimer_.reset(new LeaseReclaimer(engine_, AF_INET, true));
+    reclaimer_->configure(true, cfg_);
+    EXPECT_TRUE(reclaimer_->isEnabled());
+    EXPECT_TRUE(engine_->getBackgroundReclamation());
+    reclaimer_->start();
+    EXPECT_TRUE(reclaimer_->isRunning());
+
+    EXPECT_TRUE(waitReclaimed());
+
+    // The last pass found no expired lease and drained the backlog. The
+    // backlog accumulates the passes so it is not bounded by the 10 leases
+    // of a pass.
+    ObservationPtr backlog;
+    ObservationPtr age;
+    for (unsigned int i = 0; i < 500; ++i) {
+        backlog = StatsMgr::instance().getObservation("reclaim-backlog");
+        age = StatsMgr::instance().getObservation("reclaim-backlog-age");
+        if (backlog && age &&
+            (backlog->getInteger().first == TEST_LEASES_NUM) &&
+            (age->getInteger().first == 0)) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    reclaimer_->stop();
+    EXPECT_FALSE(reclaimer_->isRunning());
+
+    ASSERT_TRUE(backlog);
+    EXPECT_EQ(TEST_LEASES_NUM, backlog->getInteger().first);
+    ASSERT_TRUE(age);
+    EXPECT_EQ(0, age->getInteger().first);
+
+    // The destructor resets the background reclamation flag.
+    reclaimer_.reset();
+    EXPECT_FALSE(engine_->getBackgroundReclamation());
+}
+
+// Verifies that the thread is stopped during a critical section.
+TEST_F(LeaseReclaimerTest, criticalSection) {
+    reclaimer_.reset(new LeaseReclaimer(engine_, AF_INET, true));
+    reclaimer_->configure(true, cfg_);
+    reclaimer_->start();
+    EXPECT_TRUE(reclaimer_->isRunning());
+    {
+        MultiThreadingCriticalSection cs;
+        EXPECT_FALSE(reclaimer_->isRunning());
+    }
+    EXPECT_TRUE(reclaimer_->isRunning());
+    EXPECT_TRUE(waitReclaimed());
+}
+
+} // end of anonymous namespace
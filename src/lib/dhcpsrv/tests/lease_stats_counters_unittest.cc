@@ -0,0 +1,157 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+#include <asiolink/io_address.h>
+#include <dhcpsrv/lease.h>
+#include <dhcpsrv/lease_stats_counters.h>
+
+#include <gtest/gtest.h>
+
+using namespace isc;
+using namespace isc::asiolink;
+using namespace isc::dhcp;
+
+namespace {
+
+/// @brief Creates an IPv4 lease.
+///
+/// @param address Address of the lease.
+/// @param subnet_id Subnet of the lease.
+/// @param state State of the lease.
+Lease4 createLease4(const std::string& address, const SubnetID& subnet_id,
+                    const uint32_t state = Lease::STATE_DEFAULT) {
+    Lease4 lease;
+    lease.addr_ = IOAddress(address);
+    lease.subnet_id_ = subnet_id;
+    lease.state_ = state;
+    return (lease);
+}
+
+/// @brief Counts the leases of a range: used when no lease is expected.
+void countNothing(const Lease::Type, const IOAddress&, const IOAddress&,
+                  LeaseStatsCounters::StateCounts&) {
+    ADD_FAILURE() << "unexpected count of a known range";
+}
+
+// Verifies that the subnet counters follow the lease changes.
+TEST(LeaseStatsCountersTest, subnets) {
+    LeaseStatsCounters counters;
+    Lease4 lease1 = createLease4("192.0.2.1", 1);
+    Lease4 lease2 = createLease4("192.0.2.2", 1);
+    Lease4 lease3 = createLease4("192.0.3.1", 2, Lease::STATE_DECLINED);
+    counters.addLease(lease1, Lease::TYPE_V4);
+    counters.addLease(lease2, Lease::TYPE_V4);
+    counters.addLease(lease3, Lease::TYPE_V4);
+
+    std::vector<LeaseStatsRow> rows;
+    counters.getSubnetRows(1, 10, rows);
+    ASSERT_EQ(2, rows.size());
+    EXPECT_EQ(1, rows[0].subnet_id_);
+    EXPECT_EQ(Lease::STATE_DEFAULT, rows[0].lease_state_);
+    EXPECT_EQ(2, rows[0].state_count_);
+    EXPECT_EQ(2, rows[1].subnet_id_);
+    EXPECT_EQ(Lease::STATE_DECLINED, rows[1].lease_state_);
+    EXPECT_EQ(1, rows[1].state_count_);
+
+    // Decline a lease of the subnet 1.
+    Lease4 declined = lease2;
+    declined.state_ = Lease::STATE_DECLINED;
+    counters.updateLease(lease2, declined, Lease::TYPE_V4);
+    // Delete the lease of the subnet 2.
+    counters.deleteLease(lease3, Lease::TYPE_V4);
+
+    rows.clear();
+    counters.getSubnetRows(1, 10, rows);
+    ASSERT_EQ(2, rows.size());
+    EXPECT_EQ(1, rows[0].subnet_id_);
+    EXPECT_EQ(Lease::STATE_DEFAULT, rows[0].lease_state_);
+    EXPECT_EQ(1, rows[0].state_count_);
+    EXPECT_EQ(1, rows[1].subnet_id_);
+    EXPECT_EQ(Lease::STATE_DECLINED, rows[1].lease_state_);
+    EXPECT_EQ(1, rows[1].state_count_);
+
+    // Only the requested subnets are returned.
+    rows.clear();
+    counters.getSubnetRows(2, 10, rows);
+    EXPECT_TRUE(rows.empty());
+
+    counters.clear();
+    rows.clear();
+    counters.getSubnetRows(1, 10, rows);
+    EXPECT_TRUE(rows.empty());
+}
+
+// Verifies that the pool counters follow the lease changes and that only
+// the new pools are counted.
+TEST(LeaseStatsCountersTest, pools) {
+    LeaseStatsCounters counters;
+    Lease4 lease1 = createLease4("192.0.2.10", 1);
+    Lease4 lease2 = createLease4("192.0.2.200", 1);
+    counters.addLease(lease1, Lease::TYPE_V4);
+    counters.addLease(lease2, Lease::TYPE_V4);
+
+    LeaseStatsPoolCollection pools;
+    pools.push_back(LeaseStatsPool(1, 0, Lease::TYPE_V4, IOAddress("192.0.2.1"),
+                                   IOAddress("192.0.2.99")));
+    pools.push_back(LeaseStatsPool(1, 1, Lease::TYPE_V4, IOAddress("192.0.2.100"),
+                                   IOAddress("192.0.2.199")));
+    size_t counted = 0;
+    counters.setPools(pools,
+        [&counted](const Lease::Type, const IOAddress& first, const IOAddress&,
+                   LeaseStatsCounters::StateCounts& counts) {
+            ++counted;
+            // Only lease1 is in the pools.
+            if (first == IOAddress("192.0.2.1")) {
+                ++counts[Lease::STATE_DEFAULT];
+            }
+        });
+    EXPECT_EQ(2, counted);
+
+    // Add a lease in each pool and one out of the pools.
+    counters.addLease(createLease4("192.0.2.11", 1), Lease::TYPE_V4);
+    counters.addLease(createLease4("192.0.2.150", 1), Lease::TYPE_V4);
+    counters.addLease(createLease4("192.0.2.250", 1), Lease::TYPE_V4);
+    // Leases of other types are not in the pools.
+    counters.addLease(createLease4("192.0.2.12", 1), Lease::TYPE_NA);
+
+    std::vector<LeaseStatsRow> rows;
+    counters.getPoolRows(rows);
+    ASSERT_EQ(2, rows.size());
+    EXPECT_EQ(1, rows[0].subnet_id_);
+    EXPECT_EQ(0, rows[0].pool_id_);
+    EXPECT_EQ(2, rows[0].state_count_);
+    EXPECT_EQ(1, rows[1].subnet_id_);
+    EXPECT_EQ(1, rows[1].pool_id_);
+    EXPECT_EQ(1, rows[1].state_count_);
+
+    // Setting the same pools does not count the leases again.
+    counters.setPools(pools, countNothing);
+    rows.clear();
+    counters.getPoolRows(rows);
+    ASSERT_EQ(2, rows.size());
+    EXPECT_EQ(2, rows[0].state_count_);
+    EXPECT_EQ(1, rows[1].state_count_);
+
+    // Removed pools are forgotten.
+    pools.pop_back();
+    counters.setPools(pools, countNothing);
+    rows.clear();
+    counters.getPoolRows(rows);
+    ASSERT_EQ(1, rows.size());
+    EXPECT_EQ(0, rows[0].pool_id_);
+
+    // Subnet counters are not affected by the pools.
+    rows.clear();
+    counters.getSubnetRows(1, 1, rows);
+    ASSERT_EQ(2, rows.size());
+    EXPECT_EQ(Lease::TYPE_NA, rows[0].lease_type_);
+    EXPECT_EQ(1, rows[0].state_count_);
+    EXPECT_EQ(Lease::TYPE_V4, rows[1].lease_type_);
+    EXPECT_EQ(5, rows[1].state_count_);
+}
+
+} // end of anonymous namespace
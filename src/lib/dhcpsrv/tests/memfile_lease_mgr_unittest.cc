@@ -1052,6 +1052,19 @@ TEST_F(MemfileLeaseMgrTest, getLeases4PagedMultiThread) {
     testGetLeases4Paged();
 }
 
+/// @brief Test that IPv4 leases are passed to a callback.
+TEST_F(MemfileLeaseMgrTest, walkLeases4) {
+    startBackend(V4);
+    testWalkLeases4();
+}
+
+/// @brief Test that IPv4 leases are passed to a callback.
+TEST_F(MemfileLeaseMgrTest, walkLeases4MultiThread) {
+    startBackend(V4);
+    MultiThreadingMgr::instance().setMode(true);
+    testWalkLeases4();
+}
+
 /// @brief This test checks that all IPv6 leases for a specified subnet id are returned.
 TEST_F(MemfileLeaseMgrTest, getLeases6SubnetId) {
     startBackend(V6);
@@ -1118,6 +1131,105 @@ TEST_F(MemfileLeaseMgrTest, getLeases6PagedMultiThread) {
     testGetLeases6Paged();
 }
 
+/// @brief Test that IPv6 leases are passed to a callback.
+TEST_F(MemfileLeaseMgrTest, walkLeases6) {
+    startBackend(V6);
+    testWalkLeases6();
+}
+
+/// @brief Test that IPv6 leases are passed to a callback.
+TEST_F(MemfileLeaseMgrTest, walkLeases6MultiThread) {
+    startBackend(V6);
+    MultiThreadingMgr::instance().setMode(true);
+    testWalkLeases6();
+}
+
+/// @brief Test that the IPv4 leases are passed to a callback by chunks
+/// which can use the lease manager.
+TEST_F(MemfileLeaseMgrTest, walkLeases4Chunks) {
+    startBackend(V4);
+    MultiThreadingMgr::instance().setMode(true);
+
+    // More leases than a walk chunk.
+    const size_t lease_count = 2500;
+    for (size_t i = 0; i < lease_count; ++i) {
+        IOAddress address(IOAddress("192.0.2.0").toUint32() + i);
+        makeLease4(address.toText(), 1 + (i % 2));
+    }
+
+    // The callback is called without the lock, so it can use the lease
+    // manager.
+    std::vector<IOAddress> addresses;
+    auto callback = [this, &addresses](const Lease4& lease) {
+        ASSERT_TRUE(lmptr_->getLease4(lease.addr_));
+        addresses.push_back(lease.addr_);
+    };
+
+    ASSERT_NO_THROW(lmptr_->walkLeases4(callback));
+    ASSERT_EQ(lease_count, addresses.size());
+    for (size_t i = 0; i < lease_count; ++i) {
+        EXPECT_EQ(IOAddress("192.0.2.0").toUint32() + i,
+                  addresses[i].toUint32());
+    }
+
+    // A page larger than a chunk.
+    addresses.clear();
+    ASSERT_NO_THROW(lmptr_->walkLeases4(IOAddress("192.0.2.9"),
+                                        LeasePageSize(2000), callback));
+    ASSERT_EQ(2000, addresses.size());
+    EXPECT_EQ("192.0.2.10", addresses.front().toText());
+    EXPECT_EQ(IOAddress("192.0.2.10").toUint32() + 1999,
+              addresses.back().toUint32());
+
+    // The leases of a subnet.
+    addresses.clear();
+    ASSERT_NO_THROW(lmptr_->walkLeases4(SubnetID(2), callback));
+    EXPECT_EQ(lease_count / 2, addresses.size());
+}
+
+/// @brief Test that the IPv6 leases are passed to a callback by chunks
+/// which can use the lease manager.
+TEST_F(MemfileLeaseMgrTest, walkLeases6Chunks) {
+    startBackend(V6);
+    MultiThreadingMgr::instance().setMode(true);
+
+    // More leases than a walk chunk.
+    const size_t lease_count = 2500;
+    for (size_t i = 0; i < lease_count; ++i) {
+        std::ostringstream address;
+        address << "2001:db8:1::" << std::hex << (i + 1);
+        makeLease6(Lease::TYPE_NA, address.str(), 0, 1 + (i % 2));
+    }
+
+    // The callback is called without the lock, so it can use the lease
+    // manager.
+    std::vector<IOAddress> addresses;
+    auto callback = [this, &addresses](const Lease6& lease) {
+        ASSERT_TRUE(lmptr_->getLease6(lease.type_, lease.addr_));
+        addresses.push_back(lease.addr_);
+    };
+
+    ASSERT_NO_THROW(lmptr_->walkLeases6(callback));
+    ASSERT_EQ(lease_count, addresses.size());
+    for (size_t i = 1; i < lease_count; ++i) {
+        EXPECT_TRUE(addresses[i - 1] < addresses[i]);
+    }
+
+    // A page larger than a chunk.
+    std::vector<IOAddress> all_addresses(addresses);
+    addresses.clear();
+    ASSERT_NO_THROW(lmptr_->walkLeases6(all_addresses[9],
+                                        LeasePageSize(2000), callback));
+    ASSERT_EQ(2000, addresses.size());
+    EXPECT_EQ(all_addresses[10], addresses.front());
+    EXPECT_EQ(all_addresses[2009], addresses.back());
+
+    // The leases of a subnet.
+    addresses.clear();
+    ASSERT_NO_THROW(lmptr_->walkLeases6(SubnetID(2), callback));
+    EXPECT_EQ(lease_count / 2, addresses.size());
+}
+
 /// @brief Basic Lease6 Checks
 ///
 /// Checks that the addLease, getLease6 (by address) and deleteLease (with an
@@ -1316,6 +1428,36 @@ TEST_F(MemfileLeaseMgrTest, DISABLED_updateLease6MultiThread) {
     testUpdateLease6();
 }
 
+/// @brief Lease4 batch operations tests
+///
+/// Checks that we are able to add, update and delete collections of leases.
+TEST_F(MemfileLeaseMgrTest, batchLeases4) {
+    startBackend(V4);
+    testBatchLeases4();
+}
+
+/// @brief Lease4 batch operations tests
+TEST_F(MemfileLeaseMgrTest, batchLeases4MultiThread) {
+    startBackend(V4);
+    MultiThreadingMgr::instance().setMode(true);
+    testBatchLeases4();
+}
+
+/// @brief Lease6 batch operations tests
+///
+/// Checks that we are able to add, update and delete collections of leases.
+TEST_F(MemfileLeaseMgrTest, batchLeases6) {
+    startBackend(V6);
+    testBatchLeases6();
+}
+
+/// @brief Lease6 batch operations tests
+TEST_F(MemfileLeaseMgrTest, batchLeases6MultiThread) {
+    startBackend(V6);
+    MultiThreadingMgr::instance().setMode(true);
+    testBatchLeases6();
+}
+
 /// @brief DHCPv4 Lease recreation tests
 ///
 /// Checks that the lease can be created, deleted and recreated with
@@ -2256,4 +2398,120 @@ TEST_F(MemfileLeaseMgrTest, leaseStatsQueryAttribution6) {
     testLeaseStatsQueryAttribution6();
 }
 
+/// @brief Tests v4 pool lease stats query.
+TEST_F(MemfileLeaseMgrTest, poolLeaseStatsQuery4) {
+    startBackend(V4);
+
+    // Two pools of the subnet 1.
+    LeaseStatsPoolCollection pools;
+    pools.push_back(LeaseStatsPool(1, 0, Lease::TYPE_V4, IOAddress("192.0.1.10"),
+                                   IOAddress("192.0.1.19")));
+    pools.push_back(LeaseStatsPool(1, 1, Lease::TYPE_V4, IOAddress("192.0.1.20"),
+                                   IOAddress("192.0.1.29")));
+
+    // The leases added before the query are counted when the pools are
+    // first given to the backend.
+    makeLease4("192.0.1.10", 1);
+    makeLease4("192.0.1.11", 1, Lease::STATE_DECLINED);
+    makeLease4("192.0.1.12", 1, Lease::STATE_EXPIRED_RECLAIMED);
+    makeLease4("192.0.1.30", 1);
+
+    RowSet expected_rows;
+    expected_rows.insert(LeaseStatsRow(1, 0, Lease::TYPE_NA,
+                                       Lease::STATE_DEFAULT, 1));
+    expected_rows.insert(LeaseStatsRow(1, 0, Lease::TYPE_NA,
+                                       Lease::STATE_DECLINED, 1));
+    LeaseStatsQueryPtr query;
+    ASSERT_NO_THROW(query = lmptr_->startPoolLeaseStatsQuery4(pools));
+    {
+        SCOPED_TRACE("FIRST POOL QUERY");
+        checkQueryAgainstRowSet(query, expected_rows);
+    }
+
+    // The leases added, updated or deleted after the query are counted
+    // incrementally.
+    makeLease4("192.0.1.20", 1);
+    Lease4Ptr lease = lmptr_->getLease4(IOAddress("192.0.1.11"));
+    ASSERT_TRUE(lease);
+    lease->state_ = Lease::STATE_DEFAULT;
+    ASSERT_NO_THROW(lmptr_->updateLease4(lease));
+    lease = lmptr_->getLease4(IOAddress("192.0.1.10"));
+    ASSERT_TRUE(lease);
+    ASSERT_TRUE(lmptr_->deleteLease(lease));
+
+    expected_rows.clear();
+    expected_rows.insert(LeaseStatsRow(1, 0, Lease::TYPE_NA,
+                                       Lease::STATE_DEFAULT, 1));
+    expected_rows.insert(LeaseStatsRow(1, 1, Lease::TYPE_NA,
+                                       Lease::STATE_DEFAULT, 1));
+    ASSERT_NO_THROW(query = lmptr_->startPoolLeaseStatsQuery4(pools));
+    {
+        SCOPED_TRACE("SECOND POOL QUERY");
+        checkQueryAgainstRowSet(query, expected_rows);
+    }
+}
+
+/// @brief Tests v6 pool lease stats query.
+TEST_F(MemfileLeaseMgrTest, poolLeaseStatsQuery6) {
+    startBackend(V6);
+
+    // An address pool and a prefix pool of the subnet 1.
+    LeaseStatsPoolCollection pools;
+    pools.push_back(LeaseStatsPool(1, 0, Lease::TYPE_NA, IOAddress("2001:db8:1::10"),
+                                   IOAddress("2001:db8:1::1f")));
+    pools.push_back(LeaseStatsPool(1, 0, Lease::TYPE_PD, IOAddress("3000:1::"),
+                                   IOAddress("3000:1:0:ffff::")));
+
+    makeLease6(Lease::TYPE_NA, "2001:db8:1::10", 0, 1);
+    makeLease6(Lease::TYPE_NA, "2001:db8:1::11", 0, 1, Lease::STATE_DECLINED);
+    makeLease6(Lease::TYPE_NA, "2001:db8:1::20", 0, 1);
+    makeLease6(Lease::TYPE_PD, "3000:1:0:1::", 64, 1);
+
+    RowSet expected_rows;
+    expected_rows.insert(LeaseStatsRow(1, 0, Lease::TYPE_NA,
+                                       Lease::STATE_DEFAULT, 1));
+    expected_rows.insert(LeaseStatsRow(1, 0, Lease::TYPE_NA,
+                                       Lease::STATE_DECLINED, 1));
+    expected_rows.insert(LeaseStatsRow(1, 0, Lease::TYPE_PD,
+                                       Lease::STATE_DEFAULT, 1));
+    LeaseStatsQueryPtr query;
+    ASSERT_NO_THROW(query = lmptr_->startPoolLeaseStatsQuery6(pools));
+    {
+        SCOPED_TRACE("FIRST POOL QUERY");
+        checkQueryAgainstRowSet(query, expected_rows);
+    }
+
+    makeLease6(Lease::TYPE_PD, "3000:1:0:2::", 64, 1);
+    expected_rows.erase(LeaseStatsRow(1, 0, Lease::TYPE_PD,
+                                      Lease::STATE_DEFAULT, 1));
+    expected_rows.insert(LeaseStatsRow(1, 0, Lease::TYPE_PD,
+                                       Lease::STATE_DEFAULT, 2));
+    ASSERT_NO_THROW(query = lmptr_->startPoolLeaseStatsQuery6(pools));
+    {
+        SCOPED_TRACE("SECOND POOL QUERY");
+        checkQueryAgainstRowSet(query, expected_rows);
+    }
+}
+
+/// @brief Verifies that the lease statistics are counted when the
+/// leases are loaded from the lease file.
+TEST_F(MemfileLeaseMgrTest, leaseStatsQueryReload4) {
+    startBackend(V4);
+
+    makeLease4("192.0.1.1", 1);
+    makeLease4("192.0.1.2", 1, Lease::STATE_DECLINED);
+    makeLease4("192.0.1.3", 2);
+
+    // Reopen the backend: the leases are counted when loaded.
+    reopen(V4);
+
+    RowSet expected_rows;
+    expected_rows.insert(LeaseStatsRow(1, Lease::STATE_DEFAULT, 1));
+    expected_rows.insert(LeaseStatsRow(1, Lease::STATE_DECLINED, 1));
+    expected_rows.insert(LeaseStatsRow(2, Lease::STATE_DEFAULT, 1));
+    LeaseStatsQueryPtr query;
+    ASSERT_NO_THROW(query = lmptr_->startLeaseStatsQuery4());
+    checkQueryAgainstRowSet(query, expected_rows);
+}
+
 }  // namespace
@@ -78,6 +78,35 @@ TEST_F(MultiThreadingConfigParserTest, validContent) {
         "   \"thread-pool-size\": 4, \n"
         "   \"packet-queue-size\": 64 \n"
         "} \n"
+        },
+        {
+        "enable-multi-threading, with receiver-threads",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"receiver-threads\": true \n"
+        "} \n"
+        },
+        {
+        "enable-multi-threading, with send-batch-size and send-batch-delay",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"send-batch-size\": 32, \n"
+        "   \"send-batch-delay\": 200 \n"
+        "} \n"
+        },
+        {
+        "enable-multi-threading, with background-config-parsing",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"background-config-parsing\": true \n"
+        "} \n"
+        },
+        {
+        "enable-multi-threading, with command-threads",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"command-threads\": 2 \n"
+        "} \n"
         }
     };
 
@@ -168,6 +197,83 @@ TEST_F(MultiThreadingConfigParserTest, invalidContent) {
         "{ \n"
         "   \"packet-queue-size\": 200000 \n"
         "} \n"
+        },
+        {
+        "receiver-threads not boolean",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"receiver-threads\": \"yes\" \n"
+        "} \n"
+        },
+        {
+        "send-batch-size not integer",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"send-batch-size\": \"32\" \n"
+        "} \n"
+        },
+        {
+        "send-batch-size negative",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"send-batch-size\": -1 \n"
+        "} \n"
+        },
+        {
+        "send-batch-size too large",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"send-batch-size\": 100000 \n"
+        "} \n"
+        },
+        {
+        "send-batch-delay not integer",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"send-batch-delay\": true \n"
+        "} \n"
+        },
+        {
+        "send-batch-delay negative",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"send-batch-delay\": -1 \n"
+        "} \n"
+        },
+        {
+        "send-batch-delay too large",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"send-batch-delay\": 2000000 \n"
+        "} \n"
+        },
+        {
+        "background-config-parsing not boolean",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"background-config-parsing\": 1 \n"
+        "} \n"
+        },
+        {
+        "command-threads not integer",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"command-threads\": true \n"
+        "} \n"
+        },
+        {
+        "command-threads negative",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"command-threads\": -1 \n"
+        "} \n"
+        },
+        {
+        "command-threads too large",
+        "{ \n"
+        "   \"enable-multi-threading\": true, \n"
+        "   \"command-threads\": 200000 \n"
+        "} \n"
         }
     };
 
@@ -515,6 +515,17 @@ TEST_F(MySqlLeaseMgrTest, getLeases4PagedMultiThreading) {
     testGetLeases4Paged();
 }
 
+/// @brief Test that IPv4 leases are passed to a callback.
+TEST_F(MySqlLeaseMgrTest, walkLeases4) {
+    testWalkLeases4();
+}
+
+/// @brief Test that IPv4 leases are passed to a callback.
+TEST_F(MySqlLeaseMgrTest, walkLeases4MultiThreading) {
+    MultiThreadingTest mt(true);
+    testWalkLeases4();
+}
+
 /// @brief This test checks that all IPv6 leases for a specified subnet id are returned.
 TEST_F(MySqlLeaseMgrTest, getLeases6SubnetId) {
     testGetLeases6SubnetId();
@@ -559,6 +570,17 @@ TEST_F(MySqlLeaseMgrTest, getLeases6PagedMultiThreading) {
     testGetLeases6Paged();
 }
 
+/// @brief Test that IPv6 leases are passed to a callback.
+TEST_F(MySqlLeaseMgrTest, walkLeases6) {
+    testWalkLeases6();
+}
+
+/// @brief Test that IPv6 leases are passed to a callback.
+TEST_F(MySqlLeaseMgrTest, walkLeases6MultiThreading) {
+    MultiThreadingTest mt(true);
+    testWalkLeases6();
+}
+
 /// @brief Basic Lease4 Checks
 ///
 /// Checks that the addLease, getLease4(by address), getLease4(hwaddr,subnet_id),
@@ -805,6 +827,36 @@ TEST_F(MySqlLeaseMgrTest, concurrentUpdateLease6MultiThreading) {
     testConcurrentUpdateLease6();
 }
 
+/// @brief Lease4 batch operations tests
+///
+/// Checks that we are able to add, update and delete collections of leases.
+/// The MySQL backend does not override the batch operations, so this tests
+/// the default implementation which processes the leases one by one.
+TEST_F(MySqlLeaseMgrTest, batchLeases4) {
+    testBatchLeases4();
+}
+
+/// @brief Lease4 batch operations tests
+TEST_F(MySqlLeaseMgrTest, batchLeases4MultiThreading) {
+    MultiThreadingTest mt(true);
+    testBatchLeases4();
+}
+
+/// @brief Lease6 batch operations tests
+///
+/// Checks that we are able to add, update and delete collections of leases.
+/// The MySQL backend does not override the batch operations, so this tests
+/// the default implementation which processes the leases one by one.
+TEST_F(MySqlLeaseMgrTest, batchLeases6) {
+    testBatchLeases6();
+}
+
+/// @brief Lease6 batch operations tests
+TEST_F(MySqlLeaseMgrTest, batchLeases6MultiThreading) {
+    MultiThreadingTest mt(true);
+    testBatchLeases6();
+}
+
 /// @brief DHCPv4 Lease recreation tests
 ///
 /// Checks that the lease can be created, deleted and recreated with
@@ -0,0 +1,283 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <cc/command_interpreter.h>
+#include <dhcpsrv/packet_profiler.h>
+#include <exceptions/exceptions.h>
+#include <stats/stats_mgr.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <unistd.h>
+
+using namespace isc;
+using namespace isc::config;
+using namespace isc::data;
+using namespace isc::dhcp;
+using namespace isc::stats;
+
+namespace {
+
+/// @brief Test fixture class for @c PacketProfiler.
+class PacketProfilerTest : public ::testing::Test {
+public:
+    /// @brief Constructor.
+    PacketProfilerTest() {
+        PacketProfiler::instance().setSampleRate(0);
+        StatsMgr::instance().removeAll();
+    }
+
+    /// @brief Destructor.
+    virtual ~PacketProfilerTest() {
+        PacketProfiler::instance().setSampleRate(0);
+        StatsMgr::instance().removeAll();
+    }
+
+    /// @brief Simulates the processing of a packet.
+    ///
+    /// @param timestamp Reception time of the packet.
+    void processPacket(const boost::posix_time::ptime& timestamp =
+                       boost::posix_time::ptime()) {
+        PacketProfiler::PacketScope profile(timestamp);
+        PacketProfiler::StageTimer timer(PacketProfiler::STAGE_UNPACK);
+        {
+            PacketProfiler::StageTimer timer(PacketProfiler::STAGE_ALLOCATION);
+            PacketProfiler::StageTimer nested(PacketProfiler::STAGE_LEASE_WRITE);
+        }
+    }
+
+    /// @brief Returns the count of a stage in the profile.
+    ///
+    /// @param stage Name of the stage.
+    /// @return Number of durations recorded for the stage.
+    int64_t getCount(const std::string& stage) {
+        ElementPtr profile = PacketProfiler::instance().toElement();
+        return (profile->get("stages")->get(stage)->get("count")->intValue());
+    }
+};
+
+// Check that the values below SUB_BUCKETS are counted exactly and that the
+// greater values are counted in buckets holding close values.
+TEST(StageHistogramTest, buckets) {
+    for (uint64_t value = 0; value < StageHistogram::SUB_BUCKETS; ++value) {
+        EXPECT_EQ(value, StageHistogram::getBucketIndex(value));
+        EXPECT_EQ(value, StageHistogram::getBucketHighest(value));
+    }
+    for (uint64_t value = StageHistogram::SUB_BUCKETS;
+         value < StageHistogram::MAX_VALUE; value = value * 3 / 2 + 7) {
+        size_t index = StageHistogram::getBucketIndex(value);
+        ASSERT_LT(index, StageHistogram::BUCKETS);
+        uint64_t highest = StageHistogram::getBucketHighest(index);
+        EXPECT_LE(value, highest);
+        EXPECT_LT(highest - value, value / 14 + 1) << value;
+        EXPECT_EQ(index + 1, StageHistogram::getBucketIndex(highest + 1));
+    }
+    EXPECT_EQ(StageHistogram::BUCKETS - 1,
+              StageHistogram::getBucketIndex(StageHistogram::MAX_VALUE));
+    EXPECT_EQ(StageHistogram::BUCKETS - 1,
+              StageHistogram::getBucketIndex(StageHistogram::MAX_VALUE * 2));
+}
+
+// Check the percentiles, the count, the sum and the maximum.
+TEST(StageHistogramTest, percentiles) {
+    StageHistogram histogram;
+    EXPECT_EQ(0, histogram.getPercentile(50.));
+    for (uint64_t value = 1; value <= 100; ++value) {
+        histogram.record(value * 1000);
+    }
+    EXPECT_EQ(100, histogram.getCount());
+    EXPECT_EQ(5050000, histogram.getSum());
+    EXPECT_EQ(100000, histogram.getMax());
+    uint64_t p50 = histogram.getPercentile(50.);
+    EXPECT_LE(50000, p50);
+    EXPECT_GT(50000 * 107 / 100, p50);
+    uint64_t p99 = histogram.getPercentile(99.);
+    EXPECT_LE(99000, p99);
+    EXPECT_GE(100000, p99);
+    EXPECT_EQ(100000, histogram.getPercentile(100.));
+    EXPECT_THROW(histogram.getPercentile(101.), BadValue);
+    EXPECT_THROW(histogram.getPercentile(-1.), BadValue);
+
+    StageHistogram merged;
+    merged.merge(histogram);
+    merged.merge(histogram);
+    EXPECT_EQ(200, merged.getCount());
+    EXPECT_EQ(p50, merged.getPercentile(50.));
+
+    histogram.reset();
+    EXPECT_EQ(0, histogram.getCount());
+    EXPECT_EQ(0, histogram.getMax());
+}
+
+// Check that nothing is recorded when the profiling is disabled.
+TEST_F(PacketProfilerTest, disabled) {
+    EXPECT_EQ(0, PacketProfiler::instance().getSampleRate());
+    {
+        boost::posix_time::ptime no_timestamp;
+        PacketProfiler::PacketScope profile(no_timestamp);
+        EXPECT_FALSE(PacketProfiler::isSampling());
+    }
+    processPacket();
+    EXPECT_EQ(0, getCount("total"));
+    EXPECT_EQ(0, getCount("unpack"));
+}
+
+// Check that the stages of the sampled packets are recorded.
+TEST_F(PacketProfilerTest, sampling) {
+    PacketProfiler::instance().setSampleRate(2);
+    for (int i = 0; i < 10; ++i) {
+        processPacket();
+    }
+    EXPECT_FALSE(PacketProfiler::isSampling());
+    EXPECT_EQ(5, getCount("total"));
+    EXPECT_EQ(5, getCount("unpack"));
+    EXPECT_EQ(5, getCount("allocation"));
+    EXPECT_EQ(5, getCount("lease-write"));
+    EXPECT_EQ(0, getCount("ddns"));
+    // The packets have no reception time.
+    EXPECT_EQ(0, getCount("receive"));
+
+    // A stage measured outside of a packet is not recorded.
+    {
+        PacketProfiler::StageTimer timer(PacketProfiler::STAGE_DDNS);
+    }
+    EXPECT_EQ(0, getCount("ddns"));
+
+    // Setting the sample rate removes the recorded values.
+    PacketProfiler::instance().setSampleRate(1);
+    EXPECT_EQ(0, getCount("total"));
+    processPacket(boost::posix_time::microsec_clock::universal_time());
+    EXPECT_EQ(1, getCount("total"));
+    EXPECT_EQ(1, getCount("receive"));
+
+    ElementPtr profile = PacketProfiler::instance().toElement();
+    EXPECT_EQ(1, profile->get("sample-rate")->intValue());
+    ConstElementPtr total = profile->get("stages")->get("total");
+    ASSERT_TRUE(total);
+    EXPECT_LE(total->get("p50")->intValue(), total->get("max")->intValue());
+    EXPECT_LE(total->get("p99")->intValue(), total->get("max")->intValue());
+    EXPECT_TRUE(total->get("mean"));
+    EXPECT_TRUE(total->get("p90"));
+}
+
+// Check that nested packet scopes are ignored.
+TEST_F(PacketProfilerTest, nestedScopes) {
+    PacketProfiler::instance().setSampleRate(1);
+    {
+        boost::posix_time::ptime no_timestamp;
+        PacketProfiler::PacketScope profile(no_timestamp);
+        EXPECT_TRUE(PacketProfiler::isSampling());
+        processPacket();
+        EXPECT_TRUE(PacketProfiler::isSampling());
+    }
+    EXPECT_FALSE(PacketProfiler::isSampling());
+    EXPECT_EQ(1, getCount("total"));
+    EXPECT_EQ(1, getCount("unpack"));
+}
+
+// Check that the time spent in a nested stage is not counted in the
+// enclosing stage.
+TEST_F(PacketProfilerTest, exclusiveStages) {
+    PacketProfiler::instance().setSampleRate(1);
+    {
+        boost::posix_time::ptime no_timestamp;
+        PacketProfiler::PacketScope profile(no_timestamp);
+        PacketProfiler::StageTimer timer(PacketProfiler::STAGE_SUBNET_SELECT);
+        {
+            PacketProfiler::StageTimer nested(PacketProfiler::STAGE_HOOKS);
+            usleep(50000);
+        }
+    }
+    ConstElementPtr stages = PacketProfiler::instance().toElement()->get("stages");
+    EXPECT_GE(stages->get("hooks")->get("max")->intValue(), 45000000);
+    EXPECT_LT(stages->get("subnet-select")->get("max")->intValue(), 25000000);
+    EXPECT_GE(stages->get("total")->get("max")->intValue(), 45000000);
+}
+
+// Check that the values recorded by other threads are kept when they exit.
+TEST_F(PacketProfilerTest, threads) {
+    PacketProfiler::instance().setSampleRate(1);
+    std::thread first([this]() {
+        for (int i = 0; i < 3; ++i) {
+            processPacket();
+        }
+    });
+    std::thread second([this]() {
+        processPacket();
+    });
+    first.join();
+    second.join();
+    processPacket();
+    EXPECT_EQ(5, getCount("total"));
+
+    PacketProfiler::instance().reset();
+    EXPECT_EQ(0, getCount("total"));
+}
+
+// Check that the percentiles are published as statistics.
+TEST_F(PacketProfilerTest, statistics) {
+    PacketProfiler::instance().setSampleRate(1);
+    processPacket();
+    PacketProfiler::instance().publishStatistics();
+    EXPECT_TRUE(StatsMgr::instance().getObservation("pkt-stage-total-p50"));
+    EXPECT_TRUE(StatsMgr::instance().getObservation("pkt-stage-total-p99"));
+    EXPECT_TRUE(StatsMgr::instance().getObservation("pkt-stage-unpack-max"));
+    EXPECT_FALSE(StatsMgr::instance().getObservation("pkt-stage-ddns-p50"));
+}
+
+// Check the packet-profile-set and packet-profile-get commands.
+TEST_F(PacketProfilerTest, commands) {
+    int rcode = -1;
+    ConstElementPtr answer =
+        PacketProfiler::profileSetHandler("packet-profile-set",
+                                          ConstElementPtr());
+    parseAnswer(rcode, answer);
+    EXPECT_EQ(CONTROL_RESULT_ERROR, rcode);
+
+    ElementPtr params = Element::createMap();
+    params->set("sample-rate", Element::create("ten"));
+    answer = PacketProfiler::profileSetHandler("packet-profile-set", params);
+    parseAnswer(rcode, answer);
+    EXPECT_EQ(CONTROL_RESULT_ERROR, rcode);
+
+    params->set("sample-rate", Element::create(-1));
+    answer = PacketProfiler::profileSetHandler("packet-profile-set", params);
+    parseAnswer(rcode, answer);
+    EXPECT_EQ(CONTROL_RESULT_ERROR, rcode);
+
+    params->set("sample-rate", Element::create(10));
+    answer = PacketProfiler::profileSetHandler("packet-profile-set", params);
+    parseAnswer(rcode, answer);
+    EXPECT_EQ(CONTROL_RESULT_SUCCESS, rcode);
+    EXPECT_EQ(10, PacketProfiler::instance().getSampleRate());
+
+    answer = PacketProfiler::profileGetHandler("packet-profile-get",
+                                               ConstElementPtr());
+    ConstElementPtr arguments = parseAnswer(rcode, answer);
+    EXPECT_EQ(CONTROL_RESULT_SUCCESS, rcode);
+    ASSERT_TRUE(arguments);
+    EXPECT_EQ(10, arguments->get("sample-rate")->intValue());
+    ConstElementPtr stages = arguments->get("stages");
+    ASSERT_TRUE(stages);
+    EXPECT_EQ(PacketProfiler::STAGE_COUNT, stages->size());
+    for (int i = 0; i < PacketProfiler::STAGE_COUNT; ++i) {
+        std::string name =
+            PacketProfiler::stageToText(static_cast<PacketProfiler::Stage>(i));
+        EXPECT_TRUE(stages->get(name)) << name;
+    }
+
+    params->set("sample-rate", Element::create(0));
+    answer = PacketProfiler::profileSetHandler("packet-profile-set", params);
+    parseAnswer(rcode, answer);
+    EXPECT_EQ(CONTROL_RESULT_SUCCESS, rcode);
+    EXPECT_EQ(0, PacketProfiler::instance().getSampleRate());
+}
+
+} // end of anonymous namespace
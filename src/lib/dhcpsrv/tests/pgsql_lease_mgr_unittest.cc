@@ -471,6 +471,17 @@ TEST_F(PgSqlLeaseMgrTest, getLeases4PagedMultiThreading) {
     testGetLeases4Paged();
 }
 
+/// @brief Test that IPv4 leases are passed to a callback.
+TEST_F(PgSqlLeaseMgrTest, walkLeases4) {
+    testWalkLeases4();
+}
+
+/// @brief Test that IPv4 leases are passed to a callback.
+TEST_F(PgSqlLeaseMgrTest, walkLeases4MultiThreading) {
+    MultiThreadingTest mt(true);
+    testWalkLeases4();
+}
+
 /// @brief This test checks that all IPv6 leases for a specified subnet id are returned.
 TEST_F(PgSqlLeaseMgrTest, getLeases6SubnetId) {
     testGetLeases6SubnetId();
@@ -515,6 +526,17 @@ TEST_F(PgSqlLeaseMgrTest, getLeases6PagedMultiThreading) {
     testGetLeases6Paged();
 }
 
+/// @brief Test that IPv6 leases are passed to a callback.
+TEST_F(PgSqlLeaseMgrTest, walkLeases6) {
+    testWalkLeases6();
+}
+
+/// @brief Test that IPv6 leases are passed to a callback.
+TEST_F(PgSqlLeaseMgrTest, walkLeases6MultiThreading) {
+    MultiThreadingTest mt(true);
+    testWalkLeases6();
+}
+
 /// @brief Basic Lease4 Checks
 ///
 /// Checks that the addLease, getLease4(by address), getLease4(hwaddr,subnet_id),
@@ -761,6 +783,32 @@ TEST_F(PgSqlLeaseMgrTest, concurrentUpdateLease6MultiThreading) {
     testConcurrentUpdateLease6();
 }
 
+/// @brief Lease4 batch operations tests
+///
+/// Checks that we are able to add, update and delete collections of leases.
+TEST_F(PgSqlLeaseMgrTest, batchLeases4) {
+    testBatchLeases4();
+}
+
+/// @brief Lease4 batch operations tests
+TEST_F(PgSqlLeaseMgrTest, batchLeases4MultiThreading) {
+    MultiThreadingTest mt(true);
+    testBatchLeases4();
+}
+
+/// @brief Lease6 batch operations tests
+///
+/// Checks that we are able to add, update and delete collections of leases.
+TEST_F(PgSqlLeaseMgrTest, batchLeases6) {
+    testBatchLeases6();
+}
+
+/// @brief Lease6 batch operations tests
+TEST_F(PgSqlLeaseMgrTest, batchLeases6MultiThreading) {
+    MultiThreadingTest mt(true);
+    testBatchLeases6();
+}
+
 /// @brief DHCPv4 Lease recreation tests
 ///
 /// Checks that the lease can be created, deleted and recreated with
@@ -943,7 +943,7 @@ TokenOr::evaluate(Pkt& /*pkt*/, ValueStack& values) {
 
 void
 TokenMember::evaluate(Pkt& pkt, ValueStack& values) {
-    if (pkt.inClass(client_class_)) {
+    if (pkt.inClass(client_class_id_)) {
         values.push("true");
     } else {
         values.push("false");
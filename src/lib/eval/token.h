@@ -973,7 +973,8 @@ public:
     ///
     /// @param client_class client class name
     TokenMember(const std::string& client_class)
-        :client_class_(client_class){
+        :client_class_(client_class),
+         client_class_id_(ClientClassRegistry::instance().intern(client_class)) {
     }
 
     /// @brief Token evaluation (check if client_class_ was added to
@@ -996,6 +997,9 @@ public:
 protected:
     /// @brief The client class name
     ClientClass client_class_;
+
+    /// @brief Identifier of the interned client class name
+    ClientClassId client_class_id_;
 };
 
 /// @brief Token that represents vendor options in DHCPv4 and DHCPv6.
@@ -0,0 +1,167 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef CALLOUT_ARGUMENT_H
+#define CALLOUT_ARGUMENT_H
+
+#include <boost/any.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+
+namespace isc {
+namespace hooks {
+
+/// @brief Named argument passed to the callouts.
+///
+/// This is a replacement of the name/boost::any pair formerly used to
+/// store the callout arguments. The value is stored together with its
+/// type information and the values small enough, e.g. shared pointers,
+/// raw pointers, integers and booleans, are stored in place instead of
+/// being allocated on the heap. Setting a value of the type already held
+/// by the argument assigns the value in place.
+///
+/// The argument objects are reused by the callout handle: the name keeps
+/// its storage when the argument is cleared, so passing the same argument
+/// at each hook point does not allocate memory.
+///
+/// As with boost::any, getting the value with a type which is not the
+/// type of the value set throws boost::bad_any_cast.
+class CalloutArgument : public boost::noncopyable {
+public:
+
+    /// @brief Constructor.
+    CalloutArgument() : name_(), type_(0), destroy_(0) {
+    }
+
+    /// @brief Destructor.
+    ~CalloutArgument() {
+        clear();
+    }
+
+    /// @brief Returns the argument name.
+    const std::string& getName() const {
+        return (name_);
+    }
+
+    /// @brief Sets the argument name.
+    ///
+    /// @param name New name of the argument.
+    void setName(const std::string& name) {
+        name_.assign(name);
+    }
+
+    /// @brief Checks if the argument holds a value.
+    bool empty() const {
+        return (type_ == 0);
+    }
+
+    /// @brief Sets the value.
+    ///
+    /// @param value Value to set.
+    template <typename T>
+    void setValue(const T& value) {
+        if (type_ && (*type_ == typeid(T))) {
+            *Storage<T>::get(storage_) = value;
+            return;
+        }
+        clear();
+        Storage<T>::construct(storage_, value);
+        type_ = &typeid(T);
+        destroy_ = &Storage<T>::destroy;
+    }
+
+    /// @brief Gets the value.
+    ///
+    /// @return Reference to the value.
+    /// @throw boost::bad_any_cast if the value is not of the type T.
+    template <typename T>
+    const T& getValue() const {
+        if (!type_ || (*type_ != typeid(T))) {
+            throw boost::bad_any_cast();
+        }
+        return (*Storage<T>::get(const_cast<Buffer&>(storage_)));
+    }
+
+    /// @brief Destroys the value.
+    ///
+    /// The name is kept so the argument can be reused.
+    void clear() {
+        if (destroy_) {
+            destroy_(storage_);
+            destroy_ = 0;
+            type_ = 0;
+        }
+    }
+
+private:
+
+    /// @brief Size of the buffer holding the values in place.
+    static const size_t BUFFER_SIZE = 4 * sizeof(void*);
+
+    /// @brief Buffer holding the value or a pointer to it.
+    typedef std::aligned_storage<BUFFER_SIZE>::type Buffer;
+
+    /// @brief Checks if the values of a type are stored in place.
+    template <typename T>
+    struct InPlace {
+        static const bool value = (sizeof(T) <= BUFFER_SIZE) &&
+            (std::alignment_of<Buffer>::value % std::alignment_of<T>::value == 0);
+    };
+
+    /// @brief Storage operations for values stored in place.
+    template <typename T, bool in_place = InPlace<T>::value>
+    struct Storage {
+        static void construct(Buffer& buffer, const T& value) {
+            new (&buffer) T(value);
+        }
+
+        static T* get(Buffer& buffer) {
+            return (reinterpret_cast<T*>(&buffer));
+        }
+
+        static void destroy(Buffer& buffer) {
+            get(buffer)->~T();
+        }
+    };
+
+    /// @brief Storage operations for values allocated on the heap.
+    template <typename T>
+    struct Storage<T, false> {
+        static void construct(Buffer& buffer, const T& value) {
+            *reinterpret_cast<T**>(&buffer) = new T(value);
+        }
+
+        static T* get(Buffer& buffer) {
+            return (*reinterpret_cast<T**>(&buffer));
+        }
+
+        static void destroy(Buffer& buffer) {
+            delete get(buffer);
+        }
+    };
+
+    /// @brief Argument name.
+    std::string name_;
+
+    /// @brief Type of the value, null when there is no value.
+    const std::type_info* type_;
+
+    /// @brief Destroys the value, null when there is no value.
+    void (*destroy_)(Buffer&);
+
+    /// @brief Value or pointer to the value.
+    Buffer storage_;
+};
+
+} // namespace hooks
+} // namespace isc
+
+#endif // CALLOUT_ARGUMENT_H
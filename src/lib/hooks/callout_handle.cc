@@ -1,4 +1,4 @@
-// Copyright (C) 2013-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2013-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -11,6 +11,7 @@
 #include <hooks/library_handle.h>
 #include <hooks/server_hooks.h>
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
@@ -23,8 +24,8 @@ namespace hooks {
 // Constructor.
 CalloutHandle::CalloutHandle(const boost::shared_ptr<CalloutManager>& manager,
                     const boost::shared_ptr<LibraryManagerCollection>& lmcoll)
-    : lm_collection_(lmcoll), arguments_(), context_collection_(),
-      manager_(manager), server_hooks_(ServerHooks::getServerHooks()),
+    : lm_collection_(lmcoll), arguments_(), arguments_count_(0),
+      context_collection_(), manager_(manager), server_hooks_(ServerHooks::getServerHooks()),
       current_library_(-1), current_hook_(-1), next_step_(NEXT_STEP_CONTINUE) {
 
     // Call the "context_create" hook.  We should be OK doing this - although
@@ -37,12 +38,15 @@ CalloutHandle::CalloutHandle(const boost::shared_ptr<CalloutManager>& manager,
 CalloutHandle::~CalloutHandle() {
     // Call the "context_destroy" hook.  We should be OK doing this - although
     // the destructor is being called, all the member variables are still in
-    // existence.
-    manager_->callCallouts(ServerHooks::CONTEXT_DESTROY, *this);
+    // existence.  A handle detached by the pool has already called it.
+    if (manager_) {
+        manager_->callCallouts(ServerHooks::CONTEXT_DESTROY, *this);
+    }
 
     // Explicitly clear the argument and context objects.  This should free up
     // all memory that could have been allocated by libraries that were loaded.
     arguments_.clear();
+    arguments_count_ = 0;
     context_collection_.clear();
 
     // Normal destruction of the remaining variables will include the
@@ -59,19 +63,82 @@ CalloutHandle::~CalloutHandle() {
     // scope of this framework and is not addressed by it.
 }
 
-// Return the name of all argument items.
+void
+CalloutHandle::attach(const boost::shared_ptr<CalloutManager>& manager,
+                      const boost::shared_ptr<LibraryManagerCollection>& lmcoll) {
+    lm_collection_ = lmcoll;
+    manager_ = manager;
+    current_library_ = -1;
+    current_hook_ = -1;
+    next_step_ = NEXT_STEP_CONTINUE;
+
+    // Call the "context_create" hook as the constructor does.
+    manager_->callCallouts(ServerHooks::CONTEXT_CREATE, *this);
+}
+
+void
+CalloutHandle::detach() {
+    // Call the "context_destroy" hook as the destructor does.
+    if (manager_) {
+        manager_->callCallouts(ServerHooks::CONTEXT_DESTROY, *this);
+    }
+
+    // Release all the objects which may have been allocated by the
+    // libraries. The argument objects are kept for the next packet.
+    deleteAllArguments();
+    context_collection_.clear();
+    manager_.reset();
+    lm_collection_.reset();
+}
+
+// Return the name of all argument items. They are sorted as they used to
+// be when the arguments were stored in a map.
 
 vector<string>
 CalloutHandle::getArgumentNames() const {
     vector<string> names;
-    for (ElementCollection::const_iterator i = arguments_.begin();
-         i != arguments_.end(); ++i) {
-        names.push_back(i->first);
+    names.reserve(arguments_count_);
+    for (size_t i = 0; i < arguments_count_; ++i) {
+        names.push_back(arguments_[i]->getName());
     }
+    sort(names.begin(), names.end());
 
     return (names);
 }
 
+// Delete an argument. The deleted argument is moved after the arguments
+// in use so it can be reused.
+
+void
+CalloutHandle::deleteArgument(const std::string& name) {
+    for (size_t i = 0; i < arguments_count_; ++i) {
+        if (arguments_[i]->getName() == name) {
+            arguments_[i]->clear();
+            --arguments_count_;
+            arguments_[i].swap(arguments_[arguments_count_]);
+            return;
+        }
+    }
+}
+
+// Return the argument with a given name, creating it if needed.
+
+CalloutArgument&
+CalloutHandle::getArgumentForName(const std::string& name) {
+    for (size_t i = 0; i < arguments_count_; ++i) {
+        if (arguments_[i]->getName() == name) {
+            return (*arguments_[i]);
+        }
+    }
+    if (arguments_count_ == arguments_.size()) {
+        arguments_.push_back(boost::make_shared<CalloutArgument>());
+    }
+    CalloutArgument& argument = *arguments_[arguments_count_];
+    argument.setName(name);
+    ++arguments_count_;
+    return (argument);
+}
+
 ParkingLotHandlePtr
 CalloutHandle::getParkingLotHandlePtr() const {
     return (boost::make_shared<ParkingLotHandle>(server_hooks_.getParkingLotPtr(current_hook_)));
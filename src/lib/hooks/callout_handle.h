@@ -1,4 +1,4 @@
-// Copyright (C) 2013-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2013-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,7 @@
 #define CALLOUT_HANDLE_H
 
 #include <exceptions/exceptions.h>
+#include <hooks/callout_argument.h>
 #include <hooks/library_handle.h>
 #include <hooks/parking_lots.h>
 
@@ -47,6 +48,7 @@ public:
 
 // Forward declaration of the library handle and related collection classes.
 
+class CalloutHandlePool;
 class CalloutManager;
 class LibraryManagerCollection;
 
@@ -91,10 +93,15 @@ public:
 
 
     /// Typedef to allow abbreviation of iterator specification in methods.
-    /// The std::string is the argument name and the "boost::any" is the
+    /// The std::string is the context item name and the "boost::any" is the
     /// corresponding value associated with it.
     typedef std::map<std::string, boost::any> ElementCollection;
 
+    /// Typedef of the collection of arguments. The arguments are searched
+    /// by name in this small vector and reused once deleted, see
+    /// @ref CalloutArgument.
+    typedef std::vector<boost::shared_ptr<CalloutArgument> > ArgumentCollection;
+
     /// Typedef to allow abbreviations in specifications when accessing
     /// context.  The ElementCollection is the name/value collection for
     /// a particular context.  The "int" corresponds to the index of an
@@ -144,7 +151,7 @@ public:
     /// @param value Value to set.  That can be of any data type.
     template <typename T>
     void setArgument(const std::string& name, T value) {
-        arguments_[name] = value;
+        getArgumentForName(name).setValue(value);
     }
 
     /// @brief Get argument
@@ -161,13 +168,13 @@ public:
     ///        the variable provided to receive the value.
     template <typename T>
     void getArgument(const std::string& name, T& value) const {
-        ElementCollection::const_iterator element_ptr = arguments_.find(name);
-        if (element_ptr == arguments_.end()) {
+        const CalloutArgument* argument = findArgument(name);
+        if (!argument) {
             isc_throw(NoSuchArgument, "unable to find argument with name " <<
                       name);
         }
 
-        value = boost::any_cast<T>(element_ptr->second);
+        value = argument->getValue<T>();
     }
 
     /// @brief Get argument names
@@ -187,9 +194,7 @@ public:
     /// by this method.
     ///
     /// @param name Name of the element in the argument list to set.
-    void deleteArgument(const std::string& name) {
-        static_cast<void>(arguments_.erase(name));
-    }
+    void deleteArgument(const std::string& name);
 
     /// @brief Delete all arguments
     ///
@@ -198,7 +203,10 @@ public:
     /// N.B. If any elements are raw pointers, the pointed-to data is NOT
     /// deleted by this method.
     void deleteAllArguments() {
-        arguments_.clear();
+        for (size_t i = 0; i < arguments_count_; ++i) {
+            arguments_[i]->clear();
+        }
+        arguments_count_ = 0;
     }
 
     /// @brief Sets the next processing step.
@@ -357,6 +365,52 @@ public:
 
 private:
 
+    friend class CalloutHandlePool;
+
+    /// @brief Find an argument
+    ///
+    /// @param name Name of the argument.
+    ///
+    /// @return Pointer to the argument or null if there is no argument
+    ///         with this name.
+    const CalloutArgument* findArgument(const std::string& name) const {
+        for (size_t i = 0; i < arguments_count_; ++i) {
+            if (arguments_[i]->getName() == name) {
+                return (arguments_[i].get());
+            }
+        }
+        return (0);
+    }
+
+    /// @brief Return reference to the argument with a given name
+    ///
+    /// The argument is created if it does not exist, reusing a deleted
+    /// argument if any.
+    ///
+    /// @param name Name of the argument.
+    ///
+    /// @return Reference to the argument.
+    CalloutArgument& getArgumentForName(const std::string& name);
+
+    /// @brief Associate the handle with a callout manager
+    ///
+    /// Used by the @ref CalloutHandlePool when a handle is reused: it
+    /// attaches the handle to the current callout manager and library
+    /// collection and calls the "context_create" callouts as the
+    /// constructor does.
+    ///
+    /// @param manager Pointer to the callout manager object.
+    /// @param lmcoll Pointer to the library manager collection.
+    void attach(const boost::shared_ptr<CalloutManager>& manager,
+                const boost::shared_ptr<LibraryManagerCollection>& lmcoll);
+
+    /// @brief Release the handle before it is put back to the pool
+    ///
+    /// Calls the "context_destroy" callouts as the destructor does, deletes
+    /// the arguments and the contexts and releases the callout manager and
+    /// the library collection so the libraries can be unloaded.
+    void detach();
+
     /// @brief Check index
     ///
     /// Gets the current library index, throwing an exception if it is not set
@@ -400,8 +454,12 @@ private:
     /// created.
     boost::shared_ptr<LibraryManagerCollection> lm_collection_;
 
-    /// Collection of arguments passed to the callouts
-    ElementCollection arguments_;
+    /// Collection of arguments passed to the callouts. The arguments
+    /// beyond arguments_count_ have been deleted and are kept for reuse.
+    ArgumentCollection arguments_;
+
+    /// Number of arguments in use.
+    size_t arguments_count_;
 
     /// Context collection - there is one entry per library context.
     ContextCollection context_collection_;
@@ -0,0 +1,114 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <hooks/callout_handle_pool.h>
+
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+using isc::hooks::CalloutHandle;
+
+/// @brief Pooled handles of a thread.
+typedef vector<CalloutHandle*> HandleStack;
+
+/// @brief Pool of the current thread, null when it does not exist.
+///
+/// This trivial pointer can be checked safely when the thread exits,
+/// after the pool owner has been destroyed.
+thread_local HandleStack* thread_pool = 0;
+
+/// @brief Owner of the pool of the current thread.
+struct PoolOwner {
+    /// @brief Constructor.
+    PoolOwner() : handles_() {
+        thread_pool = &handles_;
+    }
+
+    /// @brief Destructor.
+    ///
+    /// Destroys the pooled handles.
+    ~PoolOwner() {
+        thread_pool = 0;
+        for (auto handle : handles_) {
+            delete handle;
+        }
+    }
+
+    /// @brief Pooled handles.
+    HandleStack handles_;
+};
+
+/// @brief Returns the pool of the current thread, creating it if needed.
+HandleStack&
+getThreadPool() {
+    thread_local PoolOwner owner;
+    return (owner.handles_);
+}
+
+} // end of anonymous namespace
+
+namespace isc {
+namespace hooks {
+
+const size_t CalloutHandlePool::MAX_POOL_SIZE;
+
+CalloutHandlePtr
+CalloutHandlePool::create(const boost::shared_ptr<CalloutManager>& manager,
+                          const boost::shared_ptr<LibraryManagerCollection>& lmcoll) {
+    HandleStack& handles = getThreadPool();
+    if (handles.empty()) {
+        return (CalloutHandlePtr(new CalloutHandle(manager, lmcoll),
+                                 &CalloutHandlePool::release));
+    }
+    CalloutHandle* handle = handles.back();
+    handles.pop_back();
+    try {
+        handle->attach(manager, lmcoll);
+    } catch (...) {
+        delete handle;
+        throw;
+    }
+    return (CalloutHandlePtr(handle, &CalloutHandlePool::release));
+}
+
+size_t
+CalloutHandlePool::size() {
+    return (thread_pool ? thread_pool->size() : 0);
+}
+
+void
+CalloutHandlePool::clear() {
+    if (thread_pool) {
+        for (auto handle : *thread_pool) {
+            delete handle;
+        }
+        thread_pool->clear();
+    }
+}
+
+void
+CalloutHandlePool::release(CalloutHandle* handle) {
+    // Without a pool in this thread, or with a full one, simply destroy
+    // the handle.
+    if (!thread_pool || (thread_pool->size() >= MAX_POOL_SIZE)) {
+        delete handle;
+        return;
+    }
+    try {
+        handle->detach();
+        thread_pool->push_back(handle);
+    } catch (...) {
+        delete handle;
+    }
+}
+
+} // namespace hooks
+} // namespace isc
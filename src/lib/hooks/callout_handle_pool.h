@@ -0,0 +1,71 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef CALLOUT_HANDLE_POOL_H
+#define CALLOUT_HANDLE_POOL_H
+
+#include <hooks/callout_handle.h>
+
+#include <boost/shared_ptr.hpp>
+
+#include <cstddef>
+
+namespace isc {
+namespace hooks {
+
+/// @brief Per thread pool of callout handles.
+///
+/// The servers create a callout handle for each processed packet. Rather
+/// than destroying the handle with the packet, the handle is returned to
+/// the pool of the thread releasing it and reused for a next packet. The
+/// handle keeps the argument objects allocated for the previous packet,
+/// so setting the same arguments at each hook point does not allocate
+/// memory.
+///
+/// The behavior seen by the hooks libraries is unchanged: the
+/// "context_create" callouts are called when the handle is obtained from
+/// the pool and the "context_destroy" callouts when it is released. The
+/// arguments and the per library contexts are deleted on release and the
+/// pooled handles hold no reference to the callout manager and to the
+/// loaded libraries, so the libraries can still be unloaded.
+class CalloutHandlePool {
+public:
+
+    /// @brief Maximum number of handles kept by each thread.
+    static const size_t MAX_POOL_SIZE = 64;
+
+    /// @brief Returns a callout handle.
+    ///
+    /// A handle of the pool of the calling thread is used if any, otherwise
+    /// a new handle is created. The returned pointer gives the handle back
+    /// to the pool of the thread releasing the last reference.
+    ///
+    /// @param manager Pointer to the callout manager object.
+    /// @param lmcoll Pointer to the library manager collection.
+    /// @return Pointer to the callout handle.
+    static CalloutHandlePtr
+    create(const boost::shared_ptr<CalloutManager>& manager,
+           const boost::shared_ptr<LibraryManagerCollection>& lmcoll);
+
+    /// @brief Returns the number of handles in the pool of the calling
+    /// thread.
+    static size_t size();
+
+    /// @brief Destroys the handles in the pool of the calling thread.
+    static void clear();
+
+private:
+
+    /// @brief Deleter of the callout handles returned by @ref create.
+    ///
+    /// @param handle Pointer to the released handle.
+    static void release(CalloutHandle* handle);
+};
+
+} // namespace hooks
+} // namespace isc
+
+#endif // CALLOUT_HANDLE_POOL_H
@@ -28,6 +28,7 @@ namespace hooks {
 CalloutManager::CalloutManager(int num_libraries)
     : server_hooks_(ServerHooks::getServerHooks()), current_library_(-1),
       hook_vector_(ServerHooks::getServerHooks().getCount()),
+      packet_callouts_count_(0),
       library_handle_(*this), pre_library_handle_(*this, 0),
       post_library_handle_(*this, INT_MAX), num_libraries_(num_libraries) {
     if (num_libraries < 0) {
@@ -83,6 +84,9 @@ CalloutManager::registerCallout(const std::string& name,
             // current index, so insert the new element ahead of this one.
             hook_vector_[hook_index].insert(i, make_pair(library_index,
                                                          callout));
+            if (!isCommandHook(name)) {
+                ++packet_callouts_count_;
+            }
             return;
         }
     }
@@ -91,6 +95,16 @@ CalloutManager::registerCallout(const std::string& name,
     // empty) set of callouts with a library index greater than the current
     // library index.  Inset the callout at the end of the list.
     hook_vector_[hook_index].push_back(make_pair(library_index, callout));
+    if (!isCommandHook(name)) {
+        ++packet_callouts_count_;
+    }
+}
+
+// Check if a hook is a control command hook point.
+
+bool
+CalloutManager::isCommandHook(const std::string& name) {
+    return (!name.empty() && (name[0] == '$'));
 }
 
 // Check if callouts are present for a given hook index.
@@ -270,6 +284,10 @@ CalloutManager::deregisterCallout(const std::string& name, CalloutPtr callout,
     // Return an indication of whether anything was removed.
     bool removed = initial_size != hook_vector_[hook_index].size();
     if (removed) {
+        if (!isCommandHook(name)) {
+            packet_callouts_count_ -= initial_size -
+                hook_vector_[hook_index].size();
+        }
         LOG_DEBUG(callouts_logger, HOOKS_DBG_EXTENDED_CALLS,
                   HOOKS_CALLOUT_DEREGISTERED).arg(library_index).arg(name);
     }
@@ -309,6 +327,10 @@ CalloutManager::deregisterAllCallouts(const std::string& name,
     // Return an indication of whether anything was removed.
     bool removed = initial_size != hook_vector_[hook_index].size();
     if (removed) {
+        if (!isCommandHook(name)) {
+            packet_callouts_count_ -= initial_size -
+                hook_vector_[hook_index].size();
+        }
         LOG_DEBUG(callouts_logger, HOOKS_DBG_EXTENDED_CALLS,
                   HOOKS_ALL_CALLOUTS_DEREGISTERED).arg(library_index).arg(name);
     }
@@ -212,6 +212,29 @@ public:
     /// @throw NoSuchHook Given index does not correspond to a valid hook.
     bool calloutsPresent(int hook_index) const;
 
+    /// @brief Checks if callouts are present on any packet hook
+    ///
+    /// The number of callouts is maintained when callouts are registered
+    /// and deregistered, so this check does not walk the hooks. It allows
+    /// the servers to skip the creation and the setup of the callout
+    /// handles when no library has registered a callout. The control
+    /// command handlers are not counted: a library which only provides
+    /// commands does not require a callout handle per packet.
+    ///
+    /// @return true if at least one callout is registered on a hook which
+    /// is not a control command hook, false if not.
+    bool anyCalloutsPresent() const {
+        return (packet_callouts_count_ > 0);
+    }
+
+    /// @brief Returns the number of registered callouts
+    ///
+    /// @return Number of callouts registered on all hooks but the control
+    /// command hooks.
+    size_t getCalloutsCount() const {
+        return (packet_callouts_count_);
+    }
+
     /// @brief Checks if control command handlers are present for the
     /// specified command.
     ///
@@ -397,6 +420,17 @@ private:
     /// @throw NoSuchLibrary Library index is not valid.
     void checkLibraryIndex(int library_index) const;
 
+    /// @brief Checks if a hook is a control command hook point
+    ///
+    /// The command handlers are registered as callouts on the hook points
+    /// named after the commands and prefixed with a dollar sign (see
+    /// @ref ServerHooks::commandToHookName).
+    ///
+    /// @param name Name of the hook.
+    ///
+    /// @return true if the hook is a control command hook point.
+    static bool isCommandHook(const std::string& name);
+
     // Member variables
 
     /// Reference to the singleton ServerHooks object.  See the
@@ -414,6 +448,11 @@ private:
     /// callout registered for that hook.
     std::vector<CalloutVector> hook_vector_;
 
+    /// Number of callouts registered on all hooks but the control command
+    /// hooks, i.e. the sum of the sizes of the callout vectors of the hooks
+    /// which names do not start with a dollar sign.
+    size_t packet_callouts_count_;
+
     /// LibraryHandle object user by the callout to access the callout
     /// registration methods on this CalloutManager object.  The object is set
     /// such that the index of the library associated with any operation is
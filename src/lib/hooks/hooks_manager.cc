@@ -1,4 +1,4 @@
-// Copyright (C) 2013-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2013-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -7,6 +7,7 @@
 #include <config.h>
 
 #include <hooks/callout_handle.h>
+#include <hooks/callout_handle_pool.h>
 #include <hooks/callout_manager.h>
 #include <hooks/library_handle.h>
 #include <hooks/library_manager_collection.h>
@@ -55,6 +56,16 @@ HooksManager::calloutsPresent(int index) {
     return (getHooksManager().calloutsPresentInternal(index));
 }
 
+bool
+HooksManager::anyCalloutsPresentInternal() const {
+    return (callout_manager_->anyCalloutsPresent());
+}
+
+bool
+HooksManager::anyCalloutsPresent() {
+    return (getHooksManager().anyCalloutsPresentInternal());
+}
+
 bool
 HooksManager::commandHandlersPresentInternal(const std::string& command_name) {
     return (callout_manager_->commandHandlersPresent(command_name));
@@ -193,7 +204,7 @@ HooksManager::prepareUnloadLibraries() {
 
 boost::shared_ptr<CalloutHandle>
 HooksManager::createCalloutHandleInternal() {
-    return (boost::make_shared<CalloutHandle>(callout_manager_, lm_collection_));
+    return (CalloutHandlePool::create(callout_manager_, lm_collection_));
 }
 
 boost::shared_ptr<CalloutHandle>
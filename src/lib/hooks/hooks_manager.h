@@ -121,6 +121,18 @@ public:
     /// @throw NoSuchHook Given index does not correspond to a valid hook.
     static bool calloutsPresent(int index);
 
+    /// @brief Are callouts present on any hook?
+    ///
+    /// Checks loaded libraries and returns true if at least one callout
+    /// has been registered by them, whatever the hook. Unlike
+    /// @ref calloutsPresent this check does not depend on the hook, so
+    /// the servers use it to skip the per packet hooks setup, e.g. the
+    /// creation of the callout handle, when no callout is registered.
+    /// The control command handlers are not taken into account.
+    ///
+    /// @return true if callouts are present, false if not.
+    static bool anyCalloutsPresent();
+
     /// @brief Checks if control command handlers are present for the
     /// specified command.
     ///
@@ -196,7 +208,8 @@ public:
     /// @brief Return callout handle
     ///
     /// Returns a callout handle to be associated with a request passed round
-    /// the system.
+    /// the system. The handle is taken from the @ref CalloutHandlePool of
+    /// the calling thread when possible and given back to it when released.
     ///
     /// @note This handle is valid only after a loadLibraries() call and then
     ///       only up to the next loadLibraries() call.
@@ -418,6 +431,11 @@ private:
     /// @throw NoSuchHook Given index does not correspond to a valid hook.
     bool calloutsPresentInternal(int index);
 
+    /// @brief Are callouts present on any hook?
+    ///
+    /// @return true if callouts are present, false if not.
+    bool anyCalloutsPresentInternal() const;
+
     /// @brief Checks if control command handlers are present for the
     /// specified command.
     ///
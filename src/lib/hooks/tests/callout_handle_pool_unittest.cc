@@ -0,0 +1,165 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <hooks/callout_handle.h>
+#include <hooks/callout_handle_pool.h>
+#include <hooks/callout_manager.h>
+#include <hooks/library_manager_collection.h>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace isc::hooks;
+using namespace std;
+
+namespace {
+
+/// @brief Number of calls to the context_create callout.
+int create_count = 0;
+
+/// @brief Number of calls to the context_destroy callout.
+int destroy_count = 0;
+
+/// @brief context_create callout checking the handle is clean.
+int
+contextCreate(CalloutHandle& handle) {
+    ++create_count;
+    EXPECT_TRUE(handle.getArgumentNames().empty());
+    handle.setContext("created", create_count);
+    return (0);
+}
+
+/// @brief context_destroy callout.
+int
+contextDestroy(CalloutHandle& handle) {
+    ++destroy_count;
+    int created = 0;
+    EXPECT_NO_THROW(handle.getContext("created", created));
+    return (0);
+}
+
+/// @brief Test fixture for the callout handle pool.
+class CalloutHandlePoolTest : public ::testing::Test {
+public:
+
+    /// @brief Constructor.
+    ///
+    /// Registers the context callouts.
+    CalloutHandlePoolTest() : manager_(new CalloutManager(1)) {
+        CalloutHandlePool::clear();
+        create_count = 0;
+        destroy_count = 0;
+        manager_->registerCallout("context_create", contextCreate, 0);
+        manager_->registerCallout("context_destroy", contextDestroy, 0);
+    }
+
+    /// @brief Destructor.
+    ~CalloutHandlePoolTest() {
+        CalloutHandlePool::clear();
+    }
+
+    /// @brief Callout manager.
+    boost::shared_ptr<CalloutManager> manager_;
+};
+
+// Test that a released handle is reused.
+TEST_F(CalloutHandlePoolTest, reuse) {
+    EXPECT_EQ(0, CalloutHandlePool::size());
+
+    CalloutHandlePtr handle = CalloutHandlePool::create(manager_,
+        boost::shared_ptr<LibraryManagerCollection>());
+    ASSERT_TRUE(handle);
+    EXPECT_EQ(1, create_count);
+    CalloutHandle* raw = handle.get();
+
+    boost::shared_ptr<int> value(new int(1));
+    handle->setArgument("value", value);
+    handle->setStatus(CalloutHandle::NEXT_STEP_DROP);
+    EXPECT_EQ(2, value.use_count());
+
+    // Releasing the handle calls the context_destroy callouts and
+    // releases the arguments.
+    handle.reset();
+    EXPECT_EQ(1, destroy_count);
+    EXPECT_EQ(1, value.use_count());
+    EXPECT_EQ(1, CalloutHandlePool::size());
+
+    // The next handle is the pooled one, in the initial state.
+    handle = CalloutHandlePool::create(manager_,
+        boost::shared_ptr<LibraryManagerCollection>());
+    EXPECT_EQ(raw, handle.get());
+    EXPECT_EQ(0, CalloutHandlePool::size());
+    EXPECT_EQ(2, create_count);
+    EXPECT_EQ(CalloutHandle::NEXT_STEP_CONTINUE, handle->getStatus());
+    EXPECT_TRUE(handle->getArgumentNames().empty());
+
+    // The context is the one created for this use.
+    handle->setCurrentLibrary(0);
+    int created = 0;
+    ASSERT_NO_THROW(handle->getContext("created", created));
+    EXPECT_EQ(2, created);
+    handle->setCurrentLibrary(-1);
+
+    handle.reset();
+    EXPECT_EQ(2, destroy_count);
+}
+
+// Test that the pooled handles don't hold the library collection.
+TEST_F(CalloutHandlePoolTest, libraries) {
+    HookLibsCollection libraries;
+    boost::shared_ptr<LibraryManagerCollection>
+        lmcoll(new LibraryManagerCollection(libraries));
+    boost::weak_ptr<LibraryManagerCollection> weak_lmcoll(lmcoll);
+
+    CalloutHandlePtr handle = CalloutHandlePool::create(manager_, lmcoll);
+    lmcoll.reset();
+    EXPECT_FALSE(weak_lmcoll.expired());
+
+    handle.reset();
+    EXPECT_EQ(1, CalloutHandlePool::size());
+    EXPECT_TRUE(weak_lmcoll.expired());
+}
+
+// Test that the pool size is bounded.
+TEST_F(CalloutHandlePoolTest, maxSize) {
+    vector<CalloutHandlePtr> handles;
+    for (size_t i = 0; i < CalloutHandlePool::MAX_POOL_SIZE + 10; ++i) {
+        handles.push_back(CalloutHandlePool::create(manager_,
+            boost::shared_ptr<LibraryManagerCollection>()));
+    }
+    handles.clear();
+    EXPECT_EQ(CalloutHandlePool::MAX_POOL_SIZE, CalloutHandlePool::size());
+    EXPECT_EQ(create_count, destroy_count);
+}
+
+// Test that a handle released by another thread goes to the pool of
+// this thread and that the pool is destroyed with the thread.
+TEST_F(CalloutHandlePoolTest, threads) {
+    CalloutHandlePtr handle;
+    thread creator([this, &handle]() {
+        handle = CalloutHandlePool::create(manager_,
+            boost::shared_ptr<LibraryManagerCollection>());
+        CalloutHandlePtr other = CalloutHandlePool::create(manager_,
+            boost::shared_ptr<LibraryManagerCollection>());
+        other.reset();
+        EXPECT_EQ(1, CalloutHandlePool::size());
+    });
+    creator.join();
+    EXPECT_EQ(2, create_count);
+    EXPECT_EQ(1, destroy_count);
+
+    // The handle is released by this thread.
+    handle.reset();
+    EXPECT_EQ(2, destroy_count);
+}
+
+} // end of anonymous namespace
@@ -1,4 +1,4 @@
-// Copyright (C) 2013-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2013-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -15,6 +15,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <vector>
+
 using namespace isc::hooks;
 using namespace std;
 
@@ -301,6 +304,90 @@ TEST_F(CalloutHandleTest, DeleteAllArguments) {
     EXPECT_THROW(handle.getArgument("four", value), NoSuchArgument);
 }
 
+// Test that deleted arguments are reused with values of other types.
+
+TEST_F(CalloutHandleTest, ArgumentReuse) {
+    CalloutHandle handle(getCalloutManager());
+
+    handle.setArgument("one", 1);
+    handle.setArgument("two", string("two"));
+    handle.deleteAllArguments();
+    EXPECT_TRUE(handle.getArgumentNames().empty());
+
+    // Set arguments with other names and types.
+    handle.setArgument("zeta", string("zeta"));
+    handle.setArgument("alpha", 2);
+    handle.setArgument("beta", true);
+
+    int int_value = 0;
+    string string_value;
+    bool bool_value = false;
+    EXPECT_THROW(handle.getArgument("one", int_value), NoSuchArgument);
+    EXPECT_THROW(handle.getArgument("two", string_value), NoSuchArgument);
+    ASSERT_NO_THROW(handle.getArgument("zeta", string_value));
+    EXPECT_EQ("zeta", string_value);
+    ASSERT_NO_THROW(handle.getArgument("alpha", int_value));
+    EXPECT_EQ(2, int_value);
+    ASSERT_NO_THROW(handle.getArgument("beta", bool_value));
+    EXPECT_TRUE(bool_value);
+
+    // The names are returned in alphabetical order.
+    vector<string> names = handle.getArgumentNames();
+    ASSERT_EQ(3, names.size());
+    EXPECT_EQ("alpha", names[0]);
+    EXPECT_EQ("beta", names[1]);
+    EXPECT_EQ("zeta", names[2]);
+
+    // Change the type of an argument.
+    handle.setArgument("alpha", string("alpha"));
+    EXPECT_THROW(handle.getArgument("alpha", int_value), boost::bad_any_cast);
+    ASSERT_NO_THROW(handle.getArgument("alpha", string_value));
+    EXPECT_EQ("alpha", string_value);
+
+    // Delete one argument and add a new one.
+    handle.deleteArgument("beta");
+    handle.setArgument("gamma", 3);
+    EXPECT_THROW(handle.getArgument("beta", bool_value), NoSuchArgument);
+    ASSERT_NO_THROW(handle.getArgument("gamma", int_value));
+    EXPECT_EQ(3, int_value);
+    EXPECT_EQ(3, handle.getArgumentNames().size());
+}
+
+// Test that values too large to be stored in place are supported and
+// that the stored shared pointers are released with the arguments.
+
+TEST_F(CalloutHandleTest, ArgumentLargeValues) {
+    CalloutHandle handle(getCalloutManager());
+
+    // A value larger than the in place storage.
+    vector<int> large(64, 0);
+    large[63] = 63;
+    struct Large {
+        char data[128];
+    } large_struct;
+    large_struct.data[127] = 'x';
+    handle.setArgument("vector", large);
+    handle.setArgument("struct", large_struct);
+
+    vector<int> vector_value;
+    ASSERT_NO_THROW(handle.getArgument("vector", vector_value));
+    EXPECT_TRUE(large == vector_value);
+    Large struct_value;
+    ASSERT_NO_THROW(handle.getArgument("struct", struct_value));
+    EXPECT_EQ('x', struct_value.data[127]);
+
+    // Shared pointers are released when the arguments are deleted.
+    boost::shared_ptr<int> ptr(new int(5));
+    handle.setArgument("ptr", ptr);
+    EXPECT_EQ(2, ptr.use_count());
+    handle.setArgument("ptr", boost::shared_ptr<int>(new int(6)));
+    EXPECT_EQ(1, ptr.use_count());
+    handle.setArgument("ptr", ptr);
+    EXPECT_EQ(2, ptr.use_count());
+    handle.deleteAllArguments();
+    EXPECT_EQ(1, ptr.use_count());
+}
+
 // Test the "status" field.
 TEST_F(CalloutHandleTest, StatusField) {
     CalloutHandle handle(getCalloutManager());
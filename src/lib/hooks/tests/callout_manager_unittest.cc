@@ -318,6 +318,68 @@ TEST_F(CalloutManagerTest, CalloutsPresent) {
     EXPECT_THROW(getCalloutManager()->calloutsPresent(-1), NoSuchHook);
 }
 
+// Check that the number of callouts registered on all hooks is maintained
+// when callouts are registered and deregistered.
+
+TEST_F(CalloutManagerTest, AnyCalloutsPresent) {
+    // No callouts are attached to any of the hooks.
+    EXPECT_FALSE(getCalloutManager()->anyCalloutsPresent());
+    EXPECT_EQ(0, getCalloutManager()->getCalloutsCount());
+
+    getCalloutManager()->registerCallout("alpha", callout_one, 1);
+    getCalloutManager()->registerCallout("alpha", callout_two, 1);
+    getCalloutManager()->registerCallout("beta", callout_two, 2);
+    getCalloutManager()->registerCallout("delta", callout_three, 3);
+    getCalloutManager()->registerCallout("delta", callout_four, 3);
+    EXPECT_TRUE(getCalloutManager()->anyCalloutsPresent());
+    EXPECT_EQ(5, getCalloutManager()->getCalloutsCount());
+
+    // Deregister a callout which is not registered.
+    EXPECT_FALSE(getCalloutManager()->deregisterCallout("gamma", callout_one, 1));
+    EXPECT_EQ(5, getCalloutManager()->getCalloutsCount());
+
+    // Deregister a single callout.
+    EXPECT_TRUE(getCalloutManager()->deregisterCallout("alpha", callout_two, 1));
+    EXPECT_EQ(4, getCalloutManager()->getCalloutsCount());
+
+    // Deregister all the callouts of a library on a hook.
+    EXPECT_TRUE(getCalloutManager()->deregisterAllCallouts("delta", 3));
+    EXPECT_EQ(2, getCalloutManager()->getCalloutsCount());
+    EXPECT_TRUE(getCalloutManager()->anyCalloutsPresent());
+
+    // Deregister the remaining callouts.
+    EXPECT_TRUE(getCalloutManager()->deregisterAllCallouts("alpha", 1));
+    EXPECT_TRUE(getCalloutManager()->deregisterAllCallouts("beta", 2));
+    EXPECT_EQ(0, getCalloutManager()->getCalloutsCount());
+    EXPECT_FALSE(getCalloutManager()->anyCalloutsPresent());
+}
+
+// Check that the control command handlers are not counted as callouts
+// registered on the packet hooks.
+
+TEST_F(CalloutManagerTest, AnyCalloutsPresentCommandHandlers) {
+    getCalloutManager()->setLibraryIndex(1);
+    getCalloutManager()->getLibraryHandle().registerCommandCallout("command-one",
+                                                                   callout_one);
+    getCalloutManager()->getLibraryHandle().registerCommandCallout("command-two",
+                                                                   callout_two);
+    EXPECT_TRUE(getCalloutManager()->commandHandlersPresent("command-one"));
+    EXPECT_FALSE(getCalloutManager()->anyCalloutsPresent());
+    EXPECT_EQ(0, getCalloutManager()->getCalloutsCount());
+
+    // A callout on a packet hook is counted.
+    getCalloutManager()->registerCallout("alpha", callout_three, 1);
+    EXPECT_TRUE(getCalloutManager()->anyCalloutsPresent());
+    EXPECT_EQ(1, getCalloutManager()->getCalloutsCount());
+
+    // Deregistering the command handlers does not change the count.
+    EXPECT_TRUE(getCalloutManager()->deregisterAllCallouts(
+                    ServerHooks::commandToHookName("command-one"), 1));
+    EXPECT_EQ(1, getCalloutManager()->getCalloutsCount());
+    EXPECT_TRUE(getCalloutManager()->deregisterAllCallouts("alpha", 1));
+    EXPECT_FALSE(getCalloutManager()->anyCalloutsPresent());
+}
+
 // Test that calling a hook with no callouts on it returns success.
 
 TEST_F(CalloutManagerTest, CallNoCallouts) {
@@ -0,0 +1,71 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+/// @file
+/// @brief Library with control command handlers only
+///
+/// This is source of a test library for the HooksManager tests.  The
+/// characteristics of the library produced from this file are:
+///
+/// - The "version" and "load" framework functions are supplied.
+///
+/// - No callout is registered on a packet hook point. The "load" function
+///   registers two control command handlers for the commands "command-one"
+///   and "command-two".
+
+#include <config.h>
+#include <hooks/hooks.h>
+
+using namespace isc::hooks;
+
+extern "C" {
+
+// First command handler assigns data to a result.
+
+static int
+command_handler_one(CalloutHandle& handle) {
+    int data;
+    handle.getArgument("data_1", data);
+    handle.setArgument("result", data);
+
+    return (0);
+}
+
+// Second command handler multiples the result by data.
+
+static int
+command_handler_two(CalloutHandle& handle) {
+    int data;
+    handle.getArgument("data_2", data);
+
+    int result;
+    handle.getArgument("result", result);
+
+    result *= data;
+    handle.setArgument("result", result);
+
+    return (0);
+}
+
+// Framework functions
+
+int
+version() {
+    return (KEA_HOOKS_VERSION);
+}
+
+int load(LibraryHandle& handle) {
+    // Initialize the user library if the main image was statically linked
+#ifdef USE_STATIC_LINK
+    hooksStaticLinkInit();
+#endif
+    handle.registerCommandCallout("command-one", command_handler_one);
+    handle.registerCommandCallout("command-two", command_handler_two);
+
+    return (0);
+}
+
+};
@@ -655,10 +655,71 @@ TEST_F(HooksManagerTest, NoLibrariesCalloutsPresent) {
     EXPECT_FALSE(HooksManager::calloutsPresent(hookpt_one_index_));
     EXPECT_FALSE(HooksManager::calloutsPresent(hookpt_two_index_));
     EXPECT_FALSE(HooksManager::calloutsPresent(hookpt_three_index_));
+    EXPECT_FALSE(HooksManager::anyCalloutsPresent());
     EXPECT_FALSE(HooksManager::commandHandlersPresent("command-one"));
     EXPECT_FALSE(HooksManager::commandHandlersPresent("command-two"));
 }
 
+// Check that the presence of callouts on any hook follows the registration
+// and the deregistration of the callouts.
+
+TEST_F(HooksManagerTest, AnyCalloutsPresent) {
+    EXPECT_FALSE(HooksManager::anyCalloutsPresent());
+
+    HooksManager::preCalloutsLibraryHandle().registerCallout("hookpt_two",
+                                                             testPreCallout);
+    EXPECT_TRUE(HooksManager::anyCalloutsPresent());
+    EXPECT_FALSE(HooksManager::calloutsPresent(hookpt_one_index_));
+    EXPECT_TRUE(HooksManager::calloutsPresent(hookpt_two_index_));
+
+    EXPECT_TRUE(HooksManager::preCalloutsLibraryHandle().
+                deregisterAllCallouts("hookpt_two"));
+    EXPECT_FALSE(HooksManager::anyCalloutsPresent());
+
+    // Load a library registering callouts.
+    HookLibsCollection library_names;
+    library_names.push_back(make_pair(std::string(FULL_CALLOUT_LIBRARY),
+                                      data::ConstElementPtr()));
+    EXPECT_TRUE(HooksManager::loadLibraries(library_names));
+    EXPECT_TRUE(HooksManager::anyCalloutsPresent());
+
+    // Unloading it removes the callouts.
+    EXPECT_NO_THROW(HooksManager::prepareUnloadLibraries());
+    EXPECT_TRUE(HooksManager::unloadLibraries());
+    EXPECT_FALSE(HooksManager::anyCalloutsPresent());
+}
+
+// Check that the control command handlers are not taken into account
+// when checking if callouts are present on any hook: a library which only
+// provides commands must not cause the creation of a callout handle for
+// each packet.
+
+TEST_F(HooksManagerTest, AnyCalloutsPresentCommandsOnly) {
+    HookLibsCollection library_names;
+    library_names.push_back(make_pair(std::string(COMMAND_CALLOUT_LIBRARY),
+                                      data::ConstElementPtr()));
+    EXPECT_TRUE(HooksManager::loadLibraries(library_names));
+
+    // The command handlers are present but they are not packet callouts.
+    EXPECT_TRUE(HooksManager::commandHandlersPresent("command-one"));
+    EXPECT_TRUE(HooksManager::commandHandlersPresent("command-two"));
+    EXPECT_FALSE(HooksManager::anyCalloutsPresent());
+
+    // Registering a callout on a packet hook point is detected.
+    HooksManager::preCalloutsLibraryHandle().registerCallout("hookpt_one",
+                                                             testPreCallout);
+    EXPECT_TRUE(HooksManager::anyCalloutsPresent());
+    EXPECT_TRUE(HooksManager::preCalloutsLibraryHandle().
+                deregisterAllCallouts("hookpt_one"));
+    EXPECT_FALSE(HooksManager::anyCalloutsPresent());
+
+    // Unloading the library removes the command handlers.
+    EXPECT_NO_THROW(HooksManager::prepareUnloadLibraries());
+    EXPECT_TRUE(HooksManager::unloadLibraries());
+    EXPECT_FALSE(HooksManager::commandHandlersPresent("command-one"));
+    EXPECT_FALSE(HooksManager::anyCalloutsPresent());
+}
+
 TEST_F(HooksManagerTest, NoLibrariesCallCallouts) {
     executeCallCallouts(-1, 3, -1, 22, -1, 83, -1);
 }
@@ -0,0 +1,338 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <log/async_logger.h>
+#include <log/log_formatter.h>
+#include <log/log_messages.h>
+#include <log/logger.h>
+#include <log/logger_impl.h>
+#include <log/macros.h>
+
+#include <chrono>
+
+using namespace std;
+
+namespace {
+
+/// \brief Flag set in the logging thread
+thread_local bool logging_thread = false;
+
+/// \brief Holder of the queue of a thread
+///
+/// The queue is closed when the thread exits so the logging thread
+/// drops it once the remaining messages have been written.
+struct QueueHolder {
+    /// \brief Constructor
+    QueueHolder() : queue_(), generation_(0) {
+    }
+
+    /// \brief Destructor
+    ~QueueHolder() {
+        if (queue_) {
+            queue_->close();
+        }
+    }
+
+    /// \brief Queue of the thread
+    isc::log::AsyncLogQueuePtr queue_;
+
+    /// \brief Generation of the logging thread the queue is registered with
+    uint64_t generation_;
+};
+
+/// \brief Queue of the current thread
+thread_local QueueHolder queue_holder;
+
+/// \brief Maximum time the logging thread sleeps without checking the queues
+const chrono::milliseconds MAX_WAIT(100);
+
+} // end of anonymous namespace
+
+namespace isc {
+namespace log {
+
+AsyncLogQueue::AsyncLogQueue(size_t capacity)
+    : slots_(capacity > 0 ? capacity : 1), head_(0), tail_(0),
+      closed_(false) {
+}
+
+bool
+AsyncLogQueue::push(LoggerImpl* logger, const Severity& severity,
+                    const MessageID& ident, vector<string>& args) {
+    uint64_t tail = tail_.load(memory_order_relaxed);
+    if (tail - head_.load(memory_order_acquire) >= slots_.size()) {
+        return (false);
+    }
+    AsyncLogRecord& record = slots_[tail % slots_.size()];
+    record.logger_ = logger;
+    record.severity_ = severity;
+    record.ident_ = ident;
+    record.args_.swap(args);
+    args.clear();
+    record.timestamp_ = chrono::system_clock::now();
+    // Sequentially consistent store so it is ordered with the check of
+    // the waiting flag of the logging thread.
+    tail_.store(tail + 1);
+    return (true);
+}
+
+bool
+AsyncLogQueue::pop(AsyncLogRecord& record) {
+    uint64_t head = head_.load(memory_order_relaxed);
+    if (head == tail_.load(memory_order_acquire)) {
+        return (false);
+    }
+    AsyncLogRecord& slot = slots_[head % slots_.size()];
+    record.logger_ = slot.logger_;
+    record.severity_ = slot.severity_;
+    record.ident_ = slot.ident_;
+    record.args_.swap(slot.args_);
+    slot.args_.clear();
+    record.timestamp_ = slot.timestamp_;
+    head_.store(head + 1, memory_order_release);
+    return (true);
+}
+
+const size_t AsyncLogger::DEFAULT_QUEUE_CAPACITY;
+
+atomic<bool> AsyncLogger::running_(false);
+
+AsyncLogger&
+AsyncLogger::instance() {
+    static AsyncLogger async_logger;
+    return (async_logger);
+}
+
+AsyncLogger::AsyncLogger()
+    : mutex_(), cv_(), flush_cv_(), thread_(), queues_(), generation_(0),
+      capacity_(DEFAULT_QUEUE_CAPACITY), stopping_(false), waiting_(false),
+      flush_requested_(0), flush_done_(0), dropped_(0), dropped_reported_(0) {
+}
+
+AsyncLogger::~AsyncLogger() {
+    stop();
+}
+
+void
+AsyncLogger::start(size_t capacity) {
+    lock_guard<mutex> lk(mutex_);
+    if (thread_) {
+        return;
+    }
+    capacity_ = (capacity > 0 ? capacity : DEFAULT_QUEUE_CAPACITY);
+    queues_.clear();
+    ++generation_;
+    stopping_ = false;
+    waiting_ = false;
+    flush_done_ = flush_requested_;
+    dropped_reported_ = dropped_;
+    thread_.reset(new thread(&AsyncLogger::run, this));
+    running_ = true;
+}
+
+void
+AsyncLogger::stop() {
+    boost::shared_ptr<thread> worker;
+    {
+        lock_guard<mutex> lk(mutex_);
+        if (!thread_ || stopping_) {
+            return;
+        }
+        // New messages are written synchronously from now.
+        running_ = false;
+        stopping_ = true;
+        worker = thread_;
+        cv_.notify_one();
+    }
+    if (worker->get_id() == this_thread::get_id()) {
+        worker->detach();
+    } else {
+        worker->join();
+    }
+    // Write the messages queued by threads which checked the running
+    // flag just before it was cleared.
+    drain();
+    lock_guard<mutex> lk(mutex_);
+    queues_.clear();
+    thread_.reset();
+    stopping_ = false;
+    flush_cv_.notify_all();
+}
+
+void
+AsyncLogger::flush() {
+    if (!isEnabled()) {
+        return;
+    }
+    unique_lock<mutex> lk(mutex_);
+    if (!thread_ || stopping_) {
+        return;
+    }
+    uint64_t requested = ++flush_requested_;
+    cv_.notify_one();
+    flush_cv_.wait(lk, [this, requested]() {
+        return (!thread_ || (flush_done_ >= requested));
+    });
+}
+
+bool
+AsyncLogger::push(LoggerImpl* logger, const Severity& severity,
+                  const MessageID& ident, vector<string>& args) {
+    if (!running_) {
+        return (false);
+    }
+    if (!getQueue().push(logger, severity, ident, args)) {
+        ++dropped_;
+        return (true);
+    }
+    if (waiting_.exchange(false)) {
+        lock_guard<mutex> lk(mutex_);
+        cv_.notify_one();
+    }
+    return (true);
+}
+
+void
+AsyncLogger::format(string& message, const vector<string>& args) {
+    unsigned placeholder = 0;
+    for (auto const& arg : args) {
+        replacePlaceholder(message, arg, ++placeholder);
+    }
+    checkExcessPlaceholders(message, ++placeholder);
+}
+
+bool
+AsyncLogger::inLoggingThread() {
+    return (logging_thread);
+}
+
+AsyncLogQueue&
+AsyncLogger::getQueue() {
+    uint64_t generation = generation_;
+    if (!queue_holder.queue_ || (queue_holder.generation_ != generation)) {
+        if (queue_holder.queue_) {
+            queue_holder.queue_->close();
+        }
+        queue_holder.queue_.reset(new AsyncLogQueue(capacity_));
+        queue_holder.generation_ = generation;
+        lock_guard<mutex> lk(mutex_);
+        queues_.push_back(queue_holder.queue_);
+    }
+    return (*queue_holder.queue_);
+}
+
+void
+AsyncLogger::run() {
+    logging_thread = true;
+    for (;;) {
+        uint64_t requested;
+        bool stopping;
+        {
+            lock_guard<mutex> lk(mutex_);
+            requested = flush_requested_;
+            stopping = stopping_;
+        }
+        drain();
+        reportDropped();
+
+        unique_lock<mutex> lk(mutex_);
+        if (flush_done_ != requested) {
+            flush_done_ = requested;
+            flush_cv_.notify_all();
+        }
+        if (stopping) {
+            break;
+        }
+        if (stopping_ || (flush_requested_ != flush_done_)) {
+            continue;
+        }
+        // Publish the waiting flag before checking the queues: a producer
+        // either sees the flag and wakes the thread up or pushed its
+        // message before the check.
+        waiting_ = true;
+        bool empty = true;
+        for (auto const& queue : queues_) {
+            if (!queue->empty()) {
+                empty = false;
+                break;
+            }
+        }
+        if (empty) {
+            cv_.wait_for(lk, MAX_WAIT);
+        }
+        waiting_ = false;
+    }
+}
+
+size_t
+AsyncLogger::drain() {
+    vector<AsyncLogQueuePtr> queues;
+    {
+        lock_guard<mutex> lk(mutex_);
+        queues = queues_;
+    }
+    size_t count = 0;
+    AsyncLogRecord record;
+    bool written;
+    do {
+        written = false;
+        for (auto const& queue : queues) {
+            // Bound the number of messages taken from a queue at once so
+            // a busy thread does not delay the messages of the others.
+            for (size_t i = 0; i < queue->getCapacity(); ++i) {
+                if (!queue->pop(record)) {
+                    break;
+                }
+                write(record);
+                written = true;
+                ++count;
+            }
+        }
+    } while (written);
+
+    // Forget the queues of the threads which have exited.
+    lock_guard<mutex> lk(mutex_);
+    for (auto it = queues_.begin(); it != queues_.end(); ) {
+        if ((*it)->isClosed() && (*it)->empty()) {
+            it = queues_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    return (count);
+}
+
+void
+AsyncLogger::write(const AsyncLogRecord& record) {
+    try {
+        string message = *record.logger_->lookupMessage(record.ident_);
+        format(message, record.args_);
+        record.logger_->outputRaw(record.severity_, message,
+                                  record.timestamp_);
+    } catch (...) {
+        // Catch and ignore all exceptions here, as the formatter does.
+    }
+}
+
+void
+AsyncLogger::reportDropped() {
+    uint64_t dropped = dropped_;
+    if (dropped == dropped_reported_) {
+        return;
+    }
+    try {
+        Logger logger("log");
+        LOG_WARN(logger, LOG_ASYNC_DROPPED).arg(dropped - dropped_reported_);
+    } catch (...) {
+        // Nothing can be done if the report itself fails.
+    }
+    dropped_reported_ = dropped;
+}
+
+} // namespace log
+} // namespace isc
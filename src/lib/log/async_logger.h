@@ -0,0 +1,290 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#ifndef ASYNC_LOGGER_H
+#define ASYNC_LOGGER_H
+
+#include <log/logger_level.h>
+#include <log/message_types.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace isc {
+namespace log {
+
+class LoggerImpl;
+
+/// \brief Log message waiting in the asynchronous logging queue
+///
+/// The message is kept unformatted: only the message identifier and the
+/// arguments given to the formatter are stored. The text of the message is
+/// looked up and the placeholders are replaced by the logging thread.
+/// The time the message was queued is kept so the output shows when the
+/// message was logged rather than when it was written.
+struct AsyncLogRecord {
+    /// \brief Constructor
+    AsyncLogRecord()
+        : logger_(0), severity_(NONE), ident_(0), args_(), timestamp_() {
+    }
+
+    /// \brief Logger implementation producing the output
+    LoggerImpl* logger_;
+
+    /// \brief Severity of the message
+    Severity severity_;
+
+    /// \brief Message identifier
+    MessageID ident_;
+
+    /// \brief Arguments replacing the %1, %2... placeholders
+    std::vector<std::string> args_;
+
+    /// \brief Time the message was queued
+    std::chrono::system_clock::time_point timestamp_;
+};
+
+/// \brief Single producer, single consumer ring of log messages
+///
+/// Each thread logging asynchronously owns one queue, so the thread
+/// appends messages without taking any lock. The logging thread is the
+/// only consumer. The capacity is fixed: when the queue is full the
+/// message is not added and the caller counts it as dropped.
+class AsyncLogQueue : public boost::noncopyable {
+public:
+    /// \brief Constructor
+    ///
+    /// \param capacity Maximum number of messages held by the queue.
+    explicit AsyncLogQueue(size_t capacity);
+
+    /// \brief Adds a message at the end of the queue (producer side)
+    ///
+    /// The arguments are swapped into the queue to avoid copying them.
+    /// The message is timestamped with the current time.
+    ///
+    /// \param logger Logger implementation producing the output.
+    /// \param severity Severity of the message.
+    /// \param ident Message identifier.
+    /// \param args Arguments of the message, emptied on success.
+    ///
+    /// \return false if the queue is full, true otherwise.
+    bool push(LoggerImpl* logger, const Severity& severity,
+              const MessageID& ident, std::vector<std::string>& args);
+
+    /// \brief Takes the first message of the queue (consumer side)
+    ///
+    /// \param record Record receiving the message.
+    ///
+    /// \return false if the queue is empty, true otherwise.
+    bool pop(AsyncLogRecord& record);
+
+    /// \brief Checks if the queue is empty
+    bool empty() const {
+        return (head_.load() == tail_.load());
+    }
+
+    /// \brief Returns the queue capacity
+    size_t getCapacity() const {
+        return (slots_.size());
+    }
+
+    /// \brief Marks the queue as closed
+    ///
+    /// Called when the producer thread exits. The consumer drops the queue
+    /// once it has been emptied.
+    void close() {
+        closed_ = true;
+    }
+
+    /// \brief Checks if the queue has been closed
+    bool isClosed() const {
+        return (closed_);
+    }
+
+private:
+    /// \brief Ring of messages
+    std::vector<AsyncLogRecord> slots_;
+
+    /// \brief Number of messages taken by the consumer
+    std::atomic<uint64_t> head_;
+
+    /// \brief Number of messages added by the producer
+    std::atomic<uint64_t> tail_;
+
+    /// \brief Closed flag
+    std::atomic<bool> closed_;
+};
+
+/// \brief Pointer to an asynchronous logging queue
+typedef boost::shared_ptr<AsyncLogQueue> AsyncLogQueuePtr;
+
+/// \brief Asynchronous logging backend
+///
+/// When it is running, the loggers don't format and write messages in the
+/// calling thread. The formatter stores the message identifier and its
+/// arguments in the queue of the calling thread and the logging thread
+/// formats the messages and writes them to the appenders. The threads
+/// logging messages don't wait for the output or for each other.
+///
+/// The queues are bounded: a message which does not fit in the queue is
+/// dropped and counted. The logging thread reports the number of dropped
+/// messages with the LOG_ASYNC_DROPPED message.
+///
+/// The asynchronous logging is enabled at logger initialization when the
+/// KEA_LOGGER_ASYNC environment variable is set to the capacity of the
+/// per thread queues.
+class AsyncLogger : public boost::noncopyable {
+public:
+    /// \brief Default capacity of the per thread queues
+    static const size_t DEFAULT_QUEUE_CAPACITY = 4096;
+
+    /// \brief Returns the asynchronous logger instance
+    static AsyncLogger& instance();
+
+    /// \brief Destructor
+    ///
+    /// Stops the logging thread, writing the pending messages.
+    ~AsyncLogger();
+
+    /// \brief Starts the logging thread
+    ///
+    /// Does nothing if the logging thread is already running.
+    ///
+    /// \param capacity Capacity of the per thread queues.
+    void start(size_t capacity = DEFAULT_QUEUE_CAPACITY);
+
+    /// \brief Stops the logging thread
+    ///
+    /// The pending messages are written before the thread exits. Once
+    /// stopped, the messages are written synchronously again.
+    void stop();
+
+    /// \brief Waits until all messages queued so far have been written
+    ///
+    /// Does nothing when called by the logging thread itself or when the
+    /// logging thread is not running.
+    void flush();
+
+    /// \brief Checks if the messages must be queued
+    ///
+    /// \return true if the logging thread is running and the caller is
+    /// not the logging thread, false otherwise.
+    static bool isEnabled() {
+        return (running_ && !inLoggingThread());
+    }
+
+    /// \brief Queues a message for the logging thread
+    ///
+    /// \param logger Logger implementation producing the output.
+    /// \param severity Severity of the message.
+    /// \param ident Message identifier.
+    /// \param args Arguments of the message.
+    ///
+    /// \return false if the logging thread is not running and the message
+    /// must be written by the caller, true if the message was queued or
+    /// dropped because the queue of the calling thread was full.
+    bool push(LoggerImpl* logger, const Severity& severity,
+              const MessageID& ident, std::vector<std::string>& args);
+
+    /// \brief Returns the total number of dropped messages
+    uint64_t getDroppedCount() const {
+        return (dropped_);
+    }
+
+    /// \brief Replaces the placeholders of a message by its arguments
+    ///
+    /// \param message Text of the message with placeholders.
+    /// \param args Arguments of the message.
+    static void format(std::string& message,
+                       const std::vector<std::string>& args);
+
+private:
+    /// \brief Constructor
+    AsyncLogger();
+
+    /// \brief Checks if the caller is the logging thread
+    static bool inLoggingThread();
+
+    /// \brief Returns the queue of the calling thread
+    ///
+    /// The queue is created and registered on first use.
+    AsyncLogQueue& getQueue();
+
+    /// \brief Body of the logging thread
+    void run();
+
+    /// \brief Writes all queued messages
+    ///
+    /// \return Number of messages written.
+    size_t drain();
+
+    /// \brief Formats and writes a message
+    ///
+    /// \param record Message to be written.
+    void write(const AsyncLogRecord& record);
+
+    /// \brief Logs the number of messages dropped since the last report
+    void reportDropped();
+
+    /// \brief Flag set when the logging thread is running
+    ///
+    /// It is static so as it can be checked at no cost in the loggers
+    /// and safely during the destruction of static objects.
+    static std::atomic<bool> running_;
+
+    /// \brief Protects the members below and the thread wake up
+    std::mutex mutex_;
+
+    /// \brief Wakes up the logging thread
+    std::condition_variable cv_;
+
+    /// \brief Notifies the end of a flush
+    std::condition_variable flush_cv_;
+
+    /// \brief Logging thread
+    boost::shared_ptr<std::thread> thread_;
+
+    /// \brief Registered per thread queues
+    std::vector<AsyncLogQueuePtr> queues_;
+
+    /// \brief Incremented each time the logging thread is started
+    std::atomic<uint64_t> generation_;
+
+    /// \brief Capacity of the per thread queues
+    size_t capacity_;
+
+    /// \brief Flag set when the logging thread is asked to stop
+    std::atomic<bool> stopping_;
+
+    /// \brief Flag set when the logging thread waits for messages
+    std::atomic<bool> waiting_;
+
+    /// \brief Number of the last flush request
+    uint64_t flush_requested_;
+
+    /// \brief Number of the last completed flush request
+    uint64_t flush_done_;
+
+    /// \brief Total number of dropped messages
+    std::atomic<uint64_t> dropped_;
+
+    /// \brief Number of dropped messages already reported
+    uint64_t dropped_reported_;
+};
+
+} // namespace log
+} // namespace isc
+
+#endif // ASYNC_LOGGER_H
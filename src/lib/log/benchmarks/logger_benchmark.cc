@@ -0,0 +1,165 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <log/async_logger.h>
+#include <log/log_messages.h>
+#include <log/logger.h>
+#include <log/logger_manager.h>
+#include <log/logger_specification.h>
+#include <log/macros.h>
+#include <log/output_option.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+using namespace isc::log;
+
+namespace {
+
+/// @brief Name of the logger used by the benchmarks.
+const char* BENCH_LOGGER_NAME = "bench-logger";
+
+/// @brief Capacity of the per thread queues in the asynchronous mode.
+const size_t BENCH_QUEUE_CAPACITY = 65536;
+
+/// @brief Base fixture class for the logging benchmarks.
+///
+/// The benchmarks log an INFO message with two arguments, similar to
+/// the messages logged by the servers for each packet or lease, to a
+/// file. The results are only meaningful when the log library is built
+/// with log4cplus: the message is formatted in the benchmark threads but
+/// written by log4cplus. As the fixture is set up and torn down by each benchmark thread,
+/// the logging is configured by the first thread and reset by the last.
+class LoggerBenchmark : public ::benchmark::Fixture {
+public:
+    /// @brief Constructor.
+    ///
+    /// @param async Use the asynchronous logging when true.
+    explicit LoggerBenchmark(bool async) : async_(async) {
+    }
+
+    /// @brief Setup routine.
+    ///
+    /// Directs the output of the benchmark logger to a file and starts
+    /// the logging thread in the asynchronous mode.
+    void SetUp(::benchmark::State const&) override {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (users_++ > 0) {
+            return;
+        }
+        filename_ = TEST_DATA_BUILDDIR "/kea-logger-bench.log";
+        static_cast<void>(remove(filename_.c_str()));
+
+        OutputOption option;
+        option.destination = OutputOption::DEST_FILE;
+        option.filename = filename_;
+        LoggerSpecification spec(BENCH_LOGGER_NAME, INFO);
+        spec.addOutputOption(option);
+        LoggerManager manager;
+        manager.process(spec);
+
+        if (async_) {
+            AsyncLogger::instance().start(BENCH_QUEUE_CAPACITY);
+        }
+        dropped_ = AsyncLogger::instance().getDroppedCount();
+    }
+
+    void SetUp(::benchmark::State& s) override {
+        ::benchmark::State const& cs = s;
+        SetUp(cs);
+    }
+
+    /// @brief Cleans up after the test.
+    ///
+    /// Writes the pending messages, reports the number of dropped
+    /// messages and restores the default logging.
+    void TearDown(::benchmark::State& state) override {
+        std::lock_guard<std::mutex> lk(mutex_);
+        if (--users_ > 0) {
+            return;
+        }
+        AsyncLogger::instance().stop();
+        state.counters["dropped"] =
+            AsyncLogger::instance().getDroppedCount() - dropped_;
+        LoggerManager::reset();
+        static_cast<void>(remove(filename_.c_str()));
+    }
+
+    /// @brief Logs messages until the benchmark ends.
+    ///
+    /// @param state Benchmark state.
+    void logMessages(::benchmark::State& state) {
+        Logger logger(BENCH_LOGGER_NAME);
+        const std::string file = "/var/lib/kea/kea-leases4.csv";
+        const std::string error = "Resource temporarily unavailable";
+        for (auto _ : state) {
+            LOG_INFO(logger, LOG_READ_ERROR)
+                .arg(file)
+                .arg(error);
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+private:
+    /// @brief Use the asynchronous logging.
+    bool async_;
+
+    /// @brief Protects the members below.
+    static std::mutex mutex_;
+
+    /// @brief Number of benchmark threads using the fixture.
+    static size_t users_;
+
+    /// @brief Name of the log file.
+    static std::string filename_;
+
+    /// @brief Dropped messages count when the benchmark started.
+    static uint64_t dropped_;
+};
+
+std::mutex LoggerBenchmark::mutex_;
+size_t LoggerBenchmark::users_ = 0;
+std::string LoggerBenchmark::filename_;
+uint64_t LoggerBenchmark::dropped_ = 0;
+
+/// @brief Fixture class for the synchronous logging.
+class SyncLoggerBenchmark : public LoggerBenchmark {
+public:
+    SyncLoggerBenchmark() : LoggerBenchmark(false) {
+    }
+};
+
+/// @brief Fixture class for the asynchronous logging.
+class AsyncLoggerBenchmark : public LoggerBenchmark {
+public:
+    AsyncLoggerBenchmark() : LoggerBenchmark(true) {
+    }
+};
+
+/// Defines steps necessary for conducting a benchmark that measures
+/// messages logged per second when writing them in the calling threads.
+BENCHMARK_DEFINE_F(SyncLoggerBenchmark, logInfo)(benchmark::State& state) {
+    logMessages(state);
+}
+
+/// Defines steps necessary for conducting a benchmark that measures
+/// messages logged per second when queuing them for the logging thread.
+BENCHMARK_DEFINE_F(AsyncLoggerBenchmark, logInfo)(benchmark::State& state) {
+    logMessages(state);
+}
+
+/// Run with 1 and 16 logging threads.
+BENCHMARK_REGISTER_F(SyncLoggerBenchmark, logInfo)
+    ->Threads(1)->Threads(16)->UseRealTime();
+BENCHMARK_REGISTER_F(AsyncLoggerBenchmark, logInfo)
+    ->Threads(1)->Threads(16)->UseRealTime();
+
+} // end of anonymous namespace
@@ -1,4 +1,4 @@
-// Copyright (C) 2011-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2011-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -10,9 +10,11 @@
 #include <cstddef>
 #include <string>
 #include <iostream>
+#include <vector>
 
 #include <exceptions/exceptions.h>
 #include <log/logger_level.h>
+#include <log/message_types.h>
 
 #include <boost/make_shared.hpp>
 #include <boost/shared_ptr.hpp>
@@ -102,6 +104,11 @@ replacePlaceholder(std::string& message, const std::string& replacement,
 /// destroyed before any call to .arg, producing an output, and then the one
 /// the .arg calls are called on would get destroyed as well, producing output
 /// again. So, think of this behavior as soul moving from one to another.
+///
+/// When the asynchronous logging is enabled the formatter is created in the
+/// deferred mode: it keeps the message identifier and collects the
+/// arguments converted to strings, and the logger queues them for the
+/// logging thread which replaces the placeholders.
 template<class Logger> class Formatter {
 private:
     /// \brief The logger we will use to output the final message.
@@ -118,6 +125,11 @@ private:
     /// \brief Which will be the next placeholder to replace
     unsigned nextPlaceholder_;
 
+    /// \brief Message identifier in the deferred mode, NULL otherwise
+    MessageID ident_;
+
+    /// \brief Arguments collected in the deferred mode
+    std::vector<std::string> args_;
 
 public:
     /// \brief Constructor of "active" formatter
@@ -138,7 +150,24 @@ public:
               boost::shared_ptr<std::string> message = boost::make_shared<std::string>(),
               Logger* logger = NULL) :
         logger_(logger), severity_(severity), message_(message),
-        nextPlaceholder_(0) {
+        nextPlaceholder_(0), ident_(NULL), args_() {
+    }
+
+    /// \brief Constructor of "active" deferred formatter
+    ///
+    /// This will create a formatter which does not replace the placeholders
+    /// but collects the arguments. The message is passed by its identifier
+    /// to the logger which looks it up and formats it later.
+    ///
+    /// It is not expected to be called by user of logging system directly.
+    ///
+    /// \param severity The severity of the message (DEBUG, ERROR etc.)
+    /// \param ident The message identifier. Must not be NULL.
+    /// \param logger The logger where the final output will go.
+    Formatter(const Severity& severity, const MessageID& ident,
+              Logger* logger) :
+        logger_(logger), severity_(severity), message_(),
+        nextPlaceholder_(0), ident_(ident), args_() {
     }
 
     /// \brief Copy constructor
@@ -148,7 +177,11 @@ public:
     /// object being copied relinquishes that responsibility.
     Formatter(const Formatter& other) :
         logger_(other.logger_), severity_(other.severity_),
-        message_(other.message_), nextPlaceholder_(other.nextPlaceholder_) {
+        message_(other.message_), nextPlaceholder_(other.nextPlaceholder_),
+        ident_(other.ident_), args_() {
+        // The original formatter is deactivated so its arguments can be
+        // taken over instead of being copied.
+        args_.swap(const_cast<Formatter&>(other).args_);
         other.logger_ = NULL;
     }
 
@@ -158,6 +191,10 @@ public:
     ~Formatter() {
         if (logger_) {
             try {
+                if (ident_) {
+                    logger_->outputDeferred(severity_, ident_, args_);
+                    return;
+                }
                 checkExcessPlaceholders(*message_, ++nextPlaceholder_);
                 logger_->output(severity_, *message_);
             } catch (...) {
@@ -176,6 +213,8 @@ public:
             severity_ = other.severity_;
             message_ = other.message_;
             nextPlaceholder_ = other.nextPlaceholder_;
+            ident_ = other.ident_;
+            args_.swap(const_cast<Formatter&>(other).args_);
             other.logger_ = NULL;
         }
 
@@ -229,6 +268,10 @@ public:
             // .arg(42).arg("%1") would return "42 %1" - there are no recursive
             // replacements).
             try {
+                if (ident_) {
+                    args_.push_back(arg);
+                    return (*this);
+                }
                 replacePlaceholder(*message_, arg, ++nextPlaceholder_);
             } catch (...) {
                 // Something went wrong here, the log message is broken, so
@@ -252,6 +295,7 @@ public:
     void deactivate() {
         if (logger_) {
             message_.reset();
+            args_.clear();
             logger_ = NULL;
         }
     }
@@ -1,4 +1,4 @@
-// Copyright (C) 2011-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2011-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -9,6 +9,7 @@
 #include <stdarg.h>
 #include <stdio.h>
 
+#include <log/async_logger.h>
 #include <log/logger.h>
 #include <log/logger_impl.h>
 #include <log/logger_name.h>
@@ -49,6 +50,11 @@ Logger::initLoggerImpl() {
 // Destructor.
 
 Logger::~Logger() {
+    // Messages waiting in the asynchronous logging queues may refer to
+    // the implementation which is about to be deleted.
+    if (loggerptr_ && AsyncLogger::isEnabled()) {
+        AsyncLogger::instance().flush();
+    }
     delete loggerptr_;
 
     // The next statement is required for the Kea hooks framework, where a
@@ -147,11 +153,30 @@ Logger::output(const Severity& severity, const std::string& message) {
     getLoggerPtr()->outputRaw(severity, message);
 }
 
+void
+Logger::outputDeferred(const Severity& severity, const MessageID& ident,
+                       std::vector<std::string>& args) {
+    LoggerImpl* impl = getLoggerPtr();
+    if (!AsyncLogger::instance().push(impl, severity, ident, args)) {
+        // The logging thread was stopped meanwhile.
+        std::string message = *impl->lookupMessage(ident);
+        AsyncLogger::format(message, args);
+        impl->outputRaw(severity, message);
+    }
+}
+
+Logger::Formatter
+Logger::createFormatter(const Severity& severity, const MessageID& ident) {
+    if (AsyncLogger::isEnabled()) {
+        return (Formatter(severity, ident, this));
+    }
+    return (Formatter(severity, getLoggerPtr()->lookupMessage(ident), this));
+}
+
 Logger::Formatter
 Logger::debug(int dbglevel, const isc::log::MessageID& ident) {
     if (isDebugEnabled(dbglevel)) {
-        return (Formatter(DEBUG, getLoggerPtr()->lookupMessage(ident),
-                          this));
+        return (createFormatter(DEBUG, ident));
     } else {
         return (Formatter());
     }
@@ -160,8 +185,7 @@ Logger::debug(int dbglevel, const isc::log::MessageID& ident) {
 Logger::Formatter
 Logger::info(const isc::log::MessageID& ident) {
     if (isInfoEnabled()) {
-        return (Formatter(INFO, getLoggerPtr()->lookupMessage(ident),
-                          this));
+        return (createFormatter(INFO, ident));
     } else {
         return (Formatter());
     }
@@ -170,8 +194,7 @@ Logger::info(const isc::log::MessageID& ident) {
 Logger::Formatter
 Logger::warn(const isc::log::MessageID& ident) {
     if (isWarnEnabled()) {
-        return (Formatter(WARN, getLoggerPtr()->lookupMessage(ident),
-                          this));
+        return (createFormatter(WARN, ident));
     } else {
         return (Formatter());
     }
@@ -180,8 +203,7 @@ Logger::warn(const isc::log::MessageID& ident) {
 Logger::Formatter
 Logger::error(const isc::log::MessageID& ident) {
     if (isErrorEnabled()) {
-        return (Formatter(ERROR, getLoggerPtr()->lookupMessage(ident),
-                          this));
+        return (createFormatter(ERROR, ident));
     } else {
         return (Formatter());
     }
@@ -190,8 +212,7 @@ Logger::error(const isc::log::MessageID& ident) {
 Logger::Formatter
 Logger::fatal(const isc::log::MessageID& ident) {
     if (isFatalEnabled()) {
-        return (Formatter(FATAL, getLoggerPtr()->lookupMessage(ident),
-                          this));
+        return (createFormatter(FATAL, ident));
     } else {
         return (Formatter());
     }
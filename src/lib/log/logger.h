@@ -12,6 +12,7 @@
 #include <cstring>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include <exceptions/exceptions.h>
 #include <log/logger_level.h>
@@ -312,6 +313,28 @@ private:
     /// \param message Text of the message to be output.
     void output(const Severity& severity, const std::string& message);
 
+    /// \brief Deferred output function
+    ///
+    /// This is used by the formatter in the deferred mode to queue the
+    /// message for the asynchronous logging thread. If that thread is not
+    /// running anymore the message is formatted and output immediately.
+    ///
+    /// \param severity Severity of the message being output.
+    /// \param ident Message identification.
+    /// \param args Arguments of the message, they may be swapped out.
+    void outputDeferred(const Severity& severity, const MessageID& ident,
+                        std::vector<std::string>& args);
+
+    /// \brief Creates an active formatter
+    ///
+    /// The formatter is created in the deferred mode when the asynchronous
+    /// logging is enabled.
+    ///
+    /// \param severity Severity of the message.
+    /// \param ident Message identification.
+    Formatter createFormatter(const Severity& severity,
+                              const MessageID& ident);
+
     /// \brief Copy Constructor
     ///
     /// Disabled (marked private) as it makes no sense to copy the logger -
@@ -1,4 +1,4 @@
-// Copyright (C) 2011-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2011-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -8,6 +8,7 @@
 
 
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
@@ -23,6 +24,7 @@
 #include <log4cplus/version.h>
 #include <log4cplus/configurator.h>
 #include <log4cplus/loggingmacros.h>
+#include <log4cplus/spi/loggingevent.h>
 
 #include <log/logger.h>
 #include <log/logger_impl.h>
@@ -46,6 +48,40 @@ using namespace std;
 namespace isc {
 namespace log {
 
+namespace {
+
+/// @brief Logging event with a given time
+///
+/// log4cplus timestamps the events when they are created: this event
+/// replaces the timestamp by the time the message was logged.
+class TimedLoggingEvent : public log4cplus::spi::InternalLoggingEvent {
+public:
+    /// @brief Constructor
+    ///
+    /// @param logger Name of the logger.
+    /// @param level Level of the message.
+    /// @param message Text of the message.
+    /// @param time Time of the message.
+    TimedLoggingEvent(const log4cplus::tstring& logger,
+                      log4cplus::LogLevel level,
+                      const log4cplus::tstring& message,
+                      const chrono::system_clock::time_point& time)
+        : log4cplus::spi::InternalLoggingEvent(logger, level, message,
+                                               __FILE__, __LINE__) {
+#if LOG4CPLUS_VERSION < LOG4CPLUS_MAKE_VERSION(2, 0, 0)
+        const int64_t usecs = chrono::duration_cast<chrono::microseconds>(
+            time.time_since_epoch()).count();
+        timestamp = log4cplus::helpers::Time(usecs / 1000000,
+                                             usecs % 1000000);
+#else
+        timestamp = chrono::time_point_cast<
+            log4cplus::helpers::Time::duration>(time);
+#endif
+    }
+};
+
+} // end of anonymous namespace
+
 /// @brief detects whether file locking is enabled or disabled
 ///
 /// The lockfile is enabled by default. The only way to disable it is to
@@ -198,5 +234,55 @@ LoggerImpl::outputRaw(const Severity& severity, const string& message) {
     }
 }
 
+void
+LoggerImpl::outputRaw(const Severity& severity, const string& message,
+                      const chrono::system_clock::time_point& timestamp) {
+    log4cplus::LogLevel level;
+    switch (severity) {
+        case DEBUG:
+            level = log4cplus::DEBUG_LOG_LEVEL;
+            break;
+
+        case INFO:
+            level = log4cplus::INFO_LOG_LEVEL;
+            break;
+
+        case WARN:
+            level = log4cplus::WARN_LOG_LEVEL;
+            break;
+
+        case ERROR:
+            level = log4cplus::ERROR_LOG_LEVEL;
+            break;
+
+        case FATAL:
+            level = log4cplus::FATAL_LOG_LEVEL;
+            break;
+
+        default:
+            // Nothing to timestamp: report as the untimed variant does.
+            outputRaw(severity, message);
+            return;
+    }
+
+    // Same locking as the untimed variant.
+    std::lock_guard<std::mutex> mutex_locker(LoggerManager::getMutex());
+    interprocess::InterprocessSyncLocker locker(*sync_);
+
+    if (!locker.lock()) {
+        LOG4CPLUS_ERROR(logger_, "Unable to lock logger lockfile");
+    }
+
+    // The check done by the LOG4CPLUS_XXX macros.
+    if (logger_.isEnabledFor(level)) {
+        logger_.forcedLog(TimedLoggingEvent(logger_.getName(), level,
+                                            message, timestamp));
+    }
+
+    if (!locker.unlock()) {
+        LOG4CPLUS_ERROR(logger_, "Unable to unlock logger lockfile");
+    }
+}
+
 } // namespace log
 } // namespace isc
@@ -1,4 +1,4 @@
-// Copyright (C) 2011-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2011-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -10,6 +10,7 @@
 #include <stdarg.h>
 #include <time.h>
 
+#include <chrono>
 #include <iostream>
 #include <cstdlib>
 #include <string>
@@ -161,6 +162,18 @@ public:
     /// \param message Text of the message.
     void outputRaw(const Severity& severity, const std::string& message);
 
+    /// \brief Raw output with a given time
+    ///
+    /// Writes the message into the log with the given time instead of the
+    /// current time. Used by the asynchronous logging thread so the output
+    /// shows the time the message was queued.
+    ///
+    /// \param severity Severity of the message.
+    /// \param message Text of the message.
+    /// \param timestamp Time of the message.
+    void outputRaw(const Severity& severity, const std::string& message,
+                   const std::chrono::system_clock::time_point& timestamp);
+
     /// \brief Look up message text in dictionary
     ///
     /// This gets you the unformatted text of message for given ID.
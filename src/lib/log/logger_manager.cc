@@ -7,8 +7,10 @@
 #include <config.h>
 
 #include <algorithm>
+#include <cstdlib>
 #include <vector>
 
+#include <log/async_logger.h>
 #include <log/logger.h>
 #include <log/logger_manager.h>
 #include <log/logger_manager_impl.h>
@@ -78,6 +80,8 @@ LoggerManager::~LoggerManager() {
 // Initialize processing
 void
 LoggerManager::processInit() {
+    // Write the queued messages with the current destinations.
+    AsyncLogger::instance().flush();
     impl_->processInit();
 }
 
@@ -134,6 +138,21 @@ LoggerManager::init(const std::string& root, isc::log::Severity severity,
 
     // Ensure that the mutex is constructed and ready at this point.
     (void) getMutex();
+
+    // Start the asynchronous logging when the size of the per thread
+    // queues is given in the environment.
+    const char* async = getenv("KEA_LOGGER_ASYNC");
+    if (async) {
+        size_t capacity = 0;
+        try {
+            capacity = boost::lexical_cast<size_t>(async);
+        } catch (const boost::bad_lexical_cast&) {
+            // Not a number: keep the synchronous logging.
+        }
+        if (capacity > 0) {
+            AsyncLogger::instance().start(capacity);
+        }
+    }
 }
 
 void
@@ -0,0 +1,125 @@
+// Copyright (C) 2021 Internet Systems Consortium, Inc. ("ISC")
+//
+// This Source Code Form is subject to the terms of the Mozilla Public
+// License, v. 2.0. If a copy of the MPL was not distributed with this
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.
+
+#include <config.h>
+
+#include <log/async_logger.h>
+#include <log/log_formatter.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace isc::log;
+using namespace std;
+
+namespace {
+
+// Check that the placeholders are replaced as the formatter does.
+TEST(AsyncLoggerTest, format) {
+    string message = "%1 and %2";
+    vector<string> args;
+    args.push_back("%2");
+    args.push_back("42");
+    AsyncLogger::format(message, args);
+    // Same sequential replacement as Formatter::arg().
+    EXPECT_EQ("42 and 42", message);
+}
+
+// Check that the excess placeholders are reported as by the formatter.
+TEST(AsyncLoggerTest, formatExcessPlaceholders) {
+    string expected = "%1 %2";
+    checkExcessPlaceholders(expected, 2);
+
+    string message = "%1 %2";
+    vector<string> args(1, "%1");
+    AsyncLogger::format(message, args);
+    EXPECT_EQ(expected, message);
+}
+
+// Check the order of the messages and the capacity of the queue.
+TEST(AsyncLoggerTest, queue) {
+    AsyncLogQueue queue(2);
+    EXPECT_EQ(2, queue.getCapacity());
+    EXPECT_TRUE(queue.empty());
+
+    vector<string> args(1, "first");
+    EXPECT_TRUE(queue.push(0, INFO, "ID1", args));
+    // The arguments are moved into the queue.
+    EXPECT_TRUE(args.empty());
+    args.push_back("second");
+    EXPECT_TRUE(queue.push(0, WARN, "ID2", args));
+    args.push_back("third");
+    EXPECT_FALSE(queue.push(0, ERROR, "ID3", args));
+    // The arguments of the rejected message are left to the caller.
+    ASSERT_EQ(1, args.size());
+    EXPECT_FALSE(queue.empty());
+
+    AsyncLogRecord record;
+    ASSERT_TRUE(queue.pop(record));
+    EXPECT_EQ(INFO, record.severity_);
+    EXPECT_EQ(string("ID1"), record.ident_);
+    ASSERT_EQ(1, record.args_.size());
+    EXPECT_EQ("first", record.args_[0]);
+
+    // There is room again.
+    EXPECT_TRUE(queue.push(0, ERROR, "ID3", args));
+
+    ASSERT_TRUE(queue.pop(record));
+    EXPECT_EQ(string("ID2"), record.ident_);
+    ASSERT_TRUE(queue.pop(record));
+    EXPECT_EQ(string("ID3"), record.ident_);
+    EXPECT_FALSE(queue.pop(record));
+    EXPECT_TRUE(queue.empty());
+}
+
+// Check that the messages are timestamped when they are queued.
+TEST(AsyncLoggerTest, queueTimestamp) {
+    AsyncLogQueue queue(2);
+    vector<string> args;
+
+    auto before = chrono::system_clock::now();
+    EXPECT_TRUE(queue.push(0, INFO, "ID1", args));
+    auto after = chrono::system_clock::now();
+
+    // The message is written later: it keeps the time it was queued.
+    this_thread::sleep_for(chrono::milliseconds(10));
+    AsyncLogRecord record;
+    ASSERT_TRUE(queue.pop(record));
+    EXPECT_LE(before, record.timestamp_);
+    EXPECT_GE(after, record.timestamp_);
+}
+
+// Check that the logging thread can be started and stopped.
+TEST(AsyncLoggerTest, startStop) {
+    AsyncLogger& async_logger = AsyncLogger::instance();
+    EXPECT_FALSE(AsyncLogger::isEnabled());
+    // Flush does nothing when the logging thread is not running.
+    EXPECT_NO_THROW(async_logger.flush());
+
+    vector<string> args;
+    EXPECT_FALSE(async_logger.push(0, INFO, "ID", args));
+
+    EXPECT_NO_THROW(async_logger.start(16));
+    EXPECT_TRUE(AsyncLogger::isEnabled());
+    // A second start does nothing.
+    EXPECT_NO_THROW(async_logger.start(16));
+    EXPECT_NO_THROW(async_logger.flush());
+
+    EXPECT_NO_THROW(async_logger.stop());
+    EXPECT_FALSE(AsyncLogger::isEnabled());
+    EXPECT_NO_THROW(async_logger.stop());
+
+    // It can be restarted.
+    EXPECT_NO_THROW(async_logger.start(16));
+    EXPECT_TRUE(AsyncLogger::isEnabled());
+    EXPECT_NO_THROW(async_logger.stop());
+}
+
+} // end of anonymous namespace
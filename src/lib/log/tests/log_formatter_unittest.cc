@@ -1,4 +1,4 @@
-// Copyright (C) 2011-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2011-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -25,10 +25,17 @@ protected:
     typedef pair<isc::log::Severity, string> Output;
     typedef isc::log::Formatter<FormatterTest> Formatter;
     vector<Output> outputs;
+    typedef pair<isc::log::MessageID, vector<string> > Deferred;
+    vector<Deferred> deferred;
 public:
     void output(const isc::log::Severity& prefix, const string& message) {
         outputs.push_back(Output(prefix, message));
     }
+    void outputDeferred(const isc::log::Severity&,
+                        const isc::log::MessageID& ident,
+                        vector<string>& args) {
+        deferred.push_back(Deferred(ident, args));
+    }
     // Just shortcut for new string
     boost::shared_ptr<string> s(const char* text) {
         return (boost::make_shared<string>(text));
@@ -50,6 +57,26 @@ TEST_F(FormatterTest, active) {
     EXPECT_EQ("Text of message", outputs[0].second);
 }
 
+// Create a deferred formatter and check it collects the arguments
+// instead of replacing the placeholders.
+TEST_F(FormatterTest, deferred) {
+    Formatter(isc::log::INFO, isc::log::MessageID("TEST_ID"), this).
+        arg("Hello").arg(42);
+    EXPECT_EQ(0, outputs.size());
+    ASSERT_EQ(1, deferred.size());
+    EXPECT_EQ(string("TEST_ID"), deferred[0].first);
+    ASSERT_EQ(2, deferred[0].second.size());
+    EXPECT_EQ("Hello", deferred[0].second[0]);
+    EXPECT_EQ("42", deferred[0].second[1]);
+}
+
+// A deactivated deferred formatter produces nothing
+TEST_F(FormatterTest, deferredDeactivate) {
+    Formatter(isc::log::INFO, isc::log::MessageID("TEST_ID"), this).
+        arg("Hello").deactivate();
+    EXPECT_EQ(0, deferred.size());
+}
+
 // No output even when we have an arg on the inactive formatter
 TEST_F(FormatterTest, inactiveArg) {
     Formatter().arg("Hello");
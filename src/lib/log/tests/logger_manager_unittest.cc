@@ -1,4 +1,4 @@
-// Copyright (C) 2011-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2011-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -20,6 +20,7 @@
 
 #include <exceptions/exceptions.h>
 
+#include <log/async_logger.h>
 #include <log/macros.h>
 #include <log/log_messages.h>
 #include <log/logger.h>
@@ -34,6 +35,8 @@
 #include <sys/types.h>
 #include <regex.h>
 
+#include <thread>
+
 using namespace isc;
 using namespace isc::log;
 using namespace std;
@@ -239,6 +242,52 @@ TEST_F(LoggerManagerTest, FileLogger) {
     checkFileContents(file_spec.getFileName(), ids.begin(), ids.end());
 }
 
+// Check that the messages logged asynchronously reach the file in the
+// order they were logged by a thread.
+TEST_F(LoggerManagerTest, AsyncFileLogger) {
+    SpecificationForFileLogger file_spec;
+    static_cast<void>(remove(file_spec.getFileName().c_str()));
+
+    LoggerManager manager;
+    manager.process(file_spec.getSpecification());
+
+    AsyncLogger& async_logger = AsyncLogger::instance();
+    async_logger.start();
+    EXPECT_TRUE(AsyncLogger::isEnabled());
+
+    vector<MessageID> ids;
+    {
+        Logger logger(file_spec.getLoggerName().c_str());
+
+        // Log from another thread: its queue is dropped when it exits
+        // but the messages must still be written.
+        thread producer([&logger]() {
+            LOG_FATAL(logger, LOG_DUPLICATE_MESSAGE_ID).arg("test");
+            LOG_FATAL(logger, LOG_DUPLICATE_NAMESPACE).arg("test");
+        });
+        producer.join();
+        ids.push_back(LOG_DUPLICATE_MESSAGE_ID);
+        ids.push_back(LOG_DUPLICATE_NAMESPACE);
+
+        // Make sure the messages of the other thread come first.
+        async_logger.flush();
+
+        LOG_FATAL(logger, LOG_INVALID_MESSAGE_ID).arg("test").arg("test2");
+        ids.push_back(LOG_INVALID_MESSAGE_ID);
+
+        LOG_FATAL(logger, LOG_NO_MESSAGE_ID).arg("42");
+        ids.push_back(LOG_NO_MESSAGE_ID);
+
+        // The logger destructor waits for the pending messages.
+    }
+    async_logger.stop();
+    EXPECT_FALSE(AsyncLogger::isEnabled());
+    EXPECT_EQ(0, async_logger.getDroppedCount());
+
+    LoggerManager::reset();
+    checkFileContents(file_spec.getFileName(), ids.begin(), ids.end());
+}
+
 // Check if the file rolls over when it gets above a certain size.
 TEST_F(LoggerManagerTest, FileSizeRollover) {
     // Set to a suitable minimum that log4cplus can copy with
@@ -116,6 +116,109 @@ PgSqlTransaction::commit() {
     committed_ = true;
 }
 
+const size_t PgSqlPipeline::MAX_DEPTH = 64;
+
+PgSqlPipeline::PgSqlPipeline(PgSqlConnection& conn)
+    : conn_(conn), pipelined_(false), pending_(0), results_() {
+    conn_.checkUnusable();
+#ifdef LIBPQ_HAS_PIPELINING
+    pipelined_ = (PQenterPipelineMode(conn_) == 1);
+#endif
+}
+
+PgSqlPipeline::~PgSqlPipeline() {
+#ifdef LIBPQ_HAS_PIPELINING
+    if (pipelined_) {
+        try {
+            sync();
+        } catch (...) {
+            // Nothing to do: the results are discarded anyway.
+        }
+        PQexitPipelineMode(conn_);
+    }
+#endif
+}
+
+void
+PgSqlPipeline::send(const PgSqlTaggedStatement& statement,
+                    const PsqlBindArray& bind_array,
+                    const int result_format) {
+#ifdef LIBPQ_HAS_PIPELINING
+    if (pipelined_) {
+        if (PQsendQueryPrepared(conn_, statement.name, statement.nbparams,
+                                &bind_array.values_[0],
+                                &bind_array.lengths_[0],
+                                &bind_array.formats_[0],
+                                result_format) != 1) {
+            // Keep the results in order: the null result is reported
+            // as a fatal error by checkStatementError.
+            sync();
+            results_.push_back(PgSqlResultPtr(new PgSqlResult(NULL)));
+            return;
+        }
+        if (++pending_ >= MAX_DEPTH) {
+            sync();
+        }
+        return;
+    }
+#endif
+    results_.push_back(PgSqlResultPtr(new PgSqlResult(
+        PQexecPrepared(conn_, statement.name, statement.nbparams,
+                       &bind_array.values_[0], &bind_array.lengths_[0],
+                       &bind_array.formats_[0], result_format))));
+}
+
+PgSqlResultPtr
+PgSqlPipeline::getResult() {
+    if (results_.empty()) {
+        sync();
+    }
+    if (results_.empty()) {
+        isc_throw(DbOperationError, "no pending statement in the pipeline");
+    }
+    PgSqlResultPtr r = results_.front();
+    results_.pop_front();
+#ifdef LIBPQ_HAS_PIPELINING
+    if (PQresultStatus(*r) == PGRES_PIPELINE_ABORTED) {
+        isc_throw(DbOperationError, "statement skipped after a previous "
+                  "error in the pipeline");
+    }
+#endif
+    return (r);
+}
+
+void
+PgSqlPipeline::sync() {
+#ifdef LIBPQ_HAS_PIPELINING
+    if (!pending_) {
+        return;
+    }
+    size_t pending = pending_;
+    pending_ = 0;
+    if (PQpipelineSync(conn_) != 1) {
+        for (; pending > 0; --pending) {
+            results_.push_back(PgSqlResultPtr(new PgSqlResult(NULL)));
+        }
+        return;
+    }
+    for (; pending > 0; --pending) {
+        PGresult* r = PQgetResult(conn_);
+        results_.push_back(PgSqlResultPtr(new PgSqlResult(r)));
+        // The result of each statement is followed by a null result.
+        if (r) {
+            while (PGresult* extra = PQgetResult(conn_)) {
+                PQclear(extra);
+            }
+        }
+    }
+    // Consume the synchronization point.
+    PGresult* r = PQgetResult(conn_);
+    if (r) {
+        PQclear(r);
+    }
+#endif
+}
+
 PgSqlConnection::~PgSqlConnection() {
     if (conn_) {
         // Deallocate the prepared queries.
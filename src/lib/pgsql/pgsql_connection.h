@@ -11,7 +11,9 @@
 
 #include <libpq-fe.h>
 #include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
 
+#include <deque>
 #include <vector>
 #include <stdint.h>
 
@@ -166,6 +168,9 @@ private:
     int cols_;   ///< Number of columns in the result set
 };
 
+/// @brief Defines a pointer to a PgSqlResult
+typedef boost::shared_ptr<PgSqlResult> PgSqlResultPtr;
+
 
 /// @brief Postgresql connection handle Holder
 ///
@@ -232,6 +237,9 @@ private:
 /// @brief Forward declaration to @ref PgSqlConnection.
 class PgSqlConnection;
 
+/// @brief Forward declaration to @ref PsqlBindArray.
+struct PsqlBindArray;
+
 /// @brief RAII object representing a PostgreSQL transaction.
 ///
 /// An instance of this class should be created in a scope where multiple
@@ -290,6 +298,95 @@ private:
     bool committed_;
 };
 
+/// @brief RAII object sending a series of prepared statements in a
+/// PostgreSQL pipeline.
+///
+/// In pipeline mode the statements are sent without waiting for the
+/// results of the previous ones, which saves a round trip to the server
+/// per statement. The results are fetched afterwards in the order the
+/// statements were sent. The pipeline mode is entered by the constructor
+/// and left by the destructor, so the instance must be destroyed before
+/// the connection is used for anything else, e.g. before committing a
+/// @ref PgSqlTransaction.
+///
+/// After an error the server skips the remaining statements up to the
+/// next synchronization point, so the pipeline should be used within a
+/// transaction which is rolled back when a result reports an error.
+///
+/// When the client library does not support pipelining (before
+/// PostgreSQL 14) the statements are executed when they are sent.
+class PgSqlPipeline : public boost::noncopyable {
+public:
+
+    /// @brief Maximum number of statements sent before the results are
+    /// read.
+    ///
+    /// The connection is in blocking mode so the results must be read
+    /// before the server output buffers fill up.
+    static const size_t MAX_DEPTH;
+
+    /// @brief Constructor.
+    ///
+    /// Enters the pipeline mode.
+    ///
+    /// @param conn PostgreSQL connection to use for the pipeline.
+    PgSqlPipeline(PgSqlConnection& conn);
+
+    /// @brief Destructor.
+    ///
+    /// Discards the results which were not fetched and leaves the
+    /// pipeline mode.
+    ~PgSqlPipeline();
+
+    /// @brief Sends a prepared statement.
+    ///
+    /// The bind array is copied by the client library so it can be
+    /// discarded when this method returns.
+    ///
+    /// @param statement Statement to execute.
+    /// @param bind_array Parameters of the statement.
+    /// @param result_format Format of the result set: 0 for text and 1
+    /// for binary.
+    void send(const PgSqlTaggedStatement& statement,
+              const PsqlBindArray& bind_array,
+              const int result_format = 0);
+
+    /// @brief Fetches the result of the next statement.
+    ///
+    /// The caller is expected to check the result using
+    /// @ref PgSqlConnection::checkStatementError.
+    ///
+    /// @return Result of the oldest statement whose result was not fetched.
+    /// @throw DbOperationError if there is no pending statement or if the
+    /// statement was skipped because of a previous error.
+    PgSqlResultPtr getResult();
+
+    /// @brief Indicates if the statements are pipelined.
+    ///
+    /// @return False when the client library does not support pipelining.
+    bool isPipelined() const {
+        return (pipelined_);
+    }
+
+private:
+
+    /// @brief Sends a synchronization point and reads the results of the
+    /// pending statements.
+    void sync();
+
+    /// @brief Holds reference to the PostgreSQL database connection.
+    PgSqlConnection& conn_;
+
+    /// @brief Boolean flag indicating if the connection is in pipeline mode.
+    bool pipelined_;
+
+    /// @brief Number of statements sent since the last synchronization point.
+    size_t pending_;
+
+    /// @brief Results which were read but not fetched.
+    std::deque<PgSqlResultPtr> results_;
+};
+
 /// @brief Common PgSql Connector Pool
 ///
 /// This class provides common operations for PgSql database connection
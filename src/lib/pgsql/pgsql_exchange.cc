@@ -1,4 +1,4 @@
-// Copyright (C) 2016-2018 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2016-2018,2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -171,6 +171,34 @@ PgSqlExchange::getRawColumnValue(const PgSqlResult& r, const int row,
     return (value);
 }
 
+bool
+PgSqlExchange::isBinaryInteger(const PgSqlResult& r, const size_t col) {
+    if (PQfformat(r, col) != PsqlBindArray::BINARY_FMT) {
+        return (false);
+    }
+    Oid type = PQftype(r, col);
+    return ((type == OID_INT2) || (type == OID_INT4) || (type == OID_INT8));
+}
+
+int64_t
+PgSqlExchange::getBinaryInteger(const PgSqlResult& r, const int row,
+                                const size_t col) {
+    const uint8_t* data =
+        reinterpret_cast<const uint8_t*>(getRawColumnValue(r, row, col));
+    int length = PQgetlength(r, row, col);
+    if ((length != 2) && (length != 4) && (length != 8)) {
+        isc_throw(DbOperationError, "Invalid binary integer length: " << length
+                  << " for: " << getColumnLabel(r, col) << " row:" << row);
+    }
+
+    // Values are in network order: sign extend from the first byte.
+    int64_t value = static_cast<int8_t>(data[0]);
+    for (int i = 1; i < length; ++i) {
+        value = (value * 256) + data[i];
+    }
+    return (value);
+}
+
 bool
 PgSqlExchange::isColumnNull(const PgSqlResult& r, const int row,
                             const size_t col) {
@@ -188,6 +216,16 @@ void
 PgSqlExchange::getColumnValue(const PgSqlResult& r, const int row,
                               const size_t col, bool &value) {
     const char* data = getRawColumnValue(r, row, col);
+    if (PQfformat(r, col) == PsqlBindArray::BINARY_FMT) {
+        if (PQgetlength(r, row, col) != 1) {
+            isc_throw(DbOperationError, "Invalid binary boolean length: "
+                      << PQgetlength(r, row, col) << " for: "
+                      << getColumnLabel(r, col) << " row:" << row);
+        }
+        value = (*data != 0);
+        return;
+    }
+
     if (!strlen(data) || *data == 'f') {
         value = false;
     } else if (*data == 't') {
@@ -202,6 +240,18 @@ PgSqlExchange::getColumnValue(const PgSqlResult& r, const int row,
 void
 PgSqlExchange::getColumnValue(const PgSqlResult& r, const int row,
                               const size_t col, uint8_t &value) {
+    if (isBinaryInteger(r, col)) {
+        int64_t binary = getBinaryInteger(r, row, col);
+        try {
+            value = boost::numeric_cast<uint8_t>(binary);
+        } catch (const std::exception& ex) {
+            isc_throw(DbOperationError, "Invalid uint8_t data: " << binary
+                      << " for: " << getColumnLabel(r, col) << " row:" << row
+                      << " : " << ex.what());
+        }
+        return;
+    }
+
     const char* data = getRawColumnValue(r, row, col);
     try {
         // lexically casting as uint8_t doesn't convert from char
@@ -232,6 +282,19 @@ PgSqlExchange::convertFromBytea(const PgSqlResult& r, const int row,
                                 const size_t col, uint8_t* buffer,
                                 const size_t buffer_size,
                                 size_t &bytes_converted) {
+    if (PQfformat(r, col) == PsqlBindArray::BINARY_FMT) {
+        // Binary values are not escaped.
+        const char* data = getRawColumnValue(r, row, col);
+        bytes_converted = PQgetlength(r, row, col);
+        if (bytes_converted > buffer_size) {
+            isc_throw (DbOperationError, "Converted data size: "
+                       << bytes_converted << " is too large for: "
+                       << getColumnLabel(r, col) << " row:" << row);
+        }
+        memcpy(buffer, data, bytes_converted);
+        return;
+    }
+
     // Returns converted bytes in a dynamically allocated buffer, and
     // sets bytes_converted.
     unsigned char* bytes = PQunescapeBytea((const unsigned char*)
@@ -279,7 +342,7 @@ PgSqlExchange::dumpRow(const PgSqlResult& r, int row) {
             stream << "\"" << val << "\"" << std::endl;
         } else {
             const char *data = val;
-            int length = PQfsize(r, col);
+            int length = PQgetlength(r, row, col);
             if (length == 0) {
                 stream << "empty" << std::endl;
             } else {
@@ -12,6 +12,7 @@
 
 #include <boost/lexical_cast.hpp>
 #include <boost/noncopyable.hpp>
+#include <boost/numeric/conversion/cast.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <stdint.h>
@@ -264,6 +265,30 @@ public:
     static const char* getRawColumnValue(const PgSqlResult& r, const int row,
                                          const size_t col);
 
+    /// @brief Tells if a column holds integers fetched in binary format.
+    ///
+    /// Statements executed with a binary result format return the
+    /// SMALLINT, INT and BIGINT columns as network order integers of
+    /// 2, 4 and 8 bytes instead of decimal text.
+    ///
+    /// @param r the result set containing the query results
+    /// @param col the column number within the row
+    ///
+    /// @return True if the column is a binary integer column.
+    static bool isBinaryInteger(const PgSqlResult& r, const size_t col);
+
+    /// @brief Fetches an integer column fetched in binary format.
+    ///
+    /// @param r the result set containing the query results
+    /// @param row the row number within the result set
+    /// @param col the column number within the row
+    ///
+    /// @return The integer value of the column.
+    /// @throw  DbOperationError if the value cannot be fetched or its
+    /// length is not 2, 4 or 8 bytes.
+    static int64_t getBinaryInteger(const PgSqlResult& r, const int row,
+                                    const size_t col);
+
     /// @brief Fetches the name of the column in a result set
     ///
     /// Returns the column name of the column from the result set.
@@ -289,7 +314,7 @@ public:
     static void getColumnValue(const PgSqlResult& r, const int row,
                                const size_t col, std::string& value);
 
-    /// @brief Fetches boolean text ('t' or 'f') as a bool.
+    /// @brief Fetches boolean text ('t' or 'f') or binary (1 or 0) as a bool.
     ///
     /// @param r the result set containing the query results
     /// @param row the row number within the result set
@@ -301,7 +326,7 @@ public:
     static void getColumnValue(const PgSqlResult& r, const int row,
                                const size_t col, bool &value);
 
-    /// @brief Fetches an integer text column as a uint8_t.
+    /// @brief Fetches an integer text or binary column as a uint8_t.
     ///
     /// @param r the result set containing the query results
     /// @param row the row number within the result set
@@ -339,7 +364,8 @@ public:
     /// @brief Fetches a text column as the given value type
     ///
     /// Uses boost::lexicalcast to convert the text column value into
-    /// a value of type T.
+    /// a value of type T. Integer columns fetched in binary format are
+    /// converted using boost::numeric_cast instead.
     ///
     /// @param r the result set containing the query results
     /// @param row the row number within the result set
@@ -351,6 +377,18 @@ public:
     template<typename T>
     static void getColumnValue(const PgSqlResult& r, const int row,
                                const size_t col, T& value) {
+        if (isBinaryInteger(r, col)) {
+            int64_t binary = getBinaryInteger(r, row, col);
+            try {
+                value = boost::numeric_cast<T>(binary);
+            } catch (const std::exception& ex) {
+                isc_throw(db::DbOperationError, "Invalid data:[" << binary
+                          << "] for row: " << row << " col: " << col << ","
+                          << getColumnLabel(r, col) << " : " << ex.what());
+            }
+            return;
+        }
+
         const char* data = getRawColumnValue(r, row, col);
         try {
             value = boost::lexical_cast<T>(data);
@@ -364,7 +402,8 @@ public:
     /// @brief Converts a column in a row in a result set to a binary bytes
     ///
     /// Method is used to convert columns stored as BYTEA into a buffer of
-    /// binary bytes, (uint8_t).  It uses PQunescapeBytea to do the conversion.
+    /// binary bytes, (uint8_t).  It uses PQunescapeBytea to do the conversion
+    /// of text columns, binary columns are copied as is.
     ///
     /// @param r the result set containing the query results
     /// @param row the row number within the result set
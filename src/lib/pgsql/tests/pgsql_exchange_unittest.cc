@@ -1,4 +1,4 @@
-// Copyright (C) 2016-2020 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2016-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -90,10 +90,85 @@ TEST(PsqlBindArray, addDataTest) {
     EXPECT_EQ(expected, b.toText());
 }
 
+/// @brief Verifies that the binary format columns are converted without
+/// a database: the result set is built by the client library.
+TEST(PgSqlExchange, binaryColumns) {
+    PGresAttDesc attrs[] = {
+        { const_cast<char*>("int2_col"), 0, 0, 1, OID_INT2, 2, -1 },
+        { const_cast<char*>("int4_col"), 0, 0, 1, OID_INT4, 4, -1 },
+        { const_cast<char*>("int8_col"), 0, 0, 1, OID_INT8, 8, -1 },
+        { const_cast<char*>("bool_col"), 0, 0, 1, OID_BOOL, 1, -1 },
+        { const_cast<char*>("bytea_col"), 0, 0, 1, OID_BYTEA, -1, -1 },
+        { const_cast<char*>("text_col"), 0, 0, 1, OID_TEXT, -1, -1 }
+    };
+    PGresult* raw = PQmakeEmptyPGresult(NULL, PGRES_TUPLES_OK);
+    ASSERT_TRUE(raw);
+    ASSERT_EQ(1, PQsetResultAttrs(raw, 6, attrs));
+
+    // Values are in network order.
+    char int2[] = { '\xff', '\xfe' };
+    char int4[] = { '\x7f', '\xff', '\xff', '\xff' };
+    char int8[] = { '\x00', '\x00', '\x00', '\x01', '\x00', '\x00',
+                    '\x00', '\x02' };
+    char boolean[] = { '\x01' };
+    char bytea[] = { '\x00', '\x01', '\x02' };
+    char text[] = "text";
+    ASSERT_EQ(1, PQsetvalue(raw, 0, 0, int2, sizeof(int2)));
+    ASSERT_EQ(1, PQsetvalue(raw, 0, 1, int4, sizeof(int4)));
+    ASSERT_EQ(1, PQsetvalue(raw, 0, 2, int8, sizeof(int8)));
+    ASSERT_EQ(1, PQsetvalue(raw, 0, 3, boolean, sizeof(boolean)));
+    ASSERT_EQ(1, PQsetvalue(raw, 0, 4, bytea, sizeof(bytea)));
+    ASSERT_EQ(1, PQsetvalue(raw, 0, 5, text, strlen(text)));
+    PgSqlResult r(raw);
+
+    EXPECT_TRUE(PgSqlExchange::isBinaryInteger(r, 0));
+    EXPECT_TRUE(PgSqlExchange::isBinaryInteger(r, 2));
+    EXPECT_FALSE(PgSqlExchange::isBinaryInteger(r, 3));
+    EXPECT_FALSE(PgSqlExchange::isBinaryInteger(r, 5));
+
+    int16_t int16_value = 0;
+    ASSERT_NO_THROW(PgSqlExchange::getColumnValue(r, 0, 0, int16_value));
+    EXPECT_EQ(-2, int16_value);
+
+    uint32_t uint32_value = 0;
+    ASSERT_NO_THROW(PgSqlExchange::getColumnValue(r, 0, 1, uint32_value));
+    EXPECT_EQ(2147483647, uint32_value);
+
+    int64_t int64_value = 0;
+    ASSERT_NO_THROW(PgSqlExchange::getColumnValue(r, 0, 2, int64_value));
+    EXPECT_EQ(4294967298LL, int64_value);
+
+    // Values which do not fit in the destination type are rejected.
+    uint16_t uint16_value = 0;
+    EXPECT_THROW(PgSqlExchange::getColumnValue(r, 0, 0, uint16_value),
+                 DbOperationError);
+    EXPECT_THROW(PgSqlExchange::getColumnValue(r, 0, 2, uint32_value),
+                 DbOperationError);
+    uint8_t uint8_value = 0;
+    EXPECT_THROW(PgSqlExchange::getColumnValue(r, 0, 1, uint8_value),
+                 DbOperationError);
+
+    bool bool_value = false;
+    ASSERT_NO_THROW(PgSqlExchange::getColumnValue(r, 0, 3, bool_value));
+    EXPECT_TRUE(bool_value);
+
+    uint8_t buffer[3];
+    size_t converted = 0;
+    ASSERT_NO_THROW(PgSqlExchange::convertFromBytea(r, 0, 4, buffer,
+                                                    sizeof(buffer), converted));
+    ASSERT_EQ(sizeof(bytea), converted);
+    EXPECT_EQ(0, memcmp(bytea, buffer, converted));
+    EXPECT_THROW(PgSqlExchange::convertFromBytea(r, 0, 4, buffer, 2,
+                                                 converted),
+                 DbOperationError);
+
+    std::string string_value;
+    ASSERT_NO_THROW(PgSqlExchange::getColumnValue(r, 0, 5, string_value));
+    EXPECT_EQ("text", string_value);
+}
+
 /// @brief Defines a pointer to a PgSqlConnection
 typedef boost::shared_ptr<PgSqlConnection> PgSqlConnectionPtr;
-/// @brief Defines a pointer to a PgSqlResult
-typedef boost::shared_ptr<PgSqlResult> PgSqlResultPtr;
 
 /// @brief Fixture for exercising basic PostgreSQL operations and data types
 ///
@@ -271,9 +346,12 @@ public:
     /// statement's execution.
     /// @param exp_rows expected number of rows fetched. (This can be 0).
     /// @lineno line number from where the call was invoked
+    /// @param result_format format of the result set: 0 for text and 1
+    /// for binary.
     ///
     /// Asserts if the result set status does not equal the expected outcome.
-    void fetchRows(PgSqlResultPtr& r, int exp_rows, int line) {
+    void fetchRows(PgSqlResultPtr& r, int exp_rows, int line,
+                   int result_format = 0) {
         std::string sql =
             "SELECT"
             "   id, bool_col, bytea_col, bigint_col, smallint_col, "
@@ -281,7 +359,16 @@ public:
             "   extract(epoch from timestamp_col)::bigint as timestamp_col,"
             "   varchar_col FROM basics";
 
-        runSql(r, sql, PGRES_TUPLES_OK, line);
+        if (result_format) {
+            r.reset(new PgSqlResult(PQexecParams(*conn_, sql.c_str(), 0, NULL,
+                                                 NULL, NULL, NULL,
+                                                 result_format)));
+            ASSERT_EQ(PQresultStatus(*r), PGRES_TUPLES_OK)
+                      << " fetch at line: " << line << " failed, reason: "
+                      << PQerrorMessage(*conn_);
+        } else {
+            runSql(r, sql, PGRES_TUPLES_OK, line);
+        }
         ASSERT_EQ(r->getRows(), exp_rows) << "fetch at line: " << line
                   << " wrong row count, expected: " << exp_rows
                   << " , have: " << r->getRows();
@@ -300,6 +387,7 @@ public:
 #define RUN_SQL(a,b,c) (runSql(a,b,c, __LINE__))
 #define RUN_PREP(a,b,c,d) (runPreparedStatement(a,b,c,d, __LINE__))
 #define FETCH_ROWS(a,b) (fetchRows(a,b,__LINE__))
+#define FETCH_BINARY_ROWS(a,b) (fetchRows(a,b,__LINE__,1))
 #define WIPE_ROWS(a) (RUN_SQL(a, "DELETE FROM BASICS", PGRES_COMMAND_OK))
 
 /// @brief Verifies that PgResultSet row and column meta-data is correct
@@ -920,4 +1008,120 @@ TEST_F(PgSqlBasicsTest, timeStampTest) {
                                                       MAX_DB_TIME), BadValue);
 }
 
+/// @brief Verify that columns fetched in binary format are converted
+TEST_F(PgSqlBasicsTest, binaryFetchTest) {
+    const char* st_name = "all_insert";
+    PgSqlTaggedStatement statement[] = {
+     {7, { OID_BOOL, OID_BYTEA, OID_INT8, OID_INT2, OID_INT4, OID_TEXT,
+           OID_TIMESTAMP }, st_name,
+      "INSERT INTO BASICS (bool_col, bytea_col, bigint_col, smallint_col, "
+      "int_col, text_col, timestamp_col) values ($1, $2, $3, $4, $5, $6, $7)" }
+    };
+
+    ASSERT_NO_THROW(conn_->prepareStatement(statement[0]));
+
+    const uint8_t bytes[] = { 0x01, 0x00, 0xff };
+    time_t now = time(0);
+    std::string time_str = PgSqlExchange::convertToDatabaseTime(now, 0);
+    PsqlBindArrayPtr bind_array(new PsqlBindArray());
+    bind_array->add(true);
+    bind_array->add(bytes, sizeof(bytes));
+    bind_array->add(std::string("-8589934592"));
+    bind_array->add(std::string("-2"));
+    bind_array->add(std::string("2147483647"));
+    bind_array->add(std::string("text"));
+    bind_array->add(time_str);
+    PgSqlResultPtr r;
+    RUN_PREP(r, statement[0], bind_array, PGRES_COMMAND_OK);
+
+    FETCH_BINARY_ROWS(r, 1);
+    ASSERT_EQ(1, PQfformat(*r, BIGINT_COL));
+
+    bool fetched_bool = false;
+    ASSERT_NO_THROW(PgSqlExchange::getColumnValue(*r, 0, BOOL_COL,
+                                                  fetched_bool));
+    EXPECT_TRUE(fetched_bool);
+
+    uint8_t fetched_bytes[sizeof(bytes)];
+    size_t byte_count = 0;
+    ASSERT_NO_THROW(PgSqlExchange::convertFromBytea(*r, 0, BYTEA_COL,
+                                                    fetched_bytes,
+                                                    sizeof(fetched_bytes),
+                                                    byte_count));
+    ASSERT_EQ(sizeof(bytes), byte_count);
+    EXPECT_EQ(0, memcmp(bytes, fetched_bytes, byte_count));
+
+    // The buffer must be large enough.
+    EXPECT_THROW(PgSqlExchange::convertFromBytea(*r, 0, BYTEA_COL,
+                                                 fetched_bytes, 1, byte_count),
+                 DbOperationError);
+
+    int64_t fetched_bigint = 0;
+    ASSERT_NO_THROW(PgSqlExchange::getColumnValue(*r, 0, BIGINT_COL,
+                                                  fetched_bigint));
+    EXPECT_EQ(-8589934592LL, fetched_bigint);
+
+    int16_t fetched_smallint = 0;
+    ASSERT_NO_THROW(PgSqlExchange::getColumnValue(*r, 0, SMALLINT_COL,
+                                                  fetched_smallint));
+    EXPECT_EQ(-2, fetched_smallint);
+
+    uint32_t fetched_int = 0;
+    ASSERT_NO_THROW(PgSqlExchange::getColumnValue(*r, 0, INT_COL,
+                                                  fetched_int));
+    EXPECT_EQ(2147483647, fetched_int);
+
+    // Values which do not fit in the destination type are rejected.
+    uint8_t fetched_byte = 0;
+    EXPECT_THROW(PgSqlExchange::getColumnValue(*r, 0, INT_COL, fetched_byte),
+                 DbOperationError);
+    uint16_t fetched_uint16 = 0;
+    EXPECT_THROW(PgSqlExchange::getColumnValue(*r, 0, SMALLINT_COL,
+                                               fetched_uint16),
+                 DbOperationError);
+
+    std::string fetched_str;
+    ASSERT_NO_THROW(PgSqlExchange::getColumnValue(*r, 0, TEXT_COL,
+                                                  fetched_str));
+    EXPECT_EQ("text", fetched_str);
+
+    time_t fetched_time = 0;
+    ASSERT_NO_THROW(PgSqlExchange::getColumnValue(*r, 0, TIMESTAMP_COL,
+                                                  fetched_time));
+    EXPECT_EQ(now, fetched_time);
+}
+
+/// @brief Verify that statements can be sent in a pipeline
+TEST_F(PgSqlBasicsTest, pipelineTest) {
+    const char* st_name = "int_insert";
+    PgSqlTaggedStatement statement[] = {
+     {1, { OID_INT4 }, st_name,
+      "INSERT INTO BASICS (int_col) values ($1)" }
+    };
+
+    ASSERT_NO_THROW(conn_->prepareStatement(statement[0]));
+
+    // Send more statements than the pipeline depth.
+    const size_t count = PgSqlPipeline::MAX_DEPTH * 2 + 1;
+    {
+        PgSqlPipeline pipeline(*conn_);
+        for (size_t i = 0; i < count; ++i) {
+            PsqlBindArray bind_array;
+            bind_array.add(i);
+            ASSERT_NO_THROW(pipeline.send(statement[0], bind_array));
+        }
+        for (size_t i = 0; i < count; ++i) {
+            PgSqlResultPtr r;
+            ASSERT_NO_THROW(r = pipeline.getResult());
+            ASSERT_NO_THROW(conn_->checkStatementError(*r, statement[0]));
+            EXPECT_EQ("1", std::string(PQcmdTuples(*r)));
+        }
+        EXPECT_THROW(pipeline.getResult(), DbOperationError);
+    }
+
+    // The connection is usable again once the pipeline is destroyed.
+    PgSqlResultPtr r;
+    FETCH_ROWS(r, count);
+}
+
 }; // namespace
@@ -1,4 +1,4 @@
-// Copyright (C) 2015 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2015-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -49,6 +49,14 @@ public:
         return (modified_ ? *staging_ : *current_);
     }
 
+    /// @brief Retrieves committed value.
+    ///
+    /// The committed value is returned even if the value has been
+    /// modified since last commit.
+    const ValueType& getCurrentValue() const {
+        return (*current_);
+    }
+
     /// @brief Sets new value.
     ///
     /// @param new_value New value to be assigned.
@@ -1,4 +1,4 @@
-// Copyright (C) 2015-2017 Internet Systems Consortium, Inc. ("ISC")
+// Copyright (C) 2015-2021 Internet Systems Consortium, Inc. ("ISC")
 //
 // This Source Code Form is subject to the terms of the Mozilla Public
 // License, v. 2.0. If a copy of the MPL was not distributed with this
@@ -88,6 +88,22 @@ TEST(StagedValueTest, commit) {
     EXPECT_EQ(123, value.getValue());
 }
 
+// This test checks that the committed value is returned until the
+// modified value is committed.
+TEST(StagedValueTest, getCurrentValue) {
+    StagedValue<int> value;
+    value = 10;
+    value.commit();
+    value = 20;
+    EXPECT_EQ(20, value.getValue());
+    EXPECT_EQ(10, value.getCurrentValue());
+    value.commit();
+    EXPECT_EQ(20, value.getCurrentValue());
+    value = 30;
+    value.revert();
+    EXPECT_EQ(20, value.getCurrentValue());
+}
+
 // This test checks that type conversion operator works correctly.
 TEST(StagedValueTest, conversionOperator) {
     StagedValue<int> value;
@@ -646,6 +646,119 @@ TEST_F(ThreadPoolTest, addFront) {
     EXPECT_EQ(thread_pool.count(), items_count);
 }
 
+/// @brief test ThreadPool with per thread queues.
+TEST_F(ThreadPoolTest, threadQueues) {
+    uint32_t items_count;
+    uint32_t thread_count;
+    CallBack call_back;
+    ThreadPool<CallBack> thread_pool;
+    // the per thread queues should be disabled by default
+    EXPECT_FALSE(thread_pool.getThreadQueues());
+    EXPECT_NO_THROW(thread_pool.setThreadQueues(true));
+    EXPECT_TRUE(thread_pool.getThreadQueues());
+
+    items_count = 4;
+    thread_count = 4;
+    // prepare setup
+    reset(thread_count);
+
+    // create tasks which block thread pool threads until signaled by main
+    // thread: the items are distributed in turn over the queues so each
+    // thread should run exactly one task
+    call_back = std::bind(&ThreadPoolTest::runAndWait, this);
+
+    // add items to stopped thread pool
+    for (uint32_t i = 0; i < items_count; ++i) {
+        bool ret = true;
+        EXPECT_NO_THROW(ret = thread_pool.add(boost::make_shared<CallBack>(call_back)));
+        EXPECT_TRUE(ret);
+    }
+
+    // the item count should match
+    ASSERT_EQ(thread_pool.count(), items_count);
+
+    // calling start should create the queues and should keep the queued items
+    EXPECT_NO_THROW(thread_pool.start(thread_count));
+    // the thread count should match
+    ASSERT_EQ(thread_pool.size(), thread_count);
+
+    // the mode can not be changed while the thread pool is running
+    EXPECT_THROW(thread_pool.setThreadQueues(false), InvalidOperation);
+    EXPECT_NO_THROW(thread_pool.setThreadQueues(true));
+
+    // wait for all items to be processed
+    waitTasks(thread_count, items_count);
+    // the item count should be 0
+    ASSERT_EQ(thread_pool.count(), 0);
+    // each thread should have processed one item
+    checkIds(thread_count);
+    // check that the number of processed tasks matches the number of items
+    checkRunHistory(items_count);
+
+    // check that waiting on tasks does timeout
+    ASSERT_FALSE(thread_pool.wait(1));
+
+    // signal thread pool tasks to continue
+    signalThreads();
+
+    // calling stop should clear all threads
+    EXPECT_NO_THROW(thread_pool.stop());
+    // the thread count should be 0
+    ASSERT_EQ(thread_pool.size(), 0);
+
+    items_count = 64;
+    // prepare setup
+    reset(thread_count);
+
+    // create tasks which do not block the thread pool threads
+    call_back = std::bind(&ThreadPoolTest::run, this);
+
+    // add items to stopped thread pool
+    for (uint32_t i = 0; i < items_count; ++i) {
+        bool ret = true;
+        EXPECT_NO_THROW(ret = thread_pool.add(boost::make_shared<CallBack>(call_back)));
+        EXPECT_TRUE(ret);
+    }
+
+    // the item count should match
+    ASSERT_EQ(thread_pool.count(), items_count);
+
+    // the items queued in the per thread queues should be kept when the
+    // per thread queues are disabled
+    EXPECT_NO_THROW(thread_pool.setThreadQueues(false));
+    EXPECT_FALSE(thread_pool.getThreadQueues());
+    ASSERT_EQ(thread_pool.count(), items_count);
+
+    // calling start should use the shared queue
+    EXPECT_NO_THROW(thread_pool.start(thread_count));
+    ASSERT_EQ(thread_pool.size(), thread_count);
+
+    // wait for all items to be processed
+    thread_pool.wait();
+    // the item count should be 0
+    ASSERT_EQ(thread_pool.count(), 0);
+    // all items should have been processed
+    ASSERT_EQ(count(), items_count);
+    // check that the number of processed tasks matches the number of items
+    checkRunHistory(items_count);
+
+    // the maximum queue size is shared by the per thread queues
+    EXPECT_NO_THROW(thread_pool.stop());
+    EXPECT_NO_THROW(thread_pool.setThreadQueues(true));
+    EXPECT_NO_THROW(thread_pool.start(thread_count));
+    EXPECT_NO_THROW(thread_pool.stop());
+    thread_pool.setMaxQueueSize(8);
+    EXPECT_EQ(thread_pool.getMaxQueueSize(), 8);
+    bool ret = true;
+    for (uint32_t i = 0; i < 8; ++i) {
+        EXPECT_NO_THROW(ret = thread_pool.add(boost::make_shared<CallBack>(call_back)));
+        EXPECT_TRUE(ret);
+    }
+    EXPECT_NO_THROW(ret = thread_pool.add(boost::make_shared<CallBack>(call_back)));
+    EXPECT_FALSE(ret);
+    EXPECT_EQ(thread_pool.count(), 8);
+}
+
 /// @brief test ThreadPool get queue statistics.
 TEST_F(ThreadPoolTest, getQueueStat) {
     ThreadPool<CallBack> thread_pool;
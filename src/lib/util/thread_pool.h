@@ -19,6 +19,7 @@
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include <signal.h>
 
@@ -28,6 +29,12 @@ namespace util {
 /// @brief Defines a thread pool which uses a thread pool queue for managing
 /// work items. Each work item is a 'functor' object.
 ///
+/// By default all the threads take the work items from a single queue.
+/// When the per thread queues are enabled, each thread takes the work items
+/// from its own queue and the added work items are distributed in turn over
+/// the queues, so the threads adding and the threads processing work items
+/// do not all contend for the same lock.
+///
 /// @tparam WorkItem a functor
 /// @tparam Container a 'queue like' container
 template <typename WorkItem, typename Container = std::deque<boost::shared_ptr<WorkItem>>>
@@ -45,7 +52,7 @@ struct ThreadPool {
     typedef typename boost::shared_ptr<WorkItem> WorkItemPtr;
 
     /// @brief Constructor
-    ThreadPool() {
+    ThreadPool() : thread_queues_enabled_(false), next_queue_(0) {
     }
 
     /// @brief Destructor
@@ -60,6 +67,34 @@ struct ThreadPool {
     void reset() {
         stopInternal();
         queue_.clear();
+        std::lock_guard<std::mutex> lock(thread_queues_mutex_);
+        thread_queues_.clear();
+    }
+
+    /// @brief enable or disable the per thread queues
+    ///
+    /// The work items queued when the mode changes are kept and processed
+    /// once the thread pool is started.
+    ///
+    /// @param enabled true to give each thread its own queue, false to use
+    /// a single queue shared by all threads
+    /// @throw InvalidOperation if the thread pool is started and the mode
+    /// changes
+    void setThreadQueues(bool enabled) {
+        if (enabled == thread_queues_enabled_) {
+            return;
+        }
+        if (queue_.enabled()) {
+            isc_throw(InvalidOperation, "thread pool already started");
+        }
+        thread_queues_enabled_ = enabled;
+    }
+
+    /// @brief check if the per thread queues are enabled
+    ///
+    /// @return true if each thread has its own queue
+    bool getThreadQueues() const {
+        return (thread_queues_enabled_);
     }
 
     /// @brief start all the threads
@@ -95,6 +130,10 @@ struct ThreadPool {
     /// @return false if the queue was full and oldest item(s) was dropped,
     /// true otherwise.
     bool add(const WorkItemPtr& item) {
+        QueuePtr queue = getNextQueue();
+        if (queue) {
+            return (queue->pushBack(item));
+        }
         return (queue_.pushBack(item));
     }
 
@@ -103,6 +142,10 @@ struct ThreadPool {
     /// @param item the 'functor' object to be added to the queue
     /// @return false if the queue was full, true otherwise.
     bool addFront(const WorkItemPtr& item) {
+        QueuePtr queue = getNextQueue();
+        if (queue) {
+            return (queue->pushFront(item));
+        }
         return (queue_.pushFront(item));
     }
 
@@ -110,7 +153,12 @@ struct ThreadPool {
     ///
     /// @return the number of work items in the queue
     size_t count() {
-        return (queue_.count());
+        size_t count = queue_.count();
+        std::lock_guard<std::mutex> lock(thread_queues_mutex_);
+        for (auto const& queue : thread_queues_) {
+            count += queue->count();
+        }
+        return (count);
     }
 
     /// @brief wait for current items to be processed
@@ -123,6 +171,9 @@ struct ThreadPool {
             isc_throw(MultiThreadingInvalidOperation, "thread pool wait called by worker thread");
         }
         queue_.wait();
+        for (auto const& queue : getThreadQueuesCopy()) {
+            queue->wait();
+        }
     }
 
     /// @brief wait for items to be processed or return after timeout
@@ -137,14 +188,31 @@ struct ThreadPool {
         if (checkThreadId(id)) {
             isc_throw(MultiThreadingInvalidOperation, "thread pool wait with timeout called by worker thread");
         }
-        return (queue_.wait(seconds));
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+        if (!queue_.waitUntil(deadline)) {
+            return (false);
+        }
+        for (auto const& queue : getThreadQueuesCopy()) {
+            if (!queue->waitUntil(deadline)) {
+                return (false);
+            }
+        }
+        return (true);
     }
 
     /// @brief set maximum number of work items in the queue
     ///
     /// @param max_queue_size the maximum size (0 means unlimited)
+    ///
+    /// When the per thread queues are enabled the maximum size is shared
+    /// between the queues.
     void setMaxQueueSize(size_t max_queue_size) {
         queue_.setMaxQueueSize(max_queue_size);
+        std::lock_guard<std::mutex> lock(thread_queues_mutex_);
+        for (auto const& queue : thread_queues_) {
+            queue->setMaxQueueSize(getThreadQueueSize(max_queue_size,
+                                                      thread_queues_.size()));
+        }
     }
 
     /// @brief get maximum number of work items in the queue
@@ -166,8 +234,15 @@ struct ThreadPool {
     /// @param which select the statistic (10, 100 or 1000)
     /// @return the queue length statistic
     /// @throw InvalidParameter if which is not 10 and 100 and 1000.
+    ///
+    /// When the per thread queues are enabled, the statistics of the queues
+    /// are added up.
     double getQueueStat(size_t which) {
-        return (queue_.getQueueStat(which));
+        double stat = queue_.getQueueStat(which);
+        for (auto const& queue : getThreadQueuesCopy()) {
+            stat += queue->getQueueStat(which);
+        }
+        return (stat);
     }
 
 private:
@@ -185,10 +260,23 @@ private:
         sigaddset(&sset, SIGHUP);
         sigaddset(&sset, SIGTERM);
         pthread_sigmask(SIG_BLOCK, &sset, &osset);
-        queue_.enable(thread_count);
         try {
-            for (uint32_t i = 0; i < thread_count; ++i) {
-                threads_.push_back(boost::make_shared<std::thread>(&ThreadPool::run, this));
+            if (thread_queues_enabled_) {
+                startThreadQueues(thread_count);
+                // No thread takes the items from the shared queue.
+                queue_.enable(0);
+                auto const& queues = getThreadQueuesCopy();
+                for (uint32_t i = 0; i < thread_count; ++i) {
+                    threads_.push_back(boost::make_shared<std::thread>(&ThreadPool::run,
+                                                                       this, queues[i].get()));
+                }
+            } else {
+                moveThreadQueues();
+                queue_.enable(thread_count);
+                for (uint32_t i = 0; i < thread_count; ++i) {
+                    threads_.push_back(boost::make_shared<std::thread>(&ThreadPool::run,
+                                                                       this, &queue_));
+                }
             }
         } catch (...) {
             // Restore signal mask.
@@ -206,6 +294,9 @@ private:
             isc_throw(MultiThreadingInvalidOperation, "thread pool stop called by worker thread");
         }
         queue_.disable();
+        for (auto const& queue : getThreadQueuesCopy()) {
+            queue->disable();
+        }
         for (auto thread : threads_) {
             thread->join();
         }
@@ -384,13 +475,34 @@ private:
         /// @param seconds the time in seconds to wait for tasks to finish
         /// @return true if all tasks finished, false on timeout
         bool wait(uint32_t seconds) {
+            return (waitUntil(std::chrono::steady_clock::now() +
+                              std::chrono::seconds(seconds)));
+        }
+
+        /// @brief wait for items to be processed or return at deadline
+        ///
+        /// @param deadline the time at which to stop waiting
+        /// @return true if all tasks finished, false on timeout
+        bool waitUntil(const std::chrono::steady_clock::time_point& deadline) {
             std::unique_lock<std::mutex> lock(mutex_);
             // Wait for any item or for working threads to finish.
-            bool ret = wait_cv_.wait_for(lock, std::chrono::seconds(seconds),
-                                         [&]() {return (working_ == 0 && queue_.empty());});
+            bool ret = wait_cv_.wait_until(lock, deadline,
+                                           [&]() {return (working_ == 0 && queue_.empty());});
             return (ret);
         }
 
+        /// @brief remove and return all work items
+        ///
+        /// Used to move the queued work items to other queues.
+        ///
+        /// @return the removed work items
+        QueueContainer takeAll() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            QueueContainer items;
+            std::swap(items, queue_);
+            return (items);
+        }
+
         /// @brief get queue length statistic
         ///
         /// @param which select the statistic (10, 100 or 1000)
@@ -488,10 +600,103 @@ private:
         double stat1000;
     };
 
+    /// @brief Type of the thread pool queues.
+    typedef ThreadPoolQueue<WorkItemPtr, Container> Queue;
+
+    /// @brief Type of shared pointers to thread pool queues.
+    typedef boost::shared_ptr<Queue> QueuePtr;
+
+    /// @brief compute the maximum size of a per thread queue
+    ///
+    /// @param max_queue_size the maximum number of work items in the thread
+    /// pool (0 means unlimited)
+    /// @param queue_count the number of per thread queues
+    /// @return the maximum size of each queue (0 means unlimited)
+    static size_t getThreadQueueSize(size_t max_queue_size, size_t queue_count) {
+        if (!max_queue_size || !queue_count) {
+            return (max_queue_size);
+        }
+        return ((max_queue_size + queue_count - 1) / queue_count);
+    }
+
+    /// @brief get the per thread queue receiving the next work item
+    ///
+    /// @return the queue or an empty pointer when the work item must be
+    /// added to the shared queue
+    QueuePtr getNextQueue() {
+        if (!thread_queues_enabled_) {
+            return (QueuePtr());
+        }
+        std::lock_guard<std::mutex> lock(thread_queues_mutex_);
+        if (thread_queues_.empty()) {
+            return (QueuePtr());
+        }
+        return (thread_queues_[next_queue_++ % thread_queues_.size()]);
+    }
+
+    /// @brief get a copy of the list of per thread queues
+    ///
+    /// @return the per thread queues
+    std::vector<QueuePtr> getThreadQueuesCopy() {
+        std::lock_guard<std::mutex> lock(thread_queues_mutex_);
+        return (thread_queues_);
+    }
+
+    /// @brief create and enable the per thread queues
+    ///
+    /// The queues are kept when the thread count does not change. The work
+    /// items held by the shared queue and by the previous per thread queues
+    /// are moved to the new queues.
+    ///
+    /// @param thread_count the number of threads
+    void startThreadQueues(uint32_t thread_count) {
+        std::lock_guard<std::mutex> lock(thread_queues_mutex_);
+        if (thread_queues_.size() != thread_count) {
+            std::vector<QueuePtr> queues;
+            size_t max_queue_size = getThreadQueueSize(queue_.getMaxQueueSize(),
+                                                       thread_count);
+            for (uint32_t i = 0; i < thread_count; ++i) {
+                QueuePtr queue(new Queue());
+                queue->setMaxQueueSize(max_queue_size);
+                queues.push_back(queue);
+            }
+            size_t index = 0;
+            for (auto const& queue : thread_queues_) {
+                Container items = queue->takeAll();
+                for (auto const& item : items) {
+                    queues[index++ % thread_count]->pushBack(item);
+                }
+            }
+            thread_queues_.swap(queues);
+        }
+        Container items = queue_.takeAll();
+        for (auto const& item : items) {
+            thread_queues_[next_queue_++ % thread_count]->pushBack(item);
+        }
+        for (auto const& queue : thread_queues_) {
+            queue->enable(1);
+        }
+    }
+
+    /// @brief move the work items of the per thread queues to the shared
+    /// queue and remove the per thread queues
+    void moveThreadQueues() {
+        std::lock_guard<std::mutex> lock(thread_queues_mutex_);
+        for (auto const& queue : thread_queues_) {
+            Container items = queue->takeAll();
+            for (auto const& item : items) {
+                queue_.pushBack(item);
+            }
+        }
+        thread_queues_.clear();
+    }
+
     /// @brief run function of each thread
-    void run() {
-        while (queue_.enabled()) {
-            WorkItemPtr item = queue_.pop();
+    ///
+    /// @param queue the queue the thread takes the work items from
+    void run(Queue* queue) {
+        while (queue->enabled()) {
+            WorkItemPtr item = queue->pop();
             if (item) {
                 try {
                     (*item)();
@@ -506,7 +711,19 @@ private:
     std::vector<boost::shared_ptr<std::thread>> threads_;
 
     /// @brief underlying work items queue
-    ThreadPoolQueue<WorkItemPtr, Container> queue_;
+    Queue queue_;
+
+    /// @brief flag which indicates if each thread has its own queue
+    std::atomic<bool> thread_queues_enabled_;
+
+    /// @brief mutex protecting the list of per thread queues
+    std::mutex thread_queues_mutex_;
+
+    /// @brief per thread queues
+    std::vector<QueuePtr> thread_queues_;
+
+    /// @brief index of the per thread queue receiving the next work item
+    size_t next_queue_;
 };
 
 /// Initialize the 10 packet rounding to exp(-.1)
@@ -75,6 +75,8 @@ api_files += $(top_srcdir)/src/share/api/network6-get.json
 api_files += $(top_srcdir)/src/share/api/network6-list.json
 api_files += $(top_srcdir)/src/share/api/network6-subnet-add.json
 api_files += $(top_srcdir)/src/share/api/network6-subnet-del.json
+api_files += $(top_srcdir)/src/share/api/packet-profile-get.json
+api_files += $(top_srcdir)/src/share/api/packet-profile-set.json
 api_files += $(top_srcdir)/src/share/api/remote-class4-del.json
 api_files += $(top_srcdir)/src/share/api/remote-class4-get-all.json
 api_files += $(top_srcdir)/src/share/api/remote-class4-get.json